@@ -144,6 +144,7 @@
 
 #define MM_LENS_DEFORMER_TYPE_ID 0x0012F185
 #define MM_LENS_EVALUATE_TYPE_ID 0x0012F186
+#define MM_LENS_EVALUATE_ARRAY_TYPE_ID 0x0012F19E
 #define MM_LENS_MODEL_TOGGLE_TYPE_ID 0x0012F188
 #define MM_LENS_MODEL_3DE_TYPE_ID 0x0012F19B
 
@@ -928,16 +928,25 @@ namespace mmimage {
   struct ExrPixelLayout;
   enum class ExrLineOrder : ::std::uint8_t;
   struct ImageExrEncoder;
+  enum class ImageResizeFilter : ::std::uint8_t;
+  enum class ImageWarpFilter : ::std::uint8_t;
   struct OptionF32;
   struct Vec2F32;
   struct Vec2I32;
   struct Box2F32;
   struct ImageRegionRectangle;
   struct PixelF32x4;
+  struct PixelF32x2;
+  struct PixelF16x4;
+  struct PixelF16x2;
+  struct PixelU8x4;
   struct PixelF64x2;
+  struct ImageSequenceFrameMetaData;
+  struct ImageSequenceMetaDataSummary;
   enum class BufferDataType : ::std::uint8_t;
   struct ShimImagePixelBuffer;
   struct ShimImageMetaData;
+  struct ShimImageExrStreamWriter;
 }
 
 namespace mmimage {
@@ -1026,6 +1035,25 @@ struct ImageExrEncoder final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$ImageExrEncoder
 
+#ifndef CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+#define CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+enum class ImageResizeFilter : ::std::uint8_t {
+  kBox = 0,
+  kLanczos3 = 1,
+  kBilinear = 2,
+  kUnknown = 255,
+};
+#endif // CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+
+#ifndef CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+#define CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+enum class ImageWarpFilter : ::std::uint8_t {
+  kBilinear = 0,
+  kBicubic = 1,
+  kUnknown = 255,
+};
+#endif // CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+
 #ifndef CXXBRIDGE1_STRUCT_mmimage$OptionF32
 #define CXXBRIDGE1_STRUCT_mmimage$OptionF32
 struct OptionF32 final {
@@ -1128,6 +1156,52 @@ struct PixelF32x4 final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$PixelF32x4
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+struct PixelF32x2 final {
+  float x;
+  float y;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+// A 16-bit (half) float pixel, with each channel stored as the
+// IEEE 754 binary16 bits.
+struct PixelF16x4 final {
+  ::std::uint16_t r;
+  ::std::uint16_t g;
+  ::std::uint16_t b;
+  ::std::uint16_t a;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+struct PixelF16x2 final {
+  ::std::uint16_t x;
+  ::std::uint16_t y;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+#define CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+struct PixelU8x4 final {
+  ::std::uint8_t r;
+  ::std::uint8_t g;
+  ::std::uint8_t b;
+  ::std::uint8_t a;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+
 #ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 #define CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 struct PixelF64x2 final {
@@ -1144,12 +1218,47 @@ struct PixelF64x2 final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+#define CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+struct ImageSequenceFrameMetaData final {
+  ::std::int32_t frame;
+  bool exists;
+  ::mmimage::ImageRegionRectangle display_window;
+  ::mmimage::ImageRegionRectangle data_window;
+  float pixel_aspect;
+  ::std::size_t num_channels;
+  bool consistent;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+#define CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+struct ImageSequenceMetaDataSummary final {
+  ::std::size_t frame_count;
+  ::std::size_t missing_frame_count;
+  ::std::int32_t first_missing_frame;
+  ::std::int32_t reference_frame;
+  ::mmimage::ImageRegionRectangle display_window;
+  float pixel_aspect;
+  ::std::size_t display_window_mismatch_count;
+  ::std::size_t data_window_mismatch_count;
+  ::std::size_t pixel_aspect_mismatch_count;
+  ::std::size_t num_channels_mismatch_count;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+
 #ifndef CXXBRIDGE1_ENUM_mmimage$BufferDataType
 #define CXXBRIDGE1_ENUM_mmimage$BufferDataType
 enum class BufferDataType : ::std::uint8_t {
   kNone = 0,
   kF32 = 1,
   kF64 = 2,
+  kF16 = 3,
+  kU8 = 4,
 };
 #endif // CXXBRIDGE1_ENUM_mmimage$BufferDataType
 
@@ -1162,8 +1271,18 @@ struct ShimImagePixelBuffer final : public ::rust::Opaque {
   MMIMAGE_API_EXPORT ::std::size_t num_channels() const noexcept;
   MMIMAGE_API_EXPORT ::std::size_t pixel_count() const noexcept;
   MMIMAGE_API_EXPORT ::std::size_t element_count() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const float> as_slice_f32() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<float> as_slice_f32_mut() noexcept;
   MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x4> as_slice_f32x4() const noexcept;
   MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x4> as_slice_f32x4_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x2> as_slice_f32x2() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x2> as_slice_f32x2_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x4> as_slice_f16x4() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x4> as_slice_f16x4_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x2> as_slice_f16x2() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x2> as_slice_f16x2_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelU8x4> as_slice_u8x4() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelU8x4> as_slice_u8x4_mut() noexcept;
   MMIMAGE_API_EXPORT void resize(::mmimage::BufferDataType data_type, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t num_channels) noexcept;
   ~ShimImagePixelBuffer() = delete;
 
@@ -1226,13 +1345,57 @@ private:
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$ShimImageMetaData
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+#define CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+struct ShimImageExrStreamWriter final : public ::rust::Opaque {
+  MMIMAGE_API_EXPORT bool open(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, ::std::size_t image_width, ::std::size_t image_height) noexcept;
+  MMIMAGE_API_EXPORT bool write_rows_f32x4(::rust::Slice<const float> pixels) noexcept;
+  MMIMAGE_API_EXPORT ::std::size_t rows_written() const noexcept;
+  MMIMAGE_API_EXPORT bool finish() noexcept;
+  ~ShimImageExrStreamWriter() = delete;
+
+private:
+  friend ::rust::layout;
+  struct layout {
+    static ::std::size_t size() noexcept;
+    static ::std::size_t align() noexcept;
+  };
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+
 MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImagePixelBuffer> shim_create_image_pixel_buffer_box() noexcept;
 
+MMIMAGE_API_EXPORT bool shim_convert_pixel_buffer(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::mmimage::BufferDataType data_type, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
 MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImageMetaData> shim_create_image_meta_data_box() noexcept;
 
+MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImageExrStreamWriter> shim_create_image_exr_stream_writer_box() noexcept;
+
 MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_f32x4(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
 
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_rgba(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_rgba_level(::rust::Str file_path, ::std::uint8_t level, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_region_f32x4(::rust::Str file_path, ::mmimage::ImageRegionRectangle region, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_channel_f32(::rust::Str file_path, ::rust::Str channel_name, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
 MMIMAGE_API_EXPORT bool shim_image_read_metadata_exr(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data) noexcept;
 
+MMIMAGE_API_EXPORT bool shim_image_read_metadata_exr_sequence(::rust::Str file_pattern, ::std::int32_t start_frame, ::std::int32_t end_frame, ::std::size_t thread_count, ::rust::Vec<::mmimage::ImageSequenceFrameMetaData> &out_frames, ::mmimage::ImageSequenceMetaDataSummary &out_summary) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_is_exr_file_path(::rust::Str file_path) noexcept;
+
+MMIMAGE_API_EXPORT ::rust::String shim_image_sequence_frame_file_path(::rust::Str file_pattern, ::std::int32_t frame) noexcept;
+
 MMIMAGE_API_EXPORT bool shim_image_write_pixels_exr_f32x4(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_write_pixels_exr_rgba(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept;
+
+MMIMAGE_API_EXPORT ::std::uint8_t shim_image_write_proxy_levels_exr(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, ::mmimage::ImageResizeFilter filter, ::std::uint8_t level_count) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_resize_pixels_f32x4(::rust::Slice<const float> src_pixels, ::std::size_t src_width, ::std::size_t src_height, ::mmimage::ImageResizeFilter filter, ::std::size_t dst_width, ::std::size_t dst_height, ::rust::Slice<float> dst_pixels) noexcept;
+
+MMIMAGE_API_EXPORT bool shim_image_warp_rows_f32x4(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::rust::Slice<const float> st_coords, ::std::size_t st_coords_stride, ::mmimage::ImageWarpFilter filter, ::std::size_t out_image_width, ::rust::Slice<float> out_pixels) noexcept;
 } // namespace mmimage
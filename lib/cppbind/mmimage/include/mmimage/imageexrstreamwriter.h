@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Write an EXR file a band of rows at a time, so the full image
+ * never needs to be held in memory.
+ */
+
+#ifndef MM_IMAGE_IMAGE_EXR_STREAM_WRITER_H
+#define MM_IMAGE_IMAGE_EXR_STREAM_WRITER_H
+
+#include <memory>
+#include <string>
+
+#include "_cxx.h"
+#include "_cxxbridge.h"
+#include "_symbol_export.h"
+#include "_types.h"
+#include "imagemetadata.h"
+
+namespace mmimage {
+
+// The file is compressed and written on a background thread while
+// the caller computes the next rows. Rows are given top-to-bottom,
+// as RGBA 32-bit float pixels.
+class ImageExrStreamWriter {
+public:
+    MMIMAGE_API_EXPORT
+    ImageExrStreamWriter() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Box<ShimImageExrStreamWriter> get_inner() noexcept;
+
+    MMIMAGE_API_EXPORT
+    void set_inner(rust::Box<ShimImageExrStreamWriter> &value) noexcept;
+
+    // Start writing 'file_path', an image 'image_width' x
+    // 'image_height' pixels in size.
+    MMIMAGE_API_EXPORT
+    bool open(const rust::Str &file_path, ImageExrEncoder exr_encoder,
+              ImageMetaData &in_meta_data, const size_t image_width,
+              const size_t image_height) noexcept;
+
+    // Write the next rows; 'pixels' must contain whole rows. Blocks
+    // while the writer is busy with earlier rows.
+    MMIMAGE_API_EXPORT
+    bool write_rows_f32x4(rust::Slice<const float> pixels) noexcept;
+
+    MMIMAGE_API_EXPORT
+    size_t rows_written() const noexcept;
+
+    // Wait for the file to be written. Returns false if writing
+    // failed, or not all rows were given.
+    MMIMAGE_API_EXPORT
+    bool finish() noexcept;
+
+private:
+    rust::Box<ShimImageExrStreamWriter> inner_;
+};
+
+}  // namespace mmimage
+
+#endif  // MM_IMAGE_IMAGE_EXR_STREAM_WRITER_H
@@ -61,12 +61,42 @@ public:
     MMIMAGE_API_EXPORT
     size_t pixel_count() noexcept;
 
+    MMIMAGE_API_EXPORT
+    const rust::Slice<const float> as_slice_f32() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Slice<float> as_slice_f32_mut() noexcept;
+
     MMIMAGE_API_EXPORT
     const rust::Slice<const PixelF32x4> as_slice_f32x4() noexcept;
 
     MMIMAGE_API_EXPORT
     rust::Slice<PixelF32x4> as_slice_f32x4_mut() noexcept;
 
+    MMIMAGE_API_EXPORT
+    const rust::Slice<const PixelF32x2> as_slice_f32x2() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Slice<PixelF32x2> as_slice_f32x2_mut() noexcept;
+
+    MMIMAGE_API_EXPORT
+    const rust::Slice<const PixelF16x4> as_slice_f16x4() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Slice<PixelF16x4> as_slice_f16x4_mut() noexcept;
+
+    MMIMAGE_API_EXPORT
+    const rust::Slice<const PixelF16x2> as_slice_f16x2() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Slice<PixelF16x2> as_slice_f16x2_mut() noexcept;
+
+    MMIMAGE_API_EXPORT
+    const rust::Slice<const PixelU8x4> as_slice_u8x4() noexcept;
+
+    MMIMAGE_API_EXPORT
+    rust::Slice<PixelU8x4> as_slice_u8x4_mut() noexcept;
+
     MMIMAGE_API_EXPORT
     void resize(const BufferDataType data_type, const size_t image_width,
                 const size_t image_height, const size_t num_channels) noexcept;
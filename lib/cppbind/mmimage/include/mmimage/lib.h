@@ -29,6 +29,7 @@
 #include "_cxxbridge.h"
 #include "_symbol_export.h"
 #include "_types.h"
+#include "imageexrstreamwriter.h"
 #include "imagemetadata.h"
 #include "imagepixelbuffer.h"
 #include "imagepixeldata.h"
@@ -41,15 +42,132 @@ namespace mmimage {
 bool image_read_metadata_exr(const rust::Str& file_path,
                              ImageMetaData& out_meta_data);
 
+// Read the metadata of frames 'start_frame' to 'end_frame'
+// (inclusive) of the EXR image sequence 'file_pattern' (the frame
+// number is written in place of the '#' characters), using
+// 'thread_count' threads (zero uses the default).
+//
+// Only the file headers are read. Missing frames are not an error;
+// they are reported in 'out_summary', along with frames that do not
+// match the first readable frame.
+bool image_read_metadata_exr_sequence(
+    const rust::Str& file_pattern, const int32_t start_frame,
+    const int32_t end_frame, const size_t thread_count,
+    rust::Vec<ImageSequenceFrameMetaData>& out_frames,
+    ImageSequenceMetaDataSummary& out_summary);
+
+// Does the file path end with the ".exr" file extension (in any
+// case)?
+bool is_exr_file_path(const rust::Str& file_path);
+
+// Replace the last run of '#' characters in 'file_pattern' with the
+// frame number, padded with zeros to the number of '#' characters.
+// As with printf-style "%04d", the '-' of a negative frame counts
+// towards the padding.
+//
+// For example "plate.####.exr" is "plate.0042.exr" at frame 42 and
+// "plate.-005.exr" at frame -5. The pattern is returned unchanged
+// if it does not contain '#'.
+rust::String image_sequence_frame_file_path(const rust::Str& file_pattern,
+                                            const int32_t frame);
+
 bool image_read_pixels_exr_f32x4(const rust::Str& file_path,
                                  ImageMetaData& out_meta_data,
                                  ImagePixelBuffer& out_pixel_data);
 
+// Read the RGBA pixels, keeping the data type of the file; half
+// float images are stored as BufferDataType::kF16, everything else
+// as BufferDataType::kF32.
+bool image_read_pixels_exr_rgba(const rust::Str& file_path,
+                                ImageMetaData& out_meta_data,
+                                ImagePixelBuffer& out_pixel_data);
+
+// Read the RGBA pixels of proxy level 'level' (see
+// 'image_write_proxy_levels_exr'). If that level has not been
+// written, the nearest lower level that exists is read, down to the
+// original image at level 0.
+bool image_read_pixels_exr_rgba_level(const rust::Str& file_path,
+                                      const uint8_t level,
+                                      ImageMetaData& out_meta_data,
+                                      ImagePixelBuffer& out_pixel_data);
+
+// Read only the pixels inside 'region' (relative to the top-left of
+// the EXR data window). 'out_pixel_data' is resized to the region.
+bool image_read_pixels_exr_region_f32x4(const rust::Str& file_path,
+                                        const ImageRegionRectangle& region,
+                                        ImageMetaData& out_meta_data,
+                                        ImagePixelBuffer& out_pixel_data);
+
+// Read a single named channel (for example "Z") into a one channel
+// pixel buffer.
+bool image_read_pixels_exr_channel_f32(const rust::Str& file_path,
+                                       const rust::Str& channel_name,
+                                       ImageMetaData& out_meta_data,
+                                       ImagePixelBuffer& out_pixel_data);
+
 bool image_write_pixels_exr_f32x4(const rust::Str& file_path,
                                   ImageExrEncoder exr_encoder,
                                   ImageMetaData& in_meta_data,
                                   ImagePixelBuffer& in_pixel_data);
 
+// Write the RGBA pixels, keeping the data type of the pixel buffer
+// (8-bit buffers are written as half float).
+bool image_write_pixels_exr_rgba(const rust::Str& file_path,
+                                 ImageExrEncoder exr_encoder,
+                                 ImageMetaData& in_meta_data,
+                                 ImagePixelBuffer& in_pixel_data);
+
+// Write downsampled proxy levels 1 to 'level_count' of an EXR
+// file. Level N is half the size of level N-1, and is written to
+// "<directory>/proxyN/<file name>", next to the original file.
+//
+// Returns the number of levels written; zero means failure.
+uint8_t image_write_proxy_levels_exr(const rust::Str& file_path,
+                                     ImageExrEncoder exr_encoder,
+                                     ImageResizeFilter filter,
+                                     const uint8_t level_count);
+
+// Resize the RGBA 32-bit float pixels 'src_pixels' ('src_width' x
+// 'src_height') to 'dst_width' x 'dst_height' pixels, into
+// 'dst_pixels', with separable filter passes. When down-sizing, the
+// filter is widened so that every source pixel contributes. The same
+// resize is used to write proxy levels.
+//
+// Returns false if any size is zero, or the slices are too small.
+bool image_resize_pixels_f32x4(rust::Slice<const float> src_pixels,
+                               const size_t src_width,
+                               const size_t src_height,
+                               ImageResizeFilter filter,
+                               const size_t dst_width,
+                               const size_t dst_height,
+                               rust::Slice<float> dst_pixels);
+
+// Convert the pixel values of 'in_pixel_data' into 'data_type' (one
+// of kF32, kF16 or kU8), in 'out_pixel_data'.
+//
+// 8-bit values map to 0.0-1.0; no colour space conversion is done.
+bool convert_pixel_buffer(ImagePixelBuffer& in_pixel_data,
+                          BufferDataType data_type,
+                          ImagePixelBuffer& out_pixel_data);
+
+// Resample rows of the RGBA 32-bit float image 'in_pixel_data' at
+// the (s, t) coordinates in 'st_coords', into 'out_pixels'.
+//
+// 'st_coords' contains 'st_coords_stride' values per output pixel,
+// the first two being the (s, t) coordinate, with (0, 0) at the
+// bottom-left of the image and (1, 1) at the top-right (the same as
+// an ST-map). 'out_pixels' must hold whole rows of
+// 'out_image_width' RGBA pixels. Rows are computed in parallel.
+//
+// Returns false, without writing any pixels, if 'st_coords' does not
+// hold exactly one coordinate for each pixel of 'out_pixels'.
+bool image_warp_rows_f32x4(ImagePixelBuffer& in_pixel_data,
+                           rust::Slice<const float> st_coords,
+                           const size_t st_coords_stride,
+                           ImageWarpFilter filter,
+                           const size_t out_image_width,
+                           rust::Slice<float> out_pixels);
+
 }  // namespace mmimage
 
 #endif  // MM_IMAGE_LIB_H
@@ -982,16 +982,25 @@ namespace mmimage {
   struct ExrPixelLayout;
   enum class ExrLineOrder : ::std::uint8_t;
   struct ImageExrEncoder;
+  enum class ImageResizeFilter : ::std::uint8_t;
+  enum class ImageWarpFilter : ::std::uint8_t;
   struct OptionF32;
   struct Vec2F32;
   struct Vec2I32;
   struct Box2F32;
   struct ImageRegionRectangle;
   struct PixelF32x4;
+  struct PixelF32x2;
+  struct PixelF16x4;
+  struct PixelF16x2;
+  struct PixelU8x4;
   struct PixelF64x2;
+  struct ImageSequenceFrameMetaData;
+  struct ImageSequenceMetaDataSummary;
   enum class BufferDataType : ::std::uint8_t;
   struct ShimImagePixelBuffer;
   struct ShimImageMetaData;
+  struct ShimImageExrStreamWriter;
 }
 
 namespace mmimage {
@@ -1080,6 +1089,25 @@ struct ImageExrEncoder final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$ImageExrEncoder
 
+#ifndef CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+#define CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+enum class ImageResizeFilter : ::std::uint8_t {
+  kBox = 0,
+  kLanczos3 = 1,
+  kBilinear = 2,
+  kUnknown = 255,
+};
+#endif // CXXBRIDGE1_ENUM_mmimage$ImageResizeFilter
+
+#ifndef CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+#define CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+enum class ImageWarpFilter : ::std::uint8_t {
+  kBilinear = 0,
+  kBicubic = 1,
+  kUnknown = 255,
+};
+#endif // CXXBRIDGE1_ENUM_mmimage$ImageWarpFilter
+
 #ifndef CXXBRIDGE1_STRUCT_mmimage$OptionF32
 #define CXXBRIDGE1_STRUCT_mmimage$OptionF32
 struct OptionF32 final {
@@ -1182,6 +1210,52 @@ struct PixelF32x4 final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$PixelF32x4
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+struct PixelF32x2 final {
+  float x;
+  float y;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF32x2
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+// A 16-bit (half) float pixel, with each channel stored as the
+// IEEE 754 binary16 bits.
+struct PixelF16x4 final {
+  ::std::uint16_t r;
+  ::std::uint16_t g;
+  ::std::uint16_t b;
+  ::std::uint16_t a;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF16x4
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+#define CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+struct PixelF16x2 final {
+  ::std::uint16_t x;
+  ::std::uint16_t y;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelF16x2
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+#define CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+struct PixelU8x4 final {
+  ::std::uint8_t r;
+  ::std::uint8_t g;
+  ::std::uint8_t b;
+  ::std::uint8_t a;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$PixelU8x4
+
 #ifndef CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 #define CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 struct PixelF64x2 final {
@@ -1198,12 +1272,46 @@ struct PixelF64x2 final {
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$PixelF64x2
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+#define CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+struct ImageSequenceFrameMetaData final {
+  ::std::int32_t frame;
+  bool exists;
+  ::mmimage::ImageRegionRectangle display_window;
+  ::mmimage::ImageRegionRectangle data_window;
+  float pixel_aspect;
+  ::std::size_t num_channels;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ImageSequenceFrameMetaData
+
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+#define CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+struct ImageSequenceMetaDataSummary final {
+  ::std::size_t frame_count;
+  ::std::size_t missing_frame_count;
+  ::std::int32_t first_missing_frame;
+  ::std::int32_t reference_frame;
+  ::mmimage::ImageRegionRectangle display_window;
+  float pixel_aspect;
+  ::std::size_t display_window_mismatch_count;
+  ::std::size_t data_window_mismatch_count;
+  ::std::size_t pixel_aspect_mismatch_count;
+  ::std::size_t num_channels_mismatch_count;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ImageSequenceMetaDataSummary
+
 #ifndef CXXBRIDGE1_ENUM_mmimage$BufferDataType
 #define CXXBRIDGE1_ENUM_mmimage$BufferDataType
 enum class BufferDataType : ::std::uint8_t {
   kNone = 0,
   kF32 = 1,
   kF64 = 2,
+  kF16 = 3,
+  kU8 = 4,
 };
 #endif // CXXBRIDGE1_ENUM_mmimage$BufferDataType
 
@@ -1216,8 +1324,18 @@ struct ShimImagePixelBuffer final : public ::rust::Opaque {
   MMIMAGE_API_EXPORT ::std::size_t num_channels() const noexcept;
   MMIMAGE_API_EXPORT ::std::size_t pixel_count() const noexcept;
   MMIMAGE_API_EXPORT ::std::size_t element_count() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const float> as_slice_f32() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<float> as_slice_f32_mut() noexcept;
   MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x4> as_slice_f32x4() const noexcept;
   MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x4> as_slice_f32x4_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x2> as_slice_f32x2() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x2> as_slice_f32x2_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x4> as_slice_f16x4() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x4> as_slice_f16x4_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x2> as_slice_f16x2() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x2> as_slice_f16x2_mut() noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelU8x4> as_slice_u8x4() const noexcept;
+  MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelU8x4> as_slice_u8x4_mut() noexcept;
   MMIMAGE_API_EXPORT void resize(::mmimage::BufferDataType data_type, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t num_channels) noexcept;
   ~ShimImagePixelBuffer() = delete;
 
@@ -1280,6 +1398,24 @@ private:
 };
 #endif // CXXBRIDGE1_STRUCT_mmimage$ShimImageMetaData
 
+#ifndef CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+#define CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+struct ShimImageExrStreamWriter final : public ::rust::Opaque {
+  MMIMAGE_API_EXPORT bool open(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, ::std::size_t image_width, ::std::size_t image_height) noexcept;
+  MMIMAGE_API_EXPORT bool write_rows_f32x4(::rust::Slice<const float> pixels) noexcept;
+  MMIMAGE_API_EXPORT ::std::size_t rows_written() const noexcept;
+  MMIMAGE_API_EXPORT bool finish() noexcept;
+  ~ShimImageExrStreamWriter() = delete;
+
+private:
+  friend ::rust::layout;
+  struct layout {
+    static ::std::size_t size() noexcept;
+    static ::std::size_t align() noexcept;
+  };
+};
+#endif // CXXBRIDGE1_STRUCT_mmimage$ShimImageExrStreamWriter
+
 extern "C" {
 bool mmimage$cxxbridge1$ExrPixelLayout$operator$eq(const ExrPixelLayout &, const ExrPixelLayout &) noexcept;
 bool mmimage$cxxbridge1$ExrPixelLayout$operator$ne(const ExrPixelLayout &, const ExrPixelLayout &) noexcept;
@@ -1346,13 +1482,35 @@ bool mmimage$cxxbridge1$PixelF64x2$operator$ge(const PixelF64x2 &, const PixelF6
 
 ::std::size_t mmimage$cxxbridge1$ShimImagePixelBuffer$element_count(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
 
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
+
 ::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x4(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
 
 ::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x4_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
 
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x2(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x2_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x4(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x4_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x2(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x2_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_u8x4(const ::mmimage::ShimImagePixelBuffer &self) noexcept;
+
+::rust::repr::Fat mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_u8x4_mut(::mmimage::ShimImagePixelBuffer &self) noexcept;
+
 void mmimage$cxxbridge1$ShimImagePixelBuffer$resize(::mmimage::ShimImagePixelBuffer &self, ::mmimage::BufferDataType data_type, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t num_channels) noexcept;
 
 ::mmimage::ShimImagePixelBuffer *mmimage$cxxbridge1$shim_create_image_pixel_buffer_box() noexcept;
+
+bool mmimage$cxxbridge1$shim_convert_pixel_buffer(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::mmimage::BufferDataType data_type, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
 ::std::size_t mmimage$cxxbridge1$ShimImageMetaData$operator$sizeof() noexcept;
 ::std::size_t mmimage$cxxbridge1$ShimImageMetaData$operator$alignof() noexcept;
 
@@ -1429,12 +1587,46 @@ void mmimage$cxxbridge1$ShimImageMetaData$get_named_attribute_as_string(const ::
 void mmimage$cxxbridge1$ShimImageMetaData$as_string(const ::mmimage::ShimImageMetaData &self, ::rust::String *return$) noexcept;
 
 ::mmimage::ShimImageMetaData *mmimage$cxxbridge1$shim_create_image_meta_data_box() noexcept;
+::std::size_t mmimage$cxxbridge1$ShimImageExrStreamWriter$operator$sizeof() noexcept;
+::std::size_t mmimage$cxxbridge1$ShimImageExrStreamWriter$operator$alignof() noexcept;
+
+bool mmimage$cxxbridge1$ShimImageExrStreamWriter$open(::mmimage::ShimImageExrStreamWriter &self, ::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, ::std::size_t image_width, ::std::size_t image_height) noexcept;
+
+bool mmimage$cxxbridge1$ShimImageExrStreamWriter$write_rows_f32x4(::mmimage::ShimImageExrStreamWriter &self, ::rust::Slice<const float> pixels) noexcept;
+
+::std::size_t mmimage$cxxbridge1$ShimImageExrStreamWriter$rows_written(const ::mmimage::ShimImageExrStreamWriter &self) noexcept;
+
+bool mmimage$cxxbridge1$ShimImageExrStreamWriter$finish(::mmimage::ShimImageExrStreamWriter &self) noexcept;
+
+::mmimage::ShimImageExrStreamWriter *mmimage$cxxbridge1$shim_create_image_exr_stream_writer_box() noexcept;
 
 bool mmimage$cxxbridge1$shim_image_read_pixels_exr_f32x4(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
 
+bool mmimage$cxxbridge1$shim_image_read_pixels_exr_rgba(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_read_pixels_exr_rgba_level(::rust::Str file_path, ::std::uint8_t level, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_read_pixels_exr_region_f32x4(::rust::Str file_path, ::mmimage::ImageRegionRectangle region, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_read_pixels_exr_channel_f32(::rust::Str file_path, ::rust::Str channel_name, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept;
+
 bool mmimage$cxxbridge1$shim_image_read_metadata_exr(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data) noexcept;
 
+bool mmimage$cxxbridge1$shim_image_read_metadata_exr_sequence(::rust::Str file_pattern, ::std::int32_t start_frame, ::std::int32_t end_frame, ::std::size_t thread_count, ::rust::Vec<::mmimage::ImageSequenceFrameMetaData> &out_frames, ::mmimage::ImageSequenceMetaDataSummary &out_summary) noexcept;
+
+bool mmimage$cxxbridge1$shim_is_exr_file_path(::rust::Str file_path) noexcept;
+
+void mmimage$cxxbridge1$shim_image_sequence_frame_file_path(::rust::Str file_pattern, ::std::int32_t frame, ::rust::String *return$) noexcept;
+
 bool mmimage$cxxbridge1$shim_image_write_pixels_exr_f32x4(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_write_pixels_exr_rgba(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept;
+
+::std::uint8_t mmimage$cxxbridge1$shim_image_write_proxy_levels_exr(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, ::mmimage::ImageResizeFilter filter, ::std::uint8_t level_count) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_resize_pixels_f32x4(::rust::Slice<const float> src_pixels, ::std::size_t src_width, ::std::size_t src_height, ::mmimage::ImageResizeFilter filter, ::std::size_t dst_width, ::std::size_t dst_height, ::rust::Slice<float> dst_pixels) noexcept;
+
+bool mmimage$cxxbridge1$shim_image_warp_rows_f32x4(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::rust::Slice<const float> st_coords, ::std::size_t st_coords_stride, ::mmimage::ImageWarpFilter filter, ::std::size_t out_image_width, ::rust::Slice<float> out_pixels) noexcept;
 } // extern "C"
 } // namespace mmimage
 
@@ -1701,6 +1893,14 @@ MMIMAGE_API_EXPORT ::std::size_t ShimImagePixelBuffer::element_count() const noe
   return mmimage$cxxbridge1$ShimImagePixelBuffer$element_count(*this);
 }
 
+MMIMAGE_API_EXPORT ::rust::Slice<const float> ShimImagePixelBuffer::as_slice_f32() const noexcept {
+  return ::rust::impl<::rust::Slice<const float>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<float> ShimImagePixelBuffer::as_slice_f32_mut() noexcept {
+  return ::rust::impl<::rust::Slice<float>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32_mut(*this));
+}
+
 MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x4> ShimImagePixelBuffer::as_slice_f32x4() const noexcept {
   return ::rust::impl<::rust::Slice<const ::mmimage::PixelF32x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x4(*this));
 }
@@ -1709,6 +1909,38 @@ MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x4> ShimImagePixelBuffer::as
   return ::rust::impl<::rust::Slice<::mmimage::PixelF32x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x4_mut(*this));
 }
 
+MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF32x2> ShimImagePixelBuffer::as_slice_f32x2() const noexcept {
+  return ::rust::impl<::rust::Slice<const ::mmimage::PixelF32x2>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x2(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF32x2> ShimImagePixelBuffer::as_slice_f32x2_mut() noexcept {
+  return ::rust::impl<::rust::Slice<::mmimage::PixelF32x2>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f32x2_mut(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x4> ShimImagePixelBuffer::as_slice_f16x4() const noexcept {
+  return ::rust::impl<::rust::Slice<const ::mmimage::PixelF16x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x4(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x4> ShimImagePixelBuffer::as_slice_f16x4_mut() noexcept {
+  return ::rust::impl<::rust::Slice<::mmimage::PixelF16x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x4_mut(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelF16x2> ShimImagePixelBuffer::as_slice_f16x2() const noexcept {
+  return ::rust::impl<::rust::Slice<const ::mmimage::PixelF16x2>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x2(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelF16x2> ShimImagePixelBuffer::as_slice_f16x2_mut() noexcept {
+  return ::rust::impl<::rust::Slice<::mmimage::PixelF16x2>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_f16x2_mut(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<const ::mmimage::PixelU8x4> ShimImagePixelBuffer::as_slice_u8x4() const noexcept {
+  return ::rust::impl<::rust::Slice<const ::mmimage::PixelU8x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_u8x4(*this));
+}
+
+MMIMAGE_API_EXPORT ::rust::Slice<::mmimage::PixelU8x4> ShimImagePixelBuffer::as_slice_u8x4_mut() noexcept {
+  return ::rust::impl<::rust::Slice<::mmimage::PixelU8x4>>::slice(mmimage$cxxbridge1$ShimImagePixelBuffer$as_slice_u8x4_mut(*this));
+}
+
 MMIMAGE_API_EXPORT void ShimImagePixelBuffer::resize(::mmimage::BufferDataType data_type, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t num_channels) noexcept {
   mmimage$cxxbridge1$ShimImagePixelBuffer$resize(*this, data_type, image_width, image_height, num_channels);
 }
@@ -1717,6 +1949,10 @@ MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImagePixelBuffer> shim_create_imag
   return ::rust::Box<::mmimage::ShimImagePixelBuffer>::from_raw(mmimage$cxxbridge1$shim_create_image_pixel_buffer_box());
 }
 
+MMIMAGE_API_EXPORT bool shim_convert_pixel_buffer(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::mmimage::BufferDataType data_type, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_convert_pixel_buffer(in_pixel_buffer, data_type, out_pixel_buffer);
+}
+
 ::std::size_t ShimImageMetaData::layout::size() noexcept {
   return mmimage$cxxbridge1$ShimImageMetaData$operator$sizeof();
 }
@@ -1879,17 +2115,91 @@ MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImageMetaData> shim_create_image_m
   return ::rust::Box<::mmimage::ShimImageMetaData>::from_raw(mmimage$cxxbridge1$shim_create_image_meta_data_box());
 }
 
+::std::size_t ShimImageExrStreamWriter::layout::size() noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$operator$sizeof();
+}
+
+::std::size_t ShimImageExrStreamWriter::layout::align() noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$operator$alignof();
+}
+
+MMIMAGE_API_EXPORT bool ShimImageExrStreamWriter::open(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, ::std::size_t image_width, ::std::size_t image_height) noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$open(*this, file_path, exr_encoder, in_meta_data, image_width, image_height);
+}
+
+MMIMAGE_API_EXPORT bool ShimImageExrStreamWriter::write_rows_f32x4(::rust::Slice<const float> pixels) noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$write_rows_f32x4(*this, pixels);
+}
+
+MMIMAGE_API_EXPORT ::std::size_t ShimImageExrStreamWriter::rows_written() const noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$rows_written(*this);
+}
+
+MMIMAGE_API_EXPORT bool ShimImageExrStreamWriter::finish() noexcept {
+  return mmimage$cxxbridge1$ShimImageExrStreamWriter$finish(*this);
+}
+
+MMIMAGE_API_EXPORT ::rust::Box<::mmimage::ShimImageExrStreamWriter> shim_create_image_exr_stream_writer_box() noexcept {
+  return ::rust::Box<::mmimage::ShimImageExrStreamWriter>::from_raw(mmimage$cxxbridge1$shim_create_image_exr_stream_writer_box());
+}
+
 MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_f32x4(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
   return mmimage$cxxbridge1$shim_image_read_pixels_exr_f32x4(file_path, out_meta_data, out_pixel_buffer);
 }
 
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_rgba(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_image_read_pixels_exr_rgba(file_path, out_meta_data, out_pixel_buffer);
+}
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_rgba_level(::rust::Str file_path, ::std::uint8_t level, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_image_read_pixels_exr_rgba_level(file_path, level, out_meta_data, out_pixel_buffer);
+}
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_region_f32x4(::rust::Str file_path, ::mmimage::ImageRegionRectangle region, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_image_read_pixels_exr_region_f32x4(file_path, region, out_meta_data, out_pixel_buffer);
+}
+
+MMIMAGE_API_EXPORT bool shim_image_read_pixels_exr_channel_f32(::rust::Str file_path, ::rust::Str channel_name, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data, ::rust::Box<::mmimage::ShimImagePixelBuffer> &out_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_image_read_pixels_exr_channel_f32(file_path, channel_name, out_meta_data, out_pixel_buffer);
+}
+
 MMIMAGE_API_EXPORT bool shim_image_read_metadata_exr(::rust::Str file_path, ::rust::Box<::mmimage::ShimImageMetaData> &out_meta_data) noexcept {
   return mmimage$cxxbridge1$shim_image_read_metadata_exr(file_path, out_meta_data);
 }
 
+MMIMAGE_API_EXPORT bool shim_image_read_metadata_exr_sequence(::rust::Str file_pattern, ::std::int32_t start_frame, ::std::int32_t end_frame, ::std::size_t thread_count, ::rust::Vec<::mmimage::ImageSequenceFrameMetaData> &out_frames, ::mmimage::ImageSequenceMetaDataSummary &out_summary) noexcept {
+  return mmimage$cxxbridge1$shim_image_read_metadata_exr_sequence(file_pattern, start_frame, end_frame, thread_count, out_frames, out_summary);
+}
+
+MMIMAGE_API_EXPORT bool shim_is_exr_file_path(::rust::Str file_path) noexcept {
+  return mmimage$cxxbridge1$shim_is_exr_file_path(file_path);
+}
+
+MMIMAGE_API_EXPORT ::rust::String shim_image_sequence_frame_file_path(::rust::Str file_pattern, ::std::int32_t frame) noexcept {
+  ::rust::MaybeUninit<::rust::String> return$;
+  mmimage$cxxbridge1$shim_image_sequence_frame_file_path(file_pattern, frame, &return$.value);
+  return ::std::move(return$.value);
+}
+
 MMIMAGE_API_EXPORT bool shim_image_write_pixels_exr_f32x4(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept {
   return mmimage$cxxbridge1$shim_image_write_pixels_exr_f32x4(file_path, exr_encoder, in_meta_data, in_pixel_buffer);
 }
+
+MMIMAGE_API_EXPORT bool shim_image_write_pixels_exr_rgba(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, const ::rust::Box<::mmimage::ShimImageMetaData> &in_meta_data, const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer) noexcept {
+  return mmimage$cxxbridge1$shim_image_write_pixels_exr_rgba(file_path, exr_encoder, in_meta_data, in_pixel_buffer);
+}
+
+MMIMAGE_API_EXPORT ::std::uint8_t shim_image_write_proxy_levels_exr(::rust::Str file_path, ::mmimage::ImageExrEncoder exr_encoder, ::mmimage::ImageResizeFilter filter, ::std::uint8_t level_count) noexcept {
+  return mmimage$cxxbridge1$shim_image_write_proxy_levels_exr(file_path, exr_encoder, filter, level_count);
+}
+
+MMIMAGE_API_EXPORT bool shim_image_resize_pixels_f32x4(::rust::Slice<const float> src_pixels, ::std::size_t src_width, ::std::size_t src_height, ::mmimage::ImageResizeFilter filter, ::std::size_t dst_width, ::std::size_t dst_height, ::rust::Slice<float> dst_pixels) noexcept {
+  return mmimage$cxxbridge1$shim_image_resize_pixels_f32x4(src_pixels, src_width, src_height, filter, dst_width, dst_height, dst_pixels);
+}
+
+MMIMAGE_API_EXPORT bool shim_image_warp_rows_f32x4(const ::rust::Box<::mmimage::ShimImagePixelBuffer> &in_pixel_buffer, ::rust::Slice<const float> st_coords, ::std::size_t st_coords_stride, ::mmimage::ImageWarpFilter filter, ::std::size_t out_image_width, ::rust::Slice<float> out_pixels) noexcept {
+  return mmimage$cxxbridge1$shim_image_warp_rows_f32x4(in_pixel_buffer, st_coords, st_coords_stride, filter, out_image_width, out_pixels);
+}
 } // namespace mmimage
 
 extern "C" {
@@ -1900,6 +2210,19 @@ void cxxbridge1$box$mmimage$ShimImagePixelBuffer$drop(::rust::Box<::mmimage::Shi
 ::mmimage::ShimImageMetaData *cxxbridge1$box$mmimage$ShimImageMetaData$alloc() noexcept;
 void cxxbridge1$box$mmimage$ShimImageMetaData$dealloc(::mmimage::ShimImageMetaData *) noexcept;
 void cxxbridge1$box$mmimage$ShimImageMetaData$drop(::rust::Box<::mmimage::ShimImageMetaData> *ptr) noexcept;
+
+::mmimage::ShimImageExrStreamWriter *cxxbridge1$box$mmimage$ShimImageExrStreamWriter$alloc() noexcept;
+void cxxbridge1$box$mmimage$ShimImageExrStreamWriter$dealloc(::mmimage::ShimImageExrStreamWriter *) noexcept;
+void cxxbridge1$box$mmimage$ShimImageExrStreamWriter$drop(::rust::Box<::mmimage::ShimImageExrStreamWriter> *ptr) noexcept;
+
+void cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$new(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> const *ptr) noexcept;
+void cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$drop(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> *ptr) noexcept;
+::std::size_t cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$len(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> const *ptr) noexcept;
+::std::size_t cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$capacity(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> const *ptr) noexcept;
+::mmimage::ImageSequenceFrameMetaData const *cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$data(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> const *ptr) noexcept;
+void cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$reserve_total(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> *ptr, ::std::size_t new_cap) noexcept;
+void cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$set_len(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> *ptr, ::std::size_t len) noexcept;
+void cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$truncate(::rust::Vec<::mmimage::ImageSequenceFrameMetaData> *ptr, ::std::size_t len) noexcept;
 } // extern "C"
 
 namespace rust {
@@ -1928,5 +2251,49 @@ template <>
 MMIMAGE_API_EXPORT void Box<::mmimage::ShimImageMetaData>::drop() noexcept {
   cxxbridge1$box$mmimage$ShimImageMetaData$drop(this);
 }
+template <>
+MMIMAGE_API_EXPORT ::mmimage::ShimImageExrStreamWriter *Box<::mmimage::ShimImageExrStreamWriter>::allocation::alloc() noexcept {
+  return cxxbridge1$box$mmimage$ShimImageExrStreamWriter$alloc();
+}
+template <>
+MMIMAGE_API_EXPORT void Box<::mmimage::ShimImageExrStreamWriter>::allocation::dealloc(::mmimage::ShimImageExrStreamWriter *ptr) noexcept {
+  cxxbridge1$box$mmimage$ShimImageExrStreamWriter$dealloc(ptr);
+}
+template <>
+MMIMAGE_API_EXPORT void Box<::mmimage::ShimImageExrStreamWriter>::drop() noexcept {
+  cxxbridge1$box$mmimage$ShimImageExrStreamWriter$drop(this);
+}
+template <>
+MMIMAGE_API_EXPORT Vec<::mmimage::ImageSequenceFrameMetaData>::Vec() noexcept {
+  cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$new(this);
+}
+template <>
+MMIMAGE_API_EXPORT void Vec<::mmimage::ImageSequenceFrameMetaData>::drop() noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$drop(this);
+}
+template <>
+MMIMAGE_API_EXPORT ::std::size_t Vec<::mmimage::ImageSequenceFrameMetaData>::size() const noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$len(this);
+}
+template <>
+MMIMAGE_API_EXPORT ::std::size_t Vec<::mmimage::ImageSequenceFrameMetaData>::capacity() const noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$capacity(this);
+}
+template <>
+MMIMAGE_API_EXPORT ::mmimage::ImageSequenceFrameMetaData const *Vec<::mmimage::ImageSequenceFrameMetaData>::data() const noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$data(this);
+}
+template <>
+MMIMAGE_API_EXPORT void Vec<::mmimage::ImageSequenceFrameMetaData>::reserve_total(::std::size_t new_cap) noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$reserve_total(this, new_cap);
+}
+template <>
+MMIMAGE_API_EXPORT void Vec<::mmimage::ImageSequenceFrameMetaData>::set_len(::std::size_t len) noexcept {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$set_len(this, len);
+}
+template <>
+MMIMAGE_API_EXPORT void Vec<::mmimage::ImageSequenceFrameMetaData>::truncate(::std::size_t len) {
+  return cxxbridge1$rust_vec$mmimage$ImageSequenceFrameMetaData$truncate(this, len);
+}
 } // namespace cxxbridge1
 } // namespace rust
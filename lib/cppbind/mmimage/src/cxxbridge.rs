@@ -18,13 +18,23 @@
 // ====================================================================
 //
 
+use crate::imageexrstreamwriter::shim_create_image_exr_stream_writer_box;
+use crate::imageexrstreamwriter::ShimImageExrStreamWriter;
 use crate::imagemetadata::shim_create_image_meta_data_box;
 use crate::imagemetadata::ShimImageMetaData;
+use crate::imagepixelbuffer::shim_convert_pixel_buffer;
 use crate::imagepixelbuffer::shim_create_image_pixel_buffer_box;
 use crate::imagepixelbuffer::ShimImagePixelBuffer;
 use crate::shim_image_read_metadata_exr;
+use crate::shim_image_read_pixels_exr_channel_f32;
 use crate::shim_image_read_pixels_exr_f32x4;
+use crate::shim_image_read_pixels_exr_region_f32x4;
+use crate::shim_image_read_pixels_exr_rgba;
+use crate::shim_image_read_pixels_exr_rgba_level;
+use crate::shim_image_warp_rows_f32x4;
 use crate::shim_image_write_pixels_exr_f32x4;
+use crate::shim_image_write_pixels_exr_rgba;
+use crate::shim_image_write_proxy_levels_exr;
 
 #[cxx::bridge(namespace = "mmimage")]
 pub mod ffi {
@@ -145,6 +155,35 @@ pub mod ffi {
         line_order: ExrLineOrder,
     }
 
+    #[repr(u8)]
+    #[derive(Debug, Copy, Clone, Hash, Eq, PartialEq, Ord, PartialOrd)]
+    pub(crate) enum ImageResizeFilter {
+        #[cxx_name = "kBox"]
+        Box = 0,
+
+        #[cxx_name = "kLanczos3"]
+        Lanczos3 = 1,
+
+        #[cxx_name = "kBilinear"]
+        Bilinear = 2,
+
+        #[cxx_name = "kUnknown"]
+        Unknown = 255,
+    }
+
+    #[repr(u8)]
+    #[derive(Debug, Copy, Clone, Hash, Eq, PartialEq, Ord, PartialOrd)]
+    pub(crate) enum ImageWarpFilter {
+        #[cxx_name = "kBilinear"]
+        Bilinear = 0,
+
+        #[cxx_name = "kBicubic"]
+        Bicubic = 1,
+
+        #[cxx_name = "kUnknown"]
+        Unknown = 255,
+    }
+
     #[derive(Debug, Copy, Clone, PartialEq, PartialOrd)]
     struct OptionF32 {
         exists: bool,
@@ -187,12 +226,67 @@ pub mod ffi {
         a: f32,
     }
 
+    #[derive(Debug, Copy, Clone)]
+    struct PixelF32x2 {
+        x: f32,
+        y: f32,
+    }
+
+    /// A 16-bit (half) float pixel, with each channel stored as the
+    /// IEEE 754 binary16 bits.
+    #[derive(Debug, Copy, Clone)]
+    struct PixelF16x4 {
+        r: u16,
+        g: u16,
+        b: u16,
+        a: u16,
+    }
+
+    #[derive(Debug, Copy, Clone)]
+    struct PixelF16x2 {
+        x: u16,
+        y: u16,
+    }
+
+    #[derive(Debug, Copy, Clone)]
+    struct PixelU8x4 {
+        r: u8,
+        g: u8,
+        b: u8,
+        a: u8,
+    }
+
     #[derive(Debug, Copy, Clone, PartialEq, PartialOrd)]
     struct PixelF64x2 {
         x: f64,
         y: f64,
     }
 
+    #[derive(Debug, Copy, Clone)]
+    struct ImageSequenceFrameMetaData {
+        frame: i32,
+        exists: bool,
+        display_window: ImageRegionRectangle,
+        data_window: ImageRegionRectangle,
+        pixel_aspect: f32,
+        num_channels: usize,
+        consistent: bool,
+    }
+
+    #[derive(Debug, Copy, Clone)]
+    struct ImageSequenceMetaDataSummary {
+        frame_count: usize,
+        missing_frame_count: usize,
+        first_missing_frame: i32,
+        reference_frame: i32,
+        display_window: ImageRegionRectangle,
+        pixel_aspect: f32,
+        display_window_mismatch_count: usize,
+        data_window_mismatch_count: usize,
+        pixel_aspect_mismatch_count: usize,
+        num_channels_mismatch_count: usize,
+    }
+
     #[repr(u8)]
     #[derive(Debug, Copy, Clone)]
     pub(crate) enum BufferDataType {
@@ -204,6 +298,12 @@ pub mod ffi {
 
         #[cxx_name = "kF64"]
         F64 = 2,
+
+        #[cxx_name = "kF16"]
+        F16 = 3,
+
+        #[cxx_name = "kU8"]
+        U8 = 4,
     }
 
     extern "Rust" {
@@ -217,8 +317,18 @@ pub mod ffi {
         pub fn pixel_count(&self) -> usize;
         pub fn element_count(&self) -> usize;
 
+        pub fn as_slice_f32(&self) -> &[f32];
+        pub fn as_slice_f32_mut(&mut self) -> &mut [f32];
         pub fn as_slice_f32x4(&self) -> &[PixelF32x4];
         pub fn as_slice_f32x4_mut(&mut self) -> &mut [PixelF32x4];
+        pub fn as_slice_f32x2(&self) -> &[PixelF32x2];
+        pub fn as_slice_f32x2_mut(&mut self) -> &mut [PixelF32x2];
+        pub fn as_slice_f16x4(&self) -> &[PixelF16x4];
+        pub fn as_slice_f16x4_mut(&mut self) -> &mut [PixelF16x4];
+        pub fn as_slice_f16x2(&self) -> &[PixelF16x2];
+        pub fn as_slice_f16x2_mut(&mut self) -> &mut [PixelF16x2];
+        pub fn as_slice_u8x4(&self) -> &[PixelU8x4];
+        pub fn as_slice_u8x4_mut(&mut self) -> &mut [PixelU8x4];
 
         pub fn resize(
             &mut self,
@@ -229,6 +339,12 @@ pub mod ffi {
         );
 
         fn shim_create_image_pixel_buffer_box() -> Box<ShimImagePixelBuffer>;
+
+        fn shim_convert_pixel_buffer(
+            in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+            data_type: BufferDataType,
+            out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+        ) -> bool;
     }
 
     extern "Rust" {
@@ -278,6 +394,25 @@ pub mod ffi {
         fn shim_create_image_meta_data_box() -> Box<ShimImageMetaData>;
     }
 
+    extern "Rust" {
+        type ShimImageExrStreamWriter;
+
+        fn open(
+            &mut self,
+            file_path: &str,
+            exr_encoder: ImageExrEncoder,
+            in_meta_data: &Box<ShimImageMetaData>,
+            image_width: usize,
+            image_height: usize,
+        ) -> bool;
+        fn write_rows_f32x4(&mut self, pixels: &[f32]) -> bool;
+        fn rows_written(&self) -> usize;
+        fn finish(&mut self) -> bool;
+
+        fn shim_create_image_exr_stream_writer_box(
+        ) -> Box<ShimImageExrStreamWriter>;
+    }
+
     extern "Rust" {
         fn shim_image_read_pixels_exr_f32x4(
             file_path: &str,
@@ -285,16 +420,92 @@ pub mod ffi {
             out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
         ) -> bool;
 
+        fn shim_image_read_pixels_exr_rgba(
+            file_path: &str,
+            out_meta_data: &mut Box<ShimImageMetaData>,
+            out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+        ) -> bool;
+
+        fn shim_image_read_pixels_exr_rgba_level(
+            file_path: &str,
+            level: u8,
+            out_meta_data: &mut Box<ShimImageMetaData>,
+            out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+        ) -> bool;
+
+        fn shim_image_read_pixels_exr_region_f32x4(
+            file_path: &str,
+            region: ImageRegionRectangle,
+            out_meta_data: &mut Box<ShimImageMetaData>,
+            out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+        ) -> bool;
+
+        fn shim_image_read_pixels_exr_channel_f32(
+            file_path: &str,
+            channel_name: &str,
+            out_meta_data: &mut Box<ShimImageMetaData>,
+            out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+        ) -> bool;
+
         fn shim_image_read_metadata_exr(
             file_path: &str,
             out_meta_data: &mut Box<ShimImageMetaData>,
         ) -> bool;
 
+        fn shim_image_read_metadata_exr_sequence(
+            file_pattern: &str,
+            start_frame: i32,
+            end_frame: i32,
+            thread_count: usize,
+            out_frames: &mut Vec<ImageSequenceFrameMetaData>,
+            out_summary: &mut ImageSequenceMetaDataSummary,
+        ) -> bool;
+
+        fn shim_is_exr_file_path(file_path: &str) -> bool;
+
+        fn shim_image_sequence_frame_file_path(
+            file_pattern: &str,
+            frame: i32,
+        ) -> String;
+
         fn shim_image_write_pixels_exr_f32x4(
             file_path: &str,
             exr_encoder: ImageExrEncoder,
             in_meta_data: &Box<ShimImageMetaData>,
             in_pixel_buffer: &Box<ShimImagePixelBuffer>,
         ) -> bool;
+
+        fn shim_image_write_pixels_exr_rgba(
+            file_path: &str,
+            exr_encoder: ImageExrEncoder,
+            in_meta_data: &Box<ShimImageMetaData>,
+            in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+        ) -> bool;
+
+        fn shim_image_write_proxy_levels_exr(
+            file_path: &str,
+            exr_encoder: ImageExrEncoder,
+            filter: ImageResizeFilter,
+            level_count: u8,
+        ) -> u8;
+
+        fn shim_image_resize_pixels_f32x4(
+            src_pixels: &[f32],
+            src_width: usize,
+            src_height: usize,
+            filter: ImageResizeFilter,
+            dst_width: usize,
+            dst_height: usize,
+            dst_pixels: &mut [f32],
+        ) -> bool;
+
+        fn shim_image_warp_rows_f32x4(
+            in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+            st_coords: &[f32],
+            st_coords_stride: usize,
+            filter: ImageWarpFilter,
+            out_image_width: usize,
+            out_pixels: &mut [f32],
+        ) -> bool;
     }
 }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include <mmimage/imageexrstreamwriter.h>
+#include <mmimage/lib.h>
+
+namespace mmimage {
+
+ImageExrStreamWriter::ImageExrStreamWriter() noexcept
+    : inner_(shim_create_image_exr_stream_writer_box()) {}
+
+rust::Box<ShimImageExrStreamWriter> ImageExrStreamWriter::get_inner() noexcept {
+    return std::move(inner_);
+}
+
+void ImageExrStreamWriter::set_inner(
+    rust::Box<ShimImageExrStreamWriter> &value) noexcept {
+    inner_ = std::move(value);
+    return;
+}
+
+bool ImageExrStreamWriter::open(const rust::Str &file_path,
+                                ImageExrEncoder exr_encoder,
+                                ImageMetaData &in_meta_data,
+                                const size_t image_width,
+                                const size_t image_height) noexcept {
+    auto inner_meta_data = in_meta_data.get_inner();
+    bool result = inner_->open(file_path, exr_encoder, inner_meta_data,
+                               image_width, image_height);
+    in_meta_data.set_inner(inner_meta_data);
+    return result;
+}
+
+bool ImageExrStreamWriter::write_rows_f32x4(
+    rust::Slice<const float> pixels) noexcept {
+    return inner_->write_rows_f32x4(pixels);
+}
+
+size_t ImageExrStreamWriter::rows_written() const noexcept {
+    return inner_->rows_written();
+}
+
+bool ImageExrStreamWriter::finish() noexcept { return inner_->finish(); }
+
+}  // namespace mmimage
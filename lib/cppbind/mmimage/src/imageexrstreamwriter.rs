@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::cxxbridge::ffi::ImageExrEncoder as BindImageExrEncoder;
+use crate::encoder::bind_to_core_image_exr_encoder;
+use crate::imagemetadata::ShimImageMetaData;
+
+use mmimage_rust::stream::ImageExrStreamWriter as CoreImageExrStreamWriter;
+
+pub struct ShimImageExrStreamWriter {
+    inner: CoreImageExrStreamWriter,
+}
+
+impl ShimImageExrStreamWriter {
+    pub fn new() -> Self {
+        Self {
+            inner: CoreImageExrStreamWriter::new(),
+        }
+    }
+
+    pub fn open(
+        &mut self,
+        file_path: &str,
+        exr_encoder: BindImageExrEncoder,
+        in_meta_data: &Box<ShimImageMetaData>,
+        image_width: usize,
+        image_height: usize,
+    ) -> bool {
+        let exr_encoder = bind_to_core_image_exr_encoder(exr_encoder);
+        let result = self.inner.open(
+            file_path,
+            exr_encoder,
+            in_meta_data.get_inner(),
+            image_width,
+            image_height,
+        );
+        result.is_ok()
+    }
+
+    pub fn write_rows_f32x4(&mut self, pixels: &[f32]) -> bool {
+        self.inner.write_rows_f32x4(pixels).is_ok()
+    }
+
+    pub fn rows_written(&self) -> usize {
+        self.inner.rows_written()
+    }
+
+    pub fn finish(&mut self) -> bool {
+        self.inner.finish().is_ok()
+    }
+}
+
+pub fn shim_create_image_exr_stream_writer_box() -> Box<ShimImageExrStreamWriter>
+{
+    Box::new(ShimImageExrStreamWriter::new())
+}
@@ -71,6 +71,14 @@ void ImagePixelBuffer::resize(const BufferDataType data_type,
     return inner_->resize(data_type, image_width, image_height, num_channels);
 }
 
+const rust::Slice<const float> ImagePixelBuffer::as_slice_f32() noexcept {
+    return inner_->as_slice_f32();
+}
+
+rust::Slice<float> ImagePixelBuffer::as_slice_f32_mut() noexcept {
+    return inner_->as_slice_f32_mut();
+}
+
 const rust::Slice<const PixelF32x4>
 ImagePixelBuffer::as_slice_f32x4() noexcept {
     return inner_->as_slice_f32x4();
@@ -80,4 +88,39 @@ rust::Slice<PixelF32x4> ImagePixelBuffer::as_slice_f32x4_mut() noexcept {
     return inner_->as_slice_f32x4_mut();
 }
 
+const rust::Slice<const PixelF32x2>
+ImagePixelBuffer::as_slice_f32x2() noexcept {
+    return inner_->as_slice_f32x2();
+}
+
+rust::Slice<PixelF32x2> ImagePixelBuffer::as_slice_f32x2_mut() noexcept {
+    return inner_->as_slice_f32x2_mut();
+}
+
+const rust::Slice<const PixelF16x4>
+ImagePixelBuffer::as_slice_f16x4() noexcept {
+    return inner_->as_slice_f16x4();
+}
+
+rust::Slice<PixelF16x4> ImagePixelBuffer::as_slice_f16x4_mut() noexcept {
+    return inner_->as_slice_f16x4_mut();
+}
+
+const rust::Slice<const PixelF16x2>
+ImagePixelBuffer::as_slice_f16x2() noexcept {
+    return inner_->as_slice_f16x2();
+}
+
+rust::Slice<PixelF16x2> ImagePixelBuffer::as_slice_f16x2_mut() noexcept {
+    return inner_->as_slice_f16x2_mut();
+}
+
+const rust::Slice<const PixelU8x4> ImagePixelBuffer::as_slice_u8x4() noexcept {
+    return inner_->as_slice_u8x4();
+}
+
+rust::Slice<PixelU8x4> ImagePixelBuffer::as_slice_u8x4_mut() noexcept {
+    return inner_->as_slice_u8x4_mut();
+}
+
 }  // namespace mmimage
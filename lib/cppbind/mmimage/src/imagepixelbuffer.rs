@@ -19,19 +19,27 @@
 //
 
 use crate::cxxbridge::ffi::BufferDataType as BindBufferDataType;
+use crate::cxxbridge::ffi::PixelF16x2 as BindPixelF16x2;
+use crate::cxxbridge::ffi::PixelF16x4 as BindPixelF16x4;
+use crate::cxxbridge::ffi::PixelF32x2 as BindPixelF32x2;
 use crate::cxxbridge::ffi::PixelF32x4 as BindPixelF32x4;
+use crate::cxxbridge::ffi::PixelU8x4 as BindPixelU8x4;
+use half::f16;
+use mmimage_rust::pixelbuffer::convert_pixel_buffer as core_convert_pixel_buffer;
 use mmimage_rust::pixelbuffer::BufferDataType as CoreBufferDataType;
 use mmimage_rust::pixelbuffer::ImagePixelBuffer as CoreImagePixelBuffer;
 
-// fn core_to_bind_buffer_data_type(
-//     value: CoreBufferDataType,
-// ) -> BindBufferDataType {
-//     match value {
-//         CoreBufferDataType::None => BindBufferDataType::None,
-//         CoreBufferDataType::F32 => BindBufferDataType::F32,
-//         CoreBufferDataType::F64 => BindBufferDataType::F64,
-//     }
-// }
+fn core_to_bind_buffer_data_type(
+    value: CoreBufferDataType,
+) -> BindBufferDataType {
+    match value {
+        CoreBufferDataType::None => BindBufferDataType::None,
+        CoreBufferDataType::F32 => BindBufferDataType::F32,
+        CoreBufferDataType::F64 => BindBufferDataType::F64,
+        CoreBufferDataType::F16 => BindBufferDataType::F16,
+        CoreBufferDataType::U8 => BindBufferDataType::U8,
+    }
+}
 
 fn bind_to_core_buffer_data_type(
     value: BindBufferDataType,
@@ -40,6 +48,8 @@ fn bind_to_core_buffer_data_type(
         BindBufferDataType::None => CoreBufferDataType::None,
         BindBufferDataType::F32 => CoreBufferDataType::F32,
         BindBufferDataType::F64 => CoreBufferDataType::F64,
+        BindBufferDataType::F16 => CoreBufferDataType::F16,
+        BindBufferDataType::U8 => CoreBufferDataType::U8,
         _ => CoreBufferDataType::None,
     }
 }
@@ -60,16 +70,16 @@ impl ShimImagePixelBuffer {
         &self.inner
     }
 
+    pub fn get_inner_mut(&mut self) -> &mut CoreImagePixelBuffer {
+        &mut self.inner
+    }
+
     pub fn set_inner(&mut self, pixel_data: CoreImagePixelBuffer) {
         self.inner = pixel_data;
     }
 
     pub fn data_type(&self) -> BindBufferDataType {
-        match self.inner.data_type() {
-            CoreBufferDataType::None => BindBufferDataType::None,
-            CoreBufferDataType::F32 => BindBufferDataType::F32,
-            CoreBufferDataType::F64 => BindBufferDataType::F64,
-        }
+        core_to_bind_buffer_data_type(self.inner.data_type())
     }
 
     pub fn image_width(&self) -> usize {
@@ -92,6 +102,14 @@ impl ShimImagePixelBuffer {
         self.inner.element_count()
     }
 
+    pub fn as_slice_f32(&self) -> &[f32] {
+        self.inner.as_slice_f32()
+    }
+
+    pub fn as_slice_f32_mut(&mut self) -> &mut [f32] {
+        self.inner.as_slice_f32_mut()
+    }
+
     pub fn as_slice_f32x4(&self) -> &[BindPixelF32x4] {
         let slice = self.inner.as_slice_f32x4();
         // SAFETY: We assume that the BindPixelF32x4's memory layout is
@@ -115,6 +133,75 @@ impl ShimImagePixelBuffer {
         }
     }
 
+    pub fn as_slice_f32x2(&self) -> &[BindPixelF32x2] {
+        let slice = self.inner.as_slice_f32x2();
+        // SAFETY: The bind pixel types have the same memory layout as
+        // the equivalent tuples.
+        unsafe {
+            std::mem::transmute::<&[(f32, f32)], &[BindPixelF32x2]>(slice)
+        }
+    }
+
+    pub fn as_slice_f32x2_mut(&mut self) -> &mut [BindPixelF32x2] {
+        let slice = self.inner.as_slice_f32x2_mut();
+        unsafe {
+            std::mem::transmute::<&mut [(f32, f32)], &mut [BindPixelF32x2]>(
+                slice,
+            )
+        }
+    }
+
+    pub fn as_slice_f16x4(&self) -> &[BindPixelF16x4] {
+        let slice = self.inner.as_slice_f16x4();
+        unsafe {
+            std::mem::transmute::<&[(f16, f16, f16, f16)], &[BindPixelF16x4]>(
+                slice,
+            )
+        }
+    }
+
+    pub fn as_slice_f16x4_mut(&mut self) -> &mut [BindPixelF16x4] {
+        let slice = self.inner.as_slice_f16x4_mut();
+        unsafe {
+            std::mem::transmute::<
+                &mut [(f16, f16, f16, f16)],
+                &mut [BindPixelF16x4],
+            >(slice)
+        }
+    }
+
+    pub fn as_slice_f16x2(&self) -> &[BindPixelF16x2] {
+        let slice = self.inner.as_slice_f16x2();
+        unsafe {
+            std::mem::transmute::<&[(f16, f16)], &[BindPixelF16x2]>(slice)
+        }
+    }
+
+    pub fn as_slice_f16x2_mut(&mut self) -> &mut [BindPixelF16x2] {
+        let slice = self.inner.as_slice_f16x2_mut();
+        unsafe {
+            std::mem::transmute::<&mut [(f16, f16)], &mut [BindPixelF16x2]>(
+                slice,
+            )
+        }
+    }
+
+    pub fn as_slice_u8x4(&self) -> &[BindPixelU8x4] {
+        let slice = self.inner.as_slice_u8x4();
+        unsafe {
+            std::mem::transmute::<&[(u8, u8, u8, u8)], &[BindPixelU8x4]>(slice)
+        }
+    }
+
+    pub fn as_slice_u8x4_mut(&mut self) -> &mut [BindPixelU8x4] {
+        let slice = self.inner.as_slice_u8x4_mut();
+        unsafe {
+            std::mem::transmute::<&mut [(u8, u8, u8, u8)], &mut [BindPixelU8x4]>(
+                slice,
+            )
+        }
+    }
+
     pub fn resize(
         &mut self,
         data_type: BindBufferDataType,
@@ -131,3 +218,16 @@ impl ShimImagePixelBuffer {
 pub fn shim_create_image_pixel_buffer_box() -> Box<ShimImagePixelBuffer> {
     Box::new(ShimImagePixelBuffer::new())
 }
+
+pub fn shim_convert_pixel_buffer(
+    in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+    data_type: BindBufferDataType,
+    out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+) -> bool {
+    let data_type = bind_to_core_buffer_data_type(data_type);
+    core_convert_pixel_buffer(
+        in_pixel_buffer.get_inner(),
+        data_type,
+        out_pixel_buffer.get_inner_mut(),
+    )
+}
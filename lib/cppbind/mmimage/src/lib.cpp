@@ -41,6 +41,25 @@ bool image_read_metadata_exr(const rust::Str& file_path,
     return result;
 }
 
+bool image_read_metadata_exr_sequence(
+    const rust::Str& file_pattern, const int32_t start_frame,
+    const int32_t end_frame, const size_t thread_count,
+    rust::Vec<ImageSequenceFrameMetaData>& out_frames,
+    ImageSequenceMetaDataSummary& out_summary) {
+    return shim_image_read_metadata_exr_sequence(file_pattern, start_frame,
+                                                 end_frame, thread_count,
+                                                 out_frames, out_summary);
+}
+
+bool is_exr_file_path(const rust::Str& file_path) {
+    return shim_is_exr_file_path(file_path);
+}
+
+rust::String image_sequence_frame_file_path(const rust::Str& file_pattern,
+                                            const int32_t frame) {
+    return shim_image_sequence_frame_file_path(file_pattern, frame);
+}
+
 bool image_read_pixels_exr_f32x4(const rust::Str& file_path,
                                  ImageMetaData& out_meta_data,
                                  ImagePixelBuffer& out_pixel_data) {
@@ -55,6 +74,65 @@ bool image_read_pixels_exr_f32x4(const rust::Str& file_path,
     return result;
 }
 
+bool image_read_pixels_exr_rgba(const rust::Str& file_path,
+                                ImageMetaData& out_meta_data,
+                                ImagePixelBuffer& out_pixel_data) {
+    auto pixel_data = out_pixel_data.get_inner();
+    auto meta_data = out_meta_data.get_inner();
+
+    bool result =
+        shim_image_read_pixels_exr_rgba(file_path, meta_data, pixel_data);
+
+    out_pixel_data.set_inner(pixel_data);
+    out_meta_data.set_inner(meta_data);
+    return result;
+}
+
+bool image_read_pixels_exr_rgba_level(const rust::Str& file_path,
+                                      const uint8_t level,
+                                      ImageMetaData& out_meta_data,
+                                      ImagePixelBuffer& out_pixel_data) {
+    auto pixel_data = out_pixel_data.get_inner();
+    auto meta_data = out_meta_data.get_inner();
+
+    bool result = shim_image_read_pixels_exr_rgba_level(file_path, level,
+                                                        meta_data, pixel_data);
+
+    out_pixel_data.set_inner(pixel_data);
+    out_meta_data.set_inner(meta_data);
+    return result;
+}
+
+bool image_read_pixels_exr_region_f32x4(const rust::Str& file_path,
+                                        const ImageRegionRectangle& region,
+                                        ImageMetaData& out_meta_data,
+                                        ImagePixelBuffer& out_pixel_data) {
+    auto pixel_data = out_pixel_data.get_inner();
+    auto meta_data = out_meta_data.get_inner();
+
+    bool result = shim_image_read_pixels_exr_region_f32x4(
+        file_path, region, meta_data, pixel_data);
+
+    out_pixel_data.set_inner(pixel_data);
+    out_meta_data.set_inner(meta_data);
+    return result;
+}
+
+bool image_read_pixels_exr_channel_f32(const rust::Str& file_path,
+                                       const rust::Str& channel_name,
+                                       ImageMetaData& out_meta_data,
+                                       ImagePixelBuffer& out_pixel_data) {
+    auto pixel_data = out_pixel_data.get_inner();
+    auto meta_data = out_meta_data.get_inner();
+
+    bool result = shim_image_read_pixels_exr_channel_f32(
+        file_path, channel_name, meta_data, pixel_data);
+
+    out_pixel_data.set_inner(pixel_data);
+    out_meta_data.set_inner(meta_data);
+    return result;
+}
+
 bool image_write_pixels_exr_f32x4(const rust::Str& file_path,
                                   ImageExrEncoder exr_encoder,
                                   ImageMetaData& in_meta_data,
@@ -70,4 +148,69 @@ bool image_write_pixels_exr_f32x4(const rust::Str& file_path,
     return result;
 }
 
+bool image_write_pixels_exr_rgba(const rust::Str& file_path,
+                                 ImageExrEncoder exr_encoder,
+                                 ImageMetaData& in_meta_data,
+                                 ImagePixelBuffer& in_pixel_data) {
+    auto inner_pixel_data = in_pixel_data.get_inner();
+    auto inner_meta_data = in_meta_data.get_inner();
+
+    bool result = shim_image_write_pixels_exr_rgba(
+        file_path, exr_encoder, inner_meta_data, inner_pixel_data);
+
+    in_pixel_data.set_inner(inner_pixel_data);
+    in_meta_data.set_inner(inner_meta_data);
+    return result;
+}
+
+uint8_t image_write_proxy_levels_exr(const rust::Str& file_path,
+                                    ImageExrEncoder exr_encoder,
+                                    ImageResizeFilter filter,
+                                    const uint8_t level_count) {
+    return shim_image_write_proxy_levels_exr(file_path, exr_encoder, filter,
+                                             level_count);
+}
+
+bool image_resize_pixels_f32x4(rust::Slice<const float> src_pixels,
+                               const size_t src_width,
+                               const size_t src_height,
+                               ImageResizeFilter filter,
+                               const size_t dst_width,
+                               const size_t dst_height,
+                               rust::Slice<float> dst_pixels) {
+    return shim_image_resize_pixels_f32x4(src_pixels, src_width, src_height,
+                                          filter, dst_width, dst_height,
+                                          dst_pixels);
+}
+
+bool convert_pixel_buffer(ImagePixelBuffer& in_pixel_data,
+                          BufferDataType data_type,
+                          ImagePixelBuffer& out_pixel_data) {
+    auto inner_in_pixel_data = in_pixel_data.get_inner();
+    auto inner_out_pixel_data = out_pixel_data.get_inner();
+
+    bool result = shim_convert_pixel_buffer(inner_in_pixel_data, data_type,
+                                            inner_out_pixel_data);
+
+    in_pixel_data.set_inner(inner_in_pixel_data);
+    out_pixel_data.set_inner(inner_out_pixel_data);
+    return result;
+}
+
+bool image_warp_rows_f32x4(ImagePixelBuffer& in_pixel_data,
+                           rust::Slice<const float> st_coords,
+                           const size_t st_coords_stride,
+                           ImageWarpFilter filter,
+                           const size_t out_image_width,
+                           rust::Slice<float> out_pixels) {
+    auto inner_pixel_data = in_pixel_data.get_inner();
+
+    bool result = shim_image_warp_rows_f32x4(inner_pixel_data, st_coords,
+                                             st_coords_stride, filter,
+                                             out_image_width, out_pixels);
+
+    in_pixel_data.set_inner(inner_pixel_data);
+    return result;
+}
+
 }  // namespace mmimage
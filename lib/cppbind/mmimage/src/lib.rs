@@ -19,18 +19,42 @@
 //
 
 use crate::cxxbridge::ffi::ImageExrEncoder as BindImageExrEncoder;
+use crate::cxxbridge::ffi::ImageRegionRectangle as BindImageRegionRectangle;
+use crate::cxxbridge::ffi::ImageResizeFilter as BindImageResizeFilter;
+use crate::cxxbridge::ffi::ImageSequenceFrameMetaData as BindImageSequenceFrameMetaData;
+use crate::cxxbridge::ffi::ImageSequenceMetaDataSummary as BindImageSequenceMetaDataSummary;
+use crate::cxxbridge::ffi::ImageWarpFilter as BindImageWarpFilter;
 use crate::encoder::bind_to_core_image_exr_encoder;
 use crate::imagemetadata::ShimImageMetaData;
 use crate::imagepixelbuffer::ShimImagePixelBuffer;
+use crate::resize::bind_to_core_image_resize_filter;
+use crate::sequence::core_to_bind_image_sequence_frame_metadata;
+use crate::sequence::core_to_bind_image_sequence_metadata_summary;
+use crate::warp::bind_to_core_image_warp_filter;
 
 pub mod cxxbridge;
 pub mod encoder;
+pub mod imageexrstreamwriter;
 pub mod imagemetadata;
 pub mod imagepixelbuffer;
+pub mod resize;
+pub mod sequence;
+pub mod warp;
 
+use mmimage_rust::datatype::ImageRegionRectangle as CoreImageRegionRectangle;
 use mmimage_rust::image_read_metadata_exr as core_image_read_metadata_exr;
-use mmimage_rust::image_read_pixels_exr_f32x4 as core_image_read_pixels_exr_f32x4;
+use mmimage_rust::image_read_pixels_exr_f32x1_into as core_image_read_pixels_exr_f32x1_into;
+use mmimage_rust::image_read_pixels_exr_f32x4_into as core_image_read_pixels_exr_f32x4_into;
+use mmimage_rust::image_read_pixels_exr_rgba_into as core_image_read_pixels_exr_rgba_into;
+use mmimage_rust::image_read_pixels_exr_rgba_level_into as core_image_read_pixels_exr_rgba_level_into;
 use mmimage_rust::image_write_pixels_exr_f32x4 as core_image_write_pixels_exr_f32x4;
+use mmimage_rust::image_write_pixels_exr_rgba as core_image_write_pixels_exr_rgba;
+use mmimage_rust::image_write_proxy_levels_exr as core_image_write_proxy_levels_exr;
+use mmimage_rust::resize::image_resize_pixels_f32 as core_image_resize_pixels_f32;
+use mmimage_rust::sequence::image_read_metadata_exr_sequence as core_image_read_metadata_exr_sequence;
+use mmimage_rust::sequence::image_sequence_frame_file_path as core_image_sequence_frame_file_path;
+use mmimage_rust::sequence::is_exr_file_path as core_is_exr_file_path;
+use mmimage_rust::warp::image_warp_rows_f32x4 as core_image_warp_rows_f32x4;
 
 pub fn shim_image_read_metadata_exr(
     file_path: &str,
@@ -45,19 +69,150 @@ pub fn shim_image_read_metadata_exr(
     true
 }
 
+/// Read the metadata of each frame of an image sequence, in
+/// parallel. 'out_frames' is cleared and re-used.
+pub fn shim_image_read_metadata_exr_sequence(
+    file_pattern: &str,
+    start_frame: i32,
+    end_frame: i32,
+    thread_count: usize,
+    out_frames: &mut Vec<BindImageSequenceFrameMetaData>,
+    out_summary: &mut BindImageSequenceMetaDataSummary,
+) -> bool {
+    let result = core_image_read_metadata_exr_sequence(
+        file_pattern,
+        start_frame,
+        end_frame,
+        thread_count,
+    );
+    match result {
+        Ok((frames, summary)) => {
+            out_frames.clear();
+            out_frames.extend(
+                frames
+                    .iter()
+                    .map(core_to_bind_image_sequence_frame_metadata),
+            );
+            *out_summary =
+                core_to_bind_image_sequence_metadata_summary(&summary);
+            true
+        }
+        Err(_err) => false,
+    }
+}
+
+pub fn shim_is_exr_file_path(file_path: &str) -> bool {
+    core_is_exr_file_path(file_path)
+}
+
+pub fn shim_image_sequence_frame_file_path(
+    file_pattern: &str,
+    frame: i32,
+) -> String {
+    core_image_sequence_frame_file_path(file_pattern, frame)
+}
+
+/// Read the pixels into the existing pixel buffer, re-using the
+/// buffer's memory.
 pub fn shim_image_read_pixels_exr_f32x4(
     file_path: &str,
     out_meta_data: &mut Box<ShimImageMetaData>,
     out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
 ) -> bool {
     // TODO: How to return errors? An enum perhaps?
-    let image = core_image_read_pixels_exr_f32x4(file_path);
-    if let Err(_err) = image {
+    let meta_data = core_image_read_pixels_exr_f32x4_into(
+        file_path,
+        None,
+        out_pixel_buffer.get_inner_mut(),
+    );
+    if let Err(_err) = meta_data {
+        return false;
+    }
+    out_meta_data.set_inner(meta_data.unwrap());
+    true
+}
+
+/// Read the pixels, keeping the half or full float data type of the
+/// file.
+pub fn shim_image_read_pixels_exr_rgba(
+    file_path: &str,
+    out_meta_data: &mut Box<ShimImageMetaData>,
+    out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+) -> bool {
+    let meta_data = core_image_read_pixels_exr_rgba_into(
+        file_path,
+        None,
+        out_pixel_buffer.get_inner_mut(),
+    );
+    if let Err(_err) = meta_data {
         return false;
     }
-    let (meta_data, pixel_buffer) = image.unwrap();
-    out_meta_data.set_inner(meta_data);
-    out_pixel_buffer.set_inner(pixel_buffer);
+    out_meta_data.set_inner(meta_data.unwrap());
+    true
+}
+
+/// Read the pixels of a proxy level, or the nearest lower level that
+/// exists on disk.
+pub fn shim_image_read_pixels_exr_rgba_level(
+    file_path: &str,
+    level: u8,
+    out_meta_data: &mut Box<ShimImageMetaData>,
+    out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+) -> bool {
+    let result = core_image_read_pixels_exr_rgba_level_into(
+        file_path,
+        level,
+        out_pixel_buffer.get_inner_mut(),
+    );
+    match result {
+        Ok((meta_data, _read_level)) => {
+            out_meta_data.set_inner(meta_data);
+            true
+        }
+        Err(_err) => false,
+    }
+}
+
+pub fn shim_image_read_pixels_exr_region_f32x4(
+    file_path: &str,
+    region: BindImageRegionRectangle,
+    out_meta_data: &mut Box<ShimImageMetaData>,
+    out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+) -> bool {
+    let region = CoreImageRegionRectangle::new(
+        region.position_x,
+        region.position_y,
+        region.size_x,
+        region.size_y,
+    );
+    let meta_data = core_image_read_pixels_exr_f32x4_into(
+        file_path,
+        Some(&region),
+        out_pixel_buffer.get_inner_mut(),
+    );
+    if let Err(_err) = meta_data {
+        return false;
+    }
+    out_meta_data.set_inner(meta_data.unwrap());
+    true
+}
+
+pub fn shim_image_read_pixels_exr_channel_f32(
+    file_path: &str,
+    channel_name: &str,
+    out_meta_data: &mut Box<ShimImageMetaData>,
+    out_pixel_buffer: &mut Box<ShimImagePixelBuffer>,
+) -> bool {
+    let meta_data = core_image_read_pixels_exr_f32x1_into(
+        file_path,
+        channel_name,
+        None,
+        out_pixel_buffer.get_inner_mut(),
+    );
+    if let Err(_err) = meta_data {
+        return false;
+    }
+    out_meta_data.set_inner(meta_data.unwrap());
     true
 }
 
@@ -84,3 +239,94 @@ pub fn shim_image_write_pixels_exr_f32x4(
     }
     true
 }
+
+pub fn shim_image_write_pixels_exr_rgba(
+    file_path: &str,
+    exr_encoder: BindImageExrEncoder,
+    in_meta_data: &Box<ShimImageMetaData>,
+    in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+) -> bool {
+    let meta_data = in_meta_data.get_inner();
+    let pixel_buffer = in_pixel_buffer.get_inner();
+
+    let exr_encoder = bind_to_core_image_exr_encoder(exr_encoder);
+    let result = core_image_write_pixels_exr_rgba(
+        file_path,
+        exr_encoder,
+        meta_data,
+        pixel_buffer,
+    );
+
+    if let Err(_err) = result {
+        return false;
+    }
+    true
+}
+
+/// Write the proxy levels of an EXR file, returning the number of
+/// levels written (zero on failure).
+pub fn shim_image_write_proxy_levels_exr(
+    file_path: &str,
+    exr_encoder: BindImageExrEncoder,
+    filter: BindImageResizeFilter,
+    level_count: u8,
+) -> u8 {
+    let exr_encoder = bind_to_core_image_exr_encoder(exr_encoder);
+    let filter = bind_to_core_image_resize_filter(filter);
+    let result = core_image_write_proxy_levels_exr(
+        file_path,
+        exr_encoder,
+        filter,
+        level_count,
+    );
+    match result {
+        Ok(levels_written) => levels_written,
+        Err(_err) => 0,
+    }
+}
+
+/// Resize the RGBA 32-bit float pixels in 'src_pixels' into
+/// 'dst_pixels'.
+pub fn shim_image_resize_pixels_f32x4(
+    src_pixels: &[f32],
+    src_width: usize,
+    src_height: usize,
+    filter: BindImageResizeFilter,
+    dst_width: usize,
+    dst_height: usize,
+    dst_pixels: &mut [f32],
+) -> bool {
+    let filter = bind_to_core_image_resize_filter(filter);
+    let num_channels = 4;
+    core_image_resize_pixels_f32(
+        src_pixels,
+        src_width,
+        src_height,
+        num_channels,
+        filter,
+        dst_width,
+        dst_height,
+        dst_pixels,
+    )
+}
+
+/// Resample rows of the image in 'in_pixel_buffer' at the (s, t)
+/// coordinates given in 'st_coords', into 'out_pixels'.
+pub fn shim_image_warp_rows_f32x4(
+    in_pixel_buffer: &Box<ShimImagePixelBuffer>,
+    st_coords: &[f32],
+    st_coords_stride: usize,
+    filter: BindImageWarpFilter,
+    out_image_width: usize,
+    out_pixels: &mut [f32],
+) -> bool {
+    let filter = bind_to_core_image_warp_filter(filter);
+    core_image_warp_rows_f32x4(
+        in_pixel_buffer.get_inner(),
+        st_coords,
+        st_coords_stride,
+        filter,
+        out_image_width,
+        out_pixels,
+    )
+}
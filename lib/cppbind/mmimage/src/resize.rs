@@ -0,0 +1,37 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::cxxbridge::ffi::ImageResizeFilter as BindImageResizeFilter;
+
+use mmimage_rust::resize::ImageResizeFilter as CoreImageResizeFilter;
+
+pub fn bind_to_core_image_resize_filter(
+    value: BindImageResizeFilter,
+) -> CoreImageResizeFilter {
+    match value {
+        BindImageResizeFilter::Box => CoreImageResizeFilter::Box,
+        BindImageResizeFilter::Bilinear => CoreImageResizeFilter::Bilinear,
+        BindImageResizeFilter::Lanczos3 => CoreImageResizeFilter::Lanczos3,
+        BindImageResizeFilter::Unknown => {
+            panic!("ImageResizeFilter has invalid Unknown value.")
+        }
+        _ => panic!("ImageResizeFilter has invalid value."),
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::cxxbridge::ffi::ImageRegionRectangle as BindImageRegionRectangle;
+use crate::cxxbridge::ffi::ImageSequenceFrameMetaData as BindImageSequenceFrameMetaData;
+use crate::cxxbridge::ffi::ImageSequenceMetaDataSummary as BindImageSequenceMetaDataSummary;
+
+use mmimage_rust::datatype::ImageRegionRectangle as CoreImageRegionRectangle;
+use mmimage_rust::sequence::ImageSequenceFrameMetaData as CoreImageSequenceFrameMetaData;
+use mmimage_rust::sequence::ImageSequenceMetaDataSummary as CoreImageSequenceMetaDataSummary;
+
+fn core_to_bind_image_region_rectangle(
+    value: &CoreImageRegionRectangle,
+) -> BindImageRegionRectangle {
+    BindImageRegionRectangle {
+        position_x: value.position_x,
+        position_y: value.position_y,
+        size_x: value.size_x,
+        size_y: value.size_y,
+    }
+}
+
+pub fn core_to_bind_image_sequence_frame_metadata(
+    value: &CoreImageSequenceFrameMetaData,
+) -> BindImageSequenceFrameMetaData {
+    BindImageSequenceFrameMetaData {
+        frame: value.frame,
+        exists: value.exists,
+        display_window: core_to_bind_image_region_rectangle(
+            &value.display_window,
+        ),
+        data_window: core_to_bind_image_region_rectangle(&value.data_window),
+        pixel_aspect: value.pixel_aspect,
+        num_channels: value.num_channels,
+        consistent: value.consistent,
+    }
+}
+
+pub fn core_to_bind_image_sequence_metadata_summary(
+    value: &CoreImageSequenceMetaDataSummary,
+) -> BindImageSequenceMetaDataSummary {
+    BindImageSequenceMetaDataSummary {
+        frame_count: value.frame_count,
+        missing_frame_count: value.missing_frame_count,
+        first_missing_frame: value.first_missing_frame,
+        reference_frame: value.reference_frame,
+        display_window: core_to_bind_image_region_rectangle(
+            &value.display_window,
+        ),
+        pixel_aspect: value.pixel_aspect,
+        display_window_mismatch_count: value.display_window_mismatch_count,
+        data_window_mismatch_count: value.data_window_mismatch_count,
+        pixel_aspect_mismatch_count: value.pixel_aspect_mismatch_count,
+        num_channels_mismatch_count: value.num_channels_mismatch_count,
+    }
+}
@@ -0,0 +1,36 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::cxxbridge::ffi::ImageWarpFilter as BindImageWarpFilter;
+
+use mmimage_rust::warp::ImageWarpFilter as CoreImageWarpFilter;
+
+pub fn bind_to_core_image_warp_filter(
+    value: BindImageWarpFilter,
+) -> CoreImageWarpFilter {
+    match value {
+        BindImageWarpFilter::Bilinear => CoreImageWarpFilter::Bilinear,
+        BindImageWarpFilter::Bicubic => CoreImageWarpFilter::Bicubic,
+        BindImageWarpFilter::Unknown => {
+            panic!("ImageWarpFilter has invalid Unknown value.")
+        }
+        _ => panic!("ImageWarpFilter has invalid value."),
+    }
+}
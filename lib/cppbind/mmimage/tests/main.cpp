@@ -28,6 +28,7 @@
 #include "test_b.h"
 #include "test_c.h"
 #include "test_d.h"
+#include "test_e.h"
 
 void print_help(const char *exec_file) {
     std::cout
@@ -65,16 +66,19 @@ int main(int argc, char *argv[]) {
     }
     char *dir_path = argv[1];
 
-    if (!test_a("mmimage_test_a:", dir_path)) {
+    if (test_a("mmimage_test_a:", dir_path) != 0) {
         return 1;
     }
-    if (!test_b("mmimage_test_b:", dir_path)) {
+    if (test_b("mmimage_test_b:", dir_path) != 0) {
         return 1;
     }
-    if (!test_c("mmimage_test_c:", dir_path)) {
+    if (test_c("mmimage_test_c:", dir_path) != 0) {
         return 1;
     }
-    if (!test_d("mmimage_test_d:", dir_path)) {
+    if (test_d("mmimage_test_d:", dir_path) != 0) {
+        return 1;
+    }
+    if (test_e("mmimage_test_e:", dir_path) != 0) {
         return 1;
     }
     return 0;
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include "test_e.h"
+
+#include <mmimage/mmimage.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "common.h"
+
+namespace mmimg = mmimage;
+
+// 16-bit (half) float bit patterns, for exactly representable values.
+const uint16_t kHalfZero = 0x0000;
+const uint16_t kHalfHalf = 0x3800;
+const uint16_t kHalfOne = 0x3C00;
+const uint16_t kHalfTwo = 0x4000;
+
+bool test_e_image_write_read_f16(const char *test_name,
+                                 const size_t image_width,
+                                 const size_t image_height,
+                                 rust::Str output_file_path) {
+    auto meta_data = mmimg::ImageMetaData();
+    auto exr_encoder = mmimg::ImageExrEncoder{
+        mmimg::ExrCompression::kZIP1,
+        mmimg::ExrPixelLayout{mmimg::ExrPixelLayoutMode::kScanLines, 0, 0},
+        mmimg::ExrLineOrder::kIncreasing,
+    };
+
+    const auto num_channels = 4;
+    auto pixel_buffer = mmimg::ImagePixelBuffer();
+    pixel_buffer.resize(mmimg::BufferDataType::kF16, image_width, image_height,
+                        num_channels);
+
+    rust::Slice<mmimg::PixelF16x4> raw_data_mut =
+        pixel_buffer.as_slice_f16x4_mut();
+    const size_t pixel_count = image_width * image_height;
+    for (size_t i = 0; i < pixel_count; i++) {
+        raw_data_mut[i] =
+            mmimg::PixelF16x4{kHalfZero, kHalfHalf, kHalfTwo, kHalfOne};
+    }
+
+    bool result = mmimg::image_write_pixels_exr_rgba(
+        output_file_path, exr_encoder, meta_data, pixel_buffer);
+    std::cout << test_name << " written result: " << result << std::endl;
+    if (!result) {
+        return false;
+    }
+
+    // The file should be read back as half float, at 8 bytes per
+    // pixel.
+    auto reread_buffer = mmimg::ImagePixelBuffer();
+    result = mmimg::image_read_pixels_exr_rgba(output_file_path, meta_data,
+                                               reread_buffer);
+    std::cout << test_name << " image read result: " << result << std::endl;
+    if (!result) {
+        return false;
+    }
+    if (reread_buffer.data_type() != mmimg::BufferDataType::kF16) {
+        std::cerr << test_name << " image was not read as half float."
+                  << std::endl;
+        return false;
+    }
+    rust::Slice<const mmimg::PixelF16x4> reread_data =
+        reread_buffer.as_slice_f16x4();
+    const mmimg::PixelF16x4 first_pixel = reread_data[0];
+    if (first_pixel.r != kHalfZero || first_pixel.g != kHalfHalf ||
+        first_pixel.b != kHalfTwo || first_pixel.a != kHalfOne) {
+        std::cerr << test_name << " half float pixel values do not match."
+                  << std::endl;
+        return false;
+    }
+
+    // Convert to 32-bit float.
+    auto f32_buffer = mmimg::ImagePixelBuffer();
+    result = mmimg::convert_pixel_buffer(
+        reread_buffer, mmimg::BufferDataType::kF32, f32_buffer);
+    if (!result) {
+        return false;
+    }
+    rust::Slice<const mmimg::PixelF32x4> f32_data =
+        f32_buffer.as_slice_f32x4();
+    const mmimg::PixelF32x4 last_pixel = f32_data[pixel_count - 1];
+    std::cout << test_name << " f32 pixel: " << last_pixel.r << ", "
+              << last_pixel.g << ", " << last_pixel.b << ", " << last_pixel.a
+              << std::endl;
+    if (last_pixel.r != 0.0f || last_pixel.g != 0.5f ||
+        last_pixel.b != 2.0f || last_pixel.a != 1.0f) {
+        std::cerr << test_name << " f32 pixel values do not match."
+                  << std::endl;
+        return false;
+    }
+
+    // Convert to 8-bit; values are clamped to 0.0 to 1.0.
+    auto u8_buffer = mmimg::ImagePixelBuffer();
+    result = mmimg::convert_pixel_buffer(f32_buffer, mmimg::BufferDataType::kU8,
+                                         u8_buffer);
+    if (!result) {
+        return false;
+    }
+    rust::Slice<const mmimg::PixelU8x4> u8_data = u8_buffer.as_slice_u8x4();
+    const mmimg::PixelU8x4 u8_pixel = u8_data[0];
+    if (u8_pixel.r != 0 || u8_pixel.g != 128 || u8_pixel.b != 255 ||
+        u8_pixel.a != 255) {
+        std::cerr << test_name << " u8 pixel values do not match."
+                  << std::endl;
+        return false;
+    }
+
+    std::cout << test_name << " f16 element count: "
+              << reread_buffer.element_count()
+              << " f32 element count: " << f32_buffer.element_count()
+              << " u8 element count: " << u8_buffer.element_count()
+              << std::endl;
+    return true;
+}
+
+int test_e(const char *test_name, const char *dir_path) {
+    auto out_path = join_path(dir_path, "test_half_float.0001.out.exr");
+    const auto out_file_path = rust::Str(out_path);
+
+    size_t image_width = 64;
+    size_t image_height = 32;
+    bool ok = test_e_image_write_read_f16(test_name, image_width, image_height,
+                                          out_file_path);
+    if (!ok) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -28,7 +28,12 @@
 #include <mmlens/_cxx.h>
 #include <mmlens/_cxxbridge.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace mmlens {
 
@@ -42,7 +47,11 @@ public:
         , m_camera{3.0, 3.6, 2.4, 1.0, 0.0, 0.0}
         // TODO: Pre-compute this value.
         , m_film_back_radius_cm(1.0)
-        , m_inputLensModel{} {};
+        , m_inputLensModel{}
+        , m_version(nextVersion())
+        , m_prepared_version(0)
+        , m_hash_version(0)
+        , m_hash_value(0) {};
 
     LensModel(const LensModel &rhs)
         : m_type(rhs.getType())
@@ -56,7 +65,13 @@ public:
         // TODO: Can we re-compute this value rather than using
         // 'm_state'?
         , m_film_back_radius_cm(1.0)
-        , m_inputLensModel{rhs.getInputLensModel()} {};
+        , m_inputLensModel{rhs.getInputLensModel()}
+        // The cached hash is not copied, for the same reason as
+        // 'm_state'.
+        , m_version(nextVersion())
+        , m_prepared_version(0)
+        , m_hash_version(0)
+        , m_hash_value(0) {};
 
     virtual std::unique_ptr<LensModel> cloneAsUniquePtr() const = 0;
     virtual std::shared_ptr<LensModel> cloneAsSharedPtr() const = 0;
@@ -77,7 +92,7 @@ public:
     void setType(const LensModelType value) {
         bool same_value = m_type == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_type = value;
         }
     }
@@ -85,7 +100,7 @@ public:
     void setFocalLength(const double value) {
         bool same_value = m_camera.focal_length_cm == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.focal_length_cm = value;
         }
     }
@@ -93,7 +108,7 @@ public:
     void setFilmBackWidth(const double value) {
         bool same_value = m_camera.film_back_width_cm == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.film_back_width_cm = value;
         }
     }
@@ -101,7 +116,7 @@ public:
     void setFilmBackHeight(const double value) {
         bool same_value = m_camera.film_back_height_cm == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.film_back_height_cm = value;
         }
     }
@@ -109,7 +124,7 @@ public:
     void setPixelAspect(const double value) {
         bool same_value = m_camera.pixel_aspect == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.pixel_aspect = value;
         }
     }
@@ -117,7 +132,7 @@ public:
     void setLensCenterOffsetX(const double value) {
         bool same_value = m_camera.lens_center_offset_x_cm == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.lens_center_offset_x_cm = value;
         }
     }
@@ -125,18 +140,30 @@ public:
     void setLensCenterOffsetY(const double value) {
         bool same_value = m_camera.lens_center_offset_y_cm == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_camera.lens_center_offset_y_cm = value;
         }
     }
 
+    // The version of this lens model and all input lens models in
+    // the chain. The version increases each time any lens model in
+    // the chain is changed, so an unchanged version means the lens
+    // chain is unchanged.
+    uint64_t getVersion() const {
+        uint64_t version = m_version;
+        if (m_inputLensModel != nullptr) {
+            version = std::max(version, m_inputLensModel->getVersion());
+        }
+        return version;
+    }
+
     std::shared_ptr<LensModel> getInputLensModel() const {
         return m_inputLensModel;
     }
     void setInputLensModel(std::shared_ptr<LensModel> value) {
         bool same_value = m_inputLensModel == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_inputLensModel = value;
         }
     }
@@ -151,14 +178,103 @@ public:
     virtual void applyModelDistort(const double x, const double y,
                                    double &out_x, double &out_y) = 0;
 
-    virtual mmhash::HashValue hashValue() = 0;
+    // Undistort 'point_count' points, stored as interleaved X and Y
+    // values. The lens model parameters are set up once for all
+    // points, rather than once per point. 'in_xy' and 'out_xy' may be
+    // the same array.
+    virtual void applyModelUndistortPoints(const double *in_xy,
+                                           double *out_xy,
+                                           const size_t point_count) {
+        for (size_t i = 0; i < point_count; ++i) {
+            applyModelUndistort(in_xy[(i * 2) + 0], in_xy[(i * 2) + 1],
+                                out_xy[(i * 2) + 0], out_xy[(i * 2) + 1]);
+        }
+    }
+
+    // Distort 'point_count' points, stored as interleaved X and Y
+    // values, as 'applyModelUndistortPoints'.
+    virtual void applyModelDistortPoints(const double *in_xy, double *out_xy,
+                                         const size_t point_count) {
+        for (size_t i = 0; i < point_count; ++i) {
+            applyModelDistort(in_xy[(i * 2) + 0], in_xy[(i * 2) + 1],
+                              out_xy[(i * 2) + 0], out_xy[(i * 2) + 1]);
+        }
+    }
+
+    // The hash of this lens model and all input lens models in the
+    // chain. The hash is only computed again after a lens model in
+    // the chain has changed.
+    //
+    // May be called from many threads at once, as long as the lens
+    // model is not changed at the same time.
+    mmhash::HashValue hashValue() {
+        const uint64_t version = getVersion();
+        if (m_hash_version.load(std::memory_order_acquire) == version) {
+            return m_hash_value;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_hash_version.load(std::memory_order_relaxed) != version) {
+            m_hash_value = computeHashValue();
+            m_hash_version.store(version, std::memory_order_release);
+        }
+        return m_hash_value;
+    }
 
 protected:
+    // Compute the hash of this lens model, combined with the
+    // 'hashValue()' of the input lens model.
+    virtual mmhash::HashValue computeHashValue() = 0;
+
+    // Mark the lens model as changed, so that the intermediate data
+    // and the hash are recomputed before they are next used.
+    void setDirty() {
+        m_state = LensModelState::kDirty;
+        m_version = nextVersion();
+    }
+
+    // Call 'func' to set up intermediate data, unless it has already
+    // been called since this lens model was last changed. Only one
+    // thread calls 'func'; other threads calling 'prepareOnce' at the
+    // same time wait for it to finish, so the intermediate data may
+    // be read by all threads once 'prepareOnce' returns.
+    template <typename Func>
+    void prepareOnce(Func func) {
+        const uint64_t version = m_version;
+        if (m_prepared_version.load(std::memory_order_acquire) == version) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_prepared_version.load(std::memory_order_relaxed) == version) {
+            return;
+        }
+        func();
+        m_state = LensModelState::kClean;
+        m_prepared_version.store(version, std::memory_order_release);
+    }
+
+    // A new version number, larger than all previous version numbers
+    // of all lens models.
+    static uint64_t nextVersion() {
+        static std::atomic<uint64_t> counter(0);
+        return ++counter;
+    }
+
     std::shared_ptr<LensModel> m_inputLensModel;
     LensModelType m_type;
     LensModelState m_state;
     CameraParameters m_camera;
     double m_film_back_radius_cm;
+
+    uint64_t m_version;
+
+    // Guards the lazily computed intermediate data and hash, which
+    // may be requested by many threads evaluating the lens at once.
+    std::mutex m_mutex;
+    std::atomic<uint64_t> m_prepared_version;
+    std::atomic<uint64_t> m_hash_version;
+    mmhash::HashValue m_hash_value;
 };
 
 inline LensModel::~LensModel() {}
@@ -38,6 +38,8 @@
 
 namespace mmlens {
 
+class Distortion3deAnamorphicStdDeg4Rescaled;
+
 class LensModel3deAnamorphicDeg4RotateSqueezeXYRescaled : public LensModel {
 public:
     LensModel3deAnamorphicDeg4RotateSqueezeXYRescaled()
@@ -102,7 +104,7 @@ public:
     void setDegree2Cx02(const double value) {
         bool same_value = m_lens.degree2_cx02 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_cx02 = value;
         }
     }
@@ -110,7 +112,7 @@ public:
     void setDegree2Cy02(const double value) {
         bool same_value = m_lens.degree2_cy02 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_cy02 = value;
         }
     }
@@ -118,7 +120,7 @@ public:
     void setDegree2Cx22(const double value) {
         bool same_value = m_lens.degree2_cx22 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_cx22 = value;
         }
     }
@@ -126,7 +128,7 @@ public:
     void setDegree2Cy22(const double value) {
         bool same_value = m_lens.degree2_cy22 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_cy22 = value;
         }
     }
@@ -134,7 +136,7 @@ public:
     void setDegree4Cx04(const double value) {
         bool same_value = m_lens.degree4_cx04 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cx04 = value;
         }
     }
@@ -142,7 +144,7 @@ public:
     void setDegree4Cy04(const double value) {
         bool same_value = m_lens.degree4_cy04 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cy04 = value;
         }
     }
@@ -150,7 +152,7 @@ public:
     void setDegree4Cx24(const double value) {
         bool same_value = m_lens.degree4_cx24 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cx24 = value;
         }
     }
@@ -158,7 +160,7 @@ public:
     void setDegree4Cy24(const double value) {
         bool same_value = m_lens.degree4_cy24 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cy24 = value;
         }
     }
@@ -166,7 +168,7 @@ public:
     void setDegree4Cx44(const double value) {
         bool same_value = m_lens.degree4_cx44 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cx44 = value;
         }
     }
@@ -174,7 +176,7 @@ public:
     void setDegree4Cy44(const double value) {
         bool same_value = m_lens.degree4_cy44 == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_cy44 = value;
         }
     }
@@ -182,7 +184,7 @@ public:
     void setLensRotation(const double value) {
         bool same_value = m_lens.lens_rotation == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.lens_rotation = value;
         }
     }
@@ -190,7 +192,7 @@ public:
     void setSqueezeX(const double value) {
         bool same_value = m_lens.squeeze_x == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.squeeze_x = value;
         }
     }
@@ -198,7 +200,7 @@ public:
     void setSqueezeY(const double value) {
         bool same_value = m_lens.squeeze_y == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.squeeze_y = value;
         }
     }
@@ -206,7 +208,7 @@ public:
     void setRescale(const double value) {
         bool same_value = m_lens.rescale == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.rescale = value;
         }
     }
@@ -214,13 +216,28 @@ public:
     virtual void applyModelUndistort(const double x, const double y,
                                      double &out_x, double &out_y);
 
+    virtual void applyModelUndistortPoints(const double *in_xy,
+                                           double *out_xy,
+                                           const size_t point_count);
+
     virtual void applyModelDistort(const double x, const double y,
                                    double &out_x, double &out_y);
 
-    virtual mmhash::HashValue hashValue();
+protected:
+    virtual mmhash::HashValue computeHashValue();
 
 private:
+    // Set up the film back radius and the distortion evaluator, when
+    // the lens model has changed. May be called from many threads at
+    // once; see 'LensModel::prepareOnce'.
+    void prepare();
+
     Parameters3deAnamorphicStdDeg4Rescaled m_lens;
+
+    // The prepared distortion evaluator. It is replaced (not
+    // modified) when the lens model changes, and is only read while
+    // evaluating, so evaluation may run on many threads once prepared.
+    std::shared_ptr<Distortion3deAnamorphicStdDeg4Rescaled> m_distortion;
 };
 
 }  // namespace mmlens
@@ -38,6 +38,8 @@
 
 namespace mmlens {
 
+class Distortion3deClassic;
+
 class LensModel3deClassic : public LensModel {
 public:
     LensModel3deClassic()
@@ -75,7 +77,7 @@ public:
     void setDistortion(const double value) {
         bool same_value = m_lens.distortion == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.distortion = value;
         }
     }
@@ -83,7 +85,7 @@ public:
     void setAnamorphicSqueeze(const double value) {
         bool same_value = m_lens.anamorphic_squeeze == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.anamorphic_squeeze = value;
         }
     }
@@ -91,7 +93,7 @@ public:
     void setCurvatureX(const double value) {
         bool same_value = m_lens.curvature_x == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.curvature_x = value;
         }
     }
@@ -99,7 +101,7 @@ public:
     void setCurvatureY(const double value) {
         bool same_value = m_lens.curvature_y == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.curvature_y = value;
         }
     }
@@ -107,7 +109,7 @@ public:
     void setQuarticDistortion(const double value) {
         bool same_value = m_lens.quartic_distortion == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.quartic_distortion = value;
         }
     }
@@ -115,13 +117,28 @@ public:
     virtual void applyModelUndistort(const double x, const double y,
                                      double &out_x, double &out_y);
 
+    virtual void applyModelUndistortPoints(const double *in_xy,
+                                           double *out_xy,
+                                           const size_t point_count);
+
     virtual void applyModelDistort(const double x, const double y,
                                    double &out_x, double &out_y);
 
-    virtual mmhash::HashValue hashValue();
+protected:
+    virtual mmhash::HashValue computeHashValue();
 
 private:
+    // Set up the film back radius and the distortion evaluator, when
+    // the lens model has changed. May be called from many threads at
+    // once; see 'LensModel::prepareOnce'.
+    void prepare();
+
     Parameters3deClassic m_lens;
+
+    // The prepared distortion evaluator. It is replaced (not
+    // modified) when the lens model changes, and is only read while
+    // evaluating, so evaluation may run on many threads once prepared.
+    std::shared_ptr<Distortion3deClassic> m_distortion;
 };
 
 }  // namespace mmlens
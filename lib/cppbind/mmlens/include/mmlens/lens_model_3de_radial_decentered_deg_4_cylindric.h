@@ -39,6 +39,8 @@
 
 namespace mmlens {
 
+class Distortion3deRadialStdDeg4;
+
 class LensModel3deRadialDecenteredDeg4Cylindric : public LensModel {
 public:
     LensModel3deRadialDecenteredDeg4Cylindric()
@@ -85,7 +87,7 @@ public:
     void setDegree2Distortion(const double value) {
         bool same_value = m_lens.degree2_distortion == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_distortion = value;
         }
     }
@@ -93,7 +95,7 @@ public:
     void setDegree2U(const double value) {
         bool same_value = m_lens.degree2_u == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_u = value;
         }
     }
@@ -101,7 +103,7 @@ public:
     void setDegree2V(const double value) {
         bool same_value = m_lens.degree2_v == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree2_v = value;
         }
     }
@@ -109,7 +111,7 @@ public:
     void setDegree4Distortion(const double value) {
         bool same_value = m_lens.degree4_distortion == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_distortion = value;
         }
     }
@@ -117,7 +119,7 @@ public:
     void setDegree4U(const double value) {
         bool same_value = m_lens.degree4_u == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_u = value;
         }
     }
@@ -125,7 +127,7 @@ public:
     void setDegree4V(const double value) {
         bool same_value = m_lens.degree4_v == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.degree4_v = value;
         }
     }
@@ -133,7 +135,7 @@ public:
     void setCylindricDirection(const double value) {
         bool same_value = m_lens.cylindric_direction == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.cylindric_direction = value;
         }
     }
@@ -141,7 +143,7 @@ public:
     void setCylindricBending(const double value) {
         bool same_value = m_lens.cylindric_bending == value;
         if (!same_value) {
-            m_state = LensModelState::kDirty;
+            setDirty();
             m_lens.cylindric_bending = value;
         }
     }
@@ -149,13 +151,28 @@ public:
     virtual void applyModelUndistort(const double x, const double y,
                                      double &out_x, double &out_y);
 
+    virtual void applyModelUndistortPoints(const double *in_xy,
+                                           double *out_xy,
+                                           const size_t point_count);
+
     virtual void applyModelDistort(const double x, const double y,
                                    double &out_x, double &out_y);
 
-    virtual mmhash::HashValue hashValue();
+protected:
+    virtual mmhash::HashValue computeHashValue();
 
 private:
+    // Set up the film back radius and the distortion evaluator, when
+    // the lens model has changed. May be called from many threads at
+    // once; see 'LensModel::prepareOnce'.
+    void prepare();
+
     Parameters3deRadialStdDeg4 m_lens;
+
+    // The prepared distortion evaluator. It is replaced (not
+    // modified) when the lens model changes, and is only read while
+    // evaluating, so evaluation may run on many threads once prepared.
+    std::shared_ptr<Distortion3deRadialStdDeg4> m_distortion;
 };
 
 }  // namespace mmlens
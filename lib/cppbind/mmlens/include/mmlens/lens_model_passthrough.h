@@ -51,7 +51,8 @@ public:
     virtual void applyModelDistort(const double x, const double y,
                                    double &out_x, double &out_y);
 
-    virtual mmhash::HashValue hashValue();
+protected:
+    virtual mmhash::HashValue computeHashValue();
 };
 
 }  // namespace mmlens
@@ -819,6 +819,8 @@ void mmlens$cxxbridge1$apply_identity_to_f64_3de_classic_multithread(::mmlens::D
 
 void mmlens$cxxbridge1$apply_identity_to_f32_3de_classic_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept;
 
+void mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_classic_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept;
+
 void mmlens$cxxbridge1$apply_f64_to_f64_3de_classic_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept;
 
 void mmlens$cxxbridge1$apply_f64_to_f32_3de_classic_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept;
@@ -827,6 +829,8 @@ void mmlens$cxxbridge1$apply_identity_to_f64_3de_radial_std_deg4_multithread(::m
 
 void mmlens$cxxbridge1$apply_identity_to_f32_3de_radial_std_deg4_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept;
 
+void mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_radial_std_deg4_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept;
+
 void mmlens$cxxbridge1$apply_f64_to_f64_3de_radial_std_deg4_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept;
 
 void mmlens$cxxbridge1$apply_f64_to_f32_3de_radial_std_deg4_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept;
@@ -835,6 +839,8 @@ void mmlens$cxxbridge1$apply_identity_to_f64_3de_anamorphic_std_deg4_multithread
 
 void mmlens$cxxbridge1$apply_identity_to_f32_3de_anamorphic_std_deg4_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept;
 
+void mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_anamorphic_std_deg4_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept;
+
 void mmlens$cxxbridge1$apply_f64_to_f64_3de_anamorphic_std_deg4_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept;
 
 void mmlens$cxxbridge1$apply_f64_to_f32_3de_anamorphic_std_deg4_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept;
@@ -843,6 +849,8 @@ void mmlens$cxxbridge1$apply_identity_to_f64_3de_anamorphic_std_deg4_rescaled_mu
 
 void mmlens$cxxbridge1$apply_identity_to_f32_3de_anamorphic_std_deg4_rescaled_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept;
 
+void mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_anamorphic_std_deg4_rescaled_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept;
+
 void mmlens$cxxbridge1$apply_f64_to_f64_3de_anamorphic_std_deg4_rescaled_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept;
 
 void mmlens$cxxbridge1$apply_f64_to_f32_3de_anamorphic_std_deg4_rescaled_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept;
@@ -1142,6 +1150,10 @@ MMLENS_API_EXPORT void apply_identity_to_f32_multithread(::mmlens::DistortionDir
   mmlens$cxxbridge1$apply_identity_to_f32_3de_classic_multithread(direction, image_width, image_height, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
 
+MMLENS_API_EXPORT void apply_identity_to_f32_rows_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept {
+  mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_classic_multithread(direction, image_width, image_height, start_row, end_row, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
+}
+
 MMLENS_API_EXPORT void apply_f64_to_f64_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deClassic lens_parameters) noexcept {
   mmlens$cxxbridge1$apply_f64_to_f64_3de_classic_multithread(direction, in_data_ptr, in_data_size, in_data_stride, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
@@ -1158,6 +1170,10 @@ MMLENS_API_EXPORT void apply_identity_to_f32_multithread(::mmlens::DistortionDir
   mmlens$cxxbridge1$apply_identity_to_f32_3de_radial_std_deg4_multithread(direction, image_width, image_height, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
 
+MMLENS_API_EXPORT void apply_identity_to_f32_rows_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept {
+  mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_radial_std_deg4_multithread(direction, image_width, image_height, start_row, end_row, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
+}
+
 MMLENS_API_EXPORT void apply_f64_to_f64_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deRadialStdDeg4 lens_parameters) noexcept {
   mmlens$cxxbridge1$apply_f64_to_f64_3de_radial_std_deg4_multithread(direction, in_data_ptr, in_data_size, in_data_stride, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
@@ -1174,6 +1190,10 @@ MMLENS_API_EXPORT void apply_identity_to_f32_multithread(::mmlens::DistortionDir
   mmlens$cxxbridge1$apply_identity_to_f32_3de_anamorphic_std_deg4_multithread(direction, image_width, image_height, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
 
+MMLENS_API_EXPORT void apply_identity_to_f32_rows_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept {
+  mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_anamorphic_std_deg4_multithread(direction, image_width, image_height, start_row, end_row, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
+}
+
 MMLENS_API_EXPORT void apply_f64_to_f64_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4 lens_parameters) noexcept {
   mmlens$cxxbridge1$apply_f64_to_f64_3de_anamorphic_std_deg4_multithread(direction, in_data_ptr, in_data_size, in_data_stride, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
@@ -1190,6 +1210,10 @@ MMLENS_API_EXPORT void apply_identity_to_f32_multithread(::mmlens::DistortionDir
   mmlens$cxxbridge1$apply_identity_to_f32_3de_anamorphic_std_deg4_rescaled_multithread(direction, image_width, image_height, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
 
+MMLENS_API_EXPORT void apply_identity_to_f32_rows_multithread(::mmlens::DistortionDirection direction, ::std::size_t image_width, ::std::size_t image_height, ::std::size_t start_row, ::std::size_t end_row, float *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept {
+  mmlens$cxxbridge1$apply_identity_to_f32_rows_3de_anamorphic_std_deg4_rescaled_multithread(direction, image_width, image_height, start_row, end_row, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
+}
+
 MMLENS_API_EXPORT void apply_f64_to_f64_multithread(::mmlens::DistortionDirection direction, const double *in_data_ptr, ::std::size_t in_data_size, ::std::size_t in_data_stride, double *out_data_ptr, ::std::size_t out_data_size, ::std::size_t out_data_stride, ::mmlens::CameraParameters camera_parameters, double film_back_radius_cm, ::mmlens::Parameters3deAnamorphicStdDeg4Rescaled lens_parameters) noexcept {
   mmlens$cxxbridge1$apply_f64_to_f64_3de_anamorphic_std_deg4_rescaled_multithread(direction, in_data_ptr, in_data_size, in_data_stride, out_data_ptr, out_data_size, out_data_stride, camera_parameters, film_back_radius_cm, lens_parameters);
 }
@@ -26,21 +26,25 @@ use crate::lens_io::shim_read_lens_file;
 use crate::distortion_process::apply_f64_to_f32_3de_classic_multithread;
 use crate::distortion_process::apply_f64_to_f64_3de_classic_multithread;
 use crate::distortion_process::apply_identity_to_f32_3de_classic_multithread;
+use crate::distortion_process::apply_identity_to_f32_rows_3de_classic_multithread;
 use crate::distortion_process::apply_identity_to_f64_3de_classic_multithread;
 
 use crate::distortion_process::apply_f64_to_f32_3de_radial_std_deg4_multithread;
 use crate::distortion_process::apply_f64_to_f64_3de_radial_std_deg4_multithread;
 use crate::distortion_process::apply_identity_to_f32_3de_radial_std_deg4_multithread;
+use crate::distortion_process::apply_identity_to_f32_rows_3de_radial_std_deg4_multithread;
 use crate::distortion_process::apply_identity_to_f64_3de_radial_std_deg4_multithread;
 
 use crate::distortion_process::apply_f64_to_f32_3de_anamorphic_std_deg4_multithread;
 use crate::distortion_process::apply_f64_to_f64_3de_anamorphic_std_deg4_multithread;
 use crate::distortion_process::apply_identity_to_f32_3de_anamorphic_std_deg4_multithread;
+use crate::distortion_process::apply_identity_to_f32_rows_3de_anamorphic_std_deg4_multithread;
 use crate::distortion_process::apply_identity_to_f64_3de_anamorphic_std_deg4_multithread;
 
 use crate::distortion_process::apply_f64_to_f32_3de_anamorphic_std_deg4_rescaled_multithread;
 use crate::distortion_process::apply_f64_to_f64_3de_anamorphic_std_deg4_rescaled_multithread;
 use crate::distortion_process::apply_identity_to_f32_3de_anamorphic_std_deg4_rescaled_multithread;
+use crate::distortion_process::apply_identity_to_f32_rows_3de_anamorphic_std_deg4_rescaled_multithread;
 use crate::distortion_process::apply_identity_to_f64_3de_anamorphic_std_deg4_rescaled_multithread;
 
 #[cxx::bridge(namespace = "mmlens")]
@@ -595,6 +599,21 @@ pub mod ffi {
             lens_parameters: Parameters3deClassic,
         );
 
+        #[cxx_name = "apply_identity_to_f32_rows_multithread"]
+        unsafe fn apply_identity_to_f32_rows_3de_classic_multithread(
+            direction: DistortionDirection,
+            image_width: usize,
+            image_height: usize,
+            start_row: usize,
+            end_row: usize,
+            out_data_ptr: *mut f32,
+            out_data_size: usize,
+            out_data_stride: usize,
+            camera_parameters: CameraParameters,
+            film_back_radius_cm: f64,
+            lens_parameters: Parameters3deClassic,
+        );
+
         #[cxx_name = "apply_f64_to_f64_multithread"]
         unsafe fn apply_f64_to_f64_3de_classic_multithread(
             direction: DistortionDirection,
@@ -652,6 +671,21 @@ pub mod ffi {
             lens_parameters: Parameters3deRadialStdDeg4,
         );
 
+        #[cxx_name = "apply_identity_to_f32_rows_multithread"]
+        unsafe fn apply_identity_to_f32_rows_3de_radial_std_deg4_multithread(
+            direction: DistortionDirection,
+            image_width: usize,
+            image_height: usize,
+            start_row: usize,
+            end_row: usize,
+            out_data_ptr: *mut f32,
+            out_data_size: usize,
+            out_data_stride: usize,
+            camera_parameters: CameraParameters,
+            film_back_radius_cm: f64,
+            lens_parameters: Parameters3deRadialStdDeg4,
+        );
+
         #[cxx_name = "apply_f64_to_f64_multithread"]
         unsafe fn apply_f64_to_f64_3de_radial_std_deg4_multithread(
             direction: DistortionDirection,
@@ -709,6 +743,21 @@ pub mod ffi {
             lens_parameters: Parameters3deAnamorphicStdDeg4,
         );
 
+        #[cxx_name = "apply_identity_to_f32_rows_multithread"]
+        unsafe fn apply_identity_to_f32_rows_3de_anamorphic_std_deg4_multithread(
+            direction: DistortionDirection,
+            image_width: usize,
+            image_height: usize,
+            start_row: usize,
+            end_row: usize,
+            out_data_ptr: *mut f32,
+            out_data_size: usize,
+            out_data_stride: usize,
+            camera_parameters: CameraParameters,
+            film_back_radius_cm: f64,
+            lens_parameters: Parameters3deAnamorphicStdDeg4,
+        );
+
         #[cxx_name = "apply_f64_to_f64_multithread"]
         unsafe fn apply_f64_to_f64_3de_anamorphic_std_deg4_multithread(
             direction: DistortionDirection,
@@ -766,6 +815,21 @@ pub mod ffi {
             lens_parameters: Parameters3deAnamorphicStdDeg4Rescaled,
         );
 
+        #[cxx_name = "apply_identity_to_f32_rows_multithread"]
+        unsafe fn apply_identity_to_f32_rows_3de_anamorphic_std_deg4_rescaled_multithread(
+            direction: DistortionDirection,
+            image_width: usize,
+            image_height: usize,
+            start_row: usize,
+            end_row: usize,
+            out_data_ptr: *mut f32,
+            out_data_size: usize,
+            out_data_stride: usize,
+            camera_parameters: CameraParameters,
+            film_back_radius_cm: f64,
+            lens_parameters: Parameters3deAnamorphicStdDeg4Rescaled,
+        );
+
         #[cxx_name = "apply_f64_to_f64_multithread"]
         unsafe fn apply_f64_to_f64_3de_anamorphic_std_deg4_rescaled_multithread(
             direction: DistortionDirection,
@@ -34,7 +34,7 @@ template <DistortionDirection DIRECTION, class IN_TYPE, class OUT_TYPE,
 std::pair<OUT_TYPE, OUT_TYPE> apply_lens_distortion_once(
     const IN_TYPE in_x, const IN_TYPE in_y,
     const CameraParameters camera_parameters, const double film_back_radius_cm,
-    LENS_TYPE lens) {
+    const LENS_TYPE &lens) {
     auto out_x = static_cast<OUT_TYPE>(0);
     auto out_y = static_cast<OUT_TYPE>(0);
 
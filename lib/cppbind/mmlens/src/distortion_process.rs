@@ -133,6 +133,9 @@ fn apply_identity_func<
     }
 }
 
+/// Compute the identity coordinates of rows 'start_row' to 'end_row'
+/// (exclusive) of the image, into 'out_data_ptr', which holds only
+/// those rows.
 fn apply_identity_multithread<
     T: Copy + Send + Sync,
     LensParameter: Copy + Sized + Send + Sync,
@@ -140,6 +143,8 @@ fn apply_identity_multithread<
     direction: BindDistortionDirection,
     image_width: usize,
     image_height: usize,
+    start_row: usize,
+    end_row: usize,
     num_channels: usize,
     out_data_ptr: *mut T,
     out_data_size: usize,
@@ -196,7 +201,8 @@ fn apply_identity_multithread<
                 / (core::mem::size_of::<T>() * chunk_size);
 
             let start_image_width = 0;
-            let start_image_height = image_height_offset * parallel_scanlines;
+            let start_image_height =
+                start_row + (image_height_offset * parallel_scanlines);
             let end_image_width = image_width;
             let end_image_height = start_image_height + parallel_scanlines;
 
@@ -222,9 +228,9 @@ fn apply_identity_multithread<
         let remainder_rows = remainder_count / image_width;
 
         let start_image_width = 0;
-        let start_image_height = image_height - remainder_rows;
+        let start_image_height = end_row - remainder_rows;
         let end_image_width = image_width;
-        let end_image_height = image_height;
+        let end_image_height = end_row;
 
         apply_identity_func(
             direction,
@@ -465,6 +471,8 @@ pub fn apply_identity_to_f64_3de_classic_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -490,6 +498,40 @@ pub fn apply_identity_to_f32_3de_classic_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
+        out_data_stride,
+        out_data_ptr,
+        out_data_size,
+        camera_parameters,
+        film_back_radius_cm,
+        lens_parameters,
+        apply_identity_to_f32_3de_classic,
+    );
+}
+
+/// Compute the identity coordinates of rows 'start_row' to
+/// 'end_row' (exclusive) of the image; 'out_data_ptr' holds only
+/// those rows.
+pub fn apply_identity_to_f32_rows_3de_classic_multithread(
+    direction: BindDistortionDirection,
+    image_width: usize,
+    image_height: usize,
+    start_row: usize,
+    end_row: usize,
+    out_data_ptr: *mut f32,
+    out_data_size: usize,
+    out_data_stride: usize,
+    camera_parameters: BindCameraParameters,
+    film_back_radius_cm: f64,
+    lens_parameters: BindParameters3deClassic,
+) {
+    apply_identity_multithread::<f32, BindParameters3deClassic>(
+        direction,
+        image_width,
+        image_height,
+        start_row,
+        end_row,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -572,6 +614,8 @@ pub fn apply_identity_to_f64_3de_radial_std_deg4_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -597,6 +641,40 @@ pub fn apply_identity_to_f32_3de_radial_std_deg4_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
+        out_data_stride,
+        out_data_ptr,
+        out_data_size,
+        camera_parameters,
+        film_back_radius_cm,
+        lens_parameters,
+        apply_identity_to_f32_3de_radial_std_deg4,
+    );
+}
+
+/// Compute the identity coordinates of rows 'start_row' to
+/// 'end_row' (exclusive) of the image; 'out_data_ptr' holds only
+/// those rows.
+pub fn apply_identity_to_f32_rows_3de_radial_std_deg4_multithread(
+    direction: BindDistortionDirection,
+    image_width: usize,
+    image_height: usize,
+    start_row: usize,
+    end_row: usize,
+    out_data_ptr: *mut f32,
+    out_data_size: usize,
+    out_data_stride: usize,
+    camera_parameters: BindCameraParameters,
+    film_back_radius_cm: f64,
+    lens_parameters: BindParameters3deRadialStdDeg4,
+) {
+    apply_identity_multithread::<f32, BindParameters3deRadialStdDeg4>(
+        direction,
+        image_width,
+        image_height,
+        start_row,
+        end_row,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -679,6 +757,8 @@ pub fn apply_identity_to_f64_3de_anamorphic_std_deg4_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -704,6 +784,40 @@ pub fn apply_identity_to_f32_3de_anamorphic_std_deg4_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
+        out_data_stride,
+        out_data_ptr,
+        out_data_size,
+        camera_parameters,
+        film_back_radius_cm,
+        lens_parameters,
+        apply_identity_to_f32_3de_anamorphic_std_deg4,
+    );
+}
+
+/// Compute the identity coordinates of rows 'start_row' to
+/// 'end_row' (exclusive) of the image; 'out_data_ptr' holds only
+/// those rows.
+pub fn apply_identity_to_f32_rows_3de_anamorphic_std_deg4_multithread(
+    direction: BindDistortionDirection,
+    image_width: usize,
+    image_height: usize,
+    start_row: usize,
+    end_row: usize,
+    out_data_ptr: *mut f32,
+    out_data_size: usize,
+    out_data_stride: usize,
+    camera_parameters: BindCameraParameters,
+    film_back_radius_cm: f64,
+    lens_parameters: BindParameters3deAnamorphicStdDeg4,
+) {
+    apply_identity_multithread::<f32, BindParameters3deAnamorphicStdDeg4>(
+        direction,
+        image_width,
+        image_height,
+        start_row,
+        end_row,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -786,6 +900,8 @@ pub fn apply_identity_to_f64_3de_anamorphic_std_deg4_rescaled_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -811,6 +927,40 @@ pub fn apply_identity_to_f32_3de_anamorphic_std_deg4_rescaled_multithread(
         direction,
         image_width,
         image_height,
+        0,
+        image_height,
+        out_data_stride,
+        out_data_ptr,
+        out_data_size,
+        camera_parameters,
+        film_back_radius_cm,
+        lens_parameters,
+        apply_identity_to_f32_3de_anamorphic_std_deg4_rescaled,
+    );
+}
+
+/// Compute the identity coordinates of rows 'start_row' to
+/// 'end_row' (exclusive) of the image; 'out_data_ptr' holds only
+/// those rows.
+pub fn apply_identity_to_f32_rows_3de_anamorphic_std_deg4_rescaled_multithread(
+    direction: BindDistortionDirection,
+    image_width: usize,
+    image_height: usize,
+    start_row: usize,
+    end_row: usize,
+    out_data_ptr: *mut f32,
+    out_data_size: usize,
+    out_data_stride: usize,
+    camera_parameters: BindCameraParameters,
+    film_back_radius_cm: f64,
+    lens_parameters: BindParameters3deAnamorphicStdDeg4Rescaled,
+) {
+    apply_identity_multithread::<f32, BindParameters3deAnamorphicStdDeg4Rescaled>(
+        direction,
+        image_width,
+        image_height,
+        start_row,
+        end_row,
         out_data_stride,
         out_data_ptr,
         out_data_size,
@@ -26,19 +26,42 @@
 #include <mmlens/lib.h>
 
 #include <functional>
+#include <memory>
 
 #include "distortion_operations.h"
 #include "distortion_structs.h"
 
 namespace mmlens {
 
-void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelUndistort(
-    const double xd, const double yd, double &xu, double &yu) {
-    if (m_state != LensModelState::kClean) {
+void LensModel3deAnamorphicDeg4RotateSqueezeXY::prepare() {
+    prepareOnce([this]() {
         m_film_back_radius_cm =
             mmlens::compute_diagonal_normalized_camera_factor(m_camera);
-        m_state = LensModelState::kClean;
-    }
+
+        // The distortion parameters are set up once, and re-used until
+        // the lens model changes.
+        auto distortion = std::make_shared<Distortion3deAnamorphicStdDeg4>();
+        distortion->set_parameter(0, m_lens.degree2_cx02);
+        distortion->set_parameter(1, m_lens.degree2_cy02);
+        distortion->set_parameter(2, m_lens.degree2_cx22);
+        distortion->set_parameter(3, m_lens.degree2_cy22);
+        distortion->set_parameter(4, m_lens.degree4_cx04);
+        distortion->set_parameter(5, m_lens.degree4_cy04);
+        distortion->set_parameter(6, m_lens.degree4_cx24);
+        distortion->set_parameter(7, m_lens.degree4_cy24);
+        distortion->set_parameter(8, m_lens.degree4_cx44);
+        distortion->set_parameter(9, m_lens.degree4_cy44);
+        distortion->set_parameter(10, m_lens.lens_rotation);
+        distortion->set_parameter(11, m_lens.squeeze_x);
+        distortion->set_parameter(12, m_lens.squeeze_y);
+        distortion->initialize_parameters(m_camera);
+        m_distortion = distortion;
+    });
+}
+
+void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelUndistort(
+    const double xd, const double yd, double &xu, double &yu) {
+    prepare();
 
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
@@ -48,28 +71,12 @@ void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelUndistort(
         inputLensModel->applyModelUndistort(xdd, ydd, xdd, ydd);
     }
 
-    auto distortion = Distortion3deAnamorphicStdDeg4();
-    distortion.set_parameter(0, m_lens.degree2_cx02);
-    distortion.set_parameter(1, m_lens.degree2_cy02);
-    distortion.set_parameter(2, m_lens.degree2_cx22);
-    distortion.set_parameter(3, m_lens.degree2_cy22);
-    distortion.set_parameter(4, m_lens.degree4_cx04);
-    distortion.set_parameter(5, m_lens.degree4_cy04);
-    distortion.set_parameter(6, m_lens.degree4_cx24);
-    distortion.set_parameter(7, m_lens.degree4_cy24);
-    distortion.set_parameter(8, m_lens.degree4_cx44);
-    distortion.set_parameter(9, m_lens.degree4_cy44);
-    distortion.set_parameter(10, m_lens.lens_rotation);
-    distortion.set_parameter(11, m_lens.squeeze_x);
-    distortion.set_parameter(12, m_lens.squeeze_y);
-    distortion.initialize_parameters(m_camera);
-
     // 'undistort' expects values 0.0 to 1.0, but our inputs are -0.5
     // to 0.5, therefore we must convert.
     const auto direction = DistortionDirection::kUndistort;
     auto out_xy = apply_lens_distortion_once<direction, double, double,
                                              Distortion3deAnamorphicStdDeg4>(
-        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, distortion);
+        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, *m_distortion);
 
     // Convert back to -0.5 to 0.5 coordinate space.
     xu = out_xy.first - 0.5;
@@ -77,13 +84,38 @@ void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelUndistort(
     return;
 }
 
+void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelUndistortPoints(
+    const double *in_xy, double *out_xy, const size_t point_count) {
+    prepare();
+
+    // Apply the 'previous' lens model in the chain, to all points.
+    std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
+    const double *xy = in_xy;
+    if (inputLensModel != nullptr) {
+        inputLensModel->applyModelUndistortPoints(in_xy, out_xy, point_count);
+        xy = out_xy;
+    }
+
+    // 'undistort' expects values 0.0 to 1.0, but our inputs are -0.5
+    // to 0.5, therefore we must convert.
+    const auto direction = DistortionDirection::kUndistort;
+    for (size_t i = 0; i < point_count; ++i) {
+        auto out_point =
+            apply_lens_distortion_once<direction, double, double,
+                                       Distortion3deAnamorphicStdDeg4>(
+                xy[(i * 2) + 0] + 0.5, xy[(i * 2) + 1] + 0.5, m_camera,
+                m_film_back_radius_cm, *m_distortion);
+
+        // Convert back to -0.5 to 0.5 coordinate space.
+        out_xy[(i * 2) + 0] = out_point.first - 0.5;
+        out_xy[(i * 2) + 1] = out_point.second - 0.5;
+    }
+    return;
+}
+
 void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelDistort(
     const double xd, const double yd, double &xu, double &yu) {
-    if (m_state != LensModelState::kClean) {
-        m_film_back_radius_cm =
-            mmlens::compute_diagonal_normalized_camera_factor(m_camera);
-        m_state = LensModelState::kClean;
-    }
+    prepare();
 
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
@@ -93,28 +125,12 @@ void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelDistort(
         inputLensModel->applyModelDistort(xdd, ydd, xdd, ydd);
     }
 
-    auto distortion = Distortion3deAnamorphicStdDeg4();
-    distortion.set_parameter(0, m_lens.degree2_cx02);
-    distortion.set_parameter(1, m_lens.degree2_cy02);
-    distortion.set_parameter(2, m_lens.degree2_cx22);
-    distortion.set_parameter(3, m_lens.degree2_cy22);
-    distortion.set_parameter(4, m_lens.degree4_cx04);
-    distortion.set_parameter(5, m_lens.degree4_cy04);
-    distortion.set_parameter(6, m_lens.degree4_cx24);
-    distortion.set_parameter(7, m_lens.degree4_cy24);
-    distortion.set_parameter(8, m_lens.degree4_cx44);
-    distortion.set_parameter(9, m_lens.degree4_cy44);
-    distortion.set_parameter(10, m_lens.lens_rotation);
-    distortion.set_parameter(11, m_lens.squeeze_x);
-    distortion.set_parameter(12, m_lens.squeeze_y);
-    distortion.initialize_parameters(m_camera);
-
     // 'undistort' expects values 0.0 to 1.0, but our inputs are -0.5
     // to 0.5, therefore we must convert.
     const auto direction = DistortionDirection::kRedistort;
     auto out_xy = apply_lens_distortion_once<direction, double, double,
                                              Distortion3deAnamorphicStdDeg4>(
-        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, distortion);
+        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, *m_distortion);
 
     // Convert back to -0.5 to 0.5 coordinate space.
     xu = out_xy.first - 0.5;
@@ -122,7 +138,8 @@ void LensModel3deAnamorphicDeg4RotateSqueezeXY::applyModelDistort(
     return;
 }
 
-mmhash::HashValue LensModel3deAnamorphicDeg4RotateSqueezeXY::hashValue() {
+mmhash::HashValue
+LensModel3deAnamorphicDeg4RotateSqueezeXY::computeHashValue() {
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
     mmhash::HashValue hash = 0;
@@ -28,19 +28,34 @@
 #include <mmlens/lib.h>
 
 #include <functional>
+#include <memory>
 
 #include "distortion_operations.h"
 #include "distortion_structs.h"
 
 namespace mmlens {
 
-void LensModel3deClassic::applyModelUndistort(const double xd, const double yd,
-                                              double &xu, double &yu) {
-    if (m_state != LensModelState::kClean) {
+void LensModel3deClassic::prepare() {
+    prepareOnce([this]() {
         m_film_back_radius_cm =
             mmlens::compute_diagonal_normalized_camera_factor(m_camera);
-        m_state = LensModelState::kClean;
-    }
+
+        // The distortion parameters are set up once, and re-used until
+        // the lens model changes.
+        auto distortion = std::make_shared<Distortion3deClassic>();
+        distortion->set_parameter(0, m_lens.distortion);
+        distortion->set_parameter(1, m_lens.anamorphic_squeeze);
+        distortion->set_parameter(2, m_lens.curvature_x);
+        distortion->set_parameter(3, m_lens.curvature_y);
+        distortion->set_parameter(4, m_lens.quartic_distortion);
+        distortion->initialize_parameters(m_camera);
+        m_distortion = distortion;
+    });
+}
+
+void LensModel3deClassic::applyModelUndistort(const double xd, const double yd,
+                                              double &xu, double &yu) {
+    prepare();
 
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
@@ -50,21 +65,13 @@ void LensModel3deClassic::applyModelUndistort(const double xd, const double yd,
         inputLensModel->applyModelUndistort(xdd, ydd, xdd, ydd);
     }
 
-    auto distortion = Distortion3deClassic();
-    distortion.set_parameter(0, m_lens.distortion);
-    distortion.set_parameter(1, m_lens.anamorphic_squeeze);
-    distortion.set_parameter(2, m_lens.curvature_x);
-    distortion.set_parameter(3, m_lens.curvature_y);
-    distortion.set_parameter(4, m_lens.quartic_distortion);
-    distortion.initialize_parameters(m_camera);
-
     const auto direction = DistortionDirection::kUndistort;
 
     // 'undistort' expects values 0.0 to 1.0, but our inputs are -0.5
     // to 0.5, therefore we must convert.
     auto out_xy = apply_lens_distortion_once<direction, double, double,
                                              Distortion3deClassic>(
-        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, distortion);
+        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, *m_distortion);
 
     // Convert back to -0.5 to 0.5 coordinate space.
     xu = out_xy.first - 0.5;
@@ -72,13 +79,39 @@ void LensModel3deClassic::applyModelUndistort(const double xd, const double yd,
     return;
 }
 
+void LensModel3deClassic::applyModelUndistortPoints(const double *in_xy,
+                                                    double *out_xy,
+                                                    const size_t point_count) {
+    prepare();
+
+    // Apply the 'previous' lens model in the chain, to all points.
+    std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
+    const double *xy = in_xy;
+    if (inputLensModel != nullptr) {
+        inputLensModel->applyModelUndistortPoints(in_xy, out_xy, point_count);
+        xy = out_xy;
+    }
+
+    // 'undistort' expects values 0.0 to 1.0, but our inputs are -0.5
+    // to 0.5, therefore we must convert.
+    const auto direction = DistortionDirection::kUndistort;
+    for (size_t i = 0; i < point_count; ++i) {
+        auto out_point =
+            apply_lens_distortion_once<direction, double, double,
+                                       Distortion3deClassic>(
+                xy[(i * 2) + 0] + 0.5, xy[(i * 2) + 1] + 0.5, m_camera,
+                m_film_back_radius_cm, *m_distortion);
+
+        // Convert back to -0.5 to 0.5 coordinate space.
+        out_xy[(i * 2) + 0] = out_point.first - 0.5;
+        out_xy[(i * 2) + 1] = out_point.second - 0.5;
+    }
+    return;
+}
+
 void LensModel3deClassic::applyModelDistort(const double xd, const double yd,
                                             double &xu, double &yu) {
-    if (m_state != LensModelState::kClean) {
-        m_film_back_radius_cm =
-            mmlens::compute_diagonal_normalized_camera_factor(m_camera);
-        m_state = LensModelState::kClean;
-    }
+    prepare();
 
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
@@ -88,21 +121,13 @@ void LensModel3deClassic::applyModelDistort(const double xd, const double yd,
         inputLensModel->applyModelDistort(xdd, ydd, xdd, ydd);
     }
 
-    auto distortion = Distortion3deClassic();
-    distortion.set_parameter(0, m_lens.distortion);
-    distortion.set_parameter(1, m_lens.anamorphic_squeeze);
-    distortion.set_parameter(2, m_lens.curvature_x);
-    distortion.set_parameter(3, m_lens.curvature_y);
-    distortion.set_parameter(4, m_lens.quartic_distortion);
-    distortion.initialize_parameters(m_camera);
-
     const auto direction = DistortionDirection::kRedistort;
 
     // The lens distortion operation expects values 0.0 to 1.0, but
     // our inputs are -0.5 to 0.5, therefore we must convert.
     auto out_xy = apply_lens_distortion_once<direction, double, double,
                                              Distortion3deClassic>(
-        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, distortion);
+        xdd + 0.5, ydd + 0.5, m_camera, m_film_back_radius_cm, *m_distortion);
 
     // Convert back to -0.5 to 0.5 coordinate space.
     xu = out_xy.first - 0.5;
@@ -110,7 +135,7 @@ void LensModel3deClassic::applyModelDistort(const double xd, const double yd,
     return;
 }
 
-mmhash::HashValue LensModel3deClassic::hashValue() {
+mmhash::HashValue LensModel3deClassic::computeHashValue() {
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
     mmhash::HashValue hash = 0;
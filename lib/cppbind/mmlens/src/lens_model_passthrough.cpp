@@ -56,7 +56,7 @@ void LensModelPassthrough::applyModelDistort(const double xd, const double yd,
     return;
 }
 
-mmhash::HashValue LensModelPassthrough::hashValue() {
+mmhash::HashValue LensModelPassthrough::computeHashValue() {
     // Apply the 'previous' lens model in the chain.
     std::shared_ptr<LensModel> inputLensModel = LensModel::getInputLensModel();
     mmhash::HashValue hash = 0;
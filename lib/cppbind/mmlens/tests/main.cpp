@@ -35,6 +35,7 @@
 #include "test_both_3de_classic.h"
 #include "test_both_3de_radial_std_deg4.h"
 #include "test_lens_file_load.h"
+#include "test_lens_model_hash.h"
 #include "test_once_3de_anamorphic_std_deg4.h"
 #include "test_once_3de_anamorphic_std_deg4_rescaled.h"
 #include "test_once_3de_classic.h"
@@ -220,5 +221,8 @@ int main(int argc, char* argv[]) {
     test_lens_file_load(dir_path, "test_file_3de_anamorphic_std_deg4_3.nk");
     test_lens_file_load(dir_path,
                         "test_file_3de_anamorphic_std_deg4_rescaled_3.nk");
-    return 0;
+
+    // Cached lens model hashes and prepared evaluation.
+    const int status = test_lens_model_hash(verbosity);
+    return status;
 }
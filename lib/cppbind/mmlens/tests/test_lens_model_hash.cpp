@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Test the cached hash and the prepared evaluation of a chain of lens
+ * models are updated when any lens model in the chain changes, and
+ * may be first used from many threads at once.
+ */
+
+#include "test_lens_model_hash.h"
+
+#include <mmlens/mmlens.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool check(const char* test_name, const char* check_name,
+           const bool value) {
+    if (!value) {
+        std::cout << test_name << ": FAILED: " << check_name << std::endl;
+    }
+    return value;
+}
+
+std::shared_ptr<mmlens::LensModel> create_lens_chain(
+    const double distortion, const double quartic_distortion) {
+    auto lens_a = std::make_shared<mmlens::LensModel3deClassic>();
+    lens_a->setDistortion(distortion);
+
+    auto lens_b = std::make_shared<mmlens::LensModel3deClassic>();
+    lens_b->setQuarticDistortion(quartic_distortion);
+    lens_b->setInputLensModel(lens_a);
+    return lens_b;
+}
+
+}  // namespace
+
+int test_lens_model_hash(const int verbosity) {
+    const auto test_name = "test_lens_model_hash";
+    std::cout << "Running... " << test_name << std::endl;
+
+    auto lens_a = std::make_shared<mmlens::LensModel3deClassic>();
+    lens_a->setDistortion(0.1);
+
+    auto lens_b = std::make_shared<mmlens::LensModel3deClassic>();
+    lens_b->setQuarticDistortion(0.1);
+    lens_b->setInputLensModel(lens_a);
+
+    bool ok = true;
+
+    // An unchanged lens chain gives the same (cached) values.
+    const mmhash::HashValue hash_1 = lens_b->hashValue();
+    const uint64_t version_1 = lens_b->getVersion();
+    ok &= check(test_name, "unchanged hash", lens_b->hashValue() == hash_1);
+    ok &= check(test_name, "unchanged version",
+                lens_b->getVersion() == version_1);
+
+    // A change to the input lens model changes the hash and version
+    // of the output lens model.
+    lens_a->setDistortion(0.2);
+    const mmhash::HashValue hash_2 = lens_b->hashValue();
+    const uint64_t version_2 = lens_b->getVersion();
+    ok &= check(test_name, "input changed hash", hash_2 != hash_1);
+    ok &= check(test_name, "input changed version", version_2 > version_1);
+
+    // The hash depends only on the lens parameters, but the version
+    // always increases.
+    lens_a->setDistortion(0.1);
+    ok &= check(test_name, "input reverted hash",
+                lens_b->hashValue() == hash_1);
+    ok &= check(test_name, "input reverted version",
+                lens_b->getVersion() > version_2);
+
+    // The prepared evaluation is updated after a change, giving the
+    // same values as a newly created lens chain.
+    const double x = 0.3;
+    const double y = -0.2;
+    double out_x = 0.0;
+    double out_y = 0.0;
+    lens_b->applyModelUndistort(x, y, out_x, out_y);
+    lens_a->setDistortion(0.2);
+    lens_b->applyModelUndistort(x, y, out_x, out_y);
+
+    std::shared_ptr<mmlens::LensModel> lens_c = create_lens_chain(0.2, 0.1);
+    double expected_x = 0.0;
+    double expected_y = 0.0;
+    lens_c->applyModelUndistort(x, y, expected_x, expected_y);
+    ok &= check(test_name, "prepared evaluation",
+                (std::fabs(out_x - expected_x) < 1e-12) &&
+                    (std::fabs(out_y - expected_y) < 1e-12));
+    ok &= check(test_name, "new lens chain hash",
+                lens_c->hashValue() == lens_b->hashValue());
+
+    // The hash and the prepared evaluation are computed lazily; many
+    // threads using a changed lens chain at once must all see the
+    // same values.
+    lens_a->setDistortion(0.3);
+    std::shared_ptr<mmlens::LensModel> lens_d = create_lens_chain(0.3, 0.1);
+    const mmhash::HashValue expected_hash = lens_d->hashValue();
+    lens_d->applyModelUndistort(x, y, expected_x, expected_y);
+
+    const size_t thread_count = 8;
+    std::vector<mmhash::HashValue> thread_hashes(thread_count, 0);
+    std::vector<double> thread_xy(thread_count * 2, 0.0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&lens_b, &thread_hashes, &thread_xy, x, y, i]() {
+            lens_b->applyModelUndistort(x, y, thread_xy[(i * 2) + 0],
+                                        thread_xy[(i * 2) + 1]);
+            thread_hashes[i] = lens_b->hashValue();
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        ok &= check(test_name, "threaded hash",
+                    thread_hashes[i] == expected_hash);
+        ok &= check(
+            test_name, "threaded evaluation",
+            (std::fabs(thread_xy[(i * 2) + 0] - expected_x) < 1e-12) &&
+                (std::fabs(thread_xy[(i * 2) + 1] - expected_y) < 1e-12));
+    }
+
+    if (verbosity >= 1) {
+        std::cout << test_name << ": hash=" << lens_b->hashValue()
+                  << " version=" << lens_b->getVersion() << std::endl;
+    }
+
+    std::cout << test_name << ": " << (ok ? "passed" : "failed")
+              << std::endl;
+    return ok ? 0 : 1;
+}
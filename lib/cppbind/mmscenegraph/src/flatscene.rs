@@ -21,6 +21,8 @@
 use crate::attrdatablock::ShimAttrDataBlock;
 use mmscenegraph_rust::constant::FrameValue as CoreFrameValue;
 use mmscenegraph_rust::constant::Real as CoreReal;
+use mmscenegraph_rust::math::dag::DagLevelSchedule as CoreDagLevelSchedule;
+use mmscenegraph_rust::math::rotate::euler::RotateOrder as CoreRotateOrder;
 use mmscenegraph_rust::scene::flat::FlatScene as CoreFlatScene;
 
 pub struct ShimFlatScene {
@@ -70,14 +72,16 @@ pub fn shim_create_flat_scene_box() -> Box<ShimFlatScene> {
     let mkr_cam_indices = Vec::new();
     let mkr_bnd_indices = Vec::new();
     let tfm_attr_list = Vec::new();
-    let rotate_order_list = Vec::new();
+    let rotate_order_list: Vec<CoreRotateOrder> = Vec::new();
     let cam_attr_list = Vec::new();
     let cam_film_fit_list = Vec::new();
     let cam_render_res_list = Vec::new();
     let mkr_attr_list = Vec::new();
     let tfm_node_ids = Vec::new();
     let tfm_node_indices = Vec::new();
-    let tfm_node_parent_indices = Vec::new();
+    let tfm_node_parent_indices: Vec<Option<usize>> = Vec::new();
+    let tfm_level_schedule =
+        CoreDagLevelSchedule::new(&tfm_node_parent_indices, &rotate_order_list);
     let core_flat_scene = CoreFlatScene::new(
         bnd_ids,
         cam_ids,
@@ -93,6 +97,7 @@ pub fn shim_create_flat_scene_box() -> Box<ShimFlatScene> {
         tfm_node_ids,
         tfm_node_indices,
         tfm_node_parent_indices,
+        tfm_level_schedule,
     );
     Box::new(ShimFlatScene::new(core_flat_scene))
 }
@@ -0,0 +1,233 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use criterion::measurement::WallTime;
+use criterion::{
+    black_box, criterion_group, criterion_main, BenchmarkGroup, BenchmarkId,
+    Criterion, Throughput,
+};
+use std::path::PathBuf;
+
+use exr::prelude::traits::*;
+
+use mmimage_rust::datatype::ImageRegionRectangle;
+use mmimage_rust::encoder::ExrCompression;
+use mmimage_rust::encoder::ExrLineOrder;
+use mmimage_rust::encoder::ExrPixelLayout;
+use mmimage_rust::encoder::ImageExrEncoder;
+use mmimage_rust::image_read_pixels_exr_f32x1_into;
+use mmimage_rust::image_read_pixels_exr_f32x4;
+use mmimage_rust::image_read_pixels_exr_f32x4_into;
+use mmimage_rust::image_write_pixels_exr_f32x4;
+use mmimage_rust::metadata::ImageMetaData;
+use mmimage_rust::pixelbuffer::BufferDataType;
+use mmimage_rust::pixelbuffer::ImagePixelBuffer;
+
+const IMAGE_SIZES: &[(&str, usize, usize)] =
+    &[("4k", 4096, 2160), ("8k", 8192, 4320)];
+
+/// Write a gradient EXR image, used as the input for the benchmarks.
+fn create_test_image(name: &str, width: usize, height: usize) -> PathBuf {
+    let mut file_path = std::env::temp_dir();
+    file_path.push(format!("mmimage_bench_{}_{}x{}.exr", name, width, height));
+    if file_path.is_file() {
+        return file_path;
+    }
+
+    let mut pixel_buffer = ImagePixelBuffer::new();
+    pixel_buffer.resize(BufferDataType::F32, width, height, 4);
+    for (i, pixel) in pixel_buffer.as_slice_f32x4_mut().iter_mut().enumerate() {
+        let x = (i % width) as f32 / width as f32;
+        let y = (i / width) as f32 / height as f32;
+        *pixel = (x, y, 1.0 - x, 1.0);
+    }
+
+    let encoder = ImageExrEncoder {
+        compression: ExrCompression::ZIP16,
+        pixel_layout: ExrPixelLayout::ScanLines,
+        line_order: ExrLineOrder::Increasing,
+    };
+    let meta_data = ImageMetaData::new();
+    image_write_pixels_exr_f32x4(
+        file_path.to_str().unwrap(),
+        encoder,
+        &meta_data,
+        &pixel_buffer,
+    )
+    .unwrap();
+    file_path
+}
+
+/// The EXR reader before decoding directly into the pixel buffer; one
+/// allocation per scanline, followed by a copy into a flat buffer.
+fn read_exr_f32x4_vec_of_vecs(file_path: &str) -> ImagePixelBuffer {
+    let image = exr::image::read::read()
+        .no_deep_data()
+        .largest_resolution_level()
+        .rgba_channels(
+            |resolution, _channels: &exr::image::RgbaChannels| {
+                let default_pixel = (0.0, 0.0, 0.0, 0.0);
+                let empty_line = vec![default_pixel; resolution.width()];
+                vec![empty_line; resolution.height()]
+            },
+            |pixel_vector, position, (r, g, b, a): (f32, f32, f32, f32)| {
+                pixel_vector[position.y()][position.x()] = (r, g, b, a)
+            },
+        )
+        .first_valid_layer()
+        .all_attributes()
+        .from_file(file_path)
+        .unwrap();
+
+    let image_width = image.layer_data.size.width();
+    let image_height = image.layer_data.size.height();
+    let mut pixel_buffer = ImagePixelBuffer::new();
+    pixel_buffer.resize(BufferDataType::F32, image_width, image_height, 4);
+    let pixels = pixel_buffer.as_slice_f32x4_mut();
+    for y in 0..image_height {
+        for x in 0..image_width {
+            pixels[(image_width * y) + x] =
+                image.layer_data.channel_data.pixels[y][x];
+        }
+    }
+    pixel_buffer
+}
+
+/// Reset and then read the peak resident memory (in KiB) of this
+/// process, when supported by the operating system.
+fn reset_peak_memory() {
+    #[cfg(target_os = "linux")]
+    {
+        // Writing "5" resets the "VmHWM" (peak RSS) value.
+        let _ = std::fs::write("/proc/self/clear_refs", "5");
+    }
+}
+
+fn read_peak_memory_kib() -> Option<usize> {
+    let status = std::fs::read_to_string("/proc/self/status").ok()?;
+    let line = status.lines().find(|line| line.starts_with("VmHWM:"))?;
+    line.split_whitespace().nth(1)?.parse::<usize>().ok()
+}
+
+fn print_peak_memory<F: FnMut()>(label: &str, mut func: F) {
+    reset_peak_memory();
+    let before = read_peak_memory_kib();
+    func();
+    let after = read_peak_memory_kib();
+    if let (Some(before), Some(after)) = (before, after) {
+        println!(
+            "{}: peak RSS {} MiB (+{} MiB)",
+            label,
+            after / 1024,
+            after.saturating_sub(before) / 1024
+        );
+    }
+}
+
+fn bench_read_exr_f32x4_size(
+    group: &mut BenchmarkGroup<WallTime>,
+    name: &str,
+    width: usize,
+    height: usize,
+) {
+    let file_path = create_test_image(name, width, height);
+    let file_path = file_path.to_str().unwrap();
+    let region = ImageRegionRectangle::new(0, 0, width / 2, height / 2);
+
+    print_peak_memory(&format!("{} vec_of_vecs", name), || {
+        black_box(read_exr_f32x4_vec_of_vecs(file_path));
+    });
+    print_peak_memory(&format!("{} new_buffer", name), || {
+        black_box(image_read_pixels_exr_f32x4(file_path).unwrap());
+    });
+    let mut pixel_buffer = ImagePixelBuffer::new();
+    image_read_pixels_exr_f32x4_into(file_path, None, &mut pixel_buffer)
+        .unwrap();
+    print_peak_memory(&format!("{} reuse_buffer", name), || {
+        image_read_pixels_exr_f32x4_into(file_path, None, &mut pixel_buffer)
+            .unwrap();
+    });
+    print_peak_memory(&format!("{} region", name), || {
+        let mut region_buffer = ImagePixelBuffer::new();
+        image_read_pixels_exr_f32x4_into(
+            file_path,
+            Some(&region),
+            &mut region_buffer,
+        )
+        .unwrap();
+        black_box(region_buffer);
+    });
+
+    group.throughput(Throughput::Elements((width * height) as u64));
+    group.bench_function(BenchmarkId::new("vec_of_vecs", name), |b| {
+        b.iter(|| read_exr_f32x4_vec_of_vecs(black_box(file_path)))
+    });
+    group.bench_function(BenchmarkId::new("new_buffer", name), |b| {
+        b.iter(|| image_read_pixels_exr_f32x4(black_box(file_path)).unwrap())
+    });
+    group.bench_function(BenchmarkId::new("reuse_buffer", name), |b| {
+        b.iter(|| {
+            image_read_pixels_exr_f32x4_into(
+                black_box(file_path),
+                None,
+                &mut pixel_buffer,
+            )
+            .unwrap()
+        })
+    });
+    group.bench_function(BenchmarkId::new("region", name), |b| {
+        b.iter(|| {
+            image_read_pixels_exr_f32x4_into(
+                black_box(file_path),
+                Some(&region),
+                &mut pixel_buffer,
+            )
+            .unwrap()
+        })
+    });
+    group.bench_function(BenchmarkId::new("channel_r", name), |b| {
+        b.iter(|| {
+            image_read_pixels_exr_f32x1_into(
+                black_box(file_path),
+                "R",
+                None,
+                &mut pixel_buffer,
+            )
+            .unwrap()
+        })
+    });
+}
+
+fn bench_read_exr_f32x4(c: &mut Criterion) {
+    let mut group = c.benchmark_group("read_exr_f32x4");
+    // Each sample decodes a full (large) image.
+    group.sample_size(10);
+    for (name, width, height) in IMAGE_SIZES {
+        bench_read_exr_f32x4_size(&mut group, name, *width, *height);
+    }
+    group.finish();
+}
+
+criterion_group!(
+    name = benches;
+    config = Criterion::default().with_measurement(WallTime);
+    targets = bench_read_exr_f32x4
+);
+criterion_main!(benches);
@@ -18,20 +18,34 @@
 // ====================================================================
 //
 
+use crate::datatype::ImageRegionRectangle;
 use crate::encoder::ImageExrEncoder;
 use crate::metadata::ImageMetaData;
+use crate::pixelbuffer::convert_pixel_buffer_to_f16;
 use crate::pixelbuffer::BufferDataType;
 use crate::pixelbuffer::ImagePixelBuffer;
+use crate::pixeldata::ImagePixelDataF16x4;
 use crate::pixeldata::ImagePixelDataF32x4;
+use crate::resize::image_downsample_pixel_buffer;
+use crate::resize::image_proxy_level_size;
+use crate::resize::ImageResizeFilter;
 use anyhow::bail;
 use anyhow::Result;
+use exr::block::samples::Sample;
 use exr::prelude::traits::*;
+use std::cell::Cell;
+use std::path::Path;
+use std::path::PathBuf;
 
 pub mod datatype;
 pub mod encoder;
 pub mod metadata;
 pub mod pixelbuffer;
 pub mod pixeldata;
+pub mod resize;
+pub mod sequence;
+pub mod stream;
+pub mod warp;
 
 /// Read the Metadata from an EXR image.
 //
@@ -57,81 +71,311 @@ pub fn image_read_metadata_exr(file_path: &str) -> Result<ImageMetaData> {
     Ok(image_metadata)
 }
 
-/// Read an EXR image from a file path.
+/// Clamp the (optional) region to an image of the given resolution.
+///
+/// The region is relative to the top-left of the EXR data window,
+/// and the returned tuple is (min_x, min_y, width, height).
+fn clamp_read_region(
+    resolution: exr::math::Vec2<usize>,
+    region: Option<&ImageRegionRectangle>,
+) -> (usize, usize, usize, usize) {
+    match region {
+        None => (0, 0, resolution.width(), resolution.height()),
+        Some(region) => {
+            let min_x = std::cmp::min(
+                std::cmp::max(region.position_x, 0) as usize,
+                resolution.width(),
+            );
+            let min_y = std::cmp::min(
+                std::cmp::max(region.position_y, 0) as usize,
+                resolution.height(),
+            );
+            let max_x =
+                std::cmp::min(min_x + region.size_x, resolution.width());
+            let max_y =
+                std::cmp::min(min_y + region.size_y, resolution.height());
+            (min_x, min_y, max_x - min_x, max_y - min_y)
+        }
+    }
+}
+
+/// The pixel storage that EXR pixels are decoded into.
+struct ExrReadTarget {
+    min_x: usize,
+    min_y: usize,
+    buffer: ImagePixelBuffer,
+}
+
+impl ExrReadTarget {
+    fn new(
+        reuse_buffer: &Cell<Option<ImagePixelBuffer>>,
+        resolution: exr::math::Vec2<usize>,
+        region: Option<&ImageRegionRectangle>,
+        data_type: BufferDataType,
+        num_channels: usize,
+    ) -> ExrReadTarget {
+        let (min_x, min_y, width, height) =
+            clamp_read_region(resolution, region);
+        let mut buffer = reuse_buffer
+            .take()
+            .unwrap_or_else(|| ImagePixelBuffer::new());
+        buffer.resize(data_type, width, height, num_channels);
+        ExrReadTarget {
+            min_x,
+            min_y,
+            buffer,
+        }
+    }
+
+    /// The index of the pixel in the buffer, or None if the pixel is
+    /// outside the region being read.
+    fn pixel_index(&self, position: exr::math::Vec2<usize>) -> Option<usize> {
+        if position.x() < self.min_x || position.y() < self.min_y {
+            return None;
+        }
+        let x = position.x() - self.min_x;
+        let y = position.y() - self.min_y;
+        let width = self.buffer.image_width();
+        if x < width && y < self.buffer.image_height() {
+            Some((width * y) + x)
+        } else {
+            None
+        }
+    }
+}
+
+/// Read the RGBA channels of an EXR image from a file path, into an
+/// existing pixel buffer.
+///
+/// Pixels are decoded directly into the memory of
+/// 'out_pixel_buffer', by position, without any intermediate image
+/// copy. The buffer's memory is re-used (and only grown when
+/// needed), so reading many frames of the same size into the same
+/// buffer does not allocate.
+///
+/// When 'region' is given, only the pixels inside the region are
+/// stored, and the buffer is sized to the region (clamped to the
+/// image). The region is relative to the top-left of the EXR data
+/// window.
+///
+/// If reading fails, the 'out_pixel_buffer' contents are undefined.
 //
 // https://github.com/johannesvollmer/exrs/blob/master/GUIDE.md
 // https://github.com/johannesvollmer/exrs/blob/master/examples/0c_read_rgba.rs
-pub fn image_read_pixels_exr_f32x4(
+pub fn image_read_pixels_exr_f32x4_into(
     file_path: &str,
-) -> Result<(ImageMetaData, ImagePixelBuffer)> {
+    region: Option<&ImageRegionRectangle>,
+    out_pixel_buffer: &mut ImagePixelBuffer,
+) -> Result<ImageMetaData> {
+    // The 'exrs' crate creates the pixel storage inside a 'Fn'
+    // closure, so the caller's buffer is moved in and out through a
+    // Cell.
+    let reuse_buffer = Cell::new(Some(std::mem::replace(
+        out_pixel_buffer,
+        ImagePixelBuffer::new(),
+    )));
+
+    let num_channels = 4;
     let image = exr::image::read::read()
         .no_deep_data()
         .largest_resolution_level()
         .rgba_channels(
             |resolution, _channels: &exr::image::RgbaChannels| {
-                // instantiate your image type with the size of the image in
-                // file.
-                let default_pixel = (0.0, 0.0, 0.0, 0.0);
-                let empty_line = vec![default_pixel; resolution.width()];
-                let empty_image = vec![empty_line; resolution.height()];
-                empty_image
+                ExrReadTarget::new(
+                    &reuse_buffer,
+                    resolution,
+                    region,
+                    BufferDataType::F32,
+                    num_channels,
+                )
             },
-            |pixel_vector, position, (r, g, b, a): (f32, f32, f32, f32)| {
-                // transfer the colors from the file to your image type,
-                // requesting all values to be converted to f32 numbers (you
-                // can also directly use f16 instead) and you could also use
-                // `Sample` instead of `f32` to keep the original data type
-                // from the file
-                pixel_vector[position.y()][position.x()] = (r, g, b, a)
+            |target: &mut ExrReadTarget,
+             position,
+             (r, g, b, a): (f32, f32, f32, f32)| {
+                if let Some(index) = target.pixel_index(position) {
+                    target.buffer.as_slice_f32x4_mut()[index] = (r, g, b, a);
+                }
             },
         )
         .first_valid_layer()
         .all_attributes()
-        .from_file(file_path)?;
+        .from_file(file_path);
+
+    let image = match image {
+        Ok(value) => value,
+        Err(err) => {
+            // Give the buffer back if the pixels were never created.
+            if let Some(buffer) = reuse_buffer.take() {
+                *out_pixel_buffer = buffer;
+            }
+            bail!(err)
+        }
+    };
 
-    // printing all pixels might kill the console, so only print some
-    // meta data about the image.
-    let _data_window = image.layer_data.absolute_bounds();
     let layer_attributes = image.layer_data.attributes;
-    let image_width = image.layer_data.size.width();
-    let image_height = image.layer_data.size.height();
-
-    // println!("Opened file: {}", file_path);
-    // println!("Layer Attributes: {:#?}", layer_attributes);
-    // println!("Data Window: {:?}", data_window);
-
-    let pixel_count = image_width * image_height;
-    let default_pixel = 0.0;
-    let mut pixel_data: Vec<f64> = vec![default_pixel; pixel_count * 2];
-    let pixel_data_slice = unsafe {
-        std::mem::transmute::<&mut [f64], &mut [(f32, f32, f32, f32)]>(
-            pixel_data.as_mut_slice(),
+    *out_pixel_buffer = image.layer_data.channel_data.pixels.buffer;
+
+    let image_metadata =
+        ImageMetaData::with_attributes(&image.attributes, &layer_attributes);
+    Ok(image_metadata)
+}
+
+/// Read the RGBA channels of an EXR image from a file path, into an
+/// existing pixel buffer, keeping the data type of the file.
+///
+/// Half-float (16-bit) images are stored as 'BufferDataType::F16',
+/// using half the memory of a 32-bit float buffer. All other images
+/// are stored as 'BufferDataType::F32'. The buffer memory is
+/// re-used, and 'region' is used in the same way as
+/// 'image_read_pixels_exr_f32x4_into'.
+pub fn image_read_pixels_exr_rgba_into(
+    file_path: &str,
+    region: Option<&ImageRegionRectangle>,
+    out_pixel_buffer: &mut ImagePixelBuffer,
+) -> Result<ImageMetaData> {
+    let reuse_buffer = Cell::new(Some(std::mem::replace(
+        out_pixel_buffer,
+        ImagePixelBuffer::new(),
+    )));
+
+    let num_channels = 4;
+    let image = exr::image::read::read()
+        .no_deep_data()
+        .largest_resolution_level()
+        .rgba_channels(
+            |resolution, channels: &exr::image::RgbaChannels| {
+                let is_half =
+                    |channel: &exr::meta::attribute::ChannelDescription| {
+                        channel.sample_type
+                            == exr::meta::attribute::SampleType::F16
+                    };
+                let alpha_is_half = match &channels.3 {
+                    Some(channel) => is_half(channel),
+                    None => true,
+                };
+                let data_type = if is_half(&channels.0)
+                    && is_half(&channels.1)
+                    && is_half(&channels.2)
+                    && alpha_is_half
+                {
+                    BufferDataType::F16
+                } else {
+                    BufferDataType::F32
+                };
+                ExrReadTarget::new(
+                    &reuse_buffer,
+                    resolution,
+                    region,
+                    data_type,
+                    num_channels,
+                )
+            },
+            |target: &mut ExrReadTarget,
+             position,
+             (r, g, b, a): (Sample, Sample, Sample, Sample)| {
+                if let Some(index) = target.pixel_index(position) {
+                    if target.buffer.data_type() == BufferDataType::F16 {
+                        target.buffer.as_slice_f16x4_mut()[index] =
+                            (r.to_f16(), g.to_f16(), b.to_f16(), a.to_f16());
+                    } else {
+                        target.buffer.as_slice_f32x4_mut()[index] =
+                            (r.to_f32(), g.to_f32(), b.to_f32(), a.to_f32());
+                    }
+                }
+            },
         )
+        .first_valid_layer()
+        .all_attributes()
+        .from_file(file_path);
+
+    let image = match image {
+        Ok(value) => value,
+        Err(err) => {
+            if let Some(buffer) = reuse_buffer.take() {
+                *out_pixel_buffer = buffer;
+            }
+            bail!(err)
+        }
     };
 
-    for y in 0..image_height {
-        for x in 0..image_width {
-            let position = exr::math::Vec2(x, y);
-            let pixel = image.layer_data.channel_data.pixels[position.y()]
-                [position.x()];
-            let pixel_index = (image_width * y) + x;
-            pixel_data_slice[pixel_index] = pixel;
+    let layer_attributes = image.layer_data.attributes;
+    *out_pixel_buffer = image.layer_data.channel_data.pixels.buffer;
+
+    let image_metadata =
+        ImageMetaData::with_attributes(&image.attributes, &layer_attributes);
+    Ok(image_metadata)
+}
+
+/// Read a single named channel of an EXR image (for example "Z" or
+/// "R") from a file path, into an existing pixel buffer.
+///
+/// The pixel buffer will contain one f32 channel. The buffer memory
+/// is re-used, and 'region' is used in the same way as
+/// 'image_read_pixels_exr_f32x4_into'.
+pub fn image_read_pixels_exr_f32x1_into(
+    file_path: &str,
+    channel_name: &str,
+    region: Option<&ImageRegionRectangle>,
+    out_pixel_buffer: &mut ImagePixelBuffer,
+) -> Result<ImageMetaData> {
+    let reuse_buffer = Cell::new(Some(std::mem::replace(
+        out_pixel_buffer,
+        ImagePixelBuffer::new(),
+    )));
+
+    let num_channels = 1;
+    let image = exr::image::read::read()
+        .no_deep_data()
+        .largest_resolution_level()
+        .specific_channels()
+        .required(channel_name)
+        .collect_pixels(
+            |resolution,
+             _channels: &(exr::meta::attribute::ChannelDescription,)| {
+                ExrReadTarget::new(
+                    &reuse_buffer,
+                    resolution,
+                    region,
+                    BufferDataType::F32,
+                    num_channels,
+                )
+            },
+            |target: &mut ExrReadTarget, position, (value,): (f32,)| {
+                if let Some(index) = target.pixel_index(position) {
+                    target.buffer.as_slice_f32_mut()[index] = value;
+                }
+            },
+        )
+        .first_valid_layer()
+        .all_attributes()
+        .from_file(file_path);
+
+    let image = match image {
+        Ok(value) => value,
+        Err(err) => {
+            if let Some(buffer) = reuse_buffer.take() {
+                *out_pixel_buffer = buffer;
+            }
+            bail!(err)
         }
-    }
+    };
 
-    let num_channels = 4;
-    let image_data = ImagePixelBuffer::from_data(
-        BufferDataType::F32,
-        image_width,
-        image_height,
-        num_channels,
-        pixel_data,
-    );
+    let layer_attributes = image.layer_data.attributes;
+    *out_pixel_buffer = image.layer_data.channel_data.pixels.buffer;
 
     let image_metadata =
         ImageMetaData::with_attributes(&image.attributes, &layer_attributes);
+    Ok(image_metadata)
+}
 
-    Ok((image_metadata, image_data))
+/// Read an EXR image from a file path.
+pub fn image_read_pixels_exr_f32x4(
+    file_path: &str,
+) -> Result<(ImageMetaData, ImagePixelBuffer)> {
+    let mut pixel_buffer = ImagePixelBuffer::new();
+    let image_metadata =
+        image_read_pixels_exr_f32x4_into(file_path, None, &mut pixel_buffer)?;
+    Ok((image_metadata, pixel_buffer))
 }
 
 /// Write a 32-bit float image to an EXR file.
@@ -182,3 +426,205 @@ pub fn image_write_pixels_exr_f32x4(
         Err(err) => bail!(err),
     }
 }
+
+/// Write a 16-bit (half) float image to an EXR file.
+pub fn image_write_pixels_exr_f16x4(
+    file_path: &str,
+    encoder: ImageExrEncoder,
+    meta_data: &ImageMetaData,
+    pixel_buffer: &ImagePixelBuffer,
+) -> Result<()> {
+    let layer_attributes = meta_data.as_layer_attributes();
+
+    let pixel_data = ImagePixelDataF16x4::from_buffer(pixel_buffer);
+    let generate_pixels =
+        |position: exr::math::Vec2<usize>| (pixel_data.get_pixel(position));
+
+    let encoding = ImageExrEncoder::as_exr_encoding(encoder);
+    let layer = exr::image::Layer::new(
+        (pixel_buffer.image_width(), pixel_buffer.image_height()),
+        layer_attributes,
+        encoding,
+        exr::image::SpecificChannels::rgba(generate_pixels),
+    );
+
+    let mut image = exr::image::Image::from_layer(layer);
+    image.attributes = meta_data.as_image_attributes();
+
+    match image.write().to_file(file_path) {
+        Ok(..) => Ok(()),
+        Err(err) => bail!(err),
+    }
+}
+
+/// Write an RGBA image to an EXR file, keeping the data type of the
+/// pixel buffer.
+///
+/// 32-bit float buffers are written as 32-bit float, and 16-bit
+/// float buffers as 16-bit float. 8-bit buffers are converted to
+/// 16-bit float (which represents every 8-bit value exactly).
+pub fn image_write_pixels_exr_rgba(
+    file_path: &str,
+    encoder: ImageExrEncoder,
+    meta_data: &ImageMetaData,
+    pixel_buffer: &ImagePixelBuffer,
+) -> Result<()> {
+    if pixel_buffer.num_channels() != 4 {
+        bail!(
+            "Expected 4 channels, got {} channels.",
+            pixel_buffer.num_channels()
+        );
+    }
+    match pixel_buffer.data_type() {
+        BufferDataType::F32 => image_write_pixels_exr_f32x4(
+            file_path,
+            encoder,
+            meta_data,
+            pixel_buffer,
+        ),
+        BufferDataType::F16 => image_write_pixels_exr_f16x4(
+            file_path,
+            encoder,
+            meta_data,
+            pixel_buffer,
+        ),
+        BufferDataType::U8 | BufferDataType::F64 => {
+            let mut converted = ImagePixelBuffer::new();
+            convert_pixel_buffer_to_f16(pixel_buffer, &mut converted);
+            image_write_pixels_exr_f16x4(
+                file_path, encoder, meta_data, &converted,
+            )
+        }
+        BufferDataType::None => bail!("Pixel buffer has no data type."),
+    }
+}
+
+/// The file path of a proxy level of an image.
+///
+/// Proxy level N is stored next to the original file, in a
+/// directory named "proxyN", with the same file name. Level 0 is the
+/// original file path. Each level is half the width and height of
+/// the level before it.
+///
+/// For example level 2 of "/plates/shot.1001.exr" is
+/// "/plates/proxy2/shot.1001.exr".
+pub fn image_proxy_level_file_path(file_path: &str, level: u8) -> String {
+    if level == 0 {
+        return file_path.to_string();
+    }
+    let path = Path::new(file_path);
+    let file_name = match path.file_name() {
+        Some(value) => value,
+        None => return file_path.to_string(),
+    };
+    let mut proxy_path = match path.parent() {
+        Some(value) => value.to_path_buf(),
+        None => PathBuf::new(),
+    };
+    proxy_path.push(format!("proxy{}", level));
+    proxy_path.push(file_name);
+    proxy_path.to_string_lossy().into_owned()
+}
+
+/// Scale the windows of the metadata to match an image downsampled
+/// to 'level'.
+fn scale_metadata_to_proxy_level(
+    meta_data: &ImageMetaData,
+    level: u8,
+) -> ImageMetaData {
+    let factor = 1_i32 << std::cmp::min(level, 30);
+    let mut proxy_meta_data = meta_data.clone();
+
+    let display_window = &mut proxy_meta_data.display_window;
+    display_window.position_x = display_window.position_x.div_euclid(factor);
+    display_window.position_y = display_window.position_y.div_euclid(factor);
+    display_window.size_x =
+        image_proxy_level_size(display_window.size_x, level);
+    display_window.size_y =
+        image_proxy_level_size(display_window.size_y, level);
+
+    let layer_position = &mut proxy_meta_data.layer_position;
+    layer_position.x = layer_position.x.div_euclid(factor);
+    layer_position.y = layer_position.y.div_euclid(factor);
+
+    proxy_meta_data
+}
+
+/// Write proxy levels 1 to 'level_count' (inclusive) of an EXR image,
+/// using the file paths from 'image_proxy_level_file_path'. The
+/// directories are created when needed.
+///
+/// The full resolution image is read once, and each level is
+/// filtered from the level before it, keeping the data type of the
+/// file. Levels stop when the image is 1 pixel wide or high.
+///
+/// Returns the number of levels written.
+pub fn image_write_proxy_levels_exr(
+    file_path: &str,
+    encoder: ImageExrEncoder,
+    filter: ImageResizeFilter,
+    level_count: u8,
+) -> Result<u8> {
+    let mut pixel_buffer = ImagePixelBuffer::new();
+    let meta_data =
+        image_read_pixels_exr_rgba_into(file_path, None, &mut pixel_buffer)?;
+
+    let mut proxy_buffer = ImagePixelBuffer::new();
+    let mut levels_written = 0;
+    for level in 1..=level_count {
+        if pixel_buffer.image_width() <= 1 || pixel_buffer.image_height() <= 1 {
+            break;
+        }
+        if !image_downsample_pixel_buffer(
+            &pixel_buffer,
+            1,
+            filter,
+            &mut proxy_buffer,
+        ) {
+            bail!("Could not downsample image to proxy level {}.", level);
+        }
+        std::mem::swap(&mut pixel_buffer, &mut proxy_buffer);
+
+        let proxy_file_path = image_proxy_level_file_path(file_path, level);
+        if let Some(directory) = Path::new(&proxy_file_path).parent() {
+            std::fs::create_dir_all(directory)?;
+        }
+        let proxy_meta_data = scale_metadata_to_proxy_level(&meta_data, level);
+        image_write_pixels_exr_rgba(
+            &proxy_file_path,
+            encoder,
+            &proxy_meta_data,
+            &pixel_buffer,
+        )?;
+        levels_written = level;
+    }
+    Ok(levels_written)
+}
+
+/// Read the RGBA channels of proxy level 'level' of an EXR image,
+/// into an existing pixel buffer.
+///
+/// If the requested level does not exist on disk, the nearest lower
+/// level that exists is read instead, down to the original image at
+/// level 0. Returns the metadata and the level that was read.
+pub fn image_read_pixels_exr_rgba_level_into(
+    file_path: &str,
+    level: u8,
+    pixel_buffer: &mut ImagePixelBuffer,
+) -> Result<(ImageMetaData, u8)> {
+    for read_level in (1..=level).rev() {
+        let proxy_file_path =
+            image_proxy_level_file_path(file_path, read_level);
+        if Path::new(&proxy_file_path).is_file() {
+            let meta_data = image_read_pixels_exr_rgba_into(
+                &proxy_file_path,
+                None,
+                pixel_buffer,
+            )?;
+            return Ok((meta_data, read_level));
+        }
+    }
+    let meta_data =
+        image_read_pixels_exr_rgba_into(file_path, None, pixel_buffer)?;
+    Ok((meta_data, 0))
+}
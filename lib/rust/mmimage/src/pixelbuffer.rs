@@ -18,11 +18,29 @@
 // ====================================================================
 //
 
+use half::f16;
+use half::slice::HalfFloatSliceExt;
+
 #[derive(Copy, Clone, Debug, PartialEq, Eq)]
 pub enum BufferDataType {
     None = 0,
     F32 = 1,
     F64 = 2,
+    F16 = 3,
+    U8 = 4,
+}
+
+impl BufferDataType {
+    /// The number of bytes used for a single channel value.
+    pub fn byte_size(&self) -> usize {
+        match self {
+            BufferDataType::None => 0,
+            BufferDataType::F32 => std::mem::size_of::<f32>(),
+            BufferDataType::F64 => std::mem::size_of::<f64>(),
+            BufferDataType::F16 => std::mem::size_of::<f16>(),
+            BufferDataType::U8 => std::mem::size_of::<u8>(),
+        }
+    }
 }
 
 /// This is a general data structure for storing pixels in memory.
@@ -31,6 +49,11 @@ pub enum BufferDataType {
 ///
 /// The stored data is 64-bit aligned, to allow SSE and AVX
 /// instructions can be used by the compiler.
+///
+/// Pixels can be stored as 8-bit unsigned integers, 16-bit
+/// (half) floats, 32-bit floats or 64-bit floats, with any number of
+/// channels, so the source type of an image can be kept in memory
+/// without expanding every pixel to 32-bit float RGBA.
 #[derive(Clone, Debug)]
 pub struct ImagePixelBuffer {
     data_type: BufferDataType,
@@ -72,7 +95,7 @@ impl ImagePixelBuffer {
         }
     }
 
-    /// The type of data stored in the buffer; f32 or f64.
+    /// The type of data stored in the buffer; u8, f16, f32 or f64.
     pub fn data_type(&self) -> BufferDataType {
         self.data_type
     }
@@ -96,64 +119,122 @@ impl ImagePixelBuffer {
     ///
     /// For a single RGBA pixel, this would return 1.
     pub fn pixel_count(&self) -> usize {
-        let mut count = 0;
-        if self.data_type == BufferDataType::None {
+        if self.num_channels == 0 {
             // There is (conceptually) no count.
-            count = 0;
-        } else if self.data_type == BufferDataType::F32 {
-            count = self.data.len()
-                * (std::mem::size_of::<f64>() / std::mem::size_of::<f32>());
-            count /= self.num_channels;
-        } else if self.data_type == BufferDataType::F64 {
-            count = self.data.len() / self.num_channels;
+            return 0;
         }
-        count
+        self.element_count() / self.num_channels
     }
 
     /// The number of values that can be held in the buffer.
     ///
     /// For a single RGBA pixel, this would return 4.
     pub fn element_count(&self) -> usize {
-        let mut count = 0;
-        if self.data_type == BufferDataType::None {
+        let byte_size = self.data_type.byte_size();
+        if byte_size == 0 {
             // There is (conceptually) no count.
-            count = 0;
-        } else if self.data_type == BufferDataType::F32 {
-            count = self.data.len()
-                * (std::mem::size_of::<f64>() / std::mem::size_of::<f32>());
-        } else if self.data_type == BufferDataType::F64 {
-            count = self.data.len();
+            return 0;
+        }
+        (self.data.len() * std::mem::size_of::<f64>()) / byte_size
+    }
+
+    /// The number of bytes used by the pixels of the image.
+    pub fn byte_count(&self) -> usize {
+        self.data_type.byte_size()
+            * self.num_channels
+            * self.image_width
+            * self.image_height
+    }
+
+    /// Re-interpret the underlying memory as a slice of 'T'.
+    ///
+    /// 'T' must be a plain data type with an alignment no larger
+    /// than f64.
+    fn as_slice_of<T>(&self) -> &[T] {
+        debug_assert!(std::mem::align_of::<T>() <= std::mem::align_of::<f64>());
+        let len = (self.data.len() * std::mem::size_of::<f64>())
+            / std::mem::size_of::<T>();
+        // SAFETY: The f64 buffer is at least as aligned as 'T', and
+        // the length only covers the bytes owned by the buffer.
+        unsafe {
+            std::slice::from_raw_parts(self.data.as_ptr() as *const T, len)
+        }
+    }
+
+    fn as_slice_of_mut<T>(&mut self) -> &mut [T] {
+        debug_assert!(std::mem::align_of::<T>() <= std::mem::align_of::<f64>());
+        let len = (self.data.len() * std::mem::size_of::<f64>())
+            / std::mem::size_of::<T>();
+        unsafe {
+            std::slice::from_raw_parts_mut(
+                self.data.as_mut_ptr() as *mut T,
+                len,
+            )
         }
-        count
     }
 
     /// Get a slice of the underlying memory buffer, mutable or not.
+    ///
+    /// The slice type does not need to match the data type of the
+    /// buffer; the memory is re-interpreted. Use the 'convert_*'
+    /// functions to change the type of the stored values.
     pub fn as_slice_f64(&self) -> &[f64] {
         &self.data[..]
     }
+    pub fn as_slice_f32(&self) -> &[f32] {
+        self.as_slice_of::<f32>()
+    }
     pub fn as_slice_f32x2(&self) -> &[(f32, f32)] {
-        unsafe { std::mem::transmute::<&[f64], &[(f32, f32)]>(&self.data[..]) }
+        self.as_slice_of::<(f32, f32)>()
     }
     // fn as_slice_f64x2(&self) -> &[(f64, f64)] {}
     pub fn as_slice_f32x4(&self) -> &[(f32, f32, f32, f32)] {
-        unsafe {
-            std::mem::transmute::<&[f64], &[(f32, f32, f32, f32)]>(
-                &self.data[..],
-            )
-        }
+        self.as_slice_of::<(f32, f32, f32, f32)>()
     }
     // fn as_slice_f64x4(&self) -> &[(f64, f64, f64, f64)] {}
+    pub fn as_slice_f16(&self) -> &[f16] {
+        self.as_slice_of::<f16>()
+    }
+    pub fn as_slice_f16x2(&self) -> &[(f16, f16)] {
+        self.as_slice_of::<(f16, f16)>()
+    }
+    pub fn as_slice_f16x4(&self) -> &[(f16, f16, f16, f16)] {
+        self.as_slice_of::<(f16, f16, f16, f16)>()
+    }
+    pub fn as_slice_u8(&self) -> &[u8] {
+        self.as_slice_of::<u8>()
+    }
+    pub fn as_slice_u8x4(&self) -> &[(u8, u8, u8, u8)] {
+        self.as_slice_of::<(u8, u8, u8, u8)>()
+    }
+
     // fn as_slice_f64_mut(&mut self) -> &mut [f64] {}
     // fn as_slice_f64x2_mut(&mut self) -> &mut [(f64, f64)] {}
-    // fn as_slice_f32x2_mut(&mut self) -> &mut [(f32, f32)] {}
+    pub fn as_slice_f32_mut(&mut self) -> &mut [f32] {
+        self.as_slice_of_mut::<f32>()
+    }
+    pub fn as_slice_f32x2_mut(&mut self) -> &mut [(f32, f32)] {
+        self.as_slice_of_mut::<(f32, f32)>()
+    }
     pub fn as_slice_f32x4_mut(&mut self) -> &mut [(f32, f32, f32, f32)] {
-        unsafe {
-            std::mem::transmute::<&mut [f64], &mut [(f32, f32, f32, f32)]>(
-                &mut self.data[..],
-            )
-        }
+        self.as_slice_of_mut::<(f32, f32, f32, f32)>()
     }
     // fn as_slice_f64x4_mut(&mut self) -> &mut [(f64, f64, f64, f64)] {}
+    pub fn as_slice_f16_mut(&mut self) -> &mut [f16] {
+        self.as_slice_of_mut::<f16>()
+    }
+    pub fn as_slice_f16x2_mut(&mut self) -> &mut [(f16, f16)] {
+        self.as_slice_of_mut::<(f16, f16)>()
+    }
+    pub fn as_slice_f16x4_mut(&mut self) -> &mut [(f16, f16, f16, f16)] {
+        self.as_slice_of_mut::<(f16, f16, f16, f16)>()
+    }
+    pub fn as_slice_u8_mut(&mut self) -> &mut [u8] {
+        self.as_slice_of_mut::<u8>()
+    }
+    pub fn as_slice_u8x4_mut(&mut self) -> &mut [(u8, u8, u8, u8)] {
+        self.as_slice_of_mut::<(u8, u8, u8, u8)>()
+    }
 
     /// Keeps the current buffer's data and resizes the memory to hold
     /// more elements.
@@ -169,25 +250,149 @@ impl ImagePixelBuffer {
     ) {
         self.image_width = image_width;
         self.image_height = image_height;
-        let pixel_count = image_width * image_height;
         self.data_type = data_type;
         self.num_channels = num_channels;
-        match data_type {
-            BufferDataType::None => {
-                // No resizing is needed or possible.
+
+        let byte_count = self.byte_count();
+        let f64_size = std::mem::size_of::<f64>();
+        let new_size = (byte_count + f64_size - 1) / f64_size;
+        self.data.resize(new_size, 0.0);
+    }
+}
+
+/// Convert the values of 'src' to 32-bit floats, in 'out' (which is
+/// resized to the same image size and number of channels).
+///
+/// 8-bit values are mapped from 0-255 to 0.0-1.0, with no colour
+/// space conversion.
+pub fn convert_pixel_buffer_to_f32(
+    src: &ImagePixelBuffer,
+    out: &mut ImagePixelBuffer,
+) {
+    out.resize(
+        BufferDataType::F32,
+        src.image_width(),
+        src.image_height(),
+        src.num_channels(),
+    );
+    let count = src.image_width() * src.image_height() * src.num_channels();
+    let dst = &mut out.as_slice_f32_mut()[..count];
+    match src.data_type() {
+        BufferDataType::None => (),
+        BufferDataType::F32 => {
+            dst.copy_from_slice(&src.as_slice_f32()[..count])
+        }
+        BufferDataType::F64 => {
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_f64()[..count]) {
+                *d = *s as f32;
             }
-            BufferDataType::F32 => {
-                let byte_count = std::mem::size_of::<f32>()
-                    * self.num_channels
-                    * pixel_count;
-                let new_size =
-                    (byte_count as f64) / (std::mem::size_of::<f64>() as f64);
-                self.data.resize(new_size.ceil() as usize, 0.0);
+        }
+        BufferDataType::F16 => {
+            // Uses the F16C instructions when available.
+            src.as_slice_f16()[..count].convert_to_f32_slice(dst);
+        }
+        BufferDataType::U8 => {
+            let scale = 1.0 / (u8::MAX as f32);
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_u8()[..count]) {
+                *d = (*s as f32) * scale;
             }
-            BufferDataType::F64 => {
-                let new_size = self.num_channels * pixel_count;
-                self.data.resize(new_size, 0.0);
+        }
+    }
+}
+
+/// Convert the values of 'src' to 16-bit (half) floats, in 'out'.
+pub fn convert_pixel_buffer_to_f16(
+    src: &ImagePixelBuffer,
+    out: &mut ImagePixelBuffer,
+) {
+    out.resize(
+        BufferDataType::F16,
+        src.image_width(),
+        src.image_height(),
+        src.num_channels(),
+    );
+    let count = src.image_width() * src.image_height() * src.num_channels();
+    let dst = &mut out.as_slice_f16_mut()[..count];
+    match src.data_type() {
+        BufferDataType::None => (),
+        BufferDataType::F32 => {
+            dst.convert_from_f32_slice(&src.as_slice_f32()[..count]);
+        }
+        BufferDataType::F64 => {
+            dst.convert_from_f64_slice(&src.as_slice_f64()[..count]);
+        }
+        BufferDataType::F16 => {
+            dst.copy_from_slice(&src.as_slice_f16()[..count])
+        }
+        BufferDataType::U8 => {
+            // Every 8-bit value has an exact 16-bit float
+            // representation, so a lookup table is used.
+            let mut table = [f16::ZERO; 256];
+            for (i, value) in table.iter_mut().enumerate() {
+                *value = f16::from_f32((i as f32) / (u8::MAX as f32));
+            }
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_u8()[..count]) {
+                *d = table[*s as usize];
             }
         }
     }
 }
+
+/// Convert the values of 'src' to 8-bit unsigned integers, in 'out'.
+///
+/// Floating point values are clamped to 0.0-1.0 and rounded to the
+/// nearest integer, with no colour space conversion.
+pub fn convert_pixel_buffer_to_u8(
+    src: &ImagePixelBuffer,
+    out: &mut ImagePixelBuffer,
+) {
+    out.resize(
+        BufferDataType::U8,
+        src.image_width(),
+        src.image_height(),
+        src.num_channels(),
+    );
+    let count = src.image_width() * src.image_height() * src.num_channels();
+    let dst = &mut out.as_slice_u8_mut()[..count];
+    let quantize = |value: f32| -> u8 {
+        // 'NaN' values become zero.
+        let value = value.max(0.0).min(1.0);
+        ((value * (u8::MAX as f32)) + 0.5) as u8
+    };
+    match src.data_type() {
+        BufferDataType::None => (),
+        BufferDataType::F32 => {
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_f32()[..count]) {
+                *d = quantize(*s);
+            }
+        }
+        BufferDataType::F64 => {
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_f64()[..count]) {
+                *d = quantize(*s as f32);
+            }
+        }
+        BufferDataType::F16 => {
+            for (d, s) in dst.iter_mut().zip(&src.as_slice_f16()[..count]) {
+                *d = quantize(s.to_f32());
+            }
+        }
+        BufferDataType::U8 => dst.copy_from_slice(&src.as_slice_u8()[..count]),
+    }
+}
+
+/// Convert the values of 'src' to 'data_type', in 'out'.
+///
+/// Returns false if the conversion to 'data_type' is not supported.
+pub fn convert_pixel_buffer(
+    src: &ImagePixelBuffer,
+    data_type: BufferDataType,
+    out: &mut ImagePixelBuffer,
+) -> bool {
+    match data_type {
+        BufferDataType::F32 => convert_pixel_buffer_to_f32(src, out),
+        BufferDataType::F16 => convert_pixel_buffer_to_f16(src, out),
+        BufferDataType::U8 => convert_pixel_buffer_to_u8(src, out),
+        BufferDataType::None | BufferDataType::F64 => return false,
+    }
+    true
+}
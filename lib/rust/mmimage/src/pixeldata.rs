@@ -20,6 +20,7 @@
 
 use crate::pixelbuffer::ImagePixelBuffer;
 use exr::prelude::*;
+use half::f16;
 
 #[derive(Debug, Clone)]
 pub struct ImagePixelDataF32x4<'a> {
@@ -46,6 +47,30 @@ impl GetPixel for ImagePixelDataF32x4<'_> {
     }
 }
 
+#[derive(Debug, Clone)]
+pub struct ImagePixelDataF16x4<'a> {
+    buffer_ref: &'a ImagePixelBuffer,
+}
+
+impl ImagePixelDataF16x4<'_> {
+    pub fn from_buffer(buffer_ref: &ImagePixelBuffer) -> ImagePixelDataF16x4 {
+        ImagePixelDataF16x4 { buffer_ref }
+    }
+}
+
+impl GetPixel for ImagePixelDataF16x4<'_> {
+    type Pixel = (f16, f16, f16, f16);
+
+    fn get_pixel(&self, position: Vec2<usize>) -> Self::Pixel {
+        let column = position.x();
+        let row = position.y();
+
+        let index = (row * self.buffer_ref.image_width()) + column;
+        let slice = self.buffer_ref.as_slice_f16x4();
+        slice[index]
+    }
+}
+
 #[derive(Debug, Clone)]
 pub struct ImagePixelDataF64x2 {
     pub width: usize,
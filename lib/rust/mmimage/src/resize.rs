@@ -0,0 +1,427 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::pixelbuffer::convert_pixel_buffer;
+use crate::pixelbuffer::convert_pixel_buffer_to_f32;
+use crate::pixelbuffer::BufferDataType;
+use crate::pixelbuffer::ImagePixelBuffer;
+use rayon::prelude::*;
+
+/// The filter used to compute each pixel when an image is resized.
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub enum ImageResizeFilter {
+    /// The average of the source pixels covered by the output pixel.
+    Box,
+
+    /// A linear (tent) filter, 1 pixel wide.
+    Bilinear,
+
+    /// A windowed sinc filter, 3 lobes wide. Sharper than 'Box', but
+    /// may ring (overshoot) next to high contrast edges.
+    Lanczos3,
+}
+
+impl ImageResizeFilter {
+    /// The radius of the filter, in output pixels.
+    fn support(&self) -> f32 {
+        match self {
+            ImageResizeFilter::Box => 0.5,
+            ImageResizeFilter::Bilinear => 1.0,
+            ImageResizeFilter::Lanczos3 => 3.0,
+        }
+    }
+
+    fn evaluate(&self, x: f32) -> f32 {
+        match self {
+            ImageResizeFilter::Box => {
+                if x >= -0.5 && x < 0.5 {
+                    1.0
+                } else {
+                    0.0
+                }
+            }
+            ImageResizeFilter::Bilinear => {
+                let x = x.abs();
+                if x < 1.0 {
+                    1.0 - x
+                } else {
+                    0.0
+                }
+            }
+            ImageResizeFilter::Lanczos3 => {
+                let x = x.abs();
+                if x < 1.0e-6 {
+                    1.0
+                } else if x < 3.0 {
+                    let pi_x = std::f32::consts::PI * x;
+                    3.0 * pi_x.sin() * (pi_x / 3.0).sin() / (pi_x * pi_x)
+                } else {
+                    0.0
+                }
+            }
+        }
+    }
+}
+
+/// The source pixels (and their weights) used to compute one output
+/// pixel along one axis.
+struct FilterTaps {
+    start: usize,
+    weights: Vec<f32>,
+}
+
+/// Compute the filter taps for every output pixel, when resizing
+/// 'src_size' pixels to 'dst_size' pixels.
+fn compute_filter_taps(
+    src_size: usize,
+    dst_size: usize,
+    filter: ImageResizeFilter,
+) -> Vec<FilterTaps> {
+    let scale = src_size as f32 / dst_size as f32;
+
+    // When shrinking, the filter is widened to cover all the source
+    // pixels under the output pixel, to avoid aliasing.
+    let filter_scale = scale.max(1.0);
+    let support = filter.support() * filter_scale;
+
+    let mut all_taps = Vec::with_capacity(dst_size);
+    for dst_index in 0..dst_size {
+        let center = (dst_index as f32 + 0.5) * scale;
+        let start = (center - support).floor().max(0.0) as usize;
+        let end = std::cmp::min((center + support).ceil() as usize, src_size);
+
+        let mut weights = Vec::with_capacity(end - start);
+        let mut weight_sum = 0.0;
+        for src_index in start..end {
+            let x = (src_index as f32 + 0.5 - center) / filter_scale;
+            let weight = filter.evaluate(x);
+            weights.push(weight);
+            weight_sum += weight;
+        }
+
+        if weight_sum.abs() > 1.0e-6 {
+            for weight in weights.iter_mut() {
+                *weight /= weight_sum;
+            }
+            all_taps.push(FilterTaps { start, weights });
+        } else {
+            // No source pixels are under the filter; use the nearest
+            // pixel.
+            let nearest = std::cmp::min(center as usize, src_size - 1);
+            all_taps.push(FilterTaps {
+                start: nearest,
+                weights: vec![1.0],
+            });
+        }
+    }
+    all_taps
+}
+
+/// Resize 32-bit float pixels, with separable horizontal and
+/// vertical filter passes. Each pass computes rows of the output in
+/// parallel.
+fn resize_pixels_f32(
+    src: &[f32],
+    src_width: usize,
+    src_height: usize,
+    num_channels: usize,
+    dst: &mut [f32],
+    dst_width: usize,
+    dst_height: usize,
+    filter: ImageResizeFilter,
+) {
+    let taps_x = compute_filter_taps(src_width, dst_width, filter);
+    let taps_y = compute_filter_taps(src_height, dst_height, filter);
+
+    // Horizontal pass, from 'src' (src_width x src_height) to 'temp'
+    // (dst_width x src_height).
+    let src_row_stride = src_width * num_channels;
+    let dst_row_stride = dst_width * num_channels;
+    let mut temp = vec![0.0_f32; dst_row_stride * src_height];
+    temp.par_chunks_mut(dst_row_stride).enumerate().for_each(
+        |(y, temp_row)| {
+            let src_row = &src[(y * src_row_stride)..][..src_row_stride];
+            for (x, taps) in taps_x.iter().enumerate() {
+                let out_pixel =
+                    &mut temp_row[(x * num_channels)..][..num_channels];
+                for (i, weight) in taps.weights.iter().enumerate() {
+                    let src_pixel = &src_row
+                        [((taps.start + i) * num_channels)..][..num_channels];
+                    for c in 0..num_channels {
+                        out_pixel[c] += src_pixel[c] * weight;
+                    }
+                }
+            }
+        },
+    );
+
+    // Vertical pass, from 'temp' to 'dst' (dst_width x dst_height).
+    dst[..(dst_row_stride * dst_height)]
+        .par_chunks_mut(dst_row_stride)
+        .enumerate()
+        .for_each(|(y, dst_row)| {
+            for value in dst_row.iter_mut() {
+                *value = 0.0;
+            }
+            let taps = &taps_y[y];
+            for (i, weight) in taps.weights.iter().enumerate() {
+                let temp_row = &temp[((taps.start + i) * dst_row_stride)..]
+                    [..dst_row_stride];
+                for (d, t) in dst_row.iter_mut().zip(temp_row) {
+                    *d += t * weight;
+                }
+            }
+        });
+}
+
+/// Resize the image in 'src' to 'dst_width' x 'dst_height' pixels,
+/// into 'out'.
+///
+/// The pixels are filtered as 32-bit floats, and then converted back
+/// to the data type of 'src' (64-bit float images are returned as
+/// 32-bit float). Returns false if 'src' has no pixels or the output
+/// size is zero.
+pub fn image_resize_pixel_buffer(
+    src: &ImagePixelBuffer,
+    dst_width: usize,
+    dst_height: usize,
+    filter: ImageResizeFilter,
+    out: &mut ImagePixelBuffer,
+) -> bool {
+    let src_width = src.image_width();
+    let src_height = src.image_height();
+    let num_channels = src.num_channels();
+    if src_width == 0
+        || src_height == 0
+        || num_channels == 0
+        || dst_width == 0
+        || dst_height == 0
+        || src.data_type() == BufferDataType::None
+    {
+        return false;
+    }
+
+    let mut src_f32 = ImagePixelBuffer::new();
+    let src_f32 = if src.data_type() == BufferDataType::F32 {
+        src
+    } else {
+        convert_pixel_buffer_to_f32(src, &mut src_f32);
+        &src_f32
+    };
+
+    let out_data_type = match src.data_type() {
+        BufferDataType::F16 => BufferDataType::F16,
+        BufferDataType::U8 => BufferDataType::U8,
+        _ => BufferDataType::F32,
+    };
+
+    let src_count = src_width * src_height * num_channels;
+    if out_data_type == BufferDataType::F32 {
+        out.resize(BufferDataType::F32, dst_width, dst_height, num_channels);
+        resize_pixels_f32(
+            &src_f32.as_slice_f32()[..src_count],
+            src_width,
+            src_height,
+            num_channels,
+            out.as_slice_f32_mut(),
+            dst_width,
+            dst_height,
+            filter,
+        );
+        return true;
+    }
+
+    let mut resized = ImagePixelBuffer::new();
+    resized.resize(BufferDataType::F32, dst_width, dst_height, num_channels);
+    resize_pixels_f32(
+        &src_f32.as_slice_f32()[..src_count],
+        src_width,
+        src_height,
+        num_channels,
+        resized.as_slice_f32_mut(),
+        dst_width,
+        dst_height,
+        filter,
+    );
+    convert_pixel_buffer(&resized, out_data_type, out)
+}
+
+/// Resize the 32-bit float pixels in 'src' ('src_width' x
+/// 'src_height' pixels, with 'num_channels' interleaved channels) to
+/// 'dst_width' x 'dst_height' pixels, into 'dst'.
+///
+/// Returns false if any size is zero, or the slices are too small.
+pub fn image_resize_pixels_f32(
+    src: &[f32],
+    src_width: usize,
+    src_height: usize,
+    num_channels: usize,
+    filter: ImageResizeFilter,
+    dst_width: usize,
+    dst_height: usize,
+    dst: &mut [f32],
+) -> bool {
+    let src_count = src_width * src_height * num_channels;
+    let dst_count = dst_width * dst_height * num_channels;
+    if src_count == 0
+        || dst_count == 0
+        || src.len() < src_count
+        || dst.len() < dst_count
+    {
+        return false;
+    }
+
+    if src_width == dst_width && src_height == dst_height {
+        dst[..dst_count].copy_from_slice(&src[..src_count]);
+        return true;
+    }
+    resize_pixels_f32(
+        &src[..src_count],
+        src_width,
+        src_height,
+        num_channels,
+        dst,
+        dst_width,
+        dst_height,
+        filter,
+    );
+    true
+}
+
+/// The size of an image dimension at a proxy level; each level is
+/// half the size of the level before it, and never smaller than one
+/// pixel.
+pub fn image_proxy_level_size(size: usize, level: u8) -> usize {
+    std::cmp::max(size >> std::cmp::min(level as usize, 31), 1)
+}
+
+/// Downsample the image in 'src' by a factor of 2 to the power of
+/// 'level', into 'out'.
+pub fn image_downsample_pixel_buffer(
+    src: &ImagePixelBuffer,
+    level: u8,
+    filter: ImageResizeFilter,
+    out: &mut ImagePixelBuffer,
+) -> bool {
+    image_resize_pixel_buffer(
+        src,
+        image_proxy_level_size(src.image_width(), level),
+        image_proxy_level_size(src.image_height(), level),
+        filter,
+        out,
+    )
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_filter_taps_sum_to_one() {
+        for filter in [
+            ImageResizeFilter::Box,
+            ImageResizeFilter::Bilinear,
+            ImageResizeFilter::Lanczos3,
+        ]
+        .iter()
+        {
+            let all_taps = compute_filter_taps(1920, 480, *filter);
+            assert_eq!(all_taps.len(), 480);
+            for taps in all_taps.iter() {
+                let sum: f32 = taps.weights.iter().sum();
+                assert!((sum - 1.0).abs() < 1.0e-4);
+                assert!(taps.start + taps.weights.len() <= 1920);
+            }
+        }
+    }
+
+    #[test]
+    fn test_box_downsample_averages_pixels() {
+        let width = 4;
+        let height = 2;
+        let mut src = ImagePixelBuffer::new();
+        src.resize(BufferDataType::F32, width, height, 1);
+        src.as_slice_f32_mut()[..(width * height)]
+            .copy_from_slice(&[0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0]);
+
+        let mut out = ImagePixelBuffer::new();
+        assert!(image_downsample_pixel_buffer(
+            &src,
+            1,
+            ImageResizeFilter::Box,
+            &mut out
+        ));
+        assert_eq!(out.image_width(), 2);
+        assert_eq!(out.image_height(), 1);
+        let values = &out.as_slice_f32()[..2];
+        assert!((values[0] - 2.5).abs() < 1.0e-5);
+        assert!((values[1] - 4.5).abs() < 1.0e-5);
+    }
+
+    #[test]
+    fn test_resize_pixels_f32() {
+        // A constant image stays constant, with any filter.
+        let src = vec![0.5_f32; 7 * 5 * 4];
+        let mut dst = vec![0.0_f32; 3 * 2 * 4];
+        assert!(image_resize_pixels_f32(
+            &src,
+            7,
+            5,
+            4,
+            ImageResizeFilter::Bilinear,
+            3,
+            2,
+            &mut dst
+        ));
+        for value in dst.iter() {
+            assert!((value - 0.5).abs() < 1.0e-5);
+        }
+
+        // The output slice is too small.
+        let mut small = vec![0.0_f32; 4];
+        assert!(!image_resize_pixels_f32(
+            &src,
+            7,
+            5,
+            4,
+            ImageResizeFilter::Box,
+            3,
+            2,
+            &mut small
+        ));
+    }
+
+    #[test]
+    fn test_downsample_keeps_data_type() {
+        let mut src = ImagePixelBuffer::new();
+        src.resize(BufferDataType::F16, 64, 32, 4);
+        let mut out = ImagePixelBuffer::new();
+        assert!(image_downsample_pixel_buffer(
+            &src,
+            3,
+            ImageResizeFilter::Lanczos3,
+            &mut out
+        ));
+        assert_eq!(out.data_type(), BufferDataType::F16);
+        assert_eq!(out.image_width(), 8);
+        assert_eq!(out.image_height(), 4);
+        assert_eq!(out.num_channels(), 4);
+    }
+}
@@ -0,0 +1,381 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::datatype::ImageRegionRectangle;
+use anyhow::bail;
+use anyhow::Result;
+use rayon::prelude::*;
+
+/// The metadata of one frame of an image sequence, used to validate
+/// the sequence.
+#[derive(Debug, Clone)]
+pub struct ImageSequenceFrameMetaData {
+    pub frame: i32,
+
+    /// The file exists and the header could be read. When false, the
+    /// other values are zero.
+    pub exists: bool,
+
+    pub display_window: ImageRegionRectangle,
+    pub data_window: ImageRegionRectangle,
+    pub pixel_aspect: f32,
+    pub num_channels: usize,
+
+    /// The frame exists and matches the reference frame (see
+    /// 'summarize_image_sequence_metadata').
+    pub consistent: bool,
+}
+
+impl ImageSequenceFrameMetaData {
+    fn missing(frame: i32) -> ImageSequenceFrameMetaData {
+        ImageSequenceFrameMetaData {
+            frame,
+            exists: false,
+            display_window: ImageRegionRectangle::default(),
+            data_window: ImageRegionRectangle::default(),
+            pixel_aspect: 0.0,
+            num_channels: 0,
+            consistent: false,
+        }
+    }
+}
+
+/// The inconsistencies found in an image sequence.
+///
+/// Frames are compared with the first frame that exists (the
+/// "reference" frame).
+#[derive(Debug, Clone)]
+pub struct ImageSequenceMetaDataSummary {
+    pub frame_count: usize,
+    pub missing_frame_count: usize,
+
+    /// The first frame that does not exist, or zero if all frames
+    /// exist.
+    pub first_missing_frame: i32,
+
+    /// The first frame that exists, and its display window and pixel
+    /// aspect.
+    pub reference_frame: i32,
+    pub display_window: ImageRegionRectangle,
+    pub pixel_aspect: f32,
+
+    pub display_window_mismatch_count: usize,
+    pub data_window_mismatch_count: usize,
+    pub pixel_aspect_mismatch_count: usize,
+    pub num_channels_mismatch_count: usize,
+}
+
+impl ImageSequenceMetaDataSummary {
+    pub fn new() -> ImageSequenceMetaDataSummary {
+        ImageSequenceMetaDataSummary {
+            frame_count: 0,
+            missing_frame_count: 0,
+            first_missing_frame: 0,
+            reference_frame: 0,
+            display_window: ImageRegionRectangle::default(),
+            pixel_aspect: 0.0,
+            display_window_mismatch_count: 0,
+            data_window_mismatch_count: 0,
+            pixel_aspect_mismatch_count: 0,
+            num_channels_mismatch_count: 0,
+        }
+    }
+
+    /// Are all frames present, with the same metadata?
+    pub fn is_consistent(&self) -> bool {
+        self.missing_frame_count == 0
+            && self.display_window_mismatch_count == 0
+            && self.data_window_mismatch_count == 0
+            && self.pixel_aspect_mismatch_count == 0
+            && self.num_channels_mismatch_count == 0
+    }
+}
+
+fn same_region(a: &ImageRegionRectangle, b: &ImageRegionRectangle) -> bool {
+    a.position_x == b.position_x
+        && a.position_y == b.position_y
+        && a.size_x == b.size_x
+        && a.size_y == b.size_y
+}
+
+/// Does the file path end with the ".exr" file extension (in any
+/// case)?
+pub fn is_exr_file_path(file_path: &str) -> bool {
+    let extension = ".exr";
+    if file_path.len() < extension.len() {
+        return false;
+    }
+    let start = file_path.len() - extension.len();
+    match file_path.get(start..) {
+        Some(value) => value.eq_ignore_ascii_case(extension),
+        None => false,
+    }
+}
+
+/// Replace the last run of '#' characters in 'file_pattern' with the
+/// frame number, padded with zeros to the number of '#' characters.
+///
+/// For example "plate.####.exr" at frame 42 is "plate.0042.exr".
+/// As with printf-style "%04d" (used by the existing frame path
+/// code), the sign of a negative frame counts towards the padding, so
+/// frame -5 is "plate.-005.exr".
+pub fn image_sequence_frame_file_path(
+    file_pattern: &str,
+    frame: i32,
+) -> String {
+    let end = match file_pattern.rfind('#') {
+        Some(value) => value + 1,
+        None => return file_pattern.to_string(),
+    };
+    let start = file_pattern[..end].trim_end_matches('#').len();
+    let padding = end - start;
+
+    let number = format!("{:0width$}", frame, width = padding);
+
+    let mut file_path = String::with_capacity(file_pattern.len() + 8);
+    file_path.push_str(&file_pattern[..start]);
+    file_path.push_str(&number);
+    file_path.push_str(&file_pattern[end..]);
+    file_path
+}
+
+/// Read the header of a single EXR file. Only the header is read,
+/// not the pixels.
+fn read_frame_metadata_exr(
+    file_path: &str,
+    frame: i32,
+) -> ImageSequenceFrameMetaData {
+    // 'pedantic = false' means "do not throw an error for invalid or
+    // missing attributes", skipping them instead.
+    let pedantic = false;
+    let exr_meta_data =
+        match exr::meta::MetaData::read_from_file(file_path, pedantic) {
+            Ok(value) => value,
+            Err(_) => return ImageSequenceFrameMetaData::missing(frame),
+        };
+    if exr_meta_data.headers.len() == 0 {
+        return ImageSequenceFrameMetaData::missing(frame);
+    }
+
+    let exr_header = &exr_meta_data.headers[0];
+    let image_attributes = &exr_header.shared_attributes;
+    let layer_attributes = &exr_header.own_attributes;
+
+    let display_window = ImageRegionRectangle::new(
+        image_attributes.display_window.position.x(),
+        image_attributes.display_window.position.y(),
+        image_attributes.display_window.size.width(),
+        image_attributes.display_window.size.height(),
+    );
+    let data_window = ImageRegionRectangle::new(
+        layer_attributes.layer_position.x(),
+        layer_attributes.layer_position.y(),
+        exr_header.layer_size.width(),
+        exr_header.layer_size.height(),
+    );
+
+    ImageSequenceFrameMetaData {
+        frame,
+        exists: true,
+        display_window,
+        data_window,
+        pixel_aspect: image_attributes.pixel_aspect,
+        num_channels: exr_header.channels.list.len(),
+        consistent: false,
+    }
+}
+
+/// Compare each frame with the first frame that exists, and set the
+/// 'consistent' value of each frame.
+pub fn summarize_image_sequence_metadata(
+    frames: &mut [ImageSequenceFrameMetaData],
+) -> ImageSequenceMetaDataSummary {
+    let mut summary = ImageSequenceMetaDataSummary::new();
+    summary.frame_count = frames.len();
+
+    let reference = match frames.iter().find(|frame| frame.exists) {
+        Some(value) => value.clone(),
+        None => ImageSequenceFrameMetaData::missing(0),
+    };
+    summary.reference_frame = reference.frame;
+    summary.display_window = reference.display_window.clone();
+    summary.pixel_aspect = reference.pixel_aspect;
+
+    for frame in frames.iter_mut() {
+        frame.consistent = false;
+        if !frame.exists {
+            if summary.missing_frame_count == 0 {
+                summary.first_missing_frame = frame.frame;
+            }
+            summary.missing_frame_count += 1;
+            continue;
+        }
+
+        let same_display_window =
+            same_region(&frame.display_window, &reference.display_window);
+        let same_data_window =
+            same_region(&frame.data_window, &reference.data_window);
+        let same_pixel_aspect = frame.pixel_aspect == reference.pixel_aspect;
+        let same_num_channels = frame.num_channels == reference.num_channels;
+        if !same_display_window {
+            summary.display_window_mismatch_count += 1;
+        }
+        if !same_data_window {
+            summary.data_window_mismatch_count += 1;
+        }
+        if !same_pixel_aspect {
+            summary.pixel_aspect_mismatch_count += 1;
+        }
+        if !same_num_channels {
+            summary.num_channels_mismatch_count += 1;
+        }
+        frame.consistent = same_display_window
+            && same_data_window
+            && same_pixel_aspect
+            && same_num_channels;
+    }
+    summary
+}
+
+/// Read the headers of the EXR files 'start_frame' to 'end_frame'
+/// (inclusive) of an image sequence.
+///
+/// The files are read in parallel, because the time to read a header
+/// is mostly spent waiting for the file system (especially network
+/// storage), with 'thread_count' threads. When 'thread_count' is zero
+/// the default (global) thread pool is used.
+///
+/// The frames are returned in frame order. Frames that do not exist
+/// (or cannot be read) are not an error, and are counted in the
+/// summary.
+pub fn image_read_metadata_exr_sequence(
+    file_pattern: &str,
+    start_frame: i32,
+    end_frame: i32,
+    thread_count: usize,
+) -> Result<(
+    Vec<ImageSequenceFrameMetaData>,
+    ImageSequenceMetaDataSummary,
+)> {
+    if end_frame < start_frame {
+        bail!(
+            "End frame {} is before the start frame {}.",
+            end_frame,
+            start_frame
+        );
+    }
+
+    let read_frames = || -> Vec<ImageSequenceFrameMetaData> {
+        (start_frame..=end_frame)
+            .into_par_iter()
+            .map(|frame| {
+                let file_path =
+                    image_sequence_frame_file_path(file_pattern, frame);
+                read_frame_metadata_exr(&file_path, frame)
+            })
+            .collect()
+    };
+
+    let mut frames = if thread_count == 0 {
+        read_frames()
+    } else {
+        let thread_pool = rayon::ThreadPoolBuilder::new()
+            .num_threads(thread_count)
+            .build()?;
+        thread_pool.install(read_frames)
+    };
+
+    let summary = summarize_image_sequence_metadata(&mut frames);
+    Ok((frames, summary))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_frame_file_path() {
+        assert_eq!(
+            image_sequence_frame_file_path("plate.####.exr", 42),
+            "plate.0042.exr"
+        );
+        assert_eq!(
+            image_sequence_frame_file_path("plate.#.exr", 1001),
+            "plate.1001.exr"
+        );
+        assert_eq!(
+            image_sequence_frame_file_path("plate.####.exr", -5),
+            "plate.-005.exr"
+        );
+        assert_eq!(
+            image_sequence_frame_file_path("plate.#.exr", -5),
+            "plate.-5.exr"
+        );
+        assert_eq!(
+            image_sequence_frame_file_path("plate.##.exr", -1234),
+            "plate.-1234.exr"
+        );
+        assert_eq!(image_sequence_frame_file_path("plate.exr", 1), "plate.exr");
+    }
+
+    #[test]
+    fn test_is_exr_file_path() {
+        assert!(is_exr_file_path("plate.0042.exr"));
+        assert!(is_exr_file_path("PLATE.####.EXR"));
+        assert!(!is_exr_file_path("plate.0042.jpg"));
+        assert!(!is_exr_file_path("exr"));
+        assert!(!is_exr_file_path(""));
+    }
+
+    #[test]
+    fn test_summary_counts_inconsistencies() {
+        let mut frames = Vec::new();
+        for frame in 1..=4 {
+            let mut frame_meta_data =
+                ImageSequenceFrameMetaData::missing(frame);
+            frame_meta_data.exists = true;
+            frame_meta_data.display_window =
+                ImageRegionRectangle::new(0, 0, 1920, 1080);
+            frame_meta_data.data_window =
+                ImageRegionRectangle::new(0, 0, 1920, 1080);
+            frame_meta_data.pixel_aspect = 1.0;
+            frame_meta_data.num_channels = 4;
+            frames.push(frame_meta_data);
+        }
+        frames[1] = ImageSequenceFrameMetaData::missing(2);
+        frames[2].pixel_aspect = 2.0;
+        frames[3].data_window = ImageRegionRectangle::new(-8, -8, 1936, 1096);
+
+        let summary = summarize_image_sequence_metadata(&mut frames);
+        assert_eq!(summary.frame_count, 4);
+        assert_eq!(summary.missing_frame_count, 1);
+        assert_eq!(summary.first_missing_frame, 2);
+        assert_eq!(summary.reference_frame, 1);
+        assert_eq!(summary.display_window_mismatch_count, 0);
+        assert_eq!(summary.data_window_mismatch_count, 1);
+        assert_eq!(summary.pixel_aspect_mismatch_count, 1);
+        assert_eq!(summary.num_channels_mismatch_count, 0);
+        assert!(!summary.is_consistent());
+
+        let consistent: Vec<bool> =
+            frames.iter().map(|frame| frame.consistent).collect();
+        assert_eq!(consistent, vec![true, false, false, false]);
+    }
+}
@@ -0,0 +1,245 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::encoder::ImageExrEncoder;
+use crate::metadata::ImageMetaData;
+use anyhow::bail;
+use anyhow::Result;
+use std::sync::mpsc::sync_channel;
+use std::sync::mpsc::Receiver;
+use std::sync::mpsc::SyncSender;
+use std::sync::Mutex;
+use std::thread::JoinHandle;
+
+/// The number of row bands that may be waiting to be written, before
+/// 'write_rows_f32x4' blocks. This (and the band height chosen by
+/// the caller) bounds the memory used by the writer.
+const STREAM_QUEUE_BAND_COUNT: usize = 2;
+
+/// The rows of the image being written, received from the producer
+/// one band at a time.
+struct StreamRows {
+    receiver: Receiver<Vec<f32>>,
+    image_width: usize,
+    rows: Vec<f32>,
+    start_row: usize,
+    row_count: usize,
+}
+
+impl StreamRows {
+    fn get_pixel(&mut self, x: usize, y: usize) -> (f32, f32, f32, f32) {
+        while y >= (self.start_row + self.row_count) {
+            match self.receiver.recv() {
+                Ok(rows) => {
+                    self.start_row += self.row_count;
+                    self.row_count = rows.len() / (self.image_width * 4);
+                    self.rows = rows;
+                }
+                // The producer stopped before sending all rows; the
+                // remaining pixels are transparent black.
+                Err(_) => return (0.0, 0.0, 0.0, 0.0),
+            }
+        }
+        if y < self.start_row {
+            // Pixels are expected to be requested in increasing row
+            // order, so this should not happen.
+            return (0.0, 0.0, 0.0, 0.0);
+        }
+        let index = (((y - self.start_row) * self.image_width) + x) * 4;
+        (
+            self.rows[index],
+            self.rows[index + 1],
+            self.rows[index + 2],
+            self.rows[index + 3],
+        )
+    }
+}
+
+fn write_stream_exr_f32x4(
+    file_path: &str,
+    encoder: ImageExrEncoder,
+    meta_data: &ImageMetaData,
+    image_width: usize,
+    image_height: usize,
+    receiver: Receiver<Vec<f32>>,
+) -> Result<()> {
+    let stream_rows = Mutex::new(StreamRows {
+        receiver,
+        image_width,
+        rows: Vec::new(),
+        start_row: 0,
+        row_count: 0,
+    });
+
+    // The EXR writer asks for the pixels of each block in increasing
+    // row order (on one thread), and compresses the blocks in
+    // parallel, so only a few bands are ever held in memory.
+    let generate_pixels = |position: exr::math::Vec2<usize>| {
+        let mut stream_rows = stream_rows.lock().unwrap();
+        stream_rows.get_pixel(position.x(), position.y())
+    };
+
+    let mut encoding = ImageExrEncoder::as_exr_encoding(encoder);
+    encoding.blocks = exr::image::Blocks::ScanLines;
+    encoding.line_order = exr::meta::attribute::LineOrder::Increasing;
+
+    let layer = exr::image::Layer::new(
+        (image_width, image_height),
+        meta_data.as_layer_attributes(),
+        encoding,
+        exr::image::SpecificChannels::rgba(generate_pixels),
+    );
+    let mut image = exr::image::Image::from_layer(layer);
+    image.attributes = meta_data.as_image_attributes();
+
+    match image.write().to_file(file_path) {
+        Ok(..) => Ok(()),
+        Err(err) => bail!(err),
+    }
+}
+
+/// Write an RGBA 32-bit float EXR file a band of rows at a time, so
+/// the full image never needs to be held in memory.
+///
+/// The file is compressed and written on a background thread while
+/// the caller computes the next band of rows. Rows must be given
+/// top-to-bottom.
+pub struct ImageExrStreamWriter {
+    image_width: usize,
+    image_height: usize,
+    rows_written: usize,
+    sender: Option<SyncSender<Vec<f32>>>,
+    thread: Option<JoinHandle<Result<()>>>,
+}
+
+impl ImageExrStreamWriter {
+    pub fn new() -> ImageExrStreamWriter {
+        ImageExrStreamWriter {
+            image_width: 0,
+            image_height: 0,
+            rows_written: 0,
+            sender: None,
+            thread: None,
+        }
+    }
+
+    pub fn is_open(&self) -> bool {
+        self.thread.is_some()
+    }
+
+    pub fn rows_written(&self) -> usize {
+        self.rows_written
+    }
+
+    /// Start writing 'file_path'.
+    pub fn open(
+        &mut self,
+        file_path: &str,
+        encoder: ImageExrEncoder,
+        meta_data: &ImageMetaData,
+        image_width: usize,
+        image_height: usize,
+    ) -> Result<()> {
+        if self.is_open() {
+            bail!("Stream writer is already open.");
+        }
+        if image_width == 0 || image_height == 0 {
+            bail!("Image size must not be zero.");
+        }
+
+        let (sender, receiver) = sync_channel(STREAM_QUEUE_BAND_COUNT);
+        let file_path = file_path.to_string();
+        let meta_data = meta_data.clone();
+        let thread = std::thread::spawn(move || {
+            write_stream_exr_f32x4(
+                &file_path,
+                encoder,
+                &meta_data,
+                image_width,
+                image_height,
+                receiver,
+            )
+        });
+
+        self.image_width = image_width;
+        self.image_height = image_height;
+        self.rows_written = 0;
+        self.sender = Some(sender);
+        self.thread = Some(thread);
+        Ok(())
+    }
+
+    /// Write the next rows of RGBA pixels. 'pixels' must hold whole
+    /// rows. Blocks while the writer is busy with earlier rows.
+    pub fn write_rows_f32x4(&mut self, pixels: &[f32]) -> Result<()> {
+        let row_element_count = self.image_width * 4;
+        let sender = match &self.sender {
+            Some(value) => value,
+            None => bail!("Stream writer is not open."),
+        };
+        if pixels.len() % row_element_count != 0 {
+            bail!("Pixels must contain whole rows.");
+        }
+        let row_count = pixels.len() / row_element_count;
+        if self.rows_written + row_count > self.image_height {
+            bail!("Too many rows written to the image.");
+        }
+
+        if sender.send(pixels.to_vec()).is_err() {
+            // The writer thread has stopped, so the error will be
+            // returned by 'finish'.
+            bail!("Stream writer failed.");
+        }
+        self.rows_written += row_count;
+        Ok(())
+    }
+
+    /// Wait for the file to be written. Rows that were not given are
+    /// written as transparent black, and an error is returned.
+    pub fn finish(&mut self) -> Result<()> {
+        // Dropping the sender tells the writer thread no more rows
+        // will be sent.
+        self.sender = None;
+        let thread = match self.thread.take() {
+            Some(value) => value,
+            None => bail!("Stream writer is not open."),
+        };
+        match thread.join() {
+            Ok(result) => result?,
+            Err(_) => bail!("Stream writer thread panicked."),
+        };
+        if self.rows_written != self.image_height {
+            bail!(
+                "Only {} of {} rows were written.",
+                self.rows_written,
+                self.image_height
+            );
+        }
+        Ok(())
+    }
+}
+
+impl Drop for ImageExrStreamWriter {
+    fn drop(&mut self) {
+        if self.is_open() {
+            let _ = self.finish();
+        }
+    }
+}
@@ -0,0 +1,348 @@
+//
+// Copyright (C) 2024 David Cattermole.
+//
+// This file is part of mmSolver.
+//
+// mmSolver is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// mmSolver is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+// ====================================================================
+//
+
+use crate::pixelbuffer::BufferDataType;
+use crate::pixelbuffer::ImagePixelBuffer;
+use rayon::prelude::*;
+
+/// The filter used to sample the source image at a (fractional)
+/// pixel position.
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub enum ImageWarpFilter {
+    /// Linear interpolation of the nearest 2x2 pixels.
+    Bilinear,
+
+    /// Catmull-Rom interpolation of the nearest 4x4 pixels. Sharper
+    /// than 'Bilinear', but slower.
+    Bicubic,
+}
+
+/// Get a pixel of the RGBA image, or zero (transparent black) for
+/// pixels outside the image.
+#[inline]
+fn fetch_pixel(
+    pixels: &[f32],
+    image_width: usize,
+    image_height: usize,
+    x: i64,
+    y: i64,
+) -> [f32; 4] {
+    if x < 0 || y < 0 || x >= image_width as i64 || y >= image_height as i64 {
+        return [0.0; 4];
+    }
+    let index = ((y as usize * image_width) + x as usize) * 4;
+    [
+        pixels[index],
+        pixels[index + 1],
+        pixels[index + 2],
+        pixels[index + 3],
+    ]
+}
+
+fn sample_bilinear(
+    pixels: &[f32],
+    image_width: usize,
+    image_height: usize,
+    x: f32,
+    y: f32,
+) -> [f32; 4] {
+    let x0 = x.floor();
+    let y0 = y.floor();
+    let fx = x - x0;
+    let fy = y - y0;
+    let x0 = x0 as i64;
+    let y0 = y0 as i64;
+
+    let p00 = fetch_pixel(pixels, image_width, image_height, x0, y0);
+    let p10 = fetch_pixel(pixels, image_width, image_height, x0 + 1, y0);
+    let p01 = fetch_pixel(pixels, image_width, image_height, x0, y0 + 1);
+    let p11 = fetch_pixel(pixels, image_width, image_height, x0 + 1, y0 + 1);
+
+    let mut out = [0.0; 4];
+    for c in 0..4 {
+        let top = p00[c] + (p10[c] - p00[c]) * fx;
+        let bottom = p01[c] + (p11[c] - p01[c]) * fx;
+        out[c] = top + (bottom - top) * fy;
+    }
+    out
+}
+
+/// Catmull-Rom weights for the 4 pixels around a sample, with 't'
+/// being the fractional position between the 2nd and 3rd pixel.
+#[inline]
+fn catmull_rom_weights(t: f32) -> [f32; 4] {
+    let t2 = t * t;
+    let t3 = t2 * t;
+    [
+        0.5 * (-t3 + 2.0 * t2 - t),
+        0.5 * (3.0 * t3 - 5.0 * t2 + 2.0),
+        0.5 * (-3.0 * t3 + 4.0 * t2 + t),
+        0.5 * (t3 - t2),
+    ]
+}
+
+fn sample_bicubic(
+    pixels: &[f32],
+    image_width: usize,
+    image_height: usize,
+    x: f32,
+    y: f32,
+) -> [f32; 4] {
+    let x0 = x.floor();
+    let y0 = y.floor();
+    let weights_x = catmull_rom_weights(x - x0);
+    let weights_y = catmull_rom_weights(y - y0);
+    let x0 = x0 as i64;
+    let y0 = y0 as i64;
+
+    let mut out = [0.0; 4];
+    for (j, weight_y) in weights_y.iter().enumerate() {
+        let mut row = [0.0; 4];
+        for (i, weight_x) in weights_x.iter().enumerate() {
+            let pixel = fetch_pixel(
+                pixels,
+                image_width,
+                image_height,
+                x0 + i as i64 - 1,
+                y0 + j as i64 - 1,
+            );
+            for c in 0..4 {
+                row[c] += pixel[c] * weight_x;
+            }
+        }
+        for c in 0..4 {
+            out[c] += row[c] * weight_y;
+        }
+    }
+    out
+}
+
+/// Warp rows of an image, by sampling the source image at the
+/// ST-map coordinates of each output pixel.
+///
+/// 'st_coords' holds the coordinates of each output pixel,
+/// 'st_coords_stride' values per pixel (the first two values are
+/// used). Coordinates are normalized, with (0.0, 0.0) at the
+/// bottom-left pixel and (1.0, 1.0) at the top-right pixel of the
+/// source image, the same as the ST-maps written by the lens
+/// distortion tool. Samples outside the source image are
+/// transparent black.
+///
+/// 'out_pixels' is RGBA 32-bit float, with the same number of pixels
+/// as 'st_coords'. The rows are computed in parallel.
+///
+/// Returns false if the source image is not RGBA 32-bit float, or
+/// the buffer sizes do not match; 'out_pixels' must hold whole rows
+/// of 'out_image_width' pixels, and 'st_coords' must hold exactly
+/// 'st_coords_stride' values for each of those pixels.
+pub fn image_warp_rows_f32x4(
+    src: &ImagePixelBuffer,
+    st_coords: &[f32],
+    st_coords_stride: usize,
+    filter: ImageWarpFilter,
+    out_image_width: usize,
+    out_pixels: &mut [f32],
+) -> bool {
+    let image_width = src.image_width();
+    let image_height = src.image_height();
+    if src.data_type() != BufferDataType::F32
+        || src.num_channels() != 4
+        || image_width < 2
+        || image_height < 2
+        || st_coords_stride < 2
+        || out_image_width == 0
+    {
+        return false;
+    }
+    let src_pixels = src.as_slice_f32();
+    if src_pixels.len() < (image_width * image_height * 4) {
+        return false;
+    }
+
+    // Validate the buffer sizes up front, so a short buffer cannot
+    // cause an out-of-bounds access (or be silently ignored) inside
+    // the row loop.
+    let out_row_value_count = out_image_width * 4;
+    if out_pixels.len() % out_row_value_count != 0 {
+        return false;
+    }
+    let row_count = out_pixels.len() / out_row_value_count;
+    let coords_row_value_count = out_image_width * st_coords_stride;
+    if st_coords.len() % st_coords_stride != 0
+        || st_coords.len() != row_count * coords_row_value_count
+    {
+        return false;
+    }
+
+    let pixels = &src_pixels[..(image_width * image_height * 4)];
+    let scale_x = (image_width - 1) as f32;
+    let scale_y = (image_height - 1) as f32;
+
+    out_pixels
+        .par_chunks_mut(out_row_value_count)
+        .zip(st_coords.par_chunks(coords_row_value_count))
+        .for_each(|(out_row, coords_row)| {
+            for (out_pixel, coord) in out_row
+                .chunks_exact_mut(4)
+                .zip(coords_row.chunks_exact(st_coords_stride))
+            {
+                // Rows of the source image are stored top-to-bottom.
+                let x = coord[0] * scale_x;
+                let y = (1.0 - coord[1]) * scale_y;
+                let value = match filter {
+                    ImageWarpFilter::Bilinear => {
+                        sample_bilinear(pixels, image_width, image_height, x, y)
+                    }
+                    ImageWarpFilter::Bicubic => {
+                        sample_bicubic(pixels, image_width, image_height, x, y)
+                    }
+                };
+                out_pixel.copy_from_slice(&value);
+            }
+        });
+    true
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn create_ramp_image(
+        image_width: usize,
+        image_height: usize,
+    ) -> ImagePixelBuffer {
+        let mut src = ImagePixelBuffer::new();
+        src.resize(BufferDataType::F32, image_width, image_height, 4);
+        let pixels = src.as_slice_f32_mut();
+        for y in 0..image_height {
+            for x in 0..image_width {
+                let index = ((y * image_width) + x) * 4;
+                pixels[index] = x as f32;
+                pixels[index + 1] = y as f32;
+                pixels[index + 2] = 0.0;
+                pixels[index + 3] = 1.0;
+            }
+        }
+        src
+    }
+
+    #[test]
+    fn test_identity_warp_keeps_pixels() {
+        let image_width = 5;
+        let image_height = 4;
+        let src = create_ramp_image(image_width, image_height);
+
+        let mut st_coords = Vec::new();
+        for y in 0..image_height {
+            for x in 0..image_width {
+                st_coords.push(x as f32 / (image_width - 1) as f32);
+                st_coords.push(1.0 - (y as f32 / (image_height - 1) as f32));
+            }
+        }
+
+        for filter in
+            [ImageWarpFilter::Bilinear, ImageWarpFilter::Bicubic].iter()
+        {
+            let mut out = vec![0.0; image_width * image_height * 4];
+            assert!(image_warp_rows_f32x4(
+                &src,
+                &st_coords,
+                2,
+                *filter,
+                image_width,
+                &mut out
+            ));
+            let expected = &src.as_slice_f32()[..out.len()];
+            for (a, b) in out.iter().zip(expected) {
+                assert!((a - b).abs() < 1.0e-4);
+            }
+        }
+    }
+
+    #[test]
+    fn test_bilinear_interpolates_between_pixels() {
+        let src = create_ramp_image(5, 4);
+        // Half-way between pixel x=1 and x=2, on row y=1.
+        let st_coords = [1.5 / 4.0, 1.0 - (1.0 / 3.0)];
+        let mut out = [0.0; 4];
+        assert!(image_warp_rows_f32x4(
+            &src,
+            &st_coords,
+            2,
+            ImageWarpFilter::Bilinear,
+            1,
+            &mut out
+        ));
+        assert!((out[0] - 1.5).abs() < 1.0e-4);
+        assert!((out[1] - 1.0).abs() < 1.0e-4);
+    }
+
+    #[test]
+    fn test_mismatched_buffer_sizes_fail() {
+        let src = create_ramp_image(5, 4);
+        let image_width = 3;
+        let stride = 2;
+        let mut out = vec![0.0; image_width * 2 * 4];
+
+        // Two full rows of coordinates.
+        let st_coords = vec![0.5; image_width * 2 * stride];
+        assert!(image_warp_rows_f32x4(
+            &src,
+            &st_coords,
+            stride,
+            ImageWarpFilter::Bilinear,
+            image_width,
+            &mut out
+        ));
+
+        // Not a multiple of the stride.
+        let st_coords_partial = vec![0.5; (image_width * 2 * stride) - 1];
+        assert!(!image_warp_rows_f32x4(
+            &src,
+            &st_coords_partial,
+            stride,
+            ImageWarpFilter::Bilinear,
+            image_width,
+            &mut out
+        ));
+
+        // Only one row of coordinates for two output rows.
+        let st_coords_short = vec![0.5; image_width * stride];
+        assert!(!image_warp_rows_f32x4(
+            &src,
+            &st_coords_short,
+            stride,
+            ImageWarpFilter::Bilinear,
+            image_width,
+            &mut out
+        ));
+
+        // The output is not a whole number of rows.
+        let mut out_partial = vec![0.0; (image_width * 2 * 4) - 4];
+        assert!(!image_warp_rows_f32x4(
+            &src,
+            &st_coords,
+            stride,
+            ImageWarpFilter::Bilinear,
+            image_width,
+            &mut out_partial
+        ));
+    }
+}
@@ -19,22 +19,30 @@
 //
 
 use criterion::measurement::WallTime;
-use criterion::{black_box, criterion_group, criterion_main, Criterion};
+use criterion::{
+    black_box, criterion_group, criterion_main, BenchmarkGroup, BenchmarkId,
+    Criterion, Throughput,
+};
 
 use rand::distributions::Uniform;
 use rand::thread_rng;
 use rand::Rng;
 
 use mmscenegraph_rust::attr::datablock::AttrDataBlock;
+use mmscenegraph_rust::constant::FrameValue;
 use mmscenegraph_rust::constant::Matrix44;
 use mmscenegraph_rust::constant::Real;
 use mmscenegraph_rust::math::camera::get_projection_matrix;
 use mmscenegraph_rust::math::camera::FilmFit;
+use mmscenegraph_rust::math::dag::compute_world_matrices_with_attrs;
 use mmscenegraph_rust::math::reprojection::reproject_as_normalised_coord;
 use mmscenegraph_rust::math::rotate::euler::RotateOrder;
+use mmscenegraph_rust::math::transform::calculate_matrices_with_values;
 use mmscenegraph_rust::math::transform::calculate_matrix;
 use mmscenegraph_rust::math::transform::calculate_matrix_with_values;
 use mmscenegraph_rust::math::transform::Transform;
+use mmscenegraph_rust::math::transform::TransformScratch;
+use mmscenegraph_rust::math::transform::TransformValues;
 use mmscenegraph_rust::node::traits::NodeHasId;
 use mmscenegraph_rust::node::NodeId;
 use mmscenegraph_rust::scene::bake::bake_scene_graph;
@@ -104,6 +112,91 @@ fn bench_transform_calculate_matrix_with_values(c: &mut Criterion) {
     });
 }
 
+fn create_random_transform_values(count: usize) -> TransformValues {
+    const MAX_MIN_TRANSLATE_VALUE: Real = 10000.0;
+    const MAX_MIN_ROTATE_VALUE: Real = 180.0;
+    const MAX_MIN_SCALE_VALUE: Real = 10.0;
+
+    let mut rng = thread_rng();
+    let translate_side =
+        Uniform::new(-MAX_MIN_TRANSLATE_VALUE, MAX_MIN_TRANSLATE_VALUE);
+    let rotate_side = Uniform::new(-MAX_MIN_ROTATE_VALUE, MAX_MIN_ROTATE_VALUE);
+    let scale_side = Uniform::new(-MAX_MIN_SCALE_VALUE, MAX_MIN_SCALE_VALUE);
+
+    let mut values = TransformValues::with_capacity(count);
+    for _ in 0..count {
+        values.push(
+            rng.sample(translate_side),
+            rng.sample(translate_side),
+            rng.sample(translate_side),
+            rng.sample(rotate_side),
+            rng.sample(rotate_side),
+            rng.sample(rotate_side),
+            rng.sample(scale_side),
+            rng.sample(scale_side),
+            rng.sample(scale_side),
+        );
+    }
+    values
+}
+
+// Compare calculating a matrix per-frame with calculating all the
+// frames in a single batch.
+fn bench_transform_calculate_matrix_batched(c: &mut Criterion) {
+    let roo = RotateOrder::ZXY;
+
+    let mut group = c.benchmark_group("transform::calculate_matrix_batched");
+    for count in [1, 10, 100, 1000, 10000].iter() {
+        let count = *count;
+        let values = create_random_transform_values(count);
+        let mut scratch = TransformScratch::new();
+        let mut matrix_list: Vec<Matrix44> = Vec::with_capacity(count);
+
+        group.throughput(Throughput::Elements(count as u64));
+        group.bench_with_input(
+            BenchmarkId::new("calculate_matrix_with_values", count),
+            &values,
+            |b, values| {
+                b.iter(|| {
+                    matrix_list.clear();
+                    for i in 0..values.len() {
+                        matrix_list.push(calculate_matrix_with_values(
+                            values.tx[i],
+                            values.ty[i],
+                            values.tz[i],
+                            values.rx[i],
+                            values.ry[i],
+                            values.rz[i],
+                            values.sx[i],
+                            values.sy[i],
+                            values.sz[i],
+                            roo,
+                        ));
+                    }
+                    black_box(&matrix_list);
+                })
+            },
+        );
+        group.bench_with_input(
+            BenchmarkId::new("calculate_matrices_with_values", count),
+            &values,
+            |b, values| {
+                b.iter(|| {
+                    matrix_list.clear();
+                    calculate_matrices_with_values(
+                        black_box(values),
+                        roo,
+                        &mut scratch,
+                        &mut matrix_list,
+                    );
+                    black_box(&matrix_list);
+                })
+            },
+        );
+    }
+    group.finish();
+}
+
 fn bench_camera_get_projection_matrix(c: &mut Criterion) {
     let focal_length = 35.0;
     let film_back_width = 36.0 / 25.4;
@@ -703,138 +796,123 @@ fn bench_construct_and_evaluate_scene_graph(c: &mut Criterion) {
     });
 }
 
-// fn bench_compute_dag_matrices_deep(c: &mut Criterion) {
-//     let mut group = c.benchmark_group("dag::compute_matrices (deep graph)");
-//     for size in [1, 2, 10, 20, 100, 200, 1000, 2000].iter() {
-//         // Set up clone of data structures to be passed to function.
-//         let depth = 100;
-//         let scene = create_scene_depth(*size, depth);
-//         let expect_count = scene.transforms.len() + 1;
-//         let world_matrix_list = vec![Matrix44::identity(); expect_count];
-//         let local_matrix_list = vec![Matrix44::identity(); expect_count];
-//         let parent_world_matrix_list = vec![Matrix44::identity(); expect_count];
+/// Create a scene with `width` separate hierarchies, each hierarchy
+/// is a chain of `depth` transforms with a bundle at the bottom.
+fn create_scene_hierarchy(
+    width: usize,
+    depth: usize,
+) -> (SceneGraph, AttrDataBlock, EvaluationObjects) {
+    const MAX_MIN_TRANSLATE_VALUE: Real = 10000.0;
+    const MAX_MIN_ROTATE_VALUE: Real = 180.0;
+    const MAX_MIN_SCALE_VALUE: Real = 10.0;
 
-//         group.throughput(Throughput::Elements(expect_count as u64));
-//         group.bench_with_input(BenchmarkId::from_parameter(size), size, move |b, &_size| {
-//             b.iter_batched(
-//                 || {
-//                     let data = (
-//                         scene.transforms.clone(),
-//                         scene.out_transforms.clone(),
-//                         scene.transform_parents.clone(),
-//                         scene.params.values.clone(),
-//                         local_matrix_list.clone(),
-//                         world_matrix_list.clone(),
-//                         parent_world_matrix_list.clone(),
-//                     );
-//                     data
-//                 },
-//                 |mut data| {
-//                     mmsg::dag::compute_matrices(
-//                         black_box(data.0),
-//                         black_box(&mut data.1),
-//                         black_box(&mut data.2),
-//                         black_box(&mut data.3),
-//                         black_box(&mut data.4),
-//                         black_box(&mut data.5),
-//                         black_box(&mut data.6),
-//                     );
-//                 },
-//                 BatchSize::LargeInput,
-//             )
-//         });
-//     }
-//     group.finish();
-// }
+    let mut rng = thread_rng();
+    let translate_side =
+        Uniform::new(-MAX_MIN_TRANSLATE_VALUE, MAX_MIN_TRANSLATE_VALUE);
+    let rotate_side = Uniform::new(-MAX_MIN_ROTATE_VALUE, MAX_MIN_ROTATE_VALUE);
+    let scale_side = Uniform::new(-MAX_MIN_SCALE_VALUE, MAX_MIN_SCALE_VALUE);
 
-// fn create_scene_wide(size: usize, wide: usize) -> mmsg::scene::SceneGraph {
-//     let mut scene = mmsg::scene::SceneGraph::new();
-//     let tfm_root = mmsg::scene::ROOT_INDEX;
-
-//     const MAX_MIN_TRANSLATE_VALUE: Real = 10000.0;
-//     const MAX_MIN_ROTATE_VALUE: Real = 180.0;
-//     const MAX_MIN_SCALE_VALUE: Real = 10000.0;
-
-//     // Transform A (parented under to root)
-//     let mut rng = thread_rng();
-//     let translate_side = Uniform::new(-MAX_MIN_TRANSLATE_VALUE, MAX_MIN_TRANSLATE_VALUE);
-//     let rotate_side = Uniform::new(-MAX_MIN_ROTATE_VALUE, MAX_MIN_ROTATE_VALUE);
-//     let scale_side = Uniform::new(-MAX_MIN_SCALE_VALUE, MAX_MIN_SCALE_VALUE);
-//     for _ in 0..size {
-//         for _j in 0..wide {
-//             // Transform (unparented)
-//             let tx = rng.sample(translate_side);
-//             let ty = rng.sample(translate_side);
-//             let tz = rng.sample(translate_side);
-//             let rx = rng.sample(rotate_side);
-//             let ry = rng.sample(rotate_side);
-//             let rz = rng.sample(rotate_side);
-//             let sx = rng.sample(scale_side);
-//             let sy = rng.sample(scale_side);
-//             let sz = rng.sample(scale_side);
-//             let tfm = mmsg::scene::add_transform_to_scene(
-//                 tx,
-//                 ty,
-//                 tz,
-//                 rx,
-//                 ry,
-//                 rz,
-//                 sx,
-//                 sy,
-//                 sz,
-//                 RotateOrder::ZXY,
-//                 tfm_root,
-//                 &mut scene,
-//             );
-//         }
-//     }
+    let mut sg = SceneGraph::new();
+    let mut attrdb = AttrDataBlock::new();
+    let mut eval_objects = EvaluationObjects::new();
 
-//     scene
-// }
+    let rotate_order = RotateOrder::ZXY;
+    for _ in 0..width {
+        let mut parent_id = NodeId::Root;
+        for _ in 0..depth {
+            let tfm = create_static_transform(
+                &mut sg,
+                &mut attrdb,
+                (
+                    rng.sample(translate_side),
+                    rng.sample(translate_side),
+                    rng.sample(translate_side),
+                ),
+                (
+                    rng.sample(rotate_side),
+                    rng.sample(rotate_side),
+                    rng.sample(rotate_side),
+                ),
+                (
+                    rng.sample(scale_side),
+                    rng.sample(scale_side),
+                    rng.sample(scale_side),
+                ),
+                rotate_order,
+            );
+            sg.set_node_parent(tfm.get_id(), parent_id);
+            parent_id = tfm.get_id();
+        }
+
+        let bnd = create_static_bundle(
+            &mut sg,
+            &mut attrdb,
+            (
+                rng.sample(translate_side),
+                rng.sample(translate_side),
+                rng.sample(translate_side),
+            ),
+            (0.0, 0.0, 0.0),
+            (1.0, 1.0, 1.0),
+            rotate_order,
+        );
+        sg.set_node_parent(bnd.get_id(), parent_id);
+        eval_objects.add_bundle(bnd);
+    }
+
+    (sg, attrdb, eval_objects)
+}
 
-// fn bench_compute_dag_matrices_wide(c: &mut Criterion) {
-//     let mut group = c.benchmark_group("dag::compute_matrices (wide graph)");
-//     for size in [1, 2, 10, 20, 100, 200, 1000, 2000].iter() {
-//         // Set up clone of data structures to be passed to function.
-//         let wide = 100;
-//         let scene = create_scene_wide(*size, wide);
-//         let expect_count = scene.transforms.len() + 1;
-//         let world_matrix_list = vec![Matrix44::identity(); expect_count];
-//         let local_matrix_list = vec![Matrix44::identity(); expect_count];
-//         let parent_world_matrix_list = vec![Matrix44::identity(); expect_count];
+fn bench_compute_dag_matrices_hierarchy(
+    group: &mut BenchmarkGroup<WallTime>,
+    width: usize,
+    depth: usize,
+    parameter: usize,
+) {
+    let (sg, attrdb, eval_objects) = create_scene_hierarchy(width, depth);
+    let flat_scene = bake_scene_graph(&sg, &eval_objects);
+    let frame_list: Vec<FrameValue> = (1001..1121).collect();
+    let num_transforms = flat_scene.tfm_node_ids.len();
+    let mut out_matrix_list = Vec::new();
+
+    group.throughput(Throughput::Elements(
+        (num_transforms * frame_list.len()) as u64,
+    ));
+    group.bench_function(BenchmarkId::from_parameter(parameter), |b| {
+        b.iter(|| {
+            compute_world_matrices_with_attrs(
+                &attrdb,
+                &flat_scene.tfm_attr_list,
+                &flat_scene.rotate_order_list,
+                &flat_scene.tfm_node_parent_indices,
+                &flat_scene.tfm_level_schedule,
+                black_box(&frame_list),
+                &mut out_matrix_list,
+            );
+            black_box(&out_matrix_list);
+        })
+    });
+}
 
-//         group.throughput(Throughput::Elements(expect_count as u64));
-//         group.bench_with_input(BenchmarkId::from_parameter(size), size, move |b, &_size| {
-//             b.iter_batched(
-//                 || {
-//                     let data = (
-//                         scene.transforms.clone(),
-//                         scene.out_transforms.clone(),
-//                         scene.transform_parents.clone(),
-//                         scene.params.values.clone(),
-//                         local_matrix_list.clone(),
-//                         world_matrix_list.clone(),
-//                         parent_world_matrix_list.clone(),
-//                     );
-//                     data
-//                 },
-//                 |mut data| {
-//                     mmsg::dag::compute_matrices(
-//                         black_box(data.0),
-//                         black_box(&mut data.1),
-//                         black_box(&mut data.2),
-//                         black_box(&mut data.3),
-//                         black_box(&mut data.4),
-//                         black_box(&mut data.5),
-//                         black_box(&mut data.6),
-//                     );
-//                 },
-//                 BatchSize::LargeInput,
-//             )
-//         });
-//     }
-//     group.finish();
-// }
+// A few hierarchies with many levels, such as a character rig.
+fn bench_compute_dag_matrices_deep(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dag::compute_matrices (deep graph)");
+    let width = 10;
+    for depth in [10, 20, 50, 100].iter() {
+        bench_compute_dag_matrices_hierarchy(&mut group, width, *depth, *depth);
+    }
+    group.finish();
+}
+
+// Many hierarchies, each with a realistic number of levels.
+fn bench_compute_dag_matrices_wide(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dag::compute_matrices (wide graph)");
+    let depth = 10;
+    for width in [10, 100, 1000].iter() {
+        bench_compute_dag_matrices_hierarchy(&mut group, *width, depth, *width);
+    }
+    group.finish();
+}
 
 // // fn bench_topological_sort(c: &mut Criterion) {
 // //     let mut group = c.benchmark_group("dag::compute_matrices (wide graph)");
@@ -930,6 +1008,7 @@ criterion_group!(
     targets =
         bench_transform_calculate_matrix,
         bench_transform_calculate_matrix_with_values,
+        bench_transform_calculate_matrix_batched,
         bench_camera_get_projection_matrix,
         bench_reprojection_reproject_as_normalised_coord,
         bench_reprojection,
@@ -938,7 +1017,7 @@ criterion_group!(
         bench_construct_scene_graph_depth_transforms,
         bench_construct_and_evaluate_scene_graph,
         // bench_compute_dag_matrices,
-        // bench_compute_dag_matrices_deep,
-        // bench_compute_dag_matrices_wide
+        bench_compute_dag_matrices_deep,
+        bench_compute_dag_matrices_wide
 );
 criterion_main!(benches);
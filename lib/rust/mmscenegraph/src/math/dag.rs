@@ -28,7 +28,10 @@ use crate::constant::MM_TO_INCH;
 use crate::math::camera::get_projection_matrix;
 use crate::math::camera::FilmFit;
 use crate::math::rotate::euler::RotateOrder;
+use crate::math::transform::calculate_matrices_with_values;
 use crate::math::transform::calculate_matrix_with_values;
+use crate::math::transform::TransformScratch;
+use crate::math::transform::TransformValues;
 // use crate::math::transform::decompose_matrix;
 use crate::node::traits::NodeCanTransform3D;
 use crate::node::traits::NodeCanViewScene;
@@ -78,6 +81,75 @@ pub fn compute_matrix_with_attrs(
     )
 }
 
+/// Append the value of the attribute at each frame to `out_values`.
+#[inline]
+fn gather_attr_values(
+    attr_data_block: &AttrDataBlock,
+    attr_id: AttrId,
+    frame_list: &[FrameValue],
+    out_values: &mut Vec<Real>,
+) {
+    match attr_id {
+        AttrId::AnimDense(_) => out_values.extend(
+            frame_list
+                .iter()
+                .map(|frame| attr_data_block.get_attr_value(attr_id, *frame)),
+        ),
+        _ => {
+            // The value is the same for all frames.
+            let value = attr_data_block.get_attr_value(attr_id, 0);
+            out_values.resize(out_values.len() + frame_list.len(), value);
+        }
+    }
+}
+
+/// Append the transform attribute values at each frame to `values`.
+fn gather_transform_values(
+    attr_data_block: &AttrDataBlock,
+    tfm_attrs: &AttrTransformIds,
+    frame_list: &[FrameValue],
+    values: &mut TransformValues,
+) {
+    let mut attr_values = [
+        (tfm_attrs.tx, &mut values.tx),
+        (tfm_attrs.ty, &mut values.ty),
+        (tfm_attrs.tz, &mut values.tz),
+        (tfm_attrs.rx, &mut values.rx),
+        (tfm_attrs.ry, &mut values.ry),
+        (tfm_attrs.rz, &mut values.rz),
+        (tfm_attrs.sx, &mut values.sx),
+        (tfm_attrs.sy, &mut values.sy),
+        (tfm_attrs.sz, &mut values.sz),
+    ];
+    for (attr_id, out_values) in attr_values.iter_mut() {
+        gather_attr_values(attr_data_block, *attr_id, frame_list, out_values);
+    }
+}
+
+/// Compute the local matrix of a transform for each frame in
+/// `frame_list`, appending the matrices to `out_matrix_list`.
+///
+/// The attribute values for all frames are gathered into contiguous
+/// arrays first, then the matrices are calculated in bulk.
+pub fn compute_matrices_with_attrs(
+    attr_data_block: &AttrDataBlock,
+    tfm_attrs: &AttrTransformIds,
+    rotate_order: RotateOrder,
+    frame_list: &[FrameValue],
+    values: &mut TransformValues,
+    scratch: &mut TransformScratch,
+    out_matrix_list: &mut Vec<Matrix44>,
+) {
+    values.clear();
+    gather_transform_values(attr_data_block, tfm_attrs, frame_list, values);
+    calculate_matrices_with_values(
+        values,
+        rotate_order,
+        scratch,
+        out_matrix_list,
+    );
+}
+
 pub fn compute_matrix<T>(
     attr_data_block: &AttrDataBlock,
     transform: &Box<T>,
@@ -231,11 +303,122 @@ pub fn compute_matrices<'a>(
     }
 }
 
+/// A contiguous run of transforms (in `DagLevelSchedule::indices`)
+/// that share the same depth and rotate order, and can therefore be
+/// computed with a single call to `calculate_matrices_with_values`.
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub struct DagBatch {
+    pub start: usize,
+    pub end: usize,
+    pub rotate_order: RotateOrder,
+}
+
+/// The order to evaluate a transform hierarchy, with transforms
+/// grouped by their depth in the hierarchy (level-order).
+///
+/// Every transform in a level depends only on transforms in previous
+/// levels, so all transforms in a level can be computed together.
+#[derive(Debug, Clone, Default)]
+pub struct DagLevelSchedule {
+    /// Transform indices, sorted by depth and then rotate order.
+    pub indices: Vec<usize>,
+
+    /// The batches of `indices`, in evaluation order.
+    pub batches: Vec<DagBatch>,
+
+    /// The first batch of each level, with an extra value at the end
+    /// for the number of batches.
+    pub level_offsets: Vec<usize>,
+}
+
+impl DagLevelSchedule {
+    /// Create the schedule from the parent index of each
+    /// transform. Parents must appear before their children.
+    pub fn new(
+        transform_parents: &[Option<usize>],
+        rotate_order_list: &[RotateOrder],
+    ) -> Self {
+        let transform_num = transform_parents.len();
+        assert!(rotate_order_list.len() == transform_num);
+
+        let mut depth_list = Vec::with_capacity(transform_num);
+        for (i, parent) in transform_parents.iter().enumerate() {
+            let depth = match parent {
+                Some(parent_index) => {
+                    assert!(*parent_index < i);
+                    depth_list[*parent_index] + 1
+                }
+                None => 0,
+            };
+            depth_list.push(depth);
+        }
+
+        // Stable sort, so transforms keep their relative order within
+        // each batch.
+        let mut indices: Vec<usize> = (0..transform_num).collect();
+        indices.sort_by_key(|i| (depth_list[*i], rotate_order_list[*i]));
+
+        let mut batches = Vec::new();
+        let mut level_offsets = Vec::new();
+        let mut previous_depth = None;
+        for (k, i) in indices.iter().enumerate() {
+            let depth = depth_list[*i];
+            let rotate_order = rotate_order_list[*i];
+            if previous_depth != Some(depth) {
+                level_offsets.push(batches.len());
+                previous_depth = Some(depth);
+            } else {
+                let batch: &mut DagBatch = batches.last_mut().unwrap();
+                if batch.rotate_order == rotate_order {
+                    batch.end = k + 1;
+                    continue;
+                }
+            }
+            batches.push(DagBatch {
+                start: k,
+                end: k + 1,
+                rotate_order,
+            });
+        }
+        level_offsets.push(batches.len());
+
+        Self {
+            indices,
+            batches,
+            level_offsets,
+        }
+    }
+
+    pub fn num_levels(&self) -> usize {
+        self.level_offsets.len().saturating_sub(1)
+    }
+
+    /// The batches that make up the level.
+    pub fn level_batches(&self, level: usize) -> &[DagBatch] {
+        let start = self.level_offsets[level];
+        let end = self.level_offsets[level + 1];
+        &self.batches[start..end]
+    }
+
+    /// The transform indices in the batch.
+    pub fn batch_indices(&self, batch: &DagBatch) -> &[usize] {
+        &self.indices[batch.start..batch.end]
+    }
+}
+
+/// Compute the world matrix of each transform for each frame in
+/// `frame_list`.
+///
+/// `out_matrix_list` is indexed by `(transform_index * num_frames) +
+/// frame_index`. Transforms are evaluated level by level, using
+/// `schedule`, with the local matrices of each batch in a level
+/// computed together.
 pub fn compute_world_matrices_with_attrs(
     attr_data_block: &AttrDataBlock,
     tfm_attr_list: &Vec<AttrTransformIds>,
     rotate_order_list: &Vec<RotateOrder>,
     transform_parents: &Vec<Option<usize>>,
+    schedule: &DagLevelSchedule,
     frame_list: &[FrameValue],
     out_matrix_list: &mut Vec<Matrix44>,
 ) {
@@ -248,81 +431,64 @@ pub fn compute_world_matrices_with_attrs(
     // println!("tfm_attr_list.len(): {}", tfm_attr_list.len());
     assert!(tfm_attr_list.len() == transform_num);
     assert!(rotate_order_list.len() == transform_num);
+    assert!(schedule.indices.len() == transform_num);
 
     out_matrix_list.clear();
-    out_matrix_list.reserve(transform_num * num_frames);
-
-    for (i, (tfm_attrs, rotate_order)) in
-        (0..).zip(tfm_attr_list.iter().zip(rotate_order_list.iter()))
-    {
-        // println!("compute_world_matrices i: {}", i);
-        let rotate_order = *rotate_order;
-
-        let attr_tx = tfm_attrs.tx;
-        let attr_ty = tfm_attrs.ty;
-        let attr_tz = tfm_attrs.tz;
-
-        let attr_rx = tfm_attrs.rx;
-        let attr_ry = tfm_attrs.ry;
-        let attr_rz = tfm_attrs.rz;
-
-        let attr_sx = tfm_attrs.sx;
-        let attr_sy = tfm_attrs.sy;
-        let attr_sz = tfm_attrs.sz;
-
-        for (f, frame) in (0..).zip(frame_list) {
-            let frame = *frame;
-
-            let local_matrix = compute_matrix_with_attrs(
-                attr_data_block,
-                attr_tx,
-                attr_ty,
-                attr_tz,
-                attr_rx,
-                attr_ry,
-                attr_rz,
-                attr_sx,
-                attr_sy,
-                attr_sz,
-                rotate_order,
-                frame,
-            );
-            // println!("  local_matrix {} at {}: {}", i, f, local_matrix);
+    out_matrix_list.resize(transform_num * num_frames, Matrix44::identity());
+    if num_frames == 0 {
+        return;
+    }
 
-            let world_matrix = match transform_parents[i] {
-                Some(parent_index) => {
-                    assert!(parent_index < i);
-                    let parent_index_at_frame = (parent_index * num_frames) + f;
-                    let parent_world_matrix =
-                        out_matrix_list[parent_index_at_frame];
-                    // println!(
-                    //     "  parent_world_matrix {} at {}: {}",
-                    //     parent_index, f, parent_world_matrix
-                    // );
-
-                    // let proo = rotate_order;
-                    // let (ptx, pty, ptz, prx, pry, prz, psx, psy, psz) =
-                    //     decompose_matrix(parent_world_matrix, proo);
-                    // println!("  ptx: {} pty: {} ptz: {}", ptx, pty, ptz);
-                    // println!("  prx: {} pry: {} prz: {} proo: {:?}", prx, pry, prz, proo);
-                    // println!("  psx: {} psy: {} psz: {}", psx, psy, psz);
-
-                    parent_world_matrix * local_matrix
-                }
-                // node has no parent, so just use the local matrix.
-                None => local_matrix,
-            };
+    // Memory re-used for each batch.
+    let mut values = TransformValues::new();
+    let mut scratch = TransformScratch::new();
+    let mut local_matrix_list = Vec::new();
+
+    for level in 0..schedule.num_levels() {
+        for batch in schedule.level_batches(level) {
+            let batch_indices = schedule.batch_indices(batch);
+
+            values.clear();
+            for i in batch_indices {
+                gather_transform_values(
+                    attr_data_block,
+                    &tfm_attr_list[*i],
+                    frame_list,
+                    &mut values,
+                );
+            }
 
-            // let wroo = rotate_order;
-            // let (wtx, wty, wtz, wrx, wry, wrz, wsx, wsy, wsz) =
-            //     decompose_matrix(world_matrix, wroo);
-            // println!("  wtx: {} wty: {} wtz: {}", wtx, wty, wtz);
-            // println!("  wrx: {} wry: {} wrz: {} wroo: {:?}", wrx, wry, wrz, wroo);
-            // println!("  wsx: {} wsy: {} wsz: {}", wsx, wsy, wsz);
+            local_matrix_list.clear();
+            calculate_matrices_with_values(
+                &values,
+                batch.rotate_order,
+                &mut scratch,
+                &mut local_matrix_list,
+            );
 
-            out_matrix_list.push(world_matrix);
+            // Parents are in previous levels, so their world matrices
+            // are already computed.
+            let local_chunks = local_matrix_list.chunks_exact(num_frames);
+            for (i, local_matrices) in batch_indices.iter().zip(local_chunks) {
+                let start = i * num_frames;
+                match transform_parents[*i] {
+                    Some(parent_index) => {
+                        let parent_start = parent_index * num_frames;
+                        for (f, local_matrix) in
+                            local_matrices.iter().enumerate()
+                        {
+                            let parent_world_matrix =
+                                out_matrix_list[parent_start + f];
+                            out_matrix_list[start + f] =
+                                parent_world_matrix * local_matrix;
+                        }
+                    }
+                    // node has no parent, so just use the local matrix.
+                    None => out_matrix_list[start..start + num_frames]
+                        .copy_from_slice(local_matrices),
+                }
+            }
         }
-        // println!("------------------------------------------------");
     }
 }
 
@@ -377,3 +543,166 @@ pub fn compute_world_matrices(
         // println!("------------------------------------------------");
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::node::traits::NodeCanRotate3D;
+    use crate::node::traits::NodeCanScale3D;
+    use crate::node::traits::NodeCanTranslate3D;
+    use crate::node::transform::TransformNode;
+
+    #[test]
+    fn test_dag_level_schedule() {
+        //   0      3
+        //   |      |
+        //   1      4 (XYZ)
+        //  / \
+        // 2   5
+        let parents = vec![None, Some(0), Some(1), None, Some(3), Some(1)];
+        let mut rotate_orders = vec![RotateOrder::ZXY; parents.len()];
+        rotate_orders[4] = RotateOrder::XYZ;
+        let schedule = DagLevelSchedule::new(&parents, &rotate_orders);
+
+        assert_eq!(schedule.num_levels(), 3);
+        assert_eq!(schedule.indices, vec![0, 3, 4, 1, 2, 5]);
+
+        let level0 = schedule.level_batches(0);
+        assert_eq!(level0.len(), 1);
+        assert_eq!(schedule.batch_indices(&level0[0]), &[0, 3]);
+
+        let level1 = schedule.level_batches(1);
+        assert_eq!(level1.len(), 2);
+        assert_eq!(level1[0].rotate_order, RotateOrder::XYZ);
+        assert_eq!(schedule.batch_indices(&level1[0]), &[4]);
+        assert_eq!(schedule.batch_indices(&level1[1]), &[1]);
+
+        let level2 = schedule.level_batches(2);
+        assert_eq!(level2.len(), 1);
+        assert_eq!(schedule.batch_indices(&level2[0]), &[2, 5]);
+    }
+
+    // A transform with all attributes animated over 'frame_count'
+    // frames, starting at 'frame_start'.
+    fn create_anim_transform(
+        attrdb: &mut AttrDataBlock,
+        seed: Real,
+        frame_start: FrameValue,
+        frame_count: usize,
+        rotate_order: RotateOrder,
+    ) -> TransformNode {
+        let mut anim_attr = |offset: Real, scale: Real| {
+            let values = (0..frame_count)
+                .map(|f| offset + (scale * (seed + f as Real)).sin())
+                .collect();
+            attrdb.create_attr_anim_dense(values, frame_start)
+        };
+
+        let mut node = TransformNode::default();
+        node.set_attr_tx(anim_attr(0.0, 1.1));
+        node.set_attr_ty(anim_attr(0.5, 0.7));
+        node.set_attr_tz(anim_attr(-0.5, 0.3));
+        node.set_attr_rx(anim_attr(10.0, 1.3));
+        node.set_attr_ry(anim_attr(-20.0, 0.9));
+        node.set_attr_rz(anim_attr(30.0, 0.5));
+        node.set_attr_sx(anim_attr(1.5, 0.2));
+        node.set_attr_sy(anim_attr(1.75, 0.4));
+        node.set_attr_sz(anim_attr(2.0, 0.6));
+        node.set_rotate_order(rotate_order);
+        node
+    }
+
+    #[test]
+    fn test_world_matrices_level_order_match_per_frame() {
+        //   0         4
+        //   |        / \
+        //   1 (XYZ) 5   6 (YZX)
+        //  / \      |
+        // 2   3     7
+        //     |
+        //     8 (XYZ)
+        let parents = vec![
+            None,
+            Some(0),
+            Some(1),
+            Some(1),
+            None,
+            Some(4),
+            Some(4),
+            Some(5),
+            Some(3),
+        ];
+        let mut rotate_orders = vec![RotateOrder::ZXY; parents.len()];
+        rotate_orders[1] = RotateOrder::XYZ;
+        rotate_orders[6] = RotateOrder::YZX;
+        rotate_orders[8] = RotateOrder::XYZ;
+
+        let frame_start = 1001;
+        let frame_count = 5;
+        let frame_list: Vec<FrameValue> =
+            (frame_start..(frame_start + frame_count as FrameValue)).collect();
+
+        let mut attrdb = AttrDataBlock::new();
+        let mut transforms: Vec<Box<dyn NodeCanTransform3D>> = Vec::new();
+        let mut tfm_attr_list = Vec::new();
+        for (i, rotate_order) in rotate_orders.iter().enumerate() {
+            let node = create_anim_transform(
+                &mut attrdb,
+                i as Real,
+                frame_start,
+                frame_count,
+                *rotate_order,
+            );
+            tfm_attr_list.push(AttrTransformIds {
+                tx: node.get_attr_tx(),
+                ty: node.get_attr_ty(),
+                tz: node.get_attr_tz(),
+                rx: node.get_attr_rx(),
+                ry: node.get_attr_ry(),
+                rz: node.get_attr_rz(),
+                sx: node.get_attr_sx(),
+                sy: node.get_attr_sy(),
+                sz: node.get_attr_sz(),
+            });
+            transforms.push(Box::new(node));
+        }
+
+        let schedule = DagLevelSchedule::new(&parents, &rotate_orders);
+        assert_eq!(schedule.num_levels(), 4);
+
+        let mut level_matrix_list = Vec::new();
+        compute_world_matrices_with_attrs(
+            &attrdb,
+            &tfm_attr_list,
+            &rotate_orders,
+            &parents,
+            &schedule,
+            &frame_list,
+            &mut level_matrix_list,
+        );
+        assert_eq!(level_matrix_list.len(), parents.len() * frame_count);
+
+        let mut frame_matrix_list = Vec::new();
+        for (f, frame) in frame_list.iter().enumerate() {
+            compute_world_matrices(
+                &attrdb,
+                &transforms,
+                &parents,
+                *frame,
+                &mut frame_matrix_list,
+            );
+            for (i, frame_matrix) in frame_matrix_list.iter().enumerate() {
+                let level_matrix = level_matrix_list[(i * frame_count) + f];
+                let difference = (level_matrix - frame_matrix).amax();
+                assert!(
+                    difference < 1e-9,
+                    "transform {} frame {}: {} != {}",
+                    i,
+                    frame,
+                    level_matrix,
+                    frame_matrix
+                );
+            }
+        }
+    }
+}
@@ -633,6 +633,252 @@ pub fn calculate_matrix(transform: &Transform) -> Matrix44 {
     t * r * s
 }
 
+/// Transform attribute values for many frames, stored as a
+/// structure-of-arrays.
+///
+/// Each attribute is stored in its own contiguous array, with one
+/// value per frame, so that the values can be processed in bulk by
+/// `calculate_matrices_with_values`.
+#[derive(Debug, Clone, Default)]
+pub struct TransformValues {
+    pub tx: Vec<Real>,
+    pub ty: Vec<Real>,
+    pub tz: Vec<Real>,
+    pub rx: Vec<Real>,
+    pub ry: Vec<Real>,
+    pub rz: Vec<Real>,
+    pub sx: Vec<Real>,
+    pub sy: Vec<Real>,
+    pub sz: Vec<Real>,
+}
+
+impl TransformValues {
+    pub fn new() -> TransformValues {
+        TransformValues::default()
+    }
+
+    pub fn with_capacity(capacity: usize) -> TransformValues {
+        TransformValues {
+            tx: Vec::with_capacity(capacity),
+            ty: Vec::with_capacity(capacity),
+            tz: Vec::with_capacity(capacity),
+            rx: Vec::with_capacity(capacity),
+            ry: Vec::with_capacity(capacity),
+            rz: Vec::with_capacity(capacity),
+            sx: Vec::with_capacity(capacity),
+            sy: Vec::with_capacity(capacity),
+            sz: Vec::with_capacity(capacity),
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.tx.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.tx.is_empty()
+    }
+
+    pub fn clear(&mut self) {
+        self.tx.clear();
+        self.ty.clear();
+        self.tz.clear();
+        self.rx.clear();
+        self.ry.clear();
+        self.rz.clear();
+        self.sx.clear();
+        self.sy.clear();
+        self.sz.clear();
+    }
+
+    pub fn push(
+        &mut self,
+        tx: Real,
+        ty: Real,
+        tz: Real,
+        rx: Real,
+        ry: Real,
+        rz: Real,
+        sx: Real,
+        sy: Real,
+        sz: Real,
+    ) {
+        self.tx.push(tx);
+        self.ty.push(ty);
+        self.tz.push(tz);
+        self.rx.push(rx);
+        self.ry.push(ry);
+        self.rz.push(rz);
+        self.sx.push(sx);
+        self.sy.push(sy);
+        self.sz.push(sz);
+    }
+}
+
+/// Scratch memory used by `calculate_matrices_with_values`.
+///
+/// Re-use the same scratch memory between calls to avoid
+/// allocations.
+#[derive(Debug, Clone, Default)]
+pub struct TransformScratch {
+    sin_rx: Vec<Real>,
+    cos_rx: Vec<Real>,
+    sin_ry: Vec<Real>,
+    cos_ry: Vec<Real>,
+    sin_rz: Vec<Real>,
+    cos_rz: Vec<Real>,
+}
+
+impl TransformScratch {
+    pub fn new() -> TransformScratch {
+        TransformScratch::default()
+    }
+}
+
+type Rotate33 = [[Real; 3]; 3];
+
+#[inline(always)]
+fn multiply_rotate33(a: &Rotate33, b: &Rotate33) -> Rotate33 {
+    let mut out = [[0.0; 3]; 3];
+    for row in 0..3 {
+        for col in 0..3 {
+            out[row][col] = (a[row][0] * b[0][col])
+                + (a[row][1] * b[1][col])
+                + (a[row][2] * b[2][col]);
+        }
+    }
+    out
+}
+
+#[inline(always)]
+fn rotate33_with_sin_cos(
+    sin_rx: Real,
+    cos_rx: Real,
+    sin_ry: Real,
+    cos_ry: Real,
+    sin_rz: Real,
+    cos_rz: Real,
+    rotate_order: RotateOrder,
+) -> Rotate33 {
+    let rotx = [
+        [1.0, 0.0, 0.0], //
+        [0.0, cos_rx, -sin_rx],
+        [0.0, sin_rx, cos_rx],
+    ];
+    let roty = [
+        [cos_ry, 0.0, sin_ry], //
+        [0.0, 1.0, 0.0],
+        [-sin_ry, 0.0, cos_ry],
+    ];
+    let rotz = [
+        [cos_rz, -sin_rz, 0.0], //
+        [sin_rz, cos_rz, 0.0],
+        [0.0, 0.0, 1.0],
+    ];
+
+    // Matches the multiplication order used by
+    // 'calculate_matrix_with_values'.
+    match rotate_order {
+        RotateOrder::XYZ => {
+            multiply_rotate33(&multiply_rotate33(&rotz, &roty), &rotx)
+        }
+        RotateOrder::YZX => {
+            multiply_rotate33(&multiply_rotate33(&rotx, &rotz), &roty)
+        }
+        RotateOrder::ZXY => {
+            multiply_rotate33(&multiply_rotate33(&roty, &rotx), &rotz)
+        }
+        RotateOrder::XZY => {
+            multiply_rotate33(&multiply_rotate33(&roty, &rotz), &rotx)
+        }
+        RotateOrder::YXZ => {
+            multiply_rotate33(&multiply_rotate33(&rotz, &rotx), &roty)
+        }
+        RotateOrder::ZYX => {
+            multiply_rotate33(&multiply_rotate33(&rotx, &roty), &rotz)
+        }
+    }
+}
+
+#[inline]
+fn sin_cos_in_bulk(
+    degrees: &[Real],
+    out_sin: &mut Vec<Real>,
+    out_cos: &mut Vec<Real>,
+) {
+    out_sin.clear();
+    out_cos.clear();
+    out_sin.extend(degrees.iter().map(|x| (x * DEGREES_TO_RADIANS).sin()));
+    out_cos.extend(degrees.iter().map(|x| (x * DEGREES_TO_RADIANS).cos()));
+}
+
+/// Calculate a matrix for each frame of transform values, using the
+/// same rotate order for all frames.
+///
+/// This produces the same matrices as calling
+/// `calculate_matrix_with_values` for each frame, but the sine and
+/// cosine of all rotations are computed in bulk first, and the
+/// translate, rotate and scale are combined directly, without any
+/// 4x4 matrix multiplications.
+///
+/// The matrices are appended to `out_matrix_list`.
+pub fn calculate_matrices_with_values(
+    values: &TransformValues,
+    rotate_order: RotateOrder,
+    scratch: &mut TransformScratch,
+    out_matrix_list: &mut Vec<Matrix44>,
+) {
+    let count = values.len();
+    assert!(values.ty.len() == count);
+    assert!(values.tz.len() == count);
+    assert!(values.rx.len() == count);
+    assert!(values.ry.len() == count);
+    assert!(values.rz.len() == count);
+    assert!(values.sx.len() == count);
+    assert!(values.sy.len() == count);
+    assert!(values.sz.len() == count);
+
+    sin_cos_in_bulk(&values.rx, &mut scratch.sin_rx, &mut scratch.cos_rx);
+    sin_cos_in_bulk(&values.ry, &mut scratch.sin_ry, &mut scratch.cos_ry);
+    sin_cos_in_bulk(&values.rz, &mut scratch.sin_rz, &mut scratch.cos_rz);
+
+    out_matrix_list.reserve(count);
+    for i in 0..count {
+        let r = rotate33_with_sin_cos(
+            scratch.sin_rx[i],
+            scratch.cos_rx[i],
+            scratch.sin_ry[i],
+            scratch.cos_ry[i],
+            scratch.sin_rz[i],
+            scratch.cos_rz[i],
+            rotate_order,
+        );
+        let sx = values.sx[i];
+        let sy = values.sy[i];
+        let sz = values.sz[i];
+
+        // Equivalent to 't * r * s'.
+        out_matrix_list.push(Matrix44::new(
+            r[0][0] * sx,
+            r[0][1] * sy,
+            r[0][2] * sz,
+            values.tx[i], //
+            r[1][0] * sx,
+            r[1][1] * sy,
+            r[1][2] * sz,
+            values.ty[i], //
+            r[2][0] * sx,
+            r[2][1] * sy,
+            r[2][2] * sz,
+            values.tz[i], //
+            0.0,
+            0.0,
+            0.0,
+            1.0, //
+        ));
+    }
+}
+
 pub fn multiply(tfm_a: &Transform, tfm_b: &Transform) -> Matrix44 {
     println!("Multiply!");
     let mat_a = calculate_matrix(tfm_a);
@@ -736,6 +982,57 @@ mod tests {
     //     debug_assert!(false);
     // }
 
+    #[test]
+    fn test_calculate_matrices_with_values() {
+        let count = 10;
+        let mut values = TransformValues::with_capacity(count);
+        for i in 0..count {
+            let f = i as Real;
+            values.push(
+                -2.0 + f,
+                2.0 * f,
+                5.0 - f,
+                10.0 * f,
+                -10.0 + (f * 7.0),
+                -10.0 - (f * 13.0),
+                1.0 + (f * 0.1),
+                2.0,
+                0.5 + (f * 0.2),
+            );
+        }
+
+        // Test all the rotation orders.
+        let mut scratch = TransformScratch::new();
+        for roo_index in 0..6 {
+            let roo = RotateOrder::from(roo_index);
+            let mut matrix_list = Vec::new();
+            calculate_matrices_with_values(
+                &values,
+                roo,
+                &mut scratch,
+                &mut matrix_list,
+            );
+            assert_eq!(matrix_list.len(), count);
+
+            for i in 0..count {
+                let matrix = calculate_matrix_with_values(
+                    values.tx[i],
+                    values.ty[i],
+                    values.tz[i],
+                    values.rx[i],
+                    values.ry[i],
+                    values.rz[i],
+                    values.sx[i],
+                    values.sy[i],
+                    values.sz[i],
+                    roo,
+                );
+                let eq = matrix.relative_eq(&matrix_list[i], EPSILON, EPSILON);
+                assert_eq!(eq, true);
+            }
+        }
+    }
+
     #[test]
     fn test_decompose_matrix() {
         // Test all the rotation orders.
@@ -28,6 +28,7 @@ use std::collections::hash_set::HashSet;
 use crate::attr::AttrCameraIds;
 use crate::attr::AttrMarkerIds;
 use crate::attr::AttrTransformIds;
+use crate::math::dag::DagLevelSchedule;
 use crate::node::traits::NodeCanTranslate2D;
 use crate::node::traits::NodeCanViewScene;
 use crate::node::traits::NodeHasId;
@@ -230,6 +231,11 @@ pub fn bake_scene_graph(
         rotate_order_list.push(rotate_order);
     }
 
+    // The order to evaluate the transforms, computed once here so it
+    // can be re-used for every evaluation.
+    let tfm_level_schedule =
+        DagLevelSchedule::new(&tfm_node_parent_indices, &rotate_order_list);
+
     // Camera attributes.
     let mut cam_attr_list = Vec::new();
     let mut cam_film_fit_list = Vec::new();
@@ -331,6 +337,7 @@ pub fn bake_scene_graph(
         tfm_node_ids,
         tfm_node_indices,
         tfm_node_parent_indices,
+        tfm_level_schedule,
     )
 }
 
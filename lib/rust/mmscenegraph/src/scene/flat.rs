@@ -30,6 +30,7 @@ use crate::constant::Real;
 use crate::math::camera::FilmFit;
 use crate::math::dag::compute_projection_matrix_with_attrs;
 use crate::math::dag::compute_world_matrices_with_attrs;
+use crate::math::dag::DagLevelSchedule;
 use crate::math::reprojection::reproject_as_normalised_coord;
 use crate::math::rotate::euler::RotateOrder;
 use crate::node::NodeId;
@@ -61,6 +62,7 @@ pub struct FlatScene {
     pub tfm_node_ids: Vec<NodeId>,
     pub tfm_node_indices: Vec<PGNodeIndex>,
     pub tfm_node_parent_indices: Vec<Option<usize>>,
+    pub tfm_level_schedule: DagLevelSchedule,
 
     // The computed data is stored here for access by the user.
     out_tfm_world_matrix_list: Vec<Matrix44>,
@@ -115,6 +117,7 @@ impl FlatScene {
         tfm_node_ids: Vec<NodeId>,
         tfm_node_indices: Vec<PGNodeIndex>,
         tfm_node_parent_indices: Vec<Option<usize>>,
+        tfm_level_schedule: DagLevelSchedule,
     ) -> Self {
         Self {
             bnd_ids,
@@ -134,6 +137,7 @@ impl FlatScene {
             tfm_node_ids,
             tfm_node_indices,
             tfm_node_parent_indices,
+            tfm_level_schedule,
 
             out_tfm_world_matrix_list: Vec::new(),
             out_bnd_world_matrix_list: Vec::new(),
@@ -206,6 +210,7 @@ impl FlatScene {
             &self.tfm_attr_list,
             &self.rotate_order_list,
             &self.tfm_node_parent_indices,
+            &self.tfm_level_schedule,
             frame_list,
             &mut self.out_tfm_world_matrix_list,
         );
@@ -344,6 +344,10 @@ COLLECTION_RESULTS_STORE_ATTR_NAMES = [
     'ticks_jacobian',
     'ticks_parameter',
     'ticks_error',
+    'timer_scene_graph',
+    'ticks_scene_graph',
+    'scene_graph_cache_hits',
+    'scene_graph_cache_misses',
 ]
 
 # Default plate fallback values.
@@ -174,6 +174,10 @@ def _string_get_timer_stats(input_data):
         ('jacobian_ticks', 'ticks_jacobian', int),
         ('parameter_ticks', 'ticks_parameter', int),
         ('error_ticks', 'ticks_error', int),
+        ('scene_graph_seconds', 'timer_scene_graph', float),
+        ('scene_graph_ticks', 'ticks_scene_graph', int),
+        ('scene_graph_cache_hits', 'scene_graph_cache_hits', int),
+        ('scene_graph_cache_misses', 'scene_graph_cache_misses', int),
     ]
     index = 0
     timer_stats = {}
@@ -316,6 +320,18 @@ def _node_get_timer_stats(node, existing_attrs):
         'jacobian_ticks': _get_maya_attr(node, 'ticks_jacobian', int, existing_attrs),
         'parameter_ticks': _get_maya_attr(node, 'ticks_parameter', int, existing_attrs),
         'error_ticks': _get_maya_attr(node, 'ticks_error', int, existing_attrs),
+        'scene_graph_seconds': _get_maya_attr(
+            node, 'timer_scene_graph', float, existing_attrs
+        ),
+        'scene_graph_ticks': _get_maya_attr(
+            node, 'ticks_scene_graph', int, existing_attrs
+        ),
+        'scene_graph_cache_hits': _get_maya_attr(
+            node, 'scene_graph_cache_hits', int, existing_attrs
+        ),
+        'scene_graph_cache_misses': _get_maya_attr(
+            node, 'scene_graph_cache_misses', int, existing_attrs
+        ),
     }
     return data
 
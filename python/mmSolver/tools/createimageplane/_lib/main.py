@@ -88,6 +88,9 @@ def create_image_plane_on_camera(cam, name=None):
     lib_utils.force_connect_attr(shp_node_attr, file_node_attr)
     maya.cmds.setAttr(file_node_attr, lock=True)
 
+    # The frame number used by the image cache.
+    lib_utils.force_connect_attr(shp_node_attr, mm_ip_shp + '.imageFrame')
+
     maya.cmds.setAttr(shader_network.file_node + '.useFrameExtension', is_seq)
 
     # Image sequence.
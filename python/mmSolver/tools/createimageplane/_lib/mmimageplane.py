@@ -473,6 +473,13 @@ def set_image_sequence(shp, image_sequence_path, attr_name):
 
     maya.cmds.setAttr(shp + '.' + attr_name, file_pattern, type='string')
 
+    # The image cache replaces '#' characters with the frame number.
+    hash_file_pattern = imageseq_utils.expand_image_sequence_path(
+        image_sequence_path, const_utils.IMAGE_SEQ_FORMAT_STYLE_HASH_PADDED
+    )[0]
+    hash_file_pattern = hash_file_pattern.replace('\\', '/')
+    maya.cmds.setAttr(shp + '.imageFilePath', hash_file_pattern, type='string')
+
     if not node_utils.node_is_referenced(shp):
         maya.cmds.setAttr(shp + '.imageSequenceStartFrame', lock=False)
         maya.cmds.setAttr(shp + '.imageSequenceEndFrame', lock=False)
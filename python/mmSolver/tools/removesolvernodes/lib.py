@@ -71,7 +71,11 @@ def _collect_lines(node_categories):
 
 def _collect_lenses(node_categories):
     nodes_to_delete = set(node_categories.get(mmapi.OBJECT_TYPE_LENS, set()))
-    node_types_to_delete = ['mmLensDeformer', 'mmLensEvaluate']
+    node_types_to_delete = [
+        'mmLensDeformer',
+        'mmLensEvaluate',
+        'mmLensEvaluateArray',
+    ]
     other_nodes = node_categories.get('other', [])
     for node in other_nodes:
         if cmds.nodeType(node) in node_types_to_delete:
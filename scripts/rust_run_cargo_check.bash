@@ -0,0 +1,41 @@
+#!/bin/bash
+#
+# Copyright (C) 2024 David Cattermole.
+#
+# This file is part of mmSolver.
+#
+# mmSolver is free software: you can redistribute it and/or modify it
+# under the terms of the GNU Lesser General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# mmSolver is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+# ---------------------------------------------------------------------
+#
+# Runs 'cargo check' on the Rust crates and the C++ binding crates.
+#
+# The binding crates are built by CMake when building mmSolver, so
+# checking them here catches a change to a Rust crate that breaks the
+# bindings, without needing Maya installed.
+
+# Any subsequent commands which fail will cause the shell script to
+# exit immediately.
+set -e
+
+PROJECT_ROOT=`pwd`
+
+cd ${PROJECT_ROOT}/lib/rust
+cargo check --all-targets
+
+for crate_name in mmcore mmimage mmlens mmscenegraph; do
+    cd ${PROJECT_ROOT}/lib/cppbind/${crate_name}
+    cargo check
+done
+
+cd ${PROJECT_ROOT}
@@ -67,6 +67,7 @@
 #include "mmSolver/mayahelper/maya_lens_model_utils.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_scene_graph.h"
+#include "mmSolver/mayahelper/maya_scene_graph_cache.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/string_utils.h"
 #include "mmscenegraph/mmscenegraph.h"
@@ -469,6 +470,13 @@ void printSolveDetails(const SolverResult &solverResult, SolverData &userData,
         timer.paramBenchTicks.print(stream, "Param Ticks", total_num);
         timer.errorBenchTicks.print(stream, "Error Ticks", total_num);
         timer.funcBenchTicks.print(stream, "Func Ticks", total_num);
+
+        timer.sceneGraphBenchTimer.print(stream, "Scene Graph Time", 1);
+        timer.sceneGraphBenchTicks.print(stream, "Scene Graph Ticks", 1);
+        MMSOLVER_MAYA_INFO(
+            "Scene Graph Cache: hits=" << timer.sceneGraphCacheHits
+                                       << " misses="
+                                       << timer.sceneGraphCacheMisses);
     }
 }
 
@@ -710,6 +718,39 @@ bool addFrameListToStringStream(const MTimeArray &frameList,
     return frameCount > 0;
 }
 
+// Gives the scene graph used by a solve back to the scene graph
+// cache, on every return path of the solve.
+struct SceneGraphCacheReleaseGuard {
+    SceneGraphCacheEntry *entry;
+    SolverData &userData;
+
+    SceneGraphCacheReleaseGuard(SceneGraphCacheEntry *entry,
+                                SolverData &userData)
+        : entry(entry), userData(userData) {}
+
+    SceneGraphCacheReleaseGuard(const SceneGraphCacheReleaseGuard &) = delete;
+    SceneGraphCacheReleaseGuard &operator=(
+        const SceneGraphCacheReleaseGuard &) = delete;
+
+    ~SceneGraphCacheReleaseGuard() {
+        if (entry == nullptr) {
+            return;
+        }
+        entry->sceneGraph = std::move(userData.mmsgSceneGraph);
+        entry->attrDataBlock = std::move(userData.mmsgAttrDataBlock);
+        entry->flatScene = std::move(userData.mmsgFlatScene);
+        entry->cameraNodes = std::move(userData.mmsgCameraNodes);
+        entry->bundleNodes = std::move(userData.mmsgBundleNodes);
+        entry->markerNodes = std::move(userData.mmsgMarkerNodes);
+        entry->attrIdList = std::move(userData.mmsgAttrIdList);
+
+        // The solver has changed the values of the solved
+        // attributes, so they must be re-sampled from Maya before
+        // the scene graph is used again.
+        scene_graph_cache_release(entry, entry->attrIdList);
+    }
+};
+
 MStatus solveFrames(
     CameraPtrList &cameraList, BundlePtrList &bundleList,
     const MTimeArray &frameList, MarkerPtrList &usedMarkerList,
@@ -959,12 +1000,37 @@ MStatus solveFrames(
     auto mmsgBundleNodes = std::vector<mmsg::BundleNode>();
     auto mmsgMarkerNodes = std::vector<mmsg::MarkerNode>();
     auto mmsgAttrIdList = std::vector<mmsg::AttrId>();
+    SceneGraphCacheEntry *sceneGraphCacheEntry = nullptr;
     if (solverOptions.sceneGraphMode == SceneGraphMode::kMMSceneGraph) {
-        status = construct_scene_graph(
+        // Scene graphs are cached between solves, so solving the same
+        // objects again only needs to re-sample the attributes that
+        // have changed.
+        bool sceneGraphCacheHit = false;
+        timer.sceneGraphBenchTimer.start();
+        timer.sceneGraphBenchTicks.start();
+        status = scene_graph_cache_acquire(
             cameraList, usedMarkerList, bundleList, usedAttrList, frameList,
-            solverOptions.timeEvalMode, mmsgSceneGraph, mmsgAttrDataBlock,
-            mmsgFlatScene, mmsgFrameList, mmsgCameraNodes, mmsgBundleNodes,
-            mmsgMarkerNodes, mmsgAttrIdList);
+            solverOptions.timeEvalMode, sceneGraphCacheEntry, mmsgFrameList,
+            sceneGraphCacheHit);
+        timer.sceneGraphBenchTicks.stop();
+        timer.sceneGraphBenchTimer.stop();
+        if (sceneGraphCacheHit) {
+            ++timer.sceneGraphCacheHits;
+        } else {
+            ++timer.sceneGraphCacheMisses;
+        }
+        if (status == MS::kSuccess) {
+            // The scene graph is moved back into the cache entry when
+            // the solve finishes, by 'SceneGraphCacheReleaseGuard'.
+            mmsgSceneGraph = std::move(sceneGraphCacheEntry->sceneGraph);
+            mmsgAttrDataBlock =
+                std::move(sceneGraphCacheEntry->attrDataBlock);
+            mmsgFlatScene = std::move(sceneGraphCacheEntry->flatScene);
+            mmsgCameraNodes = std::move(sceneGraphCacheEntry->cameraNodes);
+            mmsgBundleNodes = std::move(sceneGraphCacheEntry->bundleNodes);
+            mmsgMarkerNodes = std::move(sceneGraphCacheEntry->markerNodes);
+            mmsgAttrIdList = std::move(sceneGraphCacheEntry->attrIdList);
+        }
         if (status != MS::kSuccess) {
             // Please use the 'mmSolverSceneGraph' command to test construct
             // a scene graph successfully before attempting to use it.
@@ -1002,7 +1068,16 @@ MStatus solveFrames(
     status = mmsolver::constructLensModelList(
         cameraList, usedMarkerList, usedAttrList, frameList,
         markerFrameToLensModelList, attrFrameToLensModelList, lensModelList);
-    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (status != MS::kSuccess) {
+        if (sceneGraphCacheEntry != nullptr) {
+            // The scene graph data has been moved out of the cache
+            // entry, so the entry cannot be used again.
+            sceneGraphCacheEntry->valid = false;
+            scene_graph_cache_release(sceneGraphCacheEntry,
+                                      std::vector<mmsg::AttrId>());
+        }
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
 #endif
 
     // Solving Objects.
@@ -1032,6 +1107,8 @@ MStatus solveFrames(
     userData.mmsgBundleNodes = std::move(mmsgBundleNodes);
     userData.mmsgMarkerNodes = std::move(mmsgMarkerNodes);
     userData.mmsgAttrIdList = std::move(mmsgAttrIdList);
+    SceneGraphCacheReleaseGuard sceneGraphCacheGuard(sceneGraphCacheEntry,
+                                                     userData);
 
     userData.paramToAttrList = out_paramToAttrList;
     userData.errorToMarkerList = out_errorToMarkerList;
@@ -69,6 +69,15 @@ struct SolverTimer {
     mmsolver::debug::CPUBenchmark funcBenchTicks;
     mmsolver::debug::CPUBenchmark errorBenchTicks;
     mmsolver::debug::CPUBenchmark paramBenchTicks;
+
+    // Time spent getting an MM Scene Graph, either constructed or
+    // re-used from the scene graph cache.
+    mmsolver::debug::TimestampBenchmark sceneGraphBenchTimer;
+    mmsolver::debug::CPUBenchmark sceneGraphBenchTicks;
+    uint32_t sceneGraphCacheHits;
+    uint32_t sceneGraphCacheMisses;
+
+    SolverTimer() : sceneGraphCacheHits(0), sceneGraphCacheMisses(0) {}
 };
 
 enum class FrameSolveMode {
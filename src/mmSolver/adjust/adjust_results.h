@@ -170,11 +170,15 @@ struct TimerResult {
     double timer_jacobian;
     double timer_parameter;
     double timer_error;
+    double timer_scene_graph;
     Ticks ticks_solve;
     Ticks ticks_function;
     Ticks ticks_jacobian;
     Ticks ticks_parameter;
     Ticks ticks_error;
+    Ticks ticks_scene_graph;
+    uint32_t scene_graph_cache_hits;
+    uint32_t scene_graph_cache_misses;
 
     TimerResult()
         : count(0)
@@ -183,11 +187,15 @@ struct TimerResult {
         , timer_jacobian(0.0)
         , timer_parameter(0.0)
         , timer_error(0.0)
+        , timer_scene_graph(0.0)
         , ticks_solve(0)
         , ticks_function(0)
         , ticks_jacobian(0)
         , ticks_parameter(0)
-        , ticks_error(0) {}
+        , ticks_error(0)
+        , ticks_scene_graph(0)
+        , scene_graph_cache_hits(0)
+        , scene_graph_cache_misses(0) {}
 
     void fill(const SolverTimer &timer) {
         Self::count = 1;
@@ -197,12 +205,17 @@ struct TimerResult {
         Self::timer_jacobian = timer.jacBenchTimer.get_seconds();
         Self::timer_parameter = timer.paramBenchTimer.get_seconds();
         Self::timer_error = timer.paramBenchTimer.get_seconds();
+        Self::timer_scene_graph = timer.sceneGraphBenchTimer.get_seconds();
 
         Self::ticks_solve = timer.solveBenchTicks.get_ticks();
         Self::ticks_function = timer.funcBenchTicks.get_ticks();
         Self::ticks_jacobian = timer.jacBenchTicks.get_ticks();
         Self::ticks_parameter = timer.paramBenchTicks.get_ticks();
         Self::ticks_error = timer.paramBenchTicks.get_ticks();
+        Self::ticks_scene_graph = timer.sceneGraphBenchTicks.get_ticks();
+
+        Self::scene_graph_cache_hits = timer.sceneGraphCacheHits;
+        Self::scene_graph_cache_misses = timer.sceneGraphCacheMisses;
     }
 
     void add(const Self &other) {
@@ -211,12 +224,18 @@ struct TimerResult {
         Self::timer_jacobian += other.timer_jacobian;
         Self::timer_parameter += other.timer_parameter;
         Self::timer_error += other.timer_error;
+        Self::timer_scene_graph += other.timer_scene_graph;
 
         Self::ticks_solve += other.ticks_solve;
         Self::ticks_function += other.ticks_function;
         Self::ticks_jacobian += other.ticks_jacobian;
         Self::ticks_parameter += other.ticks_parameter;
         Self::ticks_error += other.ticks_error;
+        Self::ticks_scene_graph += other.ticks_scene_graph;
+
+        // Cache hits and misses are counted, not averaged.
+        Self::scene_graph_cache_hits += other.scene_graph_cache_hits;
+        Self::scene_graph_cache_misses += other.scene_graph_cache_misses;
 
         Self::count += other.count;
     }
@@ -232,12 +251,14 @@ struct TimerResult {
         Self::timer_jacobian *= count_inverse;
         Self::timer_parameter *= count_inverse;
         Self::timer_error *= count_inverse;
+        Self::timer_scene_graph *= count_inverse;
 
         Self::ticks_solve *= count_inverse;
         Self::ticks_function *= count_inverse;
         Self::ticks_jacobian *= count_inverse;
         Self::ticks_parameter *= count_inverse;
         Self::ticks_error *= count_inverse;
+        Self::ticks_scene_graph *= count_inverse;
 
         Self::count = 1;
     }
@@ -284,6 +305,24 @@ struct TimerResult {
         value = mmstring::numberToString<Ticks>(Self::ticks_error);
         str = "ticks_error=" + value;
         result.append(MString(str.c_str()));
+
+        value = mmstring::numberToString<double>(Self::timer_scene_graph);
+        str = "timer_scene_graph=" + value;
+        result.append(MString(str.c_str()));
+
+        value = mmstring::numberToString<Ticks>(Self::ticks_scene_graph);
+        str = "ticks_scene_graph=" + value;
+        result.append(MString(str.c_str()));
+
+        value = mmstring::numberToString<uint32_t>(
+            Self::scene_graph_cache_hits);
+        str = "scene_graph_cache_hits=" + value;
+        result.append(MString(str.c_str()));
+
+        value = mmstring::numberToString<uint32_t>(
+            Self::scene_graph_cache_misses);
+        str = "scene_graph_cache_misses=" + value;
+        result.append(MString(str.c_str()));
     }
 };
 
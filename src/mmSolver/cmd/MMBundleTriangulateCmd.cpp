@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Command for triangulating bundle positions from all marker
+ * observations of a solved camera.
+ *
+ * Example usage (Python):
+
+import maya.cmds
+import mmSolver.api as mmapi
+
+mkr_nodes = maya.cmds.ls('Track_*_MKR', long=True) or []
+mkr_bnd_list = []
+for mkr_node in mkr_nodes:
+    mkr = mmapi.Marker(node=mkr_node)
+    bnd = mkr.get_bundle()
+    mkr_bnd_list.append((mkr_node, bnd.get_node()))
+
+maya.cmds.mmBundleTriangulate(
+    camera='camera1',
+    marker=mkr_bnd_list,
+    startFrame=1001,
+    endFrame=1200,
+    setValues=True,
+)
+ */
+
+#include "MMBundleTriangulateCmd.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Maya
+#include <maya/MArgDatabase.h>
+#include <maya/MArgList.h>
+#include <maya/MDagPath.h>
+#include <maya/MMatrix.h>
+#include <maya/MObject.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+#include <maya/MTime.h>
+
+// MM Solver
+#include "mmSolver/adjust/adjust_defines.h"
+#include "mmSolver/mayahelper/maya_attr.h"
+#include "mmSolver/mayahelper/maya_bundle.h"
+#include "mmSolver/mayahelper/maya_camera.h"
+#include "mmSolver/mayahelper/maya_marker.h"
+#include "mmSolver/mayahelper/maya_utils.h"
+#include "mmSolver/sfm/bundle_triangulation.h"
+#include "mmSolver/sfm/marker_tracks.h"
+#include "mmSolver/sfm/sfm_utils.h"
+#include "mmSolver/utilities/debug_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
+
+#define SET_VALUES_SHORT_FLAG "-sv"
+#define SET_VALUES_LONG_FLAG "-setValues"
+
+#define CAMERA_SHORT_FLAG "-c"
+#define CAMERA_LONG_FLAG "-camera"
+
+#define MARKER_SHORT_FLAG "-m"
+#define MARKER_LONG_FLAG "-marker"
+
+#define START_FRAME_SHORT_FLAG "-sf"
+#define START_FRAME_LONG_FLAG "-startFrame"
+
+#define END_FRAME_SHORT_FLAG "-ef"
+#define END_FRAME_LONG_FLAG "-endFrame"
+
+#define MAX_REPROJECTION_ERROR_SHORT_FLAG "-mre"
+#define MAX_REPROJECTION_ERROR_LONG_FLAG "-maxReprojectionError"
+
+#define MIN_TRIANGULATION_ANGLE_SHORT_FLAG "-mta"
+#define MIN_TRIANGULATION_ANGLE_LONG_FLAG "-minTriangulationAngle"
+
+#define THREAD_COUNT_SHORT_FLAG "-tc"
+#define THREAD_COUNT_LONG_FLAG "-threadCount"
+
+namespace mmsolver {
+
+MMBundleTriangulateCmd::~MMBundleTriangulateCmd() {}
+
+void *MMBundleTriangulateCmd::creator() { return new MMBundleTriangulateCmd(); }
+
+MString MMBundleTriangulateCmd::cmdName() {
+    return MString("mmBundleTriangulate");
+}
+
+/*
+ * Tell Maya we have a syntax function.
+ */
+bool MMBundleTriangulateCmd::hasSyntax() const { return true; }
+
+bool MMBundleTriangulateCmd::isUndoable() const { return true; }
+
+/*
+ * Add flags to the command syntax
+ */
+MSyntax MMBundleTriangulateCmd::newSyntax() {
+    MStatus status = MStatus::kSuccess;
+
+    MSyntax syntax;
+    syntax.enableQuery(false);
+    syntax.enableEdit(false);
+
+    CHECK_MSTATUS(syntax.addFlag(SET_VALUES_SHORT_FLAG, SET_VALUES_LONG_FLAG,
+                                 MSyntax::kBoolean));
+
+    CHECK_MSTATUS(syntax.addFlag(CAMERA_SHORT_FLAG, CAMERA_LONG_FLAG,
+                                 MSyntax::kSelectionItem));
+
+    CHECK_MSTATUS(syntax.addFlag(MARKER_SHORT_FLAG, MARKER_LONG_FLAG,
+                                 MSyntax::kString, MSyntax::kString));
+    CHECK_MSTATUS(syntax.makeFlagMultiUse(MARKER_SHORT_FLAG));
+
+    CHECK_MSTATUS(syntax.addFlag(START_FRAME_SHORT_FLAG, START_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(END_FRAME_SHORT_FLAG, END_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+
+    CHECK_MSTATUS(syntax.addFlag(MAX_REPROJECTION_ERROR_SHORT_FLAG,
+                                 MAX_REPROJECTION_ERROR_LONG_FLAG,
+                                 MSyntax::kDouble));
+    CHECK_MSTATUS(syntax.addFlag(MIN_TRIANGULATION_ANGLE_SHORT_FLAG,
+                                 MIN_TRIANGULATION_ANGLE_LONG_FLAG,
+                                 MSyntax::kDouble));
+
+    CHECK_MSTATUS(syntax.addFlag(THREAD_COUNT_SHORT_FLAG,
+                                 THREAD_COUNT_LONG_FLAG, MSyntax::kLong));
+
+    return syntax;
+}
+
+/*
+ * Parse command line arguments
+ */
+MStatus MMBundleTriangulateCmd::parseArgs(const MArgList &args) {
+    MStatus status = MStatus::kSuccess;
+
+    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
+    const bool verbose = false;
+
+    MArgDatabase argData(syntax(), args, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    // Reset saved data structures.
+    m_marker_list.clear();
+
+    m_set_values = false;
+    if (argData.isFlagSet(SET_VALUES_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(SET_VALUES_SHORT_FLAG, 0, m_set_values);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_start_frame = 1;
+    if (argData.isFlagSet(START_FRAME_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(START_FRAME_SHORT_FLAG, 0, m_start_frame);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_end_frame = 120;
+    if (argData.isFlagSet(END_FRAME_SHORT_FLAG)) {
+        status = argData.getFlagArgument(END_FRAME_SHORT_FLAG, 0, m_end_frame);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    const ::mmsolver::sfm::BundleTriangulationOptions default_options;
+    m_max_reprojection_error = default_options.max_reprojection_error_pix;
+    if (argData.isFlagSet(MAX_REPROJECTION_ERROR_SHORT_FLAG)) {
+        status = argData.getFlagArgument(MAX_REPROJECTION_ERROR_SHORT_FLAG, 0,
+                                         m_max_reprojection_error);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_min_triangulation_angle = default_options.min_triangulation_angle_deg;
+    if (argData.isFlagSet(MIN_TRIANGULATION_ANGLE_SHORT_FLAG)) {
+        status = argData.getFlagArgument(MIN_TRIANGULATION_ANGLE_SHORT_FLAG, 0,
+                                         m_min_triangulation_angle);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    // Zero means use the default number of threads.
+    m_thread_count = 0;
+    if (argData.isFlagSet(THREAD_COUNT_SHORT_FLAG)) {
+        int thread_count = 0;
+        status =
+            argData.getFlagArgument(THREAD_COUNT_SHORT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
+
+    // The camera transform attributes are not set by this command.
+    Attr camera_tx_attr;
+    Attr camera_ty_attr;
+    Attr camera_tz_attr;
+    Attr camera_rx_attr;
+    Attr camera_ry_attr;
+    Attr camera_rz_attr;
+    MSelectionList camera_selection_list;
+    argData.getFlagArgument(CAMERA_SHORT_FLAG, 0, camera_selection_list);
+    status = ::mmsolver::sfm::parse_camera_argument(
+        camera_selection_list, m_camera, camera_tx_attr, camera_ty_attr,
+        camera_tz_attr, camera_rx_attr, camera_ry_attr, camera_rz_attr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    // Parse objects as 2D Markers, with their 3D Bundles.
+    uint32_t numberOfMarkerFlags = argData.numberOfFlagUses(MARKER_SHORT_FLAG);
+    for (uint32_t i = 0; i < numberOfMarkerFlags; ++i) {
+        MArgList markerArgs;
+        ObjectType objectType = ObjectType::kUnknown;
+        MDagPath dagPath;
+        MString markerName = "";
+        MObject markerObject;
+        status = argData.getFlagArgumentList(MARKER_SHORT_FLAG, i, markerArgs);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        markerName = markerArgs.asString(0, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsObject(markerName, markerObject);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsDagPath(markerName, dagPath);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        objectType = computeObjectType(markerObject, dagPath);
+        if (objectType != ObjectType::kMarker) {
+            MMSOLVER_MAYA_ERR("Given marker node is not a Marker; "
+                              << markerName.asChar());
+            continue;
+        }
+        MMSOLVER_MAYA_VRB("Got markerName: " << markerName.asChar());
+
+        MString bundleName = "";
+        MObject bundleObject;
+        bundleName = markerArgs.asString(1, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsObject(bundleName, bundleObject);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsDagPath(bundleName, dagPath);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        objectType = computeObjectType(bundleObject, dagPath);
+        if (objectType != ObjectType::kBundle) {
+            MMSOLVER_MAYA_ERR("Given bundle node is not a Bundle; "
+                              << bundleName.asChar());
+            continue;
+        }
+        MMSOLVER_MAYA_VRB("Got bundleName: " << bundleName.asChar());
+
+        MarkerPtr marker = MarkerPtr(new Marker());
+        marker->setNodeName(markerName);
+        marker->setCamera(m_camera);
+
+        BundlePtr bundle = BundlePtr(new Bundle());
+        bundle->setNodeName(bundleName);
+        marker->setBundle(bundle);
+
+        m_marker_list.push_back(marker);
+    }
+    MMSOLVER_MAYA_VRB("parse m_marker_list size: " << m_marker_list.size());
+
+    return status;
+}
+
+// The command result is 6 values per marker (in the order given);
+// triangulated (1.0 or 0.0), the bundle X, Y and Z world position,
+// the number of inlier marker frames, and the RMS reprojection error
+// (pixels) of the inliers.
+MStatus MMBundleTriangulateCmd::doIt(const MArgList &args) {
+    MStatus status = MStatus::kSuccess;
+
+    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
+    const bool verbose = false;
+
+    // Read all the flag arguments.
+    status = parseArgs(args);
+    if (status == MStatus::kFailure) {
+        return status;
+    }
+
+    // Command Outputs
+    MDoubleArray outResult;
+
+    if (m_end_frame < m_start_frame) {
+        MMSOLVER_MAYA_ERR("End frame must not be before the start frame; start="
+                          << m_start_frame << " end=" << m_end_frame);
+        return MS::kFailure;
+    }
+
+    // Read the markers and the camera of all frames from Maya once,
+    // on the main thread.
+    ::mmsolver::sfm::MarkerTracks tracks;
+    status = ::mmsolver::sfm::gather_marker_tracks(
+        m_start_frame, m_end_frame, m_camera, m_marker_list, tracks);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const size_t frame_count = tracks.frames.size();
+    std::vector<openMVG::Mat34> camera_matrices(frame_count);
+    std::vector<uint8_t> camera_valid(frame_count, 0);
+    const auto uiUnit = MTime::uiUnit();
+    const auto timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+    Attr &camera_matrix_attr = m_camera->getMatrixAttr();
+    for (size_t i = 0; i < frame_count; ++i) {
+        const auto frame_value = static_cast<double>(tracks.frames[i].frame);
+        const auto time = MTime(frame_value, uiUnit);
+        MMatrix world_matrix;
+        status = camera_matrix_attr.getValue(world_matrix, time, timeEvalMode);
+        if (status != MS::kSuccess) {
+            MMSOLVER_MAYA_WRN("Camera matrix could not be read on frame "
+                              << tracks.frames[i].frame << ".");
+            status = MS::kSuccess;
+            continue;
+        }
+        camera_matrices[i] =
+            ::mmsolver::sfm::convert_maya_camera_matrix_to_camera_matrix(
+                world_matrix);
+        camera_valid[i] = camera_matrices[i].allFinite();
+    }
+
+    // Each bundle is triangulated independently, in parallel, without
+    // touching the Maya DG.
+    ::mmsolver::sfm::BundleTriangulationOptions options;
+    options.max_reprojection_error_pix = m_max_reprojection_error;
+    options.min_triangulation_angle_deg = m_min_triangulation_angle;
+    options.thread_count = (m_thread_count > 0)
+                               ? static_cast<size_t>(m_thread_count)
+                               : mmthread::defaultThreadCount();
+    std::vector<::mmsolver::sfm::BundleTriangulationResult> results;
+    ::mmsolver::sfm::triangulate_bundles(tracks, camera_matrices,
+                                         camera_valid, options, results);
+
+    // Apply the results on the main thread.
+    auto attr_tx = Attr();
+    auto attr_ty = Attr();
+    auto attr_tz = Attr();
+    size_t triangulated_count = 0;
+    for (size_t i = 0; i < m_marker_list.size(); ++i) {
+        const ::mmsolver::sfm::BundleTriangulationResult &result = results[i];
+        auto bnd = m_marker_list[i]->getBundle();
+        auto bnd_name = bnd->getNodeName();
+
+        outResult.append(result.ok ? 1.0 : 0.0);
+        outResult.append(result.position[0]);
+        outResult.append(result.position[1]);
+        outResult.append(result.position[2]);
+        outResult.append(static_cast<double>(result.inlier_count));
+        outResult.append(result.error_rms_pix);
+        if (!result.ok) {
+            MMSOLVER_MAYA_VRB("Bundle could not be triangulated: "
+                              << bnd_name.asChar() << " observations="
+                              << result.observation_count
+                              << " inliers=" << result.inlier_count);
+            continue;
+        }
+        ++triangulated_count;
+        MMSOLVER_MAYA_VRB("bundle: " << bnd_name.asChar()
+                                     << " error=" << result.error_rms_pix
+                                     << " pixels, inliers="
+                                     << result.inlier_count << "/"
+                                     << result.observation_count
+                                     << " angle=" << result.angle_deg);
+
+        if (m_set_values) {
+            attr_tx.setNodeName(bnd_name);
+            attr_ty.setNodeName(bnd_name);
+            attr_tz.setNodeName(bnd_name);
+
+            attr_tx.setAttrName(MString("translateX"));
+            attr_ty.setAttrName(MString("translateY"));
+            attr_tz.setAttrName(MString("translateZ"));
+
+            attr_tx.setValue(result.position[0], m_dgmod, m_curveChange);
+            attr_ty.setValue(result.position[1], m_dgmod, m_curveChange);
+            attr_tz.setValue(result.position[2], m_dgmod, m_curveChange);
+        }
+    }
+    if (triangulated_count < m_marker_list.size()) {
+        MMSOLVER_MAYA_WRN("Bundle triangulation failed for "
+                          << (m_marker_list.size() - triangulated_count)
+                          << " of " << m_marker_list.size() << " bundles.");
+    }
+
+    m_dgmod.doIt();
+
+    MMBundleTriangulateCmd::setResult(outResult);
+    return status;
+}
+
+MStatus MMBundleTriangulateCmd::redoIt() {
+    MStatus status;
+    m_dgmod.doIt();
+    m_curveChange.redoIt();
+    return status;
+}
+
+MStatus MMBundleTriangulateCmd::undoIt() {
+    MStatus status;
+    m_curveChange.undoIt();
+    m_dgmod.undoIt();
+    return status;
+}
+
+}  // namespace mmsolver
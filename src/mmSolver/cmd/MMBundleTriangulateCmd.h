@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Header for mmBundleTriangulate Maya command.
+ */
+
+#ifndef MM_SOLVER_MM_BUNDLE_TRIANGULATE_CMD_H
+#define MM_SOLVER_MM_BUNDLE_TRIANGULATE_CMD_H
+
+// STL
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Maya
+#include <maya/MAnimCurveChange.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MArgList.h>
+#include <maya/MDGModifier.h>
+#include <maya/MGlobal.h>
+#include <maya/MIOStream.h>
+#include <maya/MPxCommand.h>
+#include <maya/MSelectionList.h>
+#include <maya/MSyntax.h>
+#include <maya/MTime.h>
+#include <maya/MTimeArray.h>
+
+// Maya helpers
+#include "mmSolver/mayahelper/maya_attr.h"
+#include "mmSolver/mayahelper/maya_bundle.h"
+#include "mmSolver/mayahelper/maya_camera.h"
+#include "mmSolver/mayahelper/maya_marker.h"
+#include "mmSolver/mayahelper/maya_utils.h"
+
+namespace mmsolver {
+
+class MMBundleTriangulateCmd : public MPxCommand {
+public:
+    MMBundleTriangulateCmd(){};
+    virtual ~MMBundleTriangulateCmd();
+
+    virtual bool hasSyntax() const;
+    static MSyntax newSyntax();
+
+    virtual MStatus doIt(const MArgList &args);
+    virtual bool isUndoable() const;
+    virtual MStatus undoIt();
+    virtual MStatus redoIt();
+
+    static void *creator();
+    static MString cmdName();
+
+private:
+    MStatus parseArgs(const MArgList &args);
+
+    bool m_set_values;
+
+    double m_max_reprojection_error;
+    double m_min_triangulation_angle;
+
+    // The number of threads; zero means the default number of
+    // threads.
+    uint32_t m_thread_count;
+
+    // Maya Objects
+    CameraPtr m_camera;
+    MarkerPtrList m_marker_list;
+
+    // Frame range
+    uint32_t m_start_frame;
+    uint32_t m_end_frame;
+
+    // Undo/Redo
+    MDGModifier m_dgmod;
+    MAnimCurveChange m_curveChange;
+};
+
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_MM_BUNDLE_TRIANGULATE_CMD_H
@@ -36,6 +36,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 // Maya
@@ -62,13 +63,16 @@
 // MM Solver
 #include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/mayahelper/maya_attr.h"
+#include "mmSolver/mayahelper/maya_bundle.h"
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/sfm/camera_from_known_points.h"
+#include "mmSolver/sfm/marker_tracks.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 #define SET_VALUES_SHORT_FLAG "-sv"
 #define SET_VALUES_LONG_FLAG "-setValues"
@@ -85,6 +89,9 @@
 #define BUNDLE_SHORT_FLAG "-b"
 #define BUNDLE_LONG_FLAG "-bundle"
 
+#define THREAD_COUNT_SHORT_FLAG "-tc"
+#define THREAD_COUNT_LONG_FLAG "-threadCount"
+
 namespace mmsolver {
 
 MMCameraPoseFromPointsCmd::~MMCameraPoseFromPointsCmd() {}
@@ -131,6 +138,9 @@ MSyntax MMCameraPoseFromPointsCmd::newSyntax() {
         syntax.addFlag(BUNDLE_SHORT_FLAG, BUNDLE_LONG_FLAG, MSyntax::kString));
     CHECK_MSTATUS(syntax.makeFlagMultiUse(BUNDLE_SHORT_FLAG));
 
+    CHECK_MSTATUS(syntax.addFlag(THREAD_COUNT_SHORT_FLAG,
+                                 THREAD_COUNT_LONG_FLAG, MSyntax::kLong));
+
     return syntax;
 }
 
@@ -159,6 +169,16 @@ MStatus MMCameraPoseFromPointsCmd::parseArgs(const MArgList &args) {
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
 
+    // Zero means use the default number of threads.
+    m_thread_count = 0;
+    if (argData.isFlagSet(THREAD_COUNT_SHORT_FLAG)) {
+        int thread_count = 0;
+        status =
+            argData.getFlagArgument(THREAD_COUNT_SHORT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
+
     // List of frames.
     const auto uiUnit = MTime::uiUnit();
     uint32_t numberOfFrameFlags = argData.numberOfFlagUses(FRAME_SHORT_FLAG);
@@ -267,70 +287,123 @@ MStatus MMCameraPoseFromPointsCmd::doIt(const MArgList &args) {
     // user that something failed.
     const MDoubleArray emptyResult;
 
-    const auto uiUnit = MTime::uiUnit();
-    for (auto i = 0; i < m_times.size(); ++i) {
+    // Gather the camera and the 2D/3D point correspondences of all
+    // frames, reading the Maya DG on the main thread. The marker and
+    // bundle values are read for all frames at once, then the points
+    // of all frames are stored in one contiguous matrix, with each
+    // frame using a range of columns.
+    const size_t frame_count = m_times.size();
+    const size_t marker_count = m_marker_list.size();
+    ::mmsolver::sfm::MarkerTracks tracks;
+    status = ::mmsolver::sfm::gather_marker_tracks(m_frames, m_camera,
+                                                   m_marker_list, tracks);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MTimeArray times;
+    for (size_t i = 0; i < frame_count; ++i) {
+        times.append(m_times[i]);
+    }
+    BundlePtrList bundle_list;
+    bundle_list.reserve(marker_count);
+    for (size_t j = 0; j < marker_count; ++j) {
+        bundle_list.push_back(m_marker_list[j]->getBundle());
+    }
+    std::vector<double> bundle_positions;
+    std::vector<uint8_t> bundle_valid;
+    status = ::mmsolver::sfm::gather_bundle_positions(
+        times, bundle_list, bundle_positions, bundle_valid);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    std::vector<::mmsolver::sfm::KnownPointsFrame> frames;
+    frames.reserve(frame_count);
+    std::vector<std::pair<double, double>> marker_coords;
+    std::vector<std::tuple<double, double, double>> bundle_coords;
+    marker_coords.reserve(frame_count * marker_count);
+    bundle_coords.reserve(frame_count * marker_count);
+    for (size_t i = 0; i < frame_count; ++i) {
         MMSOLVER_MAYA_VRB("-------------------------------");
-        auto frame = m_frames[i];
-        auto time = m_times[i];
+        const auto frame = m_frames[i];
         MMSOLVER_MAYA_VRB("frame: " << frame);
 
-        double focal_length_mm = 35.0;
-        double sensor_width_mm = 36.0;
-        double sensor_height_mm = 24.0;
-        double focal_length_pix = 0.0;
-        double ppx_pix = 0.0;
-        double ppy_pix = 0.0;
-        int32_t image_width = 2;
-        int32_t image_height = 2;
-        status = ::mmsolver::sfm::get_camera_values(
-            time, m_camera, image_width, image_height, focal_length_mm,
-            sensor_width_mm, sensor_height_mm);
-        CHECK_MSTATUS_AND_RETURN_IT(status);
-
-        ::mmsolver::sfm::convert_camera_lens_mm_to_pixel_units(
-            image_width, image_height, focal_length_mm, sensor_width_mm,
-            focal_length_pix, ppx_pix, ppy_pix);
-
-        MMSOLVER_MAYA_VRB("image (pixel): " << image_width << "x"
-                                            << image_height);
-        MMSOLVER_MAYA_VRB("sensor (mm): " << sensor_width_mm << "x"
-                                          << sensor_height_mm);
-        MMSOLVER_MAYA_VRB("focal (mm): " << focal_length_mm);
-        MMSOLVER_MAYA_VRB("focal (pixel): " << focal_length_pix);
-        MMSOLVER_MAYA_VRB("principal point (pixel): " << ppx_pix << "x"
-                                                      << ppy_pix);
-
-        MarkerPtrList marker_list;
-        BundlePtrList bundle_list;
-        std::vector<std::pair<double, double>> marker_coords;
-        std::vector<std::tuple<double, double, double>> bundle_coords;
-        std::shared_ptr<mmlens::LensModel> lensModel;
-
-        for (auto j = 0; j < m_marker_list.size(); ++j) {
-            auto marker = m_marker_list[j];
-            auto marker_success = ::mmsolver::sfm::add_marker_at_frame(
-                time, image_width, image_height, lensModel, marker,
-                marker_coords);
-            if (!marker_success) {
+        const ::mmsolver::sfm::MarkerTrackFrame &track_frame =
+            tracks.frames[i];
+        ::mmsolver::sfm::KnownPointsFrame known_points_frame;
+        known_points_frame.image_width = track_frame.image_width;
+        known_points_frame.image_height = track_frame.image_height;
+        known_points_frame.focal_length_pix = track_frame.focal_length_pix;
+        known_points_frame.ppx_pix = track_frame.ppx_pix;
+        known_points_frame.ppy_pix = track_frame.ppy_pix;
+
+        MMSOLVER_MAYA_VRB("image (pixel): "
+                          << known_points_frame.image_width << "x"
+                          << known_points_frame.image_height);
+        MMSOLVER_MAYA_VRB(
+            "focal (pixel): " << known_points_frame.focal_length_pix);
+        MMSOLVER_MAYA_VRB("principal point (pixel): "
+                          << known_points_frame.ppx_pix << "x"
+                          << known_points_frame.ppy_pix);
+
+        // Only markers with a valid bundle are used, keeping the
+        // markers and bundles paired.
+        known_points_frame.start_column = marker_coords.size();
+        for (size_t j = 0; j < marker_count; ++j) {
+            const size_t marker_index = tracks.index(i, j);
+            const size_t bundle_index = (i * marker_count) + j;
+            if (!tracks.valid[marker_index] || !bundle_valid[bundle_index]) {
                 continue;
             }
-
-            auto bundle = marker->getBundle();
-            auto bundle_success = ::mmsolver::sfm::add_bundle_at_frame(
-                time, bundle, bundle_coords);
-            if (bundle_success) {
-                marker_list.push_back(marker);
-                bundle_list.push_back(bundle);
-            }
+            auto xy = std::pair<double, double>{
+                tracks.coords[(marker_index * 2) + 0],
+                tracks.coords[(marker_index * 2) + 1]};
+            auto xyz = std::tuple<double, double, double>{
+                bundle_positions[(bundle_index * 3) + 0],
+                bundle_positions[(bundle_index * 3) + 1],
+                bundle_positions[(bundle_index * 3) + 2]};
+            marker_coords.push_back(xy);
+            bundle_coords.push_back(xyz);
         }
+        known_points_frame.column_count =
+            marker_coords.size() - known_points_frame.start_column;
+        frames.push_back(known_points_frame);
+    }
 
+    const openMVG::Mat marker_coords_matrix =
+        ::mmsolver::sfm::convert_marker_coords_to_matrix(marker_coords);
+    const openMVG::Mat bundle_coords_matrix =
+        ::mmsolver::sfm::convert_bundle_coords_to_matrix_flip_z(bundle_coords);
+
+    // Each frame is solved independently, so the frames are solved in
+    // parallel, without touching the Maya DG.
+    const size_t thread_count = (m_thread_count > 0)
+                                    ? static_cast<size_t>(m_thread_count)
+                                    : mmthread::defaultThreadCount();
+    std::vector<::mmsolver::sfm::KnownPointsFrameResult> results;
+    ::mmsolver::sfm::compute_camera_poses_from_known_points(
+        frames, marker_coords_matrix, bundle_coords_matrix, thread_count,
+        results);
+
+    // Apply the results on the main thread, in frame order.
+    for (size_t i = 0; i < frame_count; ++i) {
+        const auto frame = m_frames[i];
+        const auto time = m_times[i];
+        const ::mmsolver::sfm::KnownPointsFrameResult &result = results[i];
+
+        const bool pose_ok = result.ok;
         MTransformationMatrix pose_transform;
-        auto pose_ok = ::mmsolver::sfm::compute_camera_pose_from_known_points(
-            image_width, image_height, focal_length_pix, ppx_pix, ppy_pix,
-            marker_coords, bundle_coords, pose_transform);
-        if (!pose_ok) {
-            MMSOLVER_MAYA_WRN("Compute Relative pose failed on frame "
-                              << frame);
+        if (pose_ok) {
+            auto pose = result.pose;
+            MMSOLVER_MAYA_VRB("frame " << frame
+                                       << " error: " << result.error_max
+                                       << " pixels, inliers: "
+                                       << result.inlier_count);
+            pose_transform =
+                ::mmsolver::sfm::convert_pose_to_maya_transform_matrix(pose);
+        } else {
+            MMSOLVER_MAYA_WRN("Camera Pose could not be found on frame "
+                              << frame << " with at least 3 points."
+                              << " error=" << result.error_max << " pixels"
+                              << ", valid samples=" << result.inlier_count
+                              << ", points=" << frames[i].column_count);
         }
         auto pose_matrix = pose_transform.asMatrix();
 
@@ -25,6 +25,7 @@
 
 // STL
 #include <cmath>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 
@@ -72,6 +73,10 @@ private:
 
     bool m_set_values;
 
+    // The number of threads used to solve frames; zero means the
+    // default number of threads.
+    uint32_t m_thread_count;
+
     // Maya Objects
     CameraPtr m_camera;
     Attr m_camera_tx_attr;
@@ -126,9 +126,11 @@ maya.cmds.mmCameraRelativePose(
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/sfm/camera_relative_pose.h"
+#include "mmSolver/sfm/frame_pair_search.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 #define SET_VALUES_SHORT_FLAG "-sv"
 #define SET_VALUES_LONG_FLAG "-setValues"
@@ -151,6 +153,24 @@ maya.cmds.mmCameraRelativePose(
 #define MARKER_BUNDLE_SHORT_FLAG "-mb"
 #define MARKER_BUNDLE_LONG_FLAG "-markerBundle"
 
+#define FIND_FRAME_PAIRS_SHORT_FLAG "-ffp"
+#define FIND_FRAME_PAIRS_LONG_FLAG "-findFramePairs"
+
+#define START_FRAME_SHORT_FLAG "-sf"
+#define START_FRAME_LONG_FLAG "-startFrame"
+
+#define END_FRAME_SHORT_FLAG "-ef"
+#define END_FRAME_LONG_FLAG "-endFrame"
+
+#define MIN_FRAME_GAP_SHORT_FLAG "-mfg"
+#define MIN_FRAME_GAP_LONG_FLAG "-minFrameGap"
+
+#define PAIR_COUNT_SHORT_FLAG "-pc"
+#define PAIR_COUNT_LONG_FLAG "-pairCount"
+
+#define THREAD_COUNT_SHORT_FLAG "-tc"
+#define THREAD_COUNT_LONG_FLAG "-threadCount"
+
 namespace mmsolver {
 
 MMCameraRelativePoseCmd::~MMCameraRelativePoseCmd() {}
@@ -202,6 +222,20 @@ MSyntax MMCameraRelativePoseCmd::newSyntax() {
                                  MSyntax::kString, MSyntax::kString));
     CHECK_MSTATUS(syntax.makeFlagMultiUse(MARKER_BUNDLE_SHORT_FLAG));
 
+    CHECK_MSTATUS(syntax.addFlag(FIND_FRAME_PAIRS_SHORT_FLAG,
+                                 FIND_FRAME_PAIRS_LONG_FLAG,
+                                 MSyntax::kBoolean));
+    CHECK_MSTATUS(syntax.addFlag(START_FRAME_SHORT_FLAG, START_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(END_FRAME_SHORT_FLAG, END_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(MIN_FRAME_GAP_SHORT_FLAG,
+                                 MIN_FRAME_GAP_LONG_FLAG, MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(PAIR_COUNT_SHORT_FLAG, PAIR_COUNT_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(THREAD_COUNT_SHORT_FLAG,
+                                 THREAD_COUNT_LONG_FLAG, MSyntax::kLong));
+
     return syntax;
 }
 
@@ -261,6 +295,57 @@ MStatus MMCameraRelativePoseCmd::parseArgs(const MArgList &args) {
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
 
+    m_find_frame_pairs = false;
+    if (argData.isFlagSet(FIND_FRAME_PAIRS_SHORT_FLAG)) {
+        status = argData.getFlagArgument(FIND_FRAME_PAIRS_SHORT_FLAG, 0,
+                                         m_find_frame_pairs);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_start_frame = 1;
+    if (argData.isFlagSet(START_FRAME_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(START_FRAME_SHORT_FLAG, 0, m_start_frame);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_end_frame = 1;
+    if (argData.isFlagSet(END_FRAME_SHORT_FLAG)) {
+        status = argData.getFlagArgument(END_FRAME_SHORT_FLAG, 0, m_end_frame);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    const ::mmsolver::sfm::FramePairSearchOptions default_options;
+    m_min_frame_gap = default_options.min_frame_gap;
+    if (argData.isFlagSet(MIN_FRAME_GAP_SHORT_FLAG)) {
+        status = argData.getFlagArgument(MIN_FRAME_GAP_SHORT_FLAG, 0,
+                                         m_min_frame_gap);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    m_pair_count = static_cast<uint32_t>(default_options.result_count);
+    if (argData.isFlagSet(PAIR_COUNT_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(PAIR_COUNT_SHORT_FLAG, 0, m_pair_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    // Zero means use the default number of threads.
+    m_thread_count = 0;
+    if (argData.isFlagSet(THREAD_COUNT_SHORT_FLAG)) {
+        int thread_count = 0;
+        status =
+            argData.getFlagArgument(THREAD_COUNT_SHORT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
+
+    if (m_find_frame_pairs) {
+        // Camera values are read at the start of the frame range.
+        m_frame_a = m_start_frame;
+        m_frame_b = m_start_frame;
+    }
+
     auto uiUnit = MTime::uiUnit();
     auto frame_value_a = static_cast<double>(m_frame_a);
     auto frame_value_b = static_cast<double>(m_frame_b);
@@ -405,48 +490,35 @@ MStatus MMCameraRelativePoseCmd::parseArgs(const MArgList &args) {
         marker_b->setBundle(bundle);
         marker_b->setCamera(m_camera_b);
 
-        std::shared_ptr<mmlens::LensModel> lensModel_a;
-        std::shared_ptr<mmlens::LensModel> lensModel_b;
-        {
-            MarkerPtrList markerList;
-            markerList.push_back(marker_a);
-            markerList.push_back(marker_b);
-
-            CameraPtrList cameraList;
-            cameraList.push_back(m_camera_a);
-            cameraList.push_back(m_camera_b);
-
-            AttrPtrList attrList;
-
-            MTimeArray frameList;
-            frameList.append(m_time_a);
-            frameList.append(m_time_b);
-
-            std::vector<std::shared_ptr<mmlens::LensModel>>
-                markerFrameToLensModelList;
-            std::vector<std::shared_ptr<mmlens::LensModel>>
-                attrFrameToLensModelList;
-            std::vector<std::shared_ptr<mmlens::LensModel>> lensModelList;
-
-            status = mmsolver::constructLensModelList(
-                cameraList, markerList, attrList, frameList,
-                markerFrameToLensModelList, attrFrameToLensModelList,
-                lensModelList);
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-
-            lensModel_a = markerFrameToLensModelList[0];
-            lensModel_b = markerFrameToLensModelList[1];
-        }
+        m_marker_list_a.push_back(marker_a);
+        m_marker_list_b.push_back(marker_b);
+        m_bundle_list.push_back(bundle);
+    }
 
-        auto success = ::mmsolver::sfm::add_marker_pair_at_frame(
-            m_time_a, m_time_b, m_image_width_a, m_image_width_b,
-            m_image_height_a, m_image_height_b, lensModel_a, lensModel_b,
-            marker_a, marker_b, m_marker_coords_a, m_marker_coords_b);
-        if (success) {
-            m_marker_list_a.push_back(marker_a);
-            m_marker_list_b.push_back(marker_b);
-            m_bundle_list.push_back(bundle);
+    // Read the marker positions of all pairs at once, keeping only the
+    // pairs valid on both frames. When finding frame pairs, the marker
+    // positions of all frames are read later.
+    if (!m_find_frame_pairs) {
+        std::vector<uint8_t> pair_valid;
+        status = ::mmsolver::sfm::gather_marker_pairs(
+            m_frame_a, m_frame_b, m_camera_a, m_camera_b, m_marker_list_a,
+            m_marker_list_b, m_marker_coords_a, m_marker_coords_b,
+            pair_valid);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        MarkerPtrList marker_list_a;
+        MarkerPtrList marker_list_b;
+        BundlePtrList bundle_list;
+        for (size_t i = 0; i < pair_valid.size(); ++i) {
+            if (pair_valid[i]) {
+                marker_list_a.push_back(m_marker_list_a[i]);
+                marker_list_b.push_back(m_marker_list_b[i]);
+                bundle_list.push_back(m_bundle_list[i]);
+            }
         }
+        m_marker_list_a = marker_list_a;
+        m_marker_list_b = marker_list_b;
+        m_bundle_list = bundle_list;
     }
 
     MMSOLVER_MAYA_VRB("parse m_marker_list_a size: " << m_marker_list_a.size());
@@ -470,6 +542,10 @@ MStatus MMCameraRelativePoseCmd::doIt(const MArgList &args) {
         return status;
     }
 
+    if (m_find_frame_pairs) {
+        return findFramePairs();
+    }
+
     // Command Outputs
     MDoubleArray outResult;
     // Intended to be used as a sentinal return value, informing the
@@ -678,6 +754,63 @@ MStatus MMCameraRelativePoseCmd::doIt(const MArgList &args) {
     return status;
 }
 
+// Search the frame range for the frame pairs that are best suited
+// to compute a relative pose.
+//
+// The marker positions of all frames are read from Maya once, then
+// the frame pairs are compared without Maya. The command result is 7
+// values per frame pair, ranked best first; frame A, frame B, score,
+// number of markers on both frames, median parallax (pixels),
+// essential matrix inlier count, and homography inlier count.
+MStatus MMCameraRelativePoseCmd::findFramePairs() {
+    MStatus status = MStatus::kSuccess;
+
+    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
+    const bool verbose = false;
+
+    MDoubleArray outResult;
+    if (m_end_frame <= m_start_frame) {
+        MMSOLVER_MAYA_ERR("End frame must be after the start frame; start="
+                          << m_start_frame << " end=" << m_end_frame);
+        return MS::kFailure;
+    }
+
+    ::mmsolver::sfm::MarkerTracks tracks;
+    status = ::mmsolver::sfm::gather_marker_tracks(
+        m_start_frame, m_end_frame, m_camera_a, m_marker_list_a, tracks);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    ::mmsolver::sfm::FramePairSearchOptions options;
+    options.min_frame_gap = m_min_frame_gap;
+    options.result_count = m_pair_count;
+    options.thread_count = (m_thread_count > 0)
+                               ? static_cast<size_t>(m_thread_count)
+                               : mmthread::defaultThreadCount();
+
+    std::vector<::mmsolver::sfm::FramePairScore> pairs;
+    const size_t scored_count =
+        ::mmsolver::sfm::find_best_frame_pairs(tracks, options, pairs);
+    MMSOLVER_MAYA_VRB("frame pairs scored: " << scored_count);
+    if (pairs.empty()) {
+        MMSOLVER_MAYA_WRN("No valid frame pairs found between frames "
+                          << m_start_frame << " and " << m_end_frame
+                          << "; " << scored_count << " pairs were scored.");
+    }
+
+    for (const auto &pair : pairs) {
+        outResult.append(static_cast<double>(pair.frame_a));
+        outResult.append(static_cast<double>(pair.frame_b));
+        outResult.append(pair.score);
+        outResult.append(static_cast<double>(pair.overlap_count));
+        outResult.append(pair.median_parallax_pix);
+        outResult.append(static_cast<double>(pair.essential_inlier_count));
+        outResult.append(static_cast<double>(pair.homography_inlier_count));
+    }
+
+    MMCameraRelativePoseCmd::setResult(outResult);
+    return status;
+}
+
 MStatus MMCameraRelativePoseCmd::redoIt() {
     MStatus status;
     m_dgmod.doIt();
@@ -25,6 +25,7 @@
 
 // STL
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
 // Maya
@@ -68,9 +69,19 @@ public:
 
 private:
     MStatus parseArgs(const MArgList &args);
+    MStatus findFramePairs();
 
     bool m_set_values;
 
+    // Search the frame range for the best frame pairs, rather than
+    // computing the relative pose of frames A and B.
+    bool m_find_frame_pairs;
+    uint32_t m_start_frame;
+    uint32_t m_end_frame;
+    uint32_t m_min_frame_gap;
+    uint32_t m_pair_count;
+    uint32_t m_thread_count;
+
     // OpenMVG
     int32_t m_image_width_a;
     int32_t m_image_height_a;
@@ -18,6 +18,29 @@
  * ====================================================================
  *
  * Command for running mmCameraSolve.
+ *
+ * Solves the camera poses and bundle positions of a frame range,
+ * from 2D markers only.
+ *
+ * Example usage (Python):
+
+import maya.cmds
+import mmSolver.api as mmapi
+
+mkr_nodes = maya.cmds.ls('Track_*_MKR', long=True) or []
+mkr_bnd_list = []
+for mkr_node in mkr_nodes:
+    mkr = mmapi.Marker(node=mkr_node)
+    bnd = mkr.get_bundle()
+    mkr_bnd_list.append((mkr_node, bnd.get_node()))
+
+maya.cmds.mmCameraSolve(
+    camera='camera1',
+    marker=mkr_bnd_list,
+    startFrame=1001,
+    endFrame=1200,
+    setValues=True,
+)
  */
 
 // NOTE: The following (MSVC) warnings are disabled because of
@@ -78,12 +101,6 @@
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
-#include <fstream>
-#include <iostream>
-#include <iterator>
-#include <limits>
-#include <list>
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -93,31 +110,60 @@
 #include <maya/MArgDatabase.h>
 #include <maya/MArgList.h>
 #include <maya/MDagPath.h>
-#include <maya/MFnDependencyNode.h>
-#include <maya/MItSelectionList.h>
+#include <maya/MEulerRotation.h>
 #include <maya/MMatrix.h>
-#include <maya/MMatrixArray.h>
 #include <maya/MObject.h>
-#include <maya/MPlug.h>
+#include <maya/MPoint.h>
 #include <maya/MString.h>
-#include <maya/MStringArray.h>
 #include <maya/MSyntax.h>
 #include <maya/MTime.h>
-#include <maya/MTimeArray.h>
+#include <maya/MTransformationMatrix.h>
 
 // MM Solver
 #include "mmSolver/adjust/adjust_defines.h"
+#include "mmSolver/mayahelper/maya_attr.h"
+#include "mmSolver/mayahelper/maya_bundle.h"
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
-#include "mmSolver/sfm/camera_relative_pose.h"
+#include "mmSolver/sfm/camera_solve.h"
+#include "mmSolver/sfm/marker_tracks.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
+#include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
-namespace mmsolver {
+#define SET_VALUES_SHORT_FLAG "-sv"
+#define SET_VALUES_LONG_FLAG "-setValues"
+
+#define CAMERA_SHORT_FLAG "-c"
+#define CAMERA_LONG_FLAG "-camera"
+
+#define MARKER_SHORT_FLAG "-m"
+#define MARKER_LONG_FLAG "-marker"
+
+#define START_FRAME_SHORT_FLAG "-sf"
+#define START_FRAME_LONG_FLAG "-startFrame"
+
+#define END_FRAME_SHORT_FLAG "-ef"
+#define END_FRAME_LONG_FLAG "-endFrame"
+
+#define FRAME_A_SHORT_FLAG "-fa"
+#define FRAME_A_LONG_FLAG "-frameA"
+
+#define FRAME_B_SHORT_FLAG "-fb"
+#define FRAME_B_LONG_FLAG "-frameB"
 
-using MMMarker = Marker;
-using MMCamera = Camera;
+#define BUNDLE_ADJUST_INTERVAL_SHORT_FLAG "-bai"
+#define BUNDLE_ADJUST_INTERVAL_LONG_FLAG "-bundleAdjustInterval"
+
+#define BUNDLE_ADJUST_WINDOW_SHORT_FLAG "-baw"
+#define BUNDLE_ADJUST_WINDOW_LONG_FLAG "-bundleAdjustWindow"
+
+#define THREAD_COUNT_SHORT_FLAG "-tc"
+#define THREAD_COUNT_LONG_FLAG "-threadCount"
+
+namespace mmsolver {
 
 MMCameraSolveCmd::~MMCameraSolveCmd() {}
 
@@ -130,21 +176,47 @@ MString MMCameraSolveCmd::cmdName() { return MString("mmCameraSolve"); }
  */
 bool MMCameraSolveCmd::hasSyntax() const { return true; }
 
-bool MMCameraSolveCmd::isUndoable() const { return false; }
+bool MMCameraSolveCmd::isUndoable() const { return true; }
 
 /*
  * Add flags to the command syntax
  */
 MSyntax MMCameraSolveCmd::newSyntax() {
+    MStatus status = MStatus::kSuccess;
+
     MSyntax syntax;
     syntax.enableQuery(false);
     syntax.enableEdit(false);
 
-    unsigned int minNumObjects = 0;
-    syntax.setObjectType(MSyntax::kSelectionList, minNumObjects);
+    CHECK_MSTATUS(syntax.addFlag(SET_VALUES_SHORT_FLAG, SET_VALUES_LONG_FLAG,
+                                 MSyntax::kBoolean));
+
+    CHECK_MSTATUS(syntax.addFlag(CAMERA_SHORT_FLAG, CAMERA_LONG_FLAG,
+                                 MSyntax::kSelectionItem));
+
+    CHECK_MSTATUS(syntax.addFlag(MARKER_SHORT_FLAG, MARKER_LONG_FLAG,
+                                 MSyntax::kString, MSyntax::kString));
+    CHECK_MSTATUS(syntax.makeFlagMultiUse(MARKER_SHORT_FLAG));
+
+    CHECK_MSTATUS(syntax.addFlag(START_FRAME_SHORT_FLAG, START_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(END_FRAME_SHORT_FLAG, END_FRAME_LONG_FLAG,
+                                 MSyntax::kUnsigned));
 
-    syntax.addFlag("-sf", "-startFrame", MSyntax::kUnsigned);
-    syntax.addFlag("-ef", "-endFrame", MSyntax::kUnsigned);
+    CHECK_MSTATUS(syntax.addFlag(FRAME_A_SHORT_FLAG, FRAME_A_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(FRAME_B_SHORT_FLAG, FRAME_B_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+
+    CHECK_MSTATUS(syntax.addFlag(BUNDLE_ADJUST_INTERVAL_SHORT_FLAG,
+                                 BUNDLE_ADJUST_INTERVAL_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+    CHECK_MSTATUS(syntax.addFlag(BUNDLE_ADJUST_WINDOW_SHORT_FLAG,
+                                 BUNDLE_ADJUST_WINDOW_LONG_FLAG,
+                                 MSyntax::kUnsigned));
+
+    CHECK_MSTATUS(syntax.addFlag(THREAD_COUNT_SHORT_FLAG,
+                                 THREAD_COUNT_LONG_FLAG, MSyntax::kLong));
 
     return syntax;
 }
@@ -161,112 +233,148 @@ MStatus MMCameraSolveCmd::parseArgs(const MArgList &args) {
     MArgDatabase argData(syntax(), args, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    auto uiUnit = MTime::uiUnit();
+    // Reset saved data structures.
+    m_marker_list.clear();
+    m_camera_rotate_order = MEulerRotation::kZXY;
 
-    m_startFrame = 1;
-    if (argData.isFlagSet("-sf")) {
-        status = argData.getFlagArgument("-sf", 0, m_startFrame);
+    m_set_values = false;
+    if (argData.isFlagSet(SET_VALUES_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(SET_VALUES_SHORT_FLAG, 0, m_set_values);
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
 
-    m_endFrame = 120;
-    if (argData.isFlagSet("-ef")) {
-        status = argData.getFlagArgument("-ef", 0, m_endFrame);
+    m_start_frame = 1;
+    if (argData.isFlagSet(START_FRAME_SHORT_FLAG)) {
+        status =
+            argData.getFlagArgument(START_FRAME_SHORT_FLAG, 0, m_start_frame);
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
 
-    m_startTime = MTime(static_cast<double>(m_startFrame), uiUnit);
-    m_endTime = MTime(static_cast<double>(m_endFrame), uiUnit);
-
-    auto objects = MSelectionList();
-    status = argData.getObjects(objects);
-    CHECK_MSTATUS_AND_RETURN_IT(status);
+    m_end_frame = 120;
+    if (argData.isFlagSet(END_FRAME_SHORT_FLAG)) {
+        status = argData.getFlagArgument(END_FRAME_SHORT_FLAG, 0, m_end_frame);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
 
-    // Reset saved data structures.
-    m_marker_coords_a.clear();
-    m_marker_coords_b.clear();
-    m_image_width_a = 1;
-    m_image_height_a = 1;
-    m_image_width_b = 1;
-    m_image_height_b = 1;
-
-    MItSelectionList iter1(objects);
-    for (; !iter1.isDone(); iter1.next()) {
-        MDagPath nodeDagPath;
-        MObject node_obj;
-
-        status = iter1.getDagPath(nodeDagPath);
+    // Frames A and B must both be given, otherwise the initial frame
+    // pair is found automatically.
+    m_find_initial_frames = !(argData.isFlagSet(FRAME_A_SHORT_FLAG) &&
+                              argData.isFlagSet(FRAME_B_SHORT_FLAG));
+    m_frame_a = m_start_frame;
+    m_frame_b = m_end_frame;
+    if (!m_find_initial_frames) {
+        status = argData.getFlagArgument(FRAME_A_SHORT_FLAG, 0, m_frame_a);
         CHECK_MSTATUS_AND_RETURN_IT(status);
-        status = iter1.getDependNode(node_obj);
+        status = argData.getFlagArgument(FRAME_B_SHORT_FLAG, 0, m_frame_b);
         CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
 
-        auto node_name = nodeDagPath.fullPathName();
-        // MMSOLVER_MAYA_VRB("Node name: " << node_name.asChar());
+    const ::mmsolver::sfm::CameraSolveOptions default_options;
+    m_bundle_adjust_interval =
+        static_cast<uint32_t>(default_options.bundle_adjust_interval);
+    if (argData.isFlagSet(BUNDLE_ADJUST_INTERVAL_SHORT_FLAG)) {
+        status = argData.getFlagArgument(BUNDLE_ADJUST_INTERVAL_SHORT_FLAG, 0,
+                                         m_bundle_adjust_interval);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
 
-        auto object_type = computeObjectType(node_obj, nodeDagPath);
-        if (object_type == ObjectType::kCamera) {
-            // Add Cameras
-            MMSOLVER_MAYA_VRB("Camera name: " << node_name.asChar());
-            MString transform_node_name = nodeDagPath.fullPathName();
+    m_bundle_adjust_window =
+        static_cast<uint32_t>(default_options.bundle_adjust_window);
+    if (argData.isFlagSet(BUNDLE_ADJUST_WINDOW_SHORT_FLAG)) {
+        status = argData.getFlagArgument(BUNDLE_ADJUST_WINDOW_SHORT_FLAG, 0,
+                                         m_bundle_adjust_window);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
 
-            status = nodeDagPath.extendToShapeDirectlyBelow(0);
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-            MString shape_node_name = nodeDagPath.fullPathName();
+    // Zero means use the default number of threads.
+    m_thread_count = 0;
+    if (argData.isFlagSet(THREAD_COUNT_SHORT_FLAG)) {
+        int thread_count = 0;
+        status =
+            argData.getFlagArgument(THREAD_COUNT_SHORT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
 
-            auto cam = MMCamera();
-            cam.setTransformNodeName(transform_node_name);
-            cam.setShapeNodeName(shape_node_name);
+    MSelectionList camera_selection_list;
+    argData.getFlagArgument(CAMERA_SHORT_FLAG, 0, camera_selection_list);
+    status = ::mmsolver::sfm::parse_camera_argument(
+        camera_selection_list, m_camera, m_camera_tx_attr, m_camera_ty_attr,
+        m_camera_tz_attr, m_camera_rx_attr, m_camera_ry_attr, m_camera_rz_attr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-            ::mmsolver::sfm::get_camera_image_res(
-                m_startFrame, uiUnit, cam, m_image_width_a, m_image_height_a);
-            ::mmsolver::sfm::get_camera_image_res(
-                m_endFrame, uiUnit, cam, m_image_width_b, m_image_height_b);
-        }
-    }
-    MMSOLVER_MAYA_VRB("image A: " << m_image_width_a << "x"
-                                  << m_image_height_a);
-    MMSOLVER_MAYA_VRB("image B: " << m_image_width_b << "x"
-                                  << m_image_height_b);
-
-    // Parse objects into Camera intrinsics and Tracking Markers.
-    MItSelectionList iter2(objects);
-    for (; !iter2.isDone(); iter2.next()) {
-        MDagPath nodeDagPath;
-        MObject node_obj;
-
-        status = iter2.getDagPath(nodeDagPath);
+    const auto uiUnit = MTime::uiUnit();
+    const auto start_time = MTime(static_cast<double>(m_start_frame), uiUnit);
+    auto timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+    m_camera->getRotateOrder(m_camera_rotate_order, start_time, timeEvalMode);
+
+    // Parse objects as 2D Markers, with their 3D Bundles.
+    uint32_t numberOfMarkerFlags = argData.numberOfFlagUses(MARKER_SHORT_FLAG);
+    for (uint32_t i = 0; i < numberOfMarkerFlags; ++i) {
+        MArgList markerArgs;
+        ObjectType objectType = ObjectType::kUnknown;
+        MDagPath dagPath;
+        MString markerName = "";
+        MObject markerObject;
+        status = argData.getFlagArgumentList(MARKER_SHORT_FLAG, i, markerArgs);
         CHECK_MSTATUS_AND_RETURN_IT(status);
-        status = iter2.getDependNode(node_obj);
+
+        markerName = markerArgs.asString(0, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsObject(markerName, markerObject);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsDagPath(markerName, dagPath);
         CHECK_MSTATUS_AND_RETURN_IT(status);
+        objectType = computeObjectType(markerObject, dagPath);
+        if (objectType != ObjectType::kMarker) {
+            MMSOLVER_MAYA_ERR("Given marker node is not a Marker; "
+                              << markerName.asChar());
+            continue;
+        }
+        MMSOLVER_MAYA_VRB("Got markerName: " << markerName.asChar());
 
-        auto node_name = nodeDagPath.fullPathName();
-        MMSOLVER_MAYA_VRB("Node name: " << node_name.asChar());
-
-        auto object_type = computeObjectType(node_obj, nodeDagPath);
-        if (object_type == ObjectType::kMarker) {
-            // Add Markers
-            MMSOLVER_MAYA_VRB("Marker name: " << node_name.asChar());
-            MarkerPtr marker = MarkerPtr(new Marker());
-            marker->setNodeName(node_name);
-
-            // Lens Models are not initialized and therefore are not
-            // used when add a marker pair.
-            std::shared_ptr<mmlens::LensModel> lensModel_a;
-            std::shared_ptr<mmlens::LensModel> lensModel_b;
-
-            auto success = ::mmsolver::sfm::add_marker_pair_at_frame(
-                m_startTime, m_endTime, m_image_width_a, m_image_width_b,
-                m_image_height_a, m_image_height_b, lensModel_a, lensModel_b,
-                marker, marker, m_marker_coords_a, m_marker_coords_b);
+        MString bundleName = "";
+        MObject bundleObject;
+        bundleName = markerArgs.asString(1, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsObject(bundleName, bundleObject);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = getAsDagPath(bundleName, dagPath);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        objectType = computeObjectType(bundleObject, dagPath);
+        if (objectType != ObjectType::kBundle) {
+            MMSOLVER_MAYA_ERR("Given bundle node is not a Bundle; "
+                              << bundleName.asChar());
+            continue;
         }
+        MMSOLVER_MAYA_VRB("Got bundleName: " << bundleName.asChar());
+
+        MarkerPtr marker = MarkerPtr(new Marker());
+        marker->setNodeName(markerName);
+        marker->setCamera(m_camera);
+
+        BundlePtr bundle = BundlePtr(new Bundle());
+        bundle->setNodeName(bundleName);
+        marker->setBundle(bundle);
+
+        m_marker_list.push_back(marker);
     }
+    MMSOLVER_MAYA_VRB("parse m_marker_list size: " << m_marker_list.size());
 
     return status;
 }
 
+// The command result is the number of solved frames, followed by the
+// frame number and 16 camera matrix values of each solved frame,
+// followed by the marker index and X, Y and Z bundle position of
+// each solved bundle.
 MStatus MMCameraSolveCmd::doIt(const MArgList &args) {
     MStatus status = MStatus::kSuccess;
 
+    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
+    const bool verbose = false;
+
     // Read all the flag arguments.
     status = parseArgs(args);
     if (status == MStatus::kFailure) {
@@ -275,13 +383,159 @@ MStatus MMCameraSolveCmd::doIt(const MArgList &args) {
 
     // Command Outputs
     MDoubleArray outResult;
+    // Intended to be used as a sentinal return value, informing the
+    // user that something failed.
+    const MDoubleArray emptyResult;
+
+    if (m_end_frame <= m_start_frame) {
+        MMSOLVER_MAYA_ERR("End frame must be after the start frame; start="
+                          << m_start_frame << " end=" << m_end_frame);
+        return MS::kFailure;
+    }
+
+    // Read all marker positions and camera values from Maya once; the
+    // solve does not touch the Maya DG.
+    ::mmsolver::sfm::MarkerTracks tracks;
+    status = ::mmsolver::sfm::gather_marker_tracks(
+        m_start_frame, m_end_frame, m_camera, m_marker_list, tracks);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const size_t thread_count = (m_thread_count > 0)
+                                    ? static_cast<size_t>(m_thread_count)
+                                    : mmthread::defaultThreadCount();
+
+    ::mmsolver::sfm::CameraSolveOptions options;
+    options.find_initial_frames = m_find_initial_frames;
+    options.initial_frame_a = m_frame_a;
+    options.initial_frame_b = m_frame_b;
+    options.bundle_adjust_interval = m_bundle_adjust_interval;
+    options.bundle_adjust_window = m_bundle_adjust_window;
+    options.thread_count = thread_count;
+
+    ::mmsolver::sfm::CameraSolveResult result;
+    const bool solve_ok =
+        ::mmsolver::sfm::solve_camera_incremental(tracks, options, result);
+    if (!solve_ok) {
+        MMSOLVER_MAYA_ERR("Camera solve failed; the initial frame pair "
+                          << result.frame_a << " and " << result.frame_b
+                          << " could not be solved.");
+        MMCameraSolveCmd::setResult(emptyResult);
+        return status;
+    }
+    MMSOLVER_MAYA_VRB("initial frames: " << result.frame_a << " and "
+                                         << result.frame_b);
+    MMSOLVER_MAYA_VRB("solved frames: " << result.solved_frame_count << " of "
+                                        << tracks.frames.size());
+    MMSOLVER_MAYA_VRB("solved bundles: " << result.solved_bundle_count
+                                         << " of " << m_marker_list.size());
+    MMSOLVER_MAYA_VRB("bundle adjustments: " << result.bundle_adjust_count);
+    if (result.solved_frame_count < tracks.frames.size()) {
+        MMSOLVER_MAYA_WRN("Camera solve could not solve "
+                          << (tracks.frames.size() - result.solved_frame_count)
+                          << " frames, with fewer than "
+                          << options.min_resection_point_count
+                          << " solved bundles.");
+    }
+
+    const auto uiUnit = MTime::uiUnit();
+    outResult.append(static_cast<double>(result.solved_frame_count));
+    for (size_t i = 0; i < tracks.frames.size(); ++i) {
+        if (!result.frame_solved[i]) {
+            continue;
+        }
+        const uint32_t frame = tracks.frames[i].frame;
+        const auto time = MTime(static_cast<double>(frame), uiUnit);
+
+        auto pose = result.poses[i];
+        auto pose_transform =
+            ::mmsolver::sfm::convert_pose_to_maya_transform_matrix(pose);
+        auto pose_matrix = pose_transform.asMatrix();
+
+        outResult.append(static_cast<double>(frame));
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                outResult.append(pose_matrix(row, column));
+            }
+        }
+
+        if (m_set_values) {
+            auto world_euler_rotation =
+                MEulerRotation::decompose(pose_matrix, m_camera_rotate_order);
+            auto rotate_x = world_euler_rotation.x * RADIANS_TO_DEGREES;
+            auto rotate_y = world_euler_rotation.y * RADIANS_TO_DEGREES;
+            auto rotate_z = world_euler_rotation.z * RADIANS_TO_DEGREES;
+
+            const auto translate_x = pose_matrix(3, 0);
+            const auto translate_y = pose_matrix(3, 1);
+            const auto translate_z = pose_matrix(3, 2);
+
+            m_camera_tx_attr.setValue(translate_x, time, m_dgmod,
+                                      m_curveChange);
+            m_camera_ty_attr.setValue(translate_y, time, m_dgmod,
+                                      m_curveChange);
+            m_camera_tz_attr.setValue(translate_z, time, m_dgmod,
+                                      m_curveChange);
+
+            m_camera_rx_attr.setValue(rotate_x, time, m_dgmod, m_curveChange);
+            m_camera_ry_attr.setValue(rotate_y, time, m_dgmod, m_curveChange);
+            m_camera_rz_attr.setValue(rotate_z, time, m_dgmod, m_curveChange);
+        }
+    }
+
+    auto attr_tx = Attr();
+    auto attr_ty = Attr();
+    auto attr_tz = Attr();
+    for (size_t i = 0; i < m_marker_list.size(); ++i) {
+        if (!result.bundle_solved[i]) {
+            continue;
+        }
+        const auto &pos = result.bundle_positions[i];
+        const double tx = pos[0];
+        const double ty = pos[1];
+        // Fixes the Camera +Z/-Z issue with Maya compared to OpenMVG.
+        const double tz = -pos[2];
+
+        outResult.append(static_cast<double>(i));
+        outResult.append(tx);
+        outResult.append(ty);
+        outResult.append(tz);
+
+        if (m_set_values) {
+            auto bnd = m_marker_list[i]->getBundle();
+            auto bnd_name = bnd->getNodeName();
+
+            attr_tx.setNodeName(bnd_name);
+            attr_ty.setNodeName(bnd_name);
+            attr_tz.setNodeName(bnd_name);
+
+            attr_tx.setAttrName(MString("translateX"));
+            attr_ty.setAttrName(MString("translateY"));
+            attr_tz.setAttrName(MString("translateZ"));
+
+            attr_tx.setValue(tx, m_dgmod, m_curveChange);
+            attr_ty.setValue(ty, m_dgmod, m_curveChange);
+            attr_tz.setValue(tz, m_dgmod, m_curveChange);
+        }
+    }
 
-    // TODO: Port camera solver from
-    // './python/mmSolver/_api/solvercamerautils.py' 'camera_solve'
-    // function to C++, with the aim of improving performance.
+    m_dgmod.doIt();
 
     MMCameraSolveCmd::setResult(outResult);
     return status;
 }
 
+MStatus MMCameraSolveCmd::redoIt() {
+    MStatus status;
+    m_dgmod.doIt();
+    m_curveChange.redoIt();
+    return status;
+}
+
+MStatus MMCameraSolveCmd::undoIt() {
+    MStatus status;
+    m_curveChange.undoIt();
+    m_dgmod.undoIt();
+    return status;
+}
+
 }  // namespace mmsolver
@@ -25,55 +25,85 @@
 
 // STL
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
 // Maya
+#include <maya/MAnimCurveChange.h>
 #include <maya/MArgDatabase.h>
 #include <maya/MArgList.h>
+#include <maya/MDGModifier.h>
+#include <maya/MEulerRotation.h>
 #include <maya/MGlobal.h>
 #include <maya/MIOStream.h>
-#include <maya/MPoint.h>
 #include <maya/MPxCommand.h>
 #include <maya/MSelectionList.h>
 #include <maya/MSyntax.h>
 #include <maya/MTime.h>
 #include <maya/MTimeArray.h>
 
+// Maya helpers
+#include "mmSolver/mayahelper/maya_attr.h"
+#include "mmSolver/mayahelper/maya_bundle.h"
+#include "mmSolver/mayahelper/maya_camera.h"
+#include "mmSolver/mayahelper/maya_marker.h"
+#include "mmSolver/mayahelper/maya_utils.h"
+
 namespace mmsolver {
 
 class MMCameraSolveCmd : public MPxCommand {
 public:
     MMCameraSolveCmd(){};
-
     virtual ~MMCameraSolveCmd();
 
     virtual bool hasSyntax() const;
     static MSyntax newSyntax();
 
     virtual MStatus doIt(const MArgList &args);
-
     virtual bool isUndoable() const;
+    virtual MStatus undoIt();
+    virtual MStatus redoIt();
 
     static void *creator();
-
     static MString cmdName();
 
 private:
     MStatus parseArgs(const MArgList &args);
 
-    // OpenMVG
-    int32_t m_image_width_a;
-    int32_t m_image_height_a;
-    int32_t m_image_width_b;
-    int32_t m_image_height_b;
-    std::vector<std::pair<double, double>> m_marker_coords_a;
-    std::vector<std::pair<double, double>> m_marker_coords_b;
+    bool m_set_values;
+
+    // The initial frame pair. When not given, the best frame pair in
+    // the frame range is found.
+    bool m_find_initial_frames;
+    uint32_t m_frame_a;
+    uint32_t m_frame_b;
+
+    uint32_t m_bundle_adjust_interval;
+    uint32_t m_bundle_adjust_window;
+
+    // The number of threads; zero means the default number of
+    // threads.
+    uint32_t m_thread_count;
+
+    // Maya Objects
+    CameraPtr m_camera;
+    Attr m_camera_tx_attr;
+    Attr m_camera_ty_attr;
+    Attr m_camera_tz_attr;
+    Attr m_camera_rx_attr;
+    Attr m_camera_ry_attr;
+    Attr m_camera_rz_attr;
+    MEulerRotation::RotationOrder m_camera_rotate_order;
+
+    MarkerPtrList m_marker_list;
 
     // Frame range
-    uint32_t m_startFrame;
-    uint32_t m_endFrame;
-    MTime m_startTime;
-    MTime m_endTime;
+    uint32_t m_start_frame;
+    uint32_t m_end_frame;
+
+    // Undo/Redo
+    MDGModifier m_dgmod;
+    MAnimCurveChange m_curveChange;
 };
 
 }  // namespace mmsolver
@@ -41,7 +41,31 @@
  *     destinationOutputFormat='iff',
  *     destinationFrameStart=0,
  *     destinationFramePadding=4,
- *     resizeScale=1.0)
+ *     resizeScale=1.0,
+ *     resizeFilter='bilinear',
+ *     threadCount=0)
+ *
+ * Frames are converted in parallel; images are read and written on
+ * the main thread (in frame order), while EXR decoding, resizing and
+ * pixel type conversion happen on a pool of worker threads.
+ *
+ * # Proxy levels
+ *
+ * With the 'proxyLevels' flag, downsampled copies of EXR source
+ * images are written next to the source images, for the
+ * mmImagePlane to read when the plate is small on screen. Level N
+ * is 2^N times smaller, and is written to
+ * "<directory>/proxyN/<file name>". The destination flags are not
+ * used. The 'resizeFilter' flag chooses the filter, as for
+ * converted images.
+ *
+ * maya.cmds.mmConvertImage(
+ *     source='sourceimages/stA/stA.#.exr',
+ *     sourceFrameStart=0,
+ *     sourceFrameEnd=94,
+ *     sourceFramePadding=4,
+ *     proxyLevels=3,
+ *     resizeFilter='box')
  *
  */
 
@@ -49,6 +73,10 @@
 
 // STL
 #include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
 #include <vector>
 
 // Maya
@@ -67,16 +95,14 @@
 #include <maya/MSyntax.h>
 
 // MM Solver
-#include <mmcore/mmmath.h>
+#include <mmimage/mmimage.h>
 
+#include "mmSolver/image/image_pixel_ops.h"
 #include "mmSolver/utilities/debug_utils.h"
-#include "mmSolver/utilities/string_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 namespace mmsolver {
 
-using mmmath::clamp;
-using mmmath::fast_pow;
-
 // For an image sequence the 'file_path' should contain at least one
 // character '#', which will be replaced with the 'frame_number', with
 // a padding width of 'frame_padding'.
@@ -103,20 +129,18 @@ MStatus expand_file_path_with_frame_number(const MString &file_path,
     MString start = file_path.substring(0, first_char - 1);
     MString end = file_path.substring(last_char + 1, file_path.length() - 1);
 
-    std::string number_as_string = mmstring::numberToString(frame_number);
-
-    int extra_zeros =
-        std::max(0, static_cast<int>(frame_padding) -
-                        static_cast<int>(number_as_string.size()));
-    if (extra_zeros > 0) {
-        // Fill the start of the string with zeros, to pad the string
-        // to at least frame_padding characters.
-        number_as_string.insert(0, extra_zeros, '0');
-    }
-    MString number_padded(number_as_string.c_str());
-
-    out_file_path = start + number_padded + end;
-
+    // The characters from the first to the last '#' are replaced with
+    // 'frame_padding' '#' characters, and the frame number is written
+    // by 'mmimage', the same as for all other image sequences.
+    const size_t padding = std::max<size_t>(1, frame_padding);
+    const std::string pattern = std::string(start.asChar()) +
+                                std::string(padding, '#') +
+                                std::string(end.asChar());
+    const rust::String expanded_file_path =
+        mmimage::image_sequence_frame_file_path(
+            rust::Str(pattern), static_cast<int32_t>(frame_number));
+
+    out_file_path = MString(std::string(expanded_file_path).c_str());
     return status;
 }
 
@@ -185,213 +209,360 @@ MStatus guess_file_path_pixel_type(const MString &in_file_path,
     return status;
 }
 
-MStatus resize_image(MImage &image, const double resize_scale) {
-    MStatus status = MStatus::kSuccess;
+// The state of converting one image file.
+//
+// The source image is read and the destination image is written on
+// the main thread (because MImage is not thread-safe), and the pixel
+// processing (and EXR decoding) happens on a worker thread.
+//
+// Pixel rows are stored bottom-to-top, the same as MImage.
+struct ConvertImageTask {
+    MString src_file_path;
+    MString dst_file_path;
 
-    MImage::MPixelType pixel_type = image.pixelType();
-    if (pixel_type != MImage::kByte) {
-        MMSOLVER_MAYA_WRN(
-            "mmConvertImage: "
-            << "Maya does not support resizing floating-point pixels.");
-    }
+    // The task failed before it reached a worker thread.
+    bool failed_to_start;
 
-    uint32_t src_width = 2;
-    uint32_t src_height = 2;
-    status = image.getSize(src_width, src_height);
-    CHECK_MSTATUS_AND_RETURN_IT(status);
+    // EXR files are decoded with 'mmimage' on the worker thread,
+    // otherwise the pixels are read with MImage.
+    bool read_with_mmimage;
 
-    auto dst_width_float = static_cast<double>(src_width) * resize_scale;
-    auto dst_height_float = static_cast<double>(src_height) * resize_scale;
-    auto dst_width = static_cast<uint32_t>(dst_width_float);
-    auto dst_height = static_cast<uint32_t>(dst_height_float);
-    if ((src_width != dst_width) && (src_height != dst_height)) {
-        const auto preserve_aspect_ratio = true;
-
-        // TODO: Replace this with a hand-written resize function. The
-        // MImage.resize() method appears to have a bug whereby the
-        // resized image is offset by +1 pixel in X and Y.
-        //
-        // If we can use Rust, then we have these easily available,
-        // and they appear to do exactly what we need, very quickly:
-        // https://crates.io/crates/fast_image_resize
-        // https://crates.io/crates/resize
-        //
-        // NOTE: MImage.resize() only works on 8-bit images, not
-        // floating point.
-        status = image.resize(dst_width, dst_height, preserve_aspect_ratio);
-        CHECK_MSTATUS_AND_RETURN_IT(status);
+    MImage::MPixelType src_pixel_type;
+    MImage::MPixelType dst_pixel_type;
+    bool is_rgba;
+
+    uint32_t src_width;
+    uint32_t src_height;
+    std::vector<uint8_t> src_byte_pixels;
+    std::vector<float> src_float_pixels;
+
+    uint32_t dst_width;
+    uint32_t dst_height;
+    std::vector<uint8_t> dst_byte_pixels;
+    std::vector<float> dst_float_pixels;
+
+    // Set by the worker thread, and reported on the main thread.
+    bool succeeded;
+    std::string error_message;
+
+    std::future<void> future;
+
+    ConvertImageTask()
+        : failed_to_start(false)
+        , read_with_mmimage(false)
+        , src_pixel_type(MImage::kUnknown)
+        , dst_pixel_type(MImage::kByte)
+        , is_rgba(true)
+        , src_width(0)
+        , src_height(0)
+        , dst_width(0)
+        , dst_height(0)
+        , succeeded(false) {}
+};
+
+MStatus parse_resize_filter(const MString &in_filter_name,
+                            mmimage::ImageResizeFilter &out_filter) {
+    MStatus status = MStatus::kSuccess;
+
+    MString filter_name(in_filter_name);
+    filter_name.toLowerCase();
+
+    if (filter_name == MString("box")) {
+        out_filter = mmimage::ImageResizeFilter::kBox;
+    } else if (filter_name == MString("bilinear")) {
+        out_filter = mmimage::ImageResizeFilter::kBilinear;
+    } else if (filter_name == MString("lanczos")) {
+        out_filter = mmimage::ImageResizeFilter::kLanczos3;
+    } else {
+        status = MS::kFailure;
     }
 
     return status;
 }
 
-MStatus convert_image(const MString &src_file_path,
-                      const MString &dst_file_path,
-                      // Common output formats include: als, bmp, cin,
-                      // gif, jpg, rla, sgi, tga, tif, iff.  "iff" is
-                      // default.
-                      const MString &dst_output_format,
-                      const double resize_scale) {
-    MStatus status = MStatus::kSuccess;
+bool is_exr_file_path(const MString &file_path) {
+    return mmimage::is_exr_file_path(rust::Str(file_path.asChar()));
+}
 
-    if (src_file_path == dst_file_path) {
-        status = MS::kFailure;
-        MMSOLVER_MAYA_ERR("mmConvertImage: "
-                          << "Cannot have source and destination as same path: "
-                          << src_file_path.asChar());
-        CHECK_MSTATUS_AND_RETURN_IT(status);
-    }
+// Read the source image pixels with MImage.
+//
+// Must be run on the main thread.
+MStatus read_image_with_mimage(ConvertImageTask &task) {
+    MStatus status = MStatus::kSuccess;
 
     auto image = MImage();
     // kUnknown attempts to load the native pixel type.
     auto src_pixel_type = MImage::kUnknown;
     status = image.readFromFile(
-        src_file_path,
+        task.src_file_path,
         src_pixel_type  // The desired pixel format is unknown.
     );
     if (status != MS::kSuccess) {
         MMSOLVER_MAYA_ERR("mmConvertImage: "
                           << "Image file path could not be read: "
-                          << src_file_path.asChar());
-        CHECK_MSTATUS_AND_RETURN_IT(status);
+                          << task.src_file_path.asChar());
+        return status;
     }
-    src_pixel_type = image.pixelType();
-    const bool src_is_rgba = image.isRGBA();
+    task.src_pixel_type = image.pixelType();
+    task.is_rgba = image.isRGBA();
+
+    status = image.getSize(task.src_width, task.src_height);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     // Maya always stores 4 channels (according to the
     // documentation).
-    const auto channels = 4;
+    const size_t value_count = static_cast<size_t>(task.src_width) *
+                               task.src_height * image::kRgbaChannelCount;
+    if (task.src_pixel_type == MImage::kByte) {
+        const unsigned char *pixels = image.pixels();
+        task.src_byte_pixels.assign(pixels, pixels + value_count);
+    } else {
+        // This converts the pixels to floating point, if the pixel
+        // type is not already MImage::kFloat.
+        const float *pixels = image.floatPixels();
+        if (pixels == nullptr) {
+            status = MS::kFailure;
+            MMSOLVER_MAYA_ERR("mmConvertImage: "
+                              << "Failed to get floating point pixel data: "
+                              << task.src_file_path.asChar());
+            return status;
+        }
+        task.src_pixel_type = MImage::kFloat;
+        task.src_float_pixels.assign(pixels, pixels + value_count);
+    }
+    return status;
+}
+
+// Decode an EXR image with 'mmimage'. This is thread-safe.
+bool read_image_with_mmimage(ConvertImageTask &task) {
+    auto meta_data = mmimage::ImageMetaData();
+    auto pixel_buffer = mmimage::ImagePixelBuffer();
+    const auto rust_file_path = rust::Str(task.src_file_path.asChar());
+    const bool ok = mmimage::image_read_pixels_exr_f32x4(
+        rust_file_path, meta_data, pixel_buffer);
+    if (!ok) {
+        task.error_message = "Image file path could not be read: ";
+        task.error_message += task.src_file_path.asChar();
+        return false;
+    }
+
+    task.src_pixel_type = MImage::kFloat;
+    task.is_rgba = true;
+    task.src_width = static_cast<uint32_t>(pixel_buffer.image_width());
+    task.src_height = static_cast<uint32_t>(pixel_buffer.image_height());
+
+    const rust::Slice<const mmimage::PixelF32x4> pixels =
+        pixel_buffer.as_slice_f32x4();
+    const auto data = reinterpret_cast<const float *>(pixels.data());
+    task.src_float_pixels.assign(
+        data, data + (pixels.size() * image::kRgbaChannelCount));
+
+    // EXR files are decoded top-to-bottom.
+    const size_t row_byte_count =
+        task.src_width * image::kRgbaChannelCount * sizeof(float);
+    image::flip_rows(task.src_float_pixels.data(), row_byte_count,
+                     task.src_height);
+    return true;
+}
+
+// Decode (if needed), resize and change the pixel type of the
+// image. This is thread-safe.
+//
+// 'gamma_table' is used to convert floating-point images to 8-bit.
+void process_convert_image_task(ConvertImageTask &task,
+                                const double resize_scale,
+                                const mmimage::ImageResizeFilter resize_filter,
+                                const image::GammaTable &gamma_table) {
+    if (task.read_with_mmimage) {
+        if (!read_image_with_mmimage(task)) {
+            return;
+        }
+    }
+
+    // Convert 8-bit to 32-bit floating-point is not supported.
+    if ((task.dst_pixel_type == MImage::kFloat) &&
+        (task.src_pixel_type == MImage::kByte)) {
+        task.error_message = "Cannot convert 8-bit image to floating-point: ";
+        task.error_message += task.src_file_path.asChar();
+        return;
+    }
+
+    const auto dst_width_float =
+        static_cast<double>(task.src_width) * resize_scale;
+    const auto dst_height_float =
+        static_cast<double>(task.src_height) * resize_scale;
+    task.dst_width =
+        std::max<uint32_t>(1, static_cast<uint32_t>(dst_width_float));
+    task.dst_height =
+        std::max<uint32_t>(1, static_cast<uint32_t>(dst_height_float));
+    const bool do_resize = (task.src_width != task.dst_width) ||
+                           (task.src_height != task.dst_height);
+
+    const size_t dst_pixel_count =
+        static_cast<size_t>(task.dst_width) * task.dst_height;
+    if (task.src_pixel_type == MImage::kByte) {
+        // 8-bit to 8-bit.
+        if (!do_resize) {
+            task.dst_byte_pixels.swap(task.src_byte_pixels);
+        } else {
+            const size_t src_pixel_count =
+                static_cast<size_t>(task.src_width) * task.src_height;
+            std::vector<float> float_pixels(src_pixel_count *
+                                            image::kRgbaChannelCount);
+            image::convert_pixels_rgba8_to_rgba32f(task.src_byte_pixels.data(),
+                                                   src_pixel_count,
+                                                   float_pixels.data());
+            std::vector<float> resized_pixels;
+            image::resize_pixels_rgba32f(
+                float_pixels.data(), task.src_width, task.src_height,
+                task.dst_width, task.dst_height, resize_filter,
+                resized_pixels);
+
+            // 8-bit images are not gamma corrected.
+            const image::GammaTable linear_table;
+            task.dst_byte_pixels.resize(dst_pixel_count *
+                                        image::kRgbaChannelCount);
+            image::convert_pixels_rgba32f_to_rgba8(
+                resized_pixels.data(), dst_pixel_count, linear_table,
+                task.dst_byte_pixels.data());
+        }
+    } else {
+        std::vector<float> resized_pixels;
+        if (do_resize) {
+            image::resize_pixels_rgba32f(
+                task.src_float_pixels.data(), task.src_width,
+                task.src_height, task.dst_width, task.dst_height,
+                resize_filter, resized_pixels);
+        } else {
+            resized_pixels.swap(task.src_float_pixels);
+        }
+
+        if (task.dst_pixel_type == MImage::kFloat) {
+            task.dst_float_pixels.swap(resized_pixels);
+        } else {
+            task.dst_byte_pixels.resize(dst_pixel_count *
+                                        image::kRgbaChannelCount);
+            image::convert_pixels_rgba32f_to_rgba8(
+                resized_pixels.data(), dst_pixel_count, gamma_table,
+                task.dst_byte_pixels.data());
+            task.is_rgba = true;
+        }
+    }
+
+    // Release the source pixels as soon as possible, because many
+    // tasks may be waiting to be written.
+    std::vector<uint8_t>().swap(task.src_byte_pixels);
+    std::vector<float>().swap(task.src_float_pixels);
+    task.succeeded = true;
+}
+
+// Write the destination image.
+//
+// Must be run on the main thread.
+MStatus write_image_with_mimage(ConvertImageTask &task,
+                                // Common output formats include: als,
+                                // bmp, cin, gif, jpg, rla, sgi, tga,
+                                // tif, iff.  "iff" is default.
+                                const MString &dst_output_format) {
+    MStatus status = MStatus::kSuccess;
+
+    const auto channels = static_cast<uint32_t>(image::kRgbaChannelCount);
+    MImage out_image;
+    status = out_image.create(task.dst_width, task.dst_height, channels,
+                              task.dst_pixel_type);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (task.dst_pixel_type == MImage::kFloat) {
+        std::copy(task.dst_float_pixels.begin(), task.dst_float_pixels.end(),
+                  out_image.floatPixels());
+    } else {
+        std::copy(task.dst_byte_pixels.begin(), task.dst_byte_pixels.end(),
+                  out_image.pixels());
+    }
+    out_image.setRGBA(task.is_rgba);
+
+    status = out_image.writeToFile(task.dst_file_path, dst_output_format);
+    if (status != MS::kSuccess) {
+        MMSOLVER_MAYA_ERR("mmConvertImage: "
+                          << "Failed to write image file: "
+                          << task.dst_file_path.asChar() << " output format: \""
+                          << dst_output_format.asChar() << "\"");
+    }
+    return status;
+}
+
+// Prepare a task and submit the pixel processing to a worker thread.
+//
+// Must be run on the main thread.
+void start_convert_image_task(ConvertImageTask &task,
+                              const MString &dst_output_format,
+                              const double resize_scale,
+                              const mmimage::ImageResizeFilter resize_filter,
+                              const image::GammaTable &gamma_table,
+                              mmthread::ThreadPool &thread_pool) {
+    MStatus status = MStatus::kSuccess;
+    task.failed_to_start = true;
+
+    if (task.src_file_path == task.dst_file_path) {
+        MMSOLVER_MAYA_ERR("mmConvertImage: "
+                          << "Cannot have source and destination as same path: "
+                          << task.src_file_path.asChar());
+        return;
+    }
 
     // Guess the Pixel Type for the output image.
-    MImage::MPixelType dst_pixel_type;
     MImage::MPixelType format_pixel_type;
     status =
         guess_output_format_pixel_type(dst_output_format, format_pixel_type);
-    CHECK_MSTATUS_AND_RETURN_IT(status);
-    status = guess_file_path_pixel_type(dst_file_path, dst_pixel_type);
-    CHECK_MSTATUS_AND_RETURN_IT(status);
-    if (format_pixel_type != dst_pixel_type) {
+    CHECK_MSTATUS(status);
+    status =
+        guess_file_path_pixel_type(task.dst_file_path, task.dst_pixel_type);
+    CHECK_MSTATUS(status);
+    if (format_pixel_type != task.dst_pixel_type) {
         MMSOLVER_MAYA_WRN(
             "mmConvertImage: "
             << "The destination file extension and output format seem "
                "to contradict each other. file path: "
-            << dst_file_path.asChar() << " output format: \""
+            << task.dst_file_path.asChar() << " output format: \""
             << dst_output_format.asChar() << "\"");
     }
 
-    if (src_pixel_type == dst_pixel_type) {
-        // Try to resize. We can only resize kByte - Maya is limited
-        // with the pixel types it can resize.
-        if (src_pixel_type == MImage::kByte) {
-            status = resize_image(image, resize_scale);
-            if (status != MS::kSuccess) {
-                MMSOLVER_MAYA_ERR("mmConvertImage: "
-                                  << "Failed to resize image file: "
-                                  << src_file_path.asChar());
-                return status;
-            }
-        }
-
-        // No conversion is needed. We write out the 8-bit image
-        // directly.
-        status = image.writeToFile(dst_file_path, dst_output_format);
+    task.read_with_mmimage = is_exr_file_path(task.src_file_path);
+    if (!task.read_with_mmimage) {
+        status = read_image_with_mimage(task);
         if (status != MS::kSuccess) {
-            MMSOLVER_MAYA_ERR("mmConvertImage: "
-                              << "Failed to write image file: "
-                              << dst_file_path.asChar() << " output format: \""
-                              << dst_output_format.asChar() << "\"");
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-        }
-    } else {
-        // Convert 32-bit to 8-bit integer. We assume the image
-        // has not been resized yet.
-        if (image.pixelType() == MImage::kByte) {
-            status = MS::kFailure;
-            MMSOLVER_MAYA_ERR("mmConvertImage: "
-                              << "Failed to write image file: "
-                              << dst_file_path.asChar() << " output format: \""
-                              << dst_output_format.asChar() << "\"");
-            return status;
-        }
-
-        // Do gamma correction before converting.
-        uint32_t image_width = 2;
-        uint32_t image_height = 2;
-        status = image.getSize(image_width, image_height);
-        CHECK_MSTATUS_AND_RETURN_IT(status);
-
-        // Get exponent based on if we are converting to/from floating
-        // point or not. Make (linear color space) pixels brighter.
-        const float gamma = 2.2F;
-        float exponent = 1.0F / gamma;
-
-        // TODO: Use the Autodesk 'synColor' library to change the
-        // color space for an 8-bit file format. This library is
-        // available in the Maya devkit.
-        //
-        // https://forums.autodesk.com/t5/maya-programming/how-to-export-colors-with-correct-color-management/td-p/10515406
-
-        // Make sure we do our color management with floating point
-        // numbers, to avoid loss of detail. This does not do anything
-        // if the pixel format is already MImage::kFloat.
-        float *float_pixels = image.floatPixels();
-        if (float_pixels == nullptr) {
-            // The data pointer should be valid because we have
-            // already read and operated on the pixels, so it seems
-            // very wrong that the data wouldn't be valid.
-            status = MS::kFailure;
-            MMSOLVER_MAYA_ERR("mmConvertImage: "
-                              << "Failed to get floating point pixel data: "
-                              << src_file_path.asChar());
-            return status;
+            return;
         }
+    }
 
-        MImage out_image;
-        out_image.create(image_width, image_height, channels, MImage::kByte);
-        unsigned char *pixels = out_image.pixels();
-
-        // Apply gamma correction.
-        for (auto y = 0; y < image_height; ++y) {
-            for (auto x = 0; x < image_width; ++x) {
-                auto index = (y * image_width * channels) + (x * channels);
-                auto r =
-                    clamp(fast_pow(float_pixels[index + 0], exponent) * 255.0F,
-                          0.0, 255.0);
-                auto g =
-                    clamp(fast_pow(float_pixels[index + 1], exponent) * 255.0F,
-                          0.0, 255.0);
-                auto b =
-                    clamp(fast_pow(float_pixels[index + 2], exponent) * 255.0F,
-                          0.0, 255.0);
-                auto a = clamp(float_pixels[index + 3] * 255.0F, 0.0, 255.0);
-                pixels[index + 0] = static_cast<unsigned char>(r);
-                pixels[index + 1] = static_cast<unsigned char>(g);
-                pixels[index + 2] = static_cast<unsigned char>(b);
-                // Alpha does not need to be gamma corrected.
-                pixels[index + 3] = static_cast<unsigned char>(a);
-            }
-        }
-        out_image.setRGBA(true);
+    task.failed_to_start = false;
+    ConvertImageTask *task_ptr = &task;
+    const image::GammaTable *gamma_table_ptr = &gamma_table;
+    task.future = thread_pool.submit(
+        [task_ptr, resize_scale, resize_filter, gamma_table_ptr]() {
+            process_convert_image_task(*task_ptr, resize_scale, resize_filter,
+                                       *gamma_table_ptr);
+        });
+}
 
-        // Try to resize. We can only resize kByte - Maya is
-        // limited with the pixel types it can resize.
-        status = resize_image(out_image, resize_scale);
-        if (status != MS::kSuccess) {
-            MMSOLVER_MAYA_ERR("mmConvertImage: "
-                              << "Failed to resize image file: "
-                              << src_file_path.asChar());
-            return status;
-        }
+// Wait for the task to be processed, then write the image.
+//
+// Must be run on the main thread.
+MStatus finish_convert_image_task(ConvertImageTask &task,
+                                  const MString &dst_output_format) {
+    MStatus status = MStatus::kSuccess;
+    if (task.failed_to_start) {
+        status = MS::kFailure;
+        return status;
+    }
 
-        status = out_image.writeToFile(dst_file_path, dst_output_format);
-        if (status != MS::kSuccess) {
-            MMSOLVER_MAYA_ERR("mmConvertImage: "
-                              << "Failed to write image file: "
-                              << dst_file_path.asChar() << " output format: \""
-                              << dst_output_format.asChar() << "\"");
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-        }
+    task.future.wait();
+    if (!task.succeeded) {
+        status = MS::kFailure;
+        MMSOLVER_MAYA_ERR("mmConvertImage: " << task.error_message);
+        return status;
     }
+
+    status = write_image_with_mimage(task, dst_output_format);
     return status;
 }
 
@@ -441,6 +612,13 @@ MSyntax MMConvertImageCmd::newSyntax() {
 
     syntax.addFlag(RESIZE_SCALE_FLAG, RESIZE_SCALE_FLAG_LONG, MSyntax::kDouble);
 
+    syntax.addFlag(RESIZE_FILTER_FLAG, RESIZE_FILTER_FLAG_LONG,
+                   MSyntax::kString);
+
+    syntax.addFlag(THREAD_COUNT_FLAG, THREAD_COUNT_FLAG_LONG, MSyntax::kLong);
+
+    syntax.addFlag(PROXY_LEVELS_FLAG, PROXY_LEVELS_FLAG_LONG, MSyntax::kLong);
+
     return syntax;
 }
 
@@ -460,8 +638,29 @@ MStatus MMConvertImageCmd::parseArgs(const MArgList &args) {
         return status;
     }
 
+    bool is_set_proxy_levels = argData.isFlagSet(PROXY_LEVELS_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (is_set_proxy_levels) {
+        int proxy_level_count = 0;
+        status =
+            argData.getFlagArgument(PROXY_LEVELS_FLAG, 0, proxy_level_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        if ((proxy_level_count < 1) || (proxy_level_count > 8)) {
+            status = MStatus::kFailure;
+            MMSOLVER_MAYA_ERR("Proxy levels argument (\""
+                              << PROXY_LEVELS_FLAG_LONG << "\" flag) value "
+                              << proxy_level_count
+                              << " is not valid, expected 1 to 8.");
+            return status;
+        }
+        m_proxy_level_count = static_cast<uint32_t>(proxy_level_count);
+    }
+
     status = argData.getFlagArgument(DST_FILE_PATH_FLAG, 0, m_dst_file_path);
-    if (status != MStatus::kSuccess) {
+    if ((status != MStatus::kSuccess) && (m_proxy_level_count > 0)) {
+        // The destination is not needed to write proxy levels.
+        status = MStatus::kSuccess;
+    } else if (status != MStatus::kSuccess) {
         MMSOLVER_MAYA_ERR("Required destination file path argument (\""
                           << DST_FILE_PATH_FLAG_LONG << "\" flag) is missing.");
         return status;
@@ -493,6 +692,12 @@ MStatus MMConvertImageCmd::parseArgs(const MArgList &args) {
     bool is_set_resize_scale = argData.isFlagSet(RESIZE_SCALE_FLAG, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
+    bool is_set_resize_filter = argData.isFlagSet(RESIZE_FILTER_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    bool is_set_thread_count = argData.isFlagSet(THREAD_COUNT_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
     if (is_set_dst_output_format) {
         status = argData.getFlagArgument(DST_OUTPUT_FORMAT_FLAG, 0,
                                          m_dst_output_format);
@@ -541,6 +746,126 @@ MStatus MMConvertImageCmd::parseArgs(const MArgList &args) {
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
 
+    if (is_set_resize_filter) {
+        MString resize_filter_name;
+        status = argData.getFlagArgument(RESIZE_FILTER_FLAG, 0,
+                                         resize_filter_name);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = parse_resize_filter(resize_filter_name, m_resize_filter);
+        if (status != MStatus::kSuccess) {
+            MMSOLVER_MAYA_ERR("Resize filter argument (\""
+                              << RESIZE_FILTER_FLAG_LONG << "\" flag) value \""
+                              << resize_filter_name.asChar()
+                              << "\" is not valid, expected \"box\", "
+                                 "\"bilinear\" or \"lanczos\".");
+            return status;
+        }
+    }
+
+    if (is_set_thread_count) {
+        int thread_count = 0;
+        status = argData.getFlagArgument(THREAD_COUNT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
+
+    return status;
+}
+
+// Write the proxy levels of each source frame, with one frame per
+// worker thread.
+MStatus MMConvertImageCmd::writeProxyLevels() {
+    MStatus status = MStatus::kSuccess;
+
+    auto src_file_object = MFileObject();
+    MString src_file_path;
+
+    const auto exr_encoder = mmimage::ImageExrEncoder{
+        mmimage::ExrCompression::kZIP1,
+        mmimage::ExrPixelLayout{mmimage::ExrPixelLayoutMode::kScanLines, 0,
+                                0},
+        mmimage::ExrLineOrder::kIncreasing,
+    };
+    const mmimage::ImageResizeFilter filter = m_resize_filter;
+    const auto level_count = static_cast<uint8_t>(m_proxy_level_count);
+
+    struct ProxyTask {
+        std::string file_path;
+        uint8_t levels_written;
+        std::future<void> future;
+    };
+
+    // The thread pool must be destroyed (waiting for the workers to
+    // finish) before the tasks are destroyed.
+    std::deque<std::unique_ptr<ProxyTask>> tasks;
+
+    const size_t thread_count = (m_thread_count > 0)
+                                    ? static_cast<size_t>(m_thread_count)
+                                    : mmthread::defaultThreadCount();
+    mmthread::ThreadPool thread_pool(thread_count);
+
+    auto total_count = 0;
+    auto fail_count = 0;
+    for (auto src_frame = m_src_frame_start; src_frame < (m_src_frame_end + 1);
+         ++src_frame) {
+        total_count += 1;
+
+        status = expand_file_path_with_frame_number(
+            m_src_file_path, m_src_frame_padding, src_frame, src_file_path);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        src_file_object.setRawFullName(src_file_path);
+        src_file_object.setResolveMethod(MFileObject::kInputFile);
+        status = find_existing_file_path(src_file_object, src_file_path,
+                                         src_file_path);
+        if ((status != MS::kSuccess) || !is_exr_file_path(src_file_path)) {
+            MMSOLVER_MAYA_WRN("mmConvertImage: "
+                              << "Cannot write proxy levels for "
+                              << "\"" << src_file_path.asChar()
+                              << "\", only existing EXR files are supported.");
+            fail_count += 1;
+            continue;
+        }
+
+        std::unique_ptr<ProxyTask> task(new ProxyTask());
+        task->file_path = src_file_path.asChar();
+        task->levels_written = 0;
+        ProxyTask *task_ptr = task.get();
+        task->future = thread_pool.submit(
+            [task_ptr, exr_encoder, filter, level_count]() {
+                const auto rust_file_path =
+                    rust::Str(task_ptr->file_path.c_str());
+                task_ptr->levels_written =
+                    mmimage::image_write_proxy_levels_exr(
+                        rust_file_path, exr_encoder, filter, level_count);
+            });
+        tasks.push_back(std::move(task));
+    }
+
+    for (std::unique_ptr<ProxyTask> &task : tasks) {
+        task->future.wait();
+        if (task->levels_written == 0) {
+            MMSOLVER_MAYA_WRN("mmConvertImage: "
+                              << "Failed to write proxy levels for "
+                              << "\"" << task->file_path << "\".");
+            fail_count += 1;
+        } else {
+            MMSOLVER_MAYA_INFO("mmConvertImage: "
+                               << "Wrote "
+                               << static_cast<int>(task->levels_written)
+                               << " proxy levels for "
+                               << "\"" << task->file_path << "\".");
+        }
+    }
+
+    status = MS::kSuccess;
+    MMConvertImageCmd::setResult(fail_count == 0);
+    if (fail_count > 0) {
+        MMSOLVER_MAYA_WRN("mmConvertImage: "
+                          << "Some proxy levels failed to write:"
+                          << " total=" << total_count
+                          << " failed=" << fail_count);
+    }
     return status;
 }
 
@@ -551,15 +876,70 @@ MStatus MMConvertImageCmd::doIt(const MArgList &args) {
     status = parseArgs(args);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
+    if (m_proxy_level_count > 0) {
+        return writeProxyLevels();
+    }
+
     auto src_file_object = MFileObject();
     auto dst_file_object = MFileObject();
 
     MString src_file_path;
     MString dst_file_path;
 
+    // Make (linear color space) pixels brighter, when converting
+    // floating-point images to 8-bit. The table is built once and
+    // shared by all tasks.
+    //
+    // TODO: Use the Autodesk 'synColor' library to change the
+    // color space for an 8-bit file format. This library is
+    // available in the Maya devkit.
+    //
+    // https://forums.autodesk.com/t5/maya-programming/how-to-export-colors-with-correct-color-management/td-p/10515406
+    const float gamma = 2.2F;
+    image::GammaTable gamma_table;
+    image::build_gamma_table(1.0F / gamma, gamma_table);
+
+    // The thread pool must be destroyed (waiting for the workers to
+    // finish) before the tasks (and the gamma table) are destroyed.
+    std::deque<std::unique_ptr<ConvertImageTask>> tasks;
+
+    // A value of zero means "use all the hardware threads".
+    const size_t thread_count = (m_thread_count > 0)
+                                    ? static_cast<size_t>(m_thread_count)
+                                    : mmthread::defaultThreadCount();
+    mmthread::ThreadPool thread_pool(thread_count);
+
+    // Limit the number of tasks waiting to be written, so that the
+    // images do not all need to be held in memory at once.
+    const size_t max_tasks_in_flight = thread_count * 2;
+
     auto total_count = 0;
     auto succeeded_count = 0;
     auto fail_count = 0;
+
+    // Images are written, and results reported, in frame order.
+    auto finish_oldest_task = [&]() {
+        ConvertImageTask &task = *tasks.front();
+        MStatus task_status =
+            finish_convert_image_task(task, m_dst_output_format);
+        if (task_status != MS::kSuccess) {
+            MMSOLVER_MAYA_WRN("mmConvertImage: "
+                              << "Failed to convert image: "
+                              << "\"" << task.src_file_path.asChar()
+                              << "\" to \"" << task.dst_file_path.asChar()
+                              << "\".");
+            fail_count += 1;
+        } else {
+            MMSOLVER_MAYA_INFO("mmConvertImage: "
+                               << "Converted "
+                               << "\"" << task.src_file_path.asChar()
+                               << "\" to \"" << task.dst_file_path.asChar()
+                               << "\".");
+            succeeded_count += 1;
+        }
+        tasks.pop_front();
+    };
+
     for (auto src_frame = m_src_frame_start, dst_frame = m_dst_frame_start;
          src_frame < (m_src_frame_end + 1); ++src_frame, ++dst_frame) {
         total_count += 1;
@@ -572,53 +952,47 @@ MStatus MMConvertImageCmd::doIt(const MArgList &args) {
             m_dst_file_path, m_dst_frame_padding, dst_frame, dst_file_path);
         CHECK_MSTATUS_AND_RETURN_IT(status);
 
+        // Paths that fail to resolve are added as failed tasks, so
+        // the results are still reported in frame order.
+        std::unique_ptr<ConvertImageTask> task(new ConvertImageTask());
+        task->failed_to_start = true;
+
         src_file_object.setRawFullName(src_file_path);
         src_file_object.setResolveMethod(MFileObject::kInputFile);
         status = find_existing_file_path(src_file_object, src_file_path,
                                          src_file_path);
+        dst_file_object.setRawFullName(dst_file_path);
+        dst_file_object.setResolveMethod(MFileObject::kNone);
+        MStatus dst_status = find_file_path(dst_file_object, dst_file_path);
+
+        task->src_file_path = src_file_path;
+        task->dst_file_path = dst_file_path;
         if (status != MS::kSuccess) {
             MMSOLVER_MAYA_WRN("mmConvertImage: "
                               << "Failed to resolve source file path: "
                               << "\"" << src_file_path.asChar() << "\"");
-            fail_count += 1;
-            continue;
-        }
-
-        dst_file_object.setRawFullName(dst_file_path);
-        dst_file_object.setResolveMethod(MFileObject::kNone);
-        status = find_file_path(dst_file_object, dst_file_path);
-        if (status != MS::kSuccess) {
+        } else if (dst_status != MS::kSuccess) {
             MMSOLVER_MAYA_WRN("mmConvertImage: "
                               << "Failed to resolve destination file path: "
                               << "\"" << dst_file_path.asChar() << "\"");
-            fail_count += 1;
-            continue;
-        }
-
-        if ((src_file_path.length() == 0) || (dst_file_path.length() == 0)) {
+        } else if ((src_file_path.length() == 0) ||
+                   (dst_file_path.length() == 0)) {
             MMSOLVER_MAYA_WRN("mmConvertImage: Failed to resolve file paths "
                               << "\"" << src_file_path.asChar() << "\" to \""
                               << dst_file_path.asChar() << "\".");
-            fail_count += 1;
-            continue;
+        } else {
+            start_convert_image_task(*task, m_dst_output_format,
+                                     m_resize_scale, m_resize_filter,
+                                     gamma_table, thread_pool);
         }
 
-        status = convert_image(src_file_path, dst_file_path,
-                               m_dst_output_format, m_resize_scale);
-        if (status != MS::kSuccess) {
-            MMSOLVER_MAYA_WRN("mmConvertImage: "
-                              << "Failed to convert image: "
-                              << "\"" << src_file_path.asChar() << "\" to \""
-                              << dst_file_path.asChar() << "\".");
-            fail_count += 1;
-            continue;
+        tasks.push_back(std::move(task));
+        while (tasks.size() >= max_tasks_in_flight) {
+            finish_oldest_task();
         }
-
-        MMSOLVER_MAYA_INFO("mmConvertImage: "
-                           << "Converted "
-                           << "\"" << src_file_path.asChar() << "\" to \""
-                           << dst_file_path.asChar() << "\".");
-        succeeded_count += 1;
+    }
+    while (!tasks.empty()) {
+        finish_oldest_task();
     }
 
     status = MS::kSuccess;
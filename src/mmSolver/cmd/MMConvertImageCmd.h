@@ -33,6 +33,9 @@
 #include <maya/MString.h>
 #include <maya/MSyntax.h>
 
+// MM Solver
+#include "mmSolver/image/image_pixel_ops.h"
+
 // Command arguments and command name:
 #define SRC_FILE_PATH_FLAG "-src"
 #define SRC_FILE_PATH_FLAG_LONG "-source"
@@ -61,6 +64,15 @@
 #define RESIZE_SCALE_FLAG "-rzs"
 #define RESIZE_SCALE_FLAG_LONG "-resizeScale"
 
+#define RESIZE_FILTER_FLAG "-rzf"
+#define RESIZE_FILTER_FLAG_LONG "-resizeFilter"
+
+#define THREAD_COUNT_FLAG "-tc"
+#define THREAD_COUNT_FLAG_LONG "-threadCount"
+
+#define PROXY_LEVELS_FLAG "-pxl"
+#define PROXY_LEVELS_FLAG_LONG "-proxyLevels"
+
 namespace mmsolver {
 
 class MMConvertImageCmd : public MPxCommand {
@@ -74,7 +86,10 @@ public:
         , m_dst_frame_start(1)
         , m_src_frame_padding(1)
         , m_dst_frame_padding(1)
-        , m_resize_scale(1.0F){};
+        , m_resize_scale(1.0F)
+        , m_resize_filter(mmimage::ImageResizeFilter::kBilinear)
+        , m_thread_count(0)
+        , m_proxy_level_count(0){};
 
     virtual ~MMConvertImageCmd();
 
@@ -91,6 +106,7 @@ public:
 
 private:
     MStatus parseArgs(const MArgList &args);
+    MStatus writeProxyLevels();
 
     MString m_src_file_path;
     MString m_dst_file_path;
@@ -105,6 +121,14 @@ private:
     uint32_t m_dst_frame_padding;
 
     double m_resize_scale;
+    mmimage::ImageResizeFilter m_resize_filter;
+
+    // Zero means use all hardware threads.
+    uint32_t m_thread_count;
+
+    // When more than zero, proxy levels of the source EXR images are
+    // written, instead of converting the images.
+    uint32_t m_proxy_level_count;
 };
 
 }  // namespace mmsolver
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Command for running mmImageCache.
+ *
+ * Query and change the image sequence cache used by the
+ * mmImagePlane.
+ *
+ * MEL:
+ *     // Query statistics.
+ *     mmImageCache -query -hitRate;
+ *     mmImageCache -query -decodeTime;  // Milliseconds per image.
+ *     mmImageCache -query -bytesResident;
+ *
+ *     // Query how often the image plane mesh is reused, rather
+ *     // than being deformed by the lens again.
+ *     mmImageCache -query -meshHitCount;
+ *     mmImageCache -query -meshMissCount;
+ *
+ *     // Change the cache size (in megabytes) and thread count.
+ *     mmImageCache -edit -memoryBudget 4096;
+ *     mmImageCache -edit -threadCount 4;
+ *
+ *     // Remove all images and reset statistics.
+ *     mmImageCache -clear -resetStatistics;
+ */
+
+#include "MMImageCacheCmd.h"
+
+// STL
+#include <cmath>
+
+// Maya
+#include <maya/MArgDatabase.h>
+#include <maya/MArgList.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+// MM Solver
+#include "mmSolver/image/image_cache.h"
+#include "mmSolver/shape/ImagePlaneMeshCache.h"
+#include "mmSolver/utilities/debug_utils.h"
+
+namespace mmsolver {
+
+const double kBytesPerMegabyte = 1024.0 * 1024.0;
+
+MMImageCacheCmd::~MMImageCacheCmd() {}
+
+void *MMImageCacheCmd::creator() { return new MMImageCacheCmd(); }
+
+MString MMImageCacheCmd::cmdName() { return MString("mmImageCache"); }
+
+/*
+ * Tell Maya we have a syntax function.
+ */
+bool MMImageCacheCmd::hasSyntax() const { return true; }
+
+bool MMImageCacheCmd::isUndoable() const { return false; }
+
+/*
+ * Add flags to the command syntax
+ */
+MSyntax MMImageCacheCmd::newSyntax() {
+    MSyntax syntax;
+    syntax.enableQuery(true);
+    syntax.enableEdit(true);
+
+    syntax.addFlag(MEMORY_BUDGET_FLAG, MEMORY_BUDGET_FLAG_LONG,
+                   MSyntax::kDouble);
+    syntax.addFlag(THREAD_COUNT_FLAG, THREAD_COUNT_FLAG_LONG,
+                   MSyntax::kUnsigned);
+    syntax.addFlag(CLEAR_FLAG, CLEAR_FLAG_LONG);
+    syntax.addFlag(RESET_STATISTICS_FLAG, RESET_STATISTICS_FLAG_LONG);
+
+    syntax.addFlag(HIT_COUNT_FLAG, HIT_COUNT_FLAG_LONG, MSyntax::kBoolean);
+    syntax.addFlag(MISS_COUNT_FLAG, MISS_COUNT_FLAG_LONG, MSyntax::kBoolean);
+    syntax.addFlag(HIT_RATE_FLAG, HIT_RATE_FLAG_LONG, MSyntax::kBoolean);
+    syntax.addFlag(DECODE_COUNT_FLAG, DECODE_COUNT_FLAG_LONG,
+                   MSyntax::kBoolean);
+    syntax.addFlag(DECODE_TIME_FLAG, DECODE_TIME_FLAG_LONG, MSyntax::kBoolean);
+    syntax.addFlag(BYTES_RESIDENT_FLAG, BYTES_RESIDENT_FLAG_LONG,
+                   MSyntax::kBoolean);
+    syntax.addFlag(ITEM_COUNT_FLAG, ITEM_COUNT_FLAG_LONG, MSyntax::kBoolean);
+    syntax.addFlag(PENDING_COUNT_FLAG, PENDING_COUNT_FLAG_LONG,
+                   MSyntax::kBoolean);
+    syntax.addFlag(MESH_HIT_COUNT_FLAG, MESH_HIT_COUNT_FLAG_LONG,
+                   MSyntax::kBoolean);
+    syntax.addFlag(MESH_MISS_COUNT_FLAG, MESH_MISS_COUNT_FLAG_LONG,
+                   MSyntax::kBoolean);
+    return syntax;
+}
+
+/*
+ * Parse command line arguments
+ */
+MStatus MMImageCacheCmd::parseArgs(const MArgList &args) {
+    MStatus status = MStatus::kSuccess;
+
+    MArgDatabase argData(syntax(), args, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const bool query = argData.isQuery(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const bool edit = argData.isEdit(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    m_clear = argData.isFlagSet(CLEAR_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    m_reset_statistics = argData.isFlagSet(RESET_STATISTICS_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const bool memory_budget = argData.isFlagSet(MEMORY_BUDGET_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const bool thread_count = argData.isFlagSet(THREAD_COUNT_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (query) {
+        struct QueryFlag {
+            const char *flag;
+            ImageCacheQuery query;
+        };
+        const QueryFlag query_flags[] = {
+            {MEMORY_BUDGET_FLAG, ImageCacheQuery::kMemoryBudget},
+            {THREAD_COUNT_FLAG, ImageCacheQuery::kThreadCount},
+            {HIT_COUNT_FLAG, ImageCacheQuery::kHitCount},
+            {MISS_COUNT_FLAG, ImageCacheQuery::kMissCount},
+            {HIT_RATE_FLAG, ImageCacheQuery::kHitRate},
+            {DECODE_COUNT_FLAG, ImageCacheQuery::kDecodeCount},
+            {DECODE_TIME_FLAG, ImageCacheQuery::kDecodeTime},
+            {BYTES_RESIDENT_FLAG, ImageCacheQuery::kBytesResident},
+            {ITEM_COUNT_FLAG, ImageCacheQuery::kItemCount},
+            {PENDING_COUNT_FLAG, ImageCacheQuery::kPendingCount},
+            {MESH_HIT_COUNT_FLAG, ImageCacheQuery::kMeshHitCount},
+            {MESH_MISS_COUNT_FLAG, ImageCacheQuery::kMeshMissCount},
+        };
+
+        m_query = ImageCacheQuery::kNone;
+        for (const QueryFlag &query_flag : query_flags) {
+            if (!argData.isFlagSet(query_flag.flag, &status)) {
+                continue;
+            }
+            if (m_query != ImageCacheQuery::kNone) {
+                status = MStatus::kFailure;
+                status.perror(
+                    "mmImageCache: Only one flag may be queried at once.");
+                return status;
+            }
+            m_query = query_flag.query;
+        }
+        if (m_query == ImageCacheQuery::kNone) {
+            status = MStatus::kFailure;
+            status.perror("mmImageCache: No flag was given to query.");
+            return status;
+        }
+        return status;
+    }
+
+    if ((memory_budget || thread_count) && !edit) {
+        status = MStatus::kFailure;
+        status.perror(
+            "mmImageCache: The 'memoryBudget' and 'threadCount' flags must "
+            "be used with the 'query' or 'edit' flag.");
+        return status;
+    }
+
+    m_set_memory_budget = memory_budget;
+    if (m_set_memory_budget) {
+        status = argData.getFlagArgument(MEMORY_BUDGET_FLAG, 0,
+                                         m_memory_budget_megabytes);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        if (m_memory_budget_megabytes < 0.0) {
+            status = MStatus::kFailure;
+            status.perror("mmImageCache: 'memoryBudget' must not be negative.");
+            return status;
+        }
+    }
+
+    m_set_thread_count = thread_count;
+    if (m_set_thread_count) {
+        status = argData.getFlagArgument(THREAD_COUNT_FLAG, 0, m_thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    return status;
+}
+
+MStatus MMImageCacheCmd::doIt(const MArgList &args) {
+    MStatus status = MStatus::kSuccess;
+
+    // Read all the flag arguments.
+    status = parseArgs(args);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (m_query != ImageCacheQuery::kNone) {
+        const image::ImageCacheStatistics statistics =
+            image::image_cache_statistics();
+        const ImagePlaneMeshCacheStatistics mesh_statistics =
+            ImagePlaneMeshCache::statistics();
+
+        double value = 0.0;
+        switch (m_query) {
+            case ImageCacheQuery::kMemoryBudget:
+                value = static_cast<double>(statistics.memory_budget_bytes) /
+                        kBytesPerMegabyte;
+                break;
+            case ImageCacheQuery::kThreadCount:
+                value = static_cast<double>(statistics.thread_count);
+                break;
+            case ImageCacheQuery::kHitCount:
+                value = static_cast<double>(statistics.hit_count);
+                break;
+            case ImageCacheQuery::kMissCount:
+                value = static_cast<double>(statistics.miss_count);
+                break;
+            case ImageCacheQuery::kHitRate:
+                value = statistics.hit_rate();
+                break;
+            case ImageCacheQuery::kDecodeCount:
+                value = static_cast<double>(statistics.decode_count);
+                break;
+            case ImageCacheQuery::kDecodeTime:
+                value = statistics.mean_decode_seconds() * 1000.0;
+                break;
+            case ImageCacheQuery::kBytesResident:
+                // Returned as a double, because an 'int' can only
+                // hold 2 GigaBytes.
+                value = static_cast<double>(statistics.bytes_resident);
+                break;
+            case ImageCacheQuery::kItemCount:
+                value = static_cast<double>(statistics.item_count);
+                break;
+            case ImageCacheQuery::kPendingCount:
+                value = static_cast<double>(statistics.pending_count);
+                break;
+            case ImageCacheQuery::kMeshHitCount:
+                value = static_cast<double>(mesh_statistics.hit_count);
+                break;
+            case ImageCacheQuery::kMeshMissCount:
+                value = static_cast<double>(mesh_statistics.miss_count);
+                break;
+            default:
+                break;
+        }
+        MMImageCacheCmd::setResult(value);
+        return status;
+    }
+
+    if (m_clear) {
+        image::image_cache_clear();
+    }
+    if (m_reset_statistics) {
+        image::image_cache_reset_statistics();
+        ImagePlaneMeshCache::resetStatistics();
+    }
+    if (m_set_memory_budget) {
+        const auto memory_budget_bytes = static_cast<size_t>(
+            std::round(m_memory_budget_megabytes * kBytesPerMegabyte));
+        image::image_cache_set_memory_budget(memory_budget_bytes);
+    }
+    if (m_set_thread_count) {
+        image::image_cache_set_thread_count(m_thread_count);
+    }
+    return status;
+}
+
+}  // namespace mmsolver
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Header for mmImageCache Maya command.
+ */
+
+#ifndef MAYA_MM_IMAGE_CACHE_CMD_H
+#define MAYA_MM_IMAGE_CACHE_CMD_H
+
+// STL
+#include <cstdint>
+
+// Maya
+#include <maya/MArgDatabase.h>
+#include <maya/MArgList.h>
+#include <maya/MGlobal.h>
+#include <maya/MIOStream.h>
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+// Command arguments and command name:
+#define MEMORY_BUDGET_FLAG "-mb"
+#define MEMORY_BUDGET_FLAG_LONG "-memoryBudget"
+
+#define THREAD_COUNT_FLAG "-tc"
+#define THREAD_COUNT_FLAG_LONG "-threadCount"
+
+#define CLEAR_FLAG "-clr"
+#define CLEAR_FLAG_LONG "-clear"
+
+#define RESET_STATISTICS_FLAG "-rst"
+#define RESET_STATISTICS_FLAG_LONG "-resetStatistics"
+
+#define HIT_COUNT_FLAG "-hc"
+#define HIT_COUNT_FLAG_LONG "-hitCount"
+
+#define MISS_COUNT_FLAG "-mc"
+#define MISS_COUNT_FLAG_LONG "-missCount"
+
+#define HIT_RATE_FLAG "-hr"
+#define HIT_RATE_FLAG_LONG "-hitRate"
+
+#define DECODE_COUNT_FLAG "-dc"
+#define DECODE_COUNT_FLAG_LONG "-decodeCount"
+
+#define DECODE_TIME_FLAG "-dt"
+#define DECODE_TIME_FLAG_LONG "-decodeTime"
+
+#define BYTES_RESIDENT_FLAG "-br"
+#define BYTES_RESIDENT_FLAG_LONG "-bytesResident"
+
+#define ITEM_COUNT_FLAG "-ic"
+#define ITEM_COUNT_FLAG_LONG "-itemCount"
+
+#define PENDING_COUNT_FLAG "-pc"
+#define PENDING_COUNT_FLAG_LONG "-pendingCount"
+
+#define MESH_HIT_COUNT_FLAG "-mhc"
+#define MESH_HIT_COUNT_FLAG_LONG "-meshHitCount"
+
+#define MESH_MISS_COUNT_FLAG "-mmc"
+#define MESH_MISS_COUNT_FLAG_LONG "-meshMissCount"
+
+namespace mmsolver {
+
+// The value to be queried by the command.
+enum class ImageCacheQuery : uint8_t {
+    kNone = 0,
+    kMemoryBudget,
+    kThreadCount,
+    kHitCount,
+    kMissCount,
+    kHitRate,
+    kDecodeCount,
+    kDecodeTime,
+    kBytesResident,
+    kItemCount,
+    kPendingCount,
+    kMeshHitCount,
+    kMeshMissCount,
+};
+
+class MMImageCacheCmd : public MPxCommand {
+public:
+    MMImageCacheCmd()
+        : m_query(ImageCacheQuery::kNone)
+        , m_set_memory_budget(false)
+        , m_memory_budget_megabytes(0.0)
+        , m_set_thread_count(false)
+        , m_thread_count(0)
+        , m_clear(false)
+        , m_reset_statistics(false){};
+
+    virtual ~MMImageCacheCmd();
+
+    virtual bool hasSyntax() const;
+    static MSyntax newSyntax();
+
+    virtual MStatus doIt(const MArgList &args);
+
+    virtual bool isUndoable() const;
+
+    static void *creator();
+
+    static MString cmdName();
+
+private:
+    MStatus parseArgs(const MArgList &args);
+
+    ImageCacheQuery m_query;
+    bool m_set_memory_budget;
+    double m_memory_budget_megabytes;
+    bool m_set_thread_count;
+    uint32_t m_thread_count;
+    bool m_clear;
+    bool m_reset_statistics;
+};
+
+}  // namespace mmsolver
+
+#endif  // MAYA_MM_IMAGE_CACHE_CMD_H
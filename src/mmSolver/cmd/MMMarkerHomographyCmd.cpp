@@ -312,47 +312,30 @@ MStatus MMMarkerHomographyCmd::parseArgs(const MArgList &args) {
         marker_b->setNodeName(markerNameB);
         marker_b->setCamera(m_camera_b);
 
-        std::shared_ptr<mmlens::LensModel> lensModel_a;
-        std::shared_ptr<mmlens::LensModel> lensModel_b;
-        {
-            MarkerPtrList markerList;
-            markerList.push_back(marker_a);
-            markerList.push_back(marker_b);
-
-            CameraPtrList cameraList;
-            cameraList.push_back(m_camera_a);
-            cameraList.push_back(m_camera_b);
-
-            AttrPtrList attrList;
-
-            MTimeArray frameList;
-            frameList.append(m_time_a);
-            frameList.append(m_time_b);
-
-            std::vector<std::shared_ptr<mmlens::LensModel>>
-                markerFrameToLensModelList;
-            std::vector<std::shared_ptr<mmlens::LensModel>>
-                attrFrameToLensModelList;
-            std::vector<std::shared_ptr<mmlens::LensModel>> lensModelList;
-
-            status = mmsolver::constructLensModelList(
-                cameraList, markerList, attrList, frameList,
-                markerFrameToLensModelList, attrFrameToLensModelList,
-                lensModelList);
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-
-            lensModel_a = markerFrameToLensModelList[0];
-            lensModel_b = markerFrameToLensModelList[1];
-        }
+        m_marker_list_a.push_back(marker_a);
+        m_marker_list_b.push_back(marker_b);
+    }
+
+    // Read the marker positions of all pairs at once, keeping only the
+    // pairs valid on both frames.
+    {
+        std::vector<uint8_t> pair_valid;
+        status = ::mmsolver::sfm::gather_marker_pairs(
+            m_frame_a, m_frame_b, m_camera_a, m_camera_b, m_marker_list_a,
+            m_marker_list_b, m_marker_coords_a, m_marker_coords_b,
+            pair_valid);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
 
-        auto success = ::mmsolver::sfm::add_marker_pair_at_frame(
-            m_time_a, m_time_b, m_image_width_a, m_image_width_b,
-            m_image_height_a, m_image_height_b, lensModel_a, lensModel_b,
-            marker_a, marker_b, m_marker_coords_a, m_marker_coords_b);
-        if (success) {
-            m_marker_list_a.push_back(marker_a);
-            m_marker_list_b.push_back(marker_b);
+        MarkerPtrList marker_list_a;
+        MarkerPtrList marker_list_b;
+        for (size_t i = 0; i < pair_valid.size(); ++i) {
+            if (pair_valid[i]) {
+                marker_list_a.push_back(m_marker_list_a[i]);
+                marker_list_b.push_back(m_marker_list_b[i]);
+            }
         }
+        m_marker_list_a = marker_list_a;
+        m_marker_list_b = marker_list_b;
     }
 
     MMSOLVER_MAYA_VRB("parse m_marker_list_a size: " << m_marker_list_a.size());
@@ -28,7 +28,7 @@
 #include <maya/MDagPath.h>
 #include <maya/MFileObject.h>
 #include <maya/MFnDependencyNode.h>
-#include <maya/MImage.h>
+#include <maya/MIntArray.h>
 #include <maya/MMatrix.h>
 #include <maya/MMatrixArray.h>
 #include <maya/MObject.h>
@@ -38,6 +38,7 @@
 #include <maya/MSyntax.h>
 
 // MM Solver
+#include "mmSolver/image/image_io.h"
 #include "mmSolver/utilities/debug_utils.h"
 
 namespace mmsolver {
@@ -69,6 +70,15 @@ MSyntax MMReadImageCmd::newSyntax() {
 
     syntax.addFlag(WIDTH_HEIGHT_FLAG, WIDTH_HEIGHT_FLAG_LONG,
                    MSyntax::kBoolean);
+    syntax.addFlag(MISSING_FRAMES_FLAG, MISSING_FRAMES_FLAG_LONG,
+                   MSyntax::kBoolean);
+    syntax.addFlag(INCONSISTENT_FRAMES_FLAG, INCONSISTENT_FRAMES_FLAG_LONG,
+                   MSyntax::kBoolean);
+
+    syntax.addFlag(FRAME_START_FLAG, FRAME_START_FLAG_LONG, MSyntax::kLong);
+    syntax.addFlag(FRAME_END_FLAG, FRAME_END_FLAG_LONG, MSyntax::kLong);
+    syntax.addFlag(THREAD_COUNT_FLAG, THREAD_COUNT_FLAG_LONG,
+                   MSyntax::kUnsigned);
     return syntax;
 }
 
@@ -114,6 +124,109 @@ MStatus MMReadImageCmd::parseArgs(const MArgList &args) {
 
     m_query_width_height = argData.isFlagSet(WIDTH_HEIGHT_FLAG, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
+    m_query_missing_frames = argData.isFlagSet(MISSING_FRAMES_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    m_query_inconsistent_frames =
+        argData.isFlagSet(INCONSISTENT_FRAMES_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const int query_count = static_cast<int>(m_query_width_height) +
+                            static_cast<int>(m_query_missing_frames) +
+                            static_cast<int>(m_query_inconsistent_frames);
+    if (query_count > 1) {
+        status = MStatus::kFailure;
+        status.perror("mmReadImage: Only one value may be queried at a time.");
+        return status;
+    }
+
+    // Frame Range
+    const bool has_frame_start = argData.isFlagSet(FRAME_START_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    const bool has_frame_end = argData.isFlagSet(FRAME_END_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (has_frame_start != has_frame_end) {
+        status = MStatus::kFailure;
+        status.perror(
+            "mmReadImage: "
+            "Both frameStart and frameEnd must be given for an image "
+            "sequence.");
+        return status;
+    }
+    m_is_sequence = has_frame_start && has_frame_end;
+    if (m_is_sequence) {
+        int frame_start = 0;
+        int frame_end = 0;
+        status = argData.getFlagArgument(FRAME_START_FLAG, 0, frame_start);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = argData.getFlagArgument(FRAME_END_FLAG, 0, frame_end);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        if (frame_end < frame_start) {
+            status = MStatus::kFailure;
+            status.perror(
+                "mmReadImage: frameEnd must not be less than frameStart.");
+            return status;
+        }
+        m_frame_start = static_cast<int32_t>(frame_start);
+        m_frame_end = static_cast<int32_t>(frame_end);
+    } else if (m_query_missing_frames || m_query_inconsistent_frames) {
+        status = MStatus::kFailure;
+        status.perror(
+            "mmReadImage: "
+            "missingFrames and inconsistentFrames need a frame range "
+            "(frameStart and frameEnd).");
+        return status;
+    }
+
+    m_thread_count = 0;
+    const bool has_thread_count =
+        argData.isFlagSet(THREAD_COUNT_FLAG, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (has_thread_count) {
+        status = argData.getFlagArgument(THREAD_COUNT_FLAG, 0, m_thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+    return status;
+}
+
+/*
+ * Read the headers of all frames of an image sequence.
+ *
+ * EXR sequences are read in parallel, so validating a long sequence
+ * (especially on network storage) is not limited by the latency of
+ * opening each file one after another.
+ */
+MStatus MMReadImageCmd::doItSequence() {
+    MStatus status = MStatus::kSuccess;
+
+    image::ImageSequenceInfo info;
+    const bool ok = image::read_image_sequence_info(
+        m_file_path, m_frame_start, m_frame_end,
+        static_cast<size_t>(m_thread_count), info);
+    if (!ok) {
+        MMSOLVER_MAYA_WRN("mmReadImage: "
+                          << "No frame of the image sequence could be read: "
+                          << m_file_path.asChar() << " (frames "
+                          << m_frame_start << " to " << m_frame_end << ")");
+    }
+
+    MIntArray outResult;
+    if (m_query_width_height) {
+        outResult.append(static_cast<int>(info.width));
+        outResult.append(static_cast<int>(info.height));
+    }
+    if (m_query_missing_frames) {
+        for (const int32_t frame : info.missing_frames) {
+            outResult.append(frame);
+        }
+    }
+    if (m_query_inconsistent_frames) {
+        for (const int32_t frame : info.inconsistent_frames) {
+            outResult.append(frame);
+        }
+    }
+    if (ok) {
+        MMReadImageCmd::setResult(outResult);
+    }
     return status;
 }
 
@@ -124,6 +237,10 @@ MStatus MMReadImageCmd::doIt(const MArgList &args) {
     status = parseArgs(args);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
+    if (m_is_sequence) {
+        return doItSequence();
+    }
+
     auto file_object = MFileObject();
     file_object.setRawFullName(m_file_path);
     file_object.setResolveMethod(MFileObject::kInputFile);
@@ -147,25 +264,20 @@ MStatus MMReadImageCmd::doIt(const MArgList &args) {
     }
 
     if (m_query_width_height) {
-        auto image = MImage();
-        // kUnknown attempts to load the native pixel type.
-        auto pixel_type = MImage::kUnknown;
-        status = image.readFromFile(
-            m_file_path,
-            pixel_type  // The desired pixel format is unknown.
-        );
-        if (status != MS::kSuccess) {
-            status = MS::kSuccess;
+        // Only the image header is read (when the format is known),
+        // and the result is cached, because this is queried for
+        // every frame of an image sequence.
+        uint32_t image_width = 2;
+        uint32_t image_height = 2;
+        const bool ok =
+            image::read_image_size(m_file_path, image_width, image_height);
+        if (!ok) {
             MMSOLVER_MAYA_WRN("mmReadImage: "
                               << "Image file path could not be read: "
                               << m_file_path.asChar());
             return status;
         }
 
-        uint32_t image_width = 2;
-        uint32_t image_height = 2;
-        image.getSize(image_width, image_height);
-
         MIntArray outResult;
         outResult.append(image_width);
         outResult.append(image_height);
@@ -23,6 +23,9 @@
 #ifndef MAYA_MM_READ_IMAGE_CMD_H
 #define MAYA_MM_READ_IMAGE_CMD_H
 
+// STL
+#include <cstdint>
+
 // Maya
 #include <maya/MArgDatabase.h>
 #include <maya/MArgList.h>
@@ -40,11 +43,34 @@
 #define WIDTH_HEIGHT_FLAG "-wh"
 #define WIDTH_HEIGHT_FLAG_LONG "-widthHeight"
 
+#define FRAME_START_FLAG "-fs"
+#define FRAME_START_FLAG_LONG "-frameStart"
+
+#define FRAME_END_FLAG "-fe"
+#define FRAME_END_FLAG_LONG "-frameEnd"
+
+#define THREAD_COUNT_FLAG "-tc"
+#define THREAD_COUNT_FLAG_LONG "-threadCount"
+
+#define MISSING_FRAMES_FLAG "-msf"
+#define MISSING_FRAMES_FLAG_LONG "-missingFrames"
+
+#define INCONSISTENT_FRAMES_FLAG "-icf"
+#define INCONSISTENT_FRAMES_FLAG_LONG "-inconsistentFrames"
+
 namespace mmsolver {
 
 class MMReadImageCmd : public MPxCommand {
 public:
-    MMReadImageCmd() : m_file_path(){};
+    MMReadImageCmd()
+        : m_file_path()
+        , m_query_width_height(false)
+        , m_query_missing_frames(false)
+        , m_query_inconsistent_frames(false)
+        , m_is_sequence(false)
+        , m_frame_start(0)
+        , m_frame_end(0)
+        , m_thread_count(0){};
 
     virtual ~MMReadImageCmd();
 
@@ -61,9 +87,19 @@ public:
 
 private:
     MStatus parseArgs(const MArgList &args);
+    MStatus doItSequence();
 
     MString m_file_path;
     bool m_query_width_height;
+    bool m_query_missing_frames;
+    bool m_query_inconsistent_frames;
+
+    // When a frame range is given, 'm_file_path' is an image sequence
+    // pattern, with '#' characters for the frame number.
+    bool m_is_sequence;
+    int32_t m_frame_start;
+    int32_t m_frame_end;
+    uint32_t m_thread_count;
 };
 
 }  // namespace mmsolver
@@ -23,8 +23,9 @@
 #include "MMReprojectionCmd.h"
 
 // STL
-#include <cassert>
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 // Maya
@@ -51,6 +52,7 @@
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/string_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 namespace mmsolver {
 
@@ -101,6 +103,7 @@ MSyntax MMReprojectionCmd::newSyntax() {
                    MSyntax::kBoolean);
     syntax.addFlag(DISTORT_MODE_FLAG, DISTORT_MODE_FLAG_LONG,
                    MSyntax::kUnsigned);
+    syntax.addFlag(THREAD_COUNT_FLAG, THREAD_COUNT_FLAG_LONG, MSyntax::kLong);
 
     syntax.makeFlagMultiUse(TIME_FLAG);
 
@@ -207,6 +210,16 @@ MStatus MMReprojectionCmd::parseArgs(const MArgList &args) {
         m_distort_mode = static_cast<ReprojectionDistortMode>(value);
     }
 
+    // Get 'Thread Count' flag
+    m_thread_count = 0;
+    bool threadCountFlagIsSet = argData.isFlagSet(THREAD_COUNT_FLAG, &status);
+    if (threadCountFlagIsSet == true) {
+        int thread_count = 0;
+        status = argData.getFlagArgument(THREAD_COUNT_FLAG, 0, thread_count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_thread_count = static_cast<uint32_t>(std::max(0, thread_count));
+    }
+
     // Get World Flag flag or Get Transforms
     m_nodeList.clear();
     m_worldPoint = MPoint();
@@ -334,119 +347,73 @@ MStatus MMReprojectionCmd::doIt(const MArgList &args) {
     m_cameraPtr->clearAttrValueCache();
 
     // Camera
-    double focalLength = 35;
-    double horizontalFilmAperture = 1;
-    double verticalFilmAperture = 1;
-    double horizontalFilmOffset = 0;
-    double verticalFilmOffset = 0;
-    short filmFit = 1;
-    double nearClipPlane = 0.1;
-    double farClipPlane = 1000;
-    double cameraScale = 1;
-
-    // Image
-    double imageWidth = m_imageResX;
-    double imageHeight = m_imageResY;
-
-    // Manipulation
-    MMatrix applyMatrix;
-    bool overrideScreenX = false;
-    bool overrideScreenY = false;
-    bool overrideScreenZ = false;
-    double screenX = 0;
-    double screenY = 0;
-    double screenZ = 0;
-    double depthScale = 1.0;
-
-    // Reprojection Outputs
-    double outCoordX;
-    double outCoordY;
-    double outNormCoordX;
-    double outNormCoordY;
-    double outMarkerCoordX;
-    double outMarkerCoordY;
-    double outMarkerCoordZ;
-    double outPixelX;
-    double outPixelY;
-    bool outInsideFrustum;
-    double outPointX;
-    double outPointY;
-    double outPointZ;
-    double outWorldPointX;
-    double outWorldPointY;
-    double outWorldPointZ;
-    MMatrix outMatrix;
-    MMatrix outWorldMatrix;
-    MMatrix outCameraProjectionMatrix;
-    MMatrix outInverseCameraProjectionMatrix;
-    MMatrix outWorldCameraProjectionMatrix;
-    MMatrix outWorldInverseCameraProjectionMatrix;
-    double outHorizontalPan;
-    double outVerticalPan;
-
-    Attr cameraMatrixAttr = m_cameraPtr->getMatrixAttr();
+    const double nearClipPlane = 0.1;
 
     // Assumed to *not* be animated.
-    farClipPlane = m_cameraPtr->getFarClipPlaneValue();
-    cameraScale = m_cameraPtr->getCameraScaleValue();
-    filmFit = m_cameraPtr->getFilmFitValue();
+    const double farClipPlane = m_cameraPtr->getFarClipPlaneValue();
+    const double cameraScale = m_cameraPtr->getCameraScaleValue();
+    const short filmFit = m_cameraPtr->getFilmFitValue();
 
-    // Lists of values to collect, then loop over and batch compute.
-    MMatrixArray tfmMatrixList;
-    MMatrixArray camMatrixList;
-    MTimeArray timeList;
+    const int timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+    const unsigned int frameCount = m_timeList.length();
+
+    // The camera values are queried once per frame, for all
+    // nodes. These camera attributes could be animated, so they are
+    // sampled at each time value.
     std::vector<double> focalLengthList;
     std::vector<double> horizontalFilmApertureList;
     std::vector<double> verticalFilmApertureList;
     std::vector<double> horizontalFilmOffsetList;
     std::vector<double> verticalFilmOffsetList;
-    std::vector<std::shared_ptr<mmlens::LensModel>> lensModelList;
+    status = m_cameraPtr->getFocalLengthAttr().getValues(
+        focalLengthList, m_timeList, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = m_cameraPtr->getFilmbackWidthAttr().getValues(
+        horizontalFilmApertureList, m_timeList, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = m_cameraPtr->getFilmbackHeightAttr().getValues(
+        verticalFilmApertureList, m_timeList, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = m_cameraPtr->getFilmbackOffsetXAttr().getValues(
+        horizontalFilmOffsetList, m_timeList, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = m_cameraPtr->getFilmbackOffsetYAttr().getValues(
+        verticalFilmOffsetList, m_timeList, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    const int timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+    Attr &cameraMatrixAttr = m_cameraPtr->getMatrixAttr();
+    std::vector<ReprojectionCameraFrame> cameraFrameList(frameCount);
+    for (unsigned int j = 0; j < frameCount; ++j) {
+        ReprojectionCameraFrame &cameraFrame = cameraFrameList[j];
+        status = cameraMatrixAttr.getValue(cameraFrame.camMatrix,
+                                           m_timeList[j], timeEvalMode);
+        CHECK_MSTATUS(status);
+        cameraFrame.focalLength = focalLengthList[j];
+        cameraFrame.horizontalFilmAperture = horizontalFilmApertureList[j];
+        cameraFrame.verticalFilmAperture = verticalFilmApertureList[j];
+        cameraFrame.horizontalFilmOffset = horizontalFilmOffsetList[j];
+        cameraFrame.verticalFilmOffset = verticalFilmOffsetList[j];
+    }
 
-    const bool needLensModels =
-        m_distort_mode != ReprojectionDistortMode::kNone;
     std::shared_ptr<mmlens::LensModel> lensModel;
-    if (needLensModels) {
+    if (m_distort_mode != ReprojectionDistortMode::kNone) {
         status = mmsolver::getLensModelFromCamera(m_cameraPtr, lensModel);
         CHECK_MSTATUS(status);
     }
 
-    // Query all the input data at once.
+    // The matrix of each node at each frame, node-major.
+    MMatrixArray tfmMatrixList;
     if (m_nodeList.length() == 0 && m_givenWorldPoint == true) {
         MMatrix tfmMatrix;
         tfmMatrix[3][0] = m_worldPoint.x;
         tfmMatrix[3][1] = m_worldPoint.y;
         tfmMatrix[3][2] = m_worldPoint.z;
-
-        for (unsigned int j = 0; j < m_timeList.length(); ++j) {
-            MTime time = m_timeList[j];
-            timeList.append(time);
-
-            MMatrix camMatrix;
-            status = cameraMatrixAttr.getValue(camMatrix, time, timeEvalMode);
-            camMatrixList.append(camMatrix);
-            tfmMatrixList.append(tfmMatrix);
-
-            // These camera attributes could be Animated, so we sample
-            // them at each time value.
-            focalLength = m_cameraPtr->getFocalLengthValue(time, timeEvalMode);
-            horizontalFilmAperture =
-                m_cameraPtr->getFilmbackWidthValue(time, timeEvalMode);
-            verticalFilmAperture =
-                m_cameraPtr->getFilmbackHeightValue(time, timeEvalMode);
-            horizontalFilmOffset =
-                m_cameraPtr->getFilmbackOffsetXValue(time, timeEvalMode);
-            verticalFilmOffset =
-                m_cameraPtr->getFilmbackOffsetYValue(time, timeEvalMode);
-
-            focalLengthList.push_back(focalLength);
-            horizontalFilmApertureList.push_back(horizontalFilmAperture);
-            verticalFilmApertureList.push_back(verticalFilmAperture);
-            horizontalFilmOffsetList.push_back(horizontalFilmOffset);
-            verticalFilmOffsetList.push_back(verticalFilmOffset);
+        tfmMatrixList.setLength(frameCount);
+        for (unsigned int j = 0; j < frameCount; ++j) {
+            tfmMatrixList[j] = tfmMatrix;
         }
     } else {
+        tfmMatrixList.setLength(m_nodeList.length() * frameCount);
         for (unsigned int i = 0; i < m_nodeList.length(); ++i) {
             MDagPath dagPath;
             status = m_nodeList.getDagPath(i, dagPath);
@@ -457,120 +424,75 @@ MStatus MMReprojectionCmd::doIt(const MArgList &args) {
             Attr tfmMatrixAttr;
             tfmMatrixAttr.setNodeName(nodeNamePath);
             tfmMatrixAttr.setAttrName("worldMatrix");
-            for (unsigned int j = 0; j < m_timeList.length(); ++j) {
-                MTime time = m_timeList[j];
-                timeList.append(time);
-
-                MMatrix camMatrix;
+            for (unsigned int j = 0; j < frameCount; ++j) {
                 MMatrix tfmMatrix;
-                status =
-                    cameraMatrixAttr.getValue(camMatrix, time, timeEvalMode);
-                status = tfmMatrixAttr.getValue(tfmMatrix, time, timeEvalMode);
-                camMatrixList.append(camMatrix);
-                tfmMatrixList.append(tfmMatrix);
-
-                // These camera attributes could be Animated, so we
-                // sample them at each time value.
-                focalLength =
-                    m_cameraPtr->getFocalLengthValue(time, timeEvalMode);
-                horizontalFilmAperture =
-                    m_cameraPtr->getFilmbackWidthValue(time, timeEvalMode);
-                verticalFilmAperture =
-                    m_cameraPtr->getFilmbackHeightValue(time, timeEvalMode);
-                horizontalFilmOffset =
-                    m_cameraPtr->getFilmbackOffsetXValue(time, timeEvalMode);
-                verticalFilmOffset =
-                    m_cameraPtr->getFilmbackOffsetYValue(time, timeEvalMode);
-
-                focalLengthList.push_back(focalLength);
-                horizontalFilmApertureList.push_back(horizontalFilmAperture);
-                verticalFilmApertureList.push_back(verticalFilmAperture);
-                horizontalFilmOffsetList.push_back(horizontalFilmOffset);
-                verticalFilmOffsetList.push_back(verticalFilmOffset);
+                status = tfmMatrixAttr.getValue(tfmMatrix, m_timeList[j],
+                                                timeEvalMode);
+                CHECK_MSTATUS(status);
+                tfmMatrixList[(i * frameCount) + j] = tfmMatrix;
             }
         }
     }
 
+    const size_t thread_count = (m_thread_count > 0)
+                                    ? static_cast<size_t>(m_thread_count)
+                                    : mmthread::defaultThreadCount();
+
     // Do the re-projection calculations, using the gathered data.
-    assert(tfmMatrixList.length() == m_timeList.length());
-    for (unsigned int i = 0; i < tfmMatrixList.length(); ++i) {
-        MTime time = timeList[i];
-        MMatrix camMatrix = camMatrixList[i];
-        MMatrix tfmMatrix = tfmMatrixList[i];
-
-        focalLength = focalLengthList[i];
-        horizontalFilmAperture = horizontalFilmApertureList[i];
-        verticalFilmAperture = verticalFilmApertureList[i];
-        horizontalFilmOffset = horizontalFilmOffsetList[i];
-        verticalFilmOffset = verticalFilmOffsetList[i];
-
-        // Query the reprojection.
-        status = reprojection(
-            tfmMatrix, camMatrix,
-
-            // Camera
-            focalLength, horizontalFilmAperture, verticalFilmAperture,
-            horizontalFilmOffset, verticalFilmOffset, filmFit, nearClipPlane,
-            farClipPlane, cameraScale,
-
-            // Image
-            imageWidth, imageHeight,
-
-            // Lens Distortion
-            m_distort_mode, lensModel,
-
-            // Manipulation
-            applyMatrix, overrideScreenX, overrideScreenY, overrideScreenZ,
-            screenX, screenY, screenZ, depthScale,
-
-            // Outputs
-            outCoordX, outCoordY, outNormCoordX, outNormCoordY, outMarkerCoordX,
-            outMarkerCoordY, outMarkerCoordZ, outPixelX, outPixelY,
-            outInsideFrustum, outPointX, outPointY, outPointZ, outWorldPointX,
-            outWorldPointY, outWorldPointZ, outMatrix, outWorldMatrix,
-            outCameraProjectionMatrix, outInverseCameraProjectionMatrix,
-            outWorldCameraProjectionMatrix,
-            outWorldInverseCameraProjectionMatrix, outHorizontalPan,
-            outVerticalPan);
-        CHECK_MSTATUS_AND_RETURN_IT(status);
+    std::vector<ReprojectionPointResult> results;
+    status = reprojectionBulk(tfmMatrixList, cameraFrameList, filmFit,
+                              nearClipPlane, farClipPlane, cameraScale,
+                              m_imageResX, m_imageResY, m_distort_mode,
+                              lensModel, thread_count, results);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
+    // Each enabled output adds values for every point, so the result
+    // size is known up-front.
+    const unsigned int valuesPerPoint =
+        (3 * (static_cast<unsigned int>(m_asCameraPoint) +
+              static_cast<unsigned int>(m_asWorldPoint) +
+              static_cast<unsigned int>(m_asCoordinate) +
+              static_cast<unsigned int>(m_asNormalizedCoordinate) +
+              static_cast<unsigned int>(m_asMarkerCoordinate) +
+              static_cast<unsigned int>(m_asPixelCoordinate))) +
+        static_cast<unsigned int>(m_withCameraDirRatio);
+    outResult.setLength(static_cast<unsigned int>(results.size()) *
+                        valuesPerPoint);
+
+    unsigned int index = 0;
+    for (const ReprojectionPointResult &result : results) {
         if (m_asCameraPoint == true) {
-            outResult.append(outPointX);
-            outResult.append(outPointY);
-            outResult.append(outPointZ);
+            outResult[index++] = result.pointX;
+            outResult[index++] = result.pointY;
+            outResult[index++] = result.pointZ;
         }
         if (m_asWorldPoint == true) {
-            outResult.append(outWorldPointX);
-            outResult.append(outWorldPointY);
-            outResult.append(outWorldPointZ);
+            outResult[index++] = result.worldPointX;
+            outResult[index++] = result.worldPointY;
+            outResult[index++] = result.worldPointZ;
         }
         if (m_asCoordinate == true) {
-            outResult.append(outCoordX);
-            outResult.append(outCoordY);
-            outResult.append(outPointZ);
+            outResult[index++] = result.coordX;
+            outResult[index++] = result.coordY;
+            outResult[index++] = result.pointZ;
         }
         if (m_asNormalizedCoordinate == true) {
-            outResult.append(outNormCoordX);
-            outResult.append(outNormCoordY);
-            outResult.append(outPointZ);
+            outResult[index++] = result.normCoordX;
+            outResult[index++] = result.normCoordY;
+            outResult[index++] = result.pointZ;
         }
         if (m_asMarkerCoordinate == true) {
-            outResult.append(outMarkerCoordX);
-            outResult.append(outMarkerCoordY);
-            outResult.append(outMarkerCoordZ);
+            outResult[index++] = result.markerCoordX;
+            outResult[index++] = result.markerCoordY;
+            outResult[index++] = result.markerCoordZ;
         }
         if (m_asPixelCoordinate == true) {
-            outResult.append(outPixelX);
-            outResult.append(outPixelY);
-            outResult.append(outPointZ);
+            outResult[index++] = result.pixelX;
+            outResult[index++] = result.pixelY;
+            outResult[index++] = result.pointZ;
         }
-
         if (m_withCameraDirRatio == true) {
-            double outCameraDirectionRatio = 0.0;
-            status = calculateCameraFacingRatio(tfmMatrix, camMatrix,
-                                                outCameraDirectionRatio);
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-            outResult.append(outCameraDirectionRatio);
+            outResult[index++] = result.cameraDirRatio;
         }
     }
 
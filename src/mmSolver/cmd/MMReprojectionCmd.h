@@ -25,6 +25,7 @@
 
 // STL
 #include <cmath>
+#include <cstdint>
 
 // Maya
 #include <maya/MArgDatabase.h>
@@ -100,6 +101,11 @@
 #define DISTORT_MODE_FLAG "-dsm"
 #define DISTORT_MODE_FLAG_LONG "-distortMode"
 
+// The number of threads used to reproject the points. Zero (the
+// default) uses all hardware threads.
+#define THREAD_COUNT_FLAG "-tc"
+#define THREAD_COUNT_FLAG_LONG "-threadCount"
+
 namespace mmsolver {
 
 class MMReprojectionCmd : public MPxCommand {
@@ -116,7 +122,8 @@ public:
         , m_asMarkerCoordinate(false)
         , m_asPixelCoordinate(false)
         , m_withCameraDirRatio(false)
-        , m_distort_mode(ReprojectionDistortMode::kNone) {
+        , m_distort_mode(ReprojectionDistortMode::kNone)
+        , m_thread_count(0) {
         m_cameraPtr = CameraPtr(new Camera());
     };
 
@@ -152,6 +159,7 @@ private:
     bool m_asPixelCoordinate;
     bool m_withCameraDirRatio;
     ReprojectionDistortMode m_distort_mode;
+    uint32_t m_thread_count;
 };
 
 }  // namespace mmsolver
@@ -36,7 +36,8 @@
  *       -attr "myBundle.translateX" "None" "None" "None" "None"
  *       -frame 1
  *       -sceneGraphMode 1  // 1 == "mmscenegraph"
- *       -mode "addAttrsToMarkers";
+ *       -mode "addAttrsToMarkers"
+ *       -logLevel 4;  // 4 == "debug", prints construction benchmarks.
  *
  */
 
@@ -58,6 +59,7 @@
 #include <maya/MMatrixArray.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
+#include <maya/MStreamUtils.h>
 #include <maya/MString.h>
 #include <maya/MStringArray.h>
 #include <maya/MSyntax.h>
@@ -70,6 +72,7 @@
 #include "mmSolver/adjust/adjust_data.h"
 #include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/adjust/adjust_relationships.h"
+#include "mmSolver/cmd/arg_flags_solve_log.h"
 #include "mmSolver/cmd/common_arg_flags.h"
 #include "mmSolver/mayahelper/maya_scene_graph.h"
 #include "mmSolver/mayahelper/maya_utils.h"
@@ -98,6 +101,7 @@ MSyntax MMSolverSceneGraphCmd::newSyntax() {
     syntax.enableEdit(false);
 
     syntax.addFlag(COMMAND_MODE_FLAG, COMMAND_MODE_FLAG_LONG, MSyntax::kString);
+    syntax.addFlag(LOG_LEVEL_FLAG, LOG_LEVEL_FLAG_LONG, MSyntax::kUnsigned);
 
     createSolveObjectSyntax(syntax);
     createSolveFramesSyntax(syntax);
@@ -125,6 +129,15 @@ MStatus MMSolverSceneGraphCmd::parseArgs(const MArgList &args) {
         }
     }
 
+    // Get 'Log Level'
+    m_logLevel = LOG_LEVEL_DEFAULT_VALUE;
+    if (argData.isFlagSet(LOG_LEVEL_FLAG)) {
+        int logLevelNum = static_cast<int>(LOG_LEVEL_DEFAULT_VALUE);
+        status = argData.getFlagArgument(LOG_LEVEL_FLAG, 0, logLevelNum);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        m_logLevel = static_cast<LogLevel>(logLevelNum);
+    }
+
     status = parseSolveObjectArguments(argData, m_cameraList, m_markerList,
                                        m_bundleList, m_attrList);
     CHECK_MSTATUS_AND_RETURN_IT(status);
@@ -178,6 +191,11 @@ MStatus MMSolverSceneGraphCmd::doIt(const MArgList &args) {
         auto markerNodes = std::vector<mmsg::MarkerNode>();
         auto attrIdList = std::vector<mmsg::AttrId>();
 
+        auto constructBenchTimer = mmsolver::debug::TimestampBenchmark();
+        auto constructBenchTicks = mmsolver::debug::CPUBenchmark();
+        constructBenchTimer.start();
+        constructBenchTicks.start();
+
         status = construct_scene_graph(m_cameraList, m_markerList, m_bundleList,
                                        m_attrList, m_frameList, timeEvalMode,
 
@@ -185,6 +203,22 @@ MStatus MMSolverSceneGraphCmd::doIt(const MArgList &args) {
                                        sceneGraph, attrDataBlock, flatScene,
                                        frameList, cameraNodes, bundleNodes,
                                        markerNodes, attrIdList);
+
+        constructBenchTicks.stop();
+        constructBenchTimer.stop();
+
+        if (m_logLevel >= LogLevel::kDebug) {
+            // Print construction benchmark, so the speed of
+            // constructing the scene graph can be measured.
+            static std::ostream &stream = MStreamUtils::stdErrorStream();
+            stream << "mmSolverSceneGraph: cameras=" << cameraNodes.size()
+                   << " bundles=" << bundleNodes.size()
+                   << " markers=" << markerNodes.size()
+                   << " attrs=" << attrIdList.size()
+                   << " frames=" << frameList.size() << std::endl;
+            constructBenchTimer.print(stream, "Construct Scene Graph", 1);
+            constructBenchTicks.print(stream, "Construct Scene Graph", 1);
+        }
         if (status != MS::kSuccess) {
             CHECK_MSTATUS(status);
             // Do not allow this command to fail, we want to allow the
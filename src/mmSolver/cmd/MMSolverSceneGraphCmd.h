@@ -98,6 +98,10 @@ private:
 
     // Whhat Scene Graph to construct.
     SceneGraphMode m_sceneGraphMode;
+
+    // How much detail is printed? Construction benchmarks are
+    // printed at the 'debug' log level.
+    LogLevel m_logLevel;
 };
 
 }  // namespace mmsolver
@@ -24,17 +24,22 @@
 #include "reprojection.h"
 
 // STL
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 // Maya
 #include <maya/MMatrix.h>
+#include <maya/MMatrixArray.h>
+#include <maya/MPoint.h>
 
 // MM Solver
 #include <mmlens/lens_model.h>
 
 #include "mmSolver/mayahelper/maya_camera.h"  // getProjectionMatrix, computeFrustumCoordinates
 #include "mmSolver/utilities/debug_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 MStatus reprojection(
     const MMatrix tfmMatrix, const MMatrix camMatrix,
@@ -348,3 +353,247 @@ MStatus calculateCameraFacingRatio(MMatrix tfmMatrix, MMatrix camMatrix,
     outCameraDirRatio = camDir * tfmDir;
     return status;
 }
+
+namespace {
+
+// Points are reprojected on other threads in chunks of at least this
+// many points, because handing fewer points to another thread costs
+// more than the work.
+const size_t kMinPointCountPerChunk = 1024;
+
+// The camera values of a single frame, that are the same for all
+// points.
+struct FrameProjection {
+    MMatrix camMatrix;
+    MMatrix camMatrixInverse;
+    MMatrix camWorldProjMatrix;
+    MMatrix camWorldProjMatrixInverse;
+    double filmBackAspect;
+};
+
+// Multiply the row vector 'row' by 'matrix'. This is the same as the
+// last row of 'A * matrix', when 'row' is the last row of 'A'.
+MPoint multiplyRow(const MPoint &row, const MMatrix &matrix) {
+    MPoint out;
+    out.x = (row.x * matrix[0][0]) + (row.y * matrix[1][0]) +
+            (row.z * matrix[2][0]) + (row.w * matrix[3][0]);
+    out.y = (row.x * matrix[0][1]) + (row.y * matrix[1][1]) +
+            (row.z * matrix[2][1]) + (row.w * matrix[3][1]);
+    out.z = (row.x * matrix[0][2]) + (row.y * matrix[1][2]) +
+            (row.z * matrix[2][2]) + (row.w * matrix[3][2]);
+    out.w = (row.x * matrix[0][3]) + (row.y * matrix[1][3]) +
+            (row.z * matrix[2][3]) + (row.w * matrix[3][3]);
+    return out;
+}
+
+// Compute the outputs from the screen-space point 'screenRow' (the
+// last row of the screen-space matrix in 'reprojection') and the
+// coordinate 'coord'.
+void setPointResult(const MPoint &screenRow, const MPoint &coord,
+                    const FrameProjection &frame, const MMatrix &tfmMatrix,
+                    const double imageWidth, const double imageHeight,
+                    ReprojectionPointResult &out_result) {
+    // Convert back to world space
+    const MPoint worldRow =
+        multiplyRow(screenRow, frame.camWorldProjMatrixInverse);
+
+    // Convert world to camera space
+    MPoint posCamera = multiplyRow(worldRow, frame.camMatrixInverse);
+    posCamera.rationalize();
+
+    out_result.coordX = coord.x;
+    out_result.coordY = coord.y;
+    out_result.normCoordX = (coord.x + 1.0) * 0.5;
+    out_result.normCoordY = (coord.y + 1.0) * 0.5;
+    out_result.markerCoordX = coord.x * 0.5;
+    out_result.markerCoordY = coord.y * 0.5;
+    out_result.markerCoordZ = posCamera.z * -1.0;
+    out_result.pixelX = (coord.x + 1.0) * 0.5 * imageWidth;
+    out_result.pixelY = (coord.y + 1.0) * 0.5 * imageHeight;
+    out_result.insideFrustum = (coord.x >= -1.0) && (coord.x <= 1.0) &&
+                               (coord.y >= -1.0) && (coord.y <= 1.0);
+    out_result.pointX = posCamera.x;
+    out_result.pointY = posCamera.y;
+    out_result.pointZ = posCamera.z;
+    out_result.worldPointX = worldRow.x;
+    out_result.worldPointY = worldRow.y;
+    out_result.worldPointZ = worldRow.z;
+
+    calculateCameraFacingRatio(tfmMatrix, frame.camMatrix,
+                               out_result.cameraDirRatio);
+}
+
+}  // namespace
+
+MStatus reprojectionBulk(
+    const MMatrixArray &tfmMatrixList,
+    const std::vector<ReprojectionCameraFrame> &cameraFrameList,
+
+    // Camera
+    const short filmFit, const double nearClipPlane,
+    const double farClipPlane, const double cameraScale,
+
+    // Image
+    const double imageWidth, const double imageHeight,
+
+    // Lens Distortion
+    const ReprojectionDistortMode distortMode,
+    std::shared_ptr<mmlens::LensModel> lensModel,
+
+    const size_t threadCount,
+    std::vector<ReprojectionPointResult> &outResults) {
+    MStatus status = MStatus::kSuccess;
+
+    const size_t frameCount = cameraFrameList.size();
+    const size_t count = tfmMatrixList.length();
+    outResults.clear();
+    if (count == 0) {
+        return status;
+    }
+    if ((frameCount == 0) || ((count % frameCount) != 0)) {
+        MMSOLVER_MAYA_ERR(
+            "reprojectionBulk: The number of matrices ("
+            << count << ") must be a multiple of the number of frames ("
+            << frameCount << ").");
+        return MStatus::kFailure;
+    }
+    outResults.resize(count);
+
+    const double imageAspect =
+        static_cast<double>(imageWidth) / static_cast<double>(imageHeight);
+
+    // The camera projection for each frame, shared by all points.
+    std::vector<FrameProjection> frames(frameCount);
+    for (size_t j = 0; j < frameCount; ++j) {
+        const ReprojectionCameraFrame &cameraFrame = cameraFrameList[j];
+
+        MMatrix camProjMatrix;
+        status = getProjectionMatrix(
+            cameraFrame.focalLength, cameraFrame.horizontalFilmAperture,
+            cameraFrame.verticalFilmAperture, cameraFrame.horizontalFilmOffset,
+            cameraFrame.verticalFilmOffset, imageWidth, imageHeight, filmFit,
+            nearClipPlane, farClipPlane, cameraScale, camProjMatrix);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        FrameProjection &frame = frames[j];
+        frame.camMatrix = cameraFrame.camMatrix;
+        frame.camMatrixInverse = cameraFrame.camMatrix.inverse();
+        frame.camWorldProjMatrix = frame.camMatrixInverse * camProjMatrix;
+        frame.camWorldProjMatrixInverse = frame.camWorldProjMatrix.inverse();
+        frame.filmBackAspect = cameraFrame.horizontalFilmAperture /
+                               cameraFrame.verticalFilmAperture;
+    }
+
+    const bool useLens =
+        lensModel && (distortMode != ReprojectionDistortMode::kNone);
+    if (!useLens) {
+        mmthread::parallelForChunks(
+            count, threadCount, kMinPointCountPerChunk,
+            [&](const size_t start, const size_t end) {
+                for (size_t i = start; i < end; ++i) {
+                    const FrameProjection &frame = frames[i % frameCount];
+                    const MMatrix &tfmMatrix = tfmMatrixList[i];
+
+                    // Convert to screen-space.
+                    const MPoint tfmRow(tfmMatrix[3][0], tfmMatrix[3][1],
+                                        tfmMatrix[3][2], tfmMatrix[3][3]);
+                    const MPoint screenRow =
+                        multiplyRow(tfmRow, frame.camWorldProjMatrix);
+
+                    MPoint coord = screenRow;
+                    applyFilmFitCorrectionScaleForward(
+                        filmFit, frame.filmBackAspect, imageAspect, coord.x,
+                        coord.y);
+                    coord.cartesianize();
+
+                    setPointResult(screenRow, coord, frame, tfmMatrix,
+                                   imageWidth, imageHeight, outResults[i]);
+                }
+            });
+        return status;
+    }
+
+    // Screen-space points (divided by W), and the same points in
+    // lens distortion coordinates (-0.5 to 0.5), stored as
+    // interleaved X and Y values for the lens model.
+    std::vector<MPoint> screenPoints(count);
+    std::vector<double> lensInputXY(count * 2);
+    mmthread::parallelForChunks(
+        count, threadCount, kMinPointCountPerChunk,
+        [&](const size_t start, const size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                const FrameProjection &frame = frames[i % frameCount];
+                const MMatrix &tfmMatrix = tfmMatrixList[i];
+
+                const MPoint tfmRow(tfmMatrix[3][0], tfmMatrix[3][1],
+                                    tfmMatrix[3][2], tfmMatrix[3][3]);
+                MPoint posScreen =
+                    multiplyRow(tfmRow, frame.camWorldProjMatrix);
+                applyFilmFitCorrectionScaleForward(
+                    filmFit, frame.filmBackAspect, imageAspect, posScreen.x,
+                    posScreen.y);
+
+                // Convert from 'P(W*x, W*y, W*z, W)' to 'P(x, y, z, W)'.
+                posScreen.rationalize();
+                screenPoints[i] = posScreen;
+                lensInputXY[(i * 2) + 0] = posScreen.x * 0.5;
+                lensInputXY[(i * 2) + 1] = posScreen.y * 0.5;
+            }
+        });
+
+    // The lens models prepare their (lazily computed) state safely
+    // from any thread, so all chunks may start at once.
+    std::vector<double> lensOutputXY(lensInputXY);
+    const bool undistort = distortMode == ReprojectionDistortMode::kUndistort;
+    mmthread::parallelForChunks(
+        count, threadCount, kMinPointCountPerChunk,
+        [&](const size_t start, const size_t end) {
+            const double *in_xy = lensInputXY.data() + (start * 2);
+            double *out_xy = lensOutputXY.data() + (start * 2);
+            const size_t point_count = end - start;
+            if (undistort) {
+                lensModel->applyModelUndistortPoints(in_xy, out_xy,
+                                                     point_count);
+            } else {
+                lensModel->applyModelDistortPoints(in_xy, out_xy, point_count);
+            }
+        });
+
+    mmthread::parallelForChunks(
+        count, threadCount, kMinPointCountPerChunk,
+        [&](const size_t start, const size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                const FrameProjection &frame = frames[i % frameCount];
+
+                // Applying Lens distortion can result in NaN or infinite
+                // values, so we avoid applying such values if they are
+                // computed.
+                double output_x = lensInputXY[(i * 2) + 0];
+                double output_y = lensInputXY[(i * 2) + 1];
+                if (std::isfinite(lensOutputXY[(i * 2) + 0])) {
+                    output_x = lensOutputXY[(i * 2) + 0];
+                }
+                if (std::isfinite(lensOutputXY[(i * 2) + 1])) {
+                    output_y = lensOutputXY[(i * 2) + 1];
+                }
+                output_x *= 2.0;
+                output_y *= 2.0;
+
+                const MPoint coord(output_x, output_y, 0.0, 1.0);
+
+                MPoint screenRow = screenPoints[i];
+                screenRow.x = output_x;
+                screenRow.y = output_y;
+                applyFilmFitCorrectionScaleBackward(
+                    filmFit, frame.filmBackAspect, imageAspect, screenRow.x,
+                    screenRow.y);
+
+                // Convert from 'P(x, y, z, W)' to 'P(W*x, W*y, W*z, W)'.
+                screenRow.homogenize();
+
+                setPointResult(screenRow, coord, frame, tfmMatrixList[i],
+                               imageWidth, imageHeight, outResults[i]);
+            }
+        });
+    return status;
+}
@@ -24,10 +24,13 @@
 #define MM_SOLVER_CORE_REPROJECTION_H
 
 // STL
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 // Maya
 #include <maya/MMatrix.h>
+#include <maya/MMatrixArray.h>
 #include <maya/MStatus.h>
 
 // MM Solver
@@ -123,4 +126,94 @@ MStatus reprojection(
 MStatus calculateCameraFacingRatio(MMatrix tfmMatrix, MMatrix camMatrix,
                                    double &outCameraDirRatio);
 
+// The (possibly animated) camera values at a single frame.
+struct ReprojectionCameraFrame {
+    MMatrix camMatrix;
+    double focalLength;
+    double horizontalFilmAperture;
+    double verticalFilmAperture;
+    double horizontalFilmOffset;
+    double verticalFilmOffset;
+
+    ReprojectionCameraFrame()
+        : camMatrix()
+        , focalLength(35.0)
+        , horizontalFilmAperture(1.0)
+        , verticalFilmAperture(1.0)
+        , horizontalFilmOffset(0.0)
+        , verticalFilmOffset(0.0) {}
+};
+
+// The reprojection of a single point at a single frame. The values
+// match the outputs of 'reprojection' with the same names.
+struct ReprojectionPointResult {
+    double coordX;
+    double coordY;
+    double normCoordX;
+    double normCoordY;
+    double markerCoordX;
+    double markerCoordY;
+    double markerCoordZ;
+    double pixelX;
+    double pixelY;
+    bool insideFrustum;
+    double pointX;
+    double pointY;
+    double pointZ;
+    double worldPointX;
+    double worldPointY;
+    double worldPointZ;
+    double cameraDirRatio;
+
+    ReprojectionPointResult()
+        : coordX(0.0)
+        , coordY(0.0)
+        , normCoordX(0.0)
+        , normCoordY(0.0)
+        , markerCoordX(0.0)
+        , markerCoordY(0.0)
+        , markerCoordZ(0.0)
+        , pixelX(0.0)
+        , pixelY(0.0)
+        , insideFrustum(false)
+        , pointX(0.0)
+        , pointY(0.0)
+        , pointZ(0.0)
+        , worldPointX(0.0)
+        , worldPointY(0.0)
+        , worldPointZ(0.0)
+        , cameraDirRatio(0.0) {}
+};
+
+// Reproject many points at many frames at once.
+//
+// 'tfmMatrixList' has one matrix per point per frame, point-major;
+// the matrix of point 'i' at frame 'j' is at index
+// '(i * cameraFrameList.size()) + j'. 'outResults' uses the same
+// order.
+//
+// The camera projection is computed once per frame (rather than once
+// per point), the lens distortion is applied to all points with the
+// batched lens model functions, and the points are reprojected on
+// up to 'threadCount' threads of the shared thread pool (see
+// 'mmthread::parallelForChunks'). The results are the same as calling
+// 'reprojection' for each matrix, with no screen-space manipulation.
+MStatus reprojectionBulk(
+    const MMatrixArray &tfmMatrixList,
+    const std::vector<ReprojectionCameraFrame> &cameraFrameList,
+
+    // Camera
+    const short filmFit, const double nearClipPlane,
+    const double farClipPlane, const double cameraScale,
+
+    // Image Resolution - so we can give values as pixels
+    const double imageWidth, const double imageHeight,
+
+    // Lens Distortion
+    const ReprojectionDistortMode distortMode,
+    std::shared_ptr<mmlens::LensModel> lensModel,
+
+    const size_t threadCount,
+    std::vector<ReprojectionPointResult> &outResults);
+
 #endif  // MM_SOLVER_CORE_REPROJECTION_H
@@ -0,0 +1,659 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * A cache of decoded image files, with background reader threads.
+ */
+
+#include "image_cache.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+// Maya
+#include <maya/MImage.h>
+#include <maya/MString.h>
+
+// MM Solver Libs
+#include <mmimage/mmimage.h>
+
+// MM Solver
+#include "image_pixel_ops.h"
+#include "mmSolver/utilities/debug_utils.h"
+
+namespace mmsolver {
+namespace image {
+
+namespace {
+
+using ImageList = std::list<CachedImagePtr>;
+
+// An image file to be decoded at a proxy level.
+struct ImageRequest {
+    std::string file_path;
+    uint8_t proxy_level;
+    std::string key;
+};
+
+struct ImageCache {
+    std::mutex mutex;
+
+    // Signalled when there are new requests, or the threads must
+    // stop.
+    std::condition_variable request_condition;
+
+    // Signalled when a file has finished decoding.
+    std::condition_variable decoded_condition;
+
+    // The most recently used image is at the front.
+    ImageList images;
+    std::unordered_map<std::string, ImageList::iterator> image_lookup;
+
+    // Keys of the images currently being decoded, by any thread.
+    std::unordered_set<std::string> decoding;
+
+    // Images waiting to be decoded by the reader threads, and the
+    // keys of all images requested by the last prefetch (including
+    // images already cached).
+    std::deque<ImageRequest> requests;
+    std::unordered_set<std::string> requested;
+
+    // Keys of the images that could not be read. These are not read
+    // again until the cache is cleared.
+    std::unordered_set<std::string> failed;
+
+    // Images evicted from the cache, kept so the pixel buffer memory
+    // can be re-used for the next decoded image.
+    std::vector<CachedImagePtr> free_images;
+
+    std::vector<std::thread> threads;
+    size_t thread_count;
+    bool stop;
+
+    // Incremented every time the cache is cleared, so that images
+    // decoded before the clear are not added.
+    uint64_t clear_count;
+
+    size_t memory_budget_bytes;
+    size_t bytes_resident;
+
+    // Used to estimate the size of an image before it is decoded.
+    size_t last_byte_count;
+
+    ImageCacheStatistics statistics;
+
+    ImageCache()
+        : thread_count(kImageCacheDefaultThreadCount)
+        , stop(false)
+        , clear_count(0)
+        , memory_budget_bytes(kImageCacheDefaultMemoryBudgetBytes)
+        , bytes_resident(0)
+        , last_byte_count(0) {}
+
+    ~ImageCache() {
+        std::unique_lock<std::mutex> lock(mutex);
+        stop_reader_threads(lock);
+    }
+
+    void stop_reader_threads(std::unique_lock<std::mutex> &lock) {
+        stop = true;
+        request_condition.notify_all();
+
+        std::vector<std::thread> stopping_threads;
+        stopping_threads.swap(threads);
+        lock.unlock();
+        for (std::thread &thread : stopping_threads) {
+            thread.join();
+        }
+        lock.lock();
+        stop = false;
+    }
+};
+
+ImageCache &get_image_cache() {
+    static ImageCache cache;
+    return cache;
+}
+
+size_t data_type_byte_size(const mmimage::BufferDataType data_type) {
+    switch (data_type) {
+        case mmimage::BufferDataType::kF16:
+            return sizeof(uint16_t);
+        case mmimage::BufferDataType::kF32:
+            return sizeof(float);
+        case mmimage::BufferDataType::kF64:
+            return sizeof(double);
+        case mmimage::BufferDataType::kU8:
+            return sizeof(uint8_t);
+        default:
+            return 0;
+    }
+}
+
+void *pixel_data_mut(mmimage::ImagePixelBuffer &pixel_buffer) {
+    switch (pixel_buffer.data_type()) {
+        case mmimage::BufferDataType::kF16:
+            return pixel_buffer.as_slice_f16x4_mut().data();
+        case mmimage::BufferDataType::kF32:
+            return pixel_buffer.as_slice_f32x4_mut().data();
+        case mmimage::BufferDataType::kU8:
+            return pixel_buffer.as_slice_u8x4_mut().data();
+        default:
+            return nullptr;
+    }
+}
+
+// Only EXR files have proxy levels; other files are read with MImage
+// at full resolution, whatever level is requested.
+uint8_t file_proxy_level(const std::string &file_path,
+                         const uint8_t proxy_level) {
+    if (!mmimage::is_exr_file_path(rust::Str(file_path))) {
+        return 0;
+    }
+    return proxy_level;
+}
+
+// The same file may be cached at several proxy levels, so images
+// are looked up by a key made from the file path and proxy level.
+std::string make_cache_key(const std::string &file_path,
+                           const uint8_t proxy_level) {
+    if (proxy_level == 0) {
+        return file_path;
+    }
+    return file_path + "|proxy" + std::to_string(proxy_level);
+}
+
+// Set the image details from the decoded pixel buffer.
+bool update_image_details(CachedImage &image) {
+    image.width = image.pixel_buffer.image_width();
+    image.height = image.pixel_buffer.image_height();
+    image.data_type = image.pixel_buffer.data_type();
+
+    const size_t channel_byte_size = data_type_byte_size(image.data_type);
+    const size_t num_channels = image.pixel_buffer.num_channels();
+    image.byte_count =
+        image.width * image.height * num_channels * channel_byte_size;
+    return (num_channels == kRgbaChannelCount) && (image.byte_count > 0);
+}
+
+// Decode an EXR file with 'mmimage'. This is thread-safe.
+//
+// Proxy levels are read from the proxy files written by
+// 'mmConvertImage -proxyLevels', if they exist.
+bool read_image_exr(CachedImage &image) {
+    auto meta_data = mmimage::ImageMetaData();
+    const auto rust_file_path = rust::Str(image.file_path.c_str());
+    bool ok = false;
+    if (image.proxy_level == 0) {
+        ok = mmimage::image_read_pixels_exr_rgba(rust_file_path, meta_data,
+                                                 image.pixel_buffer);
+    } else {
+        ok = mmimage::image_read_pixels_exr_rgba_level(
+            rust_file_path, image.proxy_level, meta_data, image.pixel_buffer);
+    }
+    if (!ok || !update_image_details(image)) {
+        return false;
+    }
+
+    // EXR files are decoded top-to-bottom.
+    const size_t row_byte_count = image.byte_count / image.height;
+    flip_rows(pixel_data_mut(image.pixel_buffer), row_byte_count,
+              image.height);
+    return true;
+}
+
+// Read any image file format supported by Maya, at full resolution.
+//
+// Must be run on the main thread.
+bool read_image_mimage(CachedImage &image) {
+    auto mimage = MImage();
+    MStatus status =
+        mimage.readFromFile(MString(image.file_path.c_str()), MImage::kByte);
+    if (status != MS::kSuccess) {
+        return false;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    status = mimage.getSize(width, height);
+    if (status != MS::kSuccess) {
+        return false;
+    }
+
+    // Maya always stores 4 channels, bottom-to-top.
+    image.pixel_buffer.resize(mmimage::BufferDataType::kU8, width, height,
+                              kRgbaChannelCount);
+    if (!update_image_details(image)) {
+        return false;
+    }
+    std::memcpy(pixel_data_mut(image.pixel_buffer), mimage.pixels(),
+                image.byte_count);
+    return true;
+}
+
+// Decode the image and record the time taken.
+//
+// The cache must not be locked while this runs.
+bool read_image(CachedImage &image, const bool allow_mimage,
+                double &out_seconds) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    bool ok = false;
+    if (mmimage::is_exr_file_path(rust::Str(image.file_path))) {
+        ok = read_image_exr(image);
+    } else if (allow_mimage) {
+        ok = read_image_mimage(image);
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> duration = end_time - start_time;
+    out_seconds = duration.count();
+    return ok;
+}
+
+// Get an image to decode into, re-using the memory of a previously
+// evicted image if possible.
+CachedImagePtr take_free_image(ImageCache &cache,
+                               const std::string &file_path,
+                               const uint8_t proxy_level) {
+    CachedImagePtr image;
+    if (cache.free_images.empty()) {
+        image = std::make_shared<CachedImage>();
+    } else {
+        image = cache.free_images.back();
+        cache.free_images.pop_back();
+    }
+    image->file_path = file_path;
+    image->proxy_level = proxy_level;
+    return image;
+}
+
+void recycle_image(ImageCache &cache, CachedImagePtr &image) {
+    // Only images that are no longer used anywhere else can be
+    // modified. A small number of images are kept; keeping more
+    // would hide memory from the budget.
+    const size_t max_free_images = cache.thread_count + 1;
+    if ((image.use_count() == 1) &&
+        (cache.free_images.size() < max_free_images)) {
+        cache.free_images.push_back(image);
+    }
+    image.reset();
+}
+
+void evict_image(ImageCache &cache, ImageList::iterator it) {
+    CachedImagePtr image = *it;
+    cache.image_lookup.erase(make_cache_key(image->file_path,
+                                            image->proxy_level));
+    cache.images.erase(it);
+    cache.bytes_resident -= image->byte_count;
+    cache.statistics.eviction_count++;
+    recycle_image(cache, image);
+}
+
+// Evict the least recently used images until 'byte_count' more
+// bytes fit in the memory budget.
+//
+// Images that were not requested by the last prefetch are evicted
+// first. Requested images are only evicted if 'evict_requested' is
+// true.
+bool make_room(ImageCache &cache, const size_t byte_count,
+               const bool evict_requested) {
+    auto has_room = [&]() {
+        return (cache.bytes_resident + byte_count) <=
+               cache.memory_budget_bytes;
+    };
+
+    auto it = cache.images.end();
+    while (!has_room() && (it != cache.images.begin())) {
+        --it;
+        const std::string key =
+            make_cache_key((*it)->file_path, (*it)->proxy_level);
+        const bool is_requested = cache.requested.count(key) > 0;
+        if (is_requested) {
+            continue;
+        }
+        auto evict_it = it;
+        ++it;
+        evict_image(cache, evict_it);
+    }
+
+    while (!has_room() && evict_requested && !cache.images.empty()) {
+        evict_image(cache, std::prev(cache.images.end()));
+    }
+    return has_room();
+}
+
+// Add a decoded image to the cache. Returns false if the image was
+// not added.
+//
+// An image larger than the whole memory budget is never added, so
+// other images are not evicted for it. Prefetched images are dropped
+// when they do not fit without evicting other requested images; the
+// prefetch range is larger than the memory budget, so the remaining
+// prefetch requests are also forgotten. An image read on the main
+// thread is unrelated to the prefetch range, so the prefetch
+// requests are kept.
+bool insert_image(ImageCache &cache, const CachedImagePtr &image,
+                  const bool is_prefetch) {
+    const bool evict_requested = !is_prefetch;
+    const bool fits = (image->byte_count <= cache.memory_budget_bytes) &&
+                      make_room(cache, image->byte_count, evict_requested);
+    if (!fits) {
+        if (is_prefetch) {
+            cache.requests.clear();
+        }
+        return false;
+    }
+
+    cache.images.push_front(image);
+    const std::string key =
+        make_cache_key(image->file_path, image->proxy_level);
+    cache.image_lookup[key] = cache.images.begin();
+    cache.bytes_resident += image->byte_count;
+    cache.last_byte_count = image->byte_count;
+    return true;
+}
+
+// Find an image, and mark it as the most recently used.
+CachedImagePtr find_image(ImageCache &cache, const std::string &key) {
+    auto found = cache.image_lookup.find(key);
+    if (found == cache.image_lookup.end()) {
+        return nullptr;
+    }
+    ImageList::iterator it = found->second;
+    cache.images.splice(cache.images.begin(), cache.images, it);
+    return *it;
+}
+
+void record_decode(ImageCache &cache, const bool ok, const double seconds) {
+    if (ok) {
+        cache.statistics.decode_count++;
+        cache.statistics.decode_seconds += seconds;
+    } else {
+        cache.statistics.decode_failure_count++;
+    }
+}
+
+void reader_thread_loop(ImageCache *cache_ptr) {
+    ImageCache &cache = *cache_ptr;
+    const bool verbose = false;
+
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    while (true) {
+        cache.request_condition.wait(
+            lock, [&]() { return cache.stop || !cache.requests.empty(); });
+        if (cache.stop) {
+            return;
+        }
+
+        const ImageRequest request = cache.requests.front();
+        cache.requests.pop_front();
+        const bool is_cached = cache.image_lookup.count(request.key) > 0;
+        const bool is_decoding = cache.decoding.count(request.key) > 0;
+        const bool is_failed = cache.failed.count(request.key) > 0;
+        if (is_cached || is_decoding || is_failed) {
+            continue;
+        }
+
+        // Do not start decoding an image that will not fit.
+        if (!make_room(cache, cache.last_byte_count,
+                       /*evict_requested=*/false)) {
+            cache.requests.clear();
+            continue;
+        }
+
+        cache.decoding.insert(request.key);
+        CachedImagePtr image =
+            take_free_image(cache, request.file_path, request.proxy_level);
+        const uint64_t clear_count = cache.clear_count;
+        lock.unlock();
+
+        double seconds = 0.0;
+        const bool allow_mimage = false;
+        const bool ok = read_image(*image, allow_mimage, seconds);
+        MMSOLVER_MAYA_VRB("mmImageCache: Prefetched "
+                          << "\"" << request.file_path << "\""
+                          << " proxy_level="
+                          << static_cast<int>(request.proxy_level)
+                          << " ok=" << ok << " seconds=" << seconds);
+
+        lock.lock();
+        cache.decoding.erase(request.key);
+        record_decode(cache, ok, seconds);
+        const bool is_current = clear_count == cache.clear_count;
+        if (!ok && is_current) {
+            cache.failed.insert(request.key);
+        }
+        const bool is_prefetch = true;
+        if (!ok || !is_current || !insert_image(cache, image, is_prefetch)) {
+            recycle_image(cache, image);
+        }
+        cache.decoded_condition.notify_all();
+    }
+}
+
+void start_reader_threads(ImageCache &cache) {
+    while (cache.threads.size() < cache.thread_count) {
+        cache.threads.emplace_back(reader_thread_loop, &cache);
+    }
+}
+
+}  // namespace
+
+const void *cached_image_pixel_data(CachedImage &image) {
+    if (image.byte_count == 0) {
+        return nullptr;
+    }
+    return pixel_data_mut(image.pixel_buffer);
+}
+
+std::string image_sequence_file_path(const std::string &file_pattern,
+                                     const int32_t frame) {
+    const rust::String file_path = mmimage::image_sequence_frame_file_path(
+        rust::Str(file_pattern), frame);
+    return std::string(file_path);
+}
+
+CachedImagePtr image_cache_get(const std::string &file_path,
+                               const uint8_t requested_proxy_level) {
+    const uint8_t proxy_level =
+        file_proxy_level(file_path, requested_proxy_level);
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+
+    const std::string key = make_cache_key(file_path, proxy_level);
+    CachedImagePtr image = find_image(cache, key);
+    if (image) {
+        cache.statistics.hit_count++;
+        return image;
+    }
+    cache.statistics.miss_count++;
+
+    // The file could not be read before, so it is not read again.
+    if (cache.failed.count(key) > 0) {
+        return nullptr;
+    }
+
+    // A reader thread is already decoding the file.
+    if (cache.decoding.count(key) > 0) {
+        cache.decoded_condition.wait(
+            lock, [&]() { return cache.decoding.count(key) == 0; });
+        image = find_image(cache, key);
+        if (image || (cache.failed.count(key) > 0)) {
+            return image;
+        }
+    }
+
+    cache.decoding.insert(key);
+    image = take_free_image(cache, file_path, proxy_level);
+    const uint64_t clear_count = cache.clear_count;
+    lock.unlock();
+
+    double seconds = 0.0;
+    const bool allow_mimage = true;
+    const bool ok = read_image(*image, allow_mimage, seconds);
+
+    lock.lock();
+    cache.decoding.erase(key);
+    record_decode(cache, ok, seconds);
+    const bool is_current = clear_count == cache.clear_count;
+    if (!ok) {
+        MMSOLVER_MAYA_WRN("mmImageCache: "
+                          << "Image file path could not be read: "
+                          << "\"" << file_path << "\"");
+        if (is_current) {
+            cache.failed.insert(key);
+        }
+        cache.decoded_condition.notify_all();
+        recycle_image(cache, image);
+        return nullptr;
+    }
+    cache.decoded_condition.notify_all();
+    if (is_current) {
+        // An image larger than the memory budget is still returned,
+        // but is not kept in the cache.
+        const bool is_prefetch = false;
+        if (!insert_image(cache, image, is_prefetch)) {
+            MMSOLVER_MAYA_WRN("mmImageCache: "
+                              << "Image is larger than the memory budget: "
+                              << "\"" << file_path << "\"");
+        }
+    }
+    return image;
+}
+
+void image_cache_prefetch(const std::vector<std::string> &file_paths,
+                          const uint8_t proxy_level) {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+
+    cache.requests.clear();
+    cache.requested.clear();
+    for (const std::string &file_path : file_paths) {
+        // Reader threads only decode EXR files; other files are read
+        // by 'image_cache_get' on the main thread.
+        if (!mmimage::is_exr_file_path(rust::Str(file_path))) {
+            continue;
+        }
+
+        ImageRequest request;
+        request.file_path = file_path;
+        request.proxy_level = file_proxy_level(file_path, proxy_level);
+        request.key = make_cache_key(file_path, request.proxy_level);
+        if (cache.failed.count(request.key) > 0) {
+            continue;
+        }
+        cache.requested.insert(request.key);
+        cache.requests.push_back(std::move(request));
+    }
+    if (cache.requests.empty()) {
+        return;
+    }
+    start_reader_threads(cache);
+    cache.request_condition.notify_all();
+}
+
+void image_cache_set_memory_budget(const size_t memory_budget_bytes) {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.memory_budget_bytes = memory_budget_bytes;
+
+    const size_t byte_count = 0;
+    const bool evict_requested = true;
+    make_room(cache, byte_count, evict_requested);
+}
+
+size_t image_cache_memory_budget() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    return cache.memory_budget_bytes;
+}
+
+void image_cache_set_thread_count(const size_t thread_count) {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    if (thread_count == cache.thread_count) {
+        return;
+    }
+
+    cache.stop_reader_threads(lock);
+    cache.thread_count = thread_count;
+    if (!cache.requests.empty()) {
+        start_reader_threads(cache);
+        cache.request_condition.notify_all();
+    }
+}
+
+size_t image_cache_thread_count() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    return cache.thread_count;
+}
+
+void image_cache_clear() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.images.clear();
+    cache.image_lookup.clear();
+    cache.requests.clear();
+    cache.requested.clear();
+    cache.failed.clear();
+    cache.free_images.clear();
+    cache.bytes_resident = 0;
+    cache.clear_count++;
+}
+
+ImageCacheStatistics image_cache_statistics() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    ImageCacheStatistics statistics = cache.statistics;
+    statistics.item_count = cache.images.size();
+    statistics.bytes_resident = cache.bytes_resident;
+    statistics.memory_budget_bytes = cache.memory_budget_bytes;
+    statistics.pending_count = cache.requests.size() + cache.decoding.size();
+    statistics.thread_count = cache.thread_count;
+    return statistics;
+}
+
+void image_cache_reset_statistics() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.statistics = ImageCacheStatistics();
+}
+
+void image_cache_shutdown() {
+    ImageCache &cache = get_image_cache();
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.requests.clear();
+    cache.stop_reader_threads(lock);
+    lock.unlock();
+
+    image_cache_clear();
+}
+
+}  // namespace image
+}  // namespace mmsolver
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * A cache of decoded image files, used to play back image
+ * sequences.
+ *
+ * Images are kept in memory up to a memory budget, and the least
+ * recently used images are evicted first. Frames around the current
+ * time are requested with 'image_cache_prefetch' and decoded by
+ * background reader threads, so that when the viewport asks for a
+ * frame it is usually already in memory.
+ *
+ * Only EXR files are decoded by the reader threads (with 'mmimage'),
+ * other file formats are read with MImage, which is not thread-safe,
+ * so these are only read when requested on the main thread.
+ *
+ * Files that cannot be read are remembered, and are not read again
+ * until the cache is cleared.
+ *
+ * EXR images may be requested at a proxy level (level N is 2^N
+ * times smaller), which are read from the proxy files written by
+ * 'mmConvertImage -proxyLevels'. Each level of a file is cached
+ * separately.
+ */
+
+#ifndef MM_SOLVER_IMAGE_IMAGE_CACHE_H
+#define MM_SOLVER_IMAGE_IMAGE_CACHE_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// MM Solver Libs
+#include <mmimage/mmimage.h>
+
+namespace mmsolver {
+namespace image {
+
+// 2 GigaBytes.
+const size_t kImageCacheDefaultMemoryBudgetBytes =
+    2ULL * 1024ULL * 1024ULL * 1024ULL;
+
+const size_t kImageCacheDefaultThreadCount = 2;
+
+// The decoded pixels of one image file.
+//
+// Pixels are stored as interleaved RGBA channels, with rows stored
+// bottom-to-top (the same as MImage and viewport textures). EXR
+// files keep their half or full float data type, other files are
+// stored as 8-bit.
+//
+// The pixels must not be modified; the same image may be shared by
+// many users.
+struct CachedImage {
+    std::string file_path;
+    uint8_t proxy_level;
+    mmimage::ImagePixelBuffer pixel_buffer;
+    size_t width;
+    size_t height;
+    mmimage::BufferDataType data_type;
+    size_t byte_count;
+
+    CachedImage()
+        : file_path()
+        , proxy_level(0)
+        , pixel_buffer()
+        , width(0)
+        , height(0)
+        , data_type(mmimage::BufferDataType::kNone)
+        , byte_count(0) {}
+};
+
+using CachedImagePtr = std::shared_ptr<CachedImage>;
+
+// A pointer to the first pixel of the image, or nullptr if the image
+// has no pixels.
+const void *cached_image_pixel_data(CachedImage &image);
+
+// Replace the last run of '#' characters in 'file_pattern' with the
+// frame number, padded with zeros to the number of '#' characters,
+// using 'mmimage::image_sequence_frame_file_path'.
+//
+// For example "plate.####.exr" at frame 42 is "plate.0042.exr". The
+// pattern is returned unchanged if it does not contain '#'.
+std::string image_sequence_file_path(const std::string &file_pattern,
+                                     const int32_t frame);
+
+struct ImageCacheStatistics {
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t decode_count;
+    uint64_t decode_failure_count;
+    uint64_t eviction_count;
+    double decode_seconds;
+    size_t item_count;
+    size_t bytes_resident;
+    size_t memory_budget_bytes;
+    size_t pending_count;
+    size_t thread_count;
+
+    ImageCacheStatistics()
+        : hit_count(0)
+        , miss_count(0)
+        , decode_count(0)
+        , decode_failure_count(0)
+        , eviction_count(0)
+        , decode_seconds(0.0)
+        , item_count(0)
+        , bytes_resident(0)
+        , memory_budget_bytes(0)
+        , pending_count(0)
+        , thread_count(0) {}
+
+    // The fraction of lookups that found the image in memory, 0.0 to
+    // 1.0.
+    double hit_rate() const {
+        const uint64_t lookup_count = hit_count + miss_count;
+        if (lookup_count == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(hit_count) /
+               static_cast<double>(lookup_count);
+    }
+
+    // The average time taken to decode one image, in seconds.
+    double mean_decode_seconds() const {
+        if (decode_count == 0) {
+            return 0.0;
+        }
+        return decode_seconds / static_cast<double>(decode_count);
+    }
+};
+
+// Get the decoded image for 'file_path', at 'proxy_level'.
+//
+// If the image is not in the cache it is read immediately, blocking
+// the caller (if a reader thread is already decoding the file, the
+// caller waits for it). Returns nullptr if the file cannot be read.
+// An image larger than the memory budget is returned, but is not
+// kept in the cache.
+//
+// When the proxy level does not exist on disk, the nearest lower
+// level is returned, so the image size may be larger than requested.
+// Files other than EXR have no proxy levels; they are read (and
+// cached) once at full resolution, for any requested level.
+//
+// Must be called from the main thread.
+CachedImagePtr image_cache_get(const std::string &file_path,
+                               const uint8_t proxy_level = 0);
+
+// Request the images to be decoded in the background, in the order
+// given (the most important first).
+//
+// Only EXR files are decoded in the background; other files are
+// ignored. Any previously requested images that have not started
+// decoding are forgotten. Images in this list are preferred over other
+// images when the cache must evict images to stay under the memory
+// budget.
+void image_cache_prefetch(const std::vector<std::string> &file_paths,
+                          const uint8_t proxy_level = 0);
+
+void image_cache_set_memory_budget(const size_t memory_budget_bytes);
+size_t image_cache_memory_budget();
+
+// Change the number of background reader threads. Zero disables
+// background reading.
+void image_cache_set_thread_count(const size_t thread_count);
+size_t image_cache_thread_count();
+
+// Remove all images from the cache, and forget prefetch requests and
+// files that could not be read.
+void image_cache_clear();
+
+ImageCacheStatistics image_cache_statistics();
+void image_cache_reset_statistics();
+
+// Stop all reader threads and release all memory. Must be called
+// before the plug-in is unloaded.
+void image_cache_shutdown();
+
+}  // namespace image
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_IMAGE_IMAGE_CACHE_H
@@ -0,0 +1,569 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Image file reading utilities.
+ *
+ * The header parsers only read the few bytes needed to find the
+ * image size, so they are cheap even on slow network storage.
+ *
+ * File format references:
+ * - PNG: https://www.w3.org/TR/png/#11IHDR
+ * - JPEG: ITU T.81, Annex B.
+ * - TIFF: TIFF Revision 6.0, Section 2.
+ * - DPX: SMPTE 268M, generic image information header.
+ * - Maya IFF: Autodesk Maya "IFF" (EA-IFF-85 based) image format.
+ */
+
+#include "image_io.h"
+
+// STL
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Platform
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// Maya
+#include <maya/MImage.h>
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+
+// MM Solver Libs
+#include <mmimage/mmimage.h>
+
+// MM Solver
+#include "image_cache.h"
+
+namespace mmsolver {
+namespace image {
+
+namespace {
+
+// Enough bytes to detect every supported format, and to read the
+// PNG size directly.
+const size_t kHeaderByteCount = 32;
+
+// Protect against corrupt TIFF files with an unreasonable number of
+// directory entries.
+const uint16_t kTiffMaxDirectoryEntries = 4096;
+
+// When the cache grows larger than this, it is cleared.
+const size_t kImageSizeCacheMaxCount = 16384;
+
+enum class ImageFileFormat : uint8_t {
+    kUnknown = 0,
+    kEXR,
+    kDPX,
+    kJPEG,
+    kPNG,
+    kTIFF,
+    kIFF,
+};
+
+inline uint16_t read_u16_be(const uint8_t *data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+inline uint16_t read_u16_le(const uint8_t *data) {
+    return static_cast<uint16_t>((data[1] << 8) | data[0]);
+}
+
+inline uint32_t read_u32_be(const uint8_t *data) {
+    return (static_cast<uint32_t>(data[0]) << 24) |
+           (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) |
+           static_cast<uint32_t>(data[3]);
+}
+
+inline uint32_t read_u32_le(const uint8_t *data) {
+    return (static_cast<uint32_t>(data[3]) << 24) |
+           (static_cast<uint32_t>(data[2]) << 16) |
+           (static_cast<uint32_t>(data[1]) << 8) |
+           static_cast<uint32_t>(data[0]);
+}
+
+bool read_bytes(std::ifstream &stream, const uint64_t offset, uint8_t *out_data,
+                const size_t byte_count) {
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    if (!stream.good()) {
+        return false;
+    }
+    stream.read(reinterpret_cast<char *>(out_data),
+                static_cast<std::streamsize>(byte_count));
+    return static_cast<size_t>(stream.gcount()) == byte_count;
+}
+
+ImageFileFormat detect_image_file_format(const uint8_t *header,
+                                         const size_t header_size) {
+    if (header_size < 12) {
+        return ImageFileFormat::kUnknown;
+    }
+
+    const uint8_t png_signature[8] = {0x89, 'P',  'N',  'G',
+                                      '\r', '\n', 0x1A, '\n'};
+    if (std::memcmp(header, png_signature, 8) == 0) {
+        return ImageFileFormat::kPNG;
+    }
+
+    if ((header[0] == 0x76) && (header[1] == 0x2F) && (header[2] == 0x31) &&
+        (header[3] == 0x01)) {
+        return ImageFileFormat::kEXR;
+    }
+
+    if ((header[0] == 0xFF) && (header[1] == 0xD8) && (header[2] == 0xFF)) {
+        return ImageFileFormat::kJPEG;
+    }
+
+    if ((std::memcmp(header, "II*\0", 4) == 0) ||
+        (std::memcmp(header, "MM\0*", 4) == 0)) {
+        return ImageFileFormat::kTIFF;
+    }
+
+    if ((std::memcmp(header, "SDPX", 4) == 0) ||
+        (std::memcmp(header, "XPDS", 4) == 0)) {
+        return ImageFileFormat::kDPX;
+    }
+
+    if ((std::memcmp(header, "FOR4", 4) == 0) &&
+        (std::memcmp(header + 8, "CIMG", 4) == 0)) {
+        return ImageFileFormat::kIFF;
+    }
+
+    return ImageFileFormat::kUnknown;
+}
+
+bool read_png_size(const uint8_t *header, const size_t header_size,
+                   uint32_t &out_width, uint32_t &out_height) {
+    // The IHDR chunk must be the first chunk.
+    if ((header_size < 24) || (std::memcmp(header + 12, "IHDR", 4) != 0)) {
+        return false;
+    }
+    out_width = read_u32_be(header + 16);
+    out_height = read_u32_be(header + 20);
+    return true;
+}
+
+bool read_exr_size(const MString &file_path, uint32_t &out_width,
+                   uint32_t &out_height) {
+    auto meta_data = mmimage::ImageMetaData();
+    const auto rust_file_path = rust::Str(file_path.asChar());
+    if (!mmimage::image_read_metadata_exr(rust_file_path, meta_data)) {
+        return false;
+    }
+    const mmimage::ImageRegionRectangle display_window =
+        meta_data.get_display_window();
+    out_width = static_cast<uint32_t>(display_window.size_x);
+    out_height = static_cast<uint32_t>(display_window.size_y);
+    return true;
+}
+
+bool read_dpx_size(std::ifstream &stream, const uint8_t *header,
+                   uint32_t &out_width, uint32_t &out_height) {
+    const bool big_endian = std::memcmp(header, "SDPX", 4) == 0;
+
+    // 'pixels_per_line' and 'lines_per_element' in the image
+    // information header.
+    const uint64_t offset = 772;
+    uint8_t data[8];
+    if (!read_bytes(stream, offset, data, 8)) {
+        return false;
+    }
+    if (big_endian) {
+        out_width = read_u32_be(data);
+        out_height = read_u32_be(data + 4);
+    } else {
+        out_width = read_u32_le(data);
+        out_height = read_u32_le(data + 4);
+    }
+    return true;
+}
+
+bool read_jpeg_size(std::ifstream &stream, uint32_t &out_width,
+                    uint32_t &out_height) {
+    // Walk the marker segments, until a "start of frame" segment.
+    uint64_t offset = 2;
+    uint8_t data[5];
+    while (read_bytes(stream, offset, data, 2)) {
+        if (data[0] != 0xFF) {
+            return false;
+        }
+        const uint8_t marker = data[1];
+        if (marker == 0xFF) {
+            // Fill byte.
+            offset += 1;
+            continue;
+        }
+        if ((marker == 0x01) || (marker == 0xD8) ||
+            ((marker >= 0xD0) && (marker <= 0xD7))) {
+            // Stand-alone markers, without a segment length.
+            offset += 2;
+            continue;
+        }
+        if ((marker == 0xD9) || (marker == 0xDA)) {
+            // End of image, or start of scan data; there is no
+            // frame header.
+            return false;
+        }
+
+        if (!read_bytes(stream, offset + 2, data, 2)) {
+            return false;
+        }
+        const uint16_t segment_length = read_u16_be(data);
+        if (segment_length < 2) {
+            return false;
+        }
+
+        // SOF0 to SOF15, except DHT (0xC4), JPG (0xC8) and DAC (0xCC).
+        const bool start_of_frame = (marker >= 0xC0) && (marker <= 0xCF) &&
+                                    (marker != 0xC4) && (marker != 0xC8) &&
+                                    (marker != 0xCC);
+        if (start_of_frame) {
+            // Sample precision (1 byte), then height and width.
+            if (!read_bytes(stream, offset + 4, data, 5)) {
+                return false;
+            }
+            out_height = read_u16_be(data + 1);
+            out_width = read_u16_be(data + 3);
+            return true;
+        }
+
+        offset += 2 + segment_length;
+    }
+    return false;
+}
+
+bool read_tiff_size(std::ifstream &stream, const uint8_t *header,
+                    uint32_t &out_width, uint32_t &out_height) {
+    const bool little_endian = header[0] == 'I';
+    auto read_u16 = little_endian ? read_u16_le : read_u16_be;
+    auto read_u32 = little_endian ? read_u32_le : read_u32_be;
+
+    // The first image file directory (IFD).
+    const uint32_t ifd_offset = read_u32(header + 4);
+    uint8_t data[12];
+    if (!read_bytes(stream, ifd_offset, data, 2)) {
+        return false;
+    }
+    const uint16_t entry_count = read_u16(data);
+    if (entry_count > kTiffMaxDirectoryEntries) {
+        return false;
+    }
+
+    const uint16_t tag_image_width = 256;
+    const uint16_t tag_image_length = 257;
+    const uint16_t type_short = 3;
+    const uint16_t type_long = 4;
+
+    bool found_width = false;
+    bool found_height = false;
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        const uint64_t entry_offset =
+            static_cast<uint64_t>(ifd_offset) + 2 + (i * 12);
+        if (!read_bytes(stream, entry_offset, data, 12)) {
+            return false;
+        }
+        const uint16_t tag = read_u16(data);
+        if ((tag != tag_image_width) && (tag != tag_image_length)) {
+            continue;
+        }
+
+        // Values are left-justified in the 4 byte value field.
+        const uint16_t type = read_u16(data + 2);
+        uint32_t value = 0;
+        if (type == type_short) {
+            value = read_u16(data + 8);
+        } else if (type == type_long) {
+            value = read_u32(data + 8);
+        } else {
+            return false;
+        }
+
+        if (tag == tag_image_width) {
+            out_width = value;
+            found_width = true;
+        } else {
+            out_height = value;
+            found_height = true;
+        }
+        if (found_width && found_height) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool read_iff_size(std::ifstream &stream, const uint8_t *header,
+                   uint32_t &out_width, uint32_t &out_height) {
+    // Chunks inside the "FOR4 <size> CIMG" form, each is a 4 byte tag
+    // and 4 byte size, padded to 4 byte alignment.
+    const uint64_t form_size = read_u32_be(header + 4);
+    const uint64_t form_end = 8 + form_size;
+    uint64_t offset = 12;
+    uint8_t data[8];
+    while ((offset + 8) <= form_end) {
+        if (!read_bytes(stream, offset, data, 8)) {
+            return false;
+        }
+        const uint32_t chunk_size = read_u32_be(data + 4);
+        if (std::memcmp(data, "TBHD", 4) == 0) {
+            if ((chunk_size < 8) || !read_bytes(stream, offset + 8, data, 8)) {
+                return false;
+            }
+            out_width = read_u32_be(data);
+            out_height = read_u32_be(data + 4);
+            return true;
+        }
+        if (std::memcmp(data, "FOR4", 4) == 0) {
+            // The pixel data; the header must come before it.
+            return false;
+        }
+        const uint64_t aligned_size = (static_cast<uint64_t>(chunk_size) + 3) &
+                                      ~static_cast<uint64_t>(3);
+        offset += 8 + aligned_size;
+    }
+    return false;
+}
+
+bool read_image_size_with_mimage(const MString &file_path,
+                                 uint32_t &out_width, uint32_t &out_height) {
+    auto image = MImage();
+    // kUnknown attempts to load the native pixel type.
+    auto pixel_type = MImage::kUnknown;
+    MStatus status = image.readFromFile(file_path, pixel_type);
+    if (status != MS::kSuccess) {
+        return false;
+    }
+    image.getSize(out_width, out_height);
+    return true;
+}
+
+struct ImageSizeCacheEntry {
+    int64_t modified_time;
+    int64_t file_size;
+    uint32_t width;
+    uint32_t height;
+};
+
+std::mutex g_image_size_cache_mutex;
+std::unordered_map<std::string, ImageSizeCacheEntry> g_image_size_cache;
+
+bool get_file_modified_time_and_size(const char *file_path,
+                                     int64_t &out_modified_time,
+                                     int64_t &out_file_size) {
+    struct stat file_stat;
+    if (stat(file_path, &file_stat) != 0) {
+        return false;
+    }
+    out_modified_time = static_cast<int64_t>(file_stat.st_mtime);
+    out_file_size = static_cast<int64_t>(file_stat.st_size);
+    return true;
+}
+
+bool read_exr_sequence_info(const std::string &file_pattern,
+                            const int32_t start_frame,
+                            const int32_t end_frame,
+                            const size_t thread_count,
+                            ImageSequenceInfo &out_info) {
+    auto frames = rust::Vec<mmimage::ImageSequenceFrameMetaData>();
+    auto summary = mmimage::ImageSequenceMetaDataSummary();
+    const auto rust_file_pattern = rust::Str(file_pattern.c_str());
+    const bool ok = mmimage::image_read_metadata_exr_sequence(
+        rust_file_pattern, start_frame, end_frame, thread_count, frames,
+        summary);
+    if (!ok || (summary.missing_frame_count == summary.frame_count)) {
+        return false;
+    }
+
+    // Each frame is compared with the reference frame by 'mmimage'.
+    out_info.width = static_cast<uint32_t>(summary.display_window.size_x);
+    out_info.height = static_cast<uint32_t>(summary.display_window.size_y);
+    for (const auto &frame : frames) {
+        if (!frame.exists) {
+            out_info.missing_frames.push_back(frame.frame);
+            continue;
+        }
+        if (!frame.consistent) {
+            out_info.inconsistent_frames.push_back(frame.frame);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool read_image_size_from_header(const MString &file_path,
+                                 uint32_t &out_width, uint32_t &out_height) {
+    std::ifstream stream(file_path.asChar(),
+                         std::ios::in | std::ios::binary);
+    if (!stream.is_open()) {
+        return false;
+    }
+
+    uint8_t header[kHeaderByteCount];
+    stream.read(reinterpret_cast<char *>(header), kHeaderByteCount);
+    const size_t header_size = static_cast<size_t>(stream.gcount());
+    const ImageFileFormat format =
+        detect_image_file_format(header, header_size);
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool ok = false;
+    switch (format) {
+        case ImageFileFormat::kPNG:
+            ok = read_png_size(header, header_size, width, height);
+            break;
+        case ImageFileFormat::kEXR:
+            stream.close();
+            ok = read_exr_size(file_path, width, height);
+            break;
+        case ImageFileFormat::kDPX:
+            ok = read_dpx_size(stream, header, width, height);
+            break;
+        case ImageFileFormat::kJPEG:
+            ok = read_jpeg_size(stream, width, height);
+            break;
+        case ImageFileFormat::kTIFF:
+            ok = read_tiff_size(stream, header, width, height);
+            break;
+        case ImageFileFormat::kIFF:
+            ok = read_iff_size(stream, header, width, height);
+            break;
+        case ImageFileFormat::kUnknown:
+        default:
+            ok = false;
+            break;
+    }
+
+    if (!ok || (width == 0) || (height == 0)) {
+        return false;
+    }
+    out_width = width;
+    out_height = height;
+    return true;
+}
+
+bool read_image_size(const MString &file_path, uint32_t &out_width,
+                     uint32_t &out_height) {
+    const std::string key(file_path.asChar());
+
+    int64_t modified_time = 0;
+    int64_t file_size = 0;
+    const bool has_stat = get_file_modified_time_and_size(
+        file_path.asChar(), modified_time, file_size);
+    if (has_stat) {
+        std::lock_guard<std::mutex> lock(g_image_size_cache_mutex);
+        auto search = g_image_size_cache.find(key);
+        if (search != g_image_size_cache.end()) {
+            const ImageSizeCacheEntry &entry = search->second;
+            if ((entry.modified_time == modified_time) &&
+                (entry.file_size == file_size)) {
+                out_width = entry.width;
+                out_height = entry.height;
+                return true;
+            }
+        }
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool ok = read_image_size_from_header(file_path, width, height);
+    if (!ok) {
+        ok = read_image_size_with_mimage(file_path, width, height);
+    }
+    if (!ok) {
+        return false;
+    }
+
+    if (has_stat) {
+        std::lock_guard<std::mutex> lock(g_image_size_cache_mutex);
+        if (g_image_size_cache.size() >= kImageSizeCacheMaxCount) {
+            g_image_size_cache.clear();
+        }
+        ImageSizeCacheEntry entry;
+        entry.modified_time = modified_time;
+        entry.file_size = file_size;
+        entry.width = width;
+        entry.height = height;
+        g_image_size_cache[key] = entry;
+    }
+
+    out_width = width;
+    out_height = height;
+    return true;
+}
+
+void clear_image_size_cache() {
+    std::lock_guard<std::mutex> lock(g_image_size_cache_mutex);
+    g_image_size_cache.clear();
+}
+
+size_t image_size_cache_count() {
+    std::lock_guard<std::mutex> lock(g_image_size_cache_mutex);
+    return g_image_size_cache.size();
+}
+
+bool read_image_sequence_info(const MString &file_pattern,
+                              const int32_t start_frame,
+                              const int32_t end_frame,
+                              const size_t thread_count,
+                              ImageSequenceInfo &out_info) {
+    out_info = ImageSequenceInfo();
+    if (end_frame < start_frame) {
+        return false;
+    }
+
+    const std::string pattern(file_pattern.asChar());
+    if (mmimage::is_exr_file_path(rust::Str(pattern))) {
+        return read_exr_sequence_info(pattern, start_frame, end_frame,
+                                      thread_count, out_info);
+    }
+
+    // Other file formats may need MImage, which is not thread-safe,
+    // so the frames are read one at a time.
+    bool has_reference = false;
+    for (int32_t frame = start_frame; frame <= end_frame; ++frame) {
+        const std::string file_path =
+            image_sequence_file_path(pattern, frame);
+        uint32_t width = 0;
+        uint32_t height = 0;
+        const bool ok =
+            read_image_size(MString(file_path.c_str()), width, height);
+        if (!ok) {
+            out_info.missing_frames.push_back(frame);
+            continue;
+        }
+        if (!has_reference) {
+            has_reference = true;
+            out_info.width = width;
+            out_info.height = height;
+        } else if ((width != out_info.width) || (height != out_info.height)) {
+            out_info.inconsistent_frames.push_back(frame);
+        }
+    }
+    return has_reference;
+}
+
+}  // namespace image
+}  // namespace mmsolver
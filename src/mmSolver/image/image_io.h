@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Image file reading utilities.
+ */
+
+#ifndef MM_SOLVER_IMAGE_IMAGE_IO_H
+#define MM_SOLVER_IMAGE_IMAGE_IO_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Maya
+#include <maya/MString.h>
+
+namespace mmsolver {
+namespace image {
+
+// Read the width and height of an image by parsing only the file
+// header, without decoding any pixels.
+//
+// Supports EXR, DPX, JPEG, PNG, TIFF and Maya IFF files, detected
+// from the file contents, not the file extension.
+//
+// Returns false if the file could not be read, or the format is not
+// supported.
+bool read_image_size_from_header(const MString &file_path,
+                                 uint32_t &out_width, uint32_t &out_height);
+
+// Read the width and height of an image.
+//
+// The file header is read when possible, falling back to reading the
+// full image with Maya's MImage. Results are cached, keyed by the
+// file path, modification time and file size, so repeated queries
+// of an unchanged file do not touch the file contents.
+bool read_image_size(const MString &file_path, uint32_t &out_width,
+                     uint32_t &out_height);
+
+// The frames of an image sequence that are missing, or that do not
+// match the first readable frame (the "reference" frame).
+struct ImageSequenceInfo {
+    // The display window size of the reference frame.
+    uint32_t width;
+    uint32_t height;
+
+    std::vector<int32_t> missing_frames;
+    std::vector<int32_t> inconsistent_frames;
+
+    ImageSequenceInfo()
+        : width(0), height(0), missing_frames(), inconsistent_frames() {}
+};
+
+// Read the headers of frames 'start_frame' to 'end_frame'
+// (inclusive) of the image sequence 'file_pattern', where the '#'
+// characters are replaced by the frame number.
+//
+// EXR sequences are read in parallel with 'thread_count' threads
+// (zero uses the default), and frames are compared by display
+// window, data window, pixel aspect and channel count. Other file
+// formats are read one frame at a time, comparing the image size.
+//
+// Returns false if no frame could be read.
+bool read_image_sequence_info(const MString &file_pattern,
+                              const int32_t start_frame,
+                              const int32_t end_frame,
+                              const size_t thread_count,
+                              ImageSequenceInfo &out_info);
+
+// Remove all cached image sizes.
+void clear_image_size_cache();
+
+size_t image_size_cache_count();
+
+}  // namespace image
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_IMAGE_IMAGE_IO_H
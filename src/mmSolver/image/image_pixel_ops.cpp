@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Operations on buffers of image pixels.
+ *
+ * The loops are written over contiguous arrays, without branches in
+ * the inner loops, so the compiler is able to vectorise them.
+ */
+
+#include "image_pixel_ops.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// MM Solver Libs
+#include <mmimage/mmimage.h>
+
+namespace mmsolver {
+namespace image {
+
+namespace {
+
+// The gamma look up table covers values from 2^-20 to 1.0, with 2^10
+// entries per power of two. Smaller values quantise to zero.
+const uint32_t kGammaTableShift = 13;
+const uint32_t kGammaTableFirstIndex = (127 - 20) << (23 - kGammaTableShift);
+const size_t kGammaTableSize = (20 << (23 - kGammaTableShift)) + 1;
+
+inline uint32_t float_to_bits(const float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float float_from_bits(const uint32_t bits) {
+    float value = 0.0F;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Clamp to 0.0 to 1.0, with NaN becoming 0.0.
+inline float clamp_unit_float(const float value) {
+    const float x = (value > 0.0F) ? value : 0.0F;
+    return (x < 1.0F) ? x : 1.0F;
+}
+
+inline uint8_t quantise_unit_float(const float value) {
+    return static_cast<uint8_t>((clamp_unit_float(value) * 255.0F) + 0.5F);
+}
+
+// The index of the (clamped) value in the gamma look up table.
+inline uint32_t gamma_table_index(const float value) {
+    const uint32_t bits = float_to_bits(clamp_unit_float(value));
+    const uint32_t index = bits >> kGammaTableShift;
+    // Values smaller than the table quantise to zero.
+    return (index > kGammaTableFirstIndex) ? (index - kGammaTableFirstIndex)
+                                           : 0;
+}
+
+}  // namespace
+
+void resize_pixels_rgba32f(const float *src_pixels, const size_t src_width,
+                           const size_t src_height, const size_t dst_width,
+                           const size_t dst_height,
+                           const mmimage::ImageResizeFilter filter,
+                           std::vector<float> &out_pixels) {
+    const size_t channels = kRgbaChannelCount;
+    out_pixels.resize(dst_width * dst_height * channels);
+    if ((src_width == 0) || (src_height == 0) || (dst_width == 0) ||
+        (dst_height == 0)) {
+        return;
+    }
+
+    // The same resize is used by 'mmimage' to write proxy levels.
+    const size_t src_value_count = src_width * src_height * channels;
+    mmimage::image_resize_pixels_f32x4(
+        rust::Slice<const float>(src_pixels, src_value_count), src_width,
+        src_height, filter, dst_width, dst_height,
+        rust::Slice<float>(out_pixels.data(), out_pixels.size()));
+}
+
+void build_gamma_table(const float exponent, GammaTable &out_table) {
+    out_table.exponent = exponent;
+    out_table.values.clear();
+    if (exponent == 1.0F) {
+        return;
+    }
+
+    // The precision of the table is relative to the value, so dark
+    // values are not banded.
+    out_table.values.resize(kGammaTableSize);
+    for (size_t i = 0; i < kGammaTableSize; ++i) {
+        // The center of the range of values for the index.
+        const uint32_t bits = static_cast<uint32_t>(
+            ((i + kGammaTableFirstIndex) << kGammaTableShift) |
+            (1U << (kGammaTableShift - 1)));
+        const float value = std::min(float_from_bits(bits), 1.0F);
+        const float corrected = std::pow(value, exponent);
+        out_table.values[i] = quantise_unit_float(corrected);
+    }
+    // Zero and one must map exactly to black and white.
+    out_table.values[0] = 0;
+    out_table.values[kGammaTableSize - 1] = 255;
+}
+
+void convert_pixels_rgba32f_to_rgba8(const float *src_pixels,
+                                     const size_t pixel_count,
+                                     const GammaTable &gamma_table,
+                                     uint8_t *out_pixels) {
+    const size_t channels = kRgbaChannelCount;
+
+    if (gamma_table.values.empty()) {
+        const size_t value_count = pixel_count * channels;
+        for (size_t i = 0; i < value_count; ++i) {
+            out_pixels[i] = quantise_unit_float(src_pixels[i]);
+        }
+        return;
+    }
+
+    const uint8_t *table = gamma_table.values.data();
+    for (size_t i = 0; i < pixel_count; ++i) {
+        const float *src = src_pixels + (i * channels);
+        uint8_t *dst = out_pixels + (i * channels);
+        dst[0] = table[gamma_table_index(src[0])];
+        dst[1] = table[gamma_table_index(src[1])];
+        dst[2] = table[gamma_table_index(src[2])];
+        // Alpha does not need to be gamma corrected.
+        dst[3] = quantise_unit_float(src[3]);
+    }
+}
+
+void convert_pixels_rgba8_to_rgba32f(const uint8_t *src_pixels,
+                                     const size_t pixel_count,
+                                     float *out_pixels) {
+    const float scale = 1.0F / 255.0F;
+    const size_t value_count = pixel_count * kRgbaChannelCount;
+    for (size_t i = 0; i < value_count; ++i) {
+        out_pixels[i] = static_cast<float>(src_pixels[i]) * scale;
+    }
+}
+
+void flip_rows(void *pixels, const size_t row_byte_count,
+               const size_t row_count) {
+    auto bytes = static_cast<uint8_t *>(pixels);
+    std::vector<uint8_t> temp_row(row_byte_count);
+    for (size_t y = 0; y < (row_count / 2); ++y) {
+        uint8_t *top_row = bytes + (y * row_byte_count);
+        uint8_t *bottom_row = bytes + ((row_count - 1 - y) * row_byte_count);
+        std::memcpy(temp_row.data(), top_row, row_byte_count);
+        std::memcpy(top_row, bottom_row, row_byte_count);
+        std::memcpy(bottom_row, temp_row.data(), row_byte_count);
+    }
+}
+
+}  // namespace image
+}  // namespace mmsolver
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Operations on buffers of image pixels.
+ *
+ * Pixels are stored as interleaved RGBA channels, row by row, with
+ * no padding between rows.
+ */
+
+#ifndef MM_SOLVER_IMAGE_IMAGE_PIXEL_OPS_H
+#define MM_SOLVER_IMAGE_IMAGE_PIXEL_OPS_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// MM Solver Libs
+#include <mmimage/mmimage.h>
+
+namespace mmsolver {
+namespace image {
+
+const size_t kRgbaChannelCount = 4;
+
+// Resize an image using a separable filter, with
+// 'mmimage::image_resize_pixels_f32x4'.
+//
+// When down-sizing, the filter is widened so that every source pixel
+// contributes to the output. Pixel centers are aligned, so the image
+// is not shifted.
+void resize_pixels_rgba32f(const float *src_pixels, const size_t src_width,
+                           const size_t src_height, const size_t dst_width,
+                           const size_t dst_height,
+                           const mmimage::ImageResizeFilter filter,
+                           std::vector<float> &out_pixels);
+
+// Look up table of gamma corrected 8-bit values, indexed by the
+// exponent and top mantissa bits of a floating-point value.
+//
+// Build the table once with 'build_gamma_table' and share it between
+// threads; it is only read when converting pixels.
+struct GammaTable {
+    float exponent;
+    std::vector<uint8_t> values;
+
+    GammaTable() : exponent(1.0F), values() {}
+};
+
+// An exponent of 1.0 does not need a table, so 'values' is left
+// empty.
+void build_gamma_table(const float exponent, GammaTable &out_table);
+
+// Convert floating-point pixels to 8-bit.
+//
+// The RGB channels are raised to the power of the 'gamma_table'
+// exponent (for gamma correction), and all channels are clamped to
+// 0.0 to 1.0 and quantised to 0 to 255. Alpha is not gamma
+// corrected.
+void convert_pixels_rgba32f_to_rgba8(const float *src_pixels,
+                                     const size_t pixel_count,
+                                     const GammaTable &gamma_table,
+                                     uint8_t *out_pixels);
+
+// Convert 8-bit pixels to floating-point, in the range 0.0 to 1.0.
+void convert_pixels_rgba8_to_rgba32f(const uint8_t *src_pixels,
+                                     const size_t pixel_count,
+                                     float *out_pixels);
+
+// Reverse the order of the rows of the image, in-place.
+void flip_rows(void *pixels, const size_t row_byte_count,
+               const size_t row_count);
+
+}  // namespace image
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_IMAGE_IMAGE_PIXEL_OPS_H
@@ -25,9 +25,10 @@
 #include "maya_attr.h"
 
 // STL
-#include <cassert>  // assert
-#include <cmath>    // trunc, isfinite
-#include <limits>   // numeric_limits<double>::max and min
+#include <algorithm>  // fill
+#include <cassert>    // assert
+#include <cmath>      // trunc, isfinite
+#include <limits>     // numeric_limits<double>::max and min
 
 // Provides C++ compatibility.
 // Between Maya 2018 and 2020.
@@ -536,6 +537,80 @@ MStatus Attr::getValue(MMatrix &value, const MTime &time,
     return status;
 }
 
+MStatus Attr::getValues(std::vector<double> &values, const MTimeArray &times,
+                        const int timeEvalMode) {
+    MStatus status;
+    const bool connected = Attr::isConnected();
+    const bool animated = Attr::isAnimated();
+    MPlug plug = Attr::getPlug();
+    const bool use_dg_ctx = useDgContext(timeEvalMode);
+
+    // The animation curve can only be evaluated directly (without the
+    // DG) when it is evaluated with time. A curve with a connected
+    // input (such as a driven key) depends on other attributes, so it
+    // is evaluated through the DG like any other connection.
+    MObject anim_curve_node;
+    bool use_anim_curve = false;
+    if (animated) {
+        anim_curve_node = plug.source().node();
+        MFnDependencyNode curve_node_fn(anim_curve_node, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        const bool want_networked_plug = true;
+        MPlug input_plug =
+            curve_node_fn.findPlug("input", want_networked_plug, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        use_anim_curve = !input_plug.isDestination();
+    }
+
+    const uint32_t time_count = times.length();
+    values.resize(time_count);
+    if (use_anim_curve) {
+        MFnAnimCurve curveFn(anim_curve_node, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        for (uint32_t i = 0; i < time_count; ++i) {
+            status = curveFn.evaluate(times[i], values[i]);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+        }
+    } else if (connected) {
+        for (uint32_t i = 0; i < time_count; ++i) {
+            const MTime time = times[i];
+            if (use_dg_ctx) {
+#if MAYA_API_VERSION >= 20180000
+                MDGContext ctx(time);
+                MDGContextGuard ctxGuard(ctx);
+                values[i] = plug.asDouble(&status);
+#else
+                MDGContext ctx(time);
+                values[i] = plug.asDouble(ctx, &status);
+#endif
+            } else {
+                MAnimControl::setCurrentTime(time);
+#if MAYA_API_VERSION >= 20180000
+                MDGContext ctx = MDGContext::current();
+                MDGContextGuard ctxGuard(ctx);
+                values[i] = plug.asDouble(&status);
+#else
+                values[i] = plug.asDouble(MDGContext::fsNormal, &status);
+#endif
+            }
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+        }
+    } else {
+        // A static value is the same at all times.
+        const double value = plug.asDouble();
+        std::fill(values.begin(), values.end(), value);
+    }
+
+    auto attrType = Attr::getAttrType();
+    if (attrType == AttrDataType::kAngle) {
+        for (uint32_t i = 0; i < time_count; ++i) {
+            values[i] *= m_angularFactor;
+        }
+    }
+    return MS::kSuccess;
+}
+
 MStatus Attr::getValue(bool &value, const int timeEvalMode) {
     MTime time = MAnimControl::currentTime();
     return Attr::getValue(value, time, timeEvalMode);
@@ -32,6 +32,7 @@
 #include <maya/MPlug.h>
 #include <maya/MString.h>
 #include <maya/MTime.h>
+#include <maya/MTimeArray.h>
 
 #include <memory>
 #include <vector>
@@ -336,6 +337,17 @@ public:
     MStatus getValue(double &value, const int timeEvalMode);
     MStatus getValue(MMatrix &value, const int timeEvalMode);
 
+    // Get the (double) value at each of 'times', in the same order.
+    // Reading many times at once avoids re-querying the attribute
+    // state (and re-creating the animation curve function set) for
+    // each time. Animation curves evaluated with time are evaluated
+    // directly; all other connections (such as driven-keys, or a
+    // curve with a connected 'input') are evaluated through the DG,
+    // as 'getValue'. Used by the scene graph to sample animated
+    // attributes.
+    MStatus getValues(std::vector<double> &values, const MTimeArray &times,
+                      const int timeEvalMode);
+
     MStatus setValue(const double value, const MTime &time, MDGModifier &dgmod,
                      MAnimCurveChange &animChange);
 
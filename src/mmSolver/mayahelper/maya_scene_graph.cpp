@@ -24,6 +24,8 @@
 // STL
 #include <limits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 // Maya
 #include <maya/MComputation.h>
@@ -32,6 +34,8 @@
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnTransform.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
 #include <maya/MTime.h>
@@ -58,6 +62,116 @@ namespace mmsg = mmscenegraph;
 using StringToAttrIdMap = std::unordered_map<std::string, mmsg::AttrId>;
 using StringToNodeIdMap = std::unordered_map<std::string, mmsg::NodeId>;
 
+struct MObjectHandleHash {
+    std::size_t operator()(const MObjectHandle &handle) const {
+        return static_cast<std::size_t>(handle.hashCode());
+    }
+};
+
+using ObjectToNodeIdMap =
+    std::unordered_map<MObjectHandle, mmsg::NodeId, MObjectHandleHash>;
+
+// A node and attribute pair, uniquely identifying a Maya plug.
+struct NodeAttrHandle {
+    MObjectHandle node;
+    MObjectHandle attribute;
+
+    bool operator==(const NodeAttrHandle &other) const {
+        return (node == other.node) && (attribute == other.attribute);
+    }
+};
+
+struct NodeAttrHandleHash {
+    std::size_t operator()(const NodeAttrHandle &key) const {
+        auto node_hash = static_cast<std::size_t>(key.node.hashCode());
+        auto attr_hash = static_cast<std::size_t>(key.attribute.hashCode());
+        return node_hash ^
+               (attr_hash + 0x9e3779b9 + (node_hash << 6) + (node_hash >> 2));
+    }
+};
+
+// Maps Maya attributes to the mmSceneGraph AttrId created for them.
+//
+// Attributes are looked up by their node and attribute MObjectHandle
+// in O(1), without needing to build the attribute's full DAG path
+// name. The full name is only used as a fallback for attributes
+// that cannot be resolved to MObjects, so the names are only built
+// the first time the fallback is needed.
+//
+// Every attribute sampled from Maya is also recorded, so the caller
+// can re-sample the values when the Maya attribute changes.
+struct AttrToAttrIdMap {
+    std::unordered_map<NodeAttrHandle, mmsg::AttrId, NodeAttrHandleHash>
+        handle_map;
+    std::vector<SceneGraphAttrSample> samples;
+
+    // Attributes inserted since 'name_map' was last updated. Both
+    // are updated by 'find', and are therefore mutable.
+    mutable std::vector<std::pair<Attr, mmsg::AttrId>> unnamed_attrs;
+    mutable StringToAttrIdMap name_map;
+
+    void record_sample(Attr &attr, const MString &attr_name,
+                       const mmsg::AttrId attr_id, const double scaleFactor) {
+        MObject node_obj = attr.getObject();
+        if (node_obj.isNull()) {
+            return;
+        }
+        auto sample = SceneGraphAttrSample();
+        sample.node = MObjectHandle(node_obj);
+        sample.attrName = attr_name;
+        sample.attrId = attr_id;
+        sample.scaleFactor = scaleFactor;
+        samples.push_back(sample);
+    }
+
+    void insert(Attr &attr, const mmsg::AttrId attr_id) {
+        MObject node_obj = attr.getObject();
+        MObject attr_obj = attr.getAttribute();
+        if (!node_obj.isNull() && !attr_obj.isNull()) {
+            auto key = NodeAttrHandle{MObjectHandle(node_obj),
+                                      MObjectHandle(attr_obj)};
+            handle_map.insert({key, attr_id});
+        }
+        unnamed_attrs.push_back({attr, attr_id});
+    }
+
+    // Add the names of all attributes inserted since the last call,
+    // in insertion order, so the first attribute inserted with a
+    // name is found.
+    void update_name_map() const {
+        for (auto &unnamed_attr : unnamed_attrs) {
+            MString nodeAttrName = unnamed_attr.first.getLongName();
+            auto nodeAttrNameStr = std::string(nodeAttrName.asChar());
+            name_map.insert({nodeAttrNameStr, unnamed_attr.second});
+        }
+        unnamed_attrs.clear();
+    }
+
+    bool find(Attr &attr, mmsg::AttrId &out_attr_id) const {
+        MObject node_obj = attr.getObject();
+        MObject attr_obj = attr.getAttribute();
+        if (!node_obj.isNull() && !attr_obj.isNull()) {
+            auto key = NodeAttrHandle{MObjectHandle(node_obj),
+                                      MObjectHandle(attr_obj)};
+            auto search = handle_map.find(key);
+            if (search != handle_map.end()) {
+                out_attr_id = search->second;
+                return true;
+            }
+        }
+
+        update_name_map();
+        MString nodeAttrName = attr.getLongName();
+        auto nodeAttrNameStr = std::string(nodeAttrName.asChar());
+        auto search = name_map.find(nodeAttrNameStr);
+        if (search != name_map.end()) {
+            out_attr_id = search->second;
+            return true;
+        }
+        return false;
+    }
+};
+
 bool is_zero(MPoint value, double tolerance = 1.0e-3) {
     bool x_is_zero = number::isApproxEqual<double>(value.x, 0.0, tolerance);
     bool y_is_zero = number::isApproxEqual<double>(value.y, 0.0, tolerance);
@@ -164,6 +278,40 @@ bool attribute_has_complex_connection(MFnDependencyNode &depend_node,
     return false;
 }
 
+// Sample 'mayaAttr' for every frame from start_frame to end_frame
+// (inclusive).
+//
+// 'Attr::getValues' evaluates an animation curve driven by time
+// directly, which is much faster than evaluating the plug for each
+// frame, and evaluates everything else (such as driven-keys, or a
+// curve with a connected 'input' attribute, such as a time-warp)
+// through the DG.
+MStatus sample_attribute_dense(Attr &mayaAttr,
+                               const mmsg::FrameValue start_frame,
+                               const mmsg::FrameValue end_frame,
+                               const int timeEvalMode,
+                               const double scaleFactor,
+                               rust::Vec<mmsg::Real> &out_values) {
+    MStatus status = MS::kSuccess;
+
+    const auto uiUnit = MTime::uiUnit();
+    const uint32_t frame_count = (end_frame - start_frame) + 1;
+    MTimeArray times(frame_count, MTime(0.0, uiUnit));
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        const auto frame = static_cast<double>(start_frame + i);
+        status = times.set(MTime(frame, uiUnit), i);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    std::vector<double> values;
+    status = mayaAttr.getValues(values, times, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    for (const double value : values) {
+        out_values.push_back(value * scaleFactor);
+    }
+    return status;
+}
+
 MStatus add_attribute(Attr &mayaAttr, const MString &attr_name,
                       const MTimeArray &frameList,
                       const mmsg::FrameValue start_frame,
@@ -171,7 +319,7 @@ MStatus add_attribute(Attr &mayaAttr, const MString &attr_name,
                       const double scaleFactor,
                       mmsg::AttrDataBlock &out_attrDataBlock,
                       mmsg::AttrId &out_attrId,
-                      StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                      AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("add_attribute");
 
@@ -196,17 +344,16 @@ MStatus add_attribute(Attr &mayaAttr, const MString &attr_name,
         // are wanted, we must allocate memory for frames 1 to 6 (size
         // of 6), not 3.
         auto total_frame_count = (end_frame - start_frame) + 1;
-        auto uiUnit = MTime::uiUnit();
         auto values = rust::Vec<mmsg::Real>();
         values.reserve(total_frame_count);
-        for (mmsg::FrameValue f = start_frame; f < (end_frame + 1); ++f) {
-            auto frame_time = MTime(static_cast<double>(f), uiUnit);
-            status = mayaAttr.getValue(value, frame_time, timeEvalMode);
-            CHECK_MSTATUS_AND_RETURN_IT(status);
-            values.push_back(value * scaleFactor);
-        }
+
+        status = sample_attribute_dense(mayaAttr, start_frame, end_frame,
+                                        timeEvalMode, scaleFactor, values);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
         out_attrId =
             out_attrDataBlock.create_attr_anim_dense(values, start_frame);
+        out_attrToAttrIdMap.record_sample(mayaAttr, attr_name, out_attrId,
+                                          scaleFactor);
     } else if (connected) {
         // Find source of attribute connection.
         MObject node_mobject = mayaAttr.getObject();
@@ -236,18 +383,18 @@ MStatus add_attribute(Attr &mayaAttr, const MString &attr_name,
                 status = add_attribute(
                     mayaAttrSource, source_attr_name, frameList, start_frame,
                     end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                    out_attrId, out_attrNameToAttrIdMap);
+                    out_attrId, out_attrToAttrIdMap);
                 CHECK_MSTATUS_AND_RETURN_IT(status);
             }
         }
     } else {
         status = mayaAttr.getValue(value, timeEvalMode);
         out_attrId = out_attrDataBlock.create_attr_static(value * scaleFactor);
+        out_attrToAttrIdMap.record_sample(mayaAttr, attr_name, out_attrId,
+                                          scaleFactor);
     }
 
-    MString nodeAttrName = mayaAttr.getLongName();
-    auto nodeAttrNameStr = std::string(nodeAttrName.asChar());
-    out_attrNameToAttrIdMap.insert({nodeAttrNameStr, out_attrId});
+    out_attrToAttrIdMap.insert(mayaAttr, out_attrId);
 
     return status;
 }
@@ -258,26 +405,26 @@ MStatus get_translate_attrs(Attr &mayaAttr, const MTimeArray &frameList,
                             const int timeEvalMode,
                             mmsg::AttrDataBlock &out_attrDataBlock,
                             mmsg::Translate3DAttrIds &out_attrIds,
-                            StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                            AttrToAttrIdMap &out_attrToAttrIdMap) {
     MStatus status = MS::kSuccess;
     double scaleFactor = 1.0;  // No conversion.
 
     status =
         add_attribute(mayaAttr, MString("translateX"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.tx, out_attrNameToAttrIdMap);
+                      out_attrIds.tx, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("translateY"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.ty, out_attrNameToAttrIdMap);
+                      out_attrIds.ty, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("translateZ"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.tz, out_attrNameToAttrIdMap);
+                      out_attrIds.tz, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
@@ -289,26 +436,26 @@ MStatus get_rotate_attrs(Attr &mayaAttr, const MTimeArray &frameList,
                          const int timeEvalMode,
                          mmsg::AttrDataBlock &out_attrDataBlock,
                          mmsg::Rotate3DAttrIds &out_attrIds,
-                         StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                         AttrToAttrIdMap &out_attrToAttrIdMap) {
     MStatus status = MS::kSuccess;
     double scaleFactor = 1.0;  // No conversion.
 
     status =
         add_attribute(mayaAttr, MString("rotateX"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.rx, out_attrNameToAttrIdMap);
+                      out_attrIds.rx, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("rotateY"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.ry, out_attrNameToAttrIdMap);
+                      out_attrIds.ry, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("rotateZ"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.rz, out_attrNameToAttrIdMap);
+                      out_attrIds.rz, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
@@ -320,26 +467,26 @@ MStatus get_scale_attrs(Attr &mayaAttr, const MTimeArray &frameList,
                         const int timeEvalMode,
                         mmsg::AttrDataBlock &out_attrDataBlock,
                         mmsg::Scale3DAttrIds &out_attrIds,
-                        StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                        AttrToAttrIdMap &out_attrToAttrIdMap) {
     MStatus status = MS::kSuccess;
     double scaleFactor = 1.0;  // No conversion.
 
     status =
         add_attribute(mayaAttr, MString("scaleX"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.sx, out_attrNameToAttrIdMap);
+                      out_attrIds.sx, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("scaleY"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.sy, out_attrNameToAttrIdMap);
+                      out_attrIds.sy, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("scaleZ"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.sz, out_attrNameToAttrIdMap);
+                      out_attrIds.sz, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
@@ -351,7 +498,7 @@ MStatus get_camera_attrs(
     const int timeEvalMode, mmsg::AttrDataBlock &out_attrDataBlock,
     mmsg::CameraAttrIds &out_attrIds, mmsg::FilmFit &out_film_fit,
     int32_t &out_render_image_width, int32_t &out_render_image_height,
-    StringToAttrIdMap &out_attrNameToAttrIdMap) {
+    AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("get_camera_attrs");
 
@@ -366,49 +513,49 @@ MStatus get_camera_attrs(
     status = add_attribute(mayaAttr, MString("horizontalFilmAperture"),
                            frameList, start_frame, end_frame, timeEvalMode,
                            inch_to_mm, out_attrDataBlock,
-                           out_attrIds.sensor_width, out_attrNameToAttrIdMap);
+                           out_attrIds.sensor_width, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = add_attribute(mayaAttr, MString("verticalFilmAperture"), frameList,
                            start_frame, end_frame, timeEvalMode, inch_to_mm,
                            out_attrDataBlock, out_attrIds.sensor_height,
-                           out_attrNameToAttrIdMap);
+                           out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("focalLength"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.focal_length, out_attrNameToAttrIdMap);
+                      out_attrIds.focal_length, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = add_attribute(mayaAttr, MString("horizontalFilmOffset"), frameList,
                            start_frame, end_frame, timeEvalMode, inch_to_mm,
                            out_attrDataBlock, out_attrIds.lens_offset_x,
-                           out_attrNameToAttrIdMap);
+                           out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = add_attribute(mayaAttr, MString("verticalFilmOffset"), frameList,
                            start_frame, end_frame, timeEvalMode, inch_to_mm,
                            out_attrDataBlock, out_attrIds.lens_offset_y,
-                           out_attrNameToAttrIdMap);
+                           out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = add_attribute(mayaAttr, MString("nearClipPlane"), frameList,
                            start_frame, end_frame, timeEvalMode, scaleFactor,
                            out_attrDataBlock, out_attrIds.near_clip_plane,
-                           out_attrNameToAttrIdMap);
+                           out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("farClipPlane"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.far_clip_plane, out_attrNameToAttrIdMap);
+                      out_attrIds.far_clip_plane, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status =
         add_attribute(mayaAttr, MString("cameraScale"), frameList, start_frame,
                       end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                      out_attrIds.camera_scale, out_attrNameToAttrIdMap);
+                      out_attrIds.camera_scale, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
@@ -458,22 +605,22 @@ MStatus get_transform_attrs(Attr &mayaAttr, const MTimeArray &frameList,
                             mmsg::Rotate3DAttrIds &out_rotateAttrIds,
                             mmsg::Scale3DAttrIds &out_scaleAttrIds,
                             mmsg::RotateOrder &out_rotateOrder,
-                            StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                            AttrToAttrIdMap &out_attrToAttrIdMap) {
     MStatus status = MS::kSuccess;
 
     status = get_translate_attrs(mayaAttr, frameList, start_frame, end_frame,
                                  timeEvalMode, out_attrDataBlock,
-                                 out_translateAttrIds, out_attrNameToAttrIdMap);
+                                 out_translateAttrIds, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = get_rotate_attrs(mayaAttr, frameList, start_frame, end_frame,
                               timeEvalMode, out_attrDataBlock,
-                              out_rotateAttrIds, out_attrNameToAttrIdMap);
+                              out_rotateAttrIds, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = get_scale_attrs(mayaAttr, frameList, start_frame, end_frame,
                              timeEvalMode, out_attrDataBlock, out_scaleAttrIds,
-                             out_attrNameToAttrIdMap);
+                             out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = get_rotate_order_attr(mayaAttr, timeEvalMode, out_rotateOrder);
@@ -518,7 +665,7 @@ MStatus get_marker_attrs(Attr &mayaAttr, const MTimeArray &frameList,
                          const double overscan_y,
                          mmsg::AttrDataBlock &out_attrDataBlock,
                          mmsg::MarkerAttrIds &out_attrIds,
-                         StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                         AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("get_marker_attrs");
 
@@ -532,12 +679,12 @@ MStatus get_marker_attrs(Attr &mayaAttr, const MTimeArray &frameList,
 
     add_attribute(mayaAttr, MString("translateX"), frameList, start_frame,
                   end_frame, timeEvalMode, scaleFactor_x, out_attrDataBlock,
-                  out_attrIds.tx, out_attrNameToAttrIdMap);
+                  out_attrIds.tx, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     add_attribute(mayaAttr, MString("translateY"), frameList, start_frame,
                   end_frame, timeEvalMode, scaleFactor_y, out_attrDataBlock,
-                  out_attrIds.ty, out_attrNameToAttrIdMap);
+                  out_attrIds.ty, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     // TODO: The marker weight is more complicated because the user
@@ -547,7 +694,7 @@ MStatus get_marker_attrs(Attr &mayaAttr, const MTimeArray &frameList,
     // mmscenegraph currently.
     add_attribute(mayaAttr, MString("weight"), frameList, start_frame,
                   end_frame, timeEvalMode, scaleFactor, out_attrDataBlock,
-                  out_attrIds.weight, out_attrNameToAttrIdMap);
+                  out_attrIds.weight, out_attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
@@ -748,7 +895,7 @@ MStatus add_transforms(const mmsg::NodeId parent_node_id, MDagPath &dag_path,
                        mmsg::SceneGraph &out_sceneGraph,
                        mmsg::AttrDataBlock &out_attrDataBlock,
                        StringToNodeIdMap &out_nodeNameToNodeIdMap,
-                       StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                       AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("add_transforms");
     MStatus status = MS::kSuccess;
@@ -787,7 +934,7 @@ MStatus add_transforms(const mmsg::NodeId parent_node_id, MDagPath &dag_path,
             get_transform_attrs(
                 mayaAttr, frameList, start_frame, end_frame, timeEvalMode,
                 out_attrDataBlock, translate_attr_ids, rotate_attr_ids,
-                scale_attr_ids, rotate_order, out_attrNameToAttrIdMap);
+                scale_attr_ids, rotate_order, out_attrToAttrIdMap);
 
             auto tfm_node = out_sceneGraph.create_transform_node(
                 translate_attr_ids, rotate_attr_ids, scale_attr_ids,
@@ -817,7 +964,8 @@ MStatus add_cameras(const CameraPtrList &cameraList,
                     mmsg::SceneGraph &out_sceneGraph,
                     mmsg::AttrDataBlock &out_attrDataBlock,
                     StringToNodeIdMap &out_nodeNameToNodeIdMap,
-                    StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                    ObjectToNodeIdMap &out_cameraObjectToNodeIdMap,
+                    AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("add_cameras");
     MStatus status = MS::kSuccess;
@@ -833,6 +981,7 @@ MStatus add_cameras(const CameraPtrList &cameraList,
 
     out_cameraNodes.clear();
     out_cameraNodes.reserve(cameraList.size());
+    out_cameraObjectToNodeIdMap.reserve(cameraList.size());
 
     for (auto cit = cameraList.cbegin(); cit != cameraList.cend(); ++cit) {
         auto cam_ptr = *cit;
@@ -853,7 +1002,7 @@ MStatus add_cameras(const CameraPtrList &cameraList,
         get_transform_attrs(mayaAttr, frameList, start_frame, end_frame,
                             timeEvalMode, out_attrDataBlock, translate_attr_ids,
                             rotate_attr_ids, scale_attr_ids, rotate_order,
-                            out_attrNameToAttrIdMap);
+                            out_attrToAttrIdMap);
 
         status = MDagPath::getAPathTo(cam_shp_obj, shp_dag_path);
         CHECK_MSTATUS_AND_RETURN_IT(status);
@@ -868,7 +1017,7 @@ MStatus add_cameras(const CameraPtrList &cameraList,
         get_camera_attrs(mayaAttr, cam_ptr, frameList, start_frame, end_frame,
                          timeEvalMode, out_attrDataBlock, camera_attr_ids,
                          film_fit, render_image_width, render_image_height,
-                         out_attrNameToAttrIdMap);
+                         out_attrToAttrIdMap);
 
         auto cam_node = out_sceneGraph.create_camera_node(
             translate_attr_ids, rotate_attr_ids, scale_attr_ids,
@@ -879,6 +1028,8 @@ MStatus add_cameras(const CameraPtrList &cameraList,
 
         auto nodeNameStr = std::string(transform_name.asChar());
         out_nodeNameToNodeIdMap.insert({nodeNameStr, cam_node.id});
+        out_cameraObjectToNodeIdMap.insert(
+            {MObjectHandle(cam_shp_obj), cam_node.id});
 
         status = tfm_dag_path.pop();
         CHECK_MSTATUS_AND_RETURN_IT(status);
@@ -886,7 +1037,7 @@ MStatus add_cameras(const CameraPtrList &cameraList,
         status = add_transforms(
             cam_node.id, tfm_dag_path, frameList, start_frame, end_frame,
             timeEvalMode, out_sceneGraph, out_attrDataBlock,
-            out_nodeNameToNodeIdMap, out_attrNameToAttrIdMap);
+            out_nodeNameToNodeIdMap, out_attrToAttrIdMap);
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
     return status;
@@ -901,7 +1052,8 @@ MStatus add_bundles(const BundlePtrList &bundleList,
                     mmsg::SceneGraph &out_sceneGraph,
                     mmsg::AttrDataBlock &out_attrDataBlock,
                     StringToNodeIdMap &out_nodeNameToNodeIdMap,
-                    StringToAttrIdMap &out_attrNameToAttrIdMap) {
+                    ObjectToNodeIdMap &out_bundleObjectToNodeIdMap,
+                    AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("add_bundles");
     MStatus status = MS::kSuccess;
@@ -916,6 +1068,7 @@ MStatus add_bundles(const BundlePtrList &bundleList,
 
     out_bundleNodes.clear();
     out_bundleNodes.reserve(bundleList.size());
+    out_bundleObjectToNodeIdMap.reserve(bundleList.size());
 
     for (auto cit = bundleList.cbegin(); cit != bundleList.cend(); ++cit) {
         auto bnd_ptr = *cit;
@@ -934,7 +1087,7 @@ MStatus add_bundles(const BundlePtrList &bundleList,
         get_transform_attrs(mayaAttr, frameList, start_frame, end_frame,
                             timeEvalMode, out_attrDataBlock, translate_attr_ids,
                             rotate_attr_ids, scale_attr_ids, rotate_order,
-                            out_attrNameToAttrIdMap);
+                            out_attrToAttrIdMap);
 
         auto bnd_node = out_sceneGraph.create_bundle_node(
             translate_attr_ids, rotate_attr_ids, scale_attr_ids, rotate_order);
@@ -943,6 +1096,8 @@ MStatus add_bundles(const BundlePtrList &bundleList,
 
         auto nodeNameStr = std::string(transform_name.asChar());
         out_nodeNameToNodeIdMap.insert({nodeNameStr, bnd_node.id});
+        out_bundleObjectToNodeIdMap.insert(
+            {MObjectHandle(bnd_tfm_obj), bnd_node.id});
 
         status = dag_path.pop();
         CHECK_MSTATUS_AND_RETURN_IT(status);
@@ -950,28 +1105,27 @@ MStatus add_bundles(const BundlePtrList &bundleList,
         status = add_transforms(bnd_node.id, dag_path, frameList, start_frame,
                                 end_frame, timeEvalMode, out_sceneGraph,
                                 out_attrDataBlock, out_nodeNameToNodeIdMap,
-                                out_attrNameToAttrIdMap);
+                                out_attrToAttrIdMap);
         CHECK_MSTATUS_AND_RETURN_IT(status);
     }
     return status;
 }
 
-MStatus add_markers(
-    const MarkerPtrList &markerList, const CameraPtrList &cameraList,
-    const BundlePtrList &bundleList, const MTimeArray &frameList,
-    const mmsg::FrameValue start_frame, const mmsg::FrameValue end_frame,
-    const int timeEvalMode, const std::vector<mmsg::CameraNode> &cameraNodes,
-    const std::vector<mmsg::BundleNode> &bundleNodes,
-    std::vector<mmsg::MarkerNode> &out_markerNodes,
-    mmsg::EvaluationObjects &out_evalObjects, mmsg::SceneGraph &out_sceneGraph,
-    mmsg::AttrDataBlock &out_attrDataBlock,
-    StringToAttrIdMap &out_attrNameToAttrIdMap) {
+MStatus add_markers(const MarkerPtrList &markerList,
+                    const MTimeArray &frameList,
+                    const mmsg::FrameValue start_frame,
+                    const mmsg::FrameValue end_frame, const int timeEvalMode,
+                    const ObjectToNodeIdMap &cameraObjectToNodeIdMap,
+                    const ObjectToNodeIdMap &bundleObjectToNodeIdMap,
+                    std::vector<mmsg::MarkerNode> &out_markerNodes,
+                    mmsg::EvaluationObjects &out_evalObjects,
+                    mmsg::SceneGraph &out_sceneGraph,
+                    mmsg::AttrDataBlock &out_attrDataBlock,
+                    AttrToAttrIdMap &out_attrToAttrIdMap) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("add_markers");
 
     MStatus status = MS::kSuccess;
-    assert(cameraList.size() == cameraNodes.size());
-    assert(bundleList.size() == bundleNodes.size());
 
     // Create a single attribute that will be re-used.
     auto mayaAttr = Attr();
@@ -986,28 +1140,26 @@ MStatus add_markers(
         auto mkr_tfm_name = mkr_ptr->getNodeName();
         auto mkr_tfm_obj = mkr_ptr->getObject();
 
-        // Get camera name.
+        // Get camera node.
         auto mkr_cam_ptr = mkr_ptr->getCamera();
-        auto mkr_cam_shp_name = mkr_cam_ptr->getShapeNodeName();
+        auto mkr_cam_shp_obj = mkr_cam_ptr->getShapeObject();
 
         mmsg::NodeId cam_node_id = mmsg::NodeId();
-        for (uint32_t j = 0; j < cameraList.size(); ++j) {
-            if (cameraList[j]->getShapeNodeName() == mkr_cam_shp_name) {
-                cam_node_id = cameraNodes[j].id;
-                break;
-            }
+        auto cam_search =
+            cameraObjectToNodeIdMap.find(MObjectHandle(mkr_cam_shp_obj));
+        if (cam_search != cameraObjectToNodeIdMap.end()) {
+            cam_node_id = cam_search->second;
         }
 
-        // Get bundle name.
+        // Get bundle node.
         auto mkr_bnd_ptr = mkr_ptr->getBundle();
-        auto mkr_bnd_tfm_name = mkr_bnd_ptr->getNodeName();
+        auto mkr_bnd_tfm_obj = mkr_bnd_ptr->getObject();
 
         mmsg::NodeId bnd_node_id = mmsg::NodeId();
-        for (uint32_t j = 0; j < bundleList.size(); ++j) {
-            if (bundleList[j]->getNodeName() == mkr_bnd_tfm_name) {
-                bnd_node_id = bundleNodes[j].id;
-                break;
-            }
+        auto bnd_search =
+            bundleObjectToNodeIdMap.find(MObjectHandle(mkr_bnd_tfm_obj));
+        if (bnd_search != bundleObjectToNodeIdMap.end()) {
+            bnd_node_id = bnd_search->second;
         }
 
         auto dag_path = MDagPath();
@@ -1035,7 +1187,7 @@ MStatus add_markers(
         status = get_marker_attrs(mayaAttr, frameList, start_frame, end_frame,
                                   timeEvalMode, overscan_x, overscan_y,
                                   out_attrDataBlock, mkr_attr_ids,
-                                  out_attrNameToAttrIdMap);
+                                  out_attrToAttrIdMap);
         CHECK_MSTATUS_AND_RETURN_IT(status);
 
         auto mkr_node = out_sceneGraph.create_marker_node(mkr_attr_ids);
@@ -1067,7 +1219,7 @@ MStatus add_markers(
 }
 
 MStatus convert_attributes_to_attr_ids(
-    const AttrPtrList &attrList, const StringToAttrIdMap &attrNameToAttrIdMap,
+    const AttrPtrList &attrList, const AttrToAttrIdMap &attrToAttrIdMap,
     std::vector<mmsg::AttrId> &out_attrIdList) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB("convert_attributes_to_attr_ids");
@@ -1092,17 +1244,15 @@ MStatus convert_attributes_to_attr_ids(
             continue;
         }
 
-        MString attrName = attr->getLongName();
-        std::string key = std::string(attrName.asChar());
-
-        // Find mmSceneGraph AttrId from the full (long) attribute
-        // name.
-        auto search = attrNameToAttrIdMap.find(key);
-        if (search != attrNameToAttrIdMap.end()) {
-            out_attrIdList.push_back(search->second);
+        // Find mmSceneGraph AttrId from the node and attribute.
+        auto attr_id = mmsg::AttrId();
+        bool found = attrToAttrIdMap.find(*attr, attr_id);
+        if (found) {
+            out_attrIdList.push_back(attr_id);
         } else {
+            MString attrName = attr->getLongName();
             MMSOLVER_MAYA_WRN("MM Scene Graph: Attribute name was not found: "
-                              << key << " object_type="
+                              << attrName.asChar() << " object_type="
                               << static_cast<uint32_t>(object_type));
             return MS::kFailure;
         }
@@ -1111,27 +1261,28 @@ MStatus convert_attributes_to_attr_ids(
     return status;
 }
 
-MStatus construct_scene_graph(CameraPtrList &cameraList,
-                              MarkerPtrList &markerList,
-                              BundlePtrList &bundleList, AttrPtrList &attrList,
-                              const MTimeArray &frameList,
-                              const int timeEvalMode,
-                              mmsg::SceneGraph &out_sceneGraph,
-                              mmsg::AttrDataBlock &out_attrDataBlock,
-                              mmsg::FlatScene &out_flatScene,
-                              std::vector<mmsg::FrameValue> &out_frameList,
-                              std::vector<mmsg::CameraNode> &out_cameraNodes,
-                              std::vector<mmsg::BundleNode> &out_bundleNodes,
-                              std::vector<mmsg::MarkerNode> &out_markerNodes,
-                              std::vector<mmsg::AttrId> &out_attrIdList) {
+MStatus construct_scene_graph(
+    CameraPtrList &cameraList, MarkerPtrList &markerList,
+    BundlePtrList &bundleList, AttrPtrList &attrList,
+    const MTimeArray &frameList, const int timeEvalMode,
+    mmsg::SceneGraph &out_sceneGraph, mmsg::AttrDataBlock &out_attrDataBlock,
+    mmsg::FlatScene &out_flatScene,
+    std::vector<mmsg::FrameValue> &out_frameList,
+    std::vector<mmsg::CameraNode> &out_cameraNodes,
+    std::vector<mmsg::BundleNode> &out_bundleNodes,
+    std::vector<mmsg::MarkerNode> &out_markerNodes,
+    std::vector<mmsg::AttrId> &out_attrIdList,
+    std::vector<SceneGraphAttrSample> &out_attrSamples) {
     const bool verbose = false;
     MMSOLVER_MAYA_VRB(
         "construct_scene_graph -----------------------------------");
     MStatus status = MS::kSuccess;
 
     auto evalObjects = mmsg::EvaluationObjects();
-    auto attrNameToAttrIdMap = StringToAttrIdMap();
+    auto attrToAttrIdMap = AttrToAttrIdMap();
     auto nodeNameToNodeIdMap = StringToNodeIdMap();
+    auto cameraObjectToNodeIdMap = ObjectToNodeIdMap();
+    auto bundleObjectToNodeIdMap = ObjectToNodeIdMap();
 
     // Frames
     MMSOLVER_MAYA_VRB("FrameList length: " << frameList.length());
@@ -1158,23 +1309,25 @@ MStatus construct_scene_graph(CameraPtrList &cameraList,
     status = add_cameras(cameraList, frameList, start_frame, end_frame,
                          timeEvalMode, out_cameraNodes, evalObjects,
                          out_sceneGraph, out_attrDataBlock, nodeNameToNodeIdMap,
-                         attrNameToAttrIdMap);
+                         cameraObjectToNodeIdMap, attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     status = add_bundles(bundleList, frameList, start_frame, end_frame,
                          timeEvalMode, out_bundleNodes, evalObjects,
                          out_sceneGraph, out_attrDataBlock, nodeNameToNodeIdMap,
-                         attrNameToAttrIdMap);
+                         bundleObjectToNodeIdMap, attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    status = add_markers(
-        markerList, cameraList, bundleList, frameList, start_frame, end_frame,
-        timeEvalMode, out_cameraNodes, out_bundleNodes, out_markerNodes,
-        evalObjects, out_sceneGraph, out_attrDataBlock, attrNameToAttrIdMap);
+    // Cameras and bundles are linked to each marker using the hash
+    // maps built above, so each marker is resolved in O(1).
+    status = add_markers(markerList, frameList, start_frame, end_frame,
+                         timeEvalMode, cameraObjectToNodeIdMap,
+                         bundleObjectToNodeIdMap, out_markerNodes, evalObjects,
+                         out_sceneGraph, out_attrDataBlock, attrToAttrIdMap);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
     // Create parameters to attributes
-    status = convert_attributes_to_attr_ids(attrList, attrNameToAttrIdMap,
+    status = convert_attributes_to_attr_ids(attrList, attrToAttrIdMap,
                                             out_attrIdList);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
@@ -1199,5 +1352,83 @@ MStatus construct_scene_graph(CameraPtrList &cameraList,
     // Bake down SceneGraph into FlatScene for fast evaluation.
     out_flatScene = mmsg::bake_scene_graph(out_sceneGraph, evalObjects);
 
+    out_attrSamples = std::move(attrToAttrIdMap.samples);
+
+    return status;
+}
+
+MStatus construct_scene_graph(CameraPtrList &cameraList,
+                              MarkerPtrList &markerList,
+                              BundlePtrList &bundleList, AttrPtrList &attrList,
+                              const MTimeArray &frameList,
+                              const int timeEvalMode,
+                              mmsg::SceneGraph &out_sceneGraph,
+                              mmsg::AttrDataBlock &out_attrDataBlock,
+                              mmsg::FlatScene &out_flatScene,
+                              std::vector<mmsg::FrameValue> &out_frameList,
+                              std::vector<mmsg::CameraNode> &out_cameraNodes,
+                              std::vector<mmsg::BundleNode> &out_bundleNodes,
+                              std::vector<mmsg::MarkerNode> &out_markerNodes,
+                              std::vector<mmsg::AttrId> &out_attrIdList) {
+    auto attrSamples = std::vector<SceneGraphAttrSample>();
+    return construct_scene_graph(
+        cameraList, markerList, bundleList, attrList, frameList, timeEvalMode,
+        out_sceneGraph, out_attrDataBlock, out_flatScene, out_frameList,
+        out_cameraNodes, out_bundleNodes, out_markerNodes, out_attrIdList,
+        attrSamples);
+}
+
+MStatus resample_scene_graph_attribute(
+    const SceneGraphAttrSample &attrSample,
+    const mmsg::FrameValue start_frame, const mmsg::FrameValue end_frame,
+    const int timeEvalMode, mmsg::AttrDataBlock &inout_attrDataBlock) {
+    const bool verbose = false;
+    MMSOLVER_MAYA_VRB("resample_scene_graph_attribute");
+
+    MStatus status = MS::kSuccess;
+    if (!attrSample.node.isValid()) {
+        return MS::kFailure;
+    }
+
+    MObject node_obj = attrSample.node.object();
+    MString node_name;
+    status = getUniqueNodeName(node_obj, node_name);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    auto mayaAttr = Attr();
+    status = mayaAttr.setNodeName(node_name);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = mayaAttr.setAttrName(attrSample.attrName);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const auto attr_id = attrSample.attrId;
+    if (attr_id.attr_type == mmsg::AttrType::kAnimDense) {
+        auto total_frame_count = (end_frame - start_frame) + 1;
+        auto values = rust::Vec<mmsg::Real>();
+        values.reserve(total_frame_count);
+
+        status = sample_attribute_dense(mayaAttr, start_frame, end_frame,
+                                        timeEvalMode, attrSample.scaleFactor,
+                                        values);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        for (mmsg::FrameValue f = start_frame; f < (end_frame + 1); ++f) {
+            auto value = values[f - start_frame];
+            bool ok = inout_attrDataBlock.set_attr_value(attr_id, f, value);
+            if (!ok) {
+                return MS::kFailure;
+            }
+        }
+    } else if (attr_id.attr_type == mmsg::AttrType::kStatic) {
+        double value = 0.0;
+        status = mayaAttr.getValue(value, timeEvalMode);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        bool ok = inout_attrDataBlock.set_attr_value(
+            attr_id, start_frame, value * attrSample.scaleFactor);
+        if (!ok) {
+            return MS::kFailure;
+        }
+    }
+
     return status;
 }
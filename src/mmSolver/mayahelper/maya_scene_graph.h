@@ -31,6 +31,7 @@
 #include <maya/MComputation.h>
 #include <maya/MDagPath.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
 #include <maya/MTime.h>
@@ -47,6 +48,30 @@
 #include "maya_marker.h"
 #include "maya_utils.h"
 
+// Describes how a Maya attribute was sampled into an mmSceneGraph
+// attribute, so the values can be re-sampled later when the Maya
+// attribute changes, without re-constructing the scene graph.
+struct SceneGraphAttrSample {
+    MObjectHandle node;
+    MString attrName;
+    mmscenegraph::AttrId attrId;
+    double scaleFactor;
+};
+
+MStatus construct_scene_graph(
+    CameraPtrList &cameraList, MarkerPtrList &markerList,
+    BundlePtrList &bundleList, AttrPtrList &attrList,
+    const MTimeArray &frameList, const int timeEvalMode,
+    mmscenegraph::SceneGraph &out_sceneGraph,
+    mmscenegraph::AttrDataBlock &out_attrDataBlock,
+    mmscenegraph::FlatScene &out_flatScene,
+    std::vector<mmscenegraph::FrameValue> &out_frameList,
+    std::vector<mmscenegraph::CameraNode> &out_cameraNodes,
+    std::vector<mmscenegraph::BundleNode> &out_bundleNodes,
+    std::vector<mmscenegraph::MarkerNode> &out_markerNodes,
+    std::vector<mmscenegraph::AttrId> &out_attrIdList,
+    std::vector<SceneGraphAttrSample> &out_attrSamples);
+
 MStatus construct_scene_graph(
     CameraPtrList &cameraList, MarkerPtrList &markerList,
     BundlePtrList &bundleList, AttrPtrList &attrList,
@@ -60,4 +85,13 @@ MStatus construct_scene_graph(
     std::vector<mmscenegraph::MarkerNode> &out_markerNodes,
     std::vector<mmscenegraph::AttrId> &out_attrIdList);
 
+// Re-read the Maya attribute values described by 'attrSample' and
+// overwrite the values stored in 'inout_attrDataBlock', for all
+// frames between 'start_frame' and 'end_frame' (inclusive).
+MStatus resample_scene_graph_attribute(
+    const SceneGraphAttrSample &attrSample,
+    const mmscenegraph::FrameValue start_frame,
+    const mmscenegraph::FrameValue end_frame, const int timeEvalMode,
+    mmscenegraph::AttrDataBlock &inout_attrDataBlock);
+
 #endif  // MM_SOLVER_MAYA_SCENE_GRAPH_H
\ No newline at end of file
@@ -0,0 +1,691 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include "maya_scene_graph_cache.h"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+// Maya
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
+#include <maya/MDagPath.h>
+#include <maya/MFn.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MSceneMessage.h>
+#include <maya/MSelectionList.h>
+#include <maya/MStreamUtils.h>
+#include <maya/MTime.h>
+
+// MM Solver
+#include "maya_marker_group.h"
+#include "maya_scene_graph.h"
+#include "mmSolver/utilities/debug_utils.h"
+
+namespace mmsg = mmscenegraph;
+
+// The maximum number of scene graphs kept in memory.
+//
+// Entries are evicted in least-recently-used order.
+const size_t SCENE_GRAPH_CACHE_MAX_ENTRIES = 4;
+
+// Attributes that change the structure of the scene graph, rather
+// than the values of the attributes sampled into it. When these
+// change the scene graph must be re-constructed.
+//
+// Names are matched by prefix, so "rotatePivot" also matches
+// "rotatePivotX", "rotatePivotTranslate", etc.
+const char *SCENE_GRAPH_STRUCTURE_ATTR_NAME_PREFIXES[] = {
+    "rotateOrder", "rotatePivot", "scalePivot", "filmFit", "overscan",
+};
+
+// The render resolution is read when the cameras are added to the
+// scene graph.
+const char *SCENE_GRAPH_RENDER_RESOLUTION_NODE_NAME = "defaultResolution";
+
+enum class SceneGraphCacheNodeType {
+    kSampledNode = 0,
+    kAnimCurve,
+    kMarkerGroup,
+    kRenderResolution,
+};
+
+// Data given to the Maya callbacks created for each node watched by
+// a cache entry.
+struct SceneGraphCacheNodeCallback {
+    SceneGraphCacheEntry *entry;
+    SceneGraphCacheNodeType nodeType;
+    MObjectHandle node;
+    std::vector<size_t> sampleIndices;
+    MCallbackIdArray callbackIds;
+};
+
+namespace {
+
+struct SceneGraphCacheState {
+    std::vector<std::unique_ptr<SceneGraphCacheEntry>> entries;
+    MCallbackIdArray globalCallbackIds;
+    uint64_t useCounter;
+
+    // Reported in the verbose output; the solver reports the hits
+    // and misses of each solve in its results.
+    size_t hits;
+    size_t misses;
+
+    SceneGraphCacheState() : useCounter(0), hits(0), misses(0) {}
+};
+
+SceneGraphCacheState &get_cache_state() {
+    static SceneGraphCacheState state;
+    return state;
+}
+
+uint64_t attr_id_key(const mmsg::AttrId &attrId) {
+    return (static_cast<uint64_t>(attrId.attr_type) << 32) |
+           static_cast<uint64_t>(attrId.index);
+}
+
+MString plug_long_name(MPlug &plug) {
+    MStatus status = MS::kSuccess;
+    MString plug_name = plug.partialName(
+        /*includeNodeName=*/false,
+        /*includeNonMandatoryIndices=*/false,
+        /*includeInstancedIndices=*/false,
+        /*useAlias=*/false,
+        /*useFullAttributePath=*/false,
+        /*useLongNames=*/true, &status);
+    if (status != MS::kSuccess) {
+        return MString();
+    }
+    return plug_name;
+}
+
+bool is_structure_attr_name(const MString &plug_name) {
+    const std::string name = plug_name.asChar();
+    for (auto prefix : SCENE_GRAPH_STRUCTURE_ATTR_NAME_PREFIXES) {
+        if (name.compare(0, std::strlen(prefix), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void watched_node_attribute_changed(MNodeMessage::AttributeMessage msg,
+                                    MPlug &plug, MPlug & /*other_plug*/,
+                                    void *client_data) {
+    const bool verbose = false;
+    auto data = static_cast<SceneGraphCacheNodeCallback *>(client_data);
+    if ((data == nullptr) || !data->entry->valid) {
+        return;
+    }
+
+    const bool is_connection = (msg & MNodeMessage::kConnectionMade) ||
+                               (msg & MNodeMessage::kConnectionBroken);
+    const bool is_set = msg & MNodeMessage::kAttributeSet;
+    if (!is_connection && !is_set) {
+        return;
+    }
+
+    // Any connection to a watched node may change how the sampled
+    // attributes are evaluated (for example a new constraint, or a
+    // curve driven by another attribute), or which samples are
+    // dynamic, so the scene graph must be re-constructed.
+    if (is_connection) {
+        MMSOLVER_MAYA_VRB("MM Scene Graph Cache: Connection changed: "
+                          << plug.info().asChar());
+        data->entry->valid = false;
+        return;
+    }
+
+    if (data->nodeType == SceneGraphCacheNodeType::kRenderResolution) {
+        MMSOLVER_MAYA_VRB("MM Scene Graph Cache: Render resolution changed: "
+                          << plug.info().asChar());
+        data->entry->valid = false;
+        return;
+    }
+
+    // Changes to animation curve keyframes are found with
+    // 'anim_curve_plug_dirty'.
+    if (data->nodeType == SceneGraphCacheNodeType::kAnimCurve) {
+        return;
+    }
+
+    MString plug_name = plug_long_name(plug);
+    if (is_structure_attr_name(plug_name)) {
+        MMSOLVER_MAYA_VRB("MM Scene Graph Cache: Structure changed: "
+                          << plug.info().asChar());
+        data->entry->valid = false;
+        return;
+    }
+
+    const auto &samples = data->entry->attrSamples;
+    for (auto sample_index : data->sampleIndices) {
+        if (samples[sample_index].attrName == plug_name) {
+            data->entry->markSampleDirty(sample_index);
+            return;
+        }
+    }
+}
+
+void anim_curve_plug_dirty(MObject & /*node*/, MPlug &plug,
+                           void *client_data) {
+    auto data = static_cast<SceneGraphCacheNodeCallback *>(client_data);
+    if ((data == nullptr) || !data->entry->valid) {
+        return;
+    }
+
+    // The input and output of the animation curve are dirtied every
+    // time the current time changes; only changes to the curve's
+    // keyframes are interesting.
+    MString plug_name = plug_long_name(plug);
+    if ((plug_name == "input") || (plug_name == "output")) {
+        return;
+    }
+
+    for (auto sample_index : data->sampleIndices) {
+        data->entry->markSampleDirty(sample_index);
+    }
+}
+
+void invalidate_all_entries() {
+    auto &state = get_cache_state();
+    for (auto &entry : state.entries) {
+        entry->valid = false;
+    }
+}
+
+// Remove the invalid entries that are not currently used by a
+// solve.
+//
+// Must not be called from inside a node callback of an entry,
+// because the entry's callbacks are removed when it is destroyed.
+void purge_invalid_entries() {
+    auto &state = get_cache_state();
+    auto &entries = state.entries;
+    entries.erase(
+        std::remove_if(entries.begin(), entries.end(),
+                       [](const std::unique_ptr<SceneGraphCacheEntry> &entry) {
+                           return !entry->inUse &&
+                                  (!entry->valid || !entry->key.isValid());
+                       }),
+        entries.end());
+}
+
+void dag_changed(MDagMessage::DagMessage /*msgType*/, MDagPath & /*child*/,
+                 MDagPath & /*parent*/, void * /*client_data*/) {
+    // Re-parenting, instancing, adding or removing DAG nodes may
+    // change the hierarchy of any scene graph.
+    invalidate_all_entries();
+}
+
+void scene_changed(void * /*client_data*/) {
+    invalidate_all_entries();
+    purge_invalid_entries();
+}
+
+void add_global_callbacks() {
+    auto &state = get_cache_state();
+    if (state.globalCallbackIds.length() > 0) {
+        return;
+    }
+
+    MStatus status = MS::kSuccess;
+    MCallbackId callback_id =
+        MDagMessage::addAllDagChangesCallback(dag_changed, nullptr, &status);
+    if (status == MS::kSuccess) {
+        state.globalCallbackIds.append(callback_id);
+    }
+
+    const MSceneMessage::Message scene_messages[] = {
+        MSceneMessage::kBeforeNew,
+        MSceneMessage::kBeforeOpen,
+        MSceneMessage::kBeforeImport,
+        MSceneMessage::kBeforeRemoveReference,
+        MSceneMessage::kBeforeUnloadReference,
+        MSceneMessage::kBeforeLoadReference,
+    };
+    for (auto scene_message : scene_messages) {
+        callback_id = MSceneMessage::addCallback(scene_message, scene_changed,
+                                                 nullptr, &status);
+        if (status == MS::kSuccess) {
+            state.globalCallbackIds.append(callback_id);
+        }
+    }
+}
+
+SceneGraphCacheNodeCallback *find_or_create_node_callback(
+    SceneGraphCacheEntry &entry, const MObjectHandle &node,
+    const SceneGraphCacheNodeType nodeType,
+    std::unordered_map<uint64_t, SceneGraphCacheNodeCallback *> &nodeMap) {
+    const uint64_t node_key =
+        (static_cast<uint64_t>(node.hashCode()) << 2) |
+        static_cast<uint64_t>(nodeType);
+    auto search = nodeMap.find(node_key);
+    if ((search != nodeMap.end()) && (search->second->node == node)) {
+        return search->second;
+    }
+
+    auto callback = std::unique_ptr<SceneGraphCacheNodeCallback>(
+        new SceneGraphCacheNodeCallback());
+    callback->entry = &entry;
+    callback->nodeType = nodeType;
+    callback->node = node;
+    auto callback_ptr = callback.get();
+    entry.nodeCallbacks.push_back(std::move(callback));
+    nodeMap.insert({node_key, callback_ptr});
+    return callback_ptr;
+}
+
+// Find the node directly driving the attribute, if there is one.
+bool find_source_node(const SceneGraphAttrSample &sample,
+                      MObject &out_source_node) {
+    MStatus status = MS::kSuccess;
+    MObject node_obj = sample.node.object();
+    MFnDependencyNode depend_node(node_obj, &status);
+    if (status != MS::kSuccess) {
+        return false;
+    }
+
+    const bool want_networked_plug = true;
+    MPlug plug =
+        depend_node.findPlug(sample.attrName, want_networked_plug, &status);
+    if ((status != MS::kSuccess) || plug.isNull()) {
+        return false;
+    }
+
+    MPlug source_plug = plug.source();
+    if (source_plug.isNull()) {
+        return false;
+    }
+    out_source_node = source_plug.node();
+    return true;
+}
+
+// Is the node an animation curve evaluated with time? The input of
+// these curves is not connected.
+bool is_time_anim_curve_node(const MObject &node) {
+    if (!node.hasFn(MFn::kAnimCurve)) {
+        return false;
+    }
+
+    MStatus status = MS::kSuccess;
+    MFnDependencyNode depend_node(node, &status);
+    if (status != MS::kSuccess) {
+        return false;
+    }
+
+    const bool want_networked_plug = true;
+    MPlug input_plug =
+        depend_node.findPlug("input", want_networked_plug, &status);
+    if ((status != MS::kSuccess) || input_plug.isNull()) {
+        return false;
+    }
+    return input_plug.source().isNull();
+}
+
+bool find_render_resolution_node(MObject &out_node) {
+    MSelectionList selection_list;
+    MStatus status =
+        selection_list.add(MString(SCENE_GRAPH_RENDER_RESOLUTION_NODE_NAME));
+    if (status != MS::kSuccess) {
+        return false;
+    }
+    status = selection_list.getDependNode(0, out_node);
+    return (status == MS::kSuccess) && !out_node.isNull();
+}
+
+MStatus add_entry_callbacks(SceneGraphCacheEntry &entry,
+                            MarkerPtrList &markerList) {
+    MStatus status = MS::kSuccess;
+
+    auto nodeMap =
+        std::unordered_map<uint64_t, SceneGraphCacheNodeCallback *>();
+    for (size_t i = 0; i < entry.attrSamples.size(); ++i) {
+        const auto &sample = entry.attrSamples[i];
+        auto node_callback = find_or_create_node_callback(
+            entry, sample.node, SceneGraphCacheNodeType::kSampledNode,
+            nodeMap);
+        node_callback->sampleIndices.push_back(i);
+
+        // Attributes driven by time animation curves are re-sampled
+        // when the curve changes. Attributes driven by any other node
+        // may change without a callback being run, so they are
+        // re-sampled every time the entry is used.
+        MObject source_node;
+        if (!find_source_node(sample, source_node)) {
+            continue;
+        }
+        if (is_time_anim_curve_node(source_node)) {
+            auto curve_callback = find_or_create_node_callback(
+                entry, MObjectHandle(source_node),
+                SceneGraphCacheNodeType::kAnimCurve, nodeMap);
+            curve_callback->sampleIndices.push_back(i);
+        } else {
+            entry.dynamicSamples.push_back(i);
+        }
+    }
+
+    MObject render_resolution_node;
+    if (!entry.cameraNodes.empty() &&
+        find_render_resolution_node(render_resolution_node)) {
+        find_or_create_node_callback(
+            entry, MObjectHandle(render_resolution_node),
+            SceneGraphCacheNodeType::kRenderResolution, nodeMap);
+    }
+
+    for (auto &marker : markerList) {
+        MarkerGroupPtr marker_group = marker->getMarkerGroup();
+        if (!marker_group) {
+            continue;
+        }
+        MObject marker_group_obj = marker_group->getObject();
+        if (marker_group_obj.isNull()) {
+            continue;
+        }
+        find_or_create_node_callback(entry, MObjectHandle(marker_group_obj),
+                                     SceneGraphCacheNodeType::kMarkerGroup,
+                                     nodeMap);
+    }
+
+    for (auto &node_callback : entry.nodeCallbacks) {
+        MObject node_obj = node_callback->node.object();
+        void *client_data = node_callback.get();
+
+        MCallbackId callback_id = MNodeMessage::addAttributeChangedCallback(
+            node_obj, watched_node_attribute_changed, client_data, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        node_callback->callbackIds.append(callback_id);
+
+        if (node_callback->nodeType == SceneGraphCacheNodeType::kAnimCurve) {
+            callback_id = MNodeMessage::addNodeDirtyPlugCallback(
+                node_obj, anim_curve_plug_dirty, client_data, &status);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+            node_callback->callbackIds.append(callback_id);
+        }
+    }
+
+    return status;
+}
+
+void create_cache_key(CameraPtrList &cameraList, MarkerPtrList &markerList,
+                      BundlePtrList &bundleList, AttrPtrList &attrList,
+                      const int timeEvalMode, SceneGraphCacheKey &out_key) {
+    out_key.nodes.clear();
+    out_key.attrNames.clear();
+    out_key.timeEvalMode = timeEvalMode;
+
+    out_key.nodes.reserve((cameraList.size() * 2) + markerList.size() +
+                          bundleList.size() + attrList.size());
+    out_key.attrNames.reserve(attrList.size());
+
+    for (auto &camera : cameraList) {
+        out_key.nodes.push_back(MObjectHandle(camera->getTransformObject()));
+        out_key.nodes.push_back(MObjectHandle(camera->getShapeObject()));
+    }
+    for (auto &marker : markerList) {
+        out_key.nodes.push_back(MObjectHandle(marker->getObject()));
+    }
+    for (auto &bundle : bundleList) {
+        out_key.nodes.push_back(MObjectHandle(bundle->getObject()));
+    }
+    for (auto &attr : attrList) {
+        out_key.nodes.push_back(MObjectHandle(attr->getObject()));
+        out_key.attrNames.push_back(attr->getAttrName());
+    }
+}
+
+void compute_frame_range(const MTimeArray &frameList,
+                         mmsg::FrameValue &out_start_frame,
+                         mmsg::FrameValue &out_end_frame,
+                         std::vector<mmsg::FrameValue> &out_frameList) {
+    auto uiUnit = MTime::uiUnit();
+    out_start_frame = std::numeric_limits<mmsg::FrameValue>::max();
+    out_end_frame = std::numeric_limits<mmsg::FrameValue>::min();
+    out_frameList.clear();
+    out_frameList.reserve(frameList.length());
+    for (uint32_t i = 0; i < frameList.length(); ++i) {
+        MTime frame = frameList[i];
+        auto frame_num = static_cast<mmsg::FrameValue>(frame.as(uiUnit));
+        out_start_frame = std::min(out_start_frame, frame_num);
+        out_end_frame = std::max(out_end_frame, frame_num);
+        out_frameList.push_back(frame_num);
+    }
+}
+
+MStatus resample_dirty_attributes(SceneGraphCacheEntry &entry) {
+    const bool verbose = false;
+    MStatus status = MS::kSuccess;
+    for (auto sample_index : entry.dynamicSamples) {
+        entry.markSampleDirty(sample_index);
+    }
+    if (!entry.anyDirty) {
+        return status;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < entry.attrSamples.size(); ++i) {
+        if (!entry.dirtySamples[i]) {
+            continue;
+        }
+        status = resample_scene_graph_attribute(
+            entry.attrSamples[i], entry.startFrame, entry.endFrame,
+            entry.key.timeEvalMode, entry.attrDataBlock);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        entry.dirtySamples[i] = false;
+        ++count;
+    }
+    entry.anyDirty = false;
+
+    MMSOLVER_MAYA_VRB("MM Scene Graph Cache: Re-sampled "
+                      << count << " of " << entry.attrSamples.size()
+                      << " attributes.");
+    return status;
+}
+
+void evict_least_recently_used() {
+    auto &entries = get_cache_state().entries;
+    while (entries.size() > SCENE_GRAPH_CACHE_MAX_ENTRIES) {
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if ((*it)->inUse) {
+                continue;
+            }
+            if ((oldest == entries.end()) ||
+                ((*it)->lastUsed < (*oldest)->lastUsed)) {
+                oldest = it;
+            }
+        }
+        if (oldest == entries.end()) {
+            // Every entry is in use.
+            break;
+        }
+        entries.erase(oldest);
+    }
+}
+
+}  // namespace
+
+bool SceneGraphCacheKey::operator==(const SceneGraphCacheKey &other) const {
+    return (timeEvalMode == other.timeEvalMode) && (nodes == other.nodes) &&
+           (attrNames == other.attrNames);
+}
+
+bool SceneGraphCacheKey::isValid() const {
+    for (auto &node : nodes) {
+        if (!node.isValid()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SceneGraphCacheEntry::~SceneGraphCacheEntry() { removeCallbacks(); }
+
+void SceneGraphCacheEntry::markSampleDirty(const size_t sampleIndex) {
+    if (sampleIndex < dirtySamples.size()) {
+        dirtySamples[sampleIndex] = true;
+        anyDirty = true;
+    }
+}
+
+void SceneGraphCacheEntry::markAttrIdsDirty(
+    const std::vector<mmsg::AttrId> &attrIds) {
+    for (auto &attrId : attrIds) {
+        auto search = attrIdToSampleIndex.find(attr_id_key(attrId));
+        if (search != attrIdToSampleIndex.end()) {
+            markSampleDirty(search->second);
+        }
+    }
+}
+
+void SceneGraphCacheEntry::removeCallbacks() {
+    for (auto &node_callback : nodeCallbacks) {
+        if (node_callback->callbackIds.length() > 0) {
+            MMessage::removeCallbacks(node_callback->callbackIds);
+            node_callback->callbackIds.clear();
+        }
+    }
+    nodeCallbacks.clear();
+}
+
+MStatus scene_graph_cache_acquire(
+    CameraPtrList &cameraList, MarkerPtrList &markerList,
+    BundlePtrList &bundleList, AttrPtrList &attrList,
+    const MTimeArray &frameList, const int timeEvalMode,
+    SceneGraphCacheEntry *&out_entry,
+    std::vector<mmsg::FrameValue> &out_frameList, bool &out_cacheHit) {
+    const bool verbose = false;
+    MStatus status = MS::kSuccess;
+    auto &state = get_cache_state();
+    out_entry = nullptr;
+    out_cacheHit = false;
+
+    add_global_callbacks();
+    purge_invalid_entries();
+
+    auto key = SceneGraphCacheKey();
+    create_cache_key(cameraList, markerList, bundleList, attrList,
+                     timeEvalMode, key);
+
+    auto start_frame = mmsg::FrameValue();
+    auto end_frame = mmsg::FrameValue();
+    compute_frame_range(frameList, start_frame, end_frame, out_frameList);
+
+    for (auto it = state.entries.begin(); it != state.entries.end(); ++it) {
+        auto &entry = *it;
+        if (entry->inUse || !(entry->key == key)) {
+            continue;
+        }
+
+        const bool covers_frames = (start_frame >= entry->startFrame) &&
+                                   (end_frame <= entry->endFrame);
+        if (covers_frames) {
+            status = resample_dirty_attributes(*entry);
+            if (status == MS::kSuccess) {
+                out_entry = entry.get();
+                break;
+            }
+            MMSOLVER_MAYA_VRB(
+                "MM Scene Graph Cache: Failed to re-sample attributes.");
+            status = MS::kSuccess;
+        }
+
+        // The entry cannot be used, so it will be replaced.
+        state.entries.erase(it);
+        break;
+    }
+
+    if (out_entry != nullptr) {
+        out_cacheHit = true;
+        ++state.hits;
+    } else {
+        ++state.misses;
+
+        auto entry = std::unique_ptr<SceneGraphCacheEntry>(
+            new SceneGraphCacheEntry());
+        entry->key = std::move(key);
+        entry->startFrame = start_frame;
+        entry->endFrame = end_frame;
+
+        auto mmsgFrameList = std::vector<mmsg::FrameValue>();
+        status = construct_scene_graph(
+            cameraList, markerList, bundleList, attrList, frameList,
+            timeEvalMode, entry->sceneGraph, entry->attrDataBlock,
+            entry->flatScene, mmsgFrameList, entry->cameraNodes,
+            entry->bundleNodes, entry->markerNodes, entry->attrIdList,
+            entry->attrSamples);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        entry->dirtySamples.resize(entry->attrSamples.size(), false);
+        entry->attrIdToSampleIndex.reserve(entry->attrSamples.size());
+        for (size_t i = 0; i < entry->attrSamples.size(); ++i) {
+            const auto &attrId = entry->attrSamples[i].attrId;
+            entry->attrIdToSampleIndex.insert({attr_id_key(attrId), i});
+        }
+
+        status = add_entry_callbacks(*entry, markerList);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        entry->valid = true;
+        out_entry = entry.get();
+        state.entries.push_back(std::move(entry));
+    }
+
+    out_entry->inUse = true;
+    out_entry->lastUsed = ++state.useCounter;
+    evict_least_recently_used();
+
+    MMSOLVER_MAYA_VRB("MM Scene Graph Cache: hit="
+                      << out_cacheHit << " entries=" << state.entries.size()
+                      << " hits=" << state.hits
+                      << " misses=" << state.misses);
+    return status;
+}
+
+void scene_graph_cache_release(
+    SceneGraphCacheEntry *entry,
+    const std::vector<mmsg::AttrId> &modifiedAttrIds) {
+    if (entry == nullptr) {
+        return;
+    }
+    entry->inUse = false;
+    entry->markAttrIdsDirty(modifiedAttrIds);
+    if (!entry->valid) {
+        purge_invalid_entries();
+    }
+}
+
+void scene_graph_cache_clear() {
+    auto &state = get_cache_state();
+    state.entries.clear();
+    if (state.globalCallbackIds.length() > 0) {
+        MMessage::removeCallbacks(state.globalCallbackIds);
+        state.globalCallbackIds.clear();
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * A persistent cache of MM Scene Graphs, re-used across solves.
+ *
+ * Constructing an MM Scene Graph samples every attribute of every
+ * node for every frame, which is expensive to repeat when the same
+ * set of objects is solved many times (for example, by a solver
+ * running many small solves).
+ *
+ * Each cache entry is keyed by the set of solve objects (cameras,
+ * markers, bundles and attributes) and the time evaluation
+ * mode. Maya callbacks watch the sampled nodes so that when an
+ * attribute is changed, only that attribute is re-sampled on the
+ * next solve. Attributes driven by nodes other than time animation
+ * curves (constraints, expressions, etc) are re-sampled on every
+ * solve. Changes that alter the structure of the scene graph
+ * (re-parenting, any connection change of a watched node, rotate
+ * order changes, the render resolution, etc) invalidate the entry
+ * entirely.
+ */
+
+#ifndef MM_SOLVER_MAYA_SCENE_GRAPH_CACHE_H
+#define MM_SOLVER_MAYA_SCENE_GRAPH_CACHE_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Maya
+#include <maya/MMessage.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MString.h>
+#include <maya/MTimeArray.h>
+
+// MM Scene Graph
+#include "mmscenegraph/mmscenegraph.h"
+
+// MM Solver
+#include "maya_attr.h"
+#include "maya_bundle.h"
+#include "maya_camera.h"
+#include "maya_marker.h"
+#include "maya_scene_graph.h"
+
+// The objects used to construct a scene graph.
+struct SceneGraphCacheKey {
+    std::vector<MObjectHandle> nodes;
+    std::vector<MString> attrNames;
+    int timeEvalMode;
+
+    SceneGraphCacheKey() : timeEvalMode(0) {}
+
+    bool operator==(const SceneGraphCacheKey &other) const;
+
+    // Are all the nodes in the key still alive in the Maya scene?
+    bool isValid() const;
+};
+
+struct SceneGraphCacheNodeCallback;
+
+struct SceneGraphCacheEntry {
+    SceneGraphCacheKey key;
+
+    // The range of frames sampled into 'attrDataBlock'.
+    mmscenegraph::FrameValue startFrame;
+    mmscenegraph::FrameValue endFrame;
+
+    mmscenegraph::SceneGraph sceneGraph;
+    mmscenegraph::AttrDataBlock attrDataBlock;
+    mmscenegraph::FlatScene flatScene;
+    std::vector<mmscenegraph::CameraNode> cameraNodes;
+    std::vector<mmscenegraph::BundleNode> bundleNodes;
+    std::vector<mmscenegraph::MarkerNode> markerNodes;
+    std::vector<mmscenegraph::AttrId> attrIdList;
+
+    std::vector<SceneGraphAttrSample> attrSamples;
+    std::unordered_map<uint64_t, size_t> attrIdToSampleIndex;
+
+    // Indexes into 'attrSamples' that must be re-sampled before the
+    // entry is used again.
+    std::vector<bool> dirtySamples;
+    bool anyDirty;
+
+    // Indexes into 'attrSamples' that are connected to a node that
+    // is not watched, and so are re-sampled every time the entry is
+    // used.
+    std::vector<size_t> dynamicSamples;
+
+    // When false, the entry must be re-constructed from scratch.
+    bool valid;
+
+    // Is the entry currently being used by a solve?
+    bool inUse;
+
+    uint64_t lastUsed;
+
+    std::vector<std::unique_ptr<SceneGraphCacheNodeCallback>> nodeCallbacks;
+
+    SceneGraphCacheEntry()
+        : startFrame(0)
+        , endFrame(0)
+        , anyDirty(false)
+        , valid(false)
+        , inUse(false)
+        , lastUsed(0) {}
+
+    ~SceneGraphCacheEntry();
+
+    void markSampleDirty(const size_t sampleIndex);
+    void markAttrIdsDirty(const std::vector<mmscenegraph::AttrId> &attrIds);
+    void removeCallbacks();
+};
+
+// Get a scene graph for the given objects and frames.
+//
+// If a valid scene graph was already constructed for the same
+// objects, covering the frames, it is returned with the changed
+// attributes re-sampled ('out_cacheHit' is true), otherwise a new
+// scene graph is constructed.
+//
+// The returned entry is owned by the cache, and must be given back
+// with 'scene_graph_cache_release' once the solve has finished.
+MStatus scene_graph_cache_acquire(
+    CameraPtrList &cameraList, MarkerPtrList &markerList,
+    BundlePtrList &bundleList, AttrPtrList &attrList,
+    const MTimeArray &frameList, const int timeEvalMode,
+    SceneGraphCacheEntry *&out_entry,
+    std::vector<mmscenegraph::FrameValue> &out_frameList,
+    bool &out_cacheHit);
+
+// Give the entry back to the cache.
+//
+// 'modifiedAttrIds' are the attributes that have been changed by
+// the solver, which will be re-sampled from Maya before the entry is
+// used again.
+void scene_graph_cache_release(
+    SceneGraphCacheEntry *entry,
+    const std::vector<mmscenegraph::AttrId> &modifiedAttrIds);
+
+// Remove all entries and Maya callbacks.
+void scene_graph_cache_clear();
+
+#endif  // MM_SOLVER_MAYA_SCENE_GRAPH_CACHE_H
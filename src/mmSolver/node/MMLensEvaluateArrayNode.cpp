@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Evaluate a lens distortion node to compute new coordinates for an
+ * array of points.
+ */
+
+#include "MMLensEvaluateArrayNode.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Maya
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MFnData.h>
+#include <maya/MFnDoubleArrayData.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MFnPluginData.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MPlug.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+// MM Solver
+#include "MMLensData.h"
+#include "mmSolver/nodeTypeIds.h"
+#include "mmSolver/utilities/debug_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
+
+namespace mmsolver {
+
+MTypeId MMLensEvaluateArrayNode::m_id(MM_LENS_EVALUATE_ARRAY_TYPE_ID);
+
+// Input Attributes
+MObject MMLensEvaluateArrayNode::a_inLens;
+MObject MMLensEvaluateArrayNode::a_inX;
+MObject MMLensEvaluateArrayNode::a_inY;
+MObject MMLensEvaluateArrayNode::a_threadCount;
+
+// Output Attributes
+MObject MMLensEvaluateArrayNode::a_outX;
+MObject MMLensEvaluateArrayNode::a_outY;
+MObject MMLensEvaluateArrayNode::a_outHash;
+
+namespace {
+
+// Points are evaluated on other threads in chunks of at least this
+// many points, otherwise handing the points to another thread costs
+// more than it saves.
+const size_t kMinPointCountPerChunk = 1024;
+
+MStatus get_double_array(MDataBlock &data, const MObject &attr,
+                         MDoubleArray &out_values) {
+    MStatus status;
+    MDataHandle handle = data.inputValue(attr, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MObject data_obj = handle.data();
+    if (data_obj.isNull()) {
+        out_values.clear();
+        return MS::kSuccess;
+    }
+
+    MFnDoubleArrayData fn_data(data_obj, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    out_values = fn_data.array(&status);
+    return status;
+}
+
+MStatus set_double_array(MDataBlock &data, const MObject &attr,
+                         const MDoubleArray &values) {
+    MStatus status;
+    MFnDoubleArrayData fn_data;
+    MObject data_obj = fn_data.create(values, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MDataHandle handle = data.outputValue(attr, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = handle.setMObject(data_obj);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    handle.setClean();
+    return status;
+}
+
+// Undistort the interleaved X and Y values of 'xy' (in place), split
+// into chunks evaluated on up to 'thread_count' threads.
+void undistort_points(mmlens::LensModel &lens_model, std::vector<double> &xy,
+                      const size_t thread_count) {
+    const size_t point_count = xy.size() / 2;
+    double *xy_data = xy.data();
+    mmthread::parallelForChunks(
+        point_count, thread_count, kMinPointCountPerChunk,
+        [&lens_model, xy_data](const size_t start, const size_t end) {
+            double *chunk_xy = xy_data + (start * 2);
+            lens_model.applyModelUndistortPoints(chunk_xy, chunk_xy,
+                                                 end - start);
+        });
+}
+
+}  // namespace
+
+MMLensEvaluateArrayNode::MMLensEvaluateArrayNode() {}
+
+MMLensEvaluateArrayNode::~MMLensEvaluateArrayNode() {}
+
+MString MMLensEvaluateArrayNode::nodeName() {
+    return MString("mmLensEvaluateArray");
+}
+
+MStatus MMLensEvaluateArrayNode::compute(const MPlug &plug, MDataBlock &data) {
+    MStatus status = MS::kUnknownParameter;
+
+    if ((plug == a_outX) || (plug == a_outY) || (plug == a_outHash)) {
+        // Get Input Positions
+        MDoubleArray in_x;
+        MDoubleArray in_y;
+        status = get_double_array(data, a_inX, in_x);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = get_double_array(data, a_inY, in_y);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        // Extra values in the longer array have no matching value, and
+        // are ignored.
+        const unsigned int point_count = std::min(in_x.length(), in_y.length());
+
+        MDataHandle threadCountHandle = data.inputValue(a_threadCount, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        // Zero means use the default number of threads.
+        const size_t thread_count =
+            static_cast<size_t>(std::max(0, threadCountHandle.asInt()));
+
+        MDoubleArray out_x(point_count, 0.0);
+        MDoubleArray out_y(point_count, 0.0);
+        for (unsigned int i = 0; i < point_count; ++i) {
+            out_x[i] = in_x[i];
+            out_y[i] = in_y[i];
+        }
+        int64_t out_hash = 0;
+
+        // Get Input Lens
+        MDataHandle inLensHandle = data.inputValue(a_inLens, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        MMLensData *inputLensData = (MMLensData *)inLensHandle.asPluginData();
+        if (inputLensData != nullptr) {
+            std::shared_ptr<mmlens::LensModel> lensModel =
+                inputLensData->getValue();
+            if (lensModel != nullptr) {
+                // Evaluate the lens distortion for all points at once.
+                std::vector<double> xy(point_count * 2);
+                for (unsigned int i = 0; i < point_count; ++i) {
+                    xy[(i * 2) + 0] = in_x[i];
+                    xy[(i * 2) + 1] = in_y[i];
+                }
+                undistort_points(*lensModel, xy, thread_count);
+
+                for (unsigned int i = 0; i < point_count; ++i) {
+                    const double temp_out_x = xy[(i * 2) + 0];
+                    const double temp_out_y = xy[(i * 2) + 1];
+                    if (std::isfinite(temp_out_x)) {
+                        out_x[i] = temp_out_x;
+                    }
+                    if (std::isfinite(temp_out_y)) {
+                        out_y[i] = temp_out_y;
+                    }
+                }
+
+                out_hash = lensModel->hashValue();
+            }
+        }
+
+        // Output
+        status = set_double_array(data, a_outX, out_x);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = set_double_array(data, a_outY, out_y);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        MDataHandle outHashHandle = data.outputValue(a_outHash);
+        outHashHandle.setInt64(out_hash);
+        outHashHandle.setClean();
+        status = MS::kSuccess;
+    }
+
+    return status;
+}
+
+void *MMLensEvaluateArrayNode::creator() {
+    return (new MMLensEvaluateArrayNode());
+}
+
+MStatus MMLensEvaluateArrayNode::initialize() {
+    MStatus status;
+    MFnNumericAttribute numericAttr;
+    MFnTypedAttribute typedAttr;
+    MFnDoubleArrayData doubleArrayData;
+
+    // In Lens
+    MTypeId data_type_id(MM_LENS_DATA_TYPE_ID);
+    a_inLens = typedAttr.create("inLens", "ilns", data_type_id);
+    CHECK_MSTATUS(typedAttr.setStorable(false));
+    CHECK_MSTATUS(typedAttr.setKeyable(false));
+    CHECK_MSTATUS(typedAttr.setReadable(true));
+    CHECK_MSTATUS(typedAttr.setWritable(true));
+    CHECK_MSTATUS(addAttribute(a_inLens));
+
+    // In X
+    a_inX = typedAttr.create("inX", "ix", MFnData::kDoubleArray,
+                             doubleArrayData.create());
+    CHECK_MSTATUS(typedAttr.setStorable(true));
+    CHECK_MSTATUS(typedAttr.setKeyable(false));
+    CHECK_MSTATUS(addAttribute(a_inX));
+
+    // In Y
+    a_inY = typedAttr.create("inY", "iy", MFnData::kDoubleArray,
+                             doubleArrayData.create());
+    CHECK_MSTATUS(typedAttr.setStorable(true));
+    CHECK_MSTATUS(typedAttr.setKeyable(false));
+    CHECK_MSTATUS(addAttribute(a_inY));
+
+    // Thread Count
+    //
+    // Zero (the default) uses all hardware threads.
+    a_threadCount =
+        numericAttr.create("threadCount", "thc", MFnNumericData::kInt, 0);
+    CHECK_MSTATUS(numericAttr.setStorable(true));
+    CHECK_MSTATUS(numericAttr.setKeyable(false));
+    CHECK_MSTATUS(numericAttr.setChannelBox(true));
+    CHECK_MSTATUS(numericAttr.setMin(0));
+    CHECK_MSTATUS(addAttribute(a_threadCount));
+
+    // Out X
+    a_outX = typedAttr.create("outX", "ox", MFnData::kDoubleArray,
+                              doubleArrayData.create());
+    CHECK_MSTATUS(typedAttr.setStorable(false));
+    CHECK_MSTATUS(typedAttr.setKeyable(false));
+    CHECK_MSTATUS(typedAttr.setReadable(true));
+    CHECK_MSTATUS(typedAttr.setWritable(false));
+    CHECK_MSTATUS(addAttribute(a_outX));
+
+    // Out Y
+    a_outY = typedAttr.create("outY", "oy", MFnData::kDoubleArray,
+                              doubleArrayData.create());
+    CHECK_MSTATUS(typedAttr.setStorable(false));
+    CHECK_MSTATUS(typedAttr.setKeyable(false));
+    CHECK_MSTATUS(typedAttr.setReadable(true));
+    CHECK_MSTATUS(typedAttr.setWritable(false));
+    CHECK_MSTATUS(addAttribute(a_outY));
+
+    // Out Hash
+    a_outHash =
+        numericAttr.create("outHash", "outHash", MFnNumericData::kInt64, 0);
+    CHECK_MSTATUS(numericAttr.setStorable(false));
+    CHECK_MSTATUS(numericAttr.setKeyable(false));
+    CHECK_MSTATUS(numericAttr.setReadable(true));
+    CHECK_MSTATUS(numericAttr.setWritable(false));
+    CHECK_MSTATUS(addAttribute(a_outHash));
+
+    // Attribute Affects
+    CHECK_MSTATUS(attributeAffects(a_inX, a_outX));
+    CHECK_MSTATUS(attributeAffects(a_inX, a_outY));
+    CHECK_MSTATUS(attributeAffects(a_inX, a_outHash));
+
+    CHECK_MSTATUS(attributeAffects(a_inY, a_outX));
+    CHECK_MSTATUS(attributeAffects(a_inY, a_outY));
+    CHECK_MSTATUS(attributeAffects(a_inY, a_outHash));
+
+    CHECK_MSTATUS(attributeAffects(a_threadCount, a_outX));
+    CHECK_MSTATUS(attributeAffects(a_threadCount, a_outY));
+
+    CHECK_MSTATUS(attributeAffects(a_inLens, a_outX));
+    CHECK_MSTATUS(attributeAffects(a_inLens, a_outY));
+    CHECK_MSTATUS(attributeAffects(a_inLens, a_outHash));
+
+    return MS::kSuccess;
+}
+
+}  // namespace mmsolver
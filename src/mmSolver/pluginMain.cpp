@@ -36,10 +36,12 @@
 #include "mmSolver/nodeTypeIds.h"
 
 // Solver and nodes
+#include "mmSolver/cmd/MMBundleTriangulateCmd.h"
 #include "mmSolver/cmd/MMCameraPoseFromPointsCmd.h"
 #include "mmSolver/cmd/MMCameraRelativePoseCmd.h"
 #include "mmSolver/cmd/MMCameraSolveCmd.h"
 #include "mmSolver/cmd/MMConvertImageCmd.h"
+#include "mmSolver/cmd/MMImageCacheCmd.h"
 #include "mmSolver/cmd/MMMarkerHomographyCmd.h"
 #include "mmSolver/cmd/MMReadImageCmd.h"
 #include "mmSolver/cmd/MMReprojectionCmd.h"
@@ -49,10 +51,13 @@
 #include "mmSolver/cmd/MMSolverSceneGraphCmd.h"
 #include "mmSolver/cmd/MMSolverTypeCmd.h"
 #include "mmSolver/cmd/MMTestCameraMatrixCmd.h"
+#include "mmSolver/image/image_cache.h"
+#include "mmSolver/mayahelper/maya_scene_graph_cache.h"
 #include "mmSolver/node/MMCameraCalibrateNode.h"
 #include "mmSolver/node/MMImagePlaneTransformNode.h"
 #include "mmSolver/node/MMLensData.h"
 #include "mmSolver/node/MMLensDeformerNode.h"
+#include "mmSolver/node/MMLensEvaluateArrayNode.h"
 #include "mmSolver/node/MMLensEvaluateNode.h"
 #include "mmSolver/node/MMLensModel3deNode.h"
 #include "mmSolver/node/MMLensModelToggleNode.h"
@@ -75,6 +80,7 @@
 #include "mmSolver/shape/MarkerShapeNode.h"
 #include "mmSolver/shape/SkyDomeDrawOverride.h"
 #include "mmSolver/shape/SkyDomeShapeNode.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 // MM Renderer
 #if MMSOLVER_BUILD_RENDERER == 1
@@ -239,6 +245,10 @@ MStatus initializePlugin(MObject obj) {
                      mmsolver::MMTestCameraMatrixCmd::creator,
                      mmsolver::MMTestCameraMatrixCmd::newSyntax, status);
 
+    REGISTER_COMMAND(plugin, mmsolver::MMBundleTriangulateCmd::cmdName(),
+                     mmsolver::MMBundleTriangulateCmd::creator,
+                     mmsolver::MMBundleTriangulateCmd::newSyntax, status);
+
     REGISTER_COMMAND(plugin, mmsolver::MMCameraPoseFromPointsCmd::cmdName(),
                      mmsolver::MMCameraPoseFromPointsCmd::creator,
                      mmsolver::MMCameraPoseFromPointsCmd::newSyntax, status);
@@ -255,6 +265,10 @@ MStatus initializePlugin(MObject obj) {
                      mmsolver::MMConvertImageCmd::creator,
                      mmsolver::MMConvertImageCmd::newSyntax, status);
 
+    REGISTER_COMMAND(plugin, mmsolver::MMImageCacheCmd::cmdName(),
+                     mmsolver::MMImageCacheCmd::creator,
+                     mmsolver::MMImageCacheCmd::newSyntax, status);
+
     REGISTER_COMMAND(plugin, mmsolver::MMMarkerHomographyCmd::cmdName(),
                      mmsolver::MMMarkerHomographyCmd::creator,
                      mmsolver::MMMarkerHomographyCmd::newSyntax, status);
@@ -304,6 +318,11 @@ MStatus initializePlugin(MObject obj) {
                   mmsolver::MMLensEvaluateNode::creator,
                   mmsolver::MMLensEvaluateNode::initialize, status);
 
+    REGISTER_NODE(plugin, mmsolver::MMLensEvaluateArrayNode::nodeName(),
+                  mmsolver::MMLensEvaluateArrayNode::m_id,
+                  mmsolver::MMLensEvaluateArrayNode::creator,
+                  mmsolver::MMLensEvaluateArrayNode::initialize, status);
+
     REGISTER_NODE(plugin, mmsolver::MMLensModel3deNode::nodeName(),
                   mmsolver::MMLensModel3deNode::m_id,
                   mmsolver::MMLensModel3deNode::creator,
@@ -557,6 +576,18 @@ MStatus uninitializePlugin(MObject obj) {
 
     MMSOLVER_MAYA_VRB("Uninitializing " << MODULE_FULL_NAME);
 
+    // Cached scene graphs hold Maya callbacks, which must be removed
+    // before the plug-in is unloaded.
+    scene_graph_cache_clear();
+
+    // The image cache reader threads must be stopped before the
+    // plug-in code is unloaded.
+    mmsolver::image::image_cache_shutdown();
+
+    // The same for the threads shared by multi-threaded commands and
+    // nodes.
+    mmthread::sharedThreadPoolShutdown();
+
 #if MMSOLVER_BUILD_RENDERER == 1
     MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
     if (renderer) {
@@ -598,12 +629,15 @@ MStatus uninitializePlugin(MObject obj) {
                        status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMTestCameraMatrixCmd::cmdName(),
                        status);
+    DEREGISTER_COMMAND(plugin, mmsolver::MMBundleTriangulateCmd::cmdName(),
+                       status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMCameraPoseFromPointsCmd::cmdName(),
                        status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMCameraRelativePoseCmd::cmdName(),
                        status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMCameraSolveCmd::cmdName(), status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMConvertImageCmd::cmdName(), status);
+    DEREGISTER_COMMAND(plugin, mmsolver::MMImageCacheCmd::cmdName(), status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMMarkerHomographyCmd::cmdName(),
                        status);
     DEREGISTER_COMMAND(plugin, mmsolver::MMReadImageCmd::cmdName(), status);
@@ -668,6 +702,9 @@ MStatus uninitializePlugin(MObject obj) {
     DEREGISTER_NODE(plugin, mmsolver::MMLensEvaluateNode::nodeName(),
                     mmsolver::MMLensEvaluateNode::m_id, status);
 
+    DEREGISTER_NODE(plugin, mmsolver::MMLensEvaluateArrayNode::nodeName(),
+                    mmsolver::MMLensEvaluateArrayNode::m_id, status);
+
     DEREGISTER_NODE(plugin, mmsolver::MMLensModel3deNode::nodeName(),
                     mmsolver::MMLensModel3deNode::m_id, status);
 
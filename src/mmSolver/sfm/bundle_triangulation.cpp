@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Triangulate bundle positions from all of their marker observations.
+ */
+
+#include "bundle_triangulation.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <openMVG/multiview/triangulation_nview.hpp>
+#include <openMVG/numeric/numeric.h>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
+
+namespace mmsolver {
+namespace sfm {
+
+namespace {
+
+// A point closer to the camera plane (in camera space) than this is
+// considered to be behind the camera.
+const double kMinimumDepth = 1.0e-9;
+
+// Refinement stops when the position changes less than this, relative
+// to the distance to the cameras.
+const double kRefineRelativeTolerance = 1.0e-10;
+
+// One marker observation of a bundle, on a frame with a valid camera.
+struct Observation {
+    openMVG::Vec2 coord;
+    const openMVG::Mat34 *camera_matrix;
+    double focal_length_pix;
+    double ppx_pix;
+    double ppy_pix;
+
+    // The normalized ray direction in world space.
+    openMVG::Vec3 world_ray;
+};
+
+openMVG::Vec3 camera_bearing(const Observation &observation) {
+    return openMVG::Vec3(
+        (observation.coord(0) - observation.ppx_pix) /
+            observation.focal_length_pix,
+        (observation.coord(1) - observation.ppy_pix) /
+            observation.focal_length_pix,
+        1.0);
+}
+
+// The reprojection error (pixels) of 'point' in the observation, or
+// a negative value if the point is behind the camera.
+double reprojection_error(const Observation &observation,
+                          const openMVG::Vec3 &point) {
+    const openMVG::Mat34 &camera_matrix = *observation.camera_matrix;
+    const openMVG::Vec3 point_camera =
+        camera_matrix.block<3, 3>(0, 0) * point + camera_matrix.col(3);
+    if (point_camera(2) < kMinimumDepth) {
+        return -1.0;
+    }
+    const double u =
+        (observation.focal_length_pix * point_camera(0) / point_camera(2)) +
+        observation.ppx_pix;
+    const double v =
+        (observation.focal_length_pix * point_camera(1) / point_camera(2)) +
+        observation.ppy_pix;
+    const double du = u - observation.coord(0);
+    const double dv = v - observation.coord(1);
+    return std::sqrt((du * du) + (dv * dv));
+}
+
+// The angle (degrees) between the world space rays of two
+// observations.
+double ray_angle_deg(const Observation &a, const Observation &b) {
+    const double cos_angle =
+        std::max(-1.0, std::min(1.0, a.world_ray.dot(b.world_ray)));
+    return std::acos(cos_angle) * RADIANS_TO_DEGREES;
+}
+
+bool triangulate_observations(const std::vector<Observation> &observations,
+                              const std::vector<size_t> &indices,
+                              openMVG::Vec3 &out_point) {
+    openMVG::Mat3X bearings(3, indices.size());
+    std::vector<openMVG::Mat34> camera_matrices;
+    camera_matrices.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const Observation &observation = observations[indices[i]];
+        bearings.col(i) = camera_bearing(observation);
+        camera_matrices.push_back(*observation.camera_matrix);
+    }
+
+    openMVG::Vec4 point_homogeneous;
+    const bool ok = openMVG::TriangulateNViewAlgebraic(
+        bearings, camera_matrices, &point_homogeneous);
+    if (!ok || (std::abs(point_homogeneous(3)) < kMinimumDepth)) {
+        return false;
+    }
+    out_point = point_homogeneous.hnormalized();
+    return out_point.allFinite();
+}
+
+void find_inliers(const std::vector<Observation> &observations,
+                  const openMVG::Vec3 &point, const double max_error_pix,
+                  std::vector<size_t> &out_inliers) {
+    out_inliers.clear();
+    for (size_t i = 0; i < observations.size(); ++i) {
+        const double error = reprojection_error(observations[i], point);
+        if ((error >= 0.0) && (error <= max_error_pix)) {
+            out_inliers.push_back(i);
+        }
+    }
+}
+
+// Minimise the reprojection error of the inlier observations, with
+// Gauss-Newton iterations on the 3 point coordinates.
+void refine_point(const std::vector<Observation> &observations,
+                  const std::vector<size_t> &inliers,
+                  const size_t max_iteration_count, openMVG::Vec3 &point) {
+    for (size_t iteration = 0; iteration < max_iteration_count;
+         ++iteration) {
+        openMVG::Mat3 jtj = openMVG::Mat3::Zero();
+        openMVG::Vec3 jtr = openMVG::Vec3::Zero();
+        double error_sum = 0.0;
+        for (const size_t index : inliers) {
+            const Observation &observation = observations[index];
+            const openMVG::Mat34 &camera_matrix = *observation.camera_matrix;
+            const openMVG::Mat3 rotation = camera_matrix.block<3, 3>(0, 0);
+            const openMVG::Vec3 point_camera =
+                rotation * point + camera_matrix.col(3);
+            if (point_camera(2) < kMinimumDepth) {
+                return;
+            }
+
+            const double inverse_z = 1.0 / point_camera(2);
+            const double x = point_camera(0) * inverse_z;
+            const double y = point_camera(1) * inverse_z;
+            const double focal = observation.focal_length_pix;
+            const openMVG::Vec2 residual(
+                (focal * x) + observation.ppx_pix - observation.coord(0),
+                (focal * y) + observation.ppy_pix - observation.coord(1));
+
+            // The derivative of the projection with respect to the
+            // camera space point, multiplied by the derivative of the
+            // camera space point with respect to the world point.
+            Eigen::Matrix<double, 2, 3> jacobian_projection;
+            jacobian_projection << focal * inverse_z, 0.0,
+                -focal * x * inverse_z, 0.0, focal * inverse_z,
+                -focal * y * inverse_z;
+            const Eigen::Matrix<double, 2, 3> jacobian =
+                jacobian_projection * rotation;
+
+            jtj += jacobian.transpose() * jacobian;
+            jtr += jacobian.transpose() * residual;
+            error_sum += residual.squaredNorm();
+        }
+
+        const openMVG::Vec3 delta = jtj.ldlt().solve(-jtr);
+        if (!delta.allFinite()) {
+            return;
+        }
+        const openMVG::Vec3 new_point = point + delta;
+
+        // Only accept steps that reduce the error.
+        double new_error_sum = 0.0;
+        for (const size_t index : inliers) {
+            const double error =
+                reprojection_error(observations[index], new_point);
+            if (error < 0.0) {
+                return;
+            }
+            new_error_sum += error * error;
+        }
+        if (new_error_sum > error_sum) {
+            return;
+        }
+
+        point = new_point;
+        if (delta.norm() <= (kRefineRelativeTolerance * point.norm())) {
+            return;
+        }
+    }
+}
+
+void triangulate_bundle(const MarkerTracks &tracks,
+                        const std::vector<openMVG::Mat34> &camera_matrices,
+                        const std::vector<uint8_t> &camera_valid,
+                        const BundleTriangulationOptions &options,
+                        const size_t marker_index,
+                        BundleTriangulationResult &out_result) {
+    out_result = BundleTriangulationResult();
+
+    std::vector<Observation> observations;
+    for (size_t frame_index = 0; frame_index < tracks.frames.size();
+         ++frame_index) {
+        const size_t index = tracks.index(frame_index, marker_index);
+        if (!tracks.valid[index] || !camera_valid[frame_index]) {
+            continue;
+        }
+        const MarkerTrackFrame &frame = tracks.frames[frame_index];
+        Observation observation;
+        observation.coord = openMVG::Vec2(tracks.coords[(index * 2) + 0],
+                                          tracks.coords[(index * 2) + 1]);
+        observation.camera_matrix = &camera_matrices[frame_index];
+        observation.focal_length_pix = frame.focal_length_pix;
+        observation.ppx_pix = frame.ppx_pix;
+        observation.ppy_pix = frame.ppy_pix;
+        const openMVG::Mat3 rotation =
+            camera_matrices[frame_index].block<3, 3>(0, 0);
+        observation.world_ray =
+            (rotation.inverse() * camera_bearing(observation)).normalized();
+        observations.push_back(observation);
+    }
+    const size_t observation_count = observations.size();
+    out_result.observation_count = observation_count;
+    if ((observation_count < 2) ||
+        (observation_count < options.min_inlier_count)) {
+        return;
+    }
+
+    // Two-view hypotheses. All pairs are tested when there are few
+    // enough, otherwise random pairs are tested, with a generator
+    // seeded by the marker index so results are repeatable.
+    std::vector<std::pair<size_t, size_t>> pairs;
+    const size_t all_pair_count =
+        (observation_count * (observation_count - 1)) / 2;
+    if (all_pair_count <= options.max_hypothesis_count) {
+        for (size_t i = 0; i < observation_count; ++i) {
+            for (size_t j = i + 1; j < observation_count; ++j) {
+                pairs.push_back({i, j});
+            }
+        }
+    } else {
+        std::mt19937 random_generator(static_cast<uint32_t>(marker_index));
+        std::uniform_int_distribution<size_t> distribution(
+            0, observation_count - 1);
+        while (pairs.size() < options.max_hypothesis_count) {
+            const size_t i = distribution(random_generator);
+            const size_t j = distribution(random_generator);
+            if (i != j) {
+                pairs.push_back({std::min(i, j), std::max(i, j)});
+            }
+        }
+    }
+
+    std::vector<size_t> best_inliers;
+    std::vector<size_t> inliers;
+    std::vector<size_t> pair_indices(2);
+    for (const auto &pair : pairs) {
+        if (ray_angle_deg(observations[pair.first],
+                          observations[pair.second]) <
+            options.min_triangulation_angle_deg) {
+            continue;
+        }
+        pair_indices[0] = pair.first;
+        pair_indices[1] = pair.second;
+        openMVG::Vec3 point;
+        if (!triangulate_observations(observations, pair_indices, point)) {
+            continue;
+        }
+        find_inliers(observations, point, options.max_reprojection_error_pix,
+                     inliers);
+        if (inliers.size() > best_inliers.size()) {
+            std::swap(best_inliers, inliers);
+        }
+    }
+    if ((best_inliers.size() < 2) ||
+        (best_inliers.size() < options.min_inlier_count)) {
+        return;
+    }
+
+    // Triangulate all inliers together, refine, then find the inliers
+    // of the refined position.
+    openMVG::Vec3 point;
+    if (!triangulate_observations(observations, best_inliers, point)) {
+        return;
+    }
+    refine_point(observations, best_inliers,
+                 options.max_refine_iteration_count, point);
+    find_inliers(observations, point, options.max_reprojection_error_pix,
+                 inliers);
+    if ((inliers.size() < 2) || (inliers.size() < options.min_inlier_count)) {
+        return;
+    }
+
+    // The widest angle between the first inlier ray and the others.
+    double angle_deg = 0.0;
+    const Observation &first_inlier = observations[inliers[0]];
+    for (size_t i = 1; i < inliers.size(); ++i) {
+        angle_deg = std::max(
+            angle_deg, ray_angle_deg(first_inlier, observations[inliers[i]]));
+    }
+    if (angle_deg < options.min_triangulation_angle_deg) {
+        return;
+    }
+
+    double error_sum = 0.0;
+    double error_max = 0.0;
+    for (const size_t index : inliers) {
+        const double error = reprojection_error(observations[index], point);
+        error_sum += error * error;
+        error_max = std::max(error_max, error);
+    }
+
+    out_result.ok = true;
+    out_result.position = point;
+    out_result.inlier_count = inliers.size();
+    out_result.error_rms_pix =
+        std::sqrt(error_sum / static_cast<double>(inliers.size()));
+    out_result.error_max_pix = error_max;
+    out_result.angle_deg = angle_deg;
+}
+
+}  // namespace
+
+void triangulate_bundles(const MarkerTracks &tracks,
+                         const std::vector<openMVG::Mat34> &camera_matrices,
+                         const std::vector<uint8_t> &camera_valid,
+                         const BundleTriangulationOptions &options,
+                         std::vector<BundleTriangulationResult> &out_results) {
+    const size_t marker_count = tracks.marker_count;
+    out_results.clear();
+    out_results.resize(marker_count);
+
+    auto solve_bundle = [&](const size_t marker_index) {
+        triangulate_bundle(tracks, camera_matrices, camera_valid, options,
+                           marker_index, out_results[marker_index]);
+    };
+
+    const size_t min_chunk_size = 1;
+    mmthread::parallelForChunks(
+        marker_count, std::max<size_t>(options.thread_count, 1),
+        min_chunk_size, [&solve_bundle](const size_t start, const size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                solve_bundle(i);
+            }
+        });
+}
+
+}  // namespace sfm
+}  // namespace mmsolver
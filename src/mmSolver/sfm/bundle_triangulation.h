@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Triangulate bundle positions from all of their marker observations
+ * of a solved camera.
+ *
+ * Each bundle is triangulated independently:
+ *
+ * - Two-view triangulations of pairs of observations are used as
+ *   hypotheses, and the hypothesis with the most observations within
+ *   the error threshold (the inliers) is kept.
+ *
+ * - The inliers are triangulated together with the multi-view DLT
+ *   (Direct Linear Transform).
+ *
+ * - The position is refined with Gauss-Newton iterations, minimising
+ *   the reprojection error of the inliers.
+ */
+
+#ifndef MM_SOLVER_SFM_BUNDLE_TRIANGULATION_H
+#define MM_SOLVER_SFM_BUNDLE_TRIANGULATION_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <openMVG/numeric/eigen_alias_definition.hpp>
+#include <openMVG/numeric/numeric.h>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/sfm/marker_tracks.h"
+
+namespace mmsolver {
+namespace sfm {
+
+struct BundleTriangulationOptions {
+    // Bundles with fewer inlier observations are not triangulated.
+    size_t min_inlier_count;
+
+    // Observations with a larger reprojection error (pixels) are
+    // outliers.
+    double max_reprojection_error_pix;
+
+    // Bundles are only triangulated when the widest angle (degrees)
+    // between the inlier rays is at least this angle.
+    double min_triangulation_angle_deg;
+
+    // The number of two-view hypotheses tested per bundle.
+    size_t max_hypothesis_count;
+
+    size_t max_refine_iteration_count;
+
+    size_t thread_count;
+
+    BundleTriangulationOptions()
+        : min_inlier_count(2)
+        , max_reprojection_error_pix(2.0)
+        , min_triangulation_angle_deg(1.0)
+        , max_hypothesis_count(64)
+        , max_refine_iteration_count(10)
+        , thread_count(1) {}
+};
+
+struct BundleTriangulationResult {
+    bool ok;
+    openMVG::Vec3 position;
+    size_t observation_count;
+    size_t inlier_count;
+    double error_rms_pix;
+    double error_max_pix;
+    double angle_deg;
+
+    BundleTriangulationResult()
+        : ok(false)
+        , position(openMVG::Vec3::Zero())
+        , observation_count(0)
+        , inlier_count(0)
+        , error_rms_pix(0.0)
+        , error_max_pix(0.0)
+        , angle_deg(0.0) {}
+};
+
+// Triangulate the bundle of each marker in 'tracks'.
+//
+// 'camera_matrices' has one [R|t] matrix per frame of 'tracks',
+// transforming world space points into the camera space of the
+// frame, where the camera looks down +Z (as in OpenMVG). Frames with
+// 'camera_valid' set to zero are not used. 'out_results' has one
+// result per marker, with the position in world space.
+//
+// Bundles are triangulated in parallel on 'thread_count' threads. No
+// Maya API functions are called, and nothing is printed. Results do
+// not depend on the thread count.
+void triangulate_bundles(const MarkerTracks &tracks,
+                         const std::vector<openMVG::Mat34> &camera_matrices,
+                         const std::vector<uint8_t> &camera_valid,
+                         const BundleTriangulationOptions &options,
+                         std::vector<BundleTriangulationResult> &out_results);
+
+}  // namespace sfm
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_SFM_BUNDLE_TRIANGULATION_H
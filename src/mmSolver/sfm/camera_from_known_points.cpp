@@ -83,25 +83,32 @@
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
+#include "mmSolver/sfm/parallel_ac_ransac.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 namespace mmsolver {
 namespace sfm {
 
-// Use AC-RANSAC to try and find the camera pose from matching 2D and 3D points.
+namespace {
+
+// Use AC-RANSAC to try and find the camera pose from matching 2D and
+// 3D points, without printing anything, so this may be run on any
+// thread.
 //
-// - The points_3d matrix is expected to have the Z-coordinate flipped
-//   to match OpenMVG (rather than Maya).
-bool robust_camera_pose_from_known_points(
+// The random number generators used by AC-RANSAC are created (with
+// fixed seeds) for each call, so the same input always gives the same
+// result, no matter which thread runs it, or how many threads
+// AC-RANSAC uses.
+bool estimate_camera_pose_from_known_points(
     const openMVG::Mat &points_2d, const openMVG::Mat &points_3d,
     const std::pair<size_t, size_t> &image_size, const double focal_length_pix,
     const double ppx_pix, const double ppy_pix,
-    const size_t max_iteration_count, openMVG::Mat34 &out_projection_matrix) {
-    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
-    const bool verbose = false;
-
+    const size_t max_iteration_count, const size_t thread_count,
+    openMVG::Mat34 &out_projection_matrix,
+    double &out_error_max, double &out_min_nfa, size_t &out_inlier_count) {
     // Upper bound pixel tolerance for residual errors.
     double error_upper_bound = std::numeric_limits<double>::infinity();
 
@@ -126,32 +133,68 @@ bool robust_camera_pose_from_known_points(
 
     // Robustly estimate the Resection matrix with A Contrario (AC)
     // RANSAC.
-    const auto ac_ransac_output = openMVG::robust::ACRANSAC(
-        kernel, vec_inliers, max_iteration_count, &out_projection_matrix,
-        error_upper_bound, verbose);
+    ParallelACRansacOptions ac_ransac_options;
+    ac_ransac_options.max_iteration_count = max_iteration_count;
+    ac_ransac_options.precision = error_upper_bound;
+    ac_ransac_options.thread_count = thread_count;
+    const auto ac_ransac_output = parallel_ac_ransac(
+        kernel, vec_inliers, ac_ransac_options, &out_projection_matrix);
     // The amount of pixel error that is computed.
-    double out_error_max = ac_ransac_output.first;
+    out_error_max = ac_ransac_output.first;
 
     // NFA = Number of False Alarms.
-    double out_min_nfa = ac_ransac_output.second;
+    out_min_nfa = ac_ransac_output.second;
+
+    out_inlier_count = vec_inliers.size();
+    const size_t minimum_samples = SolverType::MINIMUM_SAMPLES;
+    return out_inlier_count >= minimum_samples;
+}
 
-    auto solution_found = false;
-    const size_t samples = vec_inliers.size();
-    const int minimum_samples = SolverType::MINIMUM_SAMPLES;
-    if (samples < minimum_samples) {
+openMVG::geometry::Pose3 convert_projection_matrix_to_pose(
+    const openMVG::Mat34 &projection_matrix) {
+    openMVG::Mat3 intrinsic_matrix;
+    openMVG::Mat3 rotation_matrix;
+    openMVG::Vec3 translation_vector;
+    openMVG::KRt_From_P(projection_matrix, &intrinsic_matrix, &rotation_matrix,
+                        &translation_vector);
+
+    return openMVG::geometry::Pose3(
+        rotation_matrix, -rotation_matrix.transpose() * translation_vector);
+}
+
+}  // namespace
+
+// Use AC-RANSAC to try and find the camera pose from matching 2D and 3D points.
+//
+// - The points_3d matrix is expected to have the Z-coordinate flipped
+//   to match OpenMVG (rather than Maya).
+bool robust_camera_pose_from_known_points(
+    const openMVG::Mat &points_2d, const openMVG::Mat &points_3d,
+    const std::pair<size_t, size_t> &image_size, const double focal_length_pix,
+    const double ppx_pix, const double ppy_pix,
+    const size_t max_iteration_count, const size_t thread_count,
+    openMVG::Mat34 &out_projection_matrix) {
+    // Enable to print out 'MMSOLVER_MAYA_VRB' results.
+    const bool verbose = false;
+
+    double out_error_max = 0.0;
+    double out_min_nfa = 0.0;
+    size_t samples = 0;
+    const bool solution_found = estimate_camera_pose_from_known_points(
+        points_2d, points_3d, image_size, focal_length_pix, ppx_pix, ppy_pix,
+        max_iteration_count, thread_count, out_projection_matrix,
+        out_error_max, out_min_nfa, samples);
+    if (!solution_found) {
         // no sufficient coverage (not enough matching data points
         // given)
+        const int minimum_samples =
+            openMVG::euclidean_resection::P3PSolver_Nordberg::MINIMUM_SAMPLES;
         MMSOLVER_MAYA_WRN(
             "Camera Pose could not be found with at least 3 points."
             << " error=" << out_error_max << " pixels"
             << ", number of false alarms=" << out_min_nfa
             << ", minimum samples required=" << minimum_samples
             << ", valid samples=" << samples);
-    } else {
-        solution_found = true;
-    }
-
-    if (!solution_found) {
         return false;
     }
 
@@ -201,26 +244,68 @@ bool compute_camera_pose_from_known_points(
     auto num_max_iter = 1024;
     bool ok = robust_camera_pose_from_known_points(
         marker_coords_matrix, bundle_coords_matrix, image_size,
-        focal_length_pix, ppx_pix, ppy_pix, num_max_iter, projection_matrix);
+        focal_length_pix, ppx_pix, ppy_pix, num_max_iter,
+        mmthread::defaultThreadCount(), projection_matrix);
     if (!ok) {
         MMSOLVER_MAYA_ERR(
             "Robust camera pose from known points estimation failure.");
         return false;
     }
 
-    openMVG::Mat3 intrinsic_matrix;
-    openMVG::Mat3 rotation_matrix;
-    openMVG::Vec3 translation_vector;
-    openMVG::KRt_From_P(projection_matrix, &intrinsic_matrix, &rotation_matrix,
-                        &translation_vector);
-
-    auto pose = openMVG::geometry::Pose3(
-        rotation_matrix, -rotation_matrix.transpose() * translation_vector);
-
+    auto pose = convert_projection_matrix_to_pose(projection_matrix);
     out_pose_transform = convert_pose_to_maya_transform_matrix(pose);
 
     return true;
 }
 
+void compute_camera_poses_from_known_points(
+    const std::vector<KnownPointsFrame> &frames, const openMVG::Mat &points_2d,
+    const openMVG::Mat &points_3d, const size_t thread_count,
+    std::vector<KnownPointsFrameResult> &out_results) {
+    out_results.clear();
+    out_results.resize(frames.size());
+
+    const size_t num_max_iter = 1024;
+    const size_t frame_count = frames.size();
+
+    // Threads are used for the frames, unless there is only one.
+    const size_t ransac_thread_count = (frame_count <= 1) ? thread_count : 1;
+    auto solve_frame = [&](const size_t index) {
+        const KnownPointsFrame &frame = frames[index];
+        KnownPointsFrameResult &result = out_results[index];
+        result.ok = false;
+
+        // Each frame's points are copied out of the shared matrices,
+        // because the AC-RANSAC kernel expects dense matrices.
+        const openMVG::Mat frame_points_2d =
+            points_2d.middleCols(frame.start_column, frame.column_count);
+        const openMVG::Mat frame_points_3d =
+            points_3d.middleCols(frame.start_column, frame.column_count);
+        const std::pair<size_t, size_t> image_size(
+            static_cast<size_t>(frame.image_width),
+            static_cast<size_t>(frame.image_height));
+
+        openMVG::Mat34 projection_matrix;
+        double min_nfa = 0.0;
+        result.ok = estimate_camera_pose_from_known_points(
+            frame_points_2d, frame_points_3d, image_size,
+            frame.focal_length_pix, frame.ppx_pix, frame.ppy_pix, num_max_iter,
+            ransac_thread_count, projection_matrix, result.error_max, min_nfa,
+            result.inlier_count);
+        if (result.ok) {
+            result.pose = convert_projection_matrix_to_pose(projection_matrix);
+        }
+    };
+
+    const size_t min_chunk_size = 1;
+    mmthread::parallelForChunks(
+        frame_count, std::max<size_t>(thread_count, 1), min_chunk_size,
+        [&solve_frame](const size_t start, const size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                solve_frame(i);
+            }
+        });
+}
+
 }  // namespace sfm
 }  // namespace mmsolver
@@ -40,11 +40,14 @@
 
 // STL
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 // OpenMVG
 #ifdef MMSOLVER_USE_OPENMVG
 
+#include <openMVG/geometry/pose3.hpp>
 #include <openMVG/numeric/numeric.h>
 
 #include <openMVG/numeric/eigen_alias_definition.hpp>
@@ -75,11 +78,14 @@
 namespace mmsolver {
 namespace sfm {
 
+// Robustly estimate the camera pose with AC-RANSAC, run on
+// 'thread_count' threads; see 'parallel_ac_ransac'.
 bool robust_camera_pose_from_known_points(
     const openMVG::Mat &points_2d, const openMVG::Mat &points_3d,
     const std::pair<size_t, size_t> &image_size, const double focal_length_pix,
     const double ppx_pix, const double ppy_pix,
-    const size_t max_iteration_count, openMVG::Mat34 &out_projection_matrix);
+    const size_t max_iteration_count, const size_t thread_count,
+    openMVG::Mat34 &out_projection_matrix);
 
 bool compute_camera_pose_from_known_points(
     const int32_t image_width, const int32_t image_height,
@@ -88,6 +94,54 @@ bool compute_camera_pose_from_known_points(
     const std::vector<std::tuple<double, double, double>> &bundle_coords,
     MTransformationMatrix &out_pose_transform);
 
+// The camera of one frame to be resectioned, and the columns of the
+// 2D/3D points matrices that hold the frame's points.
+struct KnownPointsFrame {
+    int32_t image_width;
+    int32_t image_height;
+    double focal_length_pix;
+    double ppx_pix;
+    double ppy_pix;
+    size_t start_column;
+    size_t column_count;
+
+    KnownPointsFrame()
+        : image_width(2)
+        , image_height(2)
+        , focal_length_pix(0.0)
+        , ppx_pix(0.0)
+        , ppy_pix(0.0)
+        , start_column(0)
+        , column_count(0) {}
+};
+
+struct KnownPointsFrameResult {
+    bool ok;
+    openMVG::geometry::Pose3 pose;
+    double error_max;
+    size_t inlier_count;
+
+    KnownPointsFrameResult()
+        : ok(false), pose(), error_max(0.0), inlier_count(0) {}
+};
+
+// Compute the camera pose of many frames at once, with each frame
+// solved independently on a pool of 'thread_count' threads. When only
+// one frame is given, the threads are used by AC-RANSAC instead.
+//
+// The points of all frames are stored in 'points_2d' (2 x N) and
+// 'points_3d' (3 x N, with the Z-coordinate flipped to match
+// OpenMVG); see 'KnownPointsFrame'. 'out_results' has one result per
+// frame, in the same order as 'frames'. No Maya API functions are
+// called, and nothing is printed.
+//
+// Results do not depend on the thread count; each frame is solved
+// with its own (fixed seed) random number generators.
+void compute_camera_poses_from_known_points(
+    const std::vector<KnownPointsFrame> &frames, const openMVG::Mat &points_2d,
+    const openMVG::Mat &points_3d, const size_t thread_count,
+    std::vector<KnownPointsFrameResult> &out_results);
+
 }  // namespace sfm
 }  // namespace mmsolver
 
@@ -84,9 +84,11 @@
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
+#include "mmSolver/sfm/parallel_ac_ransac.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 namespace mmsolver {
 namespace sfm {
@@ -97,7 +99,8 @@ bool robust_relative_pose(const openMVG::cameras::IntrinsicBase *intrinsics1,
                           openMVG::sfm::RelativePose_Info &relativePose_info,
                           const std::pair<size_t, size_t> &size_ima1,
                           const std::pair<size_t, size_t> &size_ima2,
-                          const size_t max_iteration_count) {
+                          const size_t max_iteration_count,
+                          const size_t thread_count) {
     // Enable to print out 'MMSOLVER_MAYA_VRB' results.
     const bool verbose = false;
 
@@ -134,6 +137,11 @@ bool robust_relative_pose(const openMVG::cameras::IntrinsicBase *intrinsics1,
     relativePose_info.initial_residual_tolerance =
         std::numeric_limits<double>::infinity();
 
+    ParallelACRansacOptions ac_ransac_options;
+    ac_ransac_options.max_iteration_count = max_iteration_count;
+    ac_ransac_options.precision = relativePose_info.initial_residual_tolerance;
+    ac_ransac_options.thread_count = thread_count;
+
     if (more_than_eight) {
         // Define the AContrario adaptor to use the 8 point essential matrix
         // solver.
@@ -146,11 +154,11 @@ bool robust_relative_pose(const openMVG::cameras::IntrinsicBase *intrinsics1,
 
         // Robustly estimate the Essential matrix with A Contrario
         // (AC) RANSAC
-        MMSOLVER_MAYA_VRB("robust_relative_pose: openMVG::robust::ACRANSAC()");
-        const auto ac_ransac_output = openMVG::robust::ACRANSAC(
-            kernel, relativePose_info.vec_inliers, max_iteration_count,
-            &relativePose_info.essential_matrix,
-            relativePose_info.initial_residual_tolerance, verbose);
+        MMSOLVER_MAYA_VRB("robust_relative_pose: parallel_ac_ransac()");
+        const auto ac_ransac_output =
+            parallel_ac_ransac(kernel, relativePose_info.vec_inliers,
+                               ac_ransac_options,
+                               &relativePose_info.essential_matrix);
 
         const double &threshold = ac_ransac_output.first;
         relativePose_info.found_residual_precision =
@@ -186,10 +194,10 @@ bool robust_relative_pose(const openMVG::cameras::IntrinsicBase *intrinsics1,
                 ->K());
 
         // Robust estimation of the Model and it's precision.
-        const auto ac_ransac_output = openMVG::robust::ACRANSAC(
-            kernel, relativePose_info.vec_inliers, max_iteration_count,
-            &relativePose_info.essential_matrix,
-            relativePose_info.initial_residual_tolerance, verbose);
+        const auto ac_ransac_output =
+            parallel_ac_ransac(kernel, relativePose_info.vec_inliers,
+                               ac_ransac_options,
+                               &relativePose_info.essential_matrix);
 
         relativePose_info.found_residual_precision = ac_ransac_output.first;
 
@@ -251,7 +259,8 @@ bool compute_relative_pose(
     auto num_max_iter = 4096;
     bool robust_pose_ok = robust_relative_pose(
         &cam_a, &cam_b, marker_coords_matrix_a, marker_coords_matrix_b,
-        pose_info, image_size_a, image_size_b, num_max_iter);
+        pose_info, image_size_a, image_size_b, num_max_iter,
+        mmthread::defaultThreadCount());
     if (!robust_pose_ok) {
         MMSOLVER_MAYA_ERR("Robust relative pose estimation failure.");
         return false;
@@ -63,13 +63,16 @@
 namespace mmsolver {
 namespace sfm {
 
+// Robustly estimate the relative pose with AC-RANSAC, run on
+// 'thread_count' threads; see 'parallel_ac_ransac'.
 bool robust_relative_pose(const openMVG::cameras::IntrinsicBase *intrinsics1,
                           const openMVG::cameras::IntrinsicBase *intrinsics2,
                           const openMVG::Mat &x1, const openMVG::Mat &x2,
                           openMVG::sfm::RelativePose_Info &relativePose_info,
                           const std::pair<size_t, size_t> &size_ima1,
                           const std::pair<size_t, size_t> &size_ima2,
-                          const size_t max_iteration_count);
+                          const size_t max_iteration_count,
+                          const size_t thread_count);
 
 bool compute_relative_pose(
     const int32_t image_width_a, const int32_t image_width_b,
@@ -0,0 +1,590 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Incremental camera solve of a single camera.
+ */
+
+#include "camera_solve.h"
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <ceres/ceres.h>
+#include <openMVG/cameras/Camera_Intrinsics.hpp>
+#include <openMVG/cameras/Camera_Pinhole.hpp>
+#include <openMVG/multiview/triangulation.hpp>
+#include <openMVG/numeric/numeric.h>
+#include <openMVG/sfm/pipelines/sfm_robust_model_estimation.hpp>
+#include <openMVG/sfm/sfm_data.hpp>
+#include <openMVG/sfm/sfm_data_BA.hpp>
+#include <openMVG/sfm/sfm_data_BA_ceres.hpp>
+#include <openMVG/sfm/sfm_landmark.hpp>
+#include <openMVG/sfm/sfm_view.hpp>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/sfm/camera_from_known_points.h"
+#include "mmSolver/sfm/camera_relative_pose.h"
+#include "mmSolver/sfm/frame_pair_search.h"
+#include "mmSolver/sfm/sfm_utils.h"
+
+namespace mmsolver {
+namespace sfm {
+
+namespace {
+
+// 'robust_relative_pose' needs more than 5 points.
+const size_t kMinimumOverlapCount = 6;
+
+const size_t kRelativePoseMaxIterationCount = 4096;
+
+// The weight of the (fixed) bundles outside of the local bundle
+// adjustment window, compared to the bundles being adjusted.
+const double kFixedBundleWeight = 1.0;
+
+// Bundle adjustments of more frames use an iterative linear solver.
+const size_t kDenseSolverMaximumFrameCount = 100;
+
+// In the scene the view, intrinsic and pose ids are all the frame
+// index, and the landmark id is the marker index.
+void add_frame_to_scene(const MarkerTracks &tracks, const size_t frame_index,
+                        const openMVG::geometry::Pose3 &pose,
+                        openMVG::sfm::SfM_Data &scene) {
+    const MarkerTrackFrame &frame = tracks.frames[frame_index];
+    const auto id = static_cast<openMVG::IndexT>(frame_index);
+    scene.views[id].reset(new openMVG::sfm::View(
+        /*imgPath=*/"",
+        /*view_id=*/id,
+        /*intrinsic_id=*/id,
+        /*pose_id=*/id, static_cast<size_t>(frame.image_width),
+        static_cast<size_t>(frame.image_height)));
+    scene.intrinsics[id].reset(new openMVG::cameras::Pinhole_Intrinsic(
+        frame.image_width, frame.image_height, frame.focal_length_pix,
+        frame.ppx_pix, frame.ppy_pix));
+    scene.poses[id] = pose;
+}
+
+openMVG::Vec2 marker_coord(const MarkerTracks &tracks,
+                           const size_t frame_index,
+                           const size_t marker_index) {
+    const size_t index = tracks.index(frame_index, marker_index);
+    return openMVG::Vec2(tracks.coords[(index * 2) + 0],
+                         tracks.coords[(index * 2) + 1]);
+}
+
+// Is the point in front of the camera, and does it reproject within
+// 'max_error_pix' pixels of the marker?
+bool is_good_observation(const openMVG::sfm::SfM_Data &scene,
+                         const size_t frame_index, const openMVG::Vec3 &point,
+                         const openMVG::Vec2 &coord,
+                         const double max_error_pix) {
+    const auto id = static_cast<openMVG::IndexT>(frame_index);
+    const openMVG::geometry::Pose3 &pose = scene.poses.at(id);
+    const openMVG::Vec3 point_camera = pose(point);
+    if (point_camera(2) <= 0.0) {
+        return false;
+    }
+    const auto &intrinsic = scene.intrinsics.at(id);
+    const openMVG::Vec2 residual = intrinsic->residual(point_camera, coord);
+    return residual.norm() <= max_error_pix;
+}
+
+// Solve the relative pose of the initial frame pair, and triangulate
+// the markers seen by both frames.
+bool solve_initial_frame_pair(const MarkerTracks &tracks,
+                              const CameraSolveOptions &options,
+                              const size_t index_a, const size_t index_b,
+                              openMVG::sfm::SfM_Data &scene) {
+    std::vector<size_t> marker_indices;
+    std::vector<std::pair<double, double>> marker_coords_a;
+    std::vector<std::pair<double, double>> marker_coords_b;
+    for (size_t i = 0; i < tracks.marker_count; ++i) {
+        if (!tracks.valid[tracks.index(index_a, i)] ||
+            !tracks.valid[tracks.index(index_b, i)]) {
+            continue;
+        }
+        const openMVG::Vec2 coord_a = marker_coord(tracks, index_a, i);
+        const openMVG::Vec2 coord_b = marker_coord(tracks, index_b, i);
+        marker_indices.push_back(i);
+        marker_coords_a.push_back({coord_a(0), coord_a(1)});
+        marker_coords_b.push_back({coord_b(0), coord_b(1)});
+    }
+    if (marker_indices.size() < kMinimumOverlapCount) {
+        return false;
+    }
+
+    const MarkerTrackFrame &frame_a = tracks.frames[index_a];
+    const MarkerTrackFrame &frame_b = tracks.frames[index_b];
+    const openMVG::cameras::Pinhole_Intrinsic camera_a(
+        frame_a.image_width, frame_a.image_height, frame_a.focal_length_pix,
+        frame_a.ppx_pix, frame_a.ppy_pix);
+    const openMVG::cameras::Pinhole_Intrinsic camera_b(
+        frame_b.image_width, frame_b.image_height, frame_b.focal_length_pix,
+        frame_b.ppx_pix, frame_b.ppy_pix);
+    const std::pair<size_t, size_t> image_size_a(
+        static_cast<size_t>(frame_a.image_width),
+        static_cast<size_t>(frame_a.image_height));
+    const std::pair<size_t, size_t> image_size_b(
+        static_cast<size_t>(frame_b.image_width),
+        static_cast<size_t>(frame_b.image_height));
+
+    const openMVG::Mat points_a =
+        convert_marker_coords_to_matrix(marker_coords_a);
+    const openMVG::Mat points_b =
+        convert_marker_coords_to_matrix(marker_coords_b);
+    openMVG::sfm::RelativePose_Info pose_info;
+    const bool pose_ok = robust_relative_pose(
+        &camera_a, &camera_b, points_a, points_b, pose_info, image_size_a,
+        image_size_b, kRelativePoseMaxIterationCount, options.thread_count);
+    if (!pose_ok || !is_valid_pose(pose_info.relativePose)) {
+        return false;
+    }
+
+    // The marker and bundle lists are only used for verbose printing,
+    // which is disabled.
+    openMVG::sfm::SfM_Data pair_scene;
+    construct_two_camera_sfm_data_scene(
+        frame_a.image_width, frame_b.image_width, frame_a.image_height,
+        frame_b.image_height, frame_a.focal_length_pix,
+        frame_b.focal_length_pix, frame_a.ppx_pix, frame_b.ppx_pix,
+        frame_a.ppy_pix, frame_b.ppy_pix, pose_info, pair_scene);
+    MarkerPtrList marker_list_a;
+    MarkerPtrList marker_list_b;
+    BundlePtrList bundle_list;
+    const bool triangulate_ok = triangulate_relative_pose(
+        marker_coords_a, marker_coords_b, pose_info.vec_inliers, marker_list_a,
+        marker_list_b, bundle_list, pair_scene);
+    if (!triangulate_ok) {
+        return false;
+    }
+
+    add_frame_to_scene(tracks, index_a, pair_scene.poses.at(0), scene);
+    add_frame_to_scene(tracks, index_b, pair_scene.poses.at(1), scene);
+    const auto id_a = static_cast<openMVG::IndexT>(index_a);
+    const auto id_b = static_cast<openMVG::IndexT>(index_b);
+    for (const auto &landmark_it : pair_scene.structure) {
+        const size_t marker_index = marker_indices[landmark_it.first];
+        const openMVG::Vec3 &point = landmark_it.second.X;
+        const openMVG::Vec2 coord_a =
+            marker_coord(tracks, index_a, marker_index);
+        const openMVG::Vec2 coord_b =
+            marker_coord(tracks, index_b, marker_index);
+        if (!is_good_observation(scene, index_a, point, coord_a,
+                                 options.max_reprojection_error_pix) ||
+            !is_good_observation(scene, index_b, point, coord_b,
+                                 options.max_reprojection_error_pix)) {
+            continue;
+        }
+
+        const auto id = static_cast<openMVG::IndexT>(marker_index);
+        openMVG::sfm::Landmark landmark;
+        landmark.X = point;
+        landmark.obs[id_a] = openMVG::sfm::Observation(coord_a, id);
+        landmark.obs[id_b] = openMVG::sfm::Observation(coord_b, id);
+        scene.structure.insert({id, landmark});
+    }
+    return scene.structure.size() >= options.min_resection_point_count;
+}
+
+// Solve the camera pose of a frame from the (already triangulated)
+// bundles of the markers on the frame, and add the frame's markers as
+// observations of those bundles.
+bool resect_frame(const MarkerTracks &tracks,
+                  const CameraSolveOptions &options, const size_t frame_index,
+                  openMVG::sfm::SfM_Data &scene) {
+    std::vector<size_t> marker_indices;
+    for (size_t i = 0; i < tracks.marker_count; ++i) {
+        const auto id = static_cast<openMVG::IndexT>(i);
+        if (tracks.valid[tracks.index(frame_index, i)] &&
+            scene.structure.count(id) > 0) {
+            marker_indices.push_back(i);
+        }
+    }
+    const size_t point_count = marker_indices.size();
+    if (point_count < options.min_resection_point_count) {
+        return false;
+    }
+
+    openMVG::Mat points_2d(2, point_count);
+    openMVG::Mat points_3d(3, point_count);
+    for (size_t i = 0; i < point_count; ++i) {
+        const size_t marker_index = marker_indices[i];
+        const auto id = static_cast<openMVG::IndexT>(marker_index);
+        points_2d.col(i) = marker_coord(tracks, frame_index, marker_index);
+        points_3d.col(i) = scene.structure.at(id).X;
+    }
+
+    const MarkerTrackFrame &track_frame = tracks.frames[frame_index];
+    std::vector<KnownPointsFrame> frames(1);
+    frames[0].image_width = track_frame.image_width;
+    frames[0].image_height = track_frame.image_height;
+    frames[0].focal_length_pix = track_frame.focal_length_pix;
+    frames[0].ppx_pix = track_frame.ppx_pix;
+    frames[0].ppy_pix = track_frame.ppy_pix;
+    frames[0].start_column = 0;
+    frames[0].column_count = point_count;
+
+    // A single frame is solved, so the threads are used by AC-RANSAC.
+    std::vector<KnownPointsFrameResult> results;
+    compute_camera_poses_from_known_points(frames, points_2d, points_3d,
+                                           options.thread_count, results);
+    if (results.empty() || !results[0].ok ||
+        !is_valid_pose(results[0].pose)) {
+        return false;
+    }
+
+    add_frame_to_scene(tracks, frame_index, results[0].pose, scene);
+    const auto id_view = static_cast<openMVG::IndexT>(frame_index);
+    for (size_t i = 0; i < point_count; ++i) {
+        const size_t marker_index = marker_indices[i];
+        const auto id = static_cast<openMVG::IndexT>(marker_index);
+        openMVG::sfm::Landmark &landmark = scene.structure.at(id);
+        const openMVG::Vec2 coord = points_2d.col(i);
+        if (is_good_observation(scene, frame_index, landmark.X, coord,
+                                options.max_reprojection_error_pix)) {
+            landmark.obs[id_view] = openMVG::sfm::Observation(coord, id);
+        }
+    }
+    return true;
+}
+
+// Triangulate the markers of a newly solved frame that do not have a
+// bundle yet, using the solved frame (seen by the marker) with the
+// largest angle between the rays.
+//
+// 'pending_frames' holds, per marker, the solved frames that see the
+// marker before it has a bundle.
+size_t triangulate_new_bundles(
+    const MarkerTracks &tracks, const CameraSolveOptions &options,
+    const size_t frame_index,
+    std::vector<std::vector<uint32_t>> &pending_frames,
+    openMVG::sfm::SfM_Data &scene) {
+    const auto id_view = static_cast<openMVG::IndexT>(frame_index);
+    const openMVG::geometry::Pose3 &pose = scene.poses.at(id_view);
+    const openMVG::cameras::IntrinsicBase *intrinsic =
+        scene.intrinsics.at(id_view).get();
+
+    size_t count = 0;
+    for (size_t i = 0; i < tracks.marker_count; ++i) {
+        const auto id = static_cast<openMVG::IndexT>(i);
+        if (!tracks.valid[tracks.index(frame_index, i)] ||
+            scene.structure.count(id) > 0) {
+            continue;
+        }
+
+        const openMVG::Vec2 coord = marker_coord(tracks, frame_index, i);
+        std::vector<uint32_t> &frames = pending_frames[i];
+        double best_angle = 0.0;
+        size_t best_frame_index = frame_index;
+        for (const uint32_t other_frame_index : frames) {
+            const auto other_id =
+                static_cast<openMVG::IndexT>(other_frame_index);
+            const double angle = openMVG::cameras::AngleBetweenRay(
+                pose, intrinsic, scene.poses.at(other_id),
+                scene.intrinsics.at(other_id).get(), coord,
+                marker_coord(tracks, other_frame_index, i));
+            if (angle > best_angle) {
+                best_angle = angle;
+                best_frame_index = other_frame_index;
+            }
+        }
+        if (best_angle < options.min_triangulation_angle_deg) {
+            frames.push_back(static_cast<uint32_t>(frame_index));
+            continue;
+        }
+
+        const auto best_id = static_cast<openMVG::IndexT>(best_frame_index);
+        const openMVG::geometry::Pose3 &best_pose = scene.poses.at(best_id);
+        const openMVG::Vec2 best_coord =
+            marker_coord(tracks, best_frame_index, i);
+        openMVG::Vec3 point;
+        const bool triangulate_ok = openMVG::Triangulate2View(
+            pose.rotation(), pose.translation(), (*intrinsic)(coord),
+            best_pose.rotation(), best_pose.translation(),
+            (*scene.intrinsics.at(best_id))(best_coord), point,
+            openMVG::ETriangulationMethod::DEFAULT);
+        if (!triangulate_ok ||
+            !is_good_observation(scene, frame_index, point, coord,
+                                 options.max_reprojection_error_pix) ||
+            !is_good_observation(scene, best_frame_index, point, best_coord,
+                                 options.max_reprojection_error_pix)) {
+            frames.push_back(static_cast<uint32_t>(frame_index));
+            continue;
+        }
+
+        openMVG::sfm::Landmark landmark;
+        landmark.X = point;
+        landmark.obs[id_view] = openMVG::sfm::Observation(coord, id);
+        for (const uint32_t other_frame_index : frames) {
+            const openMVG::Vec2 other_coord =
+                marker_coord(tracks, other_frame_index, i);
+            if (is_good_observation(scene, other_frame_index, point,
+                                    other_coord,
+                                    options.max_reprojection_error_pix)) {
+                const auto other_id =
+                    static_cast<openMVG::IndexT>(other_frame_index);
+                landmark.obs[other_id] =
+                    openMVG::sfm::Observation(other_coord, id);
+            }
+        }
+        scene.structure.insert({id, landmark});
+        frames.clear();
+        frames.shrink_to_fit();
+        ++count;
+    }
+    return count;
+}
+
+// Bundle adjust the last 'window_size' solved frames (or all frames
+// when 'window_size' is zero).
+//
+// Bundles that are also seen by frames outside of the window are
+// held fixed, so the frames that were solved earlier anchor the
+// adjusted frames.
+bool bundle_adjust_window(const std::vector<uint32_t> &solve_order,
+                          const size_t window_size,
+                          const size_t thread_count,
+                          openMVG::sfm::SfM_Data &scene) {
+    size_t start = 0;
+    if ((window_size > 0) && (solve_order.size() > window_size)) {
+        start = solve_order.size() - window_size;
+    }
+    std::set<openMVG::IndexT> window_ids;
+    openMVG::sfm::SfM_Data window_scene;
+    for (size_t i = start; i < solve_order.size(); ++i) {
+        const auto id = static_cast<openMVG::IndexT>(solve_order[i]);
+        window_ids.insert(id);
+        window_scene.views[id] = scene.views.at(id);
+        window_scene.intrinsics[id] = scene.intrinsics.at(id);
+        window_scene.poses[id] = scene.poses.at(id);
+    }
+
+    for (const auto &landmark_it : scene.structure) {
+        const openMVG::sfm::Landmark &landmark = landmark_it.second;
+        openMVG::sfm::Landmark window_landmark;
+        window_landmark.X = landmark.X;
+        bool outside_window = false;
+        for (const auto &obs_it : landmark.obs) {
+            if (window_ids.count(obs_it.first) > 0) {
+                window_landmark.obs.insert(obs_it);
+            } else {
+                outside_window = true;
+            }
+        }
+        if (window_landmark.obs.empty()) {
+            continue;
+        }
+        if (outside_window || (window_landmark.obs.size() < 2)) {
+            window_scene.control_points.insert(
+                {landmark_it.first, window_landmark});
+        } else {
+            window_scene.structure.insert({landmark_it.first, window_landmark});
+        }
+    }
+    if (window_scene.structure.empty()) {
+        return false;
+    }
+
+    auto optimize_options = openMVG::sfm::Optimize_Options(
+        openMVG::cameras::Intrinsic_Parameter_Type::NONE,
+        openMVG::sfm::Extrinsic_Parameter_Type::ADJUST_ALL,
+        openMVG::sfm::Structure_Parameter_Type::ADJUST_ALL,
+        openMVG::sfm::Control_Point_Parameter(kFixedBundleWeight,
+                                              /*use_control_points=*/true));
+
+    const bool bundle_adjust_verbose = false;
+    const bool bundle_adjust_multithreaded = thread_count != 1;
+    auto ceres_options =
+        openMVG::sfm::Bundle_Adjustment_Ceres::BA_Ceres_options(
+            bundle_adjust_verbose, bundle_adjust_multithreaded);
+    if (thread_count > 1) {
+        ceres_options.nb_threads_ = static_cast<unsigned int>(thread_count);
+    }
+    ceres_options.bCeres_summary_ = false;
+    ceres_options.bUse_loss_function_ = false;
+    // The bundles are eliminated (Schur complement), leaving a
+    // system the size of the number of frames, which is too large to
+    // solve densely for long frame ranges.
+    if (window_scene.poses.size() <= kDenseSolverMaximumFrameCount) {
+        ceres_options.linear_solver_type_ =
+            static_cast<int>(ceres::DENSE_SCHUR);
+        ceres_options.preconditioner_type_ = static_cast<int>(ceres::JACOBI);
+    } else {
+        ceres_options.linear_solver_type_ =
+            static_cast<int>(ceres::ITERATIVE_SCHUR);
+        ceres_options.preconditioner_type_ =
+            static_cast<int>(ceres::SCHUR_JACOBI);
+    }
+    ceres_options.sparse_linear_algebra_library_type_ =
+        static_cast<int>(ceres::NO_SPARSE);
+
+    openMVG::sfm::Bundle_Adjustment_Ceres bundle_adjustment(ceres_options);
+    if (!bundle_adjustment.Adjust(window_scene, optimize_options)) {
+        return false;
+    }
+
+    for (const auto &pose_it : window_scene.poses) {
+        scene.poses[pose_it.first] = pose_it.second;
+    }
+    for (const auto &landmark_it : window_scene.structure) {
+        scene.structure.at(landmark_it.first).X = landmark_it.second.X;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool solve_camera_incremental(const MarkerTracks &tracks,
+                              const CameraSolveOptions &options,
+                              CameraSolveResult &out_result) {
+    const size_t frame_count = tracks.frames.size();
+    const size_t marker_count = tracks.marker_count;
+    out_result = CameraSolveResult();
+    out_result.frame_solved.assign(frame_count, 0);
+    out_result.poses.resize(frame_count);
+    out_result.bundle_solved.assign(marker_count, 0);
+    out_result.bundle_positions.assign(marker_count, openMVG::Vec3::Zero());
+    if (frame_count < 2) {
+        return false;
+    }
+
+    // The initial frame pair, as frame indices.
+    const uint32_t first_frame = tracks.frames[0].frame;
+    size_t index_a = 0;
+    size_t index_b = 0;
+    if (options.find_initial_frames) {
+        FramePairSearchOptions pair_options = options.frame_pair_options;
+        pair_options.thread_count = options.thread_count;
+        std::vector<FramePairScore> pairs;
+        find_best_frame_pairs(tracks, pair_options, pairs);
+        if (pairs.empty()) {
+            return false;
+        }
+        index_a = pairs[0].frame_a - first_frame;
+        index_b = pairs[0].frame_b - first_frame;
+    } else {
+        if ((options.initial_frame_a < first_frame) ||
+            (options.initial_frame_b < first_frame)) {
+            return false;
+        }
+        index_a = options.initial_frame_a - first_frame;
+        index_b = options.initial_frame_b - first_frame;
+    }
+    if (index_a > index_b) {
+        std::swap(index_a, index_b);
+    }
+    if ((index_a == index_b) || (index_b >= frame_count)) {
+        return false;
+    }
+    out_result.frame_a = tracks.frames[index_a].frame;
+    out_result.frame_b = tracks.frames[index_b].frame;
+
+    openMVG::sfm::SfM_Data scene;
+    if (!solve_initial_frame_pair(tracks, options, index_a, index_b, scene)) {
+        return false;
+    }
+
+    std::vector<uint32_t> solve_order;
+    solve_order.push_back(static_cast<uint32_t>(index_a));
+    solve_order.push_back(static_cast<uint32_t>(index_b));
+
+    std::vector<std::vector<uint32_t>> pending_frames(marker_count);
+    for (size_t i = 0; i < marker_count; ++i) {
+        const auto id = static_cast<openMVG::IndexT>(i);
+        if (scene.structure.count(id) > 0) {
+            continue;
+        }
+        for (const size_t frame_index : {index_a, index_b}) {
+            if (tracks.valid[tracks.index(frame_index, i)]) {
+                pending_frames[i].push_back(
+                    static_cast<uint32_t>(frame_index));
+            }
+        }
+    }
+
+    // Solve the frames between the initial frames first (where the
+    // bundles are best known), then outwards to the end and the start
+    // of the frame range, so each frame is next to a solved frame.
+    std::vector<size_t> frame_order;
+    for (size_t i = index_a + 1; i < index_b; ++i) {
+        frame_order.push_back(i);
+    }
+    for (size_t i = index_b + 1; i < frame_count; ++i) {
+        frame_order.push_back(i);
+    }
+    for (size_t i = index_a; i > 0; --i) {
+        frame_order.push_back(i - 1);
+    }
+
+    size_t solved_since_bundle_adjust = 0;
+    for (const size_t frame_index : frame_order) {
+        if (!resect_frame(tracks, options, frame_index, scene)) {
+            continue;
+        }
+        solve_order.push_back(static_cast<uint32_t>(frame_index));
+        triangulate_new_bundles(tracks, options, frame_index, pending_frames,
+                                scene);
+
+        ++solved_since_bundle_adjust;
+        if ((options.bundle_adjust_interval > 0) &&
+            (solved_since_bundle_adjust >= options.bundle_adjust_interval)) {
+            if (bundle_adjust_window(solve_order, options.bundle_adjust_window,
+                                     options.thread_count, scene)) {
+                ++out_result.bundle_adjust_count;
+            }
+            solved_since_bundle_adjust = 0;
+        }
+    }
+
+    // A final adjustment of all frames together.
+    if (options.bundle_adjust_interval > 0) {
+        const size_t all_frames = 0;
+        if (bundle_adjust_window(solve_order, all_frames, options.thread_count,
+                                 scene)) {
+            ++out_result.bundle_adjust_count;
+        }
+    }
+
+    for (const uint32_t frame_index : solve_order) {
+        const auto id = static_cast<openMVG::IndexT>(frame_index);
+        out_result.frame_solved[frame_index] = 1;
+        out_result.poses[frame_index] = scene.poses.at(id);
+    }
+    out_result.solved_frame_count = solve_order.size();
+    for (const auto &landmark_it : scene.structure) {
+        const size_t marker_index = landmark_it.first;
+        out_result.bundle_solved[marker_index] = 1;
+        out_result.bundle_positions[marker_index] = landmark_it.second.X;
+    }
+    out_result.solved_bundle_count = scene.structure.size();
+    return true;
+}
+
+}  // namespace sfm
+}  // namespace mmsolver
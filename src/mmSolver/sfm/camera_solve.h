@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Incremental camera solve (structure from motion) of a single
+ * camera, using marker tracks gathered from Maya.
+ *
+ * The solve starts from the relative pose of an initial frame pair,
+ * triangulates the bundles seen by both frames, then solves (resects)
+ * the other frames one at a time from the known bundles, triangulating
+ * new bundles as they are seen by more frames. A local bundle
+ * adjustment of the most recently solved frames is run periodically
+ * to stop errors from accumulating.
+ */
+
+#ifndef MM_SOLVER_SFM_CAMERA_SOLVE_H
+#define MM_SOLVER_SFM_CAMERA_SOLVE_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <openMVG/geometry/pose3.hpp>
+#include <openMVG/numeric/eigen_alias_definition.hpp>
+#include <openMVG/numeric/numeric.h>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/sfm/frame_pair_search.h"
+#include "mmSolver/sfm/marker_tracks.h"
+
+namespace mmsolver {
+namespace sfm {
+
+struct CameraSolveOptions {
+    // When true the initial frame pair is found with
+    // 'find_best_frame_pairs', otherwise 'initial_frame_a' and
+    // 'initial_frame_b' are used.
+    bool find_initial_frames;
+    uint32_t initial_frame_a;
+    uint32_t initial_frame_b;
+    FramePairSearchOptions frame_pair_options;
+
+    // Frames with fewer known bundles are not solved.
+    size_t min_resection_point_count;
+
+    // Bundles (and marker observations) with a larger reprojection
+    // error, in pixels, are not used.
+    double max_reprojection_error_pix;
+
+    // New bundles are only triangulated when the rays of the two
+    // frames are at least this angle (degrees) apart.
+    double min_triangulation_angle_deg;
+
+    // Run a local bundle adjustment each time this number of frames
+    // are solved. Zero disables bundle adjustment.
+    size_t bundle_adjust_interval;
+
+    // The number of most recently solved frames that are adjusted by
+    // the local bundle adjustment.
+    size_t bundle_adjust_window;
+
+    size_t thread_count;
+
+    CameraSolveOptions()
+        : find_initial_frames(true)
+        , initial_frame_a(0)
+        , initial_frame_b(0)
+        , frame_pair_options()
+        , min_resection_point_count(6)
+        , max_reprojection_error_pix(4.0)
+        , min_triangulation_angle_deg(2.0)
+        , bundle_adjust_interval(10)
+        , bundle_adjust_window(30)
+        , thread_count(1) {}
+};
+
+struct CameraSolveResult {
+    // The initial frame pair used.
+    uint32_t frame_a;
+    uint32_t frame_b;
+
+    // One value per frame of the marker tracks. The pose is the
+    // OpenMVG camera pose, valid only when the frame is solved.
+    std::vector<uint8_t> frame_solved;
+    std::vector<openMVG::geometry::Pose3> poses;
+
+    // One value per marker of the marker tracks. The position is in
+    // OpenMVG coordinates (Z flipped compared to Maya), valid only
+    // when the bundle is solved.
+    std::vector<uint8_t> bundle_solved;
+    std::vector<openMVG::Vec3> bundle_positions;
+
+    size_t solved_frame_count;
+    size_t solved_bundle_count;
+    size_t bundle_adjust_count;
+
+    CameraSolveResult()
+        : frame_a(0)
+        , frame_b(0)
+        , frame_solved()
+        , poses()
+        , bundle_solved()
+        , bundle_positions()
+        , solved_frame_count(0)
+        , solved_bundle_count(0)
+        , bundle_adjust_count(0) {}
+};
+
+// Solve the camera poses and bundle positions of 'tracks'.
+//
+// No Maya API functions are called, and nothing is printed. Returns
+// false if the initial frame pair could not be solved.
+bool solve_camera_incremental(const MarkerTracks &tracks,
+                              const CameraSolveOptions &options,
+                              CameraSolveResult &out_result);
+
+}  // namespace sfm
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_SFM_CAMERA_SOLVE_H
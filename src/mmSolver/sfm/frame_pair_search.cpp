@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Search a frame range for the best frame pairs to initialise a
+ * camera solve.
+ */
+
+#include "frame_pair_search.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <openMVG/cameras/Camera_Pinhole.hpp>
+#include <openMVG/numeric/numeric.h>
+#include <openMVG/sfm/pipelines/sfm_robust_model_estimation.hpp>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/sfm/camera_relative_pose.h"
+#include "mmSolver/sfm/homography.h"
+#include "mmSolver/utilities/thread_pool.h"
+
+namespace mmsolver {
+namespace sfm {
+
+namespace {
+
+// 'robust_relative_pose' needs more than 5 points.
+const size_t kMinimumOverlapCount = 6;
+
+// Parallax larger than this fraction of the image width is not
+// considered to be any better.
+const double kParallaxImageWidthFraction = 0.1;
+
+// The frame pairs are scored in parallel, so each AC-RANSAC
+// estimation uses a single thread.
+const size_t kRansacThreadCount = 1;
+
+struct FramePairCandidate {
+    size_t index_a;
+    size_t index_b;
+    size_t overlap_count;
+    double median_parallax_pix;
+    double overlap_score;
+};
+
+bool compare_candidates(const FramePairCandidate &a,
+                        const FramePairCandidate &b) {
+    if (a.overlap_score != b.overlap_score) {
+        return a.overlap_score > b.overlap_score;
+    }
+    if (a.index_a != b.index_a) {
+        return a.index_a < b.index_a;
+    }
+    return a.index_b < b.index_b;
+}
+
+bool compare_scores(const FramePairScore &a, const FramePairScore &b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    if (a.frame_a != b.frame_a) {
+        return a.frame_a < b.frame_a;
+    }
+    return a.frame_b < b.frame_b;
+}
+
+// 0.0 to 1.0, how much parallax the pair has.
+double parallax_factor(const double median_parallax_pix,
+                       const int32_t image_width) {
+    const double parallax_max =
+        std::max(1.0, kParallaxImageWidthFraction * image_width);
+    return std::min(median_parallax_pix / parallax_max, 1.0);
+}
+
+// Count the markers valid on both frames, and the median distance the
+// markers moved between the frames.
+void compute_overlap_and_parallax(const MarkerTracks &tracks,
+                                  const size_t index_a, const size_t index_b,
+                                  std::vector<double> &scratch,
+                                  size_t &out_overlap_count,
+                                  double &out_median_parallax_pix) {
+    const size_t marker_count = tracks.marker_count;
+    const size_t offset_a = index_a * marker_count;
+    const size_t offset_b = index_b * marker_count;
+
+    scratch.clear();
+    for (size_t i = 0; i < marker_count; ++i) {
+        if (!tracks.valid[offset_a + i] || !tracks.valid[offset_b + i]) {
+            continue;
+        }
+        const double dx = tracks.coords[(offset_b + i) * 2 + 0] -
+                          tracks.coords[(offset_a + i) * 2 + 0];
+        const double dy = tracks.coords[(offset_b + i) * 2 + 1] -
+                          tracks.coords[(offset_a + i) * 2 + 1];
+        scratch.push_back(std::sqrt((dx * dx) + (dy * dy)));
+    }
+
+    out_overlap_count = scratch.size();
+    out_median_parallax_pix = 0.0;
+    if (!scratch.empty()) {
+        auto middle = scratch.begin() + (scratch.size() / 2);
+        std::nth_element(scratch.begin(), middle, scratch.end());
+        out_median_parallax_pix = *middle;
+    }
+}
+
+// Compute the cheap (overlap and parallax) score of a frame pair.
+//
+// Returns false if the pair can never be a good pair.
+bool consider_frame_pair(const MarkerTracks &tracks,
+                         const FramePairSearchOptions &options,
+                         const size_t min_overlap_count, const size_t index_a,
+                         const size_t index_b, std::vector<double> &scratch,
+                         FramePairCandidate &out_candidate) {
+    const MarkerTrackFrame &frame_a = tracks.frames[index_a];
+    const MarkerTrackFrame &frame_b = tracks.frames[index_b];
+    const uint32_t frame_gap = (frame_a.frame > frame_b.frame)
+                                   ? (frame_a.frame - frame_b.frame)
+                                   : (frame_b.frame - frame_a.frame);
+    if (frame_gap < options.min_frame_gap) {
+        return false;
+    }
+
+    out_candidate.index_a = index_a;
+    out_candidate.index_b = index_b;
+    compute_overlap_and_parallax(tracks, index_a, index_b, scratch,
+                                 out_candidate.overlap_count,
+                                 out_candidate.median_parallax_pix);
+    if ((out_candidate.overlap_count < min_overlap_count) ||
+        (out_candidate.median_parallax_pix <
+         options.min_median_parallax_pix)) {
+        return false;
+    }
+
+    out_candidate.overlap_score =
+        static_cast<double>(out_candidate.overlap_count) *
+        parallax_factor(out_candidate.median_parallax_pix,
+                        frame_a.image_width);
+    return true;
+}
+
+// Score a frame pair by estimating both an essential matrix and a
+// homography.
+//
+// The essential matrix inliers are the markers that can be used to
+// triangulate. When a homography (with a small error) explains the
+// marker motion just as well, the camera has (mostly) rotated or the
+// markers are (mostly) planar, and the relative pose is not
+// reliable, so the score is reduced.
+void score_frame_pair(const MarkerTracks &tracks,
+                      const FramePairSearchOptions &options,
+                      const FramePairCandidate &candidate,
+                      FramePairScore &out_score) {
+    const MarkerTrackFrame &frame_a = tracks.frames[candidate.index_a];
+    const MarkerTrackFrame &frame_b = tracks.frames[candidate.index_b];
+    out_score.frame_a = frame_a.frame;
+    out_score.frame_b = frame_b.frame;
+    out_score.overlap_count = candidate.overlap_count;
+    out_score.median_parallax_pix = candidate.median_parallax_pix;
+    out_score.essential_inlier_count = 0;
+    out_score.homography_inlier_count = 0;
+    out_score.homography_error_pix = 0.0;
+    out_score.score = 0.0;
+
+    const size_t marker_count = tracks.marker_count;
+    const size_t offset_a = candidate.index_a * marker_count;
+    const size_t offset_b = candidate.index_b * marker_count;
+    openMVG::Mat points_a(2, candidate.overlap_count);
+    openMVG::Mat points_b(2, candidate.overlap_count);
+    size_t column = 0;
+    for (size_t i = 0; i < marker_count; ++i) {
+        if (!tracks.valid[offset_a + i] || !tracks.valid[offset_b + i]) {
+            continue;
+        }
+        points_a(0, column) = tracks.coords[(offset_a + i) * 2 + 0];
+        points_a(1, column) = tracks.coords[(offset_a + i) * 2 + 1];
+        points_b(0, column) = tracks.coords[(offset_b + i) * 2 + 0];
+        points_b(1, column) = tracks.coords[(offset_b + i) * 2 + 1];
+        ++column;
+    }
+
+    const std::pair<size_t, size_t> image_size_a(
+        static_cast<size_t>(frame_a.image_width),
+        static_cast<size_t>(frame_a.image_height));
+    const std::pair<size_t, size_t> image_size_b(
+        static_cast<size_t>(frame_b.image_width),
+        static_cast<size_t>(frame_b.image_height));
+
+    const openMVG::cameras::Pinhole_Intrinsic camera_a(
+        frame_a.image_width, frame_a.image_height, frame_a.focal_length_pix,
+        frame_a.ppx_pix, frame_a.ppy_pix);
+    const openMVG::cameras::Pinhole_Intrinsic camera_b(
+        frame_b.image_width, frame_b.image_height, frame_b.focal_length_pix,
+        frame_b.ppx_pix, frame_b.ppy_pix);
+
+    openMVG::sfm::RelativePose_Info pose_info;
+    const bool essential_ok = robust_relative_pose(
+        &camera_a, &camera_b, points_a, points_b, pose_info, image_size_a,
+        image_size_b, options.max_iteration_count, kRansacThreadCount);
+    if (!essential_ok) {
+        return;
+    }
+    out_score.essential_inlier_count = pose_info.vec_inliers.size();
+
+    openMVG::Mat3 homography_matrix;
+    std::vector<uint32_t> homography_inliers;
+    double homography_error = 0.0;
+    const bool homography_ok = robust_homography(
+        points_a, points_b, homography_matrix, image_size_a, image_size_b,
+        options.max_iteration_count, kRansacThreadCount, homography_inliers,
+        homography_error);
+
+    double homography_ratio = 0.0;
+    if (homography_ok) {
+        out_score.homography_inlier_count = homography_inliers.size();
+        out_score.homography_error_pix = homography_error;
+        if (homography_error <= options.homography_error_tolerance_pix) {
+            homography_ratio =
+                static_cast<double>(out_score.homography_inlier_count) /
+                static_cast<double>(candidate.overlap_count);
+            homography_ratio = std::min(homography_ratio, 1.0);
+        }
+    }
+
+    out_score.score =
+        static_cast<double>(out_score.essential_inlier_count) *
+        (1.0 - homography_ratio) *
+        parallax_factor(candidate.median_parallax_pix, frame_a.image_width);
+}
+
+}  // namespace
+
+size_t find_best_frame_pairs(const MarkerTracks &tracks,
+                             const FramePairSearchOptions &options,
+                             std::vector<FramePairScore> &out_pairs) {
+    out_pairs.clear();
+
+    const size_t frame_count = tracks.frames.size();
+    if ((frame_count < 2) || (tracks.marker_count == 0)) {
+        return 0;
+    }
+    const size_t min_overlap_count =
+        std::max(options.min_overlap_count, kMinimumOverlapCount);
+    const size_t max_ransac_pair_count =
+        std::max(options.max_ransac_pair_count, static_cast<size_t>(1));
+
+    // Coarse pass; compare all pairs of frames on a grid, with the
+    // grid spacing chosen to keep the number of pairs small.
+    const size_t max_coarse_pair_count = max_ransac_pair_count * 4;
+    size_t stride = 1;
+    while (true) {
+        const size_t grid_count = (frame_count + stride - 1) / stride;
+        if (((grid_count * (grid_count - 1)) / 2) <= max_coarse_pair_count) {
+            break;
+        }
+        stride *= 2;
+    }
+
+    std::vector<size_t> grid_indices;
+    for (size_t i = 0; i < frame_count; i += stride) {
+        grid_indices.push_back(i);
+    }
+    if (grid_indices.back() != (frame_count - 1)) {
+        grid_indices.push_back(frame_count - 1);
+    }
+
+    std::vector<double> scratch;
+    scratch.reserve(tracks.marker_count);
+    std::vector<FramePairCandidate> candidates;
+    std::set<std::pair<size_t, size_t>> visited;
+    for (size_t i = 0; i < grid_indices.size(); ++i) {
+        for (size_t j = i + 1; j < grid_indices.size(); ++j) {
+            const size_t index_a = grid_indices[i];
+            const size_t index_b = grid_indices[j];
+            visited.insert(std::make_pair(index_a, index_b));
+
+            FramePairCandidate candidate;
+            if (consider_frame_pair(tracks, options, min_overlap_count,
+                                    index_a, index_b, scratch, candidate)) {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), compare_candidates);
+
+    // Fine pass; compare the frames around the best coarse pairs.
+    if (stride > 1) {
+        const size_t seed_count =
+            std::min(candidates.size(),
+                     std::max(max_ransac_pair_count / 16, size_t(1)));
+        const int64_t radius = static_cast<int64_t>(stride / 2);
+        const int64_t step =
+            static_cast<int64_t>(std::max(stride / 4, size_t(1)));
+        const int64_t last_index = static_cast<int64_t>(frame_count) - 1;
+
+        std::vector<FramePairCandidate> seeds(candidates.begin(),
+                                              candidates.begin() + seed_count);
+        for (const FramePairCandidate &seed : seeds) {
+            const int64_t seed_a = static_cast<int64_t>(seed.index_a);
+            const int64_t seed_b = static_cast<int64_t>(seed.index_b);
+            for (int64_t a = seed_a - radius; a <= seed_a + radius; a += step) {
+                for (int64_t b = seed_b - radius; b <= seed_b + radius;
+                     b += step) {
+                    if ((a < 0) || (b > last_index) || (a >= b)) {
+                        continue;
+                    }
+                    const auto key = std::make_pair(static_cast<size_t>(a),
+                                                    static_cast<size_t>(b));
+                    if (!visited.insert(key).second) {
+                        continue;
+                    }
+
+                    FramePairCandidate candidate;
+                    if (consider_frame_pair(tracks, options, min_overlap_count,
+                                            key.first, key.second, scratch,
+                                            candidate)) {
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), compare_candidates);
+    }
+
+    if (candidates.size() > max_ransac_pair_count) {
+        candidates.resize(max_ransac_pair_count);
+    }
+
+    // Robust model estimation for the remaining pairs. Each pair is
+    // independent, so the pairs are scored in parallel.
+    const size_t candidate_count = candidates.size();
+    std::vector<FramePairScore> scores(candidate_count);
+    const size_t min_chunk_size = 1;
+    mmthread::parallelForChunks(
+        candidate_count, std::max<size_t>(options.thread_count, 1),
+        min_chunk_size,
+        [&tracks, &options, &candidates, &scores](const size_t start,
+                                                  const size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                score_frame_pair(tracks, options, candidates[i], scores[i]);
+            }
+        });
+
+    for (const FramePairScore &score : scores) {
+        if (score.essential_inlier_count > 0) {
+            out_pairs.push_back(score);
+        }
+    }
+    std::sort(out_pairs.begin(), out_pairs.end(), compare_scores);
+    if (out_pairs.size() > options.result_count) {
+        out_pairs.resize(options.result_count);
+    }
+
+    return candidate_count;
+}
+
+}  // namespace sfm
+}  // namespace mmsolver
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Search a frame range for the frame pairs that are best suited to
+ * initialise a camera solve with a relative pose.
+ *
+ * A good frame pair has many markers in common, enough parallax
+ * between the frames, and cannot be explained by a homography alone
+ * (a camera that only rotates, or markers that all lie on a plane,
+ * do not give a reliable relative pose).
+ */
+
+#ifndef MM_SOLVER_SFM_FRAME_PAIR_SEARCH_H
+#define MM_SOLVER_SFM_FRAME_PAIR_SEARCH_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// MM Solver
+#include "mmSolver/sfm/marker_tracks.h"
+
+namespace mmsolver {
+namespace sfm {
+
+struct FramePairSearchOptions {
+    // The smallest number of frames between the two frames of a pair.
+    uint32_t min_frame_gap;
+
+    // Pairs with fewer markers valid on both frames are skipped. The
+    // essential matrix solver needs more than 8 points.
+    size_t min_overlap_count;
+
+    // Pairs with less median marker motion (in pixels) are skipped.
+    double min_median_parallax_pix;
+
+    // A homography with a (AC-RANSAC) pixel error at or below this
+    // value is considered to explain the motion of its inliers.
+    double homography_error_tolerance_pix;
+
+    // The maximum number of frame pairs that are given to the
+    // (expensive) robust model estimation.
+    size_t max_ransac_pair_count;
+
+    size_t max_iteration_count;
+
+    // The number of ranked pairs returned.
+    size_t result_count;
+
+    size_t thread_count;
+
+    FramePairSearchOptions()
+        : min_frame_gap(1)
+        , min_overlap_count(9)
+        , min_median_parallax_pix(2.0)
+        , homography_error_tolerance_pix(1.0)
+        , max_ransac_pair_count(256)
+        , max_iteration_count(1024)
+        , result_count(10)
+        , thread_count(1) {}
+};
+
+struct FramePairScore {
+    uint32_t frame_a;
+    uint32_t frame_b;
+    size_t overlap_count;
+    double median_parallax_pix;
+    size_t essential_inlier_count;
+    size_t homography_inlier_count;
+    double homography_error_pix;
+    double score;
+
+    FramePairScore()
+        : frame_a(0)
+        , frame_b(0)
+        , overlap_count(0)
+        , median_parallax_pix(0.0)
+        , essential_inlier_count(0)
+        , homography_inlier_count(0)
+        , homography_error_pix(0.0)
+        , score(0.0) {}
+};
+
+// Find the best frame pairs in 'tracks', returned in 'out_pairs'
+// ranked best first.
+//
+// The pairs are pruned coarse-to-fine; first the marker overlap and
+// parallax of pairs on a coarse grid of frames are compared, then
+// the frames around the best coarse pairs are compared, and only the
+// best 'max_ransac_pair_count' pairs are scored with an essential
+// matrix and a homography (estimated in parallel). No Maya API
+// functions are called, and nothing is printed.
+//
+// Returns the number of pairs scored with robust model estimation.
+size_t find_best_frame_pairs(const MarkerTracks &tracks,
+                             const FramePairSearchOptions &options,
+                             std::vector<FramePairScore> &out_pairs);
+
+}  // namespace sfm
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_SFM_FRAME_PAIR_SEARCH_H
@@ -80,9 +80,11 @@
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
+#include "mmSolver/sfm/parallel_ac_ransac.h"
 #include "mmSolver/sfm/sfm_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
+#include "mmSolver/utilities/thread_pool.h"
 
 namespace mmsolver {
 namespace sfm {
@@ -96,7 +98,23 @@ bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
                        openMVG::Mat3 &homography_matrix,
                        const std::pair<size_t, size_t> &size_ima1,
                        const std::pair<size_t, size_t> &size_ima2,
-                       const size_t max_iteration_count) {
+                       const size_t max_iteration_count,
+                       const size_t thread_count) {
+    std::vector<uint32_t> vec_inliers;
+    double out_error_max = std::numeric_limits<double>::infinity();
+    return robust_homography(x1, x2, homography_matrix, size_ima1, size_ima2,
+                             max_iteration_count, thread_count, vec_inliers,
+                             out_error_max);
+}
+
+bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
+                       openMVG::Mat3 &homography_matrix,
+                       const std::pair<size_t, size_t> &size_ima1,
+                       const std::pair<size_t, size_t> &size_ima2,
+                       const size_t max_iteration_count,
+                       const size_t thread_count,
+                       std::vector<uint32_t> &vec_inliers,
+                       double &out_error_max) {
     // Enable to print out 'MMSOLVER_MAYA_VRB' results.
     const bool verbose = false;
 
@@ -104,7 +122,7 @@ bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
     const double error_max = std::numeric_limits<double>::infinity();
 
     // The amount of pixel error that is computed.
-    double out_error_max = std::numeric_limits<double>::infinity();
+    out_error_max = std::numeric_limits<double>::infinity();
 
     MMSOLVER_MAYA_VRB("robust_homography: x1: " << x1);
     MMSOLVER_MAYA_VRB("robust_homography: x2: " << x2);
@@ -128,10 +146,13 @@ bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
 
     // Robustly estimate the Homography matrix with A Contrario (AC)
     // RANSAC.
-    std::vector<uint32_t> vec_inliers;
-    const auto ac_ransac_output = openMVG::robust::ACRANSAC(
-        kernel, vec_inliers, max_iteration_count, &homography_matrix,
-        error_upper_bound, verbose);
+    ParallelACRansacOptions ac_ransac_options;
+    ac_ransac_options.max_iteration_count = max_iteration_count;
+    ac_ransac_options.precision = error_upper_bound;
+    ac_ransac_options.thread_count = thread_count;
+    vec_inliers.clear();
+    const auto ac_ransac_output = parallel_ac_ransac(
+        kernel, vec_inliers, ac_ransac_options, &homography_matrix);
     out_error_max = ac_ransac_output.first;
 
     auto minimum_samples = KernelType::Solver::MINIMUM_SAMPLES;
@@ -194,7 +215,8 @@ bool compute_homography(
     auto num_max_iter = 4096;
     bool robust_pose_ok = robust_homography(
         marker_coords_matrix_a, marker_coords_matrix_b, homography_matrix,
-        image_size_a, image_size_b, num_max_iter);
+        image_size_a, image_size_b, num_max_iter,
+        mmthread::defaultThreadCount());
     if (!robust_pose_ok) {
         MMSOLVER_MAYA_ERR("Robust homography estimation failure.");
         return false;
@@ -61,11 +61,25 @@
 namespace mmsolver {
 namespace sfm {
 
+// Robustly estimate the homography with AC-RANSAC, run on
+// 'thread_count' threads; see 'parallel_ac_ransac'.
 bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
                        openMVG::Mat3 &homography_matrix,
                        const std::pair<size_t, size_t> &size_ima1,
                        const std::pair<size_t, size_t> &size_ima2,
-                       const size_t max_iteration_count);
+                       const size_t max_iteration_count,
+                       const size_t thread_count);
+
+// Same as above, and also returns the indices of the inlier points
+// and the AC-RANSAC error threshold (in pixels) used to find them.
+bool robust_homography(const openMVG::Mat &x1, const openMVG::Mat &x2,
+                       openMVG::Mat3 &homography_matrix,
+                       const std::pair<size_t, size_t> &size_ima1,
+                       const std::pair<size_t, size_t> &size_ima2,
+                       const size_t max_iteration_count,
+                       const size_t thread_count,
+                       std::vector<uint32_t> &vec_inliers,
+                       double &out_error_max);
 
 bool compute_homography(
     const int32_t image_width_a, const int32_t image_width_b,
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * The 2D marker positions of a camera over a range of frames, read
+ * from Maya once and then used by the structure-from-motion
+ * functions without Maya.
+ */
+
+#ifndef MM_SOLVER_SFM_MARKER_TRACKS_H
+#define MM_SOLVER_SFM_MARKER_TRACKS_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mmsolver {
+namespace sfm {
+
+// The camera of one frame in 'MarkerTracks'.
+struct MarkerTrackFrame {
+    uint32_t frame;
+    int32_t image_width;
+    int32_t image_height;
+    double focal_length_pix;
+    double ppx_pix;
+    double ppy_pix;
+
+    MarkerTrackFrame()
+        : frame(0)
+        , image_width(2)
+        , image_height(2)
+        , focal_length_pix(0.0)
+        , ppx_pix(0.0)
+        , ppy_pix(0.0) {}
+};
+
+// The pixel positions of many markers over many frames, gathered
+// from Maya once, so they can be used on any thread.
+struct MarkerTracks {
+    std::vector<MarkerTrackFrame> frames;
+    size_t marker_count;
+
+    // Marker 'm' at frame index 'f' is stored at index
+    // '(f * marker_count) + m'; 'coords' stores 2 values (X and Y)
+    // per marker.
+    std::vector<double> coords;
+    std::vector<uint8_t> valid;
+
+    MarkerTracks() : frames(), marker_count(0), coords(), valid() {}
+
+    size_t index(const size_t frame_index, const size_t marker_index) const {
+        return (frame_index * marker_count) + marker_index;
+    }
+
+    void resize(const size_t frame_count, const size_t new_marker_count) {
+        frames.resize(frame_count);
+        marker_count = new_marker_count;
+        coords.assign(frame_count * new_marker_count * 2, 0.0);
+        valid.assign(frame_count * new_marker_count, 0);
+    }
+};
+
+}  // namespace sfm
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_SFM_MARKER_TRACKS_H
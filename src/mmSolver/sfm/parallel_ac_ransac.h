@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ *
+ * A multi-threaded A Contrario RANSAC (AC-RANSAC) driver, with early
+ * termination, for OpenMVG AC-RANSAC kernels.
+ *
+ * The hypotheses are generated and scored by a fixed number of
+ * independent sampling "streams", each with a deterministic random
+ * seed. The streams run in rounds of a few iterations; after each
+ * round the best model of all streams (the lowest NFA, Number of
+ * False Alarms) is shared with every stream, and the search stops
+ * once enough hypotheses have been tested to find an uncontaminated
+ * sample with the requested confidence. Finally a fixed number of
+ * iterations sample only from the best inliers found (the AC-RANSAC
+ * "local optimization").
+ *
+ * The streams are distributed over the threads of the shared thread
+ * pool, and shared data is only exchanged between rounds, so the
+ * result is the same for any number of threads (greater than one).
+ * With one thread, 'openMVG::robust::ACRANSAC' is used, unchanged.
+ */
+
+#ifndef MM_SOLVER_SFM_PARALLEL_AC_RANSAC_H
+#define MM_SOLVER_SFM_PARALLEL_AC_RANSAC_H
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// OpenMVG
+#ifdef MMSOLVER_USE_OPENMVG
+
+#include <openMVG/robust_estimation/rand_sampling.hpp>
+#include <openMVG/robust_estimation/robust_estimator_ACRansac.hpp>
+
+#endif  // MMSOLVER_USE_OPENMVG
+
+// MM Solver
+#include "mmSolver/utilities/thread_pool.h"
+
+namespace mmsolver {
+namespace sfm {
+
+struct ParallelACRansacOptions {
+    // The maximum number of iterations, over all streams. As with
+    // 'openMVG::robust::ACRANSAC', 10% of the iterations are
+    // reserved for sampling from the best inliers.
+    size_t max_iteration_count;
+
+    // Upper bound of the (squared) residual error, or infinity for
+    // no upper bound. The same as the 'precision' argument of
+    // 'openMVG::robust::ACRANSAC'.
+    double precision;
+
+    // Stop searching once the probability of having tested at least
+    // one sample made only of inliers reaches this value. Values
+    // outside of (0.0, 1.0) disable early termination.
+    double confidence;
+
+    // The number of independent sampling streams. The result depends
+    // on the stream count and seed, but not on the thread count.
+    size_t stream_count;
+
+    // The number of iterations run by each stream between sharing the
+    // best model.
+    size_t round_iteration_count;
+
+    uint32_t seed;
+
+    // With one thread (or zero), 'openMVG::robust::ACRANSAC' is used
+    // and the stream options above are ignored.
+    size_t thread_count;
+
+    ParallelACRansacOptions()
+        : max_iteration_count(1024)
+        , precision(std::numeric_limits<double>::infinity())
+        , confidence(0.99)
+        , stream_count(8)
+        , round_iteration_count(2)
+        , seed(std::mt19937::default_seed)
+        , thread_count(1) {}
+};
+
+namespace parallel_ac_ransac_internal {
+
+// The number of samples needed to draw at least one sample of
+// 'sample_size' inliers with the probability 'confidence'.
+inline size_t required_iteration_count(const size_t inlier_count,
+                                       const size_t data_count,
+                                       const size_t sample_size,
+                                       const double confidence) {
+    const size_t max_count = std::numeric_limits<size_t>::max();
+    if ((confidence <= 0.0) || (confidence >= 1.0) || (data_count == 0)) {
+        return max_count;
+    }
+    const double inlier_ratio =
+        static_cast<double>(inlier_count) / static_cast<double>(data_count);
+    const double good_sample_probability =
+        std::pow(inlier_ratio, static_cast<double>(sample_size));
+    if (good_sample_probability >= 1.0) {
+        return 1;
+    }
+    const double denominator = std::log1p(-good_sample_probability);
+    if (denominator >= 0.0) {
+        return max_count;
+    }
+    const double count = std::ceil(std::log1p(-confidence) / denominator);
+    if (count >= static_cast<double>(max_count)) {
+        return max_count;
+    }
+    return std::max<size_t>(static_cast<size_t>(count), 1);
+}
+
+template <typename Kernel>
+struct Stream {
+    using Model = typename Kernel::Model;
+
+    Stream(const Kernel &kernel, const double max_threshold,
+           const bool quantified_nfa_evaluation, const uint32_t seed)
+        : random_generator(seed)
+        , nfa_interface(kernel, max_threshold, quantified_nfa_evaluation)
+        , ac_ransac_mode(!quantified_nfa_evaluation)
+        , nfa_limit(std::numeric_limits<double>::infinity())
+        , min_nfa(std::numeric_limits<double>::infinity())
+        , error_max(std::numeric_limits<double>::infinity())
+        , has_model(false) {
+        vec_index.resize(kernel.NumSamples());
+        std::iota(vec_index.begin(), vec_index.end(), 0);
+        vec_sample.resize(Kernel::MINIMUM_SAMPLES);
+    }
+
+    // Test 'iteration_count' hypotheses, keeping the model with the
+    // lowest NFA if it is lower than both 'min_nfa' and 'nfa_limit'.
+    void run(const Kernel &kernel, const size_t iteration_count,
+             const double max_threshold) {
+        const uint32_t sample_size = Kernel::MINIMUM_SAMPLES;
+        const uint32_t data_count = kernel.NumSamples();
+        for (size_t iter = 0; iter < iteration_count; ++iter) {
+            if (ac_ransac_mode) {
+                openMVG::robust::UniformSample(sample_size, random_generator,
+                                               &vec_index, &vec_sample);
+            } else {
+                openMVG::robust::UniformSample(sample_size, data_count,
+                                               random_generator, &vec_sample);
+            }
+
+            vec_models.clear();
+            kernel.Fit(vec_sample, &vec_models);
+
+            for (const auto &model_it : vec_models) {
+                kernel.Errors(model_it, nfa_interface.residuals());
+
+                if (!ac_ransac_mode) {
+                    // MAX-CONSENSUS check; does a model with enough
+                    // support exist?
+                    uint32_t inlier_count = 0;
+                    const std::vector<double> &residuals =
+                        nfa_interface.residuals();
+                    for (uint32_t i = 0; i < data_count; ++i) {
+                        if (residuals[i] <= max_threshold) {
+                            ++inlier_count;
+                        }
+                    }
+                    if (inlier_count > 2.5 * sample_size) {
+                        ac_ransac_mode = true;
+                    }
+                }
+
+                if (ac_ransac_mode) {
+                    std::pair<double, double> nfa_threshold(
+                        std::min(min_nfa, nfa_limit), 0.0);
+                    const bool better = nfa_interface.ComputeNFA_and_inliers(
+                        candidate_inliers, nfa_threshold);
+                    if (better) {
+                        min_nfa = nfa_threshold.first;
+                        error_max = nfa_threshold.second;
+                        inliers.swap(candidate_inliers);
+                        model = model_it;
+                        has_model = true;
+                    }
+                }
+            }
+        }
+    }
+
+    std::mt19937 random_generator;
+    openMVG::robust::acransac_nfa_internal::NFA_Interface<Kernel>
+        nfa_interface;
+    std::vector<uint32_t> vec_index;
+    std::vector<uint32_t> vec_sample;
+    std::vector<Model> vec_models;
+    std::vector<uint32_t> candidate_inliers;
+
+    bool ac_ransac_mode;
+
+    // The lowest NFA of all streams, from the last round.
+    double nfa_limit;
+
+    // The best model found by this stream.
+    double min_nfa;
+    double error_max;
+    std::vector<uint32_t> inliers;
+    Model model;
+    bool has_model;
+};
+
+}  // namespace parallel_ac_ransac_internal
+
+// Robustly estimate a model with AC-RANSAC, using multiple threads.
+//
+// A replacement for 'openMVG::robust::ACRANSAC', with the same kernel,
+// inliers, model and return value (the error threshold and the NFA).
+// When 'options.thread_count' is one (or zero) this simply calls
+// 'openMVG::robust::ACRANSAC', so single-threaded callers get exactly
+// the same results as before.
+//
+// Otherwise the kernel's 'Fit' and 'Errors' functions are called from
+// multiple threads at once. No Maya API functions are called, and
+// nothing is printed.
+//
+// 'out_iteration_count' (if not null) is set to the number of
+// hypotheses tested, or to the maximum iteration count when
+// 'openMVG::robust::ACRANSAC' is used.
+template <typename Kernel>
+std::pair<double, double> parallel_ac_ransac(
+    const Kernel &kernel, std::vector<uint32_t> &vec_inliers,
+    const ParallelACRansacOptions &options,
+    typename Kernel::Model *model = nullptr,
+    size_t *out_iteration_count = nullptr) {
+    using StreamType = parallel_ac_ransac_internal::Stream<Kernel>;
+
+    if (options.thread_count <= 1) {
+        if (out_iteration_count) {
+            *out_iteration_count = options.max_iteration_count;
+        }
+        const bool verbose = false;
+        return openMVG::robust::ACRANSAC(
+            kernel, vec_inliers,
+            static_cast<unsigned int>(options.max_iteration_count), model,
+            options.precision, verbose);
+    }
+
+    vec_inliers.clear();
+    if (out_iteration_count) {
+        *out_iteration_count = 0;
+    }
+
+    const size_t sample_size = Kernel::MINIMUM_SAMPLES;
+    const size_t data_count = kernel.NumSamples();
+    if (data_count <= sample_size) {
+        return {0.0, 0.0};
+    }
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    const bool quantified_nfa_evaluation = options.precision != infinity;
+    const double max_threshold =
+        quantified_nfa_evaluation
+            ? options.precision * kernel.normalizer2()(0, 0) *
+                  kernel.normalizer2()(0, 0)
+            : infinity;
+
+    const size_t stream_count = std::max<size_t>(options.stream_count, 1);
+    const size_t round_iteration_count =
+        std::max<size_t>(options.round_iteration_count, 1);
+    const size_t reserve_iteration_count = options.max_iteration_count / 10;
+    const size_t search_iteration_count =
+        options.max_iteration_count - reserve_iteration_count;
+
+    std::vector<std::unique_ptr<StreamType>> streams;
+    streams.reserve(stream_count);
+    for (size_t i = 0; i < stream_count; ++i) {
+        const uint32_t seed = options.seed + static_cast<uint32_t>(i);
+        streams.emplace_back(new StreamType(kernel, max_threshold,
+                                            quantified_nfa_evaluation, seed));
+    }
+
+    const size_t thread_count = std::min(options.thread_count, stream_count);
+
+    // Run 'total_count' iterations, split over the streams.
+    auto run_streams = [&](const size_t total_count) {
+        auto run_stream = [&](const size_t stream_index) {
+            size_t count = total_count / stream_count;
+            if (stream_index < (total_count % stream_count)) {
+                ++count;
+            }
+            streams[stream_index]->run(kernel, count, max_threshold);
+        };
+
+        const size_t min_chunk_size = 1;
+        mmthread::parallelForChunks(
+            stream_count, thread_count, min_chunk_size,
+            [&run_stream](const size_t start, const size_t end) {
+                for (size_t i = start; i < end; ++i) {
+                    run_stream(i);
+                }
+            });
+    };
+
+    // Share the best model (the lowest NFA, and the lowest stream
+    // index on ties) with all streams. Returns the best stream index.
+    auto share_best_model = [&]() {
+        size_t best_index = 0;
+        bool ac_ransac_mode = false;
+        for (size_t i = 0; i < stream_count; ++i) {
+            if (streams[i]->min_nfa < streams[best_index]->min_nfa) {
+                best_index = i;
+            }
+            ac_ransac_mode = ac_ransac_mode || streams[i]->ac_ransac_mode;
+        }
+
+        // Streams only keep models better than the best so far.
+        const double nfa_limit = streams[best_index]->min_nfa;
+        for (size_t i = 0; i < stream_count; ++i) {
+            streams[i]->ac_ransac_mode = ac_ransac_mode;
+            streams[i]->nfa_limit = nfa_limit;
+        }
+        return best_index;
+    };
+
+    // Search for models, until the confidence is reached.
+    size_t iteration_count = 0;
+    size_t best_index = 0;
+    const size_t round_count = stream_count * round_iteration_count;
+    while (iteration_count < search_iteration_count) {
+        const size_t count =
+            std::min(round_count, search_iteration_count - iteration_count);
+        run_streams(count);
+        iteration_count += count;
+        best_index = share_best_model();
+
+        const StreamType &best = *streams[best_index];
+        if (!best.ac_ransac_mode) {
+            // No model with enough support has been found, and is
+            // unlikely to be found.
+            if (iteration_count > (reserve_iteration_count * 2)) {
+                break;
+            }
+            continue;
+        }
+        if (best.has_model && (best.min_nfa < 0.0)) {
+            const size_t required_count =
+                parallel_ac_ransac_internal::required_iteration_count(
+                    best.inliers.size(), data_count, sample_size,
+                    options.confidence);
+            if (iteration_count >= required_count) {
+                break;
+            }
+        }
+    }
+
+    // Local optimization; sample only from the best inliers.
+    const StreamType &search_best = *streams[best_index];
+    if (search_best.ac_ransac_mode && (reserve_iteration_count > 0)) {
+        if (!search_best.inliers.empty()) {
+            const std::vector<uint32_t> best_inliers = search_best.inliers;
+            for (size_t i = 0; i < stream_count; ++i) {
+                streams[i]->vec_index = best_inliers;
+            }
+        }
+        run_streams(reserve_iteration_count);
+        iteration_count += reserve_iteration_count;
+        best_index = share_best_model();
+    }
+
+    if (out_iteration_count) {
+        *out_iteration_count = iteration_count;
+    }
+
+    StreamType &best = *streams[best_index];
+    double min_nfa = best.min_nfa;
+    double error_max = best.error_max;
+    if (best.has_model && model) {
+        *model = best.model;
+    }
+    if (min_nfa < 0.0) {
+        vec_inliers.swap(best.inliers);
+    }
+
+    if (!vec_inliers.empty()) {
+        // Un-normalize the model and the associated NFA threshold.
+        if (model) {
+            kernel.Unnormalize(model);
+        }
+        error_max = kernel.unormalizeError(error_max);
+    }
+
+    return {error_max, min_nfa};
+}
+
+}  // namespace sfm
+}  // namespace mmsolver
+
+#endif  // MM_SOLVER_SFM_PARALLEL_AC_RANSAC_H
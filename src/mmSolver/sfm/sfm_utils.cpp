@@ -77,6 +77,7 @@
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_lens_model_utils.h"
 #include "mmSolver/mayahelper/maya_marker.h"
+#include "mmSolver/mayahelper/maya_marker_group.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
@@ -459,6 +460,343 @@ bool add_bundle_at_frame(
     return success;
 }
 
+namespace {
+
+// Read 'attr' at all of 'times', or use 'default_value' when the
+// attribute does not exist on the node.
+MStatus get_attr_values_or_default(Attr &attr, const MTimeArray &times,
+                                   const int timeEvalMode,
+                                   const double default_value,
+                                   std::vector<double> &out_values) {
+    MPlug plug = attr.getPlug();
+    if (plug.isNull()) {
+        out_values.assign(times.length(), default_value);
+        return MS::kSuccess;
+    }
+    return attr.getValues(out_values, times, timeEvalMode);
+}
+
+// The inverse overscan values of a MarkerGroup at all times, read
+// once per MarkerGroup node.
+struct MarkerGroupOverscan {
+    std::vector<double> inverse_x;
+    std::vector<double> inverse_y;
+};
+
+// Read the (overscan corrected) position and the weight of 'marker'
+// at all of 'times'. The weight of a disabled marker is zero.
+MStatus get_marker_values_at_times(
+    const MTimeArray &times, MarkerPtr &marker,
+    std::map<std::string, MarkerGroupOverscan> &overscan_cache,
+    std::vector<double> &out_x, std::vector<double> &out_y,
+    std::vector<double> &out_weight, std::vector<double> &scratch) {
+    MStatus status = MStatus::kSuccess;
+    const auto timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+    const uint32_t time_count = times.length();
+
+    status = marker->getPosXAttr().getValues(out_x, times, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = marker->getPosYAttr().getValues(out_y, times, timeEvalMode);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = get_attr_values_or_default(marker->getWeightAttr(), times,
+                                        timeEvalMode, 1.0, out_weight);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = get_attr_values_or_default(marker->getEnableAttr(), times,
+                                        timeEvalMode, 1.0, scratch);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    for (uint32_t i = 0; i < time_count; ++i) {
+        const bool enable = static_cast<int>(scratch[i]) != 0;
+        out_weight[i] *= static_cast<double>(enable);
+    }
+
+    // Take into account the MarkerGroup's 'overscan' attributes, the
+    // same as 'Marker::getPosXY'. Many markers share the same
+    // MarkerGroup, so the overscan values are only read once.
+    auto marker_group = marker->getMarkerGroup();
+    if (marker_group) {
+        const std::string group_name = marker_group->getNodeName().asChar();
+        auto it = overscan_cache.find(group_name);
+        if (it == overscan_cache.end()) {
+            MarkerGroupOverscan overscan;
+            status = marker_group->getOverscanXAttr().getValues(
+                overscan.inverse_x, times, timeEvalMode);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+            status = marker_group->getOverscanYAttr().getValues(
+                overscan.inverse_y, times, timeEvalMode);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+            for (uint32_t i = 0; i < time_count; ++i) {
+                overscan.inverse_x[i] = 1.0 / overscan.inverse_x[i];
+                overscan.inverse_y[i] = 1.0 / overscan.inverse_y[i];
+            }
+            it = overscan_cache.insert({group_name, overscan}).first;
+        }
+        const MarkerGroupOverscan &overscan = it->second;
+        for (uint32_t i = 0; i < time_count; ++i) {
+            out_x[i] *= overscan.inverse_x[i];
+            out_y[i] *= overscan.inverse_y[i];
+        }
+    }
+
+    return status;
+}
+
+// Undistort the valid markers of frame index 'frame_index' in
+// 'tracks', in place. The coordinates are expected to be in the
+// Marker coordinate space (-0.5 to 0.5).
+//
+// Markers sharing the same lens model are undistorted with a single
+// call, so the lens (chain) parameters are set up once per frame,
+// rather than once per marker.
+void undistort_marker_tracks_at_frame(
+    const size_t frame_index, const size_t frame_count,
+    const std::vector<std::shared_ptr<mmlens::LensModel>>
+        &markerFrameToLensModelList,
+    MarkerTracks &tracks,
+    std::vector<std::pair<mmlens::LensModel *, size_t>> &lens_markers,
+    std::vector<double> &points) {
+    lens_markers.clear();
+    for (size_t i = 0; i < tracks.marker_count; ++i) {
+        const size_t index = tracks.index(frame_index, i);
+        mmlens::LensModel *lens_model =
+            markerFrameToLensModelList[(i * frame_count) + frame_index].get();
+        if (tracks.valid[index] && lens_model) {
+            lens_markers.push_back({lens_model, i});
+        }
+    }
+    std::stable_sort(
+        lens_markers.begin(), lens_markers.end(),
+        [](const std::pair<mmlens::LensModel *, size_t> &a,
+           const std::pair<mmlens::LensModel *, size_t> &b) {
+            return a.first < b.first;
+        });
+
+    size_t run_start = 0;
+    while (run_start < lens_markers.size()) {
+        mmlens::LensModel *lens_model = lens_markers[run_start].first;
+        size_t run_end = run_start;
+        while ((run_end < lens_markers.size()) &&
+               (lens_markers[run_end].first == lens_model)) {
+            ++run_end;
+        }
+
+        const size_t point_count = run_end - run_start;
+        points.resize(point_count * 2);
+        for (size_t k = 0; k < point_count; ++k) {
+            const size_t marker_index = lens_markers[run_start + k].second;
+            const size_t index = tracks.index(frame_index, marker_index);
+            points[(k * 2) + 0] = tracks.coords[(index * 2) + 0];
+            points[(k * 2) + 1] = tracks.coords[(index * 2) + 1];
+        }
+
+        lens_model->applyModelUndistortPoints(points.data(), points.data(),
+                                              point_count);
+
+        for (size_t k = 0; k < point_count; ++k) {
+            const size_t marker_index = lens_markers[run_start + k].second;
+            const size_t index = tracks.index(frame_index, marker_index);
+
+            // Applying the lens distortion model to large input
+            // values, creates NaN undistorted points.
+            const double out_x = points[(k * 2) + 0];
+            const double out_y = points[(k * 2) + 1];
+            if (std::isfinite(out_x)) {
+                tracks.coords[(index * 2) + 0] = out_x;
+            }
+            if (std::isfinite(out_y)) {
+                tracks.coords[(index * 2) + 1] = out_y;
+            }
+        }
+
+        run_start = run_end;
+    }
+}
+
+}  // namespace
+
+MStatus gather_marker_tracks(const std::vector<uint32_t> &frames,
+                             CameraPtr &camera, MarkerPtrList &marker_list,
+                             MarkerTracks &out_tracks) {
+    MStatus status = MStatus::kSuccess;
+
+    const auto uiUnit = MTime::uiUnit();
+    const uint32_t frame_count = static_cast<uint32_t>(frames.size());
+    MTimeArray frameList;
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        auto frame_value = static_cast<double>(frames[i]);
+        frameList.append(MTime(frame_value, uiUnit));
+    }
+
+    std::vector<std::shared_ptr<mmlens::LensModel>> markerFrameToLensModelList;
+    {
+        CameraPtrList cameraList;
+        cameraList.push_back(camera);
+        AttrPtrList attrList;
+        std::vector<std::shared_ptr<mmlens::LensModel>>
+            attrFrameToLensModelList;
+        std::vector<std::shared_ptr<mmlens::LensModel>> lensModelList;
+        status = mmsolver::constructLensModelList(
+            cameraList, marker_list, attrList, frameList,
+            markerFrameToLensModelList, attrFrameToLensModelList,
+            lensModelList);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    const size_t marker_count = marker_list.size();
+    out_tracks.resize(frame_count, marker_count);
+
+    // Read the marker values of all frames, one marker at a time, so
+    // each attribute is only looked up once.
+    std::map<std::string, MarkerGroupOverscan> overscan_cache;
+    std::vector<double> values_x;
+    std::vector<double> values_y;
+    std::vector<double> values_weight;
+    std::vector<double> scratch;
+    for (size_t i = 0; i < marker_count; ++i) {
+        auto marker = marker_list[i];
+        status = get_marker_values_at_times(frameList, marker, overscan_cache,
+                                            values_x, values_y, values_weight,
+                                            scratch);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        for (uint32_t j = 0; j < frame_count; ++j) {
+            if (!(values_weight[j] > 0)) {
+                continue;
+            }
+            const size_t index = out_tracks.index(j, i);
+            out_tracks.valid[index] = 1;
+            out_tracks.coords[(index * 2) + 0] = values_x[j];
+            out_tracks.coords[(index * 2) + 1] = values_y[j];
+        }
+    }
+
+    std::vector<std::pair<mmlens::LensModel *, size_t>> lens_markers;
+    std::vector<double> points;
+    for (uint32_t j = 0; j < frame_count; ++j) {
+        const MTime time = frameList[j];
+        MarkerTrackFrame &track_frame = out_tracks.frames[j];
+        track_frame.frame = frames[j];
+
+        double focal_length_mm = 35.0;
+        double sensor_width_mm = 36.0;
+        double sensor_height_mm = 24.0;
+        status = get_camera_values(time, camera, track_frame.image_width,
+                                   track_frame.image_height, focal_length_mm,
+                                   sensor_width_mm, sensor_height_mm);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        convert_camera_lens_mm_to_pixel_units(
+            track_frame.image_width, track_frame.image_height,
+            focal_length_mm, sensor_width_mm, track_frame.focal_length_pix,
+            track_frame.ppx_pix, track_frame.ppy_pix);
+
+        undistort_marker_tracks_at_frame(j, frame_count,
+                                         markerFrameToLensModelList,
+                                         out_tracks, lens_markers, points);
+
+        // Convert to pixel units.
+        const double image_width =
+            static_cast<double>(track_frame.image_width);
+        const double image_height =
+            static_cast<double>(track_frame.image_height);
+        for (size_t i = 0; i < marker_count; ++i) {
+            const size_t index = out_tracks.index(j, i);
+            if (!out_tracks.valid[index]) {
+                continue;
+            }
+            double &x = out_tracks.coords[(index * 2) + 0];
+            double &y = out_tracks.coords[(index * 2) + 1];
+            x = (x + 0.5) * image_width;
+            y = (y + 0.5) * image_height;
+        }
+    }
+
+    return status;
+}
+
+MStatus gather_marker_tracks(const uint32_t start_frame,
+                             const uint32_t end_frame, CameraPtr &camera,
+                             MarkerPtrList &marker_list,
+                             MarkerTracks &out_tracks) {
+    const uint32_t frame_count = end_frame - start_frame + 1;
+    std::vector<uint32_t> frames(frame_count);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        frames[i] = start_frame + i;
+    }
+    return gather_marker_tracks(frames, camera, marker_list, out_tracks);
+}
+
+MStatus gather_marker_pairs(
+    const uint32_t frame_a, const uint32_t frame_b, CameraPtr &camera_a,
+    CameraPtr &camera_b, MarkerPtrList &marker_list_a,
+    MarkerPtrList &marker_list_b,
+    std::vector<std::pair<double, double>> &marker_coords_a,
+    std::vector<std::pair<double, double>> &marker_coords_b,
+    std::vector<uint8_t> &out_pair_valid) {
+    MStatus status = MStatus::kSuccess;
+    assert(marker_list_a.size() == marker_list_b.size());
+
+    MarkerTracks tracks_a;
+    MarkerTracks tracks_b;
+    const std::vector<uint32_t> frames_a = {frame_a};
+    const std::vector<uint32_t> frames_b = {frame_b};
+    status = gather_marker_tracks(frames_a, camera_a, marker_list_a, tracks_a);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = gather_marker_tracks(frames_b, camera_b, marker_list_b, tracks_b);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    // Both markers in the pair must exist in order to be added as
+    // valid coordinates.
+    const size_t pair_count = marker_list_a.size();
+    out_pair_valid.assign(pair_count, 0);
+    for (size_t i = 0; i < pair_count; ++i) {
+        if (!tracks_a.valid[i] || !tracks_b.valid[i]) {
+            continue;
+        }
+        out_pair_valid[i] = 1;
+
+        auto xy_a = std::pair<double, double>{tracks_a.coords[(i * 2) + 0],
+                                              tracks_a.coords[(i * 2) + 1]};
+        auto xy_b = std::pair<double, double>{tracks_b.coords[(i * 2) + 0],
+                                              tracks_b.coords[(i * 2) + 1]};
+        marker_coords_a.push_back(xy_a);
+        marker_coords_b.push_back(xy_b);
+    }
+    return status;
+}
+
+MStatus gather_bundle_positions(const MTimeArray &times,
+                                BundlePtrList &bundle_list,
+                                std::vector<double> &out_positions,
+                                std::vector<uint8_t> &out_valid) {
+    MStatus status = MStatus::kSuccess;
+    const auto timeEvalMode = TIME_EVAL_MODE_DG_CONTEXT;
+
+    const uint32_t time_count = times.length();
+    const size_t bundle_count = bundle_list.size();
+    out_positions.assign(time_count * bundle_count * 3, 0.0);
+    out_valid.assign(time_count * bundle_count, 0);
+    for (size_t i = 0; i < bundle_count; ++i) {
+        auto bundle = bundle_list[i];
+
+        // The bundle weight is not animated, so bundles with no
+        // weight are skipped on all frames.
+        if (!(bundle->getWeight() > 0)) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < time_count; ++j) {
+            const size_t index = (j * bundle_count) + i;
+            status = bundle->getPos(out_positions[(index * 3) + 0],
+                                    out_positions[(index * 3) + 1],
+                                    out_positions[(index * 3) + 2], times[j],
+                                    timeEvalMode);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+            out_valid[index] = 1;
+        }
+    }
+    return status;
+}
+
 bool is_valid_pose(openMVG::geometry::Pose3 &pose) {
     const auto center = pose.center();
     const auto pos = pose.translation();
@@ -572,5 +910,23 @@ MTransformationMatrix convert_pose_to_maya_transform_matrix(
                                                               pose_rotation);
 }
 
+openMVG::Mat34 convert_maya_camera_matrix_to_camera_matrix(
+    const MMatrix &world_matrix) {
+    // Maya matrices transform row vectors, so the transpose of the
+    // inverse world matrix transforms (column vector) world space
+    // points into Maya camera space. The Maya camera looks down -Z,
+    // so the camera Z axis is negated.
+    const MMatrix inverse_matrix = world_matrix.inverse();
+    openMVG::Mat34 camera_matrix;
+    for (int i = 0; i < 3; ++i) {
+        const double sign = (i == 2) ? -1.0 : 1.0;
+        for (int j = 0; j < 3; ++j) {
+            camera_matrix(i, j) = sign * inverse_matrix(j, i);
+        }
+        camera_matrix(i, 3) = sign * inverse_matrix(3, i);
+    }
+    return camera_matrix;
+}
+
 }  // namespace sfm
 }  // namespace mmsolver
@@ -33,6 +33,7 @@
 #ifdef MMSOLVER_USE_OPENMVG
 
 #include <openMVG/geometry/pose3.hpp>
+#include <openMVG/numeric/eigen_alias_definition.hpp>
 #include <openMVG/types.hpp>
 
 #endif  // MMSOLVER_USE_OPENMVG
@@ -44,6 +45,7 @@
 #include <maya/MDGModifier.h>
 #include <maya/MGlobal.h>
 #include <maya/MIOStream.h>
+#include <maya/MMatrix.h>
 #include <maya/MPxCommand.h>
 #include <maya/MSelectionList.h>
 #include <maya/MSyntax.h>
@@ -58,6 +60,7 @@
 #include "mmSolver/mayahelper/maya_camera.h"
 #include "mmSolver/mayahelper/maya_marker.h"
 #include "mmSolver/mayahelper/maya_utils.h"
+#include "mmSolver/sfm/marker_tracks.h"
 
 namespace mmsolver {
 namespace sfm {
@@ -127,11 +130,59 @@ bool add_bundle_at_frame(
     const MTime &time, BundlePtr &bundle,
     std::vector<std::tuple<double, double, double>> &bundle_coords);
 
+// Read the (lens undistorted) pixel positions of all markers in
+// 'marker_list', and the camera values, at each of 'frames'.
+//
+// The attributes of each marker are read for all frames at once, and
+// the markers of each frame are undistorted together, once per lens
+// model.
+MStatus gather_marker_tracks(const std::vector<uint32_t> &frames,
+                             CameraPtr &camera, MarkerPtrList &marker_list,
+                             MarkerTracks &out_tracks);
+
+// Read the marker tracks from 'start_frame' to 'end_frame'
+// (inclusive).
+MStatus gather_marker_tracks(const uint32_t start_frame,
+                             const uint32_t end_frame, CameraPtr &camera,
+                             MarkerPtrList &marker_list,
+                             MarkerTracks &out_tracks);
+
+// Read the (lens undistorted) pixel positions of the marker pairs in
+// 'marker_list_a' (at 'frame_a' of 'camera_a') and 'marker_list_b'
+// (at 'frame_b' of 'camera_b'). Only the pairs valid on both frames
+// are added to 'marker_coords_a' and 'marker_coords_b';
+// 'out_pair_valid' has one value per pair.
+MStatus gather_marker_pairs(
+    const uint32_t frame_a, const uint32_t frame_b, CameraPtr &camera_a,
+    CameraPtr &camera_b, MarkerPtrList &marker_list_a,
+    MarkerPtrList &marker_list_b,
+    std::vector<std::pair<double, double>> &marker_coords_a,
+    std::vector<std::pair<double, double>> &marker_coords_b,
+    std::vector<uint8_t> &out_pair_valid);
+
+// Read the world space positions of all bundles in 'bundle_list' at
+// each of 'times'.
+//
+// Bundle 'b' at time index 't' is stored at index
+// '(t * bundle_count) + b'; 'out_positions' stores 3 values (X, Y and
+// Z) per bundle. Bundles with no weight are not valid.
+MStatus gather_bundle_positions(const MTimeArray &times,
+                                BundlePtrList &bundle_list,
+                                std::vector<double> &out_positions,
+                                std::vector<uint8_t> &out_valid);
+
 bool is_valid_pose(openMVG::geometry::Pose3 &pose);
 
 MTransformationMatrix convert_pose_to_maya_transform_matrix(
     openMVG::geometry::Pose3 &pose);
 
+// Convert a Maya camera world matrix into an [R|t] matrix that
+// transforms Maya world space points into a camera space looking
+// down +Z (as in OpenMVG). World space is not flipped, so points
+// computed with the matrix are Maya world space positions.
+openMVG::Mat34 convert_maya_camera_matrix_to_camera_matrix(
+    const MMatrix &world_matrix);
+
 }  // namespace sfm
 }  // namespace mmsolver
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include "test_parallel_ac_ransac.h"
+
+void print_help(const char* exec_file) {
+    std::cout << "Executable: " << exec_file << '\n'
+              << '\n'
+              << "Help:\n"
+              << "This command is used to test the Structure from Motion"
+              << " (sfm) component of mmSolver.\n"
+              << '\n'
+              << "Like this on Linux:\n"
+              << "$ mmsolver_sfm_tests\n"
+              << "...or on Windows: \n"
+              << "> mmsolver_sfm_tests.exe" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 0; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool is_help_flag = (std::strcmp(arg, "-h") == 0) ||
+                                  (std::strcmp(arg, "-help") == 0) ||
+                                  (std::strcmp(arg, "--help") == 0);
+        if (is_help_flag) {
+            print_help(argv[0]);
+            return 0;
+        }
+    }
+
+    // Verbosity level;
+    // - 0 == Minimal info is printed.
+    // - 1 == Standard info is printed.
+    // - 2 == All info is printed.
+    const int verbosity = 0;
+
+    // The multi-threaded AC-RANSAC must find the same inliers as
+    // 'openMVG::robust::ACRANSAC'.
+    const int status = test_parallel_ac_ransac(verbosity);
+    return status;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Test the multi-threaded AC-RANSAC driver finds the same inliers,
+ * with a similar NFA (Number of False Alarms), as
+ * 'openMVG::robust::ACRANSAC', and gives the same result for any
+ * number of threads.
+ */
+
+#include "test_parallel_ac_ransac.h"
+
+// Get M_PI constant
+#define _USE_MATH_DEFINES
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+// OpenMVG
+#include <openMVG/multiview/solver_homography_kernel.hpp>
+#include <openMVG/numeric/eigen_alias_definition.hpp>
+#include <openMVG/robust_estimation/robust_estimator_ACRansac.hpp>
+#include <openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp>
+
+// MM Solver
+#include "mmSolver/sfm/parallel_ac_ransac.h"
+
+namespace {
+
+using KernelType = openMVG::robust::ACKernelAdaptor<
+    openMVG::homography::kernel::FourPointSolver,
+    openMVG::homography::kernel::AsymmetricError, openMVG::UnnormalizerI,
+    openMVG::Mat3>;
+
+const size_t kImageWidth = 1920;
+const size_t kImageHeight = 1080;
+
+bool check(const char* test_name, const char* check_name,
+           const bool value) {
+    if (!value) {
+        std::cout << test_name << ": FAILED: " << check_name << std::endl;
+    }
+    return value;
+}
+
+// Points mapped by a known homography, with a little noise. Every
+// 'outlier_step' point is moved far away from the mapped position.
+void create_homography_points(const size_t point_count,
+                              const size_t outlier_step, openMVG::Mat& x1,
+                              openMVG::Mat& x2,
+                              std::vector<uint32_t>& expected_inliers) {
+    openMVG::Mat3 homography;
+    homography << 1.02, 0.03, 15.0, -0.02, 0.98, -10.0, 1.0e-5, 2.0e-5, 1.0;
+
+    // Fixed seed, so the test data is the same each run.
+    std::mt19937 random_generator(42);
+    std::uniform_real_distribution<double> x_distribution(
+        0.0, static_cast<double>(kImageWidth));
+    std::uniform_real_distribution<double> y_distribution(
+        0.0, static_cast<double>(kImageHeight));
+    std::uniform_real_distribution<double> noise_distribution(-0.1, 0.1);
+    std::uniform_real_distribution<double> angle_distribution(0.0,
+                                                              2.0 * M_PI);
+    std::uniform_real_distribution<double> offset_distribution(30.0, 300.0);
+
+    x1.resize(2, point_count);
+    x2.resize(2, point_count);
+    expected_inliers.clear();
+    for (size_t i = 0; i < point_count; ++i) {
+        const openMVG::Vec3 point(x_distribution(random_generator),
+                                  y_distribution(random_generator), 1.0);
+        const openMVG::Vec3 mapped = homography * point;
+        double x = mapped(0) / mapped(2);
+        double y = mapped(1) / mapped(2);
+        if ((i % outlier_step) == 0) {
+            const double angle = angle_distribution(random_generator);
+            const double offset = offset_distribution(random_generator);
+            x += std::cos(angle) * offset;
+            y += std::sin(angle) * offset;
+        } else {
+            x += noise_distribution(random_generator);
+            y += noise_distribution(random_generator);
+            expected_inliers.push_back(static_cast<uint32_t>(i));
+        }
+        x1.col(i) = point.head<2>();
+        x2.col(i) << x, y;
+    }
+}
+
+struct ACRansacResult {
+    std::vector<uint32_t> inliers;
+    openMVG::Mat3 model;
+    double error_max;
+    double nfa;
+
+    ACRansacResult()
+        : inliers()
+        , model(openMVG::Mat3::Zero())
+        , error_max(0.0)
+        , nfa(0.0) {}
+};
+
+ACRansacResult run_openmvg_ac_ransac(const KernelType& kernel,
+                                     const size_t max_iteration_count) {
+    ACRansacResult result;
+    const bool verbose = false;
+    const std::pair<double, double> output = openMVG::robust::ACRANSAC(
+        kernel, result.inliers,
+        static_cast<unsigned int>(max_iteration_count), &result.model,
+        std::numeric_limits<double>::infinity(), verbose);
+    result.error_max = output.first;
+    result.nfa = output.second;
+    return result;
+}
+
+ACRansacResult run_parallel_ac_ransac(const KernelType& kernel,
+                                      const size_t max_iteration_count,
+                                      const size_t thread_count) {
+    mmsolver::sfm::ParallelACRansacOptions options;
+    options.max_iteration_count = max_iteration_count;
+    options.thread_count = thread_count;
+
+    ACRansacResult result;
+    const std::pair<double, double> output =
+        mmsolver::sfm::parallel_ac_ransac(kernel, result.inliers, options,
+                                          &result.model);
+    result.error_max = output.first;
+    result.nfa = output.second;
+    return result;
+}
+
+// AC-RANSAC returns the inliers sorted by residual; compare them as
+// sets.
+bool is_same_inlier_set(std::vector<uint32_t> a, std::vector<uint32_t> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+bool is_same_result(const ACRansacResult& a, const ACRansacResult& b) {
+    return (a.inliers == b.inliers) && (a.model == b.model) &&
+           (a.error_max == b.error_max) && (a.nfa == b.nfa);
+}
+
+}  // namespace
+
+int test_parallel_ac_ransac(const int verbosity) {
+    const auto test_name = "test_parallel_ac_ransac";
+    std::cout << "Running... " << test_name << std::endl;
+
+    const size_t point_count = 200;
+    const size_t outlier_step = 3;
+    openMVG::Mat x1;
+    openMVG::Mat x2;
+    std::vector<uint32_t> expected_inliers;
+    create_homography_points(point_count, outlier_step, x1, x2,
+                             expected_inliers);
+
+    const bool point_to_line = false;
+    const KernelType kernel(x1, kImageWidth, kImageHeight, x2, kImageWidth,
+                            kImageHeight, point_to_line);
+
+    const size_t max_iteration_count = 1024;
+    const ACRansacResult expected =
+        run_openmvg_ac_ransac(kernel, max_iteration_count);
+
+    bool ok = true;
+    ok &= check(test_name, "ACRANSAC inliers",
+                is_same_inlier_set(expected.inliers, expected_inliers));
+
+    // One thread uses 'openMVG::robust::ACRANSAC' itself.
+    const ACRansacResult one_thread =
+        run_parallel_ac_ransac(kernel, max_iteration_count, 1);
+    ok &= check(test_name, "one thread", is_same_result(one_thread, expected));
+
+    // Many threads find the same inliers, and a model that is (at
+    // least about) as meaningful.
+    const ACRansacResult many_threads =
+        run_parallel_ac_ransac(kernel, max_iteration_count, 4);
+    ok &= check(test_name, "many threads inliers",
+                is_same_inlier_set(many_threads.inliers, expected.inliers));
+    ok &= check(test_name, "many threads NFA",
+                (many_threads.nfa < 0.0) &&
+                    (many_threads.nfa <= (expected.nfa * 0.95)));
+
+    // The result does not depend on the number of threads.
+    for (const size_t thread_count : {2, 8}) {
+        const ACRansacResult result =
+            run_parallel_ac_ransac(kernel, max_iteration_count, thread_count);
+        ok &= check(test_name, "thread count",
+                    is_same_result(result, many_threads));
+    }
+
+    if (verbosity >= 1) {
+        std::cout << test_name << ": ACRANSAC inliers="
+                  << expected.inliers.size() << " nfa=" << expected.nfa
+                  << " error_max=" << expected.error_max << std::endl;
+        std::cout << test_name
+                  << ": parallel inliers=" << many_threads.inliers.size()
+                  << " nfa=" << many_threads.nfa
+                  << " error_max=" << many_threads.error_max << std::endl;
+    }
+
+    std::cout << test_name << ": " << (ok ? "passed" : "failed")
+              << std::endl;
+    return ok ? 0 : 1;
+}
@@ -26,8 +26,10 @@
 #include <maya/MDistance.h>
 #include <maya/MEventMessage.h>
 #include <maya/MFnDependencyNode.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
+#include <maya/MProfiler.h>
 #include <maya/MString.h>
 #include <maya/MTransformationMatrix.h>
 
@@ -40,10 +42,40 @@
 // MM Solver
 #include "BundleConstants.h"
 #include "ShapeConstants.h"
+#include "ShapeDrawUtils.h"
+#include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 
 namespace mmsolver {
 
+namespace {
+
+// The bundle icon shape is constant, so it is only built once and
+// shared by all bundles.
+struct BundleShapeGeometry {
+    MPointArray cross_line_list;
+    MUintArray cross_line_index_list;
+
+    BundleShapeGeometry() {
+        for (int i = 0; i < cross_shape_points_count; i++) {
+            cross_line_list.append(cross_shape_points[i][0],
+                                   cross_shape_points[i][1],
+                                   cross_shape_points[i][2]);
+        }
+        for (int i = 0; i < cross_shape_line_indexes_count; i++) {
+            cross_line_index_list.append(cross_shape_line_indexes[i][0]);
+            cross_line_index_list.append(cross_shape_line_indexes[i][1]);
+        }
+    }
+};
+
+const BundleShapeGeometry &get_bundle_shape_geometry() {
+    static const BundleShapeGeometry geometry;
+    return geometry;
+}
+
+}  // namespace
+
 // By setting isAlwaysDirty to false in MPxDrawOverride constructor,
 // the draw override will be updated (via prepareForDraw()) only when
 // the node is marked dirty via DG evaluation or dirty
@@ -55,7 +87,9 @@ namespace mmsolver {
 BundleDrawOverride::BundleDrawOverride(const MObject &obj)
     : MHWRender::MPxDrawOverride(obj,
                                  /*callback=*/nullptr,
-                                 /*isAlwaysDirty=*/true) {
+                                 /*isAlwaysDirty=*/true)
+    , m_attr_version(1)
+    , m_attribute_changed_callback_id(0) {
     m_model_editor_changed_callback_id = MEventMessage::addEventCallback(
         "modelEditorChanged", on_model_editor_changed_func, this);
 
@@ -63,6 +97,11 @@ BundleDrawOverride::BundleDrawOverride(const MObject &obj)
     MFnDependencyNode node(obj, &status);
     m_node =
         status ? dynamic_cast<BundleShapeNode *>(node.userNode()) : nullptr;
+
+    MObject node_obj(obj);
+    m_attribute_changed_callback_id = MNodeMessage::addAttributeChangedCallback(
+        node_obj, on_attribute_changed_func, this, &status);
+    CHECK_MSTATUS(status);
 }
 
 BundleDrawOverride::~BundleDrawOverride() {
@@ -72,6 +111,11 @@ BundleDrawOverride::~BundleDrawOverride() {
         MMessage::removeCallback(m_model_editor_changed_callback_id);
         m_model_editor_changed_callback_id = 0;
     }
+
+    if (m_attribute_changed_callback_id != 0) {
+        MMessage::removeCallback(m_attribute_changed_callback_id);
+        m_attribute_changed_callback_id = 0;
+    }
 }
 
 void BundleDrawOverride::on_model_editor_changed_func(void *clientData) {
@@ -83,6 +127,18 @@ void BundleDrawOverride::on_model_editor_changed_func(void *clientData) {
     }
 }
 
+void BundleDrawOverride::on_attribute_changed_func(
+    MNodeMessage::AttributeMessage msg, MPlug & /*plug*/,
+    MPlug & /*otherPlug*/, void *clientData) {
+    const bool changed = (msg & MNodeMessage::kAttributeSet) ||
+                         (msg & MNodeMessage::kConnectionMade) ||
+                         (msg & MNodeMessage::kConnectionBroken);
+    BundleDrawOverride *ovr = static_cast<BundleDrawOverride *>(clientData);
+    if (ovr && changed) {
+        ++ovr->m_attr_version;
+    }
+}
+
 MHWRender::DrawAPI BundleDrawOverride::supportedDrawAPIs() const {
     return (MHWRender::kOpenGL | MHWRender::kDirectX11 |
             MHWRender::kOpenGLCoreProfile);
@@ -111,6 +167,12 @@ MBoundingBox BundleDrawOverride::boundingBox(
 MUserData *BundleDrawOverride::prepareForDraw(
     const MDagPath &objPath, const MDagPath & /*cameraPath*/,
     const MHWRender::MFrameContext &frameContext, MUserData *oldData) {
+#ifdef MAYA_PROFILE
+    MProfilingScope profilingScope(getDrawProfileCategory(),
+                                   MProfiler::kColorE_L2,
+                                   "BundleDrawOverride::prepareForDraw");
+#endif
+
     BundleDrawData *data = dynamic_cast<BundleDrawData *>(oldData);
     if (!data) {
         data = new BundleDrawData();
@@ -123,47 +185,49 @@ MUserData *BundleDrawOverride::prepareForDraw(
     MFnDependencyNode dependNodeFn(transformObj);
     data->m_name = dependNodeFn.name();
 
+    // The attributes are only read when they have changed, or when
+    // they are connected (animated) and may change at any time.
+    if ((data->m_attr_version != m_attr_version) || data->m_attrs_connected) {
+        MColor user_color(0.0f, 0.0f, 0.0f, 0.0f);
+        status = getNodeAttr(objPath, BundleShapeNode::m_color, user_color);
+        CHECK_MSTATUS(status);
+        status = getNodeAttr(objPath, BundleShapeNode::m_alpha, user_color[3]);
+        CHECK_MSTATUS(status);
+        data->m_user_color = user_color;
+
+        status = getNodeAttr(objPath, BundleShapeNode::m_icon_size,
+                             data->m_icon_size_attr);
+        CHECK_MSTATUS(status);
+        status = getNodeAttr(objPath, BundleShapeNode::m_line_width,
+                             data->m_line_width);
+        CHECK_MSTATUS(status);
+        status = getNodeAttr(objPath, BundleShapeNode::m_point_size,
+                             data->m_point_size);
+        CHECK_MSTATUS(status);
+        status = getNodeAttr(objPath, BundleShapeNode::m_draw_name,
+                             data->m_draw_name);
+        CHECK_MSTATUS(status);
+        status = getNodeAttr(objPath, BundleShapeNode::m_draw_on_top,
+                             data->m_draw_on_top);
+        CHECK_MSTATUS(status);
+
+        const MObject attrs[] = {
+            BundleShapeNode::m_color,      BundleShapeNode::m_alpha,
+            BundleShapeNode::m_icon_size,  BundleShapeNode::m_line_width,
+            BundleShapeNode::m_point_size, BundleShapeNode::m_draw_name,
+            BundleShapeNode::m_draw_on_top};
+        data->m_attrs_connected = anyAttrIsConnected(
+            objPath.node(), attrs, sizeof(attrs) / sizeof(attrs[0]));
+        data->m_attr_version = m_attr_version;
+    }
+
     MDoubleArray pixel_size_array =
         frameContext.getTuple(MFrameContext::kViewportPixelSize, &status);
     CHECK_MSTATUS(status);
     double pixel_size_x = 1.0 / pixel_size_array[0];
+    data->m_icon_size = data->m_icon_size_attr * pixel_size_x;
 
-    double icon_size = 0.0;
-    status = getNodeAttr(objPath, BundleShapeNode::m_icon_size, icon_size);
-    data->m_icon_size = icon_size * pixel_size_x;
-
-    MColor user_color(0.0f, 0.0f, 0.0f, 0.0f);
-    status = getNodeAttr(objPath, BundleShapeNode::m_color, user_color);
-    CHECK_MSTATUS(status);
-    status = getNodeAttr(objPath, BundleShapeNode::m_alpha, user_color[3]);
-    CHECK_MSTATUS(status);
-    status =
-        getNodeAttr(objPath, BundleShapeNode::m_line_width, data->m_line_width);
-    CHECK_MSTATUS(status);
-    status =
-        getNodeAttr(objPath, BundleShapeNode::m_point_size, data->m_point_size);
-    CHECK_MSTATUS(status);
-    status =
-        getNodeAttr(objPath, BundleShapeNode::m_draw_name, data->m_draw_name);
-    CHECK_MSTATUS(status);
-    status = getNodeAttr(objPath, BundleShapeNode::m_draw_on_top,
-                         data->m_draw_on_top);
-    CHECK_MSTATUS(status);
-
-    // The cross icon
-    data->m_cross_line_list.clear();
-    for (int i = 0; i < cross_shape_points_count; i++) {
-        data->m_cross_line_list.append(cross_shape_points[i][0],
-                                       cross_shape_points[i][1],
-                                       cross_shape_points[i][2]);
-    }
-
-    data->m_cross_line_index_list.clear();
-    for (int i = 0; i < cross_shape_line_indexes_count; i++) {
-        data->m_cross_line_index_list.append(cross_shape_line_indexes[i][0]);
-        data->m_cross_line_index_list.append(cross_shape_line_indexes[i][1]);
-    }
-
+    MColor user_color = data->m_user_color;
     float hue = 0.0;
     float sat = 0.0;
     float val = 0.0;
@@ -198,6 +262,12 @@ void BundleDrawOverride::addUIDrawables(
     const MDagPath &objPath, MHWRender::MUIDrawManager &drawManager,
     const MHWRender::MFrameContext &frameContext, const MUserData *userData) {
     MStatus status;
+#ifdef MAYA_PROFILE
+    MProfilingScope profilingScope(getDrawProfileCategory(),
+                                   MProfiler::kColorE_L3,
+                                   "BundleDrawOverride::addUIDrawables");
+#endif
+
     BundleDrawData *data = (BundleDrawData *)userData;
     if (!data) {
         return;
@@ -227,9 +297,10 @@ void BundleDrawOverride::addUIDrawables(
     MPoint origin(0.0, 0.0, 0.0);
     origin *= matrix;
     double scale = camera_pos.distanceTo(origin) * data->m_icon_size;
-    MPointArray cross_line_list(data->m_cross_line_list.length());
-    for (uint32_t i = 0; i < data->m_cross_line_list.length(); i++) {
-        MPoint orig = data->m_cross_line_list[i];
+    const BundleShapeGeometry &geometry = get_bundle_shape_geometry();
+    MPointArray cross_line_list(geometry.cross_line_list.length());
+    for (uint32_t i = 0; i < geometry.cross_line_list.length(); i++) {
+        MPoint orig = geometry.cross_line_list[i];
         MPoint pnt = MPoint(orig.x * scale, orig.y * scale, orig.z * scale);
         cross_line_list.set(pnt * obj_matrix, i);
     }
@@ -258,7 +329,7 @@ void BundleDrawOverride::addUIDrawables(
 
     // Draw cross
     drawManager.mesh(MHWRender::MUIDrawManager::kLines, cross_line_list,
-                     nullptr, nullptr, &data->m_cross_line_index_list);
+                     nullptr, nullptr, &geometry.cross_line_index_list);
 
     if (data->m_draw_on_top) {
         drawManager.endDrawInXray();
@@ -24,10 +24,15 @@
 
 #include "BundleShapeNode.h"
 
+// STL
+#include <cstdint>
+
 // Maya
 #include <maya/MColor.h>
 #include <maya/MEventMessage.h>
 #include <maya/MGlobal.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MPointArray.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
@@ -45,31 +50,45 @@
 
 namespace mmsolver {
 
+// The draw data is kept between draws (and given back to
+// 'prepareForDraw' as 'oldData'), so the node attribute values are
+// only read again when the node's attribute version changes.
 class BundleDrawData : public MUserData {
 public:
     BundleDrawData()
-        : MUserData(/*deleteAfterUse=*/true)  // let Maya clean up
-        , m_depth_priority(0)
-        , m_line_width(1.0)
+        : MUserData(/*deleteAfterUse=*/false)
+        , m_attr_version(0)
+        , m_attrs_connected(false)
         , m_point_size(1.0)
-        , m_icon_size(1.0)
+        , m_line_width(1.0)
+        , m_icon_size_attr(1.0)
+        , m_draw_on_top(false)
+        , m_draw_name(false)
         , m_active(false)
-        , m_draw_name(false) {}
+        , m_icon_size(1.0)
+        , m_depth_priority(0) {}
 
     ~BundleDrawData() override {}
 
-    MString m_name;
-    bool m_active;
+    // The attribute version of the override that the cached attribute
+    // values were read at.
+    uint64_t m_attr_version;
+    bool m_attrs_connected;
+
+    // Cached attribute values.
     double m_point_size;
     double m_line_width;
-    double m_icon_size;
-    MColor m_color{1.0f, 0.0f, 0.0f, 1.0f};
+    double m_icon_size_attr;
+    MColor m_user_color{1.0f, 0.0f, 0.0f, 1.0f};
     bool m_draw_on_top;
     bool m_draw_name;
-    unsigned int m_depth_priority;
 
-    MPointArray m_cross_line_list;
-    MUintArray m_cross_line_index_list;
+    // Computed for each draw.
+    MString m_name;
+    bool m_active;
+    double m_icon_size;
+    MColor m_color{1.0f, 0.0f, 0.0f, 1.0f};
+    unsigned int m_depth_priority;
 };
 
 class BundleDrawOverride : public MHWRender::MPxDrawOverride {
@@ -115,8 +134,17 @@ private:
 
     static void on_model_editor_changed_func(void *clientData);
 
+    static void on_attribute_changed_func(MNodeMessage::AttributeMessage msg,
+                                          MPlug &plug, MPlug &otherPlug,
+                                          void *clientData);
+
     BundleShapeNode *m_node;
     MCallbackId m_model_editor_changed_callback_id;
+
+    // Incremented each time an attribute of the shape node is set,
+    // connected or disconnected.
+    uint64_t m_attr_version;
+    MCallbackId m_attribute_changed_callback_id;
 };
 
 }  // namespace mmsolver
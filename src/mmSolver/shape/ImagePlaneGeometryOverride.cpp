@@ -25,15 +25,27 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+// STL
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
 // Maya
+#include <maya/M3dView.h>
+#include <maya/MBoundingBox.h>
 #include <maya/MColor.h>
 #include <maya/MDistance.h>
 #include <maya/MEventMessage.h>
+#include <maya/MFnDagNode.h>
 #include <maya/MFnDependencyNode.h>
+#include <maya/MMatrix.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 #include <maya/MPoint.h>
+#include <maya/MProfiler.h>
 #include <maya/MString.h>
 
 // Maya Viewport 2.0
@@ -41,9 +53,13 @@
 #include <maya/MGeometryExtractor.h>
 #include <maya/MPxGeometryOverride.h>
 #include <maya/MShaderManager.h>
+#include <maya/MStateManager.h>
+#include <maya/MTextureManager.h>
 #include <maya/MUserData.h>
 
 // MM Solver
+#include "ShapeDrawUtils.h"
+#include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/utilities/number_utils.h"
 
@@ -60,9 +76,18 @@ ImagePlaneGeometryOverride::ImagePlaneGeometryOverride(const MObject &obj)
     , m_draw_hud(false)
     , m_draw_image_size(false)
     , m_draw_camera_size(false)
-    , m_geometry_node_type(MFn::kInvalid) {
+    , m_geometry_node_type(MFn::kInvalid)
+    , m_use_image_cache(false)
+    , m_image_width(0.0)
+    , m_screen_proxy_level(0)
+    , m_proxy_level_max(0)
+    , m_texture(nullptr)
+    , m_texture_shader(nullptr)
+    , m_texture_sampler(nullptr) {
     m_model_editor_changed_callback_id = MEventMessage::addEventCallback(
         "modelEditorChanged", on_model_editor_changed_func, this);
+    m_time_changed_callback_id = MEventMessage::addEventCallback(
+        "timeChanged", on_time_changed_func, this);
 }
 
 ImagePlaneGeometryOverride::~ImagePlaneGeometryOverride() {
@@ -70,6 +95,11 @@ ImagePlaneGeometryOverride::~ImagePlaneGeometryOverride() {
         MMessage::removeCallback(m_model_editor_changed_callback_id);
         m_model_editor_changed_callback_id = 0;
     }
+    if (m_time_changed_callback_id != 0) {
+        MMessage::removeCallback(m_time_changed_callback_id);
+        m_time_changed_callback_id = 0;
+    }
+    release_texture();
 }
 
 void ImagePlaneGeometryOverride::on_model_editor_changed_func(
@@ -83,6 +113,16 @@ void ImagePlaneGeometryOverride::on_model_editor_changed_func(
     }
 }
 
+void ImagePlaneGeometryOverride::on_time_changed_func(void *clientData) {
+    // The image cache is not part of the DG, so the node is marked
+    // dirty to make sure the image for the new frame is drawn.
+    ImagePlaneGeometryOverride *ovr =
+        static_cast<ImagePlaneGeometryOverride *>(clientData);
+    if (ovr && ovr->m_use_image_cache && !ovr->m_this_node.isNull()) {
+        MHWRender::MRenderer::setGeometryDrawDirty(ovr->m_this_node);
+    }
+}
+
 MHWRender::DrawAPI ImagePlaneGeometryOverride::supportedDrawAPIs() const {
     return (MHWRender::kOpenGL | MHWRender::kDirectX11 |
             MHWRender::kOpenGLCoreProfile);
@@ -128,35 +168,47 @@ bool getUpstreamNodeFromConnection(const MObject &this_node,
 
 void ImagePlaneGeometryOverride::updateDG() {
     const auto verbose = false;
-    if (!m_geometry_node_path.isValid()) {
-        MString attr_name = "geometryNode";
-        MPlugArray connections;
-        bool ok =
-            getUpstreamNodeFromConnection(m_this_node, attr_name, connections);
-
-        if (ok) {
-            for (uint32_t i = 0; i < connections.length(); ++i) {
-                MObject node = connections[i].node();
+    // The connected geometry node is checked on every update, so a
+    // different mesh connected to the image plane is used straight
+    // away.
+    if (m_geometry_node_plug.isNull()) {
+        m_geometry_node_plug =
+            MPlug(m_this_node, ImagePlaneShapeNode::m_geometry_node);
+    }
+    MObject geometry_node;
+    if (!m_geometry_node_plug.isNull()) {
+        MPlug source_plug = m_geometry_node_plug.source();
+        if (!source_plug.isNull()) {
+            geometry_node = source_plug.node();
+        }
+    }
+    if (geometry_node != m_geometry_node) {
+        m_geometry_node = geometry_node;
+        m_geometry_node_path = MDagPath();
+        m_geometry_node_type = MFn::kInvalid;
+        m_geometry_in_mesh_plug = MPlug();
+
+        if (geometry_node.hasFn(MFn::kMesh)) {
+            MDagPath path;
+            MDagPath::getAPathTo(geometry_node, path);
+            m_geometry_node_path = path;
+            m_geometry_node_type = path.apiType();
 
-                if (node.hasFn(MFn::kMesh)) {
-                    MDagPath path;
-                    MDagPath::getAPathTo(node, path);
-                    m_geometry_node_path = path;
-                    m_geometry_node_type = path.apiType();
-                    MMSOLVER_MAYA_VRB(
-                        "Validated geometry node: "
-                        << " path="
-                        << m_geometry_node_path.fullPathName().asChar()
-                        << " type=" << node.apiTypeStr());
-                    break;
-                } else {
-                    MMSOLVER_MAYA_WRN(
-                        "Geometry node is not correct type:"
-                        << " path="
-                        << m_geometry_node_path.fullPathName().asChar()
-                        << " type=" << node.apiTypeStr());
-                }
-            }
+            MStatus status;
+            MFnDependencyNode mfn_depend_node(geometry_node);
+            const bool wantNetworkedPlug = true;
+            m_geometry_in_mesh_plug =
+                mfn_depend_node.findPlug("inMesh", wantNetworkedPlug, &status);
+            CHECK_MSTATUS(status);
+            MMSOLVER_MAYA_VRB("Validated geometry node: "
+                              << " path="
+                              << m_geometry_node_path.fullPathName().asChar()
+                              << " type=" << geometry_node.apiTypeStr());
+        } else if (!geometry_node.isNull()) {
+            MFnDependencyNode mfn_depend_node(geometry_node);
+            MMSOLVER_MAYA_WRN("Geometry node is not correct type:"
+                              << " name=" << mfn_depend_node.name().asChar()
+                              << " type=" << geometry_node.apiTypeStr());
         }
     }
 
@@ -344,10 +396,350 @@ void ImagePlaneGeometryOverride::updateDG() {
                                 MString("mm x ") + height_string +
                                 MString("mm | ") + aspect_string;
             }
+
+            update_image_cache(objPath);
+            update_mesh_key(objPath);
         }
     }
 }
 
+// Read the image for the current frame from the image cache, and
+// ask for the surrounding frames to be read in the background.
+void ImagePlaneGeometryOverride::update_image_cache(const MDagPath &objPath) {
+    MStatus status;
+
+    m_use_image_cache = false;
+    status = getNodeAttr(objPath, ImagePlaneShapeNode::m_use_image_cache,
+                         m_use_image_cache);
+    CHECK_MSTATUS(status);
+    if (!m_use_image_cache) {
+        m_image.reset();
+        return;
+    }
+
+    MString file_pattern;
+    double image_frame = 0.0;
+    int32_t frames_behind = 0;
+    int32_t frames_ahead = 0;
+    int32_t proxy_level_max = 0;
+
+    status = getNodeAttr(objPath, ImagePlaneShapeNode::m_image_file_path,
+                         file_pattern);
+    CHECK_MSTATUS(status);
+
+    status =
+        getNodeAttr(objPath, ImagePlaneShapeNode::m_image_frame, image_frame);
+    CHECK_MSTATUS(status);
+
+    status = getNodeAttr(objPath,
+                         ImagePlaneShapeNode::m_image_cache_frames_behind,
+                         frames_behind);
+    CHECK_MSTATUS(status);
+
+    status = getNodeAttr(objPath,
+                         ImagePlaneShapeNode::m_image_cache_frames_ahead,
+                         frames_ahead);
+    CHECK_MSTATUS(status);
+
+    status = getNodeAttr(objPath,
+                         ImagePlaneShapeNode::m_image_cache_proxy_level_max,
+                         proxy_level_max);
+    CHECK_MSTATUS(status);
+    m_proxy_level_max =
+        static_cast<uint8_t>(std::max(0, std::min(proxy_level_max, 8)));
+
+    status =
+        getNodeAttr(objPath, ImagePlaneShapeNode::m_image_width, m_image_width);
+    CHECK_MSTATUS(status);
+
+    if (file_pattern.length() == 0) {
+        m_image.reset();
+        return;
+    }
+
+    update_screen_proxy_level();
+
+    const auto frame = static_cast<int32_t>(std::lround(image_frame));
+
+    const std::string pattern(file_pattern.asChar());
+    const std::string file_path =
+        image::image_sequence_file_path(pattern, frame);
+
+    // Frames ahead are requested before frames behind, because
+    // playback and scrubbing forwards is most common.
+    std::vector<std::string> file_paths;
+    file_paths.push_back(file_path);
+    if (file_path != pattern) {
+        for (int32_t i = 1; i <= frames_ahead; ++i) {
+            file_paths.push_back(
+                image::image_sequence_file_path(pattern, frame + i));
+        }
+        for (int32_t i = 1; i <= frames_behind; ++i) {
+            file_paths.push_back(
+                image::image_sequence_file_path(pattern, frame - i));
+        }
+    }
+    const uint8_t proxy_level =
+        std::min(m_screen_proxy_level, m_proxy_level_max);
+    image::image_cache_prefetch(file_paths, proxy_level);
+
+    m_image = image::image_cache_get(file_path, proxy_level);
+}
+
+// The values that change the shape of the (lens distorted) image
+// plane mesh.
+void ImagePlaneGeometryOverride::update_mesh_key(const MDagPath &objPath) {
+    MStatus status;
+
+    MObject node = objPath.node(&status);
+    CHECK_MSTATUS(status);
+
+    m_mesh_key.geometry_node = MObjectHandle(m_geometry_node);
+    MObject upstream_node;
+    if (!m_geometry_in_mesh_plug.isNull()) {
+        MPlug source_plug = m_geometry_in_mesh_plug.source();
+        if (!source_plug.isNull()) {
+            upstream_node = source_plug.node();
+        }
+    }
+    m_mesh_key.geometry_upstream_node = MObjectHandle(upstream_node);
+
+    MPlug lens_hash_plug(node, ImagePlaneShapeNode::m_lens_hash_current);
+    m_mesh_key.lens_hash = lens_hash_plug.asInt64();
+
+    status = getNodeAttr(objPath, ImagePlaneShapeNode::m_camera_width_inch,
+                         m_mesh_key.film_back_width);
+    CHECK_MSTATUS(status);
+
+    status = getNodeAttr(objPath, ImagePlaneShapeNode::m_camera_height_inch,
+                         m_mesh_key.film_back_height);
+    CHECK_MSTATUS(status);
+
+    // 'meshResolution' is a dynamic attribute, added when the image
+    // plane is created.
+    if (m_mesh_resolution_plug.isNull()) {
+        MFnDependencyNode mfn_depend_node(node);
+        const bool wantNetworkedPlug = true;
+        m_mesh_resolution_plug = mfn_depend_node.findPlug(
+            "meshResolution", wantNetworkedPlug, &status);
+    }
+    m_mesh_key.mesh_resolution = 0;
+    if (!m_mesh_resolution_plug.isNull()) {
+        m_mesh_key.mesh_resolution = m_mesh_resolution_plug.asInt();
+    }
+}
+
+// Choose the proxy level from the width of the image plane in the
+// viewports, so that (roughly) one image pixel is read per screen
+// pixel.
+//
+// The image plane may be visible in many viewports at different
+// sizes, but only one image is read, so the level is computed once
+// (here, outside of the draw) for the viewport showing the image
+// plane the largest; the lowest proxy level of all viewports.
+void ImagePlaneGeometryOverride::update_screen_proxy_level() {
+    if (!m_use_image_cache || (m_proxy_level_max == 0) ||
+        !m_geometry_node_path.isValid() || (m_image_width <= 0.0)) {
+        return;
+    }
+
+    MStatus status;
+    MFnDagNode mfn_dag_node(m_geometry_node_path, &status);
+    if (status != MS::kSuccess) {
+        return;
+    }
+    const MBoundingBox bounding_box = mfn_dag_node.boundingBox();
+    const MMatrix world_matrix = m_geometry_node_path.inclusiveMatrix();
+    const MPoint min_point = bounding_box.min();
+    const MPoint max_point = bounding_box.max();
+
+    // The widest the image plane is drawn in any viewport, in
+    // pixels.
+    double max_screen_width = 0.0;
+    const uint32_t view_count = M3dView::numberOf3dViews();
+    for (uint32_t view_index = 0; view_index < view_count; ++view_index) {
+        M3dView view;
+        status = M3dView::get3dView(view_index, view);
+        if ((status != MS::kSuccess) || !view.isVisible()) {
+            continue;
+        }
+
+        MMatrix model_view_matrix;
+        MMatrix projection_matrix;
+        status = view.modelViewMatrix(model_view_matrix);
+        if (status != MS::kSuccess) {
+            continue;
+        }
+        status = view.projectionMatrix(projection_matrix);
+        if (status != MS::kSuccess) {
+            continue;
+        }
+        const MMatrix matrix =
+            world_matrix * model_view_matrix * projection_matrix;
+
+        bool in_front_of_camera = true;
+        double ndc_min_x = std::numeric_limits<double>::max();
+        double ndc_max_x = std::numeric_limits<double>::lowest();
+        for (uint32_t i = 0; i < 8; ++i) {
+            const MPoint corner((i & 1) ? max_point.x : min_point.x,
+                                (i & 2) ? max_point.y : min_point.y,
+                                (i & 4) ? max_point.z : min_point.z);
+            const MPoint clip_point = corner * matrix;
+            if (clip_point.w <= 0.0) {
+                in_front_of_camera = false;
+                break;
+            }
+            const double ndc_x = clip_point.x / clip_point.w;
+            ndc_min_x = std::min(ndc_min_x, ndc_x);
+            ndc_max_x = std::max(ndc_max_x, ndc_x);
+        }
+        if (!in_front_of_camera) {
+            continue;
+        }
+
+        // Normalized device coordinates are -1.0 to 1.0 across the
+        // viewport.
+        const double screen_width =
+            (ndc_max_x - ndc_min_x) * 0.5 * view.portWidth();
+        max_screen_width = std::max(max_screen_width, screen_width);
+    }
+
+    // Keep the previous level when the image plane is not visible in
+    // any viewport.
+    if (max_screen_width < 1.0) {
+        return;
+    }
+
+    uint8_t screen_proxy_level = 0;
+    const double image_to_screen_ratio = m_image_width / max_screen_width;
+    if (image_to_screen_ratio >= 2.0) {
+        const double level = std::floor(std::log2(image_to_screen_ratio));
+        screen_proxy_level = static_cast<uint8_t>(std::min(level, 8.0));
+    }
+    m_screen_proxy_level = screen_proxy_level;
+}
+
+// Upload the current image into the texture, re-using the texture
+// when the image size and format does not change.
+bool ImagePlaneGeometryOverride::update_texture(
+    MHWRender::MRenderer *renderer) {
+    if (!m_image) {
+        return false;
+    }
+    if (m_texture && (m_image == m_texture_image)) {
+        return true;
+    }
+
+    MHWRender::MTextureManager *texture_manager =
+        renderer->getTextureManager();
+    if (!texture_manager) {
+        MMSOLVER_MAYA_WRN("mmImagePlaneShape: Could not get MTextureManager.");
+        return false;
+    }
+
+    MHWRender::MRasterFormat raster_format = MHWRender::kR8G8B8A8_UNORM;
+    uint32_t pixel_byte_count = 0;
+    switch (m_image->data_type) {
+        case mmimage::BufferDataType::kF16:
+            raster_format = MHWRender::kR16G16B16A16_FLOAT;
+            pixel_byte_count = 4 * sizeof(uint16_t);
+            break;
+        case mmimage::BufferDataType::kF32:
+            raster_format = MHWRender::kR32G32B32A32_FLOAT;
+            pixel_byte_count = 4 * sizeof(float);
+            break;
+        case mmimage::BufferDataType::kU8:
+            raster_format = MHWRender::kR8G8B8A8_UNORM;
+            pixel_byte_count = 4 * sizeof(uint8_t);
+            break;
+        default:
+            MMSOLVER_MAYA_WRN("mmImagePlaneShape: "
+                              << "Image pixel data type is not supported: "
+                              << m_image->file_path);
+            return false;
+    }
+
+    const auto width = static_cast<uint32_t>(m_image->width);
+    const auto height = static_cast<uint32_t>(m_image->height);
+
+    MHWRender::MTextureDescription texture_desc;
+    texture_desc.setToDefault2DTexture();
+    texture_desc.fWidth = width;
+    texture_desc.fHeight = height;
+    texture_desc.fDepth = 1;
+    texture_desc.fBytesPerRow = width * pixel_byte_count;
+    texture_desc.fBytesPerSlice = texture_desc.fBytesPerRow * height;
+    texture_desc.fMipmaps = 1;
+    texture_desc.fArraySlices = 1;
+    texture_desc.fFormat = raster_format;
+    texture_desc.fTextureType = MHWRender::kImage2D;
+    texture_desc.fEnvMapType = MHWRender::kEnvNone;
+
+    const void *pixel_data = image::cached_image_pixel_data(*m_image);
+    const bool generate_mipmaps = false;
+
+    bool reuse_texture = false;
+    if (m_texture) {
+        MHWRender::MTextureDescription current_desc;
+        m_texture->textureDescription(current_desc);
+        reuse_texture = (current_desc.fWidth == width) &&
+                        (current_desc.fHeight == height) &&
+                        (current_desc.fFormat == raster_format);
+    }
+
+    if (reuse_texture) {
+        MStatus status = m_texture->update(pixel_data, generate_mipmaps);
+        if (status != MS::kSuccess) {
+            CHECK_MSTATUS(status);
+            return false;
+        }
+    } else {
+        if (m_texture) {
+            texture_manager->releaseTexture(m_texture);
+            m_texture = nullptr;
+        }
+        // An empty name stops the texture manager from sharing the
+        // texture with other nodes.
+        m_texture = texture_manager->acquireTexture(
+            MString(""), texture_desc, pixel_data, generate_mipmaps);
+        if (!m_texture) {
+            MMSOLVER_MAYA_WRN("mmImagePlaneShape: "
+                              << "Could not create texture for image: "
+                              << m_image->file_path);
+            return false;
+        }
+    }
+
+    m_texture_image = m_image;
+    return true;
+}
+
+void ImagePlaneGeometryOverride::release_texture() {
+    MHWRender::MRenderer *renderer = MHWRender::MRenderer::theRenderer();
+    if (renderer) {
+        MHWRender::MTextureManager *texture_manager =
+            renderer->getTextureManager();
+        if (texture_manager && m_texture) {
+            texture_manager->releaseTexture(m_texture);
+        }
+
+        const MHWRender::MShaderManager *shader_manager =
+            renderer->getShaderManager();
+        if (shader_manager && m_texture_shader) {
+            shader_manager->releaseShader(m_texture_shader);
+        }
+    }
+
+    if (m_texture_sampler) {
+        MHWRender::MStateManager::releaseSamplerState(m_texture_sampler);
+    }
+
+    m_texture = nullptr;
+    m_texture_shader = nullptr;
+    m_texture_sampler = nullptr;
+    m_texture_image.reset();
+}
+
 void ImagePlaneGeometryOverride::updateRenderItems(const MDagPath &path,
                                                    MRenderItemList &list) {
     const bool verbose = false;
@@ -438,7 +830,31 @@ void ImagePlaneGeometryOverride::updateRenderItems(const MDagPath &path,
     if (shadedItem) {
         shadedItem->enable(m_visible);
 
-        if (!m_shader_node.isNull()) {
+        if (m_use_image_cache && update_texture(renderer)) {
+            if (!m_texture_shader) {
+                m_texture_shader = shaderManager->getStockShader(
+                    MShaderManager::k3dSolidTextureShader);
+            }
+            if (!m_texture_sampler) {
+                MHWRender::MSamplerStateDesc sampler_desc;
+                sampler_desc.filter =
+                    MHWRender::MSamplerState::kMinMagMipLinear;
+                sampler_desc.addressU = MHWRender::MSamplerState::kTexClamp;
+                sampler_desc.addressV = MHWRender::MSamplerState::kTexClamp;
+                m_texture_sampler =
+                    MHWRender::MStateManager::acquireSamplerState(sampler_desc);
+            }
+            if (m_texture_shader) {
+                MHWRender::MTextureAssignment texture_assignment;
+                texture_assignment.texture = m_texture;
+                m_texture_shader->setParameter("map", texture_assignment);
+                if (m_texture_sampler) {
+                    m_texture_shader->setParameter("textureSampler",
+                                                   *m_texture_sampler);
+                }
+                shadedItem->setShader(m_texture_shader);
+            }
+        } else if (!m_shader_node.isNull()) {
             // TODO: Implement callback to detect when the shader
             // needs to be re-compiled.
             auto linkLostCb = nullptr;
@@ -461,6 +877,11 @@ void ImagePlaneGeometryOverride::updateRenderItems(const MDagPath &path,
             }
         }
     }
+
+    // Free the GPU memory when the image cache is no longer used.
+    if (!m_use_image_cache && m_texture) {
+        release_texture();
+    }
 }
 
 void ImagePlaneGeometryOverride::populateGeometry(
@@ -473,6 +894,27 @@ void ImagePlaneGeometryOverride::populateGeometry(
         return;
     }
 
+#ifdef MAYA_PROFILE
+    MProfilingScope profilingScope(
+        getDrawProfileCategory(), MProfiler::kColorE_L2,
+        "ImagePlaneGeometryOverride::populateGeometry");
+#endif
+
+    // The mesh is only extracted (and deformed by the lens) when it
+    // has not been extracted before with the same lens, film back
+    // and mesh resolution.
+    ImagePlaneMeshDataPtr cached_mesh_data = m_mesh_cache.find(m_mesh_key);
+    if (cached_mesh_data &&
+        populate_geometry_from_cache(*cached_mesh_data, requirements,
+                                     renderItems, data)) {
+        ImagePlaneMeshCache::countHit();
+        MMSOLVER_MAYA_VRB("mmImagePlaneShape: Mesh cache hit.");
+        m_populated_mesh_key = m_mesh_key;
+        return;
+    }
+    ImagePlaneMeshCache::countMiss();
+    MMSOLVER_MAYA_VRB("mmImagePlaneShape: Mesh cache miss.");
+
     MStatus status;
 
     // kPolyGeom_Normal = Normal Indicates the polygon performs the
@@ -495,6 +937,11 @@ void ImagePlaneGeometryOverride::populateGeometry(
         return;
     }
 
+    // A copy of the extracted values, stored in the cache once all
+    // buffers are populated.
+    auto mesh_data = std::make_shared<ImagePlaneMeshData>();
+    mesh_data->vertex_count = extractor.vertexCount();
+
     const MVertexBufferDescriptorList &descList =
         requirements.vertexRequirements();
     for (int reqNum = 0; reqNum < descList.length(); ++reqNum) {
@@ -521,6 +968,17 @@ void ImagePlaneGeometryOverride::populateGeometry(
                     status =
                         extractor.populateVertexBuffer(data, vertexCount, desc);
                     if (status == MS::kFailure) return;
+
+                    ImagePlaneMeshVertexData vertex_data;
+                    vertex_data.semantic = desc_semantic;
+                    vertex_data.semantic_name = desc.semanticName();
+                    vertex_data.dimension =
+                        static_cast<uint32_t>(desc.dimension());
+                    vertex_data.values.assign(
+                        data, data + (vertexCount * vertex_data.dimension));
+                    mesh_data->vertex_buffers.push_back(
+                        std::move(vertex_data));
+
                     vertexBuffer->commit(data);
                 }
             }
@@ -553,6 +1011,10 @@ void ImagePlaneGeometryOverride::populateGeometry(
             if (status == MS::kFailure) {
                 return;
             }
+            mesh_data->has_triangles = true;
+            mesh_data->triangle_count = numTriangles;
+            mesh_data->triangle_indices.assign(indices,
+                                               indices + (3 * numTriangles));
             indexBuffer->commit(indices);
         } else if (item->primitive() == MGeometry::kLines) {
             MIndexBufferDescriptor edgeDesc(MIndexBufferDescriptor::kEdgeLine,
@@ -566,11 +1028,116 @@ void ImagePlaneGeometryOverride::populateGeometry(
             if (status == MS::kFailure) {
                 return;
             }
+            mesh_data->has_edges = true;
+            mesh_data->edge_count = numEdges;
+            mesh_data->edge_indices.assign(indices, indices + (2 * numEdges));
             indexBuffer->commit(indices);
         }
 
         item->associateWithIndexBuffer(indexBuffer);
     }
+
+    m_mesh_cache.insert(m_mesh_key, mesh_data);
+    m_populated_mesh_key = m_mesh_key;
+}
+
+// Fill the geometry buffers with the values previously extracted
+// from the mesh. Returns false if 'mesh_data' does not contain all of
+// the buffers required, without changing 'data'.
+bool ImagePlaneGeometryOverride::populate_geometry_from_cache(
+    const ImagePlaneMeshData &mesh_data,
+    const MGeometryRequirements &requirements,
+    const MRenderItemList &renderItems, MGeometry &data) {
+    const MVertexBufferDescriptorList &descList =
+        requirements.vertexRequirements();
+    std::vector<const ImagePlaneMeshVertexData *> vertex_buffers;
+    std::vector<MVertexBufferDescriptor> vertex_descs;
+    for (int reqNum = 0; reqNum < descList.length(); ++reqNum) {
+        MVertexBufferDescriptor desc;
+        if (!descList.getDescriptor(reqNum, desc)) {
+            continue;
+        }
+
+        auto desc_semantic = desc.semantic();
+        if ((desc_semantic == MGeometry::kPosition) ||
+            (desc_semantic == MGeometry::kNormal) ||
+            (desc_semantic == MGeometry::kTexture) ||
+            (desc_semantic == MGeometry::kTangent) ||
+            (desc_semantic == MGeometry::kBitangent) ||
+            (desc_semantic == MGeometry::kColor)) {
+            const ImagePlaneMeshVertexData *vertex_data =
+                mesh_data.findVertexData(
+                    desc_semantic, desc.semanticName(),
+                    static_cast<uint32_t>(desc.dimension()));
+            if (!vertex_data) {
+                return false;
+            }
+            vertex_buffers.push_back(vertex_data);
+            vertex_descs.push_back(desc);
+        }
+    }
+
+    for (int i = 0; i < renderItems.length(); ++i) {
+        const MRenderItem *item = renderItems.itemAt(i);
+        if (!item) {
+            continue;
+        }
+        if (((item->primitive() == MGeometry::kTriangles) &&
+             !mesh_data.has_triangles) ||
+            ((item->primitive() == MGeometry::kLines) &&
+             !mesh_data.has_edges)) {
+            return false;
+        }
+    }
+
+    const uint32_t vertexCount = mesh_data.vertex_count;
+    for (size_t i = 0; i < vertex_buffers.size(); ++i) {
+        MVertexBuffer *vertexBuffer = data.createVertexBuffer(vertex_descs[i]);
+        if (!vertexBuffer) {
+            continue;
+        }
+        bool writeOnly = true;  // We don't need the current buffer values.
+        float *values =
+            static_cast<float *>(vertexBuffer->acquire(vertexCount, writeOnly));
+        if (values) {
+            std::copy(vertex_buffers[i]->values.begin(),
+                      vertex_buffers[i]->values.end(), values);
+            vertexBuffer->commit(values);
+        }
+    }
+
+    for (int i = 0; i < renderItems.length(); ++i) {
+        const MRenderItem *item = renderItems.itemAt(i);
+        if (!item) {
+            continue;
+        }
+
+        MIndexBuffer *indexBuffer =
+            data.createIndexBuffer(MGeometry::kUnsignedInt32);
+        if (!indexBuffer) {
+            continue;
+        }
+
+        const std::vector<uint32_t> *indices = nullptr;
+        if (item->primitive() == MGeometry::kTriangles) {
+            indices = &mesh_data.triangle_indices;
+        } else if (item->primitive() == MGeometry::kLines) {
+            indices = &mesh_data.edge_indices;
+        }
+        if (indices) {
+            const auto index_count = static_cast<uint32_t>(indices->size());
+            bool writeOnly = true;  // We don't need the current buffer values.
+            uint32_t *buffer = static_cast<uint32_t *>(
+                indexBuffer->acquire(index_count, writeOnly));
+            if (buffer) {
+                std::copy(indices->begin(), indices->end(), buffer);
+                indexBuffer->commit(buffer);
+            }
+        }
+
+        item->associateWithIndexBuffer(indexBuffer);
+    }
+    return true;
 }
 
 void ImagePlaneGeometryOverride::cleanUp() {}
@@ -578,7 +1145,10 @@ void ImagePlaneGeometryOverride::cleanUp() {}
 #if MAYA_API_VERSION >= 20190000
 bool ImagePlaneGeometryOverride::requiresGeometryUpdate() const {
     const bool verbose = false;
-    if (m_geometry_node_path.isValid() && !m_shader_node.isNull()) {
+    // The geometry must be populated again when a different mesh is
+    // connected, or the mesh is deformed differently.
+    if (m_geometry_node_path.isValid() && !m_shader_node.isNull() &&
+        (m_mesh_key == m_populated_mesh_key)) {
         MMSOLVER_MAYA_VRB(
             "ImagePlaneGeometryOverride::requiresGeometryUpdate: false");
         return false;
@@ -22,10 +22,14 @@
 #ifndef MM_IMAGE_PLANE_GEOMETRY_OVERRIDE_H
 #define MM_IMAGE_PLANE_GEOMETRY_OVERRIDE_H
 
+// STL
+#include <string>
+
 // Maya
 #include <maya/MColor.h>
 #include <maya/MEventMessage.h>
 #include <maya/MGlobal.h>
+#include <maya/MPlug.h>
 #include <maya/MPointArray.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
@@ -35,10 +39,15 @@
 #include <maya/MDrawRegistry.h>
 #include <maya/MHWGeometryUtilities.h>
 #include <maya/MPxGeometryOverride.h>
+#include <maya/MShaderManager.h>
+#include <maya/MStateManager.h>
+#include <maya/MTextureManager.h>
 #include <maya/MUserData.h>
 
 // MM Solver
+#include "ImagePlaneMeshCache.h"
 #include "ImagePlaneShapeNode.h"
+#include "mmSolver/image/image_cache.h"
 #include "mmSolver/utilities/debug_utils.h"
 
 namespace mmsolver {
@@ -88,6 +97,17 @@ protected:
     ImagePlaneGeometryOverride(const MObject &obj);
 
     static void on_model_editor_changed_func(void *clientData);
+    static void on_time_changed_func(void *clientData);
+
+    void update_image_cache(const MDagPath &objPath);
+    void update_mesh_key(const MDagPath &objPath);
+    bool populate_geometry_from_cache(const ImagePlaneMeshData &mesh_data,
+                                      const MGeometryRequirements &requirements,
+                                      const MRenderItemList &renderItems,
+                                      MGeometry &data);
+    void update_screen_proxy_level();
+    bool update_texture(MHWRender::MRenderer *renderer);
+    void release_texture();
 
     MObject m_this_node;
     MDagPath m_geometry_node_path;
@@ -108,6 +128,36 @@ protected:
     MString m_image_size;
     MString m_camera_size;
     MCallbackId m_model_editor_changed_callback_id;
+    MCallbackId m_time_changed_callback_id;
+
+    // Images read from the mmSolver image cache are drawn with a
+    // texture owned by this override, instead of the shader node.
+    bool m_use_image_cache;
+    double m_image_width;
+
+    // The proxy level that matches the size of the image plane on
+    // screen (in the viewport showing it the largest), and the
+    // largest proxy level allowed by the node.
+    uint8_t m_screen_proxy_level;
+    uint8_t m_proxy_level_max;
+    image::CachedImagePtr m_image;
+    image::CachedImagePtr m_texture_image;
+    MHWRender::MTexture *m_texture;
+    MHWRender::MShaderInstance *m_texture_shader;
+    const MHWRender::MSamplerState *m_texture_sampler;
+
+    // The extracted (lens distorted) mesh is reused while the
+    // connected mesh nodes, lens, film back and mesh resolution are
+    // unchanged.
+    ImagePlaneMeshKey m_mesh_key;
+    ImagePlaneMeshKey m_populated_mesh_key;
+    ImagePlaneMeshCache m_mesh_cache;
+
+    // Plugs looked up once, rather than on every update. The
+    // 'meshResolution' attribute is dynamic, so it is found by name.
+    MPlug m_geometry_node_plug;
+    MPlug m_geometry_in_mesh_plug;
+    MPlug m_mesh_resolution_plug;
 };
 
 }  // namespace mmsolver
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include "ImagePlaneMeshCache.h"
+
+// STL
+#include <atomic>
+
+namespace mmsolver {
+
+namespace {
+
+// Counted from the Viewport 2.0 draw threads, so atomics are used.
+std::atomic<uint64_t> g_mesh_cache_hit_count(0);
+std::atomic<uint64_t> g_mesh_cache_miss_count(0);
+
+}  // namespace
+
+const ImagePlaneMeshVertexData *ImagePlaneMeshData::findVertexData(
+    const MHWRender::MGeometry::Semantic semantic,
+    const MString &semantic_name, const uint32_t dimension) const {
+    for (const ImagePlaneMeshVertexData &vertex_data : vertex_buffers) {
+        if ((vertex_data.semantic == semantic) &&
+            (vertex_data.semantic_name == semantic_name) &&
+            (vertex_data.dimension == dimension)) {
+            return &vertex_data;
+        }
+    }
+    return nullptr;
+}
+
+ImagePlaneMeshDataPtr ImagePlaneMeshCache::find(
+    const ImagePlaneMeshKey &key) {
+    for (auto it = m_items.begin(); it != m_items.end(); ++it) {
+        if (it->first == key) {
+            // Move to the front; the most recently used.
+            m_items.splice(m_items.begin(), m_items, it);
+            return m_items.front().second;
+        }
+    }
+    return nullptr;
+}
+
+void ImagePlaneMeshCache::insert(const ImagePlaneMeshKey &key,
+                                 const ImagePlaneMeshDataPtr &mesh_data) {
+    for (auto it = m_items.begin(); it != m_items.end(); ++it) {
+        if (it->first == key) {
+            m_items.erase(it);
+            break;
+        }
+    }
+    m_items.emplace_front(key, mesh_data);
+    while (m_items.size() > m_capacity) {
+        m_items.pop_back();
+    }
+}
+
+void ImagePlaneMeshCache::countHit() { ++g_mesh_cache_hit_count; }
+
+void ImagePlaneMeshCache::countMiss() { ++g_mesh_cache_miss_count; }
+
+ImagePlaneMeshCacheStatistics ImagePlaneMeshCache::statistics() {
+    ImagePlaneMeshCacheStatistics statistics;
+    statistics.hit_count = g_mesh_cache_hit_count.load();
+    statistics.miss_count = g_mesh_cache_miss_count.load();
+    return statistics;
+}
+
+void ImagePlaneMeshCache::resetStatistics() {
+    g_mesh_cache_hit_count = 0;
+    g_mesh_cache_miss_count = 0;
+}
+
+}  // namespace mmsolver
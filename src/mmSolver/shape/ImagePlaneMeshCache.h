@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * A small cache of the (lens distorted) image plane mesh, used by
+ * the mmImagePlaneShape geometry override.
+ *
+ * The image plane mesh is deformed by the lens, so the vertex
+ * positions only change when the lens, the camera film back, the mesh
+ * resolution or the connected mesh nodes change. The vertex and index
+ * arrays extracted from the mesh are kept for the most recently used
+ * values, so the mesh does not need to be evaluated and extracted
+ * again when scrubbing the timeline with a static lens.
+ */
+
+#ifndef MM_IMAGE_PLANE_MESH_CACHE_H
+#define MM_IMAGE_PLANE_MESH_CACHE_H
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Maya
+#include <maya/MObjectHandle.h>
+#include <maya/MString.h>
+
+// Maya Viewport 2.0
+#include <maya/MHWGeometry.h>
+
+namespace mmsolver {
+
+// The values that define the shape of the image plane mesh.
+struct ImagePlaneMeshKey {
+    // The mesh node connected to the image plane, and the node that
+    // creates the mesh (connected to the mesh's 'inMesh'). A mesh
+    // extracted from other nodes is never reused.
+    MObjectHandle geometry_node;
+    MObjectHandle geometry_upstream_node;
+
+    int64_t lens_hash;
+    double film_back_width;
+    double film_back_height;
+    int32_t mesh_resolution;
+
+    ImagePlaneMeshKey()
+        : geometry_node()
+        , geometry_upstream_node()
+        , lens_hash(0)
+        , film_back_width(0.0)
+        , film_back_height(0.0)
+        , mesh_resolution(0) {}
+
+    bool operator==(const ImagePlaneMeshKey &other) const {
+        return (geometry_node == other.geometry_node) &&
+               (geometry_upstream_node == other.geometry_upstream_node) &&
+               (lens_hash == other.lens_hash) &&
+               (film_back_width == other.film_back_width) &&
+               (film_back_height == other.film_back_height) &&
+               (mesh_resolution == other.mesh_resolution);
+    }
+
+    bool operator!=(const ImagePlaneMeshKey &other) const {
+        return !(*this == other);
+    }
+};
+
+// The values of a single vertex buffer, ready to be copied into a
+// Viewport 2.0 vertex buffer.
+struct ImagePlaneMeshVertexData {
+    MHWRender::MGeometry::Semantic semantic;
+    MString semantic_name;
+    uint32_t dimension;
+    std::vector<float> values;
+
+    ImagePlaneMeshVertexData()
+        : semantic(MHWRender::MGeometry::kInvalidSemantic)
+        , semantic_name()
+        , dimension(0)
+        , values() {}
+};
+
+struct ImagePlaneMeshData {
+    uint32_t vertex_count;
+    std::vector<ImagePlaneMeshVertexData> vertex_buffers;
+
+    bool has_triangles;
+    uint32_t triangle_count;
+    std::vector<uint32_t> triangle_indices;
+
+    bool has_edges;
+    uint32_t edge_count;
+    std::vector<uint32_t> edge_indices;
+
+    ImagePlaneMeshData()
+        : vertex_count(0)
+        , vertex_buffers()
+        , has_triangles(false)
+        , triangle_count(0)
+        , triangle_indices()
+        , has_edges(false)
+        , edge_count(0)
+        , edge_indices() {}
+
+    // Returns nullptr if no vertex buffer matches the arguments.
+    const ImagePlaneMeshVertexData *findVertexData(
+        const MHWRender::MGeometry::Semantic semantic,
+        const MString &semantic_name, const uint32_t dimension) const;
+};
+
+using ImagePlaneMeshDataPtr = std::shared_ptr<const ImagePlaneMeshData>;
+
+struct ImagePlaneMeshCacheStatistics {
+    uint64_t hit_count;
+    uint64_t miss_count;
+
+    ImagePlaneMeshCacheStatistics() : hit_count(0), miss_count(0) {}
+};
+
+// Least-recently-used cache of image plane meshes. Each geometry
+// override owns a cache, however the statistics are shared by all
+// caches.
+class ImagePlaneMeshCache {
+public:
+    explicit ImagePlaneMeshCache(const size_t capacity = 4)
+        : m_capacity(capacity) {}
+
+    // Returns nullptr if the key is not in the cache.
+    ImagePlaneMeshDataPtr find(const ImagePlaneMeshKey &key);
+
+    void insert(const ImagePlaneMeshKey &key,
+                const ImagePlaneMeshDataPtr &mesh_data);
+
+    void clear() { m_items.clear(); }
+
+    static void countHit();
+    static void countMiss();
+    static ImagePlaneMeshCacheStatistics statistics();
+    static void resetStatistics();
+
+private:
+    using Item = std::pair<ImagePlaneMeshKey, ImagePlaneMeshDataPtr>;
+
+    // Most recently used items are at the front.
+    std::list<Item> m_items;
+    size_t m_capacity;
+};
+
+}  // namespace mmsolver
+
+#endif  // MM_IMAGE_PLANE_MESH_CACHE_H
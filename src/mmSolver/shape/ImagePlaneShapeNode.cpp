@@ -30,6 +30,8 @@
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnNumericData.h>
+#include <maya/MFnStringData.h>
+#include <maya/MFnTypedAttribute.h>
 #include <maya/MFnUnitAttribute.h>
 #include <maya/MPlug.h>
 #include <maya/MPxLocatorNode.h>
@@ -74,6 +76,12 @@ MObject ImagePlaneShapeNode::m_camera_width_inch;
 MObject ImagePlaneShapeNode::m_camera_height_inch;
 MObject ImagePlaneShapeNode::m_lens_hash_current;
 MObject ImagePlaneShapeNode::m_lens_hash_previous;
+MObject ImagePlaneShapeNode::m_use_image_cache;
+MObject ImagePlaneShapeNode::m_image_file_path;
+MObject ImagePlaneShapeNode::m_image_frame;
+MObject ImagePlaneShapeNode::m_image_cache_frames_behind;
+MObject ImagePlaneShapeNode::m_image_cache_frames_ahead;
+MObject ImagePlaneShapeNode::m_image_cache_proxy_level_max;
 MObject ImagePlaneShapeNode::m_geometry_node;
 MObject ImagePlaneShapeNode::m_shader_node;
 MObject ImagePlaneShapeNode::m_camera_node;
@@ -154,6 +162,7 @@ MStatus ImagePlaneShapeNode::initialize() {
     MStatus status;
     MFnNumericAttribute nAttr;
     MFnMessageAttribute msgAttr;
+    MFnTypedAttribute tAttr;
 
     m_visible_to_camera_only = nAttr.create("visibleToCameraOnly", "viscamony",
                                             MFnNumericData::kBoolean, 0);
@@ -234,6 +243,61 @@ MStatus ImagePlaneShapeNode::initialize() {
     CHECK_MSTATUS(nAttr.setHidden(true));
     CHECK_MSTATUS(addAttribute(m_lens_hash_previous));
 
+    // When enabled, the image sequence is read by the mmSolver image
+    // cache (with frames read ahead of time on background threads),
+    // rather than by the Maya shader node.
+    m_use_image_cache =
+        nAttr.create("useImageCache", "useimgcch", MFnNumericData::kBoolean, 0);
+    CHECK_MSTATUS(nAttr.setStorable(true));
+    CHECK_MSTATUS(nAttr.setKeyable(false));
+    CHECK_MSTATUS(addAttribute(m_use_image_cache));
+
+    // The image file path, with '#' characters replaced by the frame
+    // number, for example "/path/to/plate.####.exr".
+    {
+        MFnStringData string_data;
+        MObject default_value = string_data.create(MString(""));
+        m_image_file_path = tAttr.create("imageFilePath", "imgflpth",
+                                         MFnData::kString, default_value);
+        CHECK_MSTATUS(tAttr.setStorable(true));
+        CHECK_MSTATUS(tAttr.setUsedAsFilename(true));
+        CHECK_MSTATUS(addAttribute(m_image_file_path));
+    }
+
+    // The frame number used to replace the '#' characters in the
+    // image file path.
+    m_image_frame =
+        nAttr.create("imageFrame", "imgfrm", MFnNumericData::kDouble, 0.0);
+    CHECK_MSTATUS(nAttr.setStorable(true));
+    CHECK_MSTATUS(nAttr.setKeyable(true));
+    CHECK_MSTATUS(addAttribute(m_image_frame));
+
+    m_image_cache_frames_behind = nAttr.create(
+        "imageCacheFramesBehind", "imgcchfrmbh", MFnNumericData::kInt, 2);
+    CHECK_MSTATUS(nAttr.setStorable(true));
+    CHECK_MSTATUS(nAttr.setKeyable(false));
+    CHECK_MSTATUS(nAttr.setMin(0));
+    CHECK_MSTATUS(addAttribute(m_image_cache_frames_behind));
+
+    m_image_cache_frames_ahead = nAttr.create(
+        "imageCacheFramesAhead", "imgcchfrmah", MFnNumericData::kInt, 12);
+    CHECK_MSTATUS(nAttr.setStorable(true));
+    CHECK_MSTATUS(nAttr.setKeyable(false));
+    CHECK_MSTATUS(nAttr.setMin(0));
+    CHECK_MSTATUS(addAttribute(m_image_cache_frames_ahead));
+
+    // The smallest proxy level that may be read, when the image plane
+    // is small on screen. Proxy level N is 2^N times smaller than the
+    // image; zero always reads the full resolution image. Proxy
+    // levels are written by 'mmConvertImage -proxyLevels'.
+    m_image_cache_proxy_level_max = nAttr.create(
+        "imageCacheProxyLevelMax", "imgcchpxlmx", MFnNumericData::kInt, 3);
+    CHECK_MSTATUS(nAttr.setStorable(true));
+    CHECK_MSTATUS(nAttr.setKeyable(false));
+    CHECK_MSTATUS(nAttr.setMin(0));
+    CHECK_MSTATUS(nAttr.setMax(8));
+    CHECK_MSTATUS(addAttribute(m_image_cache_proxy_level_max));
+
     m_geometry_node = msgAttr.create("geometryNode", "geond", &status);
     CHECK_MSTATUS(status);
     CHECK_MSTATUS(msgAttr.setStorable(true));
@@ -96,6 +96,12 @@ public:
     static MObject m_camera_height_inch;
     static MObject m_lens_hash_current;
     static MObject m_lens_hash_previous;
+    static MObject m_use_image_cache;
+    static MObject m_image_file_path;
+    static MObject m_image_frame;
+    static MObject m_image_cache_frames_behind;
+    static MObject m_image_cache_frames_ahead;
+    static MObject m_image_cache_proxy_level_max;
     static MObject m_geometry_node;
     static MObject m_shader_node;
     static MObject m_camera_node;
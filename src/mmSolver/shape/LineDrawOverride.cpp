@@ -30,10 +30,12 @@
 #include <maya/MEventMessage.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnMatrixData.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 #include <maya/MPoint.h>
 #include <maya/MPointArray.h>
+#include <maya/MProfiler.h>
 #include <maya/MString.h>
 #include <maya/MTransformationMatrix.h>
 
@@ -48,6 +50,8 @@
 
 #include "LineConstants.h"
 #include "ShapeConstants.h"
+#include "ShapeDrawUtils.h"
+#include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/mayahelper/maya_utils.h"
 #include "mmSolver/node/node_line_utils.h"
 #include "mmSolver/utilities/number_utils.h"
@@ -70,13 +74,20 @@ namespace mmsolver {
 LineDrawOverride::LineDrawOverride(const MObject &obj)
     : MHWRender::MPxDrawOverride(obj,
                                  /*callback=*/nullptr,
-                                 /*isAlwaysDirty=*/true) {
+                                 /*isAlwaysDirty=*/true)
+    , m_attr_version(1)
+    , m_attribute_changed_callback_id(0) {
     m_model_editor_changed_callback_id = MEventMessage::addEventCallback(
         "modelEditorChanged", on_model_editor_changed_func, this);
 
     MStatus status;
     MFnDependencyNode node(obj, &status);
     m_node = status ? dynamic_cast<LineShapeNode *>(node.userNode()) : nullptr;
+
+    MObject node_obj(obj);
+    m_attribute_changed_callback_id = MNodeMessage::addAttributeChangedCallback(
+        node_obj, on_attribute_changed_func, this, &status);
+    CHECK_MSTATUS(status);
 }
 
 LineDrawOverride::~LineDrawOverride() {
@@ -86,6 +97,11 @@ LineDrawOverride::~LineDrawOverride() {
         MMessage::removeCallback(m_model_editor_changed_callback_id);
         m_model_editor_changed_callback_id = 0;
     }
+
+    if (m_attribute_changed_callback_id != 0) {
+        MMessage::removeCallback(m_attribute_changed_callback_id);
+        m_attribute_changed_callback_id = 0;
+    }
 }
 
 void LineDrawOverride::on_model_editor_changed_func(void *clientData) {
@@ -97,6 +113,18 @@ void LineDrawOverride::on_model_editor_changed_func(void *clientData) {
     }
 }
 
+void LineDrawOverride::on_attribute_changed_func(
+    MNodeMessage::AttributeMessage msg, MPlug & /*plug*/,
+    MPlug & /*otherPlug*/, void *clientData) {
+    const bool changed = (msg & MNodeMessage::kAttributeSet) ||
+                         (msg & MNodeMessage::kConnectionMade) ||
+                         (msg & MNodeMessage::kConnectionBroken);
+    LineDrawOverride *ovr = static_cast<LineDrawOverride *>(clientData);
+    if (ovr && changed) {
+        ++ovr->m_attr_version;
+    }
+}
+
 MHWRender::DrawAPI LineDrawOverride::supportedDrawAPIs() const {
     return (MHWRender::kOpenGL | MHWRender::kDirectX11 |
             MHWRender::kOpenGLCoreProfile);
@@ -150,6 +178,12 @@ MBoundingBox LineDrawOverride::boundingBox(
 MUserData *LineDrawOverride::prepareForDraw(
     const MDagPath &objPath, const MDagPath & /*cameraPath*/,
     const MHWRender::MFrameContext & /*frameContext*/, MUserData *oldData) {
+#ifdef MAYA_PROFILE
+    MProfilingScope profilingScope(getDrawProfileCategory(),
+                                   MProfiler::kColorE_L2,
+                                   "LineDrawOverride::prepareForDraw");
+#endif
+
     LineDrawData *data = dynamic_cast<LineDrawData *>(oldData);
     if (!data) {
         data = new LineDrawData();
@@ -171,38 +205,53 @@ MUserData *LineDrawOverride::prepareForDraw(
     CHECK_MSTATUS(status);
     MMatrix obj_matrix = matrix_inverse;
 
-    status = getNodeAttr(objPath, LineShapeNode::m_middle_scale,
-                         data->m_middle_scale);
-    CHECK_MSTATUS(status);
-
-    // Color
-    MColor color1(0.0f, 0.0f, 0.0f, 1.0f);
-    status = getNodeAttr(objPath, LineShapeNode::m_color, color1);
-    CHECK_MSTATUS(status);
-
-    // Alpha
-    status = getNodeAttr(objPath, LineShapeNode::m_alpha, color1[3]);
-    CHECK_MSTATUS(status);
-
-    // Line Width
-    status = getNodeAttr(objPath, LineShapeNode::m_inner_line_width,
-                         data->m_inner_line_width);
-    CHECK_MSTATUS(status);
-
-    // Point Size
-    status =
-        getNodeAttr(objPath, LineShapeNode::m_point_size, data->m_point_size);
-    CHECK_MSTATUS(status);
-
-    // Draw Name
-    status =
-        getNodeAttr(objPath, LineShapeNode::m_draw_name, data->m_draw_name);
-    CHECK_MSTATUS(status);
-
-    // Draw Middle
-    status =
-        getNodeAttr(objPath, LineShapeNode::m_draw_middle, data->m_draw_middle);
-    CHECK_MSTATUS(status);
+    // The attributes are only read when they have changed, or when
+    // they are connected (animated) and may change at any time.
+    if ((data->m_attr_version != m_attr_version) || data->m_attrs_connected) {
+        status = getNodeAttr(objPath, LineShapeNode::m_middle_scale,
+                             data->m_middle_scale);
+        CHECK_MSTATUS(status);
+
+        // Color
+        MColor user_color(0.0f, 0.0f, 0.0f, 1.0f);
+        status = getNodeAttr(objPath, LineShapeNode::m_color, user_color);
+        CHECK_MSTATUS(status);
+
+        // Alpha
+        status = getNodeAttr(objPath, LineShapeNode::m_alpha, user_color[3]);
+        CHECK_MSTATUS(status);
+        data->m_user_color = user_color;
+
+        // Line Width
+        status = getNodeAttr(objPath, LineShapeNode::m_inner_line_width,
+                             data->m_inner_line_width);
+        CHECK_MSTATUS(status);
+
+        // Point Size
+        status = getNodeAttr(objPath, LineShapeNode::m_point_size,
+                             data->m_point_size);
+        CHECK_MSTATUS(status);
+
+        // Draw Name
+        status = getNodeAttr(objPath, LineShapeNode::m_draw_name,
+                             data->m_draw_name);
+        CHECK_MSTATUS(status);
+
+        // Draw Middle
+        status = getNodeAttr(objPath, LineShapeNode::m_draw_middle,
+                             data->m_draw_middle);
+        CHECK_MSTATUS(status);
+
+        const MObject attrs[] = {
+            LineShapeNode::m_middle_scale, LineShapeNode::m_color,
+            LineShapeNode::m_alpha,        LineShapeNode::m_inner_line_width,
+            LineShapeNode::m_point_size,   LineShapeNode::m_draw_name,
+            LineShapeNode::m_draw_middle};
+        data->m_attrs_connected = anyAttrIsConnected(
+            objPath.node(), attrs, sizeof(attrs) / sizeof(attrs[0]));
+        data->m_attr_version = m_attr_version;
+    }
+    MColor color1 = data->m_user_color;
 
     // Create secondary color.
     MColor color2(0.0f, 0.0f, 0.0f, 1.0f);
@@ -293,6 +342,13 @@ MUserData *LineDrawOverride::prepareForDraw(
         return data;
     }
 
+    // The center of the points, used to place the name text.
+    const double inverse_num_of_points = 1.0 / numberOfPoints;
+    data->m_center_point = MPoint();
+    for (uint32_t i = 0; i < numberOfPoints; i++) {
+        data->m_center_point += data->m_point_list[i] * inverse_num_of_points;
+    }
+
     // Middle line point data.
     {
         auto line_length = data->m_middle_scale;
@@ -330,6 +386,12 @@ void LineDrawOverride::addUIDrawables(
     const MHWRender::MFrameContext & /*frameContext*/,
     const MUserData *userData) {
     MStatus status;
+#ifdef MAYA_PROFILE
+    MProfilingScope profilingScope(getDrawProfileCategory(),
+                                   MProfiler::kColorE_L3,
+                                   "LineDrawOverride::addUIDrawables");
+#endif
+
     LineDrawData *data = (LineDrawData *)userData;
     if (!data) {
         return;
@@ -339,33 +401,16 @@ void LineDrawOverride::addUIDrawables(
         return;
     }
 
-    const auto inverse_num_of_points = 1.0 / data->m_point_list.length();
-    auto middle_point = MPoint();
-    for (uint32_t i = 0; i < data->m_point_list.length(); i++) {
-        MPoint pnt = data->m_point_list[i];
-        middle_point += pnt * inverse_num_of_points;
-    }
-
-    MPointArray inner_line_list(num_of_points);
-    for (uint32_t i = 0; i < (num_of_points - 1); i++) {
-        auto index_a = i + 0;
-        auto index_b = i + 1;
-        MPoint pnt_a = data->m_point_list[index_a];
-        MPoint pnt_b = data->m_point_list[index_b];
-        inner_line_list.set(pnt_a, index_a);
-        inner_line_list.set(pnt_b, index_b);
-    }
-
-    MPointArray mid_line_list(2);
-    mid_line_list.set(data->m_middle_point_a, 0);
-    mid_line_list.set(data->m_middle_point_b, 1);
-
     // Draw middle line.
     //
     // The "best-fit" straight line between points. This is drawn
     // first, so that subsequent draw calls will render over the top
     // of this middle line.
     if (data->m_draw_middle) {
+        MPointArray mid_line_list(2);
+        mid_line_list.set(data->m_middle_point_a, 0);
+        mid_line_list.set(data->m_middle_point_b, 1);
+
         // X-Ray mode disregards depth testing and will always draw
         // on-top.
         drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
@@ -386,82 +431,48 @@ void LineDrawOverride::addUIDrawables(
         drawManager.endDrawable();
     }
 
-    // Draw inner line
-    {
-        // X-Ray mode disregards depth testing and will always draw
-        // on-top.
-        drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineWidth(static_cast<float>(data->m_inner_line_width));
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setDepthPriority(data->m_depth_priority);
-
-        drawManager.beginDrawInXray();
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineWidth(static_cast<float>(data->m_inner_line_width));
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setDepthPriority(data->m_depth_priority);
-
-        drawManager.mesh(MHWRender::MUIDrawManager::kLineStrip,
-                         inner_line_list);
-
-        drawManager.endDrawInXray();
-        drawManager.endDrawable();
-    }
-
-    // Draw point directly in the center of the object transform.
-    {
-        // X-Ray mode disregards depth testing and will always draw
-        // on-top.
-        drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setPointSize(static_cast<float>(data->m_point_size));
-        drawManager.setDepthPriority(data->m_depth_priority);
-
-        drawManager.beginDrawInXray();
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setPointSize(static_cast<float>(data->m_point_size));
-        drawManager.setDepthPriority(data->m_depth_priority);
+    // Draw the inner line, the points and the text in one drawable,
+    // because they all use the same (primary) color and depth.
+    //
+    // X-Ray mode disregards depth testing and will always draw
+    // on-top.
+    drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
+    drawManager.setColor(data->m_color1);
+    drawManager.setLineWidth(static_cast<float>(data->m_inner_line_width));
+    drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
+    drawManager.setPointSize(static_cast<float>(data->m_point_size));
+    drawManager.setDepthPriority(data->m_depth_priority);
+
+    drawManager.beginDrawInXray();
+    drawManager.setColor(data->m_color1);
+    drawManager.setLineWidth(static_cast<float>(data->m_inner_line_width));
+    drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
+    drawManager.setPointSize(static_cast<float>(data->m_point_size));
+    drawManager.setDepthPriority(data->m_depth_priority);
 
-        drawManager.mesh(MHWRender::MUIDrawManager::kPoints,
-                         data->m_point_list);
+    // Draw inner line
+    drawManager.mesh(MHWRender::MUIDrawManager::kLineStrip,
+                     data->m_point_list);
 
-        drawManager.endDrawInXray();
-        drawManager.endDrawable();
-    }
+    // Draw points.
+    drawManager.mesh(MHWRender::MUIDrawManager::kPoints, data->m_point_list);
 
     // Draw text
-    {
-        // X-Ray mode disregards depth testing and will always draw
-        // on-top.
-        drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setDepthPriority(data->m_depth_priority);
-
-        drawManager.beginDrawInXray();
-        drawManager.setColor(data->m_color1);
-        drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
-        drawManager.setDepthPriority(data->m_depth_priority);
-
-        // TODO:
-        // - Draw 'weight'.
-        // - Draw 'frame deviation'.
-        // - Draw 'average deviation'.
-        // - Draw 'max deviation'.
-        if (data->m_draw_name && data->m_active) {
-            // TODO: Add attribute to multiply the font size.
-            drawManager.setFontSize(
-                MHWRender::MUIDrawManager::kDefaultFontSize);
-            drawManager.text(middle_point, data->m_name,
-                             MHWRender::MUIDrawManager::kLeft);
-        }
-
-        drawManager.endDrawInXray();
-        drawManager.endDrawable();
+    //
+    // TODO:
+    // - Draw 'weight'.
+    // - Draw 'frame deviation'.
+    // - Draw 'average deviation'.
+    // - Draw 'max deviation'.
+    if (data->m_draw_name && data->m_active) {
+        // TODO: Add attribute to multiply the font size.
+        drawManager.setFontSize(MHWRender::MUIDrawManager::kDefaultFontSize);
+        drawManager.text(data->m_center_point, data->m_name,
+                         MHWRender::MUIDrawManager::kLeft);
     }
+
+    drawManager.endDrawInXray();
+    drawManager.endDrawable();
 }
 
 }  // namespace mmsolver
@@ -22,10 +22,15 @@
 #ifndef MM_LINE_DRAW_OVERRIDE_H
 #define MM_LINE_DRAW_OVERRIDE_H
 
+// STL
+#include <cstdint>
+
 // Maya
 #include <maya/MColor.h>
 #include <maya/MEventMessage.h>
 #include <maya/MGlobal.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MPointArray.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
@@ -46,22 +51,37 @@
 
 namespace mmsolver {
 
+// The draw data is kept between draws (and given back to
+// 'prepareForDraw' as 'oldData'), so the node attribute values are
+// only read again when the node's attribute version changes. The
+// line positions are read for each draw, because the connected nodes
+// may move.
 class LineDrawData : public MUserData {
 public:
     LineDrawData()
-        : MUserData(/*deleteAfterUse=*/true)  // let Maya clean up
+        : MUserData(/*deleteAfterUse=*/false)
+        , m_attr_version(0)
+        , m_attrs_connected(false)
+        , m_user_color()
+        , m_name()
+        , m_active(false)
+        , m_draw_name(false)
+        , m_draw_middle(false)
         , m_depth_priority(0)
+        , m_point_size(1.0)
         , m_inner_line_width(1.0)
         , m_middle_line_width(1.0)
         , m_middle_scale(1.0)
-        , m_point_size(1.0)
-        , m_point_list()
-        , m_active(false)
-        , m_draw_name(false)
-        , m_draw_middle(false) {}
+        , m_point_list() {}
 
     ~LineDrawData() override {}
 
+    // The attribute version of the override that the cached attribute
+    // values were read at.
+    uint64_t m_attr_version;
+    bool m_attrs_connected;
+    MColor m_user_color;
+
     MString m_name;
     bool m_active;
     bool m_draw_name;
@@ -79,6 +99,7 @@ public:
     MColor m_color2{0.0f, 0.0f, 1.0f, 1.0f};
 
     MPointArray m_point_list;
+    MPoint m_center_point;
     rust::Vec<mmscenegraph::Real> m_point_data_x;
     rust::Vec<mmscenegraph::Real> m_point_data_y;
     MPoint m_middle_point_a;
@@ -128,8 +149,17 @@ private:
 
     static void on_model_editor_changed_func(void *clientData);
 
+    static void on_attribute_changed_func(MNodeMessage::AttributeMessage msg,
+                                          MPlug &plug, MPlug &otherPlug,
+                                          void *clientData);
+
     LineShapeNode *m_node;
     MCallbackId m_model_editor_changed_callback_id;
+
+    // Incremented each time an attribute of the shape node is set,
+    // connected or disconnected.
+    uint64_t m_attr_version;
+    MCallbackId m_attribute_changed_callback_id;
 };
 
 }  // namespace mmsolver
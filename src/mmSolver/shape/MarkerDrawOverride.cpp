@@ -26,6 +26,7 @@
 #include <maya/MDistance.h>
 #include <maya/MEventMessage.h>
 #include <maya/MFnDependencyNode.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
 #include <maya/MString.h>
@@ -45,6 +46,47 @@
 
 namespace mmsolver {
 
+namespace {
+
+// The marker icon shapes are constant, so they are only built once
+// and shared by all markers.
+struct MarkerShapeGeometry {
+    MPointArray cross_line_list;
+    MUintArray cross_line_index_list;
+
+    MPointArray box_line_list;
+    MUintArray box_line_index_list;
+
+    MarkerShapeGeometry() {
+        // The cross icon
+        for (int i = 0; i < shape_a_points_count; i++) {
+            cross_line_list.append(shape_a_points[i][0], shape_a_points[i][1],
+                                   shape_a_points[i][2]);
+        }
+        for (int i = 0; i < shape_a_line_indexes_count; i++) {
+            cross_line_index_list.append(shape_a_line_indexes[i][0]);
+            cross_line_index_list.append(shape_a_line_indexes[i][1]);
+        }
+
+        // The (unlocked) box icon
+        for (int i = 0; i < shape_b_points_count; i++) {
+            box_line_list.append(shape_b_points[i][0], shape_b_points[i][1],
+                                 shape_b_points[i][2]);
+        }
+        for (int i = 0; i < shape_b_line_indexes_count; i++) {
+            box_line_index_list.append(shape_b_line_indexes[i][0]);
+            box_line_index_list.append(shape_b_line_indexes[i][1]);
+        }
+    }
+};
+
+const MarkerShapeGeometry &get_marker_shape_geometry() {
+    static const MarkerShapeGeometry geometry;
+    return geometry;
+}
+
+}  // namespace
+
 // By setting isAlwaysDirty to false in MPxDrawOverride constructor,
 // the draw override will be updated (via prepareForDraw()) only when
 // the node is marked dirty via DG evaluation or dirty
@@ -56,7 +98,10 @@ namespace mmsolver {
 MarkerDrawOverride::MarkerDrawOverride(const MObject &obj)
     : MHWRender::MPxDrawOverride(obj,
                                  /*callback=*/nullptr,
-                                 /*isAlwaysDirty=*/true) {
+                                 /*isAlwaysDirty=*/true)
+    , m_transform_attribute_changed_callback_id(0)
+    , m_locked(false)
+    , m_locked_dirty(true) {
     m_model_editor_changed_callback_id = MEventMessage::addEventCallback(
         "modelEditorChanged", on_model_editor_changed_func, this);
 
@@ -73,6 +118,11 @@ MarkerDrawOverride::~MarkerDrawOverride() {
         MMessage::removeCallback(m_model_editor_changed_callback_id);
         m_model_editor_changed_callback_id = 0;
     }
+
+    if (m_transform_attribute_changed_callback_id != 0) {
+        MMessage::removeCallback(m_transform_attribute_changed_callback_id);
+        m_transform_attribute_changed_callback_id = 0;
+    }
 }
 
 void MarkerDrawOverride::on_model_editor_changed_func(void *clientData) {
@@ -84,6 +134,53 @@ void MarkerDrawOverride::on_model_editor_changed_func(void *clientData) {
     }
 }
 
+void MarkerDrawOverride::on_transform_attribute_changed_func(
+    MNodeMessage::AttributeMessage msg, MPlug & /*plug*/,
+    MPlug & /*otherPlug*/, void *clientData) {
+    // Locking an attribute, or connecting to it, changes whether the
+    // marker can be moved.
+    const bool lock_changed = (msg & MNodeMessage::kAttributeLocked) ||
+                              (msg & MNodeMessage::kAttributeUnlocked) ||
+                              (msg & MNodeMessage::kConnectionMade) ||
+                              (msg & MNodeMessage::kConnectionBroken);
+    MarkerDrawOverride *ovr = static_cast<MarkerDrawOverride *>(clientData);
+    if (ovr && lock_changed) {
+        ovr->m_locked_dirty = true;
+    }
+}
+
+// Look up the transform plugs and add the attribute changed callback
+// when the marker shape's transform is first seen (or changes, when
+// the shape is re-parented).
+void MarkerDrawOverride::watch_transform(const MObject &transformObj) {
+    if (m_transform.isValid() && (m_transform.object() == transformObj)) {
+        return;
+    }
+
+    if (m_transform_attribute_changed_callback_id != 0) {
+        MMessage::removeCallback(m_transform_attribute_changed_callback_id);
+        m_transform_attribute_changed_callback_id = 0;
+    }
+
+    MStatus status;
+    MObject node(transformObj);
+    m_transform = MObjectHandle(node);
+    m_locked_dirty = true;
+
+    MFnDependencyNode dependNodeFn(node);
+    m_plug_tx = dependNodeFn.findPlug("translateX",
+                                      /*wantNetworkedPlug=*/true, &status);
+    CHECK_MSTATUS(status);
+    m_plug_ty = dependNodeFn.findPlug("translateY",
+                                      /*wantNetworkedPlug=*/true, &status);
+    CHECK_MSTATUS(status);
+
+    m_transform_attribute_changed_callback_id =
+        MNodeMessage::addAttributeChangedCallback(
+            node, on_transform_attribute_changed_func, this, &status);
+    CHECK_MSTATUS(status);
+}
+
 MHWRender::DrawAPI MarkerDrawOverride::supportedDrawAPIs() const {
     return (MHWRender::kOpenGL | MHWRender::kDirectX11 |
             MHWRender::kOpenGLCoreProfile);
@@ -140,28 +237,27 @@ MUserData *MarkerDrawOverride::prepareForDraw(
     //
     // Detect if the translateX/Y attributes are locked and if so, add
     // a 'lock' icon, and change the marker shape.
-    data->m_locked = false;
-    MPlug plug_tx = dependNodeFn.findPlug("translateX",
-                                          /*wantNetworkedPlug=*/true, &status);
-    CHECK_MSTATUS(status);
-    MPlug plug_ty = dependNodeFn.findPlug("translateY",
-                                          /*wantNetworkedPlug=*/true, &status);
-    CHECK_MSTATUS(status);
-    if (!plug_tx.isNull() && !plug_ty.isNull()) {
-        bool checkParents = false;
-        bool checkChildren = false;
-        bool tx_can_change =
-            plug_tx.isFreeToChange(checkParents, checkChildren, &status) ==
-            MPlug::kFreeToChange;
-        CHECK_MSTATUS(status);
-        bool ty_can_change =
-            plug_ty.isFreeToChange(checkParents, checkChildren, &status) ==
-            MPlug::kFreeToChange;
-        CHECK_MSTATUS(status);
-        if (!tx_can_change || !ty_can_change) {
-            data->m_locked = true;
+    watch_transform(transformObj);
+    if (m_locked_dirty) {
+        m_locked = false;
+        if (!m_plug_tx.isNull() && !m_plug_ty.isNull()) {
+            bool checkParents = false;
+            bool checkChildren = false;
+            bool tx_can_change =
+                m_plug_tx.isFreeToChange(checkParents, checkChildren,
+                                         &status) == MPlug::kFreeToChange;
+            CHECK_MSTATUS(status);
+            bool ty_can_change =
+                m_plug_ty.isFreeToChange(checkParents, checkChildren,
+                                         &status) == MPlug::kFreeToChange;
+            CHECK_MSTATUS(status);
+            if (!tx_can_change || !ty_can_change) {
+                m_locked = true;
+            }
         }
+        m_locked_dirty = false;
     }
+    data->m_locked = m_locked;
 
     MDoubleArray pixel_size_array =
         frameContext.getTuple(MFrameContext::kViewportPixelSize, &status);
@@ -188,34 +284,6 @@ MUserData *MarkerDrawOverride::prepareForDraw(
         getNodeAttr(objPath, MarkerShapeNode::m_draw_name, data->m_draw_name);
     CHECK_MSTATUS(status);
 
-    // The cross icon
-    data->m_cross_line_list.clear();
-    for (int i = 0; i < shape_a_points_count; i++) {
-        data->m_cross_line_list.append(
-            shape_a_points[i][0], shape_a_points[i][1], shape_a_points[i][2]);
-    }
-
-    data->m_cross_line_index_list.clear();
-    for (int i = 0; i < shape_a_line_indexes_count; i++) {
-        data->m_cross_line_index_list.append(shape_a_line_indexes[i][0]);
-        data->m_cross_line_index_list.append(shape_a_line_indexes[i][1]);
-    }
-
-    data->m_box_line_list.clear();
-    data->m_box_line_index_list.clear();
-    if (!data->m_locked) {
-        // Use unlocked icon.
-        for (int i = 0; i < shape_b_points_count; i++) {
-            data->m_box_line_list.append(shape_b_points[i][0],
-                                         shape_b_points[i][1],
-                                         shape_b_points[i][2]);
-        }
-        for (int i = 0; i < shape_b_line_indexes_count; i++) {
-            data->m_box_line_index_list.append(shape_b_line_indexes[i][0]);
-            data->m_box_line_index_list.append(shape_b_line_indexes[i][1]);
-        }
-    }
-
     float hue = 0.0;
     float sat = 0.0;
     float val = 0.0;
@@ -277,18 +345,24 @@ void MarkerDrawOverride::addUIDrawables(
     tfm_matrix.setScale(tfm_scale, MSpace::kObject);
     MMatrix obj_matrix = tfm_matrix.asMatrix() * matrix_inverse;
 
-    MPointArray cross_line_list(data->m_cross_line_list.length());
-    for (uint32_t i = 0; i < data->m_cross_line_list.length(); i++) {
-        MPoint orig = data->m_cross_line_list[i];
+    const MarkerShapeGeometry &geometry = get_marker_shape_geometry();
+    MPointArray cross_line_list(geometry.cross_line_list.length());
+    for (uint32_t i = 0; i < geometry.cross_line_list.length(); i++) {
+        MPoint orig = geometry.cross_line_list[i];
         MPoint pnt = MPoint(orig.x * scale, orig.y * scale, orig.z * scale);
         cross_line_list.set(pnt * obj_matrix, i);
     }
 
-    MPointArray box_line_list(data->m_box_line_list.length());
-    for (uint32_t i = 0; i < data->m_box_line_list.length(); i++) {
-        MPoint orig = data->m_box_line_list[i];
-        MPoint pnt = MPoint(orig.x * scale, orig.y * scale, orig.z * scale);
-        box_line_list.set(pnt * obj_matrix, i);
+    // The box is not drawn for locked markers.
+    MPointArray box_line_list;
+    if (!data->m_locked) {
+        box_line_list.setLength(geometry.box_line_list.length());
+        for (uint32_t i = 0; i < geometry.box_line_list.length(); i++) {
+            MPoint orig = geometry.box_line_list[i];
+            MPoint pnt =
+                MPoint(orig.x * scale, orig.y * scale, orig.z * scale);
+            box_line_list.set(pnt * obj_matrix, i);
+        }
     }
 
     drawManager.beginDrawable(MHWRender::MUIDrawManager::kSelectable);
@@ -313,11 +387,11 @@ void MarkerDrawOverride::addUIDrawables(
 
     // Draw cross
     drawManager.mesh(MHWRender::MUIDrawManager::kLines, cross_line_list,
-                     nullptr, nullptr, &data->m_cross_line_index_list);
+                     nullptr, nullptr, &geometry.cross_line_index_list);
     // Draw box.
     if (!data->m_locked) {
         drawManager.mesh(MHWRender::MUIDrawManager::kLines, box_line_list,
-                         nullptr, nullptr, &data->m_box_line_index_list);
+                         nullptr, nullptr, &geometry.box_line_index_list);
     }
     drawManager.endDrawInXray();
 
@@ -26,6 +26,10 @@
 #include <maya/MColor.h>
 #include <maya/MEventMessage.h>
 #include <maya/MGlobal.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
 #include <maya/MPointArray.h>
 #include <maya/MStreamUtils.h>
 #include <maya/MString.h>
@@ -68,12 +72,6 @@ public:
     MColor m_color{1.0f, 0.0f, 0.0f, 1.0f};
     bool m_draw_name;
     unsigned int m_depth_priority;
-
-    MPointArray m_cross_line_list;
-    MUintArray m_cross_line_index_list;
-
-    MPointArray m_box_line_list;
-    MUintArray m_box_line_index_list;
 };
 
 class MarkerDrawOverride : public MHWRender::MPxDrawOverride {
@@ -119,8 +117,25 @@ private:
 
     static void on_model_editor_changed_func(void *clientData);
 
+    static void on_transform_attribute_changed_func(
+        MNodeMessage::AttributeMessage msg, MPlug &plug, MPlug &otherPlug,
+        void *clientData);
+
+    void watch_transform(const MObject &transformObj);
+
     MarkerShapeNode *m_node;
     MCallbackId m_model_editor_changed_callback_id;
+
+    // The locked-status of the marker transform is only re-computed
+    // when the transform's attributes are locked, unlocked,
+    // connected or disconnected, as reported by a callback on the
+    // transform node.
+    MObjectHandle m_transform;
+    MCallbackId m_transform_attribute_changed_callback_id;
+    MPlug m_plug_tx;
+    MPlug m_plug_ty;
+    bool m_locked;
+    bool m_locked_dirty;
 };
 
 }  // namespace mmsolver
@@ -24,7 +24,9 @@
 
 // Maya
 #include <maya/MDistance.h>
+#include <maya/MPlug.h>
 #include <maya/MPoint.h>
+#include <maya/MProfiler.h>
 #include <maya/MTransformationMatrix.h>
 #include <maya/MVector.h>
 
@@ -32,6 +34,7 @@
 #include <maya/MDrawContext.h>
 
 // MM Solver
+#include "mmSolver/adjust/adjust_defines.h"
 #include "mmSolver/utilities/debug_utils.h"
 #include "mmSolver/utilities/number_utils.h"
 
@@ -109,4 +112,28 @@ MStatus getViewportScaleRatio(const MHWRender::MFrameContext &frameContext,
     return status;
 }
 
+bool anyAttrIsConnected(const MObject &node, const MObject *attrs,
+                        const size_t attr_count) {
+    for (size_t i = 0; i < attr_count; ++i) {
+        MPlug plug(node, attrs[i]);
+        if (plug.isNull()) {
+            continue;
+        }
+        if (plug.isDestination() || (plug.numConnectedChildren() > 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int getDrawProfileCategory() {
+#ifdef MAYA_PROFILE
+    static const int category = MProfiler::addCategory(
+        "mmSolverDraw", "MM Solver viewport shape drawing");
+    return category;
+#else
+    return 0;
+#endif
+}
+
 }  // namespace mmsolver
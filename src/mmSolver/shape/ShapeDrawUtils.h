@@ -22,8 +22,12 @@
 #ifndef MM_MARKER_DRAW_UTILS_H
 #define MM_MARKER_DRAW_UTILS_H
 
+// STL
+#include <cstddef>
+
 // Maya
 #include <maya/MDistance.h>
+#include <maya/MObject.h>
 #include <maya/MPoint.h>
 #include <maya/MTransformationMatrix.h>
 #include <maya/MVector.h>
@@ -39,6 +43,16 @@ MStatus objectIsBelowCamera(const MDagPath &objPath, const MDagPath &cameraPath,
 MStatus getViewportScaleRatio(const MHWRender::MFrameContext &frameContext,
                               double &out_scale);
 
+// Returns true if any of the 'attrs' of 'node' has an incoming
+// connection (such as an animation curve), so the value may change
+// without the attribute being set.
+bool anyAttrIsConnected(const MObject &node, const MObject *attrs,
+                        const size_t attr_count);
+
+// The Maya profiler category used to measure the CPU time of the
+// shape draw overrides. Only used when 'MAYA_PROFILE' is defined.
+int getDrawProfileCategory();
+
 }  // namespace mmsolver
 
 #endif  // MM_MARKER_DRAW_UTILS_H
\ No newline at end of file
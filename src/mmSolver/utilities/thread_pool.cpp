@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ */
+
+#include "thread_pool.h"
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace mmthread {
+
+namespace {
+
+std::mutex g_shared_thread_pool_mutex;
+std::unique_ptr<ThreadPool> g_shared_thread_pool;
+
+// The state of a single 'parallelForChunks' call, shared with the
+// tasks submitted to the thread pool. Tasks that start after all
+// chunks have been taken return without touching 'func', so the
+// state (but not 'func') may outlive the call.
+struct ParallelForState {
+    ParallelForState(const size_t count, const size_t chunk_size,
+                     const std::function<void(size_t, size_t)> &func)
+        : func(&func)
+        , count(count)
+        , chunk_size(chunk_size)
+        , chunk_count((count + chunk_size - 1) / chunk_size)
+        , next_chunk(0)
+        , finished_count(0) {}
+
+    const std::function<void(size_t, size_t)> *func;
+    const size_t count;
+    const size_t chunk_size;
+    const size_t chunk_count;
+    std::atomic<size_t> next_chunk;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t finished_count;
+};
+
+// Run chunks until no chunks are left to start.
+void runChunks(ParallelForState &state) {
+    while (true) {
+        const size_t chunk = state.next_chunk++;
+        if (chunk >= state.chunk_count) {
+            return;
+        }
+        const size_t start = chunk * state.chunk_size;
+        const size_t end = std::min(start + state.chunk_size, state.count);
+        (*state.func)(start, end);
+
+        bool finished = false;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            ++state.finished_count;
+            finished = state.finished_count == state.chunk_count;
+        }
+        if (finished) {
+            state.condition.notify_all();
+        }
+    }
+}
+
+}  // namespace
+
+size_t defaultThreadCount() {
+    const unsigned int count = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, static_cast<size_t>(count));
+}
+
+ThreadPool::ThreadPool(const size_t thread_count) : m_stop(false) {
+    const size_t count = std::max<size_t>(1, thread_count);
+    m_threads.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    // 'std::function' must be copyable, so the packaged task is
+    // shared.
+    auto packaged_task =
+        std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> future = packaged_task->get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push([packaged_task]() { (*packaged_task)(); });
+    }
+    m_condition.notify_one();
+    return future;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock,
+                             [this]() { return m_stop || !m_tasks.empty(); });
+            // Remaining tasks are finished before stopping.
+            if (m_stop && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+ThreadPool &sharedThreadPool() {
+    std::lock_guard<std::mutex> lock(g_shared_thread_pool_mutex);
+    if (!g_shared_thread_pool) {
+        g_shared_thread_pool.reset(new ThreadPool(defaultThreadCount()));
+    }
+    return *g_shared_thread_pool;
+}
+
+void sharedThreadPoolShutdown() {
+    std::lock_guard<std::mutex> lock(g_shared_thread_pool_mutex);
+    g_shared_thread_pool.reset();
+}
+
+void parallelForChunks(const size_t count, const size_t thread_count,
+                       const size_t min_chunk_size,
+                       const std::function<void(size_t, size_t)> &func) {
+    if (count == 0) {
+        return;
+    }
+
+    const size_t max_thread_count =
+        (thread_count == 0) ? defaultThreadCount() : thread_count;
+    const size_t min_size = std::max<size_t>(1, min_chunk_size);
+    const size_t max_chunk_count = (count + min_size - 1) / min_size;
+    const size_t chunk_count = std::min(max_chunk_count, max_thread_count * 4);
+    if ((max_thread_count <= 1) || (chunk_count <= 1)) {
+        func(0, count);
+        return;
+    }
+
+    const size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+    auto state = std::make_shared<ParallelForState>(count, chunk_size, func);
+
+    ThreadPool &thread_pool = sharedThreadPool();
+    const size_t task_count =
+        std::min(std::min(max_thread_count, state->chunk_count) - 1,
+                 thread_pool.threadCount());
+    for (size_t i = 0; i < task_count; ++i) {
+        // The returned future is not waited on; see 'ParallelForState'.
+        thread_pool.submit([state]() { runChunks(*state); });
+    }
+    runChunks(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state]() {
+        return state->finished_count == state->chunk_count;
+    });
+}
+
+}  // namespace mmthread
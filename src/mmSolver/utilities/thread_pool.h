@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * A fixed size pool of worker threads, and a parallel for-loop run
+ * on a pool shared by the whole plug-in.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// STL
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace mmthread {
+
+/*! The number of threads to use by default.
+ *
+ * Returns the number of hardware threads, or 1 if unknown.
+ */
+size_t defaultThreadCount();
+
+/*! A fixed size pool of worker threads, executing tasks in the order
+ * they are submitted.
+ *
+ * Tasks must not call Maya API functions that are not thread-safe.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(const size_t thread_count);
+
+    // Waits for all submitted tasks to finish.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t threadCount() const { return m_threads.size(); }
+
+    /*! Add a task to be run on a worker thread.
+     *
+     * The returned future becomes ready when the task has finished.
+     */
+    std::future<void> submit(std::function<void()> task);
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop;
+};
+
+/*! The thread pool shared by all multi-threaded code in the
+ * plug-in.
+ *
+ * The pool is created with 'defaultThreadCount()' threads when first
+ * used, so no threads are started (or stopped) each time a
+ * multi-threaded function is called.
+ */
+ThreadPool &sharedThreadPool();
+
+/*! Stop the threads of the shared thread pool.
+ *
+ * Must be called before the plug-in is unloaded. The pool is created
+ * again if it is used afterwards.
+ */
+void sharedThreadPoolShutdown();
+
+/*! Call 'func(start, end)' for contiguous index ranges that together
+ * cover the indices 0 to 'count' (exclusive), using up to
+ * 'thread_count' threads.
+ *
+ * The calling thread runs chunks too, and the other threads are
+ * taken from 'sharedThreadPool()', so 'thread_count' is limited to
+ * one more than the shared pool size. A 'thread_count' of zero uses
+ * 'defaultThreadCount()' threads.
+ *
+ * The indices are split into more chunks than there are threads, so
+ * that chunks taking longer to run do not leave other threads idle,
+ * but chunks are never smaller than 'min_chunk_size' indices
+ * (except the last one). With one thread, or only one chunk,
+ * 'func(0, count)' is called on the calling thread.
+ *
+ * Returns once all chunks have finished. The calling thread never
+ * waits for a chunk that has not started, so 'parallelForChunks' can
+ * be called from within 'func' without deadlocks. 'func' is called
+ * from multiple threads at once, and must not throw exceptions.
+ */
+void parallelForChunks(const size_t count, const size_t thread_count,
+                       const size_t min_chunk_size,
+                       const std::function<void(size_t, size_t)> &func);
+
+}  // namespace mmthread
+
+#endif  // THREAD_POOL_H
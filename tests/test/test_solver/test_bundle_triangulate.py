@@ -0,0 +1,137 @@
+# Copyright (C) 2024 David Cattermole.
+#
+# This file is part of mmSolver.
+#
+# mmSolver is free software: you can redistribute it and/or modify it
+# under the terms of the GNU Lesser General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# mmSolver is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+#
+"""
+Test the mmBundleTriangulate command, by triangulating bundles from
+markers reprojected from known bundle positions.
+"""
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import unittest
+
+import maya.cmds
+
+import test.test_solver.solverutils as solverUtils
+
+
+# @unittest.skip
+class TestBundleTriangulate(solverUtils.SolverTestCase):
+    def test_bundle_triangulate_cmd(self):
+        start = 1
+        end = 24
+        maya.cmds.playbackOptions(min=start, max=end)
+
+        # Camera, moving sideways so the bundles have parallax.
+        cam_tfm, cam_shp = self.create_camera('camera')
+        maya.cmds.setAttr(cam_tfm + '.translateY', 1.0)
+        maya.cmds.setAttr(cam_tfm + '.translateZ', 10.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateX', time=start, value=-3.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateX', time=end, value=3.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='rotateY', time=start, value=-5.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='rotateY', time=end, value=5.0)
+
+        positions = [
+            (-1.5, 0.5, 0.0),
+            (1.0, 2.0, -1.0),
+            (0.0, -1.0, 1.5),
+            (2.0, 0.0, -3.0),
+            (-2.5, 1.5, 2.0),
+        ]
+
+        mkr_grp = self.create_marker_group('marker_group', cam_tfm)
+        times = [float(t) for t in range(start, end + 1)]
+        mkr_bnd_list = []
+        for i, pos in enumerate(positions):
+            bnd_tfm, bnd_shp = self.create_bundle('bundle%s' % i)
+            maya.cmds.setAttr(bnd_tfm + '.translateX', pos[0])
+            maya.cmds.setAttr(bnd_tfm + '.translateY', pos[1])
+            maya.cmds.setAttr(bnd_tfm + '.translateZ', pos[2])
+
+            # Key the marker on the reprojected bundle position.
+            mkr_tfm, mkr_shp = self.create_marker(
+                'marker%s' % i, mkr_grp, bnd_tfm=bnd_tfm
+            )
+            values = maya.cmds.mmReprojection(
+                bnd_tfm,
+                camera=(cam_tfm, cam_shp),
+                time=times,
+                asMarkerCoordinate=True,
+            )
+            for j, t in enumerate(times):
+                x = values[(j * 3) + 0]
+                y = values[(j * 3) + 1]
+                maya.cmds.setKeyframe(mkr_tfm, attribute='tx', time=t, value=x)
+                maya.cmds.setKeyframe(mkr_tfm, attribute='ty', time=t, value=y)
+            maya.cmds.setAttr(mkr_tfm + '.tz', -1.0)
+
+            # Move the bundle away from the answer.
+            maya.cmds.setAttr(bnd_tfm + '.translateX', 0.0)
+            maya.cmds.setAttr(bnd_tfm + '.translateY', 0.0)
+            maya.cmds.setAttr(bnd_tfm + '.translateZ', 0.0)
+            mkr_bnd_list.append((mkr_tfm, bnd_tfm))
+
+        # save the input
+        path = self.get_data_path('bundle_triangulate_cmd_before.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        result = maya.cmds.mmBundleTriangulate(
+            camera=cam_tfm,
+            marker=mkr_bnd_list,
+            startFrame=start,
+            endFrame=end,
+            threadCount=2,
+            setValues=True,
+        )
+
+        # save the output
+        path = self.get_data_path('bundle_triangulate_cmd_after.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        values_per_marker = 6
+        self.assertEqual(len(result), len(positions) * values_per_marker)
+        for i, pos in enumerate(positions):
+            index = i * values_per_marker
+            ok = result[index + 0]
+            inlier_count = result[index + 4]
+            self.assertEqual(ok, 1.0)
+            self.assertEqual(inlier_count, float(len(times)))
+
+            bnd_tfm = mkr_bnd_list[i][1]
+            for k, attr in enumerate(['translateX', 'translateY', 'translateZ']):
+                self.assertApproxEqual(result[index + 1 + k], pos[k], eps=0.001)
+                value = maya.cmds.getAttr(bnd_tfm + '.' + attr)
+                self.assertApproxEqual(value, pos[k], eps=0.001)
+
+        # The result must not depend on the number of threads.
+        result_one_thread = maya.cmds.mmBundleTriangulate(
+            camera=cam_tfm,
+            marker=mkr_bnd_list,
+            startFrame=start,
+            endFrame=end,
+            threadCount=1,
+        )
+        self.assertListEqual(result, result_one_thread)
+        return
+
+
+if __name__ == '__main__':
+    prog = unittest.main()
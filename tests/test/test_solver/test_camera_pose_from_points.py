@@ -37,6 +37,7 @@ import maya.cmds
 
 import mmSolver.utils.python_compat as pycompat
 import mmSolver.api as mmapi
+import mmSolver.tools.createlens.lib as createlens_lib
 
 import test.test_solver.solverutils as solverUtils
 
@@ -138,6 +139,130 @@ class TestCameraPoseResection(solverUtils.SolverTestCase):
         maya.cmds.file(rename=path)
         maya.cmds.file(save=True, type='mayaAscii', force=True)
 
+    @staticmethod
+    def distort_point(eval_node, x, y, iterations=50):
+        """
+        Find the distorted point that undistorts to (x, y).
+
+        The mmLensEvaluate node only undistorts, so the distorted
+        point is found by fixed-point iteration.
+        """
+        dist_x = x
+        dist_y = y
+        for _ in range(iterations):
+            maya.cmds.setAttr(eval_node + '.inX', dist_x)
+            maya.cmds.setAttr(eval_node + '.inY', dist_y)
+            undist_x = maya.cmds.getAttr(eval_node + '.outX')
+            undist_y = maya.cmds.getAttr(eval_node + '.outY')
+            dist_x += x - undist_x
+            dist_y += y - undist_y
+        return dist_x, dist_y
+
+    def test_camera_pose_from_points_with_lens(self):
+        """
+        Markers distorted by the camera lens are undistorted before
+        the camera pose is calculated.
+        """
+        start = 1
+        end = 3
+        maya.cmds.playbackOptions(min=start, max=end)
+        frames = list(range(start, end + 1))
+
+        # Camera, with a known pose on each frame.
+        cam_tfm, cam_shp = self.create_camera('camera')
+        cam_values = {
+            'translateX': (-1.0, 0.0, 1.0),
+            'translateY': (1.0, 1.2, 1.5),
+            'translateZ': (10.0, 9.5, 9.0),
+            'rotateX': (-2.0, -3.0, -4.0),
+            'rotateY': (-5.0, 0.0, 5.0),
+            'rotateZ': (0.0, 1.0, 2.0),
+        }
+        for attr, values in cam_values.items():
+            for frame, value in zip(frames, values):
+                maya.cmds.setKeyframe(cam_tfm, attribute=attr, time=frame, value=value)
+
+        positions = [
+            (-1.5, 0.5, 0.0),
+            (1.0, 2.0, -1.0),
+            (0.0, -1.0, 1.5),
+            (2.0, 0.0, -3.0),
+            (-2.5, 1.5, 2.0),
+            (1.5, -0.5, 0.5),
+        ]
+
+        mkr_grp = self.create_marker_group('marker_group', cam_tfm)
+        mkr_bnd_list = []
+        for i, pos in enumerate(positions):
+            bnd_tfm, bnd_shp = self.create_bundle('bundle%s' % i)
+            maya.cmds.setAttr(bnd_tfm + '.translateX', pos[0])
+            maya.cmds.setAttr(bnd_tfm + '.translateY', pos[1])
+            maya.cmds.setAttr(bnd_tfm + '.translateZ', pos[2])
+            mkr_tfm, mkr_shp = self.create_marker(
+                'marker%s' % i, mkr_grp, bnd_tfm=bnd_tfm
+            )
+            maya.cmds.setAttr(mkr_tfm + '.tz', -1.0)
+            mkr_bnd_list.append((mkr_tfm, bnd_tfm))
+
+        # Lens, connected to the camera and all markers.
+        cam = mmapi.Camera(transform=cam_tfm)
+        lens = createlens_lib.create_lens_on_camera(cam)
+        lens_node = lens.get_node()
+        maya.cmds.setAttr(lens_node + '.lensModel', 2)  # 2 == k3deClassic
+        maya.cmds.setAttr(lens_node + '.tdeClassic_distortion', 0.1)
+        maya.cmds.setAttr(lens_node + '.tdeClassic_quarticDistortion', 0.05)
+
+        eval_node = maya.cmds.createNode('mmLensEvaluate')
+        maya.cmds.connectAttr(lens_node + '.outLens', eval_node + '.inLens')
+
+        # Key the markers on the reprojected bundle positions, as seen
+        # through the lens.
+        times = [float(f) for f in frames]
+        for mkr_tfm, bnd_tfm in mkr_bnd_list:
+            values = maya.cmds.mmReprojection(
+                bnd_tfm,
+                camera=(cam_tfm, cam_shp),
+                time=times,
+                asMarkerCoordinate=True,
+            )
+            for j, t in enumerate(times):
+                x = values[(j * 3) + 0]
+                y = values[(j * 3) + 1]
+                x, y = self.distort_point(eval_node, x, y)
+                maya.cmds.setKeyframe(mkr_tfm, attribute='tx', time=t, value=x)
+                maya.cmds.setKeyframe(mkr_tfm, attribute='ty', time=t, value=y)
+        maya.cmds.delete(eval_node)
+
+        # Move the camera away from the answer.
+        for attr in cam_values.keys():
+            for frame in frames:
+                maya.cmds.setKeyframe(cam_tfm, attribute=attr, time=frame, value=0.0)
+
+        # save the input
+        path = self.get_data_path('camera_pose_from_points_lens_before.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        result = maya.cmds.mmCameraPoseFromPoints(
+            camera=cam_tfm,
+            frame=frames,
+            marker=mkr_bnd_list,
+            setValues=True,
+        )
+
+        # save the output
+        path = self.get_data_path('camera_pose_from_points_lens_after.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        self.assertListEqual(result, [1.0] * len(frames))
+        for attr, values in cam_values.items():
+            for frame, value in zip(frames, values):
+                plug = cam_tfm + '.' + attr
+                solved_value = maya.cmds.getAttr(plug, time=frame)
+                self.assertApproxEqual(solved_value, value, eps=0.001)
+        return
+
 
 if __name__ == '__main__':
     prog = unittest.main()
@@ -0,0 +1,157 @@
+# Copyright (C) 2024 David Cattermole.
+#
+# This file is part of mmSolver.
+#
+# mmSolver is free software: you can redistribute it and/or modify it
+# under the terms of the GNU Lesser General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# mmSolver is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+#
+"""
+Test the mmCameraSolve command, by solving a camera and bundles from
+markers reprojected from a known camera and known bundle positions.
+"""
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import unittest
+
+import maya.cmds
+
+import test.test_solver.solverutils as solverUtils
+
+
+# @unittest.skip
+class TestCameraSolve(solverUtils.SolverTestCase):
+    def test_camera_solve_cmd(self):
+        start = 1
+        end = 40
+        maya.cmds.playbackOptions(min=start, max=end)
+
+        # Camera, moving sideways and forwards so the bundles have
+        # parallax.
+        cam_tfm, cam_shp = self.create_camera('camera')
+        cam_attrs = [
+            'translateX',
+            'translateY',
+            'translateZ',
+            'rotateX',
+            'rotateY',
+            'rotateZ',
+        ]
+        maya.cmds.setAttr(cam_tfm + '.translateY', 1.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateX', time=start, value=-3.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateX', time=end, value=3.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateZ', time=start, value=12.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='translateZ', time=end, value=10.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='rotateY', time=start, value=-10.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute='rotateY', time=end, value=10.0)
+
+        # Bundles on a (non-planar) grid in front of the camera.
+        positions = []
+        for i in range(24):
+            x = (i % 6) - 2.5
+            y = ((i // 6) % 4) - 1.0
+            z = ((i * 7) % 5) - 2.0
+            positions.append((x, y, z))
+
+        mkr_grp = self.create_marker_group('marker_group', cam_tfm)
+        times = [float(t) for t in range(start, end + 1)]
+        mkr_bnd_list = []
+        for i, pos in enumerate(positions):
+            bnd_tfm, bnd_shp = self.create_bundle('bundle%s' % i)
+            maya.cmds.setAttr(bnd_tfm + '.translateX', pos[0])
+            maya.cmds.setAttr(bnd_tfm + '.translateY', pos[1])
+            maya.cmds.setAttr(bnd_tfm + '.translateZ', pos[2])
+
+            # Key the marker on the reprojected bundle position.
+            mkr_tfm, mkr_shp = self.create_marker(
+                'marker%s' % i, mkr_grp, bnd_tfm=bnd_tfm
+            )
+            values = maya.cmds.mmReprojection(
+                bnd_tfm,
+                camera=(cam_tfm, cam_shp),
+                time=times,
+                asMarkerCoordinate=True,
+            )
+            for j, t in enumerate(times):
+                x = values[(j * 3) + 0]
+                y = values[(j * 3) + 1]
+                maya.cmds.setKeyframe(mkr_tfm, attribute='tx', time=t, value=x)
+                maya.cmds.setKeyframe(mkr_tfm, attribute='ty', time=t, value=y)
+            maya.cmds.setAttr(mkr_tfm + '.tz', -1.0)
+
+            # Move the bundle away from the answer.
+            maya.cmds.setAttr(bnd_tfm + '.translateX', 0.0)
+            maya.cmds.setAttr(bnd_tfm + '.translateY', 0.0)
+            maya.cmds.setAttr(bnd_tfm + '.translateZ', 0.0)
+            mkr_bnd_list.append((mkr_tfm, bnd_tfm))
+
+        # Move the camera away from the answer.
+        maya.cmds.cutKey(cam_tfm, attribute=cam_attrs)
+        for t in times:
+            for attr in cam_attrs:
+                maya.cmds.setKeyframe(cam_tfm, attribute=attr, time=t, value=0.0)
+
+        # save the input
+        path = self.get_data_path('camera_solve_cmd_before.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        result = maya.cmds.mmCameraSolve(
+            camera=cam_tfm,
+            marker=mkr_bnd_list,
+            startFrame=start,
+            endFrame=end,
+            bundleAdjustInterval=5,
+            bundleAdjustWindow=10,
+            threadCount=2,
+            setValues=True,
+        )
+
+        # save the output
+        path = self.get_data_path('camera_solve_cmd_after.ma')
+        maya.cmds.file(rename=path)
+        maya.cmds.file(save=True, type='mayaAscii', force=True)
+
+        # All frames and all bundles are solved.
+        values_per_frame = 1 + 16
+        values_per_bundle = 1 + 3
+        frame_count = int(result[0])
+        self.assertEqual(frame_count, len(times))
+        bundle_values = result[1 + (frame_count * values_per_frame) :]
+        self.assertEqual(len(bundle_values), len(positions) * values_per_bundle)
+        for i in range(frame_count):
+            frame = result[1 + (i * values_per_frame)]
+            self.assertEqual(frame, times[i])
+
+        # The solve is only known up to an unknown scale and world
+        # position, so the solved camera and bundles are compared by
+        # reprojecting the bundles onto the markers.
+        for mkr_tfm, bnd_tfm in mkr_bnd_list:
+            values = maya.cmds.mmReprojection(
+                bnd_tfm,
+                camera=(cam_tfm, cam_shp),
+                time=times,
+                asMarkerCoordinate=True,
+            )
+            for j, t in enumerate(times):
+                mkr_x = maya.cmds.getAttr(mkr_tfm + '.tx', time=t)
+                mkr_y = maya.cmds.getAttr(mkr_tfm + '.ty', time=t)
+                self.assertApproxEqual(values[(j * 3) + 0], mkr_x, eps=0.001)
+                self.assertApproxEqual(values[(j * 3) + 1], mkr_y, eps=0.001)
+        return
+
+
+if __name__ == '__main__':
+    prog = unittest.main()
@@ -142,6 +142,54 @@ class TestLens1(solverUtils.SolverTestCase):
             print('value:', axis, value)
         return
 
+    def test_lens_evaluate_array(self):
+        lens_node = maya.cmds.createNode('mmLensModel3de')
+        eval_node = maya.cmds.createNode('mmLensEvaluate')
+        eval_array_node = maya.cmds.createNode('mmLensEvaluateArray')
+
+        plug = lens_node + '.lensModel'
+        maya.cmds.setAttr(plug, 2)  # 2 == k3deClassic
+
+        plug = lens_node + '.tdeClassic_distortion'
+        maya.cmds.setAttr(plug, 0.2)
+
+        plug = lens_node + '.tdeClassic_quarticDistortion'
+        maya.cmds.setAttr(plug, 0.1)
+
+        src = lens_node + '.outLens'
+        maya.cmds.connectAttr(src, eval_node + '.inLens')
+        maya.cmds.connectAttr(src, eval_array_node + '.inLens')
+
+        # Enough points to be evaluated on multiple threads.
+        count = 5000
+        in_x = [((i % 100) / 100.0) - 0.5 for i in range(count)]
+        in_y = [((i // 50) / 100.0) - 0.5 for i in range(count)]
+        plug = eval_array_node + '.inX'
+        maya.cmds.setAttr(plug, in_x, type='doubleArray')
+        plug = eval_array_node + '.inY'
+        maya.cmds.setAttr(plug, in_y, type='doubleArray')
+        maya.cmds.setAttr(eval_array_node + '.threadCount', 4)
+
+        out_x = maya.cmds.getAttr(eval_array_node + '.outX')
+        out_y = maya.cmds.getAttr(eval_array_node + '.outY')
+        self.assertEqual(len(out_x), count)
+        self.assertEqual(len(out_y), count)
+
+        # The array node must give the same values as the
+        # single point node.
+        for i in range(0, count, 499):
+            maya.cmds.setAttr(eval_node + '.inX', in_x[i])
+            maya.cmds.setAttr(eval_node + '.inY', in_y[i])
+            x = maya.cmds.getAttr(eval_node + '.outX')
+            y = maya.cmds.getAttr(eval_node + '.outY')
+            self.assertAlmostEqual(out_x[i], x)
+            self.assertAlmostEqual(out_y[i], y)
+
+        hash_value = maya.cmds.getAttr(eval_node + '.outHash')
+        array_hash_value = maya.cmds.getAttr(eval_array_node + '.outHash')
+        self.assertEqual(hash_value, array_hash_value)
+        return
+
 
 if __name__ == '__main__':
     prog = unittest.main()
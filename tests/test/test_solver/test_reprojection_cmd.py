@@ -155,6 +155,56 @@ class TestReprojectionNode(solverUtils.SolverTestCase):
         maya.cmds.file(save=True, type='mayaAscii', force=True)
         return
 
+    def test_reprojection_cmd_many_nodes(self):
+        """
+        Reprojecting many nodes at once (on many threads) must give
+        the same values as reprojecting each node by itself.
+        """
+        start = 1001
+        end = 1100
+        maya.cmds.playbackOptions(min=start, max=end)
+
+        # Camera
+        cam_tfm, cam_shp = self.create_camera('camera')
+        maya.cmds.setAttr(cam_tfm + '.translateY', 2.0)
+        maya.cmds.setAttr(cam_tfm + '.translateZ', 10.0)
+
+        attr = 'translateX'
+        maya.cmds.setKeyframe(cam_tfm, attribute=attr, time=start, value=-2.0)
+        maya.cmds.setKeyframe(cam_tfm, attribute=attr, time=end, value=2.0)
+
+        attr = 'focalLength'
+        maya.cmds.setKeyframe(cam_shp, attribute=attr, time=start, value=35.0)
+        maya.cmds.setKeyframe(cam_shp, attribute=attr, time=end, value=50.0)
+
+        # Input transforms, on a grid.
+        nodes = []
+        for i in range(40):
+            tfm = maya.cmds.createNode('transform', name='INPUT_%s' % i)
+            maya.cmds.setAttr(tfm + '.translateX', (i % 8) - 4.0)
+            maya.cmds.setAttr(tfm + '.translateY', (i // 8) - 2.0)
+            maya.cmds.setAttr(tfm + '.translateZ', -float(i % 3))
+            nodes.append(tfm)
+
+        times = [float(t) for t in range(start, end + 1)]
+        kwargs = {
+            'camera': (cam_tfm, cam_shp),
+            'time': times,
+            'asMarkerCoordinate': True,
+            'withCameraDirectionRatio': True,
+        }
+        values = maya.cmds.mmReprojection(nodes, threadCount=4, **kwargs)
+        values_per_point = 4
+        self.assertEqual(len(values), len(nodes) * len(times) * values_per_point)
+
+        values_per_node = len(times) * values_per_point
+        for i, node in enumerate(nodes):
+            node_values = maya.cmds.mmReprojection(node, threadCount=1, **kwargs)
+            start_index = i * values_per_node
+            end_index = start_index + values_per_node
+            self.assertListEqual(values[start_index:end_index], node_values)
+        return
+
 
 if __name__ == '__main__':
     prog = unittest.main()
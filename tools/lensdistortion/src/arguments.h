@@ -89,6 +89,8 @@ struct Arguments {
     ExrCompressionMode exr_compression;
     Direction direction;
     int32_t num_threads;
+    mmimage::ImageWarpFilter warp_filter;
+    size_t tile_height;
     bool verbose;
 };
 
@@ -113,7 +115,10 @@ void print_flags() {
         << "  -v  --version        Print the software version.\n"
         << '\n'
         << "  -o  --output         Output file path.\n"
-        << "  -i  --input          TODO: Input file path.\n"
+        << "  -i  --input          Input image file path. When given, the\n"
+        << "                       input image is warped, instead of\n"
+        << "                       creating an ST-Map. '#' characters\n"
+        << "                       are replaced by the frame number.\n"
         << "      --lens           Lens distortion file path.\n"
         << "      --frame-range    First and last frame to output.\n"
         << "      --stmap          TODO: Generate an ST-Map.\n"
@@ -121,6 +126,12 @@ void print_flags() {
         << "      --direction      The direction of the ST-Map.\n"
         << "                       'undistort', 'redistort', 'both'\n"
         << "                       (default is 'both')\n"
+        << "      --warp-filter    The filter used to warp the input image;\n"
+        << "                       'bilinear' or 'bicubic'\n"
+        << "                       (default is 'bilinear')\n"
+        << "      --tile-height    Number of rows warped at once;\n"
+        << "                       limits the memory used for the output\n"
+        << "                       image (default is 64).\n"
         << "      --exr-compress   OpenEXR compression method;\n"
         << "                       ZIP1, ZIP16, RLE, or PIZ\n"
         << "                       (default is ZIP16)\n"
@@ -187,6 +198,8 @@ bool parse_arguments(const int argc, const char* argv[], Arguments& args) {
         const bool is_frame_range_flag = std::strcmp(arg, "--frame-range") == 0;
         const bool is_direction_flag = std::strcmp(arg, "--direction") == 0;
         const bool is_num_threads_flag = std::strcmp(arg, "--num-threads") == 0;
+        const bool is_warp_filter_flag = std::strcmp(arg, "--warp-filter") == 0;
+        const bool is_tile_height_flag = std::strcmp(arg, "--tile-height") == 0;
         const bool is_verbose_flag = std::strcmp(arg, "--verbose") == 0;
 
         if (is_help_flag) {
@@ -239,6 +252,30 @@ bool parse_arguments(const int argc, const char* argv[], Arguments& args) {
             // logic.
             args.num_threads = std::max(-1, given_value);
             i++;
+        } else if (is_warp_filter_flag) {
+            if (next_arg1.size() == 0) {
+                print_help(argv[0]);
+                return false;
+            }
+
+            const bool is_bicubic =
+                std::strcmp(next_arg1.c_str(), "bicubic") == 0;
+            if (is_bicubic) {
+                args.warp_filter = mmimage::ImageWarpFilter::kBicubic;
+            } else {
+                args.warp_filter = mmimage::ImageWarpFilter::kBilinear;
+            }
+
+            i++;
+        } else if (is_tile_height_flag) {
+            if (next_arg1.size() == 0) {
+                print_help(argv[0]);
+                return false;
+            }
+            const int32_t given_value =
+                convert_string_to_number<int32_t>(std::string(next_arg1));
+            args.tile_height = static_cast<size_t>(std::max(1, given_value));
+            i++;
         } else if (is_input_flag) {
             if (next_arg1.size() == 0) {
                 print_help(argv[0]);
@@ -26,6 +26,10 @@ const char* TOOL_EXECUTABLE_NAME = "mmsolver-lensdistortion";
 const char* TOOL_DESCRIPTION = "Create lens distortion ST-Maps.";
 const char* EXR_METADATA_SOFTWARE_NAME = "mayaMatchMoveSolver (mmSolver)";
 
+// The number of rows warped (and held in memory) at once, when
+// warping an input image.
+const size_t DEFAULT_WARP_TILE_HEIGHT = 64;
+
 // The coordinates around the edges of an image bounding box. These
 // coordinates are used to sample the lens distortion at the edges to
 // find the maximum/minimum extent of the distorted bounding box.
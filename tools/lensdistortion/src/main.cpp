@@ -17,7 +17,8 @@
  * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
  * ====================================================================
  *
- * This tool is used to generate lens distortion ST-Maps.
+ * This tool is used to generate lens distortion ST-Maps, or to warp
+ * an input image with lens distortion.
  */
 
 #include <mmcore/mmdata.h>
@@ -36,6 +37,7 @@
 #include "buffer.h"
 #include "constants.h"
 #include "steps.h"
+#include "warp.h"
 
 bool run_frame(mmlens::FrameNumber frame,
                const mmlens::DistortionDirection distortion_direction,
@@ -155,6 +157,8 @@ bool run(const Arguments& args) {
             << "ExrCompression : " << static_cast<int>(args.exr_compression)
             << '\n'
             << "NumThreads     : " << static_cast<int>(args.num_threads) << '\n'
+            << "WarpFilter     : " << static_cast<int>(args.warp_filter) << '\n'
+            << "TileHeight     : " << args.tile_height << '\n'
             << "Verbose        : " << static_cast<int>(args.verbose) << '\n'
             << std::endl;
     }
@@ -201,6 +205,15 @@ bool run(const Arguments& args) {
     const mmlens::DistortionDirection distortion_direction =
         convert_distortion_direction(args.direction);
 
+    // An input image is warped in a single direction only.
+    const bool warp_input_image = args.input_file_path.size() > 0;
+    if (warp_input_image && (args.direction == Direction::kBoth)) {
+        std::cerr << "ERROR: --direction must be 'undistort' or 'redistort' "
+                     "when warping an input image."
+                  << std::endl;
+        return false;
+    }
+
     mmlens::HashValue64 last_frame_hash = 0;
     const mmlens::FrameNumber start_frame = args.start_frame;
     const mmlens::FrameNumber end_frame = args.end_frame;
@@ -223,16 +236,30 @@ bool run(const Arguments& args) {
             continue;
         }
 
-        const bool result =
-            run_frame(frame, distortion_direction, image_width, image_height,
-                      num_channels, camera_parameters, film_back_radius_cm,
+        bool result = false;
+        if (warp_input_image) {
+            const std::string frame_input_file_path = compute_input_file_path(
+                args.input_file_path, frame, args.verbose);
+            const std::string frame_output_file_path = compute_output_file_path(
+                args.output_file_path, frame, args.verbose);
+            result = warp_image(
+                frame, distortion_direction, camera_parameters,
+                film_back_radius_cm, lens_layers,
+                rust::Str(frame_input_file_path),
+                rust::Str(frame_output_file_path), args.exr_compression,
+                args.warp_filter, args.tile_height, args.verbose);
+        } else {
+            result = run_frame(
+                frame, distortion_direction, image_width, image_height,
+                num_channels, camera_parameters, film_back_radius_cm,
 
-                      // Layers
-                      layer_count, lens_layers,
+                // Layers
+                layer_count, lens_layers,
 
-                      // Out to write out data.
-                      args.exr_compression, args.output_file_path,
-                      args.num_threads, args.verbose);
+                // Out to write out data.
+                args.exr_compression, args.output_file_path, args.num_threads,
+                args.verbose);
+        }
 
         if (!result) {
             return result;
@@ -249,6 +276,8 @@ int main(const int argc, const char* argv[]) {
     args.direction = Direction::kBoth;
     args.exr_compression = ExrCompressionMode::kZIP16;
     args.num_threads = 0;
+    args.warp_filter = mmimage::ImageWarpFilter::kBilinear;
+    args.tile_height = DEFAULT_WARP_TILE_HEIGHT;
     args.verbose = false;
 
     const bool parse_succeeded = parse_arguments(argc, argv, args);
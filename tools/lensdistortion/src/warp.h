@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2024 David Cattermole.
+ *
+ * This file is part of mmSolver.
+ *
+ * mmSolver is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * mmSolver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with mmSolver.  If not, see <https://www.gnu.org/licenses/>.
+ * ====================================================================
+ *
+ * Warp an input image with lens distortion, without creating an
+ * ST-Map image.
+ *
+ * The lens distortion coordinates are computed for a band of rows
+ * ("tile") at a time, the input image is resampled at those
+ * coordinates, and the rows are given to a streaming EXR writer, so
+ * the memory used for the output is bounded by the tile height, not
+ * the image size.
+ */
+
+#ifndef MM_SOLVER_LENS_DISTORTION_WARP_H
+#define MM_SOLVER_LENS_DISTORTION_WARP_H
+
+#include <mmimage/mmimage.h>
+#include <mmlens/mmlens.h>
+#include <mmsolverlibs/assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "arguments.h"
+
+// The ST coordinates have two values per-pixel; S and T.
+const size_t WARP_COORDS_STRIDE = 2;
+
+template <typename LENS_TYPE>
+void calculate_lens_distortion_rows_function(
+    const mmlens::DistortionDirection distortion_direction,
+    const size_t image_width, const size_t image_height,
+    const size_t start_row, const size_t end_row,
+    const mmlens::CameraParameters camera_parameters,
+    const double film_back_radius_cm, const LENS_TYPE lens_parameters,
+    std::vector<float>& out_coords) {
+    const size_t out_coords_size =
+        (end_row - start_row) * image_width * WARP_COORDS_STRIDE;
+    mmlens::apply_identity_to_f32_rows_multithread(
+        distortion_direction, image_width, image_height, start_row, end_row,
+        out_coords.data(), out_coords_size, WARP_COORDS_STRIDE,
+        camera_parameters, film_back_radius_cm, lens_parameters);
+}
+
+// Compute the lens distortion ST coordinates of the rows 'start_row'
+// to 'end_row' (exclusive) into 'out_coords'.
+void calculate_lens_distortion_rows(
+    const mmlens::DistortionDirection distortion_direction,
+    const uint8_t layer_num, const mmlens::FrameNumber frame,
+    const mmlens::LensModelType lens_model_type,
+    const mmlens::CameraParameters camera_parameters,
+    const double film_back_radius_cm,
+    const mmlens::DistortionLayers& lens_layers, const size_t image_width,
+    const size_t image_height, const size_t start_row, const size_t end_row,
+    std::vector<float>& out_coords) {
+    if (lens_model_type == mmlens::LensModelType::k3deClassic) {
+        const auto option =
+            lens_layers.layer_lens_parameters_3de_classic(layer_num, frame);
+        MMSOLVER_ASSERT(
+            option.exists,
+            "LensParameters are expected to exist for matching LensModelType.");
+        calculate_lens_distortion_rows_function(
+            distortion_direction, image_width, image_height, start_row,
+            end_row, camera_parameters, film_back_radius_cm, option.value,
+            out_coords);
+    } else if (lens_model_type == mmlens::LensModelType::k3deRadialStdDeg4) {
+        const auto option =
+            lens_layers.layer_lens_parameters_3de_radial_std_deg4(layer_num,
+                                                                  frame);
+        MMSOLVER_ASSERT(
+            option.exists,
+            "LensParameters are expected to exist for matching LensModelType.");
+        calculate_lens_distortion_rows_function(
+            distortion_direction, image_width, image_height, start_row,
+            end_row, camera_parameters, film_back_radius_cm, option.value,
+            out_coords);
+    } else if (lens_model_type ==
+               mmlens::LensModelType::k3deAnamorphicStdDeg4) {
+        const auto option =
+            lens_layers.layer_lens_parameters_3de_anamorphic_std_deg4(layer_num,
+                                                                      frame);
+        MMSOLVER_ASSERT(
+            option.exists,
+            "LensParameters are expected to exist for matching LensModelType.");
+        calculate_lens_distortion_rows_function(
+            distortion_direction, image_width, image_height, start_row,
+            end_row, camera_parameters, film_back_radius_cm, option.value,
+            out_coords);
+    } else if (lens_model_type ==
+               mmlens::LensModelType::k3deAnamorphicStdDeg4Rescaled) {
+        const auto option =
+            lens_layers.layer_lens_parameters_3de_anamorphic_std_deg4_rescaled(
+                layer_num, frame);
+        MMSOLVER_ASSERT(
+            option.exists,
+            "LensParameters are expected to exist for matching LensModelType.");
+        calculate_lens_distortion_rows_function(
+            distortion_direction, image_width, image_height, start_row,
+            end_row, camera_parameters, film_back_radius_cm, option.value,
+            out_coords);
+    } else {
+        MMSOLVER_PANIC(
+            "calculate_lens_distortion_rows: Unsupported lens_model_type: "
+            << static_cast<int>(lens_model_type));
+    }
+}
+
+// Replace the last run of '#' characters in the input file path with
+// the frame number, padded with zeros to the number of '#'
+// characters. For example "plate.####.exr" at frame 42 is
+// "plate.0042.exr".
+std::string compute_input_file_path(const std::string& input_file_path,
+                                    const mmlens::FrameNumber frame,
+                                    const bool verbose) {
+    const rust::String rust_file_path =
+        mmimage::image_sequence_frame_file_path(
+            rust::Str(input_file_path), static_cast<int32_t>(frame));
+    const std::string file_path(rust_file_path);
+
+    if (verbose) {
+        std::cout << "Input file path: " << file_path << std::endl;
+    }
+    return file_path;
+}
+
+// Warp the input image file with the lens distortion of 'frame', and
+// write the result to 'output_file_path'.
+//
+// The warp matches applying the ST-Map of the same direction to the
+// input image; 'undistort' removes the lens distortion from the
+// image and 'redistort' adds it.
+bool warp_image(const mmlens::FrameNumber frame,
+                const mmlens::DistortionDirection distortion_direction,
+                const mmlens::CameraParameters camera_parameters,
+                const double film_back_radius_cm,
+                const mmlens::DistortionLayers& lens_layers,
+                const rust::Str& input_file_path,
+                const rust::Str& output_file_path,
+                const ExrCompressionMode exr_compression_mode,
+                const mmimage::ImageWarpFilter warp_filter,
+                const size_t tile_height, const bool verbose) {
+    auto read_start = std::chrono::high_resolution_clock::now();
+    auto meta_data = mmimage::ImageMetaData();
+    auto in_pixel_buffer = mmimage::ImagePixelBuffer();
+    const bool read_result = mmimage::image_read_pixels_exr_f32x4(
+        input_file_path, meta_data, in_pixel_buffer);
+    if (!read_result) {
+        std::cerr << "ERROR: Failed to read image: " << input_file_path
+                  << std::endl;
+        return false;
+    }
+    auto read_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> read_duration = read_end - read_start;
+
+    const size_t image_width = in_pixel_buffer.image_width();
+    const size_t image_height = in_pixel_buffer.image_height();
+    if (image_width < 2 || image_height < 2) {
+        std::cerr << "ERROR: Input image is too small: " << image_width << 'x'
+                  << image_height << std::endl;
+        return false;
+    }
+
+    // Only the first layer is supported.
+    const uint8_t layer_num = 0;
+    const auto lens_model_type = lens_layers.layer_lens_model_type(layer_num);
+
+    auto exr_compression = convert_exr_compression(exr_compression_mode);
+    auto exr_encoder = mmimage::ImageExrEncoder{
+        exr_compression,
+        mmimage::ExrPixelLayout{mmimage::ExrPixelLayoutMode::kScanLines, 0, 0},
+        mmimage::ExrLineOrder::kIncreasing,
+    };
+    std::string software_name = query_software_name();
+    meta_data.set_software_name(software_name);
+
+    auto writer = mmimage::ImageExrStreamWriter();
+    if (!writer.open(output_file_path, exr_encoder, meta_data, image_width,
+                     image_height)) {
+        std::cerr << "ERROR: Failed to open image for writing: "
+                  << output_file_path << std::endl;
+        return false;
+    }
+
+    const size_t rows_per_tile = std::max<size_t>(1, tile_height);
+    const size_t out_pixels_stride = 4;  // RGBA.
+    std::vector<float> coords(image_width * rows_per_tile * WARP_COORDS_STRIDE);
+    std::vector<float> out_pixels(image_width * rows_per_tile *
+                                  out_pixels_stride);
+
+    auto warp_start = std::chrono::high_resolution_clock::now();
+    bool warp_result = true;
+    for (size_t start_row = 0; start_row < image_height;
+         start_row += rows_per_tile) {
+        const size_t end_row =
+            std::min<size_t>(start_row + rows_per_tile, image_height);
+        const size_t row_count = end_row - start_row;
+
+        calculate_lens_distortion_rows(
+            distortion_direction, layer_num, frame, lens_model_type,
+            camera_parameters, film_back_radius_cm, lens_layers, image_width,
+            image_height, start_row, end_row, coords);
+
+        const size_t coords_size =
+            image_width * row_count * WARP_COORDS_STRIDE;
+        const size_t out_pixels_size =
+            image_width * row_count * out_pixels_stride;
+        warp_result = mmimage::image_warp_rows_f32x4(
+            in_pixel_buffer,
+            rust::Slice<const float>(coords.data(), coords_size),
+            WARP_COORDS_STRIDE, warp_filter, image_width,
+            rust::Slice<float>(out_pixels.data(), out_pixels_size));
+        if (!warp_result) {
+            std::cerr << "ERROR: Failed to warp image rows " << start_row
+                      << " to " << end_row << '.' << std::endl;
+            break;
+        }
+
+        warp_result = writer.write_rows_f32x4(
+            rust::Slice<const float>(out_pixels.data(), out_pixels_size));
+        if (!warp_result) {
+            std::cerr << "ERROR: Failed to write image rows " << start_row
+                      << " to " << end_row << '.' << std::endl;
+            break;
+        }
+    }
+    const bool finish_result = writer.finish();
+    auto warp_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> warp_duration = warp_end - warp_start;
+
+    if (!warp_result || !finish_result) {
+        std::cerr << "ERROR: Failed to write image: " << output_file_path
+                  << std::endl;
+        return false;
+    }
+
+    // Throughput of the warp and write, not including reading the
+    // input image.
+    const double megapixel_count =
+        static_cast<double>(image_width * image_height) / 1.0e6;
+    const double warp_seconds =
+        std::max<double>(warp_duration.count(), 1.0e-9);
+    std::cout << std::fixed << std::setprecision(3) << "Warped "
+              << image_width << 'x' << image_height << " pixels at "
+              << (megapixel_count / warp_seconds) << " megapixels per second."
+              << std::endl;
+    if (verbose) {
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Read time: " << read_duration.count() << " seconds\n"
+                  << "Warp and write time: " << warp_duration.count()
+                  << " seconds\n"
+                  << "Tile height: " << rows_per_tile << " rows\n"
+                  << "Successfully wrote: " << output_file_path << std::endl;
+    }
+    return true;
+}
+
+#endif  // MM_SOLVER_LENS_DISTORTION_WARP_H